@@ -0,0 +1,349 @@
+#include "bench_kernels.h"
+#include <string.h>
+#include "../src/config.h"
+#include "../src/bit_utils.h"
+#include "../src/can_manager.h"
+#include "../src/can_dispatch.h"
+#include "../src/dbc_signals.h"
+#include "../src/message_parser.h"
+#include "../src/state_manager.h"
+
+// Frame sets are built once by prepareBenchKernels(); kernels index them with
+// (i & BENCH_FRAME_MASK) so consecutive calls see different payloads.
+#define BENCH_FRAME_MASK (BENCH_FRAME_SET_SIZE - 1)
+
+static_assert((BENCH_FRAME_SET_SIZE & BENCH_FRAME_MASK) == 0, "BENCH_FRAME_SET_SIZE must be a power of two");
+
+// The monitored DBC signals plus two byte-straddling fields
+static const SignalBits benchSignals[BENCH_FRAME_SET_SIZE] = {
+    {dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq.startBit, dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq.length},
+    {dbc::BCM_Lamp_Stat_FD1::Illuminated_Entry_Stat.startBit, dbc::BCM_Lamp_Stat_FD1::Illuminated_Entry_Stat.length},
+    {dbc::BCM_Lamp_Stat_FD1::Dr_Courtesy_Light_Stat.startBit, dbc::BCM_Lamp_Stat_FD1::Dr_Courtesy_Light_Stat.length},
+    {dbc::Locking_Systems_2_FD1::Veh_Lock_Status.startBit, dbc::Locking_Systems_2_FD1::Veh_Lock_Status.length},
+    {dbc::PowertrainData_10::TrnPrkSys_D_Actl.startBit, dbc::PowertrainData_10::TrnPrkSys_D_Actl.length},
+    {dbc::Battery_Mgmt_3_FD1::BSBattSOC.startBit, dbc::Battery_Mgmt_3_FD1::BSBattSOC.length},
+    {19, 6},
+    {44, 8},
+};
+
+// 9-16 bit fields at assorted offsets for extractBits16()
+static const SignalBits benchWideSignals[BENCH_FRAME_SET_SIZE] = {
+    {15, 16}, {23, 12}, {31, 9}, {39, 16}, {47, 10}, {55, 14}, {61, 11}, {63, 16},
+};
+
+// Other traffic seen on the vehicle bus, not in the dispatch table
+static const uint32_t benchIgnoredIds[BENCH_FRAME_SET_SIZE] = {
+    0x080, 0x167, 0x202, 0x3B3, 0x3D8, 0x415, 0x7DF, 0x7E8,
+};
+
+// Half monitored, half not
+static const uint32_t benchLookupIds[BENCH_FRAME_SET_SIZE] = {
+    BCM_LAMP_STAT_FD1_ID, 0x080, LOCKING_SYSTEMS_2_FD1_ID, 0x3B3,
+    POWERTRAIN_DATA_10_ID, 0x415, BATTERY_MGMT_3_FD1_ID, 0x7E8,
+};
+
+static uint8_t benchPayloads[BENCH_FRAME_SET_SIZE][8];
+
+// Per message: BENCH_FRAME_SET_SIZE frames with alternating signal values
+static CANMessage bcmFrames[BENCH_FRAME_SET_SIZE];
+static CANMessage lockFrames[BENCH_FRAME_SET_SIZE];
+static CANMessage powertrainFrames[BENCH_FRAME_SET_SIZE];
+static CANMessage batteryFrames[BENCH_FRAME_SET_SIZE];
+
+// Dispatch mixes: every monitored ID twice (signal bits change on each visit),
+// the same frame repeated, and IDs the dispatch table does not route
+static CANMessage changingFrames[BENCH_FRAME_SET_SIZE];
+static CANMessage repeatedFrames[BENCH_FRAME_SET_SIZE];
+static CANMessage ignoredFrames[BENCH_FRAME_SET_SIZE];
+static CANMessage lookupFrames[BENCH_FRAME_SET_SIZE];     // benchLookupIds: half monitored
+
+static BCMLampStatus bcmStatuses[BENCH_FRAME_SET_SIZE];
+static LockingSystemsStatus lockStatuses[BENCH_FRAME_SET_SIZE];
+static PowertrainData powertrainStatuses[BENCH_FRAME_SET_SIZE];
+static BatteryManagement batteryStatuses[BENCH_FRAME_SET_SIZE];
+
+static CANMessage makeBenchFrame(uint32_t id, const uint8_t* payload) {
+    CANMessage message;
+    memset(&message, 0, sizeof(message));
+    message.id = id;
+    message.length = 8;
+    memcpy(message.data, payload, sizeof(message.data));
+    message.timestamp = 1000;
+    message.source = CAN_SOURCE_MCP2515;
+    return message;
+}
+
+void prepareBenchKernels() {
+    // Deterministic filler (xorshift32) so every run measures the same bytes
+    uint32_t seed = 0x2545F491;
+    for (int i = 0; i < BENCH_FRAME_SET_SIZE; i++) {
+        for (int b = 0; b < 8; b++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            benchPayloads[i][b] = (uint8_t)seed;
+        }
+    }
+
+    for (int i = 0; i < BENCH_FRAME_SET_SIZE; i++) {
+        bool odd = (i & 1) != 0;
+
+        bcmFrames[i] = makeBenchFrame(BCM_LAMP_STAT_FD1_ID, benchPayloads[i]);
+        setBits(bcmFrames[i].data, dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq.startBit,
+                dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq.length, odd ? PUDLAMP_ON : PUDLAMP_OFF);
+
+        lockFrames[i] = makeBenchFrame(LOCKING_SYSTEMS_2_FD1_ID, benchPayloads[i]);
+        setBits(lockFrames[i].data, dbc::Locking_Systems_2_FD1::Veh_Lock_Status.startBit,
+                dbc::Locking_Systems_2_FD1::Veh_Lock_Status.length, odd ? VEH_LOCK_ALL : VEH_LOCK_DBL);
+
+        powertrainFrames[i] = makeBenchFrame(POWERTRAIN_DATA_10_ID, benchPayloads[i]);
+        setBits(powertrainFrames[i].data, dbc::PowertrainData_10::TrnPrkSys_D_Actl.startBit,
+                dbc::PowertrainData_10::TrnPrkSys_D_Actl.length, odd ? TRNPRKSTS_OUT_OF_PARK : TRNPRKSTS_PARK);
+
+        batteryFrames[i] = makeBenchFrame(BATTERY_MGMT_3_FD1_ID, benchPayloads[i]);
+        setBits(batteryFrames[i].data, dbc::Battery_Mgmt_3_FD1::BSBattSOC.startBit,
+                dbc::Battery_Mgmt_3_FD1::BSBattSOC.length, 40 + i);
+
+        parseBCMLampStatus(bcmFrames[i], bcmStatuses[i]);
+        parseLockingSystemsStatus(lockFrames[i], lockStatuses[i]);
+        parsePowertrainData(powertrainFrames[i], powertrainStatuses[i]);
+        parseBatteryManagement(batteryFrames[i], batteryStatuses[i]);
+
+        ignoredFrames[i] = makeBenchFrame(benchIgnoredIds[i], benchPayloads[i]);
+        lookupFrames[i] = makeBenchFrame(benchLookupIds[i], benchPayloads[i]);
+        repeatedFrames[i] = lockFrames[0];
+    }
+
+    // A, B, C, D with the even frames, then with the odd ones
+    const CANMessage* frameSets[] = {bcmFrames, lockFrames, powertrainFrames, batteryFrames};
+    for (int i = 0; i < BENCH_FRAME_SET_SIZE; i++) {
+        changingFrames[i] = frameSets[i % 4][i / 4];
+    }
+
+    initializeStateManager();
+    resetCANDispatchStatistics();
+    invalidateCANPayloadCache();
+}
+
+static uint32_t benchExtractBits(uint32_t iterations) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        const SignalBits& signal = benchSignals[i & BENCH_FRAME_MASK];
+        sum += extractBits(benchPayloads[(i >> 3) & BENCH_FRAME_MASK], signal.startBit, signal.length);
+    }
+    return sum;
+}
+
+static uint32_t benchExtractBits16(uint32_t iterations) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        const SignalBits& signal = benchWideSignals[i & BENCH_FRAME_MASK];
+        sum += extractBits16(benchPayloads[(i >> 3) & BENCH_FRAME_MASK], signal.startBit, signal.length);
+    }
+    return sum;
+}
+
+static uint32_t benchSetBits(uint32_t iterations) {
+    uint8_t data[8];
+    memcpy(data, benchPayloads[0], sizeof(data));
+    for (uint32_t i = 0; i < iterations; i++) {
+        const SignalBits& signal = benchSignals[i & BENCH_FRAME_MASK];
+        setBits(data, signal.startBit, signal.length, i);
+    }
+    return (uint32_t)loadCANWord(data);
+}
+
+// One op is one call decoding all BENCH_FRAME_SET_SIZE fields
+static uint32_t benchExtractSignals(uint32_t iterations) {
+    uint32_t values[BENCH_FRAME_SET_SIZE];
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        extractSignals(benchPayloads[i & BENCH_FRAME_MASK], benchSignals, values, BENCH_FRAME_SET_SIZE);
+        sum += values[i & BENCH_FRAME_MASK];
+    }
+    return sum;
+}
+
+// The three BCM_Lamp_Stat_FD1 fields parseBCMLampStatus() reads, decoded three
+// ways; one op is one frame. The byte loop is extractBits() as it was before
+// the single-load payload word.
+static const SignalBits benchBCMSignals[3] = {benchSignals[0], benchSignals[1], benchSignals[2]};
+
+static uint8_t byteLoopExtractBits(const uint8_t* data, uint8_t startBit, uint8_t length) {
+    if (length > 8 || startBit > 63) return 0;
+
+    uint64_t dataInt = 0;
+    for (int i = 0; i < 8; i++) {
+        dataInt |= ((uint64_t)data[i]) << (i * 8);
+    }
+
+    uint8_t bitPos = startBit - length + 1;
+    uint64_t mask = (1ULL << length) - 1;
+    return (dataInt >> bitPos) & mask;
+}
+
+static uint32_t benchByteLoopExtract3(uint32_t iterations) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        const uint8_t* data = bcmFrames[i & BENCH_FRAME_MASK].data;
+        for (int s = 0; s < 3; s++) {
+            sum += byteLoopExtractBits(data, benchBCMSignals[s].startBit, benchBCMSignals[s].length);
+        }
+    }
+    return sum;
+}
+
+static uint32_t benchExtractBitsFromWord3(uint32_t iterations) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint64_t word = loadCANWord(bcmFrames[i & BENCH_FRAME_MASK].data);
+        for (int s = 0; s < 3; s++) {
+            sum += extractBitsFromWord(word, benchBCMSignals[s].startBit, benchBCMSignals[s].length);
+        }
+    }
+    return sum;
+}
+
+static uint32_t benchExtractSignals3(uint32_t iterations) {
+    uint32_t values[3];
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        extractSignals(bcmFrames[i & BENCH_FRAME_MASK].data, benchBCMSignals, values, 3);
+        sum += values[0] + values[1] + values[2];
+    }
+    return sum;
+}
+
+static uint32_t benchParseBCMLampStatus(uint32_t iterations) {
+    BCMLampStatus status;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += parseBCMLampStatus(bcmFrames[i & BENCH_FRAME_MASK], status) + status.pudLampRequest;
+    }
+    return sum;
+}
+
+static uint32_t benchParseLockingSystemsStatus(uint32_t iterations) {
+    LockingSystemsStatus status;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += parseLockingSystemsStatus(lockFrames[i & BENCH_FRAME_MASK], status) + status.vehicleLockStatus;
+    }
+    return sum;
+}
+
+static uint32_t benchParsePowertrainData(uint32_t iterations) {
+    PowertrainData data;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += parsePowertrainData(powertrainFrames[i & BENCH_FRAME_MASK], data) + data.transmissionParkStatus;
+    }
+    return sum;
+}
+
+static uint32_t benchParseBatteryManagement(uint32_t iterations) {
+    BatteryManagement data;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += parseBatteryManagement(batteryFrames[i & BENCH_FRAME_MASK], data) + data.batterySOC;
+    }
+    return sum;
+}
+
+static uint32_t benchIsTargetCANMessage(uint32_t iterations) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += isTargetCANMessage(benchLookupIds[i & BENCH_FRAME_MASK]);
+    }
+    return sum;
+}
+
+// Software filter over a queued run of BENCH_FRAME_SET_SIZE frames
+static uint32_t benchSelectCANFramesToDecode(uint32_t iterations) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += selectCANFramesToDecode(lookupFrames, BENCH_FRAME_SET_SIZE);
+    }
+    return sum;
+}
+
+static uint32_t benchDispatchFrames(const CANMessage* frames, uint32_t iterations) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += dispatchCANMessage(frames[i & BENCH_FRAME_MASK]);
+    }
+    return sum;
+}
+
+static uint32_t benchDispatchIgnored(uint32_t iterations) {
+    return benchDispatchFrames(ignoredFrames, iterations);
+}
+
+// Change filter hit: freshness refresh only
+static uint32_t benchDispatchUnchanged(uint32_t iterations) {
+    return benchDispatchFrames(repeatedFrames, iterations);
+}
+
+// Full parse and state update on every frame
+static uint32_t benchDispatchChanged(uint32_t iterations) {
+    return benchDispatchFrames(changingFrames, iterations);
+}
+
+static uint32_t benchUpdateBCMLampState(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        updateBCMLampState(bcmStatuses[i & BENCH_FRAME_MASK]);
+    }
+    return getVehicleStateFlags();
+}
+
+static uint32_t benchUpdateLockingSystemsState(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        updateLockingSystemsState(lockStatuses[i & BENCH_FRAME_MASK]);
+    }
+    return getVehicleStateFlags();
+}
+
+static uint32_t benchUpdatePowertrainState(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        updatePowertrainState(powertrainStatuses[i & BENCH_FRAME_MASK]);
+    }
+    return getVehicleStateFlags();
+}
+
+static uint32_t benchUpdateBatteryState(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        updateBatteryState(batteryStatuses[i & BENCH_FRAME_MASK]);
+    }
+    return getVehicleStateFlags();
+}
+
+static const BenchKernel benchKernels[] = {
+    {"extractBits", benchExtractBits},
+    {"extractBits16", benchExtractBits16},
+    {"setBits", benchSetBits},
+    {"extractSignals/8", benchExtractSignals},
+    {"byteLoopExtractBits/3", benchByteLoopExtract3},
+    {"extractBitsFromWord/3", benchExtractBitsFromWord3},
+    {"extractSignals/3", benchExtractSignals3},
+    {"parseBCMLampStatus", benchParseBCMLampStatus},
+    {"parseLockingSystemsStatus", benchParseLockingSystemsStatus},
+    {"parsePowertrainData", benchParsePowertrainData},
+    {"parseBatteryManagement", benchParseBatteryManagement},
+    {"isTargetCANMessage", benchIsTargetCANMessage},
+    {"selectCANFramesToDecode/8", benchSelectCANFramesToDecode},
+    {"dispatchCANMessage/ignored", benchDispatchIgnored},
+    {"dispatchCANMessage/unchanged", benchDispatchUnchanged},
+    {"dispatchCANMessage/changed", benchDispatchChanged},
+    {"updateBCMLampState", benchUpdateBCMLampState},
+    {"updateLockingSystemsState", benchUpdateLockingSystemsState},
+    {"updatePowertrainState", benchUpdatePowertrainState},
+    {"updateBatteryState", benchUpdateBatteryState},
+};
+
+const BenchKernel* getBenchKernels() {
+    return benchKernels;
+}
+
+size_t getBenchKernelCount() {
+    return sizeof(benchKernels) / sizeof(benchKernels[0]);
+}
@@ -0,0 +1,38 @@
+#ifndef BENCH_KERNELS_H
+#define BENCH_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Microbenchmark kernels for the decode and state hot paths
+ *
+ * Each kernel runs one hot-path operation `iterations` times over a small
+ * rotating set of real frames and returns a checksum of the results, so the
+ * compiler cannot drop the work. The same table is driven by two runners:
+ *   - bench/native/bench_main.cpp: Google Benchmark on the host ([env:bench]),
+ *     reported in ns/op and compared against bench/baselines/native.json
+ *   - bench/target/bench_target.cpp: on the ESP32-S3 ([env:bench-esp32]),
+ *     reported in CPU cycles/op from ESP.getCycleCount()
+ *
+ * One op is one call of the measured function (one frame for the parse,
+ * dispatch and update kernels). Kernel names are the baseline keys - rename
+ * one only together with the baseline files.
+ */
+
+#define BENCH_FRAME_SET_SIZE 8          // Rotating frames per kernel (power of two)
+
+typedef uint32_t (*BenchKernelFunction)(uint32_t iterations);
+
+struct BenchKernel {
+    const char* name;
+    BenchKernelFunction run;
+};
+
+// Initialize the state manager and the frame sets; call once before any kernel
+void prepareBenchKernels();
+
+const BenchKernel* getBenchKernels();
+size_t getBenchKernelCount();
+
+#endif // BENCH_KERNELS_H
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include "mock_arduino.h"
+#include "../bench_kernels.h"
+
+/**
+ * Host runner for the bench kernels ([env:bench], Google Benchmark)
+ *
+ *   pio run -e bench
+ *   .pio/build/bench/program --benchmark_out=bench.json --benchmark_out_format=json
+ *   python3 tools/bench_compare.py bench.json
+ *
+ * Each benchmark iteration runs a kernel BENCH_BATCH times so the timer
+ * overhead stays out of the few-nanosecond kernels; items_per_second counts
+ * ops, and bench_compare.py turns it into the ns/op figure kept in
+ * bench/baselines/native.json. LOG_* output goes to the ArduinoMock serial
+ * buffer on the native build, so capture is switched off to keep formatting
+ * cost out of the measurement.
+ */
+
+#define BENCH_BATCH 1024
+
+static void runBenchKernel(benchmark::State& state, const BenchKernel* kernel) {
+    uint32_t sink = 0;
+    for (auto _ : state) {
+        sink += kernel->run(BENCH_BATCH);
+    }
+    benchmark::DoNotOptimize(sink);
+
+    state.SetItemsProcessed(state.iterations() * BENCH_BATCH);
+}
+
+int main(int argc, char** argv) {
+    ArduinoMock::instance().reset();
+    ArduinoMock::instance().setSerialCapture(false);
+    prepareBenchKernels();
+
+    const BenchKernel* kernels = getBenchKernels();
+    for (size_t i = 0; i < getBenchKernelCount(); i++) {
+        benchmark::RegisterBenchmark(kernels[i].name, runBenchKernel, &kernels[i]);
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
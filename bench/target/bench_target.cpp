@@ -0,0 +1,60 @@
+#include <Arduino.h>
+#include "../../src/config.h"
+#include "../../src/logger.h"
+#include "../bench_kernels.h"
+
+/**
+ * On-target runner for the bench kernels ([env:bench-esp32])
+ *
+ *   pio run -e bench-esp32 -t upload && pio device monitor | tee bench_esp32.log
+ *   python3 tools/bench_compare.py bench_esp32.log
+ *
+ * Replaces the application: each kernel runs BENCH_TARGET_RUNS times over
+ * BENCH_TARGET_ITERATIONS ops, timed with the CPU cycle counter
+ * (ESP.getCycleCount()). The fastest run is reported, which drops the runs
+ * that a tick or WiFi/USB interrupt landed in. Logging is turned down to
+ * errors so the deferred log queue stays out of the measurement.
+ */
+
+#define BENCH_TARGET_ITERATIONS 1024
+#define BENCH_TARGET_RUNS 16
+#define BENCH_TARGET_REPEAT_MS 10000   // Results are printed again for late monitors
+
+static volatile uint32_t benchSink;
+
+static void runTargetBenchmarks() {
+    Serial.printf("BENCH_BEGIN %s %s @ %lu MHz, %d ops x %d runs\n", FIRMWARE_VERSION, ESP.getChipModel(),
+                  (unsigned long)ESP.getCpuFreqMHz(), BENCH_TARGET_ITERATIONS, BENCH_TARGET_RUNS);
+
+    const BenchKernel* kernels = getBenchKernels();
+    for (size_t i = 0; i < getBenchKernelCount(); i++) {
+        benchSink = kernels[i].run(BENCH_TARGET_ITERATIONS);   // Warm the caches
+
+        uint32_t bestCycles = UINT32_MAX;
+        for (int run = 0; run < BENCH_TARGET_RUNS; run++) {
+            uint32_t start = ESP.getCycleCount();
+            benchSink = kernels[i].run(BENCH_TARGET_ITERATIONS);
+            uint32_t cycles = ESP.getCycleCount() - start;
+            if (cycles < bestCycles) {
+                bestCycles = cycles;
+            }
+        }
+        Serial.printf("BENCH %-32s %10.1f cycles/op\n", kernels[i].name,
+                      (double)bestCycles / BENCH_TARGET_ITERATIONS);
+    }
+    Serial.println("BENCH_END");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);   // USB CDC enumeration
+
+    setAllLogModuleLevels(DEBUG_LEVEL_ERROR);
+    prepareBenchKernels();
+    runTargetBenchmarks();
+}
+
+void loop() {
+    delay(BENCH_TARGET_REPEAT_MS);
+    runTargetBenchmarks();
+}
@@ -26,12 +26,22 @@ struct CANTestResult {
     bool receiving_messages;
     uint32_t message_count;
     uint32_t last_message_time;
-    String status;
+    char status[64];                // Fixed buffer: no String on the heap
 };
 
 CANTestResult can1_result = {false, false, 0, 0, "Not tested"};
 CANTestResult can2_result = {false, false, 0, 0, "Not tested"};
 
+// Set the status text, with an optional detail (e.g. an esp_err_t name), and print it as a failure
+static void failTest(CANTestResult& result, const char* text, const char* detail = nullptr) {
+    if (detail) {
+        snprintf(result.status, sizeof(result.status), "%s: %s", text, detail);
+    } else {
+        snprintf(result.status, sizeof(result.status), "%s", text);
+    }
+    Serial.printf("  ✗ %s\n", result.status);
+}
+
 // CAN1 (Built-in ESP32) configuration
 static const twai_general_config_t can1_config = {
     .mode = TWAI_MODE_LISTEN_ONLY,
@@ -59,21 +69,19 @@ void testCAN1() {
     // Install and start TWAI driver
     esp_err_t result = twai_driver_install(&can1_config, &timing_config, &filter_config);
     if (result != ESP_OK) {
-        can1_result.status = "Driver install failed: " + String(esp_err_to_name(result));
-        Serial.println("  ✗ " + can1_result.status);
+        failTest(can1_result, "Driver install failed", esp_err_to_name(result));
         return;
     }
     
     result = twai_start();
     if (result != ESP_OK) {
-        can1_result.status = "Driver start failed: " + String(esp_err_to_name(result));
-        Serial.println("  ✗ " + can1_result.status);
+        failTest(can1_result, "Driver start failed", esp_err_to_name(result));
         twai_driver_uninstall();
         return;
     }
     
     can1_result.initialized = true;
-    can1_result.status = "Initialized successfully";
+    snprintf(can1_result.status, sizeof(can1_result.status), "Initialized successfully");
     Serial.println("  ✓ CAN1 initialized successfully");
     
     // Quick test for immediate messages
@@ -100,20 +108,18 @@ void testCAN2() {
     
     // Initialize MCP2515 with 500kbps
     if (CAN2.setBitrate(CAN_500KBPS, MCP_16MHZ) != MCP2515::ERROR_OK) {
-        can2_result.status = "MCP2515 setBitrate failed";
-        Serial.println("  ✗ " + can2_result.status);
+        failTest(can2_result, "MCP2515 setBitrate failed");
         return;
     }
     
     // Set to listen-only mode
     if (CAN2.setListenOnlyMode() != MCP2515::ERROR_OK) {
-        can2_result.status = "MCP2515 setListenOnlyMode failed";
-        Serial.println("  ✗ " + can2_result.status);
+        failTest(can2_result, "MCP2515 setListenOnlyMode failed");
         return;
     }
     
     can2_result.initialized = true;
-    can2_result.status = "Initialized successfully";
+    snprintf(can2_result.status, sizeof(can2_result.status), "Initialized successfully");
     Serial.println("  ✓ CAN2 (MCP2515) initialized successfully");
     
     // Quick test for immediate messages
@@ -129,26 +135,21 @@ void testCAN2() {
     }
 }
 
-void printResults() {
-    Serial.println("CAN1 (X1 header - Built-in ESP32):");
-    Serial.println("  Initialized: " + String(can1_result.initialized ? "✓" : "✗"));
-    Serial.println("  Status: " + can1_result.status);
-    Serial.println("  Receiving: " + String(can1_result.receiving_messages ? "✓" : "✗"));
-    Serial.println("  Messages: " + String(can1_result.message_count));
-    if (can1_result.last_message_time > 0) {
-        Serial.println("  Last msg: " + String((millis() - can1_result.last_message_time) / 1000) + " sec ago");
+static void printResult(const char* title, const CANTestResult& result) {
+    Serial.println(title);
+    Serial.printf("  Initialized: %s\n", result.initialized ? "✓" : "✗");
+    Serial.printf("  Status: %s\n", result.status);
+    Serial.printf("  Receiving: %s\n", result.receiving_messages ? "✓" : "✗");
+    Serial.printf("  Messages: %lu\n", (unsigned long)result.message_count);
+    if (result.last_message_time > 0) {
+        Serial.printf("  Last msg: %lu sec ago\n", (unsigned long)((millis() - result.last_message_time) / 1000));
     }
-    
+}
+
+void printResults() {
+    printResult("CAN1 (X1 header - Built-in ESP32):", can1_result);
     Serial.println();
-    
-    Serial.println("CAN2 (X2 header - MCP2515):");
-    Serial.println("  Initialized: " + String(can2_result.initialized ? "✓" : "✗"));
-    Serial.println("  Status: " + can2_result.status);
-    Serial.println("  Receiving: " + String(can2_result.receiving_messages ? "✓" : "✗"));
-    Serial.println("  Messages: " + String(can2_result.message_count));
-    if (can2_result.last_message_time > 0) {
-        Serial.println("  Last msg: " + String((millis() - can2_result.last_message_time) / 1000) + " sec ago");
-    }
+    printResult("CAN2 (X2 header - MCP2515):", can2_result);
 }
 
 void setup() {
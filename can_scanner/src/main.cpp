@@ -1,9 +1,25 @@
 // CAN Scanner - Simple diagnostic tool to dump all CAN bus activity
 // This is a minimal standalone program to help diagnose CAN bus connectivity issues
+//
+// Built with SCANNER_SNIFFER_MODE=1 (pio run -e sniffer) it instead streams
+// every frame as binary packets for full-bus captures; see README.md and
+// tools/can_sniffer_decode.py on the host.
 
 #include <Arduino.h>
 #include "driver/twai.h"
 #include "esp_err.h"
+#include "esp_timer.h"
+
+#ifndef SCANNER_SNIFFER_MODE
+#define SCANNER_SNIFFER_MODE 0
+#endif
+
+// Sniffer mode: frames are batched into COBS-framed packets with a CRC-16 and
+// written to USB CDC as fast as the host reads them
+#define SNIFFER_RX_QUEUE_LEN 1024          // TWAI driver queue: ~250 ms of a saturated 500 kbps bus
+#define SNIFFER_BATCH_FRAMES 32            // Frames per packet
+#define SNIFFER_FLUSH_MS 5                 // Longest wait before a partial batch is sent
+#define SNIFFER_STATUS_INTERVAL_MS 1000    // Driver counters packet
 
 // Pin definitions for ESP32-CAN-X2 board
 #define CAN_TX_PIN 7
@@ -17,7 +33,7 @@ static const twai_general_config_t g_config = {
     .clkout_io = TWAI_IO_UNUSED,
     .bus_off_io = TWAI_IO_UNUSED,
     .tx_queue_len = 0,
-    .rx_queue_len = 50,
+    .rx_queue_len = SCANNER_SNIFFER_MODE ? SNIFFER_RX_QUEUE_LEN : 50,
     .alerts_enabled = TWAI_ALERT_RX_DATA | TWAI_ALERT_ERR_PASS | TWAI_ALERT_BUS_ERROR | 
                       TWAI_ALERT_RX_QUEUE_FULL | TWAI_ALERT_ERR_ACTIVE,
     .clkout_divider = 0,
@@ -27,10 +43,11 @@ static const twai_general_config_t g_config = {
 // Standard ESP-IDF timing configuration for 500kbps
 static const twai_timing_config_t t_config = TWAI_TIMING_CONFIG_500KBITS();
 
-// Accept all messages filter
+// Accept all messages filter (mask bits set to 1 are "don't care"; a zero
+// mask would only pass frames whose ID and data match the code exactly)
 static const twai_filter_config_t f_config = {
     .acceptance_code = 0x00000000,
-    .acceptance_mask = 0x00000000,
+    .acceptance_mask = 0xFFFFFFFF,
     .single_filter = true
 };
 
@@ -83,15 +100,156 @@ void setup() {
     Serial.println("SUCCESS");
     
     Serial.println();
+#if SCANNER_SNIFFER_MODE
+    Serial.printf("Sniffer mode: %d-frame RX queue, binary packets follow (tools/can_sniffer_decode.py)\n",
+                  SNIFFER_RX_QUEUE_LEN);
+    Serial.write((uint8_t)0x00);   // Delimiter: the banner is not part of the first packet
+    Serial.flush();
+#else
     Serial.println("CAN Scanner ready - listening for ANY messages...");
     Serial.println("Output format: [TIME] ID=0xXXX DLC=X DATA=[XX XX XX XX XX XX XX XX]");
     Serial.println("Press Ctrl+C to stop");
     Serial.println();
+#endif
     
     startTime = millis();
     lastStatsTime = startTime;
 }
 
+#if SCANNER_SNIFFER_MODE
+// Packet layout before COBS encoding (all fields little-endian):
+//   type (1), sequence (1), payload, CRC-16/CCITT-FALSE of type..payload (2)
+// Frames payload: count (1), then per frame timestamp_us (4, esp_timer low
+//   32 bits at dequeue), id (4, bit 31 extended, bit 30 remote), dlc (1), data (8)
+// Status payload: uptime_ms, frames_sent, rx_missed, rx_overrun, bus_errors (4 each),
+//   queued frames (2), TWAI state (1)
+// Each encoded packet ends with a 0x00 delimiter.
+#define SNIFFER_PACKET_FRAMES 0x01
+#define SNIFFER_PACKET_STATUS 0x02
+#define SNIFFER_FRAME_RECORD_BYTES 17
+#define SNIFFER_ID_EXTENDED 0x80000000UL
+#define SNIFFER_ID_REMOTE 0x40000000UL
+#define SNIFFER_MAX_PACKET (3 + SNIFFER_BATCH_FRAMES * SNIFFER_FRAME_RECORD_BYTES + 2)
+
+static uint8_t packet[SNIFFER_MAX_PACKET];
+static uint8_t encoded[SNIFFER_MAX_PACKET + SNIFFER_MAX_PACKET / 254 + 2];
+static uint8_t packetSequence = 0;
+static uint32_t framesSent = 0;
+
+static uint16_t crc16Ccitt(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Consistent Overhead Byte Stuffing: no 0x00 in the output, at most one extra byte per 254
+static size_t cobsEncode(const uint8_t* input, size_t length, uint8_t* output) {
+    size_t codeIndex = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (input[i] == 0) {
+            output[codeIndex] = code;
+            codeIndex = out++;
+            code = 1;
+            continue;
+        }
+        output[out++] = input[i];
+        if (++code == 0xFF) {
+            output[codeIndex] = code;
+            codeIndex = out++;
+            code = 1;
+        }
+    }
+    output[codeIndex] = code;
+    return out;
+}
+
+static void putLE32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+// Add CRC, encode, delimit and write; length is type..payload
+static void sendPacket(size_t length) {
+    uint16_t crc = crc16Ccitt(packet, length);
+    packet[length++] = (uint8_t)crc;
+    packet[length++] = (uint8_t)(crc >> 8);
+    size_t encodedLength = cobsEncode(packet, length, encoded);
+    encoded[encodedLength++] = 0x00;
+    Serial.write(encoded, encodedLength);
+    packetSequence++;
+}
+
+static void sendStatusPacket() {
+    twai_status_info_t status;
+    if (twai_get_status_info(&status) != ESP_OK) {
+        return;
+    }
+    packet[0] = SNIFFER_PACKET_STATUS;
+    packet[1] = packetSequence;
+    putLE32(&packet[2], millis());
+    putLE32(&packet[6], framesSent);
+    putLE32(&packet[10], status.rx_missed_count);
+    putLE32(&packet[14], status.rx_overrun_count);
+    putLE32(&packet[18], status.bus_error_count);
+    packet[22] = (uint8_t)status.msgs_to_rx;
+    packet[23] = (uint8_t)(status.msgs_to_rx >> 8);
+    packet[24] = (uint8_t)status.state;
+    sendPacket(25);
+}
+
+// Block until a frame arrives (or SNIFFER_FLUSH_MS), then take whatever else
+// is already queued, up to one batch
+void snifferLoop() {
+    packet[0] = SNIFFER_PACKET_FRAMES;
+    packet[1] = packetSequence;
+    uint8_t count = 0;
+    size_t offset = 3;
+    
+    twai_message_t message;
+    TickType_t wait = pdMS_TO_TICKS(SNIFFER_FLUSH_MS);
+    while (count < SNIFFER_BATCH_FRAMES && twai_receive(&message, wait) == ESP_OK) {
+        uint32_t id = message.identifier;
+        if (message.extd) {
+            id |= SNIFFER_ID_EXTENDED;
+        }
+        if (message.rtr) {
+            id |= SNIFFER_ID_REMOTE;
+        }
+        uint8_t dlc = message.data_length_code > 8 ? 8 : message.data_length_code;
+        putLE32(&packet[offset], (uint32_t)esp_timer_get_time());
+        putLE32(&packet[offset + 4], id);
+        packet[offset + 8] = dlc;
+        memset(&packet[offset + 9], 0, 8);
+        memcpy(&packet[offset + 9], message.data, dlc);
+        offset += SNIFFER_FRAME_RECORD_BYTES;
+        count++;
+        wait = 0;
+    }
+    
+    if (count > 0) {
+        packet[2] = count;
+        sendPacket(offset);
+        framesSent += count;
+        totalMessages += count;
+    }
+    
+    unsigned long currentTime = millis();
+    if (currentTime - lastStatsTime >= SNIFFER_STATUS_INTERVAL_MS) {
+        sendStatusPacket();
+        lastStatsTime = currentTime;
+    }
+}
+#endif
+
 void printDriverStatus() {
     twai_status_info_t status;
     esp_err_t result = twai_get_status_info(&status);
@@ -134,6 +292,10 @@ void checkAlerts() {
 }
 
 void loop() {
+#if SCANNER_SNIFFER_MODE
+    snifferLoop();
+    return;
+#endif
     unsigned long currentTime = millis();
     
     // Check for alerts
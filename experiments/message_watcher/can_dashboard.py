@@ -8,16 +8,24 @@ selected signals in a live, updating dashboard format.
 
 Usage:
     python can_dashboard.py <can_interface>
+    python can_dashboard.py --telemetry [PORT]
 
 Examples:
     python can_dashboard.py can0
     python can_dashboard.py slcan0
+    python can_dashboard.py --telemetry
 
 The script uses the ford_lincoln_base_pt.dbc file in the same directory
 to decode messages and displays only the configured signals in a dashboard format.
+
+With --telemetry it needs no CAN interface: it listens for the UDP datagrams
+the firmware streams when built with ENABLE_TELEMETRY (src/telemetry_protocol.h)
+and shows the values the firmware decoded, plus its health counters.
 """
 
 import argparse
+import socket
+import struct
 import sys
 import time
 import os
@@ -51,6 +59,72 @@ DASHBOARD_CONFIG = {
     },
 }
 
+# Firmware telemetry datagram, version 2 (layout in src/telemetry_protocol.h)
+TELEMETRY_PORT = 47150
+TELEMETRY_MAGIC = 0xF150
+TELEMETRY_VERSION = 2
+TELEMETRY_HEADER = struct.Struct('<HBBIIIBBBBIIIIIIHBB')
+TELEMETRY_CHANGE = struct.Struct('<II')
+TELEMETRY_HISTORY_HEADER = struct.Struct('<II')
+TELEMETRY_HISTORY_SLOT = struct.Struct('<HBBBB')
+TELEMETRY_HISTORY_SIGNALS = ["PudLamp_D_Rq", "TrnPrkSys_D_Actl", "BSBattSOC", "Veh_Lock_Status"]
+TELEMETRY_SOURCES = ["BCM_Lamp_Stat_FD1", "Locking_Systems_2_FD1", "PowertrainData_10", "Battery_Mgmt_3_FD1"]
+TELEMETRY_RECOVERY_STATES = ["IDLE", "RESET_CONTROLLER", "STOP_BUS", "START_BUS", "CONFIGURE"]
+
+
+def decode_signal_word(word):
+    """Split the firmware's VehicleSignals word into DBC signal values and flags"""
+    return {
+        'PudLamp_D_Rq': word & 0x3,
+        'TrnPrkSys_D_Actl': (word >> 2) & 0xF,
+        'BSBattSOC': (word >> 6) & 0x7F,
+        'Veh_Lock_Status': (word >> 13) & 0xFF,
+        'unlocked': bool(word & (1 << 21)),
+        'parked': bool(word & (1 << 22)),
+        'bedlight_requested': bool(word & (1 << 23)),
+        'system_ready': bool(word & (1 << 24)),
+        'manual_override': bool(word & (1 << 25)),
+        'manual_state': bool(word & (1 << 26)),
+    }
+
+
+def decode_telemetry_datagram(datagram):
+    """Return (header dict, [(time_ms, signal word), ...], history dict or None), or None for a
+    foreign/short datagram"""
+    if len(datagram) < TELEMETRY_HEADER.size:
+        return None
+    fields = TELEMETRY_HEADER.unpack_from(datagram)
+    magic, version, change_count = fields[0], fields[1], fields[2]
+    if magic != TELEMETRY_MAGIC or version != TELEMETRY_VERSION:
+        return None
+    header = dict(zip(
+        ['sequence', 'uptime_ms', 'signals', 'outputs', 'stale_mask', 'recovery_state', 'history_slots',
+         'frames_dispatched', 'parse_errors', 'can_errors', 'queue_drops', 'controller_overflows',
+         'change_drops', 'queue_high_water', 'history_signal'], fields[3:18]))
+    slot_count = header['history_slots']
+    history_offset = TELEMETRY_HEADER.size + change_count * TELEMETRY_CHANGE.size
+    expected = history_offset
+    if slot_count:
+        expected += TELEMETRY_HISTORY_HEADER.size + slot_count * TELEMETRY_HISTORY_SLOT.size
+    if len(datagram) != expected:
+        return None
+    changes = [TELEMETRY_CHANGE.unpack_from(datagram, TELEMETRY_HEADER.size + i * TELEMETRY_CHANGE.size)
+               for i in range(change_count)]
+
+    history = None
+    if slot_count:
+        slot_ms, start_ms = TELEMETRY_HISTORY_HEADER.unpack_from(datagram, history_offset)
+        slots = []
+        for i in range(slot_count):
+            changes_in_slot, low, high, last, flags = TELEMETRY_HISTORY_SLOT.unpack_from(
+                datagram, history_offset + TELEMETRY_HISTORY_HEADER.size + i * TELEMETRY_HISTORY_SLOT.size)
+            slots.append({'changes': changes_in_slot, 'min': low, 'max': high, 'last': last,
+                          'known': bool(flags & 1)})
+        signal = header['history_signal']
+        history = {'signal': TELEMETRY_HISTORY_SIGNALS[signal] if signal < len(TELEMETRY_HISTORY_SIGNALS)
+                   else str(signal), 'slot_ms': slot_ms, 'start_ms': start_ms, 'slots': slots}
+    return header, changes, history
+
 
 class CANDashboard:
     def __init__(self, can_interface, dbc_file="ford_lincoln_base_pt.dbc", two_column_mode=False):
@@ -367,9 +441,14 @@ class CANDashboard:
             else:
                 display_column(messages)
 
+        self.display_extra()
         print("\n" + "=" * 80 if not self.two_column_mode else "=" * 200)
         print("Press Ctrl+C to stop")
 
+    def display_extra(self):
+        """Additional dashboard sections (none for a CAN interface)."""
+        pass
+
     def message_listener(self):
         """Background thread to listen for CAN messages."""
         while self.running:
@@ -430,13 +509,137 @@ class CANDashboard:
             if runtime > 0:
                 print(f"Message rate: {self.stats['total_messages']/runtime:.1f} msg/sec")
             
-            # Close resources
-            if self.bus:
-                self.bus.shutdown()
-                print(f"Disconnected from {self.can_interface}")
+            self.close()
         
         return True
 
+    def close(self):
+        """Close the CAN bus connection."""
+        if self.bus:
+            self.bus.shutdown()
+            print(f"Disconnected from {self.can_interface}")
+
+
+class TelemetryDashboard(CANDashboard):
+    """Dashboard fed by the firmware's UDP telemetry stream instead of a CAN interface"""
+
+    def __init__(self, port, two_column_mode=False):
+        self.port = port
+        self.socket = None
+        self.header = None
+        self.sources = None
+        self.last_sequence = None
+        self.history = {}
+        super().__init__(f"udp:{port}", "(decoded by firmware)", two_column_mode)
+        self.stats.update({'datagrams': 0, 'lost_datagrams': 0, 'signal_changes': 0})
+
+    def load_dbc(self):
+        """No DBC needed: the firmware sends decoded values; streamed signals only."""
+        streamed = decode_signal_word(0)
+        for msg_name, config in DASHBOARD_CONFIG.items():
+            self.message_data[msg_name] = {name: None for name in config['signals'] if name in streamed}
+            self.message_timestamps[msg_name] = None
+        return True
+
+    def connect_can(self):
+        """Bind the UDP port the firmware sends to (broadcast or unicast)."""
+        try:
+            self.socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+            self.socket.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            self.socket.bind(('', self.port))
+            self.socket.settimeout(1.0)
+            print(f"Listening for telemetry on UDP port {self.port}")
+            return True
+        except OSError as e:
+            print(f"Error binding UDP port {self.port}: {e}")
+            return False
+
+    def message_listener(self):
+        """Background thread to receive telemetry datagrams."""
+        while self.running:
+            try:
+                datagram, self.sources = self.socket.recvfrom(2048)
+            except socket.timeout:
+                continue
+            except OSError as e:
+                if self.running:
+                    print(f"Error in telemetry listener: {e}")
+                break
+
+            self.stats['total_messages'] += 1
+            decoded = decode_telemetry_datagram(datagram)
+            if decoded:
+                self.stats['decoded_messages'] += 1
+                self.update_telemetry(*decoded)
+
+    def update_telemetry(self, header, changes, history):
+        """Apply one datagram: current signal word, health counters, signal history, sequence gaps."""
+        sequence = header['sequence']
+        if self.last_sequence is not None and sequence > self.last_sequence + 1:
+            self.stats['lost_datagrams'] += sequence - self.last_sequence - 1
+        self.last_sequence = sequence
+
+        signals = decode_signal_word(header['signals'])
+        now = time.time()
+        with self.data_lock:
+            self.header = header
+            if history:
+                self.history[history['signal']] = history
+            self.stats['datagrams'] += 1
+            self.stats['signal_changes'] += len(changes)
+            for index, msg_name in enumerate(TELEMETRY_SOURCES):
+                for signal_name in self.message_data.get(msg_name, {}):
+                    self.message_data[msg_name][signal_name] = signals[signal_name]
+                # Firmware marks sources it has not heard from within CAN_TIMEOUT_MS
+                if not header['stale_mask'] & (1 << index):
+                    self.message_timestamps[msg_name] = now
+            self.stats['dashboard_updates'] += 1
+
+    def display_extra(self):
+        """Firmware flags, outputs and health counters from the latest datagram."""
+        with self.data_lock:
+            header = self.header
+            histories = list(self.history.values())
+        if header is None:
+            print("\n🛰  Waiting for telemetry...")
+            return
+
+        signals = decode_signal_word(header['signals'])
+        outputs = header['outputs']
+        recovery = header['recovery_state']
+        recovery_name = (TELEMETRY_RECOVERY_STATES[recovery]
+                         if recovery < len(TELEMETRY_RECOVERY_STATES) else str(recovery))
+        print(f"\n🛰  Firmware ({self.sources[0] if self.sources else '?'}), "
+              f"uptime {header['uptime_ms'] / 1000:.1f}s, sequence {header['sequence']}")
+        print("-" * 60)
+        print(f"   Flags: ready={signals['system_ready']} parked={signals['parked']} "
+              f"unlocked={signals['unlocked']} bedlight_requested={signals['bedlight_requested']} "
+              f"override={signals['manual_override']}")
+        print(f"   Outputs: bedlight={bool(outputs & 1)} opener={bool(outputs & 2)} "
+              f"button={bool(outputs & 4)} ready_led={bool(outputs & 8)}")
+        print(f"   Frames dispatched {header['frames_dispatched']}, parse errors {header['parse_errors']}, "
+              f"CAN errors {header['can_errors']}, recovery {recovery_name}")
+        print(f"   Queue drops {header['queue_drops']} (high water {header['queue_high_water']}), "
+              f"controller overflows {header['controller_overflows']}, journal drops {header['change_drops']}")
+        print(f"   Datagrams {self.stats['datagrams']} (lost {self.stats['lost_datagrams']}), "
+              f"signal changes {self.stats['signal_changes']}")
+        for history in histories:
+            known = [slot for slot in history['slots'] if slot['known']]
+            span_h = history['slot_ms'] * len(history['slots']) / 3600000
+            if not known:
+                print(f"   History {history['signal']}: no data in the last {span_h:.0f} h")
+                continue
+            print(f"   History {history['signal']} ({span_h:.0f} h): "
+                  f"{sum(slot['changes'] for slot in known)} changes, "
+                  f"min {min(slot['min'] for slot in known)}, max {max(slot['max'] for slot in known)}, "
+                  f"last per {history['slot_ms'] // 60000} min: {' '.join(str(slot['last']) for slot in known)}")
+
+    def close(self):
+        """Close the UDP socket."""
+        if self.socket:
+            self.socket.close()
+            print(f"Stopped listening on UDP port {self.port}")
+
 
 def main():
     parser = argparse.ArgumentParser(
@@ -454,14 +657,27 @@ DASHBOARD_CONFIG dictionary at the top of this script.
 Current configuration monitors:
   - BCM_Lamp_Stat_FD1: PudLamp_D_Rq, Illuminated_Entry_Stat, Dr_Courtesy_Light_Stat
   - Locking_Systems_2_FD1: Veh_Lock_Status
+
+With --telemetry, values come from the firmware's UDP stream (ENABLE_TELEMETRY);
+signals the firmware does not track show N/A.
         """
     )
     
     parser.add_argument(
         'can_interface',
+        nargs='?',
         help='CAN interface name (e.g., can0, slcan0)'
     )
     
+    parser.add_argument(
+        '--telemetry',
+        metavar='PORT',
+        type=int,
+        nargs='?',
+        const=TELEMETRY_PORT,
+        help=f'Read the firmware UDP telemetry stream instead of a CAN interface (default port {TELEMETRY_PORT})'
+    )
+    
     parser.add_argument(
         '--dbc',
         default='ford_lincoln_base_pt.dbc',
@@ -475,9 +691,14 @@ Current configuration monitors:
     )
     
     args = parser.parse_args()
+    if (args.telemetry is None) == (args.can_interface is None):
+        parser.error('give either a CAN interface or --telemetry')
     
     # Create and run the dashboard
-    dashboard = CANDashboard(args.can_interface, args.dbc, args.two_column)
+    if args.telemetry is not None:
+        dashboard = TelemetryDashboard(args.telemetry, args.two_column)
+    else:
+        dashboard = CANDashboard(args.can_interface, args.dbc, args.two_column)
     
     try:
         success = dashboard.run()
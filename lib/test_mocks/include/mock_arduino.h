@@ -39,6 +39,8 @@ public:
     void setMillis(unsigned long time) { currentTime = time; }
     void advanceTime(unsigned long ms) { currentTime += ms; }
     unsigned long getMillis() const { return currentTime; }
+    void advanceMicros(unsigned long us) { microOffset += us; }   // Sub-millisecond steps for micros() only
+    unsigned long getMicros() const { return currentTime * 1000UL + microOffset; }
     
     // GPIO state tracking
     void setPinMode(uint8_t pin, uint8_t mode) { pinModes[pin] = mode; }
@@ -62,23 +64,29 @@ public:
     // Reset for clean tests
     void reset() {
         currentTime = 0;
+        microOffset = 0;
         pinModes.clear();
         digitalStates.clear();
         digitalReads.clear();
         serialOutput.clear();
+        serialCapture = true;
     }
     
-    // Serial output capture
-    void addSerialOutput(const std::string& output) { serialOutput += output; }
+    // Serial output capture (trace replays turn it off to keep long runs cheap)
+    void setSerialCapture(bool enabled) { serialCapture = enabled; }
+    bool isSerialCaptureEnabled() const { return serialCapture; }
+    void addSerialOutput(const std::string& output) { if (serialCapture) serialOutput += output; }
     std::string getSerialOutput() const { return serialOutput; }
     void clearSerialOutput() { serialOutput.clear(); }
 
 private:
     unsigned long currentTime = 0;
+    unsigned long microOffset = 0;
     std::map<uint8_t, uint8_t> pinModes;
     std::map<uint8_t, uint8_t> digitalStates;
     std::map<uint8_t, uint8_t> digitalReads;
     std::string serialOutput;
+    bool serialCapture = true;
 };
 
 // Mock Arduino functions
@@ -86,6 +94,10 @@ inline unsigned long millis() {
     return ArduinoMock::instance().getMillis();
 }
 
+inline unsigned long micros() {
+    return ArduinoMock::instance().getMicros();
+}
+
 inline void pinMode(uint8_t pin, uint8_t mode) {
     ArduinoMock::instance().setPinMode(pin, mode);
 }
@@ -103,6 +115,9 @@ class MockSerial {
 public:
     template<typename... Args>
     void printf(const char* format, Args... args) {
+        if (!ArduinoMock::instance().isSerialCaptureEnabled()) {
+            return;
+        }
         char buffer[256];
         snprintf(buffer, sizeof(buffer), format, args...);
         ArduinoMock::instance().addSerialOutput(std::string(buffer));
@@ -119,7 +134,8 @@ public:
 
 extern MockSerial Serial;
 
-// Mock decision logic functions with C linkage for test compatibility
+// Decision logic from state_manager.cpp and can_dispatch.cpp (both in the native
+// build), declared with C linkage for test compatibility
 extern "C" {
     bool shouldEnableBedlight(uint8_t pudLampRequest);
     bool isVehicleUnlocked(uint8_t vehicleLockStatus);
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "trace_replay.h"
+
+/**
+ * Binary CAN capture format (.f150cap) and memory-mapped reader
+ *
+ * Text captures are parsed line by line, which costs far more than the
+ * pipeline they feed. A binary capture is a fixed-record file that the reader
+ * maps into memory: opening it is O(1) whatever its size, and the ID
+ * directory and record timestamps let it seek to an ID or a time range by
+ * binary search instead of a scan.
+ *
+ * Layout (little-endian, every section 16-byte aligned):
+ *
+ *   CaptureFileHeader        64 bytes
+ *   CaptureRecord[n]         16 bytes each, in non-decreasing time order
+ *   CaptureIdEntry[ids]      16 bytes each, sorted by ID
+ *   uint32_t index[n]        record numbers grouped by ID, time order within an ID
+ *
+ * Record timestamps are 40-bit microsecond deltas from the header's base
+ * timestamp (about 12.7 days). Only standard 11-bit IDs are stored.
+ *
+ * Written by tools/can_capture_convert.py (from candump or
+ * can_embedded_logger.py logs) or writeCaptureFile(). The reader uses POSIX
+ * mmap(), i.e. Linux and macOS hosts.
+ */
+
+#define CAPTURE_FILE_MAGIC "F150CAP"    // 7 characters + NUL
+#define CAPTURE_FILE_VERSION 1
+
+struct CaptureFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;                // sizeof(CaptureRecord)
+    uint64_t baseTimestampUs;           // Capture clock of a zero record delta
+    uint64_t recordCount;
+    uint32_t idCount;
+    uint32_t reserved;
+    uint64_t recordsOffset;
+    uint64_t directoryOffset;
+    uint64_t indexOffset;
+};
+
+struct CaptureRecord {
+    uint32_t timeDeltaLow;              // Microseconds since baseTimestampUs, bits 0-31
+    uint8_t timeDeltaHigh;              // Bits 32-39
+    uint8_t length;                     // DLC, 0-8
+    uint16_t id;                        // 11-bit identifier (upper bits zero)
+    uint8_t data[8];
+};
+
+struct CaptureIdEntry {
+    uint16_t id;
+    uint16_t reserved;
+    uint32_t count;                     // Records with this ID
+    uint64_t firstIndex;                // First slot in the index for this ID
+};
+
+static_assert(sizeof(CaptureFileHeader) == 64, "CaptureFileHeader layout is part of the file format");
+static_assert(sizeof(CaptureRecord) == 16, "CaptureRecord layout is part of the file format");
+static_assert(sizeof(CaptureIdEntry) == 16, "CaptureIdEntry layout is part of the file format");
+
+#define CAPTURE_MAX_TIME_DELTA_US ((1ULL << 40) - 1)
+
+struct CaptureFile {
+    const uint8_t* base;                // Whole mapped file
+    size_t size;
+    const CaptureFileHeader* header;
+    const CaptureRecord* records;
+    const CaptureIdEntry* directory;
+    const uint32_t* index;
+};
+
+inline uint64_t captureRecordDeltaUs(const CaptureRecord& record) {
+    return ((uint64_t)record.timeDeltaHigh << 32) | record.timeDeltaLow;
+}
+
+// Map and validate a capture; false (and nothing mapped) if it is not one
+bool openCaptureFile(const char* path, CaptureFile& file);
+void closeCaptureFile(CaptureFile& file);
+
+// Write frames (any mix of IDs, timestamps non-decreasing) as a capture. Extended
+// IDs are skipped, as is everything past the 40-bit time range. Returns the
+// number of records written, or -1 on I/O error.
+long writeCaptureFile(const char* path, const TraceFrame* frames, size_t count);
+
+// A record number past the end (e.g. from a corrupt index) reads as UINT64_MAX
+// and an empty frame. A corrupt DLC above 8 reads as 8.
+uint64_t getCaptureRecordTimestampUs(const CaptureFile& file, uint64_t recordNumber);
+TraceFrame getCaptureFrame(const CaptureFile& file, uint64_t recordNumber);
+
+// First record at or after timestampUs (recordCount when none)
+uint64_t findCaptureRecordAtTime(const CaptureFile& file, uint64_t timestampUs);
+
+// Directory entry for an ID; NULL when the capture has no such frames
+const CaptureIdEntry* findCaptureId(const CaptureFile& file, uint32_t id);
+
+// Record number of the n-th frame (time order) of an ID's entry; recordCount
+// when n is past the entry or the index slot holds no valid record number
+inline uint64_t getCaptureIdRecord(const CaptureFile& file, const CaptureIdEntry& entry, uint32_t n) {
+    uint64_t recordCount = file.header->recordCount;
+    if (n >= entry.count) {
+        return recordCount;
+    }
+    uint64_t record = file.index[entry.firstIndex + n];
+    return record < recordCount ? record : recordCount;
+}
+
+// First position within an ID's entry at or after timestampUs (entry.count when none)
+uint32_t findCaptureIdRecordAtTime(const CaptureFile& file, const CaptureIdEntry& entry, uint64_t timestampUs);
+
+// Replay records [fromUs, toUs) of an open capture into the current replay session
+uint64_t replayCaptureRange(const CaptureFile& file, uint64_t fromUs, uint64_t toUs);
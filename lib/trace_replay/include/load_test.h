@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "trace_replay.h"
+#include "../../../src/load_generator.h"
+
+/**
+ * Host-side bus-load stress runs through the replay engine
+ *
+ * Generated traffic (load_generator.h) arrives at its send times in the
+ * production receive queue type (SPSCRingBuffer, CAN_RX_QUEUE_SIZE deep). A
+ * consumer modelled on loop() drains it: one pass every consumerPassUs taking
+ * up to CAN_MAX_FRAMES_PER_LOOP frames, and optionally a consumerStallUs pause
+ * every consumerStallIntervalMs (a slow serial command, a flash write). Each
+ * frame taken goes through replayTraceFrame() on the mock clock; after each
+ * one, the published signals, the derived flags and the bed light output are
+ * compared with the LoadModel of the frames delivered so far.
+ *
+ * The drop point is the lowest offered rate at which the queue overflows for
+ * a given consumer; without stalls it lies far above any CAN bus rate.
+ */
+
+struct LoadTestOptions {
+    LoadProfile profile;
+    uint32_t consumerPassUs;            // Time between two loop() passes while frames are waiting
+    uint32_t consumerStallUs;           // Pass that drains nothing for this long, 0 = never
+    uint32_t consumerStallIntervalMs;
+};
+
+struct LoadTestReport {
+    LoadGeneratorStats generated;
+    double offeredFramesPerSecond;      // Generated frames per simulated second
+    uint32_t framesDelivered;           // Taken from the queue and replayed
+    uint32_t queueDrops;
+    uint16_t queueHighWater;
+    uint32_t dlcFaultsDelivered;        // Expected dispatch.parseErrors
+    CANDispatchStats dispatch;
+    uint32_t checks;                    // Frames after which the state was compared
+    uint32_t signalMismatches;          // Published values or flags differing from the model
+    uint32_t outputMismatches;          // Bed light output differing from the model
+    unsigned long simulatedMs;
+    double wallSeconds;
+    double framesPerSecond;             // Host replay throughput of the delivered frames
+};
+
+LoadTestOptions defaultLoadTestOptions();
+LoadTestReport runLoadTest(const LoadTestOptions& options);
+// Lowest rate, stepping by stepFramesPerSecond up to maxFramesPerSecond, that drops frames; 0 if none
+uint32_t findLoadTestDropPoint(LoadTestOptions options, uint32_t stepFramesPerSecond, uint32_t maxFramesPerSecond);
+void printLoadTestReport(const LoadTestReport& report, FILE* out);
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include "mock_arduino.h"
+#include "../../../src/can_dispatch.h"
+#include "../../../src/state_manager.h"
+#include "../../../src/gpio_controller.h"
+
+/**
+ * Host-side replay of captured CAN traffic
+ *
+ * Streams recorded frames through the production pipeline - dispatch table,
+ * parsers, state manager, freshness deadlines and GPIO output logic - on the
+ * native build, with the ArduinoMock clock driven from the capture
+ * timestamps. Deadlines that fall between two frames (stale sources,
+ * readiness timeout) are applied at their own time, as loop() would.
+ *
+ * Supported captures (one frame per line, other lines are skipped):
+ *   - candump log files (candump -l / -L):  (1699999999.123456) can0 3C3#0011223344556677
+ *   - can_embedded_logger.py output:         2025-01-01 12:00:00.123 | CAN_ID:0x3C3 | data:00 11 ... | ...
+ *   - binary captures (capture_file.h), memory-mapped instead of parsed
+ * can_logger.py only records decoded signal values, not frames, so its
+ * output cannot be replayed.
+ *
+ * Replay runs as fast as possible (speed 0) or paced to the capture timing
+ * scaled by `speed` (1.0 = real time).
+ */
+
+struct TraceFrame {
+    uint64_t timestampUs;       // Capture time (format-specific epoch, only differences matter)
+    uint32_t id;
+    uint8_t length;
+    uint8_t data[8];
+};
+
+struct TraceReplayOptions {
+    double speed;               // 0 = as fast as possible, 1.0 = capture timing
+    bool captureLogs;           // Keep LOG_* output in the ArduinoMock serial buffer
+    unsigned long startMillis;  // Mock millis() at the first frame
+};
+
+struct TraceReplayReport {
+    uint64_t linesRead;
+    uint64_t framesReplayed;
+    uint64_t linesSkipped;              // Comments, headers and unparseable lines
+    CANDispatchStats dispatch;
+    unsigned long simulatedMs;          // First to last frame, capture time
+    double wallSeconds;
+    double framesPerSecond;
+    uint32_t bedlightChanges;           // Output transitions during the replay
+    uint32_t systemReadyChanges;
+    VehicleSignals finalSignals;
+    GPIOState finalOutputs;
+    uint32_t staleSourceMask;           // getStaleSourceMask() at the end
+};
+
+// Line parsers: false for anything that is not a data frame
+bool parseCandumpLine(const char* line, TraceFrame& frame);
+bool parseEmbeddedLoggerLine(const char* line, TraceFrame& frame);
+bool parseTraceLine(const char* line, TraceFrame& frame);      // Either format
+
+// Replay session: begin, feed frames/lines/files, finish
+TraceReplayOptions defaultTraceReplayOptions();
+void beginTraceReplay(const TraceReplayOptions& options);
+void replayTraceFrame(const TraceFrame& frame);
+bool replayTraceLine(const char* line);                         // false when the line was skipped
+bool replayTraceFile(const char* path);                         // Text or binary capture; false if unreadable
+void advanceTraceReplay(unsigned long ms);                      // Run the clock on with no traffic
+TraceReplayReport finishTraceReplay();
+void printTraceReplayReport(const TraceReplayReport& report, FILE* out);
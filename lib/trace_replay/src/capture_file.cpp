@@ -0,0 +1,262 @@
+#include "capture_file.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CAPTURE_STANDARD_ID_COUNT 2048
+
+// offset + count * elementSize <= size, without wrapping for crafted headers
+static bool isSectionInFile(uint64_t offset, uint64_t count, uint64_t elementSize, size_t size) {
+    return offset <= size && count <= (size - offset) / elementSize;
+}
+
+// Every section lies inside the file and the counts agree with the section sizes.
+// Record lengths and index values are checked where they are read, so opening
+// stays O(1) and does not touch the whole mapping.
+static bool isCaptureLayoutValid(const CaptureFileHeader& header, size_t size) {
+    if (memcmp(header.magic, CAPTURE_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CAPTURE_FILE_VERSION || header.recordSize != sizeof(CaptureRecord) ||
+        header.idCount > CAPTURE_STANDARD_ID_COUNT || header.recordCount > UINT32_MAX) {
+        return false;
+    }
+
+    return header.recordsOffset >= sizeof(CaptureFileHeader) && (header.recordsOffset % 16) == 0 &&
+           (header.directoryOffset % 16) == 0 && (header.indexOffset % 16) == 0 &&
+           isSectionInFile(header.recordsOffset, header.recordCount, sizeof(CaptureRecord), size) &&
+           isSectionInFile(header.directoryOffset, header.idCount, sizeof(CaptureIdEntry), size) &&
+           isSectionInFile(header.indexOffset, header.recordCount, sizeof(uint32_t), size);
+}
+
+// Directory entries are sorted and partition the index exactly
+static bool isCaptureDirectoryValid(const CaptureFileHeader& header, const CaptureIdEntry* directory) {
+    uint64_t nextIndex = 0;
+    for (uint32_t i = 0; i < header.idCount; i++) {
+        if (directory[i].id >= CAPTURE_STANDARD_ID_COUNT || directory[i].firstIndex != nextIndex ||
+            (i > 0 && directory[i].id <= directory[i - 1].id)) {
+            return false;
+        }
+        nextIndex += directory[i].count;
+    }
+    return nextIndex == header.recordCount;
+}
+
+bool openCaptureFile(const char* path, CaptureFile& file) {
+    memset(&file, 0, sizeof(file));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CaptureFileHeader)) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    const uint8_t* base = static_cast<const uint8_t*>(mapped);
+    const CaptureFileHeader* header = reinterpret_cast<const CaptureFileHeader*>(base);
+    if (!isCaptureLayoutValid(*header, (size_t)info.st_size) ||
+        !isCaptureDirectoryValid(*header, reinterpret_cast<const CaptureIdEntry*>(base + header->directoryOffset))) {
+        munmap(mapped, (size_t)info.st_size);
+        return false;
+    }
+
+    // Replays walk the records front to back
+    madvise(mapped, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+    file.base = base;
+    file.size = (size_t)info.st_size;
+    file.header = header;
+    file.records = reinterpret_cast<const CaptureRecord*>(base + header->recordsOffset);
+    file.directory = reinterpret_cast<const CaptureIdEntry*>(base + header->directoryOffset);
+    file.index = reinterpret_cast<const uint32_t*>(base + header->indexOffset);
+    return true;
+}
+
+void closeCaptureFile(CaptureFile& file) {
+    if (file.base) {
+        munmap(const_cast<uint8_t*>(file.base), file.size);
+    }
+    memset(&file, 0, sizeof(file));
+}
+
+static bool writeCaptureBytes(FILE* out, const void* data, size_t length) {
+    return length == 0 || fwrite(data, 1, length, out) == length;
+}
+
+long writeCaptureFile(const char* path, const TraceFrame* frames, size_t count) {
+    std::vector<CaptureRecord> records;
+    records.reserve(count);
+
+    uint64_t base = count > 0 ? frames[0].timestampUs : 0;
+    uint64_t lastDelta = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (frames[i].id >= CAPTURE_STANDARD_ID_COUNT || frames[i].length > 8) {
+            continue;
+        }
+
+        // Clamp so record times never decrease (time seeks rely on it)
+        uint64_t delta = frames[i].timestampUs > base ? frames[i].timestampUs - base : 0;
+        if (delta < lastDelta) {
+            delta = lastDelta;
+        }
+        if (delta > CAPTURE_MAX_TIME_DELTA_US) {
+            break;
+        }
+        lastDelta = delta;
+
+        CaptureRecord record;
+        memset(&record, 0, sizeof(record));
+        record.timeDeltaLow = (uint32_t)delta;
+        record.timeDeltaHigh = (uint8_t)(delta >> 32);
+        record.length = frames[i].length;
+        record.id = (uint16_t)frames[i].id;
+        memcpy(record.data, frames[i].data, frames[i].length);
+        records.push_back(record);
+    }
+
+    // Counting sort of record numbers by ID keeps time order within each ID
+    std::vector<uint32_t> idCounts(CAPTURE_STANDARD_ID_COUNT, 0);
+    for (const CaptureRecord& record : records) {
+        idCounts[record.id]++;
+    }
+
+    std::vector<CaptureIdEntry> directory;
+    std::vector<uint64_t> nextSlot(CAPTURE_STANDARD_ID_COUNT, 0);
+    uint64_t slot = 0;
+    for (uint32_t id = 0; id < CAPTURE_STANDARD_ID_COUNT; id++) {
+        if (idCounts[id] == 0) {
+            continue;
+        }
+        CaptureIdEntry entry;
+        entry.id = (uint16_t)id;
+        entry.reserved = 0;
+        entry.count = idCounts[id];
+        entry.firstIndex = slot;
+        directory.push_back(entry);
+        nextSlot[id] = slot;
+        slot += idCounts[id];
+    }
+
+    std::vector<uint32_t> index(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        index[nextSlot[records[i].id]++] = (uint32_t)i;
+    }
+
+    CaptureFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CAPTURE_FILE_MAGIC, sizeof(header.magic));
+    header.version = CAPTURE_FILE_VERSION;
+    header.recordSize = sizeof(CaptureRecord);
+    header.baseTimestampUs = base;
+    header.recordCount = records.size();
+    header.idCount = (uint32_t)directory.size();
+    header.recordsOffset = sizeof(CaptureFileHeader);
+    header.directoryOffset = header.recordsOffset + records.size() * sizeof(CaptureRecord);
+    header.indexOffset = header.directoryOffset + directory.size() * sizeof(CaptureIdEntry);
+
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+        return -1;
+    }
+
+    bool ok = writeCaptureBytes(out, &header, sizeof(header)) &&
+              writeCaptureBytes(out, records.data(), records.size() * sizeof(CaptureRecord)) &&
+              writeCaptureBytes(out, directory.data(), directory.size() * sizeof(CaptureIdEntry)) &&
+              writeCaptureBytes(out, index.data(), index.size() * sizeof(uint32_t));
+    ok = fclose(out) == 0 && ok;
+    return ok ? (long)records.size() : -1;
+}
+
+uint64_t getCaptureRecordTimestampUs(const CaptureFile& file, uint64_t recordNumber) {
+    if (recordNumber >= file.header->recordCount) {
+        return UINT64_MAX;
+    }
+    return file.header->baseTimestampUs + captureRecordDeltaUs(file.records[recordNumber]);
+}
+
+TraceFrame getCaptureFrame(const CaptureFile& file, uint64_t recordNumber) {
+    TraceFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    if (recordNumber >= file.header->recordCount) {
+        frame.timestampUs = UINT64_MAX;
+        return frame;
+    }
+
+    const CaptureRecord& record = file.records[recordNumber];
+    frame.timestampUs = file.header->baseTimestampUs + captureRecordDeltaUs(record);
+    frame.id = record.id;
+    frame.length = record.length <= 8 ? record.length : 8;   // DLC 9-15 still carries 8 bytes
+    memcpy(frame.data, record.data, sizeof(frame.data));
+    return frame;
+}
+
+uint64_t findCaptureRecordAtTime(const CaptureFile& file, uint64_t timestampUs) {
+    uint64_t low = 0;
+    uint64_t high = file.header->recordCount;
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if (getCaptureRecordTimestampUs(file, mid) < timestampUs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+const CaptureIdEntry* findCaptureId(const CaptureFile& file, uint32_t id) {
+    uint32_t low = 0;
+    uint32_t high = file.header->idCount;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (file.directory[mid].id == id) {
+            return &file.directory[mid];
+        }
+        if (file.directory[mid].id < id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t findCaptureIdRecordAtTime(const CaptureFile& file, const CaptureIdEntry& entry, uint64_t timestampUs) {
+    uint32_t low = 0;
+    uint32_t high = entry.count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (getCaptureRecordTimestampUs(file, getCaptureIdRecord(file, entry, mid)) < timestampUs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+uint64_t replayCaptureRange(const CaptureFile& file, uint64_t fromUs, uint64_t toUs) {
+    uint64_t replayed = 0;
+    for (uint64_t i = findCaptureRecordAtTime(file, fromUs); i < file.header->recordCount; i++) {
+        TraceFrame frame = getCaptureFrame(file, i);
+        if (frame.timestampUs >= toUs) {
+            break;
+        }
+        replayTraceFrame(frame);
+        replayed++;
+    }
+    return replayed;
+}
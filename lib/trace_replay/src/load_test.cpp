@@ -0,0 +1,164 @@
+#include "load_test.h"
+#include <chrono>
+#include <cstring>
+#include "../../../src/can_ring_buffer.h"
+
+// Queue slot: the frame and what the generator put in it
+struct LoadQueuedFrame {
+    CANFrame frame;
+    LoadFrameInfo info;
+};
+
+struct LoadTestRun {
+    LoadTestOptions options;
+    LoadTestReport report;
+    LoadModel model;
+    SPSCRingBuffer<LoadQueuedFrame, CAN_RX_QUEUE_SIZE> queue;
+    uint64_t nextPassUs;
+    uint64_t nextStallUs;
+};
+
+static LoadTestRun run;
+
+static void checkLoadState() {
+    const LoadModel& model = run.model;
+    VehicleSignals signals = getVehicleSignals();
+    const uint8_t published[LOAD_SIGNAL_COUNT] = {
+        (uint8_t)signals.pudLampRequest, (uint8_t)signals.vehicleLockStatus,
+        (uint8_t)signals.transmissionParkStatus, (uint8_t)signals.batterySOC
+    };
+
+    bool signalsMatch = signals.isParked == expectLoadParked(model) &&
+                        signals.isUnlocked == expectLoadUnlocked(model);
+    for (uint8_t signal = 0; signal < LOAD_SIGNAL_COUNT; signal++) {
+        if ((model.seenMask & (1u << signal)) && published[signal] != model.values[signal]) {
+            signalsMatch = false;
+        }
+    }
+
+    // Any delivered value makes the system ready (the runs are far shorter than the readiness timeout)
+    bool bedlight = model.seenMask != 0 && expectLoadBedlight(model);
+    run.report.checks++;
+    if (!signalsMatch) {
+        run.report.signalMismatches++;
+    }
+    if (getGPIOState().bedlight != bedlight) {
+        run.report.outputMismatches++;
+    }
+}
+
+// One loop() pass at timeUs: drain up to CAN_MAX_FRAMES_PER_LOOP frames
+static void runConsumerPass(uint64_t timeUs) {
+    const LoadTestOptions& options = run.options;
+    if (options.consumerStallUs != 0 && options.consumerStallIntervalMs != 0 && timeUs >= run.nextStallUs) {
+        run.nextStallUs += options.consumerStallIntervalMs * 1000ULL;
+        run.nextPassUs = timeUs + options.consumerStallUs;
+        return;
+    }
+
+    LoadQueuedFrame queued;
+    for (uint16_t taken = 0; taken < CAN_MAX_FRAMES_PER_LOOP && run.queue.pop(queued); taken++) {
+        TraceFrame frame;
+        frame.timestampUs = timeUs;
+        frame.id = queued.frame.id;
+        frame.length = queued.frame.length;
+        memcpy(frame.data, queued.frame.data, sizeof(frame.data));
+        replayTraceFrame(frame);
+
+        applyLoadModelFrame(run.model, queued.info);
+        if (queued.info.signal != LOAD_SIGNAL_BACKGROUND && queued.info.fault == LOAD_FAULT_DLC_MISMATCH) {
+            run.report.dlcFaultsDelivered++;
+        }
+        run.report.framesDelivered++;
+        checkLoadState();
+    }
+    run.nextPassUs = timeUs + (options.consumerPassUs != 0 ? options.consumerPassUs : 1);
+}
+
+LoadTestOptions defaultLoadTestOptions() {
+    LoadTestOptions options;
+    options.profile = defaultLoadProfile();
+    options.consumerPassUs = 500;
+    options.consumerStallUs = 0;
+    options.consumerStallIntervalMs = 0;
+    return options;
+}
+
+LoadTestReport runLoadTest(const LoadTestOptions& options) {
+    memset(&run.report, 0, sizeof(run.report));
+    run.options = options;
+    resetLoadModel(run.model);
+    LoadQueuedFrame stale;
+    while (run.queue.pop(stale)) {
+    }
+    run.queue.resetStatistics();
+    run.nextPassUs = 0;
+    run.nextStallUs = options.consumerStallIntervalMs * 1000ULL;
+
+    LoadGenerator generator;
+    beginLoadGenerator(generator, options.profile);
+    beginTraceReplay(defaultTraceReplayOptions());
+    auto wallStart = std::chrono::steady_clock::now();
+
+    LoadQueuedFrame queued;
+    uint64_t timeUs;
+    uint64_t lastUs = 0;
+    while (nextLoadFrame(generator, queued.frame, timeUs, queued.info)) {
+        while (run.nextPassUs <= timeUs) {
+            runConsumerPass(run.nextPassUs);
+        }
+        run.queue.push(queued);
+        lastUs = timeUs;
+    }
+    while (!run.queue.empty()) {
+        runConsumerPass(run.nextPassUs);
+    }
+
+    TraceReplayReport replay = finishTraceReplay();
+    LoadTestReport& report = run.report;
+    report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    report.framesPerSecond = report.wallSeconds > 0 ? report.framesDelivered / report.wallSeconds : 0;
+    report.generated = generator.stats;
+    report.offeredFramesPerSecond = lastUs > 0 ? generator.stats.frames * 1e6 / lastUs : 0;
+    report.queueDrops = run.queue.getDropCount();
+    report.queueHighWater = run.queue.getHighWaterMark();
+    report.dispatch = replay.dispatch;
+    report.simulatedMs = replay.simulatedMs;
+    return report;
+}
+
+uint32_t findLoadTestDropPoint(LoadTestOptions options, uint32_t stepFramesPerSecond, uint32_t maxFramesPerSecond) {
+    if (stepFramesPerSecond == 0) {
+        return 0;
+    }
+    for (uint32_t rate = stepFramesPerSecond; rate <= maxFramesPerSecond; rate += stepFramesPerSecond) {
+        options.profile.framesPerSecond = rate;
+        if (runLoadTest(options).queueDrops != 0) {
+            return rate;
+        }
+    }
+    return 0;
+}
+
+void printLoadTestReport(const LoadTestReport& report, FILE* out) {
+    fprintf(out, "Load test: %lu frames offered at %.0f frames/s over %.3f s (%lu monitored, %lu background, %lu in bursts)\n",
+            (unsigned long)report.generated.frames, report.offeredFramesPerSecond, report.simulatedMs / 1000.0,
+            (unsigned long)report.generated.monitoredFrames, (unsigned long)report.generated.backgroundFrames,
+            (unsigned long)report.generated.burstFrames);
+    fprintf(out, "  Faults: %lu %s, %lu %s, %lu %s, %lu %s\n",
+            (unsigned long)report.generated.faults[LOAD_FAULT_DLC_MISMATCH], getLoadFaultName(LOAD_FAULT_DLC_MISMATCH),
+            (unsigned long)report.generated.faults[LOAD_FAULT_MALFORMED], getLoadFaultName(LOAD_FAULT_MALFORMED),
+            (unsigned long)report.generated.faults[LOAD_FAULT_INVALID_VALUE], getLoadFaultName(LOAD_FAULT_INVALID_VALUE),
+            (unsigned long)report.generated.faults[LOAD_FAULT_OUT_OF_ORDER], getLoadFaultName(LOAD_FAULT_OUT_OF_ORDER));
+    fprintf(out, "  Queue: %lu delivered, %lu dropped, high water %u/%d\n",
+            (unsigned long)report.framesDelivered, (unsigned long)report.queueDrops,
+            (unsigned)report.queueHighWater, CAN_RX_QUEUE_SIZE);
+    fprintf(out, "  Dispatch: %lu monitored, %lu parsed, %lu unchanged, %lu parse errors (%lu short frames delivered)\n",
+            (unsigned long)report.dispatch.framesDispatched, (unsigned long)report.dispatch.framesParsed,
+            (unsigned long)report.dispatch.unchangedFrames, (unsigned long)report.dispatch.parseErrors,
+            (unsigned long)report.dlcFaultsDelivered);
+    fprintf(out, "  Correctness: %lu checks, %lu signal mismatches, %lu output mismatches\n",
+            (unsigned long)report.checks, (unsigned long)report.signalMismatches,
+            (unsigned long)report.outputMismatches);
+    fprintf(out, "  Host: %.3f s wall, %.0f frames/s sustained\n", report.wallSeconds, report.framesPerSecond);
+}
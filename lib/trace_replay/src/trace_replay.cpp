@@ -0,0 +1,380 @@
+#include "trace_replay.h"
+#include "capture_file.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "../../../src/arduino_interface.h"
+#include "../../../src/latency_tracker.h"
+
+// GPIO writes land in the ArduinoMock pin map, like the test interface
+class ReplayArduinoInterface : public ArduinoInterface {
+public:
+    void digitalWrite(uint8_t pin, uint8_t value) override {
+        ArduinoMock::instance().setDigitalWrite(pin, value);
+    }
+
+    uint8_t digitalRead(uint8_t pin) override {
+        return ArduinoMock::instance().getDigitalRead(pin);
+    }
+
+    void pinMode(uint8_t pin, uint8_t mode) override {
+        ArduinoMock::instance().setPinMode(pin, mode);
+    }
+
+    unsigned long millis() override {
+        return ArduinoMock::instance().getMillis();
+    }
+};
+
+struct TraceReplaySession {
+    TraceReplayOptions options;
+    TraceReplayReport report;
+    std::chrono::steady_clock::time_point wallStart;
+    uint64_t firstTimestampUs;
+    bool haveFirstFrame;
+};
+
+static ReplayArduinoInterface replayHardware;
+static TraceReplaySession session;
+
+static const char* skipSpaces(const char* p) {
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+    return p;
+}
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (no timezone handling)
+static int64_t daysFromCivil(int year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = (unsigned)(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + (int64_t)dayOfEra - 719468;
+}
+
+// (seconds.fraction) can0 ID#DATA - standard and extended IDs, data frames only
+bool parseCandumpLine(const char* line, TraceFrame& frame) {
+    const char* p = skipSpaces(line);
+    if (*p != '(') {
+        return false;
+    }
+
+    char* end;
+    uint64_t seconds = strtoull(p + 1, &end, 10);
+    if (end == p + 1 || *end != '.') {
+        return false;
+    }
+    p = end + 1;
+
+    uint64_t micros = 0;
+    int digits = 0;
+    while (*p >= '0' && *p <= '9') {
+        if (digits < 6) {
+            micros = micros * 10 + (uint64_t)(*p - '0');
+            digits++;
+        }
+        p++;
+    }
+    for (; digits < 6; digits++) {
+        micros *= 10;
+    }
+    if (*p != ')') {
+        return false;
+    }
+
+    // Interface name
+    p = skipSpaces(p + 1);
+    while (*p != '\0' && *p != ' ' && *p != '\t') {
+        p++;
+    }
+    p = skipSpaces(p);
+
+    unsigned long id = strtoul(p, &end, 16);
+    if (end == p || *end != '#') {
+        return false;
+    }
+    p = end + 1;
+    if (*p == 'R' || *p == 'r' || *p == '#') {
+        return false;                   // Remote or CAN FD frame
+    }
+
+    frame.length = 0;
+    while (frame.length < 8 && hexDigit(p[0]) >= 0 && hexDigit(p[1]) >= 0) {
+        frame.data[frame.length++] = (uint8_t)((hexDigit(p[0]) << 4) | hexDigit(p[1]));
+        p += 2;
+        if (*p == '.') {
+            p++;                        // candump -L byte separators
+        }
+    }
+    if (hexDigit(*p) >= 0) {
+        return false;                   // More than 8 bytes or an odd digit count
+    }
+
+    memset(frame.data + frame.length, 0, sizeof(frame.data) - frame.length);
+    frame.id = (uint32_t)id;
+    frame.timestampUs = seconds * 1000000ULL + micros;
+    return true;
+}
+
+// YYYY-MM-DD HH:MM:SS.mmm | CAN_ID:0xXXX | data:XX XX ... | name | signals
+bool parseEmbeddedLoggerLine(const char* line, TraceFrame& frame) {
+    int year, month, day, hour, minute, second, millisecond;
+    if (sscanf(line, "%4d-%2d-%2d %2d:%2d:%2d.%3d", &year, &month, &day,
+               &hour, &minute, &second, &millisecond) != 7) {
+        return false;
+    }
+
+    const char* p = strstr(line, "CAN_ID:0x");
+    if (!p) {
+        return false;
+    }
+    char* end;
+    unsigned long id = strtoul(p + 9, &end, 16);
+    if (end == p + 9) {
+        return false;
+    }
+
+    p = strstr(end, "data:");
+    if (!p) {
+        return false;
+    }
+    p += 5;
+
+    frame.length = 0;
+    while (true) {
+        p = skipSpaces(p);
+        if (hexDigit(p[0]) < 0 || hexDigit(p[1]) < 0) {
+            break;
+        }
+        if (frame.length == 8) {
+            return false;
+        }
+        frame.data[frame.length++] = (uint8_t)((hexDigit(p[0]) << 4) | hexDigit(p[1]));
+        p += 2;
+    }
+    if (*p != '\0' && *p != '|' && *p != '\n' && *p != '\r') {
+        return false;
+    }
+
+    memset(frame.data + frame.length, 0, sizeof(frame.data) - frame.length);
+    frame.id = (uint32_t)id;
+    int64_t secondsOfDay = hour * 3600LL + minute * 60LL + second;
+    int64_t seconds = daysFromCivil(year, (unsigned)month, (unsigned)day) * 86400LL + secondsOfDay;
+    frame.timestampUs = (uint64_t)seconds * 1000000ULL + (uint64_t)millisecond * 1000ULL;
+    return true;
+}
+
+bool parseTraceLine(const char* line, TraceFrame& frame) {
+    const char* p = skipSpaces(line);
+    if (*p == '(') {
+        return parseCandumpLine(line, frame);
+    }
+    return parseEmbeddedLoggerLine(line, frame);
+}
+
+// Outputs as updateOutputControlLogic() in main.cpp drives them
+static void applyReplayOutputs(uint8_t changedInputs) {
+    uint32_t vehicleFlags = getVehicleStateFlags();
+    bool systemReady = (vehicleFlags & VEHICLE_FLAG_SYSTEM_READY) != 0;
+    bool bedlight = decideBedlightOutput(vehicleFlags);
+    GPIOState outputs = getGPIOState();
+
+    beginGPIOBatch();
+    if (bedlight != outputs.bedlight) {
+        setBedlight(bedlight);
+        session.report.bedlightChanges++;
+    }
+    if (changedInputs & OUTPUT_INPUT_SYSTEM_READY) {
+        if (systemReady != outputs.systemReady) {
+            session.report.systemReadyChanges++;
+        }
+        setSystemReady(systemReady);
+    }
+    commitGPIOBatch();
+}
+
+// One loop() pass after frame dispatch: deadlines, opener timing, outputs
+static void runReplayPass(unsigned long now) {
+    ArduinoMock::instance().setMillis(now);
+    checkForStateChanges();
+    updateToolboxOpenerTiming();
+
+    uint8_t changedInputs = takeOutputInputChanges();
+    if (changedInputs != 0) {
+        applyReplayOutputs(changedInputs);
+    }
+}
+
+// Move the clock to `target`, stopping at every freshness deadline on the way
+static void advanceReplayClockTo(unsigned long target) {
+    unsigned long now = millis();
+    while ((long)(target - now) > 0) {
+        unsigned long remaining = target - now;
+        unsigned long idle = getStateFreshnessIdleTime(remaining);
+        if (idle >= remaining) {
+            break;
+        }
+        now += idle;
+        runReplayPass(now);
+    }
+    ArduinoMock::instance().setMillis(target);
+}
+
+// Hold the wall clock to the capture timing, scaled by options.speed
+static void paceReplay(uint64_t offsetUs) {
+    if (session.options.speed <= 0) {
+        return;
+    }
+    auto due = session.wallStart + std::chrono::microseconds((uint64_t)(offsetUs / session.options.speed));
+    std::this_thread::sleep_until(due);
+}
+
+TraceReplayOptions defaultTraceReplayOptions() {
+    TraceReplayOptions options;
+    options.speed = 0;
+    options.captureLogs = false;
+    options.startMillis = 0;
+    return options;
+}
+
+void beginTraceReplay(const TraceReplayOptions& options) {
+    memset(&session.report, 0, sizeof(session.report));
+    session.options = options;
+    session.haveFirstFrame = false;
+    session.firstTimestampUs = 0;
+
+    ArduinoMock::instance().reset();
+    ArduinoMock::instance().setMillis(options.startMillis);
+    ArduinoMock::instance().setSerialCapture(options.captureLogs);
+
+    initializeGPIOWithInterface(&replayHardware);
+    initializeStateManager();
+    resetCANDispatchStatistics();
+    invalidateCANPayloadCache();
+    runReplayPass(options.startMillis);
+
+    session.wallStart = std::chrono::steady_clock::now();
+}
+
+void replayTraceFrame(const TraceFrame& frame) {
+    if (!session.haveFirstFrame) {
+        session.firstTimestampUs = frame.timestampUs;
+        session.haveFirstFrame = true;
+    }
+
+    // Out-of-order timestamps never move the clock backwards
+    uint64_t offsetUs = frame.timestampUs > session.firstTimestampUs
+                            ? frame.timestampUs - session.firstTimestampUs : 0;
+    unsigned long target = session.options.startMillis + (unsigned long)(offsetUs / 1000);
+    if ((long)(target - millis()) < 0) {
+        target = millis();
+    }
+
+    paceReplay(offsetUs);
+    advanceReplayClockTo(target);
+
+    CANMessage message;
+    message.id = frame.id;
+    message.length = frame.length;
+    memcpy(message.data, frame.data, sizeof(message.data));
+    message.timestamp = target;
+    message.source = CAN_SOURCE_MCP2515;
+    message.arrivalUs = getLatencyTimeUs();
+    dispatchCANMessage(message);
+
+    runReplayPass(target);
+    session.report.framesReplayed++;
+    session.report.simulatedMs = target - session.options.startMillis;
+}
+
+bool replayTraceLine(const char* line) {
+    TraceFrame frame;
+    session.report.linesRead++;
+    if (!parseTraceLine(line, frame)) {
+        session.report.linesSkipped++;
+        return false;
+    }
+    replayTraceFrame(frame);
+    return true;
+}
+
+bool replayTraceFile(const char* path) {
+    CaptureFile capture;
+    if (openCaptureFile(path, capture)) {
+        replayCaptureRange(capture, 0, UINT64_MAX);
+        closeCaptureFile(capture);
+        return true;
+    }
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        // Frames sit at the start of a line; drop the tail of overlong lines
+        if (!strchr(line, '\n')) {
+            int c;
+            while ((c = fgetc(file)) != EOF && c != '\n') {
+            }
+        }
+        replayTraceLine(line);
+    }
+
+    fclose(file);
+    return true;
+}
+
+void advanceTraceReplay(unsigned long ms) {
+    unsigned long target = millis() + ms;
+    advanceReplayClockTo(target);
+    runReplayPass(target);
+    session.report.simulatedMs = target - session.options.startMillis;
+}
+
+TraceReplayReport finishTraceReplay() {
+    runReplayPass(millis());
+
+    TraceReplayReport& report = session.report;
+    report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - session.wallStart).count();
+    report.framesPerSecond = report.wallSeconds > 0 ? report.framesReplayed / report.wallSeconds : 0;
+    report.dispatch = getCANDispatchStats();
+    report.finalSignals = getVehicleSignals();
+    report.finalOutputs = getGPIOState();
+    report.staleSourceMask = getStaleSourceMask();
+
+    ArduinoMock::instance().setSerialCapture(true);
+    return report;
+}
+
+void printTraceReplayReport(const TraceReplayReport& report, FILE* out) {
+    fprintf(out, "Trace replay: %llu frames from %llu lines (%llu skipped)\n",
+            (unsigned long long)report.framesReplayed, (unsigned long long)report.linesRead,
+            (unsigned long long)report.linesSkipped);
+    fprintf(out, "  Capture time: %.3f s, wall time: %.3f s (%.0f frames/s, %.0fx real time)\n",
+            report.simulatedMs / 1000.0, report.wallSeconds, report.framesPerSecond,
+            report.wallSeconds > 0 ? report.simulatedMs / 1000.0 / report.wallSeconds : 0.0);
+    fprintf(out, "  Dispatch: %lu monitored, %lu parsed, %lu unchanged, %lu parse errors\n",
+            (unsigned long)report.dispatch.framesDispatched, (unsigned long)report.dispatch.framesParsed,
+            (unsigned long)report.dispatch.unchangedFrames, (unsigned long)report.dispatch.parseErrors);
+    fprintf(out, "  Final state: PudLamp=%u Lock=%u Park=%u SOC=%u%% ready=%s stale=0x%02lX\n",
+            (unsigned)report.finalSignals.pudLampRequest, (unsigned)report.finalSignals.vehicleLockStatus,
+            (unsigned)report.finalSignals.transmissionParkStatus, (unsigned)report.finalSignals.batterySOC,
+            report.finalSignals.systemReady ? "YES" : "NO", (unsigned long)report.staleSourceMask);
+    fprintf(out, "  Final outputs: bedlight=%s systemReady=%s toolboxOpener=%s\n",
+            report.finalOutputs.bedlight ? "ON" : "OFF", report.finalOutputs.systemReady ? "ON" : "OFF",
+            report.finalOutputs.toolboxOpener ? "ON" : "OFF");
+    fprintf(out, "  Output changes: bedlight %lu, systemReady %lu\n",
+            (unsigned long)report.bedlightChanges, (unsigned long)report.systemReadyChanges);
+}
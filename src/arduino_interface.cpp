@@ -1,5 +1,36 @@
 #include "arduino_interface.h"
 
+void ArduinoInterface::writeOutputs(uint32_t setMask, uint32_t clearMask) {
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        uint32_t bit = 1UL << pin;
+        if (setMask & bit) {
+            digitalWrite(pin, 1);
+        } else if (clearMask & bit) {
+            digitalWrite(pin, 0);
+        }
+    }
+}
+
+bool ArduinoInterface::setupPWM(uint8_t pin, uint8_t channel, uint32_t frequencyHz, uint8_t resolutionBits) {
+    (void)pin;
+    (void)channel;
+    (void)frequencyHz;
+    (void)resolutionBits;
+    return false;
+}
+
+void ArduinoInterface::writePWM(uint8_t channel, uint32_t duty) {
+    (void)channel;
+    (void)duty;
+}
+
+bool ArduinoInterface::fadePWM(uint8_t channel, uint32_t duty, uint32_t fadeMs) {
+    (void)channel;
+    (void)duty;
+    (void)fadeMs;
+    return false;
+}
+
 #ifdef NATIVE_ENV
 // For native testing, provide stub implementations
 void ArduinoHardware::digitalWrite(uint8_t pin, uint8_t value) {
@@ -15,6 +46,24 @@ void ArduinoHardware::pinMode(uint8_t pin, uint8_t mode) {
     // Stub implementation for native testing
 }
 
+void ArduinoHardware::writeOutputs(uint32_t setMask, uint32_t clearMask) {
+    // Stub implementation for native testing
+}
+
+bool ArduinoHardware::setupPWM(uint8_t pin, uint8_t channel, uint32_t frequencyHz, uint8_t resolutionBits) {
+    // Stub implementation for native testing
+    return true;
+}
+
+void ArduinoHardware::writePWM(uint8_t channel, uint32_t duty) {
+    // Stub implementation for native testing
+}
+
+bool ArduinoHardware::fadePWM(uint8_t channel, uint32_t duty, uint32_t fadeMs) {
+    // Stub implementation for native testing
+    return false;
+}
+
 unsigned long ArduinoHardware::millis() {
     // Stub implementation for native testing - return a simple counter
     static unsigned long counter = 0;
@@ -23,6 +72,9 @@ unsigned long ArduinoHardware::millis() {
 #else
 // For real hardware, use Arduino functions
 #include <Arduino.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+#include <driver/ledc.h>
 
 void ArduinoHardware::digitalWrite(uint8_t pin, uint8_t value) {
     ::digitalWrite(pin, value);
@@ -36,6 +88,48 @@ void ArduinoHardware::pinMode(uint8_t pin, uint8_t mode) {
     ::pinMode(pin, mode);
 }
 
+// The W1TS/W1TC registers only affect the bits written, so concurrent writers
+// (e.g. the opener pulse timer) never race a read-modify-write
+void ArduinoHardware::writeOutputs(uint32_t setMask, uint32_t clearMask) {
+    if (setMask) {
+        REG_WRITE(GPIO_OUT_W1TS_REG, setMask);
+    }
+    if (clearMask) {
+        REG_WRITE(GPIO_OUT_W1TC_REG, clearMask);
+    }
+}
+
+// Arduino-ESP32 2.x LEDC API: ledcSetup() returns the achieved frequency, 0 on failure
+bool ArduinoHardware::setupPWM(uint8_t pin, uint8_t channel, uint32_t frequencyHz, uint8_t resolutionBits) {
+    if (ledcSetup(channel, frequencyHz, resolutionBits) == 0) {
+        return false;
+    }
+    ledcAttachPin(pin, channel);
+    return true;
+}
+
+void ArduinoHardware::writePWM(uint8_t channel, uint32_t duty) {
+    ledcWrite(channel, duty);
+}
+
+// Arduino channel n is LEDC speed mode n / 8, channel n % 8 (the mapping ledcSetup() uses)
+bool ArduinoHardware::fadePWM(uint8_t channel, uint32_t duty, uint32_t fadeMs) {
+    static bool fadeServiceInstalled = false;
+    if (!fadeServiceInstalled) {
+        esp_err_t result = ledc_fade_func_install(0);
+        if (result != ESP_OK && result != ESP_ERR_INVALID_STATE) {
+            return false;
+        }
+        fadeServiceInstalled = true;
+    }
+    ledc_mode_t mode = (ledc_mode_t)(channel / 8);
+    ledc_channel_t ledcChannel = (ledc_channel_t)(channel % 8);
+    if (ledc_set_fade_with_time(mode, ledcChannel, duty, (int)fadeMs) != ESP_OK) {
+        return false;
+    }
+    return ledc_fade_start(mode, ledcChannel, LEDC_FADE_NO_WAIT) == ESP_OK;
+}
+
 unsigned long ArduinoHardware::millis() {
     return ::millis();
 }
@@ -17,6 +17,19 @@ public:
     virtual uint8_t digitalRead(uint8_t pin) = 0;
     virtual void pinMode(uint8_t pin, uint8_t mode) = 0;
     
+    // Drive several outputs (pins 0-31) in one step: bits in setMask go HIGH,
+    // bits in clearMask go LOW. The default falls back to digitalWrite() per pin.
+    virtual void writeOutputs(uint32_t setMask, uint32_t clearMask);
+    
+    // LEDC PWM: attach a pin to a channel, then set the channel duty. The
+    // defaults do nothing (setupPWM() reports false) for boards without LEDC.
+    virtual bool setupPWM(uint8_t pin, uint8_t channel, uint32_t frequencyHz, uint8_t resolutionBits);
+    virtual void writePWM(uint8_t channel, uint32_t duty);
+    
+    // Ramp a PWM channel to duty over fadeMs in the LEDC fade engine and return
+    // at once (no CPU work per step). false: no hardware fade, nothing written.
+    virtual bool fadePWM(uint8_t channel, uint32_t duty, uint32_t fadeMs);
+    
     // Timing functions
     virtual unsigned long millis() = 0;
 };
@@ -29,5 +42,9 @@ public:
     void digitalWrite(uint8_t pin, uint8_t value) override;
     uint8_t digitalRead(uint8_t pin) override;
     void pinMode(uint8_t pin, uint8_t mode) override;
+    void writeOutputs(uint32_t setMask, uint32_t clearMask) override;  // One W1TS/W1TC register write each
+    bool setupPWM(uint8_t pin, uint8_t channel, uint32_t frequencyHz, uint8_t resolutionBits) override;
+    void writePWM(uint8_t channel, uint32_t duty) override;
+    bool fadePWM(uint8_t channel, uint32_t duty, uint32_t fadeMs) override;
     unsigned long millis() override;
 };
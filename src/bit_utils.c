@@ -7,24 +7,14 @@
  * 1. Converts 8 bytes to 64-bit integer (little-endian)
  * 2. Calculates bit position from MSB: bit_pos = start_bit - length + 1
  * 3. Creates mask and extracts value
+ * 
+ * Callers extracting more than one signal from a frame should use
+ * loadCANWord() + extractBitsFromWord() or extractSignals() instead.
  */
 uint8_t extractBits(const uint8_t* data, uint8_t startBit, uint8_t length) {
     if (length > 8 || startBit > 63) return 0; // Bounds check
     
-    // Convert 8 bytes to 64-bit integer (little-endian) - matches Python implementation
-    uint64_t data_int = 0;
-    for (int i = 0; i < 8; i++) {
-        data_int |= ((uint64_t)data[i]) << (i * 8);
-    }
-    
-    // Calculate bit position from MSB (DBC uses MSB bit numbering) - matches Python
-    uint8_t bit_pos = startBit - length + 1;
-    
-    // Create mask and extract value - matches Python
-    uint64_t mask = (1ULL << length) - 1;
-    uint8_t value = (data_int >> bit_pos) & mask;
-    
-    return value;
+    return (uint8_t)extractBitsFromWord(loadCANWord(data), startBit, length);
 }
 
 /**
@@ -33,20 +23,18 @@ uint8_t extractBits(const uint8_t* data, uint8_t startBit, uint8_t length) {
 uint16_t extractBits16(const uint8_t* data, uint8_t startBit, uint8_t length) {
     if (length > 16 || startBit > 63) return 0; // Bounds check
     
-    // Convert 8 bytes to 64-bit integer (little-endian) - matches Python implementation
-    uint64_t data_int = 0;
-    for (int i = 0; i < 8; i++) {
-        data_int |= ((uint64_t)data[i]) << (i * 8);
-    }
-    
-    // Calculate bit position from MSB (DBC uses MSB bit numbering) - matches Python
-    uint8_t bit_pos = startBit - length + 1;
-    
-    // Create mask and extract value - matches Python
-    uint64_t mask = (1ULL << length) - 1;
-    uint16_t value = (data_int >> bit_pos) & mask;
+    return (uint16_t)extractBitsFromWord(loadCANWord(data), startBit, length);
+}
+
+/**
+ * Batched extraction - the payload word is assembled once for all signals
+ */
+void extractSignals(const uint8_t* data, const SignalBits* signals, uint32_t* values, uint8_t count) {
+    uint64_t word = loadCANWord(data);
     
-    return value;
+    for (uint8_t i = 0; i < count; i++) {
+        values[i] = extractBitsFromWord(word, signals[i].startBit, signals[i].length);
+    }
 }
 
 /**
@@ -59,10 +47,7 @@ void setBits(uint8_t* data, uint8_t startBit, uint8_t length, uint32_t value) {
     if (length > 16 || startBit > 63) return; // Bounds check
     
     // Convert existing data to 64-bit integer (little-endian)
-    uint64_t dataValue = 0;
-    for (int i = 0; i < 8; i++) {
-        dataValue |= ((uint64_t)data[i]) << (i * 8);
-    }
+    uint64_t dataValue = loadCANWord(data);
     
     // Calculate bit position (DBC uses MSB bit numbering)
     uint8_t bitPos = startBit - length + 1;
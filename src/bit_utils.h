@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <string.h>
 
 /**
  * Bit manipulation utilities for CAN message processing
@@ -33,6 +34,52 @@ uint8_t extractBits(const uint8_t* data, uint8_t startBit, uint8_t length);
  */
 uint16_t extractBits16(const uint8_t* data, uint8_t startBit, uint8_t length);
 
+/**
+ * Assemble the 8-byte CAN payload into one little-endian 64-bit word
+ * 
+ * Single unaligned load on little-endian targets (Xtensa, x86); build the word
+ * once per frame and pass it to extractBitsFromWord() for every signal.
+ * @param data: 8-byte CAN data array (any alignment)
+ * @return Payload word, byte 0 in bits 0-7
+ */
+static inline uint64_t loadCANWord(const uint8_t* data) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/**
+ * Extract bits from a payload word using DBC-style bit positioning
+ * @param word: Payload word from loadCANWord()
+ * @param startBit: MSB bit position (DBC format, 0-63)
+ * @param length: Number of bits to extract (1-32)
+ * @return Extracted value, or 0 if the field does not fit in the word
+ */
+static inline uint32_t extractBitsFromWord(uint64_t word, uint8_t startBit, uint8_t length) {
+    if (length == 0 || length > 32 || startBit > 63 || startBit + 1 < length) return 0;
+    return (uint32_t)((word >> (startBit - length + 1)) & ((1ULL << length) - 1));
+}
+
+/**
+ * Bit field descriptor for batched extraction (DBC-style positioning)
+ */
+typedef struct {
+    uint8_t startBit;   // MSB bit position (DBC format, 0-63)
+    uint8_t length;     // Number of bits (1-32)
+} SignalBits;
+
+/**
+ * Extract several signals from one CAN payload, loading the payload once
+ * @param data: 8-byte CAN data array
+ * @param signals: Array of count bit field descriptors
+ * @param values: Output array, values[i] receives signal i
+ * @param count: Number of signals
+ */
+void extractSignals(const uint8_t* data, const SignalBits* signals, uint32_t* values, uint8_t count);
+
 /**
  * Set bits in CAN data using DBC-style bit positioning
  * @param data: 8-byte CAN data array (modified in place)
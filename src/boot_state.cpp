@@ -0,0 +1,139 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include "boot_state.h"
+#include <stddef.h>
+#include <string.h>
+#include "logger.h"
+#ifndef NATIVE_ENV
+#include <Arduino.h>
+#endif
+
+// Not cleared by the startup code, so it still holds the previous boot's record
+#ifndef NATIVE_ENV
+RTC_NOINIT_ATTR static BootRecord retainedRecord;
+#else
+static BootRecord retainedRecord;
+#endif
+
+static BootRecord previousRecord;
+static bool stateRestored = false;
+static uint8_t lastResetReason = 0;
+static uint32_t milestoneUs[BOOT_MILESTONE_COUNT];
+
+static const char* const milestoneNames[BOOT_MILESTONE_COUNT] = {
+    "outputs safe", "CAN up", "state ready", "setup done", "first frame"
+};
+
+static void sealBootRecord(BootRecord& record) {
+    record.magic = BOOT_RECORD_MAGIC;
+    record.version = BOOT_RECORD_VERSION;
+    record.size = sizeof(BootRecord);
+    record.checksum = computeBootRecordChecksum(record);
+}
+
+uint32_t computeBootRecordChecksum(const BootRecord& record) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(BootRecord, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool isBootRecordValid(const BootRecord& record) {
+    return record.magic == BOOT_RECORD_MAGIC && record.version == BOOT_RECORD_VERSION &&
+           record.size == sizeof(BootRecord) && record.checksum == computeBootRecordChecksum(record);
+}
+
+bool beginBootState(uint8_t resetReason) {
+    lastResetReason = resetReason;
+    memset(milestoneUs, 0, sizeof(milestoneUs));
+    stateRestored = isBootRecordValid(retainedRecord);
+    if (stateRestored) {
+        previousRecord = retainedRecord;
+        retainedRecord.bootCount++;
+    } else {
+        memset(&previousRecord, 0, sizeof(previousRecord));
+        memset(&retainedRecord, 0, sizeof(retainedRecord));
+        retainedRecord.bootCount = 1;
+    }
+    // Health counters restart with the boot; the signals stay until replaced
+    retainedRecord.canErrors = 0;
+    retainedRecord.parseErrors = 0;
+    retainedRecord.criticalErrors = 0;
+    retainedRecord.uptimeMs = 0;
+    sealBootRecord(retainedRecord);
+    return stateRestored;
+}
+
+bool getRestoredVehicleSignals(VehicleSignals& signals) {
+    if (!stateRestored) {
+        return false;
+    }
+    memcpy(&signals, &previousRecord.signalsWord, sizeof(signals));
+    return true;
+}
+
+BootRecord getPreviousBootRecord() {
+    return previousRecord;
+}
+
+void retainBootState(const VehicleSignals& signals, const SystemHealth& health, unsigned long uptimeMs) {
+    uint32_t signalsWord = vehicleSignalsWord(signals);
+    if (signalsWord == retainedRecord.signalsWord && health.canErrors == retainedRecord.canErrors &&
+        health.parseErrors == retainedRecord.parseErrors &&
+        health.criticalErrors == retainedRecord.criticalErrors) {
+        return;
+    }
+    retainedRecord.signalsWord = signalsWord;
+    retainedRecord.canErrors = health.canErrors;
+    retainedRecord.parseErrors = health.parseErrors;
+    retainedRecord.criticalErrors = health.criticalErrors;
+    retainedRecord.uptimeMs = uptimeMs;
+    sealBootRecord(retainedRecord);
+}
+
+BootRecord* getRetainedBootRecord() {
+    return &retainedRecord;
+}
+
+void noteBootMilestone(uint8_t milestone, uint32_t timeUs) {
+    if (milestone < BOOT_MILESTONE_COUNT && milestoneUs[milestone] == 0) {
+        milestoneUs[milestone] = timeUs;
+    }
+}
+
+uint32_t getBootMilestoneUs(uint8_t milestone) {
+    return milestone < BOOT_MILESTONE_COUNT ? milestoneUs[milestone] : 0;
+}
+
+const char* getResetReasonName(uint8_t resetReason) {
+    // esp_reset_reason_t order
+    static const char* const names[] = {
+        "unknown", "power-on", "external", "software", "panic", "interrupt watchdog",
+        "task watchdog", "other watchdog", "deep sleep", "brownout", "SDIO"
+    };
+    return resetReason < sizeof(names) / sizeof(names[0]) ? names[resetReason] : "unknown";
+}
+
+void printBootStatus() {
+    LOG_INFO("=== BOOT ===");
+    LOG_INFO("Reset reason: %s, boot %lu since a cold start", getResetReasonName(lastResetReason),
+             (unsigned long)retainedRecord.bootCount);
+    if (stateRestored) {
+        LOG_INFO("Restored state from RTC memory (saved at %lu ms uptime, signals 0x%08lX)",
+                 (unsigned long)previousRecord.uptimeMs, (unsigned long)previousRecord.signalsWord);
+        LOG_INFO("Before the reset: CAN errors %lu, parse errors %lu, critical errors %lu",
+                 (unsigned long)previousRecord.canErrors, (unsigned long)previousRecord.parseErrors,
+                 (unsigned long)previousRecord.criticalErrors);
+    } else {
+        LOG_INFO("Cold boot: no valid state in RTC memory");
+    }
+    for (uint8_t milestone = 0; milestone < BOOT_MILESTONE_COUNT; milestone++) {
+        if (milestoneUs[milestone] != 0) {
+            LOG_INFO("  %-12s %lu.%03lu ms", milestoneNames[milestone], (unsigned long)(milestoneUs[milestone] / 1000),
+                     (unsigned long)(milestoneUs[milestone] % 1000));
+        } else {
+            LOG_INFO("  %-12s not yet", milestoneNames[milestone]);
+        }
+    }
+}
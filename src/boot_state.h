@@ -0,0 +1,69 @@
+#ifndef BOOT_STATE_H
+#define BOOT_STATE_H
+
+#include <stdint.h>
+#include "config.h"
+#include "state_manager.h"
+
+/**
+ * Fast boot: last-known state across resets, and the boot timeline
+ *
+ * loop() keeps a small record of the published vehicle signals and the health
+ * counters in RTC slow memory (RTC_NOINIT_ATTR), which the bootloader leaves
+ * alone on software, panic and watchdog resets. On the next boot setup() checks
+ * the record's magic, version, size and checksum and, when it holds, seeds the
+ * state manager with the signals from before the reset, so a truck that was
+ * parked and unlocked is treated that way from the first pass instead of
+ * waiting for every message to come round again. A power-on reset, or a
+ * brownout that lost the RTC domain, fails the checksum and boots cold.
+ *
+ * The health counters are kept as "before the reset" figures only: the live
+ * counters start at zero, so a reset still clears a safe shutdown.
+ *
+ * Boot milestones are esp_timer_get_time() stamps (microseconds since the
+ * application started) of the steps that matter for the first unlock: outputs
+ * safe, CAN up, state restored, setup() done and the first frame received.
+ */
+
+#define BOOT_RECORD_MAGIC 0x46313530u    // "F150"
+#define BOOT_RECORD_VERSION 1
+
+struct BootRecord {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;                  // sizeof(BootRecord) when written
+    uint32_t bootCount;             // Boots since the record was last started cold
+    uint32_t signalsWord;           // vehicleSignalsWord() of the published state
+    uint32_t canErrors;
+    uint32_t parseErrors;
+    uint32_t criticalErrors;
+    uint32_t uptimeMs;              // When the record was last written
+    uint32_t checksum;              // FNV-1a over every field above
+};
+
+#define BOOT_MILESTONE_OUTPUTS 0        // GPIO initialized, outputs off
+#define BOOT_MILESTONE_CAN 1            // CAN controller(s) receiving
+#define BOOT_MILESTONE_STATE 2          // State manager up (restored or cold)
+#define BOOT_MILESTONE_SETUP_DONE 3
+#define BOOT_MILESTONE_FIRST_FRAME 4    // First frame pulled from the receive queue
+#define BOOT_MILESTONE_COUNT 5
+
+uint32_t computeBootRecordChecksum(const BootRecord& record);
+bool isBootRecordValid(const BootRecord& record);
+
+// On boot: validates the retained record, keeps a copy as the previous boot
+// and starts a new one. Returns true when state from before the reset exists.
+bool beginBootState(uint8_t resetReason);
+bool getRestoredVehicleSignals(VehicleSignals& signals);   // false after a cold boot
+BootRecord getPreviousBootRecord();                        // Zeroed after a cold boot
+
+// Called every loop() pass; rewrites the record only when something changed
+void retainBootState(const VehicleSignals& signals, const SystemHealth& health, unsigned long uptimeMs);
+BootRecord* getRetainedBootRecord();
+
+void noteBootMilestone(uint8_t milestone, uint32_t timeUs);   // Only the first stamp counts
+uint32_t getBootMilestoneUs(uint8_t milestone);               // 0 until reached
+const char* getResetReasonName(uint8_t resetReason);           // esp_reset_reason_t
+void printBootStatus();
+
+#endif // BOOT_STATE_H
@@ -0,0 +1,163 @@
+#define LOG_MODULE_ID LOG_MODULE_GPIO
+#include "button_driver.h"
+#ifndef NATIVE_ENV
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/timers.h>
+#include "loop_scheduler.h"
+#endif
+
+static void emitButtonEvent(ButtonEvent* events, uint8_t& count, uint8_t maxEvents,
+                            uint8_t type, unsigned long now, unsigned long duration) {
+    if (count < maxEvents) {
+        events[count].type = type;
+        events[count].timestamp = now;
+        events[count].duration = duration;
+        count++;
+    }
+}
+
+void initButtonDebouncer(ButtonDebouncer& debouncer, bool pressed) {
+    debouncer.pressTime = 0;
+    debouncer.stableLevel = pressed;
+    // A button already down at boot is not a press, and must not become a hold
+    debouncer.holdReported = pressed;
+    debouncer.hasPressed = false;
+}
+
+uint8_t updateButtonDebouncer(ButtonDebouncer& debouncer, bool pressed, unsigned long now,
+                              ButtonEvent* events, uint8_t maxEvents) {
+    uint8_t count = 0;
+
+    if (pressed != debouncer.stableLevel) {
+        debouncer.stableLevel = pressed;
+
+        if (pressed) {
+            emitButtonEvent(events, count, maxEvents, BUTTON_EVENT_PRESS, now, 0);
+
+            // Two presses within BUTTON_DOUBLE_CLICK_MS (but further apart than a bounce)
+            unsigned long sinceLastPress = now - debouncer.pressTime;
+            if (debouncer.hasPressed &&
+                sinceLastPress <= BUTTON_DOUBLE_CLICK_MS &&
+                sinceLastPress > BUTTON_DEBOUNCE_MS) {
+                emitButtonEvent(events, count, maxEvents, BUTTON_EVENT_DOUBLE_CLICK, now, sinceLastPress);
+            }
+
+            debouncer.pressTime = now;
+            debouncer.hasPressed = true;
+            debouncer.holdReported = false;
+        } else {
+            emitButtonEvent(events, count, maxEvents, BUTTON_EVENT_RELEASE, now, now - debouncer.pressTime);
+            debouncer.holdReported = false;
+        }
+    }
+
+    if (debouncer.stableLevel && !debouncer.holdReported &&
+        (now - debouncer.pressTime) >= BUTTON_HOLD_THRESHOLD_MS) {
+        debouncer.holdReported = true;
+        emitButtonEvent(events, count, maxEvents, BUTTON_EVENT_HOLD, now, now - debouncer.pressTime);
+    }
+
+    return count;
+}
+
+unsigned long getButtonDebouncerTimeout(const ButtonDebouncer& debouncer, unsigned long now) {
+    if (!debouncer.stableLevel || debouncer.holdReported) {
+        return 0;
+    }
+
+    unsigned long held = now - debouncer.pressTime;
+    return held >= BUTTON_HOLD_THRESHOLD_MS ? 1 : BUTTON_HOLD_THRESHOLD_MS - held;
+}
+
+#ifndef NATIVE_ENV
+
+// Debouncer state is only touched from the timer service task
+static ButtonDebouncer debouncer;
+static TimerHandle_t buttonTimer = nullptr;
+static QueueHandle_t buttonEventQueue = nullptr;
+static std::atomic<bool> debouncedPressed(false);
+static std::atomic<uint32_t> buttonEventDrops(0);
+
+static TickType_t buttonTimerTicks(unsigned long ms) {
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    return ticks > 0 ? ticks : 1;
+}
+
+// Any edge restarts the quiet period; bounces just keep pushing it out
+static void IRAM_ATTR onButtonEdge() {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    xTimerChangePeriodFromISR(buttonTimer, buttonTimerTicks(BUTTON_DEBOUNCE_MS), &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+// Quiet period over, or hold deadline reached
+static void onButtonTimer(TimerHandle_t timer) {
+    bool pressed = digitalRead(TOOLBOX_BUTTON_PIN) == LOW;  // Active low with pullup
+    unsigned long now = millis();
+
+    ButtonEvent events[BUTTON_DEBOUNCER_MAX_EVENTS];
+    uint8_t count = updateButtonDebouncer(debouncer, pressed, now, events, BUTTON_DEBOUNCER_MAX_EVENTS);
+    debouncedPressed.store(debouncer.stableLevel, std::memory_order_relaxed);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (xQueueSend(buttonEventQueue, &events[i], 0) != pdTRUE) {
+            buttonEventDrops.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (count > 0) {
+        signalLoopEvent(LOOP_EVENT_BUTTON);
+    }
+
+    unsigned long timeout = getButtonDebouncerTimeout(debouncer, now);
+    if (timeout > 0) {
+        xTimerChangePeriod(timer, buttonTimerTicks(timeout), 0);
+    }
+}
+
+bool startButtonDriver() {
+    if (buttonTimer) {
+        return true;
+    }
+
+    buttonEventQueue = xQueueCreate(BUTTON_EVENT_QUEUE_LEN, sizeof(ButtonEvent));
+    buttonTimer = xTimerCreate("button", buttonTimerTicks(BUTTON_DEBOUNCE_MS), pdFALSE, nullptr, onButtonTimer);
+    if (!buttonEventQueue || !buttonTimer) {
+        LOG_ERROR("Button driver: failed to create event queue or debounce timer");
+        return false;
+    }
+
+    bool pressed = digitalRead(TOOLBOX_BUTTON_PIN) == LOW;
+    initButtonDebouncer(debouncer, pressed);
+    debouncedPressed.store(pressed, std::memory_order_relaxed);
+
+    attachInterrupt(digitalPinToInterrupt(TOOLBOX_BUTTON_PIN), onButtonEdge, CHANGE);
+    LOG_INFO("Button driver started (edge interrupt, %d ms debounce, %d ms hold)",
+             BUTTON_DEBOUNCE_MS, BUTTON_HOLD_THRESHOLD_MS);
+    return true;
+}
+
+void notifyButtonWake() {
+    // The edge that woke the chip went to the wakeup logic, not onButtonEdge()
+    if (buttonTimer) {
+        xTimerChangePeriod(buttonTimer, buttonTimerTicks(BUTTON_DEBOUNCE_MS), 0);
+    }
+}
+
+bool receiveButtonEvent(ButtonEvent& event) {
+    return buttonEventQueue && xQueueReceive(buttonEventQueue, &event, 0) == pdTRUE;
+}
+
+bool isButtonDriverPressed() {
+    return debouncedPressed.load(std::memory_order_relaxed);
+}
+
+uint32_t getButtonEventDrops() {
+    return buttonEventDrops.load(std::memory_order_relaxed);
+}
+
+#endif // NATIVE_ENV
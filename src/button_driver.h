@@ -0,0 +1,63 @@
+#ifndef BUTTON_DRIVER_H
+#define BUTTON_DRIVER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Interrupt-driven toolbox button driver
+ *
+ * A CHANGE interrupt on TOOLBOX_BUTTON_PIN restarts a one-shot debounce timer.
+ * When that timer expires (no edge for BUTTON_DEBOUNCE_MS) the timer callback
+ * samples the pin once and runs the debounce state machine below, which emits
+ * press, release, hold and double-click events into a queue and re-arms the
+ * timer for the hold threshold while the button stays down. Event timestamps
+ * come from the timer, not from how often loop() runs, so hold and
+ * double-click timing no longer depends on loop load.
+ *
+ * loop() only drains the queue (receiveButtonEvent); it never reads the pin.
+ */
+
+enum ButtonEventType {
+    BUTTON_EVENT_PRESS = 0,
+    BUTTON_EVENT_RELEASE,
+    BUTTON_EVENT_HOLD,
+    BUTTON_EVENT_DOUBLE_CLICK
+};
+
+struct ButtonEvent {
+    uint8_t type;                   // ButtonEventType
+    unsigned long timestamp;        // millis() when the event was detected
+    unsigned long duration;         // Release/hold: time pressed; double-click: press interval
+};
+
+#define BUTTON_DEBOUNCER_MAX_EVENTS 3   // Most events one debouncer update can emit
+
+// Debounce state machine (pure logic; host-testable)
+struct ButtonDebouncer {
+    unsigned long pressTime;        // Start of the current/last press
+    bool stableLevel;               // Debounced level (true = pressed)
+    bool holdReported;
+    bool hasPressed;                // pressTime holds a real press
+};
+
+void initButtonDebouncer(ButtonDebouncer& debouncer, bool pressed);
+
+// Apply the level sampled after a quiet debounce period (or at the hold
+// deadline). Returns the number of events written to `events`.
+uint8_t updateButtonDebouncer(ButtonDebouncer& debouncer, bool pressed, unsigned long now,
+                              ButtonEvent* events, uint8_t maxEvents);
+
+// Milliseconds until the hold deadline, or 0 when no timer is needed
+unsigned long getButtonDebouncerTimeout(const ButtonDebouncer& debouncer, unsigned long now);
+
+// Interrupt driver (firmware only)
+#ifndef NATIVE_ENV
+bool startButtonDriver();                   // Attach the edge interrupt and create timer and queue
+bool receiveButtonEvent(ButtonEvent& event);    // Non-blocking; false when the queue is empty
+bool isButtonDriverPressed();               // Current debounced level
+uint32_t getButtonEventDrops();             // Events lost to a full queue
+void notifyButtonWake();                    // Re-sample the pin after a light sleep wake
+#endif
+
+#endif // BUTTON_DRIVER_H
@@ -0,0 +1,225 @@
+#define LOG_MODULE_ID LOG_MODULE_PARSER
+#include "can_dispatch.h"
+#include "can_dispatch_table.h"
+#include "can_id_filter.h"
+#include "message_parser.h"
+#include "state_manager.h"
+#include "logger.h"
+#include "latency_tracker.h"
+#include "can_id_stats.h"
+#include "dbc_signals.h"
+
+// Handler: parse a frame and apply it to vehicle state; false if the frame was rejected
+typedef bool (*CANMessageHandler)(const CANMessage& message);
+
+// Refresher: mark the message's state fresh when its signal bits are unchanged
+typedef void (*CANStateRefresher)(unsigned long timestamp);
+
+struct CANMessageRoute {
+    uint32_t id;
+    const char* name;
+    CANMessageHandler handle;
+    CANStateRefresher refresh;
+    uint64_t signalMask;        // Payload bits the handler reads; other bits (counters, CRCs) are ignored
+    uint16_t periodMs;          // Expected transmit cycle (0: unknown), for the per-ID missed-frame estimate
+};
+
+// Last applied payload per route, for change-only processing
+struct CANPayloadCache {
+    uint64_t maskedPayload;
+    unsigned long lastFullParse;
+    uint8_t length;
+    bool valid;
+};
+
+static bool handleBCMLampStatus(const CANMessage& message) {
+    BCMLampStatus lampStatus;
+    if (!parseBCMLampStatus(message, lampStatus)) {
+        return false;
+    }
+    markFrameParsed();
+    updateBCMLampState(lampStatus);
+    LOG_DEBUG("BCM Lamp Status updated: PudLamp=%d", lampStatus.pudLampRequest);
+    return true;
+}
+
+static bool handleLockingSystemsStatus(const CANMessage& message) {
+    LockingSystemsStatus lockStatus;
+    if (!parseLockingSystemsStatus(message, lockStatus)) {
+        return false;
+    }
+    markFrameParsed();
+    updateLockingSystemsState(lockStatus);
+    LOG_DEBUG("Lock Status updated: VehLock=%d", lockStatus.vehicleLockStatus);
+    return true;
+}
+
+static bool handlePowertrainData(const CANMessage& message) {
+    PowertrainData powertrainData;
+    if (!parsePowertrainData(message, powertrainData)) {
+        return false;
+    }
+    markFrameParsed();
+    updatePowertrainState(powertrainData);
+    LOG_DEBUG("Powertrain Data updated: ParkStatus=%d", powertrainData.transmissionParkStatus);
+    return true;
+}
+
+static bool handleBatteryManagement(const CANMessage& message) {
+    BatteryManagement batteryData;
+    if (!parseBatteryManagement(message, batteryData)) {
+        return false;
+    }
+    markFrameParsed();
+    updateBatteryState(batteryData);
+    LOG_DEBUG("Battery Data updated: SOC=%d%%", batteryData.batterySOC);
+    return true;
+}
+
+// Monitored messages - register new messages here (and nowhere else)
+// The signal mask lists the DBC signals each handler consumes.
+static constexpr CANMessageRoute CAN_ROUTES[] = {
+    {BCM_LAMP_STAT_FD1_ID, "BCM_Lamp_Stat_FD1", handleBCMLampStatus, refreshBCMLampState,
+     canSignalsPayloadMask(dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq,
+                           dbc::BCM_Lamp_Stat_FD1::Illuminated_Entry_Stat,
+                           dbc::BCM_Lamp_Stat_FD1::Dr_Courtesy_Light_Stat),
+     BCM_LAMP_STAT_FD1_PERIOD_MS},
+    {LOCKING_SYSTEMS_2_FD1_ID, "Locking_Systems_2_FD1", handleLockingSystemsStatus, refreshLockingSystemsState,
+     canSignalsPayloadMask(dbc::Locking_Systems_2_FD1::Veh_Lock_Status),
+     LOCKING_SYSTEMS_2_FD1_PERIOD_MS},
+    {POWERTRAIN_DATA_10_ID, "PowertrainData_10", handlePowertrainData, refreshPowertrainState,
+     canSignalsPayloadMask(dbc::PowertrainData_10::TrnPrkSys_D_Actl),
+     POWERTRAIN_DATA_10_PERIOD_MS},
+    {BATTERY_MGMT_3_FD1_ID, "Battery_Mgmt_3_FD1", handleBatteryManagement, refreshBatteryState,
+     canSignalsPayloadMask(dbc::Battery_Mgmt_3_FD1::BSBattSOC),
+     BATTERY_MGMT_3_FD1_PERIOD_MS},
+};
+
+static constexpr uint8_t ROUTE_COUNT = sizeof(CAN_ROUTES) / sizeof(CAN_ROUTES[0]);
+
+static_assert(canRoutesAreValid(CAN_ROUTES), "CAN routes must use unique 11-bit IDs");
+
+// 2 KB ID -> route lookup, computed by the compiler and placed in flash
+static constexpr CANDispatchTable dispatchTable = buildCANDispatchTable(CAN_ROUTES);
+
+// 256-byte ID bitmap for the software filter and isTargetCANMessage()
+static constexpr CANIdBitmap monitoredIds = buildCANIdBitmap(CAN_ROUTES);
+
+static_assert(CAN_SOFTWARE_FILTER_BATCH >= 1 && CAN_SOFTWARE_FILTER_BATCH <= CAN_ID_FILTER_MAX_BATCH,
+              "CAN_SOFTWARE_FILTER_BATCH must be 1-32 (one mask bit per frame)");
+
+static CANPayloadCache payloadCache[ROUTE_COUNT];
+static CANDispatchStats dispatchStats = {};
+
+CANDispatchResult dispatchCANMessage(const CANMessage& message) {
+    uint8_t slot = dispatchTable.slotFor(message.id);
+    if (slot == CAN_DISPATCH_NO_SLOT) {
+        recordCANIdFrame(message, 0);
+        return CAN_DISPATCH_IGNORED;
+    }
+    
+    const CANMessageRoute& route = CAN_ROUTES[slot];
+    recordCANIdFrame(message, route.periodMs);
+    CANPayloadCache& cache = payloadCache[slot];
+    dispatchStats.framesDispatched++;
+    
+#if ENABLE_CAN_CHANGE_FILTER
+    // Repeats with identical signal bits only refresh freshness - no parse, state
+    // update or logging. A full parse still runs every CAN_UNCHANGED_REPARSE_MS.
+    uint64_t maskedPayload = loadCANWord(message.data) & route.signalMask;
+    if (cache.valid && cache.length == message.length && cache.maskedPayload == maskedPayload &&
+        (message.timestamp - cache.lastFullParse) < CAN_UNCHANGED_REPARSE_MS) {
+        route.refresh(message.timestamp);
+        dispatchStats.unchangedFrames++;
+        return CAN_DISPATCH_UNCHANGED;
+    }
+#endif
+    
+    beginFrameLatency(message.arrivalUs);
+    
+    // Log raw CAN message frame data at debug level for target messages
+    logCANMessage("RX", message.id, message.data, message.length);
+    
+    if (!route.handle(message)) {
+        cache.valid = false;
+        dispatchStats.parseErrors++;
+        return CAN_DISPATCH_PARSE_ERROR;
+    }
+    
+    markFrameStateApplied(hasOutputInputChanges());
+    
+#if ENABLE_CAN_CHANGE_FILTER
+    cache.maskedPayload = maskedPayload;
+    cache.length = message.length;
+    cache.lastFullParse = message.timestamp;
+    cache.valid = true;
+#endif
+    dispatchStats.framesParsed++;
+    return CAN_DISPATCH_HANDLED;
+}
+
+uint32_t selectCANFramesToDecode(const CANMessage* frames, uint8_t count) {
+#if ENABLE_SOFTWARE_CAN_FILTER
+    return matchCANIdBatch(monitoredIds, frames, count);
+#else
+    return count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1;
+#endif
+}
+
+void skipCANMessage(const CANMessage& message) {
+    recordCANIdFrame(message, 0);
+    dispatchStats.framesFiltered++;
+}
+
+CANDispatchStats getCANDispatchStats() {
+    return dispatchStats;
+}
+
+void resetCANDispatchStatistics() {
+    dispatchStats = {};
+}
+
+// Forget cached payloads so the next frame of every message is fully parsed
+void invalidateCANPayloadCache() {
+    for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        payloadCache[i].valid = false;
+    }
+}
+
+void printCANDispatchStatistics() {
+    LOG_INFO("Message Dispatch (%d monitored messages):", ROUTE_COUNT);
+    LOG_INFO("  Frames Dispatched: %lu", dispatchStats.framesDispatched);
+    LOG_INFO("  Parsed: %lu, Unchanged (skipped): %lu, Parse Errors: %lu",
+             dispatchStats.framesParsed, dispatchStats.unchangedFrames, dispatchStats.parseErrors);
+#if ENABLE_CAN_CHANGE_FILTER
+    if (dispatchStats.framesDispatched > 0) {
+        LOG_INFO("  Change Filter: %lu%% of frames skipped (re-parse every %d ms)",
+                 (dispatchStats.unchangedFrames * 100UL) / dispatchStats.framesDispatched, CAN_UNCHANGED_REPARSE_MS);
+    }
+#else
+    LOG_INFO("  Change Filter: disabled");
+#endif
+#if ENABLE_SOFTWARE_CAN_FILTER
+    LOG_INFO("  Software Filter: %lu unmonitored frames skipped (batches of %d)",
+             dispatchStats.framesFiltered, CAN_SOFTWARE_FILTER_BATCH);
+#else
+    LOG_INFO("  Software Filter: disabled");
+#endif
+}
+
+bool isTargetCANMessage(uint32_t messageId) {
+    return monitoredIds.contains(messageId);
+}
+
+const char* getCANMessageName(uint32_t messageId) {
+    uint8_t slot = dispatchTable.slotFor(messageId);
+    return slot == CAN_DISPATCH_NO_SLOT ? NULL : CAN_ROUTES[slot].name;
+}
+
+uint8_t getMonitoredMessageCount() {
+    return ROUTE_COUNT;
+}
+
+uint32_t getMonitoredMessageId(uint8_t index) {
+    return index < ROUTE_COUNT ? CAN_ROUTES[index].id : 0;
+}
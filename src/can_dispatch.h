@@ -0,0 +1,41 @@
+#ifndef CAN_DISPATCH_H
+#define CAN_DISPATCH_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "can_manager.h"
+
+// Registration-based dispatch of received frames to parser + state updater
+// handlers. Monitored messages are registered once in can_dispatch.cpp; the
+// ID lookup table and the software filter bitmap are built from that list at
+// compile time.
+
+enum CANDispatchResult {
+    CAN_DISPATCH_IGNORED = 0,       // No handler registered for this ID
+    CAN_DISPATCH_HANDLED,           // Parsed and applied to vehicle state
+    CAN_DISPATCH_UNCHANGED,         // Signal bits unchanged - only freshness refreshed
+    CAN_DISPATCH_PARSE_ERROR        // Handler rejected the frame
+};
+
+struct CANDispatchStats {
+    uint32_t framesDispatched;      // Frames with a registered handler
+    uint32_t framesParsed;          // Fully parsed and applied
+    uint32_t unchangedFrames;       // Skipped by the change filter
+    uint32_t parseErrors;           // Rejected by the handler
+    uint32_t framesFiltered;        // Unmonitored IDs skipped by the software filter
+};
+
+// Function declarations
+CANDispatchResult dispatchCANMessage(const CANMessage& message);
+// Software filter: bit i set when frames[i] is to be dispatched (count at most 32)
+uint32_t selectCANFramesToDecode(const CANMessage* frames, uint8_t count);
+void skipCANMessage(const CANMessage& message);   // Account a frame the filter did not select
+const char* getCANMessageName(uint32_t messageId);   // NULL when not monitored
+uint8_t getMonitoredMessageCount();
+uint32_t getMonitoredMessageId(uint8_t index);
+CANDispatchStats getCANDispatchStats();
+void resetCANDispatchStatistics();
+void invalidateCANPayloadCache();
+void printCANDispatchStatistics();
+
+#endif // CAN_DISPATCH_H
@@ -0,0 +1,61 @@
+#ifndef CAN_DISPATCH_TABLE_H
+#define CAN_DISPATCH_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Compile-time CAN ID -> route slot lookup
+ *
+ * A dense table with one byte per standard (11-bit) identifier, built by a
+ * constexpr function from a route array. Each entry holds the index of the
+ * route handling that ID, or CAN_DISPATCH_NO_SLOT. Looking up a frame is one
+ * bounds check and one indexed load, whatever the number of monitored IDs.
+ *
+ * Route is any type with a uint32_t `id` member; the route array stays the
+ * single place where monitored messages are registered.
+ */
+
+#define CAN_STANDARD_ID_COUNT 2048
+#define CAN_DISPATCH_NO_SLOT 0xFF
+
+struct CANDispatchTable {
+    uint8_t slots[CAN_STANDARD_ID_COUNT];
+
+    constexpr uint8_t slotFor(uint32_t id) const {
+        return id < CAN_STANDARD_ID_COUNT ? slots[id] : (uint8_t)CAN_DISPATCH_NO_SLOT;
+    }
+};
+
+// Every route has a standard ID, no ID is registered twice, and slots fit in a byte
+template <typename Route, size_t N>
+constexpr bool canRoutesAreValid(const Route (&routes)[N]) {
+    if (N >= CAN_DISPATCH_NO_SLOT) {
+        return false;
+    }
+    for (size_t i = 0; i < N; i++) {
+        if (routes[i].id >= CAN_STANDARD_ID_COUNT) {
+            return false;
+        }
+        for (size_t j = i + 1; j < N; j++) {
+            if (routes[i].id == routes[j].id) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Route, size_t N>
+constexpr CANDispatchTable buildCANDispatchTable(const Route (&routes)[N]) {
+    CANDispatchTable table = {};
+    for (size_t id = 0; id < CAN_STANDARD_ID_COUNT; id++) {
+        table.slots[id] = CAN_DISPATCH_NO_SLOT;
+    }
+    for (size_t i = 0; i < N; i++) {
+        table.slots[routes[i].id] = (uint8_t)i;
+    }
+    return table;
+}
+
+#endif // CAN_DISPATCH_TABLE_H
@@ -0,0 +1,196 @@
+#define LOG_MODULE_ID LOG_MODULE_CAN
+#include "can_filter_planner.h"
+#include <string.h>
+#include "logger.h"
+
+#define CAN_STANDARD_ID_SPACE 2048
+
+// Filters of each buffer and the plan index of its first one
+static const uint8_t bufferFilterCount[2] = {CAN_FILTER_RXB0_FILTERS, CAN_FILTER_COUNT - CAN_FILTER_RXB0_FILTERS};
+static const uint8_t bufferFirstFilter[2] = {0, CAN_FILTER_RXB0_FILTERS};
+
+// Distinct values of (id & mask); written to distinct when it is not NULL
+static uint8_t countMaskedValues(const uint16_t* ids, uint8_t count, uint16_t mask, uint16_t* distinct) {
+    uint16_t values[CAN_FILTER_PLAN_MAX_IDS];
+    uint8_t found = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t value = ids[i] & mask;
+        bool seen = false;
+        for (uint8_t j = 0; j < found && !seen; j++) {
+            seen = values[j] == value;
+        }
+        if (!seen) {
+            values[found++] = value;
+        }
+    }
+    if (distinct != NULL) {
+        memcpy(distinct, values, found * sizeof(values[0]));
+    }
+    return found;
+}
+
+// IDs a buffer admits: each distinct masked value covers 2^(cleared mask bits) IDs
+static uint32_t admittedByMask(uint8_t distinct, uint16_t mask) {
+    return (uint32_t)distinct << (11 - __builtin_popcount(mask));
+}
+
+// Greedy mask for one buffer; returns the IDs it admits (0 for an empty group)
+static uint32_t planBuffer(const uint16_t* ids, uint8_t count, uint8_t filterSlots,
+                           uint16_t& mask, uint16_t* filters) {
+    mask = CAN_FILTER_STANDARD_MASK;
+    if (count == 0) {
+        return 0;
+    }
+
+    while (countMaskedValues(ids, count, mask, NULL) > filterSlots) {
+        uint16_t bestMask = 0;
+        uint32_t bestAdmitted = UINT32_MAX;
+        for (uint8_t bit = 0; bit < 11; bit++) {
+            if ((mask & (1u << bit)) == 0) {
+                continue;
+            }
+            uint16_t candidate = mask & ~(1u << bit);
+            uint32_t admitted = admittedByMask(countMaskedValues(ids, count, candidate, NULL), candidate);
+            if (admitted < bestAdmitted) {
+                bestAdmitted = admitted;
+                bestMask = candidate;
+            }
+        }
+        mask = bestMask;
+    }
+
+    uint8_t distinct = countMaskedValues(ids, count, mask, filters);
+    for (uint8_t i = distinct; i < filterSlots; i++) {
+        filters[i] = filters[0];
+    }
+    return admittedByMask(distinct, mask);
+}
+
+// Plan both buffers for one split of the IDs; returns the estimated admitted count
+static uint32_t planSplit(const uint16_t* ids, uint8_t count, const bool* inRxb0, CANFilterPlan& plan) {
+    uint16_t groups[2][CAN_FILTER_PLAN_MAX_IDS];
+    uint8_t groupCount[2] = {0, 0};
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t buffer = inRxb0[i] ? 0 : 1;
+        groups[buffer][groupCount[buffer]++] = ids[i];
+    }
+
+    uint32_t admitted = 0;
+    for (uint8_t buffer = 0; buffer < 2; buffer++) {
+        admitted += planBuffer(groups[buffer], groupCount[buffer], bufferFilterCount[buffer],
+                               plan.masks[buffer], &plan.filters[bufferFirstFilter[buffer]]);
+    }
+
+    // An unused buffer repeats a wanted ID exactly so it admits nothing extra
+    for (uint8_t buffer = 0; buffer < 2; buffer++) {
+        if (groupCount[buffer] == 0) {
+            for (uint8_t i = 0; i < bufferFilterCount[buffer]; i++) {
+                plan.filters[bufferFirstFilter[buffer] + i] = ids[0];
+            }
+        }
+    }
+    return admitted;
+}
+
+bool planCANFilters(const uint32_t* ids, uint8_t count, CANFilterPlan& plan) {
+    if (count == 0 || count > CAN_FILTER_PLAN_MAX_IDS) {
+        return false;
+    }
+
+    // Sorted copy: contiguous splits of sorted IDs share the most high bits
+    uint16_t sorted[CAN_FILTER_PLAN_MAX_IDS];
+    for (uint8_t i = 0; i < count; i++) {
+        if (ids[i] > CAN_FILTER_STANDARD_MASK) {
+            return false;
+        }
+        uint16_t id = (uint16_t)ids[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > id; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = id;
+    }
+
+    CANFilterPlan best;
+    CANFilterPlan candidate;
+    uint32_t bestAdmitted = UINT32_MAX;
+    bool inRxb0[CAN_FILTER_PLAN_MAX_IDS];
+
+    if (count <= CAN_FILTER_PLAN_EXHAUSTIVE_IDS) {
+        for (uint32_t split = 0; split < (1UL << count) && bestAdmitted > count; split++) {
+            for (uint8_t i = 0; i < count; i++) {
+                inRxb0[i] = (split >> i) & 1;
+            }
+            uint32_t admitted = planSplit(sorted, count, inRxb0, candidate);
+            if (admitted < bestAdmitted) {
+                bestAdmitted = admitted;
+                best = candidate;
+            }
+        }
+    } else {
+        // RXB0 takes one run [first, last) of the sorted IDs, RXB1 the rest
+        for (uint8_t first = 0; first <= count; first++) {
+            for (uint8_t last = first; last <= count; last++) {
+                for (uint8_t i = 0; i < count; i++) {
+                    inRxb0[i] = i >= first && i < last;
+                }
+                uint32_t admitted = planSplit(sorted, count, inRxb0, candidate);
+                if (admitted < bestAdmitted) {
+                    bestAdmitted = admitted;
+                    best = candidate;
+                }
+            }
+        }
+    }
+
+    plan = best;
+    plan.wantedIds = count;
+    plan.admittedIds = countCANFilterPlanAdmitted(plan);
+    return true;
+}
+
+void makeOpenCANFilterPlan(CANFilterPlan& plan) {
+    memset(&plan, 0, sizeof(plan));
+    plan.admittedIds = CAN_STANDARD_ID_SPACE;
+}
+
+bool canFilterPlanAdmits(const CANFilterPlan& plan, uint32_t id) {
+    if (id > CAN_FILTER_STANDARD_MASK) {
+        return false;
+    }
+    for (uint8_t buffer = 0; buffer < 2; buffer++) {
+        uint16_t mask = plan.masks[buffer];
+        for (uint8_t i = 0; i < bufferFilterCount[buffer]; i++) {
+            if ((id & mask) == (plan.filters[bufferFirstFilter[buffer] + i] & mask)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint16_t countCANFilterPlanAdmitted(const CANFilterPlan& plan) {
+    uint16_t admitted = 0;
+    for (uint32_t id = 0; id < CAN_STANDARD_ID_SPACE; id++) {
+        if (canFilterPlanAdmits(plan, id)) {
+            admitted++;
+        }
+    }
+    return admitted;
+}
+
+bool isCANFilterPlanExact(const CANFilterPlan& plan) {
+    return plan.admittedIds == plan.wantedIds;
+}
+
+void printCANFilterPlan(const CANFilterPlan& plan) {
+    LOG_INFO("  RXB0: mask 0x%03X, RXF0-1 0x%03X 0x%03X", plan.masks[0], plan.filters[0], plan.filters[1]);
+    LOG_INFO("  RXB1: mask 0x%03X, RXF2-5 0x%03X 0x%03X 0x%03X 0x%03X", plan.masks[1],
+             plan.filters[2], plan.filters[3], plan.filters[4], plan.filters[5]);
+    // Share of the 11-bit ID space let through, in tenths of a percent
+    unsigned passTenths = (unsigned)((plan.admittedIds * 1000UL) / CAN_STANDARD_ID_SPACE);
+    LOG_INFO("  Admits %u/%d standard IDs for %u wanted (%u unwanted), pass-through %u.%u%% of the ID space",
+             plan.admittedIds, CAN_STANDARD_ID_SPACE, plan.wantedIds,
+             plan.admittedIds > plan.wantedIds ? plan.admittedIds - plan.wantedIds : 0,
+             passTenths / 10, passTenths % 10);
+}
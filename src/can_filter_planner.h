@@ -0,0 +1,48 @@
+#ifndef CAN_FILTER_PLANNER_H
+#define CAN_FILTER_PLANNER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * MCP2515 acceptance filter planner
+ *
+ * The MCP2515 has two receive buffers: RXB0 with MASK0 and filters RXF0-RXF1,
+ * RXB1 with MASK1 and filters RXF2-RXF5. A standard frame is accepted when
+ * (id & mask) == (filter & mask) for any filter of either buffer. Up to six
+ * IDs fit exactly (mask 0x7FF); beyond that a buffer's mask has to drop bits
+ * so several wanted IDs share one filter value, which also admits the IDs
+ * that differ from them only in those bits.
+ *
+ * The planner splits the wanted IDs between the two buffers and picks each
+ * mask greedily: starting from 0x7FF it clears, one at a time, the bit that
+ * keeps the admitted ID count lowest, until the distinct masked values fit
+ * the buffer's filters. Every split is tried for up to
+ * CAN_FILTER_PLAN_EXHAUSTIVE_IDS IDs, contiguous splits of the sorted IDs
+ * above that. Pure logic, host-testable.
+ */
+
+#define CAN_FILTER_COUNT 6              // RXF0-RXF5
+#define CAN_FILTER_RXB0_FILTERS 2       // RXF0-RXF1 use MASK0
+#define CAN_FILTER_STANDARD_MASK 0x7FF
+
+struct CANFilterPlan {
+    uint16_t masks[2];                  // MASK0 (RXB0), MASK1 (RXB1)
+    uint16_t filters[CAN_FILTER_COUNT]; // RXF0-RXF5
+    uint8_t wantedIds;
+    uint16_t admittedIds;               // Standard IDs the plan accepts, wanted ones included
+};
+
+// false when count is 0 or an ID is not a standard 11-bit ID
+bool planCANFilters(const uint32_t* ids, uint8_t count, CANFilterPlan& plan);
+
+// Accept-everything plan (both masks 0), for bus surveys
+void makeOpenCANFilterPlan(CANFilterPlan& plan);
+
+bool canFilterPlanAdmits(const CANFilterPlan& plan, uint32_t id);
+uint16_t countCANFilterPlanAdmitted(const CANFilterPlan& plan);
+bool isCANFilterPlanExact(const CANFilterPlan& plan);        // Admits the wanted IDs only
+
+void printCANFilterPlan(const CANFilterPlan& plan);
+
+#endif // CAN_FILTER_PLANNER_H
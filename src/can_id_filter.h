@@ -0,0 +1,54 @@
+#ifndef CAN_ID_FILTER_H
+#define CAN_ID_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "can_dispatch_table.h"
+#include "can_protocol.h"
+
+/**
+ * Compile-time software ID filter
+ *
+ * A 2048-bit bitmap with one bit per standard (11-bit) identifier, built by a
+ * constexpr function from the same route array as the dispatch table. At 256
+ * bytes it is an eighth of the slot table, and testing an ID is one word load
+ * and a shift. matchCANIdBatch() tests a run of frames as they lie in the
+ * receive queue without a branch per frame and returns one bit per frame, so
+ * frames from an open (promiscuous) bus that nobody decodes cost a few
+ * instructions each.
+ */
+
+#define CAN_ID_FILTER_WORDS (CAN_STANDARD_ID_COUNT / 32)
+#define CAN_ID_FILTER_MAX_BATCH 32          // One mask bit per frame
+
+struct CANIdBitmap {
+    uint32_t words[CAN_ID_FILTER_WORDS];
+
+    constexpr bool contains(uint32_t id) const {
+        return id < CAN_STANDARD_ID_COUNT && ((words[id >> 5] >> (id & 31)) & 1u) != 0;
+    }
+};
+
+template <typename Route, size_t N>
+constexpr CANIdBitmap buildCANIdBitmap(const Route (&routes)[N]) {
+    CANIdBitmap bitmap = {};
+    for (size_t i = 0; i < N; i++) {
+        bitmap.words[routes[i].id >> 5] |= 1u << (routes[i].id & 31);
+    }
+    return bitmap;
+}
+
+// Bit i is set when frames[i] has an ID in the bitmap (count at most CAN_ID_FILTER_MAX_BATCH).
+// An out-of-range ID reads a wrapped word and is masked off rather than branched around.
+inline uint32_t matchCANIdBatch(const CANIdBitmap& bitmap, const CANFrame* frames, uint8_t count) {
+    uint32_t matches = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t id = frames[i].id;
+        uint32_t inRange = id < CAN_STANDARD_ID_COUNT;
+        uint32_t word = bitmap.words[(id >> 5) & (CAN_ID_FILTER_WORDS - 1)];
+        matches |= ((word >> (id & 31)) & inRange) << i;
+    }
+    return matches;
+}
+
+#endif // CAN_ID_FILTER_H
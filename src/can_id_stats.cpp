@@ -0,0 +1,167 @@
+#define LOG_MODULE_ID LOG_MODULE_CAN
+#include "can_id_stats.h"
+#include <stdio.h>
+#include <string.h>
+#include "can_dispatch.h"
+#include "logger.h"
+
+static_assert((CAN_ID_STATS_SLOTS & (CAN_ID_STATS_SLOTS - 1)) == 0, "CAN_ID_STATS_SLOTS must be a power of two");
+static_assert(CAN_ID_STATS_MAX_PROBE <= CAN_ID_STATS_SLOTS, "Probe limit exceeds the table");
+
+static CANIdStats idTable[CAN_ID_STATS_SLOTS];
+static bool slotUsed[CAN_ID_STATS_SLOTS];
+static CANIdStatsSummary summary = {0, 0, 0};
+
+static uint16_t homeSlot(uint32_t id) {
+    // Fibonacci hashing spreads the clustered Ford IDs over the table
+    return (uint16_t)(((uint32_t)(id * 2654435761UL) >> 16) & (CAN_ID_STATS_SLOTS - 1));
+}
+
+// Slot holding id, or a free slot for it; CAN_ID_STATS_SLOTS when neither is within the probe limit
+static uint16_t findSlot(uint32_t id) {
+    uint16_t slot = homeSlot(id);
+    for (uint8_t probe = 0; probe < CAN_ID_STATS_MAX_PROBE; probe++) {
+        if (!slotUsed[slot] || idTable[slot].id == id) {
+            return slot;
+        }
+        slot = (slot + 1) & (CAN_ID_STATS_SLOTS - 1);
+    }
+    return CAN_ID_STATS_SLOTS;
+}
+
+static void recordInterval(CANIdStats& stats, uint32_t intervalUs) {
+    if (intervalUs >= CAN_TIMEOUT_MS * 1000UL) {
+        stats.outages++;
+        return;
+    }
+
+    if (stats.intervals == 0 || intervalUs < stats.minIntervalUs) {
+        stats.minIntervalUs = intervalUs;
+    }
+    if (intervalUs > stats.maxIntervalUs) {
+        stats.maxIntervalUs = intervalUs;
+    }
+    if (stats.intervals > 0) {
+        uint32_t delta = intervalUs > stats.lastIntervalUs ? intervalUs - stats.lastIntervalUs
+                                                           : stats.lastIntervalUs - intervalUs;
+        stats.jitterScaledUs += delta - ((stats.jitterScaledUs + 8) >> 4);
+    }
+    stats.lastIntervalUs = intervalUs;
+    stats.intervalTotalUs += intervalUs;
+    stats.intervals++;
+
+    if (stats.expectedPeriodMs > 0) {
+        uint32_t periodUs = stats.expectedPeriodMs * 1000UL;
+        uint32_t periods = (intervalUs + periodUs / 2) / periodUs;
+        if (periods > 1) {
+            stats.missedFrames += periods - 1;
+        }
+    }
+}
+
+void recordCANIdFrame(const CANMessage& message, uint16_t expectedPeriodMs) {
+    uint16_t slot = findSlot(message.id);
+    if (slot == CAN_ID_STATS_SLOTS) {
+        summary.untrackedFrames++;
+        return;
+    }
+
+    CANIdStats& stats = idTable[slot];
+    if (!slotUsed[slot]) {
+        memset(&stats, 0, sizeof(stats));
+        stats.id = message.id;
+        stats.expectedPeriodMs = expectedPeriodMs;
+        slotUsed[slot] = true;
+        summary.trackedIds++;
+    } else {
+        recordInterval(stats, message.arrivalUs - stats.lastArrivalUs);
+    }
+
+    stats.count++;
+    stats.lastArrivalUs = message.arrivalUs;
+    stats.length = message.length > 8 ? 8 : message.length;
+    memcpy(stats.data, message.data, sizeof(stats.data));
+    summary.trackedFrames++;
+}
+
+bool getCANIdStats(uint32_t id, CANIdStats& stats) {
+    uint16_t slot = findSlot(id);
+    if (slot == CAN_ID_STATS_SLOTS || !slotUsed[slot]) {
+        return false;
+    }
+    stats = idTable[slot];
+    return true;
+}
+
+uint16_t getCANIdStatsCapacity() {
+    return CAN_ID_STATS_SLOTS;
+}
+
+bool getCANIdStatsAt(uint16_t slot, CANIdStats& stats) {
+    if (slot >= CAN_ID_STATS_SLOTS || !slotUsed[slot]) {
+        return false;
+    }
+    stats = idTable[slot];
+    return true;
+}
+
+CANIdStatsSummary getCANIdStatsSummary() {
+    return summary;
+}
+
+uint32_t getCANIdMeanIntervalUs(const CANIdStats& stats) {
+    return stats.intervals > 0 ? (uint32_t)(stats.intervalTotalUs / stats.intervals) : 0;
+}
+
+uint32_t getCANIdJitterUs(const CANIdStats& stats) {
+    return stats.jitterScaledUs >> 4;
+}
+
+void resetCANIdStatistics() {
+    memset(slotUsed, 0, sizeof(slotUsed));
+    summary = {0, 0, 0};
+}
+
+void printCANIdStatistics() {
+    LOG_INFO("=== CAN IDS (%u/%d slots, %lu frames, %lu untracked) ===", summary.trackedIds,
+             CAN_ID_STATS_SLOTS, (unsigned long)summary.trackedFrames, (unsigned long)summary.untrackedFrames);
+    LOG_INFO("id      count     Hz  mean_us   max_us  jit_us  exp_ms  miss  out  last payload (* monitored)");
+
+    // Ascending ID order without sorting the table in place
+    bool havePrevious = false;
+    uint32_t previousId = 0;
+    for (uint16_t printed = 0; printed < summary.trackedIds; printed++) {
+        uint16_t next = CAN_ID_STATS_SLOTS;
+        for (uint16_t slot = 0; slot < CAN_ID_STATS_SLOTS; slot++) {
+            if (!slotUsed[slot] || (havePrevious && idTable[slot].id <= previousId)) {
+                continue;
+            }
+            if (next == CAN_ID_STATS_SLOTS || idTable[slot].id < idTable[next].id) {
+                next = slot;
+            }
+        }
+        if (next == CAN_ID_STATS_SLOTS) {
+            break;
+        }
+
+        const CANIdStats& stats = idTable[next];
+        uint32_t meanUs = getCANIdMeanIntervalUs(stats);
+        unsigned long rateTenths = meanUs > 0 ? 10000000UL / meanUs : 0;
+        char payload[17];
+        for (uint8_t i = 0; i < stats.length; i++) {
+            snprintf(payload + i * 2, 3, "%02X", stats.data[i]);
+        }
+        payload[stats.length * 2] = '\0';
+
+        // Twelve arguments at most: this line may go through the deferred log
+        LOG_INFO("%03lX%s %7lu %4lu.%lu %8lu %8lu %7lu %7u %5lu %4lu  %s",
+                 (unsigned long)stats.id, isTargetCANMessage(stats.id) ? "*" : " ",
+                 (unsigned long)stats.count, rateTenths / 10, rateTenths % 10, (unsigned long)meanUs,
+                 (unsigned long)stats.maxIntervalUs, (unsigned long)getCANIdJitterUs(stats),
+                 stats.expectedPeriodMs, (unsigned long)stats.missedFrames, (unsigned long)stats.outages,
+                 payload);
+
+        havePrevious = true;
+        previousId = stats.id;
+    }
+}
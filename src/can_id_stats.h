@@ -0,0 +1,63 @@
+#ifndef CAN_ID_STATS_H
+#define CAN_ID_STATS_H
+
+#include <stdint.h>
+#include "config.h"
+#include "can_manager.h"
+
+/**
+ * Per-CAN-ID receive statistics
+ *
+ * Every frame the dispatcher sees - monitored or not - is recorded against
+ * its ID in a fixed open-addressing table (CAN_ID_STATS_SLOTS entries, at
+ * most CAN_ID_STATS_MAX_PROBE probes), so an update is O(1) and needs no
+ * allocation. IDs that find no slot are only counted as untracked.
+ *
+ * Inter-arrival times use the frame's arrival stamp (microseconds). Jitter
+ * is the RFC 3550 interarrival estimator: a running average, gain 1/16, of
+ * the change between consecutive intervals. With an expected cycle time, an
+ * interval of n periods counts n - 1 missed frames. Gaps of CAN_TIMEOUT_MS or
+ * more are bus outages (ignition off, recovery) and are counted separately
+ * instead of skewing the interval statistics.
+ */
+
+struct CANIdStats {
+    uint32_t id;
+    uint32_t count;
+    uint32_t lastArrivalUs;
+    uint32_t intervals;             // Intervals in the statistics below (outages excluded)
+    uint64_t intervalTotalUs;
+    uint32_t minIntervalUs;
+    uint32_t maxIntervalUs;
+    uint32_t lastIntervalUs;
+    uint32_t jitterScaledUs;        // Jitter x 16 (RFC 3550 fixed point)
+    uint32_t missedFrames;          // Estimated from expectedPeriodMs
+    uint32_t outages;               // Gaps of CAN_TIMEOUT_MS or more
+    uint16_t expectedPeriodMs;      // 0: unknown, no missed-frame estimate
+    uint8_t length;
+    uint8_t data[8];                // Last payload
+};
+
+struct CANIdStatsSummary {
+    uint16_t trackedIds;
+    uint32_t trackedFrames;
+    uint32_t untrackedFrames;       // Frames whose ID found no free slot
+};
+
+// Record one frame; expectedPeriodMs is only used when the ID is first seen
+void recordCANIdFrame(const CANMessage& message, uint16_t expectedPeriodMs);
+
+// Lookup and iteration (slot order, i.e. unsorted)
+bool getCANIdStats(uint32_t id, CANIdStats& stats);
+uint16_t getCANIdStatsCapacity();
+bool getCANIdStatsAt(uint16_t slot, CANIdStats& stats);     // false for an empty slot
+CANIdStatsSummary getCANIdStatsSummary();
+
+// Derived figures
+uint32_t getCANIdMeanIntervalUs(const CANIdStats& stats);
+uint32_t getCANIdJitterUs(const CANIdStats& stats);
+
+void resetCANIdStatistics();
+void printCANIdStatistics();        // Compact dump, one line per ID sorted by ID
+
+#endif // CAN_ID_STATS_H
@@ -1,245 +1,694 @@
+#define LOG_MODULE_ID LOG_MODULE_CAN
 #include "can_manager.h"
+#include <stddef.h>
 #include <SPI.h>
 #include <mcp2515.h>
+#include "can_ring_buffer.h"
+#if ENABLE_CAN_RX_TASK
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#endif
+#if ENABLE_TWAI_CONTROLLER
+#include "twai_controller.h"
+#endif
+#include "loop_scheduler.h"
+#include "can_recovery.h"
+#include "can_dispatch.h"
+#include "can_filter_planner.h"
+#include "mcp2515_burst.h"
+#include "memory_budget.h"
+#include <esp_timer.h>
 
 // MCP2515 CAN controller instance
-MCP2515 mcp2515(CAN_CS_PIN);
+MCP2515 mcp2515(CAN_CS_PIN, CAN_SPI_CLOCK_HZ);
 
 // Global CAN state
-static bool canInitialized = false;
-static bool canConnected = false;
-static unsigned long lastCANActivity = 0;
-static uint32_t messagesReceived = 0;
-static uint32_t canErrors = 0;
-
-// Message loss tracking
-static uint32_t messageLossCount = 0;
-static uint32_t lastMessageLossCheck = 0;
+// Written by the receive path and read from loop(), which may be on another core
+static volatile bool canInitialized = false;
+static volatile bool canConnected = false;
+static volatile unsigned long lastCANActivity = 0;
+static volatile uint32_t messagesReceived = 0;
+static volatile uint32_t canErrors = 0;
+
+// Message loss tracking (exact counts from the MCP2515 EFLG register)
+static CANErrorStats errorStats = {0, 0, 0, 0, 0, 0, 0, 0};
 static unsigned long lastOverflowWarning = 0;
+
+// SPI traffic of the receive path (cmd_can_buffers)
+static MCP2515SpiStats spiStats = {0, 0, 0, 0, 0, 0};
 const unsigned long OVERFLOW_WARNING_INTERVAL = 5000; // Warn every 5 seconds max
 
-bool initializeCAN() {
-    LOG_INFO("Initializing CAN bus (MCP2515) in LISTEN-ONLY mode...");
-    LOG_INFO("Using X2 header (CAN2H/CAN2L) with MCP2515 controller");
-    
-    // Check if already initialized
-    if (canInitialized) {
-        LOG_WARN("CAN driver already initialized");
-        return isCANConnected();
+// Software receive queue between the CAN receive path (producer) and the
+// parsing loop (consumer). Frames wait here instead of in the MCP2515's two
+// hardware buffers, so bus bursts no longer overflow while loop() is busy.
+static SPSCRingBuffer<CANMessage, CAN_RX_QUEUE_SIZE> rxQueue;
+
+#if ENABLE_TWAI_CONTROLLER && MCP2515_ROLE == MCP2515_ROLE_HOT_STANDBY
+// MCP2515 frames read while TWAI was healthy (duplicates of the primary path)
+static uint32_t standbyFramesDiscarded = 0;
+#endif
+
+#if ENABLE_CAN_RX_TASK
+// Dedicated receive task: the only caller of serviceCANReceive() once started
+static TaskHandle_t canRxTaskHandle = NULL;
+static volatile uint32_t canRxTaskWakeups = 0;
+
+// Serializes MCP2515 SPI access between the receive task and the loop()-side
+// diagnostics and recovery paths. Recursive so recovery can call helpers that lock too.
+static SemaphoreHandle_t canControllerMutex = NULL;
+
+class CANControllerLock {
+public:
+    CANControllerLock() {
+        if (canControllerMutex != NULL) {
+            xSemaphoreTakeRecursive(canControllerMutex, portMAX_DELAY);
+        }
     }
+    ~CANControllerLock() {
+        if (canControllerMutex != NULL) {
+            xSemaphoreGiveRecursive(canControllerMutex);
+        }
+    }
+};
+#else
+// Single-threaded receive: everything runs from loop(), nothing to serialize
+class CANControllerLock {};
+#endif
+
+#if ENABLE_CAN_RX_INTERRUPT
+// Interrupt-driven receive state
+// The ISR only arms the reader; all SPI traffic happens in serviceCANReceive()
+static volatile bool canRxPending = false;
+static volatile uint32_t canInterruptCount = 0;
+static volatile uint32_t canRxPendingSinceUs = 0;  // First INT edge since the last drain (frame arrival)
+
+// MCP2515 INT falling edge - a frame (or error) is waiting in the controller
+static void IRAM_ATTR onCANInterrupt() {
+    if (!canRxPending) {
+        canRxPendingSinceUs = (uint32_t)esp_timer_get_time();
+    }
+    canRxPending = true;
+    canInterruptCount++;
+    
+#if ENABLE_CAN_RX_TASK
+    if (canRxTaskHandle != NULL) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(canRxTaskHandle, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+        return;
+    }
+#endif
+    // No receive task: loop() drains the controller itself
+    signalLoopEventFromISR(LOOP_EVENT_CAN_RX);
+}
+#endif
+
+// Ask the receive path to drain the controller on its next pass
+static void requestCANReceiveService() {
+#if ENABLE_CAN_RX_INTERRUPT
+    if (!canRxPending) {
+        canRxPendingSinceUs = (uint32_t)esp_timer_get_time();
+    }
+    canRxPending = true;
+#endif
+#if ENABLE_CAN_RX_TASK
+    if (canRxTaskHandle != NULL) {
+        xTaskNotifyGive(canRxTaskHandle);
+    }
+#endif
+}
+
+void notifyCANWake() {
+    // A wake edge is consumed by the GPIO wakeup logic, so onCANInterrupt()
+    // may not have run for the frame that ended the sleep
+    requestCANReceiveService();
+    signalLoopEvent(LOOP_EVENT_CAN_RX);
+}
+
+// Whether MCP2515 frames should be queued for parsing right now
+static bool shouldQueueMCP2515Frames() {
+#if ENABLE_TWAI_CONTROLLER && MCP2515_ROLE == MCP2515_ROLE_HOT_STANDBY
+    // Hot standby: keep draining the MCP2515 so it stays current, but only
+    // forward its frames once the primary TWAI path has gone quiet
+    static bool failedOver = false;
+    bool twaiSilent = !isTWAIActive() ||
+                      (millis() - getTWAILastFrameTime()) > CAN_STANDBY_FAILOVER_MS;
+    
+    if (twaiSilent != failedOver) {
+        failedOver = twaiSilent;
+        if (failedOver) {
+            LOG_WARN("TWAI silent for %d ms - failing over to MCP2515 standby", CAN_STANDBY_FAILOVER_MS);
+        } else {
+            LOG_INFO("TWAI traffic restored - MCP2515 back to standby");
+        }
+    }
+    if (!failedOver) {
+        standbyFramesDiscarded++;
+    }
+    return failedOver;
+#else
+    return true;
+#endif
+}
+
+// The MCP2515 library reads into a struct can_frame; CANFrame starts with the same layout
+static_assert(offsetof(CANFrame, id) == offsetof(struct can_frame, can_id), "CANFrame must overlay can_frame");
+static_assert(offsetof(CANFrame, length) == offsetof(struct can_frame, can_dlc), "CANFrame must overlay can_frame");
+static_assert(offsetof(CANFrame, data) == offsetof(struct can_frame, data), "CANFrame must overlay can_frame");
+static_assert(sizeof(struct can_frame) <= offsetof(CANFrame, timestamp), "can_frame must fit in front of the metadata");
+static_assert(alignof(CANFrame) >= alignof(struct can_frame), "CANFrame slots must be aligned for can_frame");
+static_assert(MCP2515_ID_EXTENDED_FLAG == CAN_EFF_FLAG && MCP2515_ID_REMOTE_FLAG == CAN_RTR_FLAG,
+              "Burst reads must flag IDs like the library");
+
+// Read one MCP2515 receive buffer straight into the next software queue slot
+static bool readBufferIntoQueue(MCP2515::RXBn rxBuffer, uint32_t arrivalUs) {
+    // A full queue still has to be drained to release the buffer
+    static CANMessage overflowFrame;
+    CANMessage* slot = rxQueue.reserve();
+    CANMessage* message = slot != nullptr ? slot : &overflowFrame;
+#if ENABLE_MCP2515_BURST_READ
+    // One READ RX BUFFER transaction; raising CS releases the buffer even on a bad DLC
+    if (!readMCP2515RxBuffer(rxBuffer == MCP2515::RXB0 ? 0 : 1, *message)) {
+        canErrors++;
+        LOG_DEBUG("CAN RXB%d read error: DLC %d", (int)rxBuffer, (int)message->length);
+        return false;
+    }
+    noteMCP2515FrameRead(spiStats, *message, true);
+#else
+    MCP2515::ERROR result = mcp2515.readMessage(rxBuffer, reinterpret_cast<struct can_frame*>(message));
     
-    // Initialize SPI for MCP2515
-    SPI.begin(CAN_CLK_PIN, CAN_MISO_PIN, CAN_MOSI_PIN, CAN_CS_PIN);
-    
-    // Reset MCP2515
-    mcp2515.reset();
-    
-    // Set CAN bit rate to 500kbps with 16MHz crystal
-    MCP2515::ERROR result = mcp2515.setBitrate(CAN_500KBPS, MCP_16MHZ);
     if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set CAN bitrate: %d", (int)result);
         canErrors++;
+        LOG_DEBUG("CAN RXB%d read error: %d", (int)rxBuffer, (int)result);
         return false;
     }
+    noteMCP2515FrameRead(spiStats, *message, false);
+#endif
     
-#if ENABLE_HARDWARE_CAN_FILTERING
-    // Configure hardware filtering to only receive our target messages
-    // This improves efficiency by filtering at the MCP2515 level
-    LOG_INFO("Configuring hardware CAN message filtering...");
+    messagesReceived++;
+    lastCANActivity = millis();
+    canConnected = true;
     
-    // MCP2515 has 2 RXB buffers, each with 2 filters (total 4 filters + 2 masks)
-    // We have exactly 4 target messages, so we can use one filter per message
+    if (!shouldQueueMCP2515Frames()) {
+        return false; // Standby controller - frame read to keep buffers clear, not parsed
+    }
     
-    // Set all filters to our target message IDs
-    result = mcp2515.setFilter(MCP2515::RXF0, false, BCM_LAMP_STAT_FD1_ID);
-    if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set filter RXF0: %d", (int)result);
-        canErrors++;
+    // A full queue drops the newest frame; the ring counts it for cmd_can_buffers
+    if (slot == nullptr) {
+        rxQueue.countDrop();
         return false;
     }
+    message->timestamp = lastCANActivity;
+    message->source = CAN_SOURCE_MCP2515;
+    message->arrivalUs = arrivalUs;
+    rxQueue.commit();
+    return true;
+}
+
+// TEC and REC are neighbours; the burst path reads both in one transaction
+static void readCANErrorCounters() {
+#if ENABLE_MCP2515_BURST_READ
+    uint8_t counters[2];
+    readMCP2515Registers(MCP2515_REG_TEC, counters, 2);
+    errorStats.transmitErrorCount = counters[0];
+    errorStats.receiveErrorCount = counters[1];
+#else
+    errorStats.transmitErrorCount = mcp2515.errorCountTX();
+    errorStats.receiveErrorCount = mcp2515.errorCountRX();
+#endif
+}
+
+// Account EFLG and TEC/REC, count receive overflows per buffer and clear the latched flags.
+// Called when the controller raises ERRIF, so it costs no SPI traffic on the normal path.
+static void accountCANErrorFlags(uint8_t flags) {
+    errorStats.lastErrorFlags = flags;
+    errorStats.errorInterrupts++;
+    readCANErrorCounters();
+    if (errorStats.receiveErrorCount > errorStats.peakReceiveErrorCount) {
+        errorStats.peakReceiveErrorCount = errorStats.receiveErrorCount;
+    }
     
-    result = mcp2515.setFilter(MCP2515::RXF1, false, LOCKING_SYSTEMS_2_FD1_ID);
-    if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set filter RXF1: %d", (int)result);
-        canErrors++;
+    if (flags & (MCP2515::EFLG_RX0OVR | MCP2515::EFLG_RX1OVR)) {
+        if (flags & MCP2515::EFLG_RX0OVR) {
+            errorStats.rx0Overflows++;
+        }
+        if (flags & MCP2515::EFLG_RX1OVR) {
+            errorStats.rx1Overflows++;
+        }
+        
+        // RXnOVR is latched until cleared; clear it so the next overflow is counted
+        mcp2515.clearRXnOVRFlags();
+        
+        unsigned long currentTime = millis();
+        if (currentTime - lastOverflowWarning >= OVERFLOW_WARNING_INTERVAL) {
+            LOG_WARN("MCP2515 RX overflow - frames lost (RXB0: %lu, RXB1: %lu, EFLG=0x%02X)",
+                     errorStats.rx0Overflows, errorStats.rx1Overflows, flags);
+            lastOverflowWarning = currentTime;
+        }
+    }
+    
+    mcp2515.clearERRIF();
+}
+
+// Drain RXB0/RXB1 while the MCP2515 reports received frames. Frames found on the
+// first pass arrived by the INT edge that started the drain; later ones are
+// stamped when they are read.
+static uint16_t drainCANReceiveBuffers(uint32_t firstArrivalUs) {
+    uint16_t framesQueued = 0;
+    
+    for (int pass = 0; pass < CAN_RX_QUEUE_SIZE; pass++) {
+        uint32_t arrivalUs = pass == 0 ? firstArrivalUs : (uint32_t)esp_timer_get_time();
+#if ENABLE_MCP2515_BURST_READ
+        // CANINTF and EFLG in one READ
+        uint8_t status[2];
+        readMCP2515Registers(MCP2515_REG_CANINTF, status, 2);
+        noteMCP2515StatusRead(spiStats, true);
+        uint8_t interrupts = status[0];
+        uint8_t errorFlags = status[1];
+#else
+        uint8_t interrupts = mcp2515.getInterrupts();
+        noteMCP2515StatusRead(spiStats, false);
+#endif
+        
+        // Error interrupts also hold INT low; account and clear them so later edges are not masked
+        if (interrupts & MCP2515::CANINTF_ERRIF) {
+#if ENABLE_MCP2515_BURST_READ
+            accountCANErrorFlags(errorFlags);
+#else
+            accountCANErrorFlags(mcp2515.getErrorFlags());
+#endif
+        }
+        if (interrupts & MCP2515::CANINTF_MERRF) {
+            mcp2515.clearMERR();
+        }
+        
+        if (!(interrupts & (MCP2515::CANINTF_RX0IF | MCP2515::CANINTF_RX1IF))) {
+            break; // Both receive buffers empty
+        }
+        
+        if ((interrupts & MCP2515::CANINTF_RX0IF) && readBufferIntoQueue(MCP2515::RXB0, arrivalUs)) {
+            framesQueued++;
+        }
+        if ((interrupts & MCP2515::CANINTF_RX1IF) && readBufferIntoQueue(MCP2515::RXB1, arrivalUs)) {
+            framesQueued++;
+        }
+    }
+    
+    return framesQueued;
+}
+
+// Acceptance filters planned from the dispatcher's IDs, or open for bus surveys
+static CANFilterPlan filterPlan;
+static bool filterPlanReady = false;
+static bool filtersOpen = !ENABLE_HARDWARE_CAN_FILTERING;
+
+static const MCP2515::RXF filterRegisters[CAN_FILTER_COUNT] = {
+    MCP2515::RXF0, MCP2515::RXF1, MCP2515::RXF2, MCP2515::RXF3, MCP2515::RXF4, MCP2515::RXF5
+};
+
+static bool ensureFilterPlan() {
+    if (filterPlanReady) {
+        return true;
+    }
+    uint32_t ids[CAN_FILTER_PLAN_MAX_IDS];
+    uint8_t count = getMonitoredMessageCount();
+    if (count > CAN_FILTER_PLAN_MAX_IDS) {
+        LOG_ERROR("%d monitored IDs exceed the filter planner limit of %d", count, CAN_FILTER_PLAN_MAX_IDS);
         return false;
     }
+    for (uint8_t i = 0; i < count; i++) {
+        ids[i] = getMonitoredMessageId(i);
+    }
+    filterPlanReady = planCANFilters(ids, count, filterPlan);
+    return filterPlanReady;
+}
+
+// Write masks and filters (the library switches the MCP2515 to configuration
+// mode); the caller restores listen-only mode
+static bool writeMCP2515Filters() {
+    CANFilterPlan plan;
+    if (filtersOpen || !ensureFilterPlan()) {
+        makeOpenCANFilterPlan(plan);
+    } else {
+        plan = filterPlan;
+    }
     
-    result = mcp2515.setFilter(MCP2515::RXF2, false, POWERTRAIN_DATA_10_ID);
+    const MCP2515::MASK maskRegisters[2] = {MCP2515::MASK0, MCP2515::MASK1};
+    for (uint8_t i = 0; i < 2; i++) {
+        MCP2515::ERROR result = mcp2515.setFilterMask(maskRegisters[i], false, plan.masks[i]);
+        if (result != MCP2515::ERROR_OK) {
+            LOG_ERROR("Failed to set filter mask MASK%d: %d", i, (int)result);
+            canErrors++;
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < CAN_FILTER_COUNT; i++) {
+        MCP2515::ERROR result = mcp2515.setFilter(filterRegisters[i], false, plan.filters[i]);
+        if (result != MCP2515::ERROR_OK) {
+            LOG_ERROR("Failed to set filter RXF%d: %d", i, (int)result);
+            canErrors++;
+            return false;
+        }
+    }
+    
+    if (plan.masks[0] == 0 && plan.masks[1] == 0) {
+        LOG_INFO("Hardware filtering open - receiving all CAN messages");
+    } else {
+        LOG_INFO("Hardware filtering configured for %d target messages:", plan.wantedIds);
+        printCANFilterPlan(plan);
+    }
+    return true;
+}
+
+// Bitrate, acceptance filters and listen-only mode; also used after a
+// recovery reset, which clears the filter registers
+static bool configureMCP2515() {
+    // Set CAN bit rate to 500kbps with 16MHz crystal
+    MCP2515::ERROR result = mcp2515.setBitrate(CAN_500KBPS, MCP_16MHZ);
     if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set filter RXF2: %d", (int)result);
+        LOG_ERROR("Failed to set CAN bitrate: %d", (int)result);
         canErrors++;
         return false;
     }
     
-    result = mcp2515.setFilter(MCP2515::RXF3, false, BATTERY_MGMT_3_FD1_ID);
-    if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set filter RXF3: %d", (int)result);
-        canErrors++;
+    if (!writeMCP2515Filters()) {
         return false;
     }
     
-    // Set masks to match exact IDs (0x7FF masks all 11 bits for standard CAN)
-    result = mcp2515.setFilterMask(MCP2515::MASK0, false, 0x7FF);
+    // Set to listen-only mode (no ACK, no error frames)
+    result = mcp2515.setListenOnlyMode();
     if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set filter mask MASK0: %d", (int)result);
+        LOG_ERROR("Failed to set listen-only mode: %d", (int)result);
         canErrors++;
         return false;
     }
     
-    result = mcp2515.setFilterMask(MCP2515::MASK1, false, 0x7FF);
+    return true;
+}
+
+// Rewrite the acceptance filters in place: configuration mode for the register
+// writes, then straight back to listen-only. Frames on the bus during the few
+// SPI transfers are missed; the queue and any buffered frames are kept.
+bool setCANFiltersOpen(bool open) {
+    CANControllerLock lock;
+    filtersOpen = open;
+    if (!canInitialized) {
+        return true;    // Applied when the controller is configured
+    }
+    
+    bool written = writeMCP2515Filters();
+    MCP2515::ERROR result = mcp2515.setListenOnlyMode();
     if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set filter mask MASK1: %d", (int)result);
+        LOG_ERROR("Failed to restore listen-only mode after filter update: %d", (int)result);
         canErrors++;
+        handleCANError();
+        return false;
+    }
+    return written;
+}
+
+bool areCANFiltersOpen() {
+    return filtersOpen;
+}
+
+bool getCANFilterPlan(CANFilterPlan& plan) {
+    if (!ensureFilterPlan()) {
         return false;
     }
+    plan = filterPlan;
+    return true;
+}
+
+// Bring up the MCP2515 on the X2 header
+static bool initializeMCP2515() {
+    LOG_INFO("Initializing CAN bus (MCP2515) in LISTEN-ONLY mode...");
+    LOG_INFO("Using X2 header (CAN2H/CAN2L) with MCP2515 controller");
     
-    LOG_INFO("Hardware filtering configured for 4 target messages:");
-    LOG_INFO("  BCM_Lamp_Stat_FD1: 0x%03X (%d)", BCM_LAMP_STAT_FD1_ID, BCM_LAMP_STAT_FD1_ID);
-    LOG_INFO("  Locking_Systems_2_FD1: 0x%03X (%d)", LOCKING_SYSTEMS_2_FD1_ID, LOCKING_SYSTEMS_2_FD1_ID);
-    LOG_INFO("  PowertrainData_10: 0x%03X (%d)", POWERTRAIN_DATA_10_ID, POWERTRAIN_DATA_10_ID);
-    LOG_INFO("  Battery_Mgmt_3_FD1: 0x%03X (%d)", BATTERY_MGMT_3_FD1_ID, BATTERY_MGMT_3_FD1_ID);
-#else
-    LOG_INFO("Hardware filtering disabled - receiving all CAN messages");
-#endif
+    // Check if already initialized
+    if (canInitialized) {
+        LOG_WARN("CAN driver already initialized");
+        return isCANConnected();
+    }
     
-    // Set to listen-only mode (no ACK, no error frames)
-    result = mcp2515.setListenOnlyMode();
-    if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set listen-only mode: %d", (int)result);
-        canErrors++;
+    // Initialize SPI for MCP2515
+    SPI.begin(CAN_CLK_PIN, CAN_MISO_PIN, CAN_MOSI_PIN, CAN_CS_PIN);
+    
+    // Reset MCP2515
+    mcp2515.reset();
+    
+    if (!configureMCP2515()) {
         return false;
     }
     
+#if ENABLE_CAN_RX_INTERRUPT
+    // Arm the receive path from the MCP2515 INT line (active low, open drain)
+    pinMode(CAN_IRQ_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(CAN_IRQ_PIN), onCANInterrupt, FALLING);
+    canRxPending = true; // Drain anything latched before the ISR was attached
+    LOG_INFO("Interrupt-driven receive enabled on CAN_IRQ_PIN (%d), queue depth %d", CAN_IRQ_PIN, CAN_RX_QUEUE_SIZE);
+#endif
+    
     canInitialized = true;
     canConnected = true;
     LOG_INFO("CAN bus initialized successfully using MCP2515");
-#if ENABLE_HARDWARE_CAN_FILTERING
-    LOG_INFO("Ready to receive messages on X2 header (CAN2H/CAN2L) with hardware filtering");
-#else
-    LOG_INFO("Ready to receive messages on X2 header (CAN2H/CAN2L) without hardware filtering");
-#endif
+    LOG_INFO("Ready to receive messages on X2 header (CAN2H/CAN2L) %s hardware filtering",
+             filtersOpen ? "without" : "with");
     
     return true;
 }
 
-bool receiveCANMessage(CANMessage& message) {
-    if (!canInitialized) {
+// Hardware steps of a full recovery (sequenced by can_recovery.cpp). Each
+// takes the controller lock only for its own duration.
+static void recoveryResetController() {
+    LOG_WARN("Performing full CAN system recovery...");
+    CANControllerLock lock;
+    canInitialized = false;     // Receive path leaves the MCP2515 alone until configured
+    canConnected = false;
+    mcp2515.reset();
+}
+
+static void recoveryStopBus() {
+    CANControllerLock lock;
+    SPI.end();
+}
+
+static void recoveryStartBus() {
+    CANControllerLock lock;
+    SPI.begin(CAN_CLK_PIN, CAN_MISO_PIN, CAN_MOSI_PIN, CAN_CS_PIN);
+}
+
+static bool recoveryConfigureController() {
+    CANControllerLock lock;
+    if (!configureMCP2515()) {
+        LOG_ERROR("Full CAN system recovery failed");
         return false;
     }
     
-    // Check for message loss before reading new messages
-    checkMessageLoss();
+    canInitialized = true;
+    canConnected = true;
+    lastCANActivity = millis();
+    messagesReceived = 0;
+    canErrors = 0;
     
-    struct can_frame frame;
-    MCP2515::ERROR result = mcp2515.readMessage(&frame);
+    // reset() re-enables the RX interrupts; drain anything that arrived meanwhile
+    requestCANReceiveService();
     
-    if (result == MCP2515::ERROR_OK) {
-        // Convert MCP2515 frame to our CANMessage structure
-        message.id = frame.can_id;
-        message.length = frame.can_dlc;
-        memcpy(message.data, frame.data, frame.can_dlc);
-        message.timestamp = millis();
-        
-        messagesReceived++;
-        lastCANActivity = millis();
-        canConnected = true;
-        
-        return true;
-    } else if (result == MCP2515::ERROR_NOMSG) {
-        // No message available - not an error
-        return false;
-    } else {
-        // Actual error occurred
-        canErrors++;
-        LOG_DEBUG("CAN receive error: %d", (int)result);
-        return false;
-    }
+    LOG_INFO("Full CAN system recovery successful");
+    return true;
 }
 
-// Debug function to receive and log any CAN message (not just target messages)
-void debugReceiveAllMessages() {
-    if (!canInitialized || !canConnected) {
-        return;
+static const CANRecoveryOps mcp2515RecoveryOps = {
+    recoveryResetController,
+    recoveryStopBus,
+    recoveryStartBus,
+    recoveryConfigureController
+};
+
+bool initializeCAN() {
+    initCANRecovery(&mcp2515RecoveryOps);
+    
+#if ENABLE_CAN_RX_TASK
+    if (canControllerMutex == NULL) {
+        canControllerMutex = xSemaphoreCreateRecursiveMutex();
     }
+#endif
     
-    struct can_frame frame;
-    int messagesProcessed = 0;
-    const int MAX_DEBUG_MESSAGES = 50; // Prevent spam
+#if ENABLE_TWAI_CONTROLLER
+    // Dual-controller mode: TWAI (X1) is the primary receiver, the MCP2515 (X2)
+    // is either a second bus or a hot standby depending on MCP2515_ROLE
+    bool twaiReady = initializeTWAI();
+    bool mcp2515Ready = initializeMCP2515();
     
-    while (messagesProcessed < MAX_DEBUG_MESSAGES) {
-        MCP2515::ERROR result = mcp2515.readMessage(&frame);
-        
-        if (result == MCP2515::ERROR_OK) {
-            messagesProcessed++;
-            lastCANActivity = millis();
-            
-            // Log the message
-            LOG_INFO("DEBUG CAN RX: ID=0x%03X (%d), Len=%d, Data=[%02X %02X %02X %02X %02X %02X %02X %02X]",
-                frame.can_id, frame.can_id, frame.can_dlc,
-                frame.data[0], frame.data[1], frame.data[2], frame.data[3],
-                frame.data[4], frame.data[5], frame.data[6], frame.data[7]);
-        } else if (result == MCP2515::ERROR_NOMSG) {
-            // No more messages available
+    if (!twaiReady && !mcp2515Ready) {
+        LOG_ERROR("No CAN controller could be initialized");
+        return false;
+    }
+    if (!twaiReady) {
+        LOG_WARN("TWAI unavailable - continuing on MCP2515 only");
+    }
+    if (!mcp2515Ready) {
+        LOG_WARN("MCP2515 unavailable - continuing on TWAI only");
+    }
+    
+    canConnected = true;
+    LOG_INFO("Dual-controller receive: TWAI %s, MCP2515 %s (%s)",
+             twaiReady ? "OK" : "FAILED", mcp2515Ready ? "OK" : "FAILED",
+             MCP2515_ROLE == MCP2515_ROLE_HOT_STANDBY ? "hot standby" : "second bus");
+    return true;
+#else
+    return initializeMCP2515();
+#endif
+}
+
+#if ENABLE_TWAI_CONTROLLER
+// Move frames from the TWAI driver queue into the software queue
+static uint16_t drainTWAIReceiveQueue() {
+    uint16_t framesQueued = 0;
+    static CANMessage overflowFrame;
+    
+    pollTWAIAlerts();
+    
+    // Bounded so a flooded bus cannot starve the MCP2515 drain. Frames are read
+    // into the next queue slot; a full queue is drained into overflowFrame.
+    for (uint16_t reads = 0; reads < CAN_RX_QUEUE_SIZE; reads++) {
+        CANMessage* slot = rxQueue.reserve();
+        CANMessage& message = slot != nullptr ? *slot : overflowFrame;
+        if (!readTWAIFrame(message)) {
             break;
+        }
+        messagesReceived++;
+        lastCANActivity = message.timestamp;
+        canConnected = true;
+        
+        if (slot != nullptr) {
+            rxQueue.commit();
+            framesQueued++;
         } else {
-            // Error occurred
-            canErrors++;
-            LOG_WARN("CAN debug receive error: %d", (int)result);
-            break;
+            rxQueue.countDrop();
         }
     }
     
-    if (messagesProcessed > 0) {
-        LOG_INFO("Processed %d debug messages", messagesProcessed);
-    }
+    return framesQueued;
 }
+#endif
 
-void processPendingCANMessages() {
-    if (!canInitialized || !canConnected) {
-        return;
+// Producer side: move frames from the CAN controllers into the software queue
+uint16_t serviceCANReceive() {
+    uint16_t framesQueued = 0;
+    CANControllerLock lock;
+    
+#if ENABLE_TWAI_CONTROLLER
+    framesQueued += drainTWAIReceiveQueue();
+#endif
+    
+    if (!canInitialized) {
+        return framesQueued;
     }
     
-    // Process up to 10 messages per call to avoid blocking too long
-    int processedCount = 0;
-    const int MAX_MESSAGES_PER_CALL = 10;
+#if ENABLE_CAN_RX_INTERRUPT
+    // Only talk to the MCP2515 when it has signalled pending frames. INT stays low
+    // while any receive flag is set, so the pin level also covers a missed edge.
+    if (!canRxPending && digitalRead(CAN_IRQ_PIN) != LOW) {
+        return framesQueued;
+    }
     
-    while (processedCount < MAX_MESSAGES_PER_CALL) {
-        struct can_frame frame;
-        MCP2515::ERROR result = mcp2515.readMessage(&frame);
-        
-        if (result == MCP2515::ERROR_OK) {
-            processedCount++;
-            messagesReceived++;
-            lastCANActivity = millis();
-            
-            // Create CANMessage structure
-            CANMessage message;
-            message.id = frame.can_id;
-            message.length = frame.can_dlc;
-            memcpy(message.data, frame.data, frame.can_dlc);
-            message.timestamp = millis();
-            
-            // Log if it's a target message we care about
-            if (isTargetCANMessage(message.id)) {
-                LOG_DEBUG("Target CAN message: ID=0x%03X, Len=%d", message.id, message.length);
-            }
-        } else if (result == MCP2515::ERROR_NOMSG) {
-            // No more messages available
-            break;
-        } else {
-            // Error occurred
-            canErrors++;
-            LOG_DEBUG("CAN process error: %d", (int)result);
-            break;
+    // Clear the request first so an edge arriving mid-drain re-arms the reader.
+    // Without a recorded edge (INT found low by the level check) the read time is used.
+    uint32_t firstArrivalUs = canRxPending ? canRxPendingSinceUs : (uint32_t)esp_timer_get_time();
+    canRxPending = false;
+#else
+    uint32_t firstArrivalUs = (uint32_t)esp_timer_get_time();
+#endif
+    
+    framesQueued += drainCANReceiveBuffers(firstArrivalUs);
+    return framesQueued;
+}
+
+#if ENABLE_CAN_RX_TASK
+// Receive task body: sleep until the INT line fires (or the poll interval
+// elapses as a safety net for missed edges and the interrupt-less TWAI path),
+// then drain every controller into the software queue
+static void canReceiveTask(void* parameter) {
+    (void)parameter;
+    
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CAN_RX_TASK_POLL_MS));
+        canRxTaskWakeups++;
+        if (serviceCANReceive() > 0) {
+            signalLoopEvent(LOOP_EVENT_CAN_RX);
         }
     }
 }
 
+bool startCANReceiveTask() {
+    if (canRxTaskHandle != NULL) {
+        return true;
+    }
+    
+    BaseType_t result = xTaskCreatePinnedToCore(canReceiveTask, "can_rx", CAN_RX_TASK_STACK_SIZE,
+                                                NULL, CAN_RX_TASK_PRIORITY, &canRxTaskHandle,
+                                                CAN_RX_TASK_CORE);
+    if (result != pdPASS) {
+        LOG_ERROR("Failed to create CAN receive task");
+        canRxTaskHandle = NULL;
+        return false;
+    }
+    
+    registerMemoryTask(canRxTaskHandle, "can_rx", CAN_RX_TASK_STACK_SIZE, false);
+    
+    // Pick up anything that was latched before the task existed
+    requestCANReceiveService();
+    LOG_INFO("CAN receive task started on core %d (priority %d, stack %d bytes)",
+             CAN_RX_TASK_CORE, CAN_RX_TASK_PRIORITY, CAN_RX_TASK_STACK_SIZE);
+    return true;
+}
+
+bool isCANReceiveTaskRunning() {
+    return canRxTaskHandle != NULL;
+}
+#endif
+
+// Consumer side: take the oldest queued frame
+bool receiveCANMessage(CANMessage& message) {
+    return rxQueue.pop(message);
+}
+
+const CANMessage* peekCANMessage() {
+    return rxQueue.front();
+}
+
+void releaseCANMessage() {
+    rxQueue.release();
+}
+
+uint16_t peekCANMessages(const CANMessage** frames, uint16_t maxCount) {
+    return rxQueue.front(frames, maxCount);
+}
+
+void releaseCANMessages(uint16_t count) {
+    rxQueue.release(count);
+}
+
+CANQueueStats getCANQueueStats() {
+    CANQueueStats stats;
+    stats.depth = rxQueue.size();
+    stats.capacity = rxQueue.capacity();
+    stats.highWaterMark = rxQueue.getHighWaterMark();
+    stats.drops = rxQueue.getDropCount();
+    return stats;
+}
+
 bool isCANConnected() {
+#if ENABLE_TWAI_CONTROLLER
+    if (!canInitialized && !isTWAIActive()) {
+        return false;
+    }
+#else
     if (!canInitialized) {
         return false;
     }
+#endif
     
     // For MCP2515, we consider it connected if:
     // 1. It's initialized
@@ -263,75 +712,31 @@ bool isCANConnected() {
     return canConnected;
 }
 
+// Bus error: schedule a full recovery (never blocks)
 void handleCANError() {
     LOG_ERROR("Handling CAN bus error - attempting recovery");
-    
-    if (!canInitialized) {
-        return;
-    }
-    
-    // For MCP2515, we can try to reset and reinitialize
-    mcp2515.reset();
-    delay(100);
-    
-    // Reinitialize
-    MCP2515::ERROR result = mcp2515.setBitrate(CAN_500KBPS, MCP_16MHZ);
-    if (result == MCP2515::ERROR_OK) {
-        result = mcp2515.setListenOnlyMode();
-        if (result == MCP2515::ERROR_OK) {
-            LOG_INFO("CAN bus recovery successful");
-            canConnected = true;
-            canErrors = 0; // Reset error count on successful recovery
-        } else {
-            LOG_ERROR("CAN recovery failed - setListenOnlyMode error: %d", (int)result);
-            canConnected = false;
-        }
-    } else {
-        LOG_ERROR("CAN recovery failed - setBitrate error: %d", (int)result);
-        canConnected = false;
-    }
+    startCANSystemRecovery();
 }
 
-bool recoverCANSystem() {
-    LOG_WARN("Performing full CAN system recovery...");
-    
-    // Reset MCP2515 completely
-    mcp2515.reset();
-    delay(200);
-    
-    // Reinitialize SPI
-    SPI.end();
-    delay(100);
-    SPI.begin(CAN_CLK_PIN, CAN_MISO_PIN, CAN_MOSI_PIN, CAN_CS_PIN);
-    delay(100);
-    
-    // Reinitialize MCP2515
-    MCP2515::ERROR result = mcp2515.setBitrate(CAN_500KBPS, MCP_16MHZ);
-    if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set bitrate during recovery: %d", (int)result);
-        canInitialized = false;
-        canConnected = false;
-        return false;
-    }
-    
-    result = mcp2515.setListenOnlyMode();
-    if (result != MCP2515::ERROR_OK) {
-        LOG_ERROR("Failed to set listen-only mode during recovery: %d", (int)result);
-        canInitialized = false;
-        canConnected = false;
+bool startCANSystemRecovery() {
+    unsigned long now = millis();
+    if (!requestCANRecovery(now)) {
+        CANRecoveryStats stats = getCANRecoveryStats();
+        if (stats.state != CAN_RECOVERY_IDLE) {
+            LOG_DEBUG("CAN recovery already in progress (%s)", getCANRecoveryStateName(stats.state));
+        } else {
+            LOG_DEBUG("CAN recovery backing off for another %lu ms", stats.retryAllowedAt - now);
+        }
         return false;
     }
-    
-    canInitialized = true;
-    canConnected = true;
-    lastCANActivity = millis();
-    messagesReceived = 0;
-    canErrors = 0;
-    
-    LOG_INFO("Full CAN system recovery successful");
     return true;
 }
 
+void serviceCANRecovery(unsigned long now) {
+    advanceCANRecovery(now);
+}
+
+
 // Diagnostic function to check raw CAN bus activity
 void checkRawCANActivity() {
     if (!canInitialized) {
@@ -349,24 +754,14 @@ void checkRawCANActivity() {
     LOG_INFO("  Errors: %lu", canErrors);
     LOG_INFO("  Last Activity: %lu ms ago", millis() - lastCANActivity);
     
-    // Try to read a few messages immediately
-    struct can_frame frame;
-    int immediateMessages = 0;
-    for (int i = 0; i < 5; i++) {
-        if (mcp2515.readMessage(&frame) == MCP2515::ERROR_OK) {
-            immediateMessages++;
-            LOG_INFO("  Immediate message %d: ID=0x%03X, Len=%d", i+1, frame.can_id, frame.can_dlc);
-        } else {
-            break;
-        }
-    }
-    
-    if (immediateMessages == 0) {
-        LOG_INFO("  No immediate messages available");
-    } else {
-        LOG_INFO("  Found %d immediate messages", immediateMessages);
-        lastCANActivity = millis();
-    }
+    // The receive path is the only consumer of the controller, so report
+    // what it holds instead of reading frames here
+    CANQueueStats queue = getCANQueueStats();
+    LOG_INFO("  Receive queue: %u of %u frames waiting (high water %u, %lu dropped)",
+             queue.depth, queue.capacity, queue.highWaterMark, (unsigned long)queue.drops);
+#if ENABLE_CAN_RX_TASK
+    LOG_INFO("  Receive task: %s", isCANReceiveTaskRunning() ? "running" : "stopped");
+#endif
     
     LOG_INFO("=== END CAN DIAGNOSTICS ===");
 }
@@ -377,19 +772,50 @@ void printCANStatistics() {
     LOG_INFO("  Controller: MCP2515 on X2 header");
     LOG_INFO("  Messages Received: %lu", messagesReceived);
     LOG_INFO("  Errors: %lu", canErrors);
-    LOG_INFO("  Suspected Buffer Overflows: %lu", messageLossCount);
+    LOG_INFO("  RX Buffer Overflows: %lu (RXB0: %lu, RXB1: %lu)",
+             getMessageLossCount(), errorStats.rx0Overflows, errorStats.rx1Overflows);
+    LOG_INFO("  Error Counters: TEC=%d REC=%d (peak REC %d), EFLG=0x%02X",
+             errorStats.transmitErrorCount, errorStats.receiveErrorCount,
+             errorStats.peakReceiveErrorCount, errorStats.lastErrorFlags);
+#if ENABLE_CAN_RX_INTERRUPT
+    LOG_INFO("  Receive Mode: Interrupt (IRQ pin %d, %lu interrupts)", CAN_IRQ_PIN, canInterruptCount);
+#else
+    LOG_INFO("  Receive Mode: Polling");
+#endif
+#if ENABLE_CAN_RX_TASK
+    if (canRxTaskHandle != NULL) {
+        LOG_INFO("  Receive Task: core %d, priority %d, %lu wakeups, %u bytes stack free",
+                 CAN_RX_TASK_CORE, CAN_RX_TASK_PRIORITY, canRxTaskWakeups,
+                 (unsigned)uxTaskGetStackHighWaterMark(canRxTaskHandle));
+    } else {
+        LOG_INFO("  Receive Task: not running (serviced from loop)");
+    }
+#endif
+    LOG_INFO("  Software Queue: %d/%d frames (peak %d), %lu dropped",
+             rxQueue.size(), rxQueue.capacity(), rxQueue.getHighWaterMark(), rxQueue.getDropCount());
     LOG_INFO("  Last Activity: %lu ms ago", millis() - lastCANActivity);
     LOG_INFO("  Connection Status: %s", canConnected ? "Connected" : "Disconnected");
     LOG_INFO("  Initialized: %s", canInitialized ? "Yes" : "No");
+    CANRecoveryStats recovery = getCANRecoveryStats();
+    LOG_INFO("  Recovery: %s, %lu attempts (%lu ok, %lu failed, %lu refused), %lu ms total, last %lu ms, next backoff %lu ms",
+             getCANRecoveryStateName(recovery.state), recovery.attempts, recovery.successes,
+             recovery.failures, recovery.refused, recovery.totalRecoveryMs,
+             recovery.lastRecoveryMs, recovery.backoffMs);
+#if ENABLE_TWAI_CONTROLLER
+#if MCP2515_ROLE == MCP2515_ROLE_HOT_STANDBY
+    LOG_INFO("  Standby Frames Discarded: %lu", standbyFramesDiscarded);
+#endif
+    printTWAIStatistics();
+#endif
     
     // Show buffer overflow status if any have occurred
-    if (messageLossCount > 0) {
-        LOG_WARN("WARNING: %lu suspected buffer overflows detected!", messageLossCount);
-        LOG_WARN("Detection method: Heuristic analysis of message patterns");
+    if (getMessageLossCount() > 0) {
+        LOG_WARN("WARNING: %lu MCP2515 receive buffer overflows detected!", getMessageLossCount());
+        LOG_WARN("Detection method: EFLG RX0OVR/RX1OVR flags (exact)");
         LOG_WARN("Consider reducing main loop processing time or using larger buffers");
         LOG_WARN("Use 'can_buffers' command for detailed buffer analysis");
     } else {
-        LOG_INFO("No suspected overflows - processing appears to keep up with traffic");
+        LOG_INFO("No overflows - processing keeps up with traffic");
     }
 }
 
@@ -397,97 +823,55 @@ void resetCANStatistics() {
     messagesReceived = 0;
     canErrors = 0;
     lastCANActivity = millis();
+    rxQueue.resetStatistics();
+#if ENABLE_TWAI_CONTROLLER
+#if MCP2515_ROLE == MCP2515_ROLE_HOT_STANDBY
+    standbyFramesDiscarded = 0;
+#endif
+    resetTWAIStatistics();
+#endif
     resetMessageLossCounters();
+    spiStats = {0, 0, 0, 0, 0, 0};
     LOG_INFO("CAN statistics reset");
 }
 
-// Check if a specific message ID should be processed
-bool isTargetCANMessage(uint32_t messageId) {
-    return (messageId == BCM_LAMP_STAT_FD1_ID ||
-            messageId == LOCKING_SYSTEMS_2_FD1_ID ||
-            messageId == POWERTRAIN_DATA_10_ID ||
-            messageId == BATTERY_MGMT_3_FD1_ID);
-}
-
-// Message loss detection - Check MCP2515 status for buffer overflows
+// Message loss detection - read the MCP2515 error flags immediately.
+// Normal accounting happens from the ERRIF interrupt in the receive path; this
+// is a single extra EFLG read for diagnostics and never touches the RX buffers.
 void checkMessageLoss() {
     if (!canInitialized) {
         return;
     }
     
-    unsigned long currentTime = millis();
-    
-    // Throttle overflow checks to avoid excessive SPI communication
-    if (currentTime - lastMessageLossCheck < 100) { // Check every 100ms max
-        return;
-    }
-    lastMessageLossCheck = currentTime;
-    
-    // Note: The standard autowp/autowp-mcp2515 library doesn't provide direct
-    // access to EFLG register or overflow flags. We'll implement indirect detection
-    // by monitoring for rapid consecutive ERROR_NOMSG results which may indicate
-    // buffer overflows when we expect messages.
-    
-    // Alternative approach: Monitor receive pattern anomalies
-    static uint32_t consecutiveNoMsgCount = 0;
-    static unsigned long lastMessageTime = 0;
-    static bool wasReceivingMessages = false;
-    
-    // Check if we're in a period where we should be receiving messages
-    bool expectingMessages = (millis() - lastCANActivity) < 2000; // Within 2 seconds of last activity
-    
-    if (expectingMessages && wasReceivingMessages) {
-        // Try to read a message to check current buffer state
-        struct can_frame frame;
-        MCP2515::ERROR result = mcp2515.readMessage(&frame);
-        
-        if (result == MCP2515::ERROR_NOMSG) {
-            consecutiveNoMsgCount++;
-        } else if (result == MCP2515::ERROR_OK) {
-            // Reset counter on successful read
-            consecutiveNoMsgCount = 0;
-            lastMessageTime = currentTime;
-        } else {
-            // Other error occurred
-            consecutiveNoMsgCount = 0;
-        }
-        
-        // Heuristic: If we suddenly stop receiving messages during active periods,
-        // it might indicate buffer overflow (especially if followed by burst of messages)
-        if (consecutiveNoMsgCount > 50) { // 50 * 100ms = 5 seconds of no messages during active period
-            messageLossCount++;
-            consecutiveNoMsgCount = 0; // Reset to avoid repeated counting
-            
-            // Log overflow warning (but not too frequently)
-            if (currentTime - lastOverflowWarning >= OVERFLOW_WARNING_INTERVAL) {
-                LOG_ERROR("Potential CAN buffer overflow detected! (Total suspected overflows: %lu)", messageLossCount);
-                LOG_WARN("Detected sudden message cessation during active CAN period");
-                LOG_WARN("This may indicate MCP2515 RX buffer overflow - messages may be lost");
-                LOG_WARN("Consider reducing main loop delay or increasing processing frequency");
-                lastOverflowWarning = currentTime;
-            }
-            
-            // Increment general error counter
-            canErrors++;
-        }
+    CANControllerLock lock;
+    uint8_t flags = mcp2515.getErrorFlags();
+    if (flags != 0) {
+        accountCANErrorFlags(flags);
     } else {
-        // Reset counters when not in active message period
-        consecutiveNoMsgCount = 0;
+        errorStats.lastErrorFlags = 0;
+        readCANErrorCounters();
     }
-    
-    // Track if we were receiving messages for next iteration
-    wasReceivingMessages = (currentTime - lastCANActivity) < 1000; // Within 1 second
 }
 
-// Get total message loss count
+// Get total message loss count (receive buffer overflows on either buffer)
 uint32_t getMessageLossCount() {
-    return messageLossCount;
+    return errorStats.rx0Overflows + errorStats.rx1Overflows;
+}
+
+CANErrorStats getCANErrorStats() {
+    return errorStats;
+}
+
+MCP2515SpiStats getMCP2515SpiStats() {
+    return spiStats;
 }
 
 // Reset message loss counters
 void resetMessageLossCounters() {
-    messageLossCount = 0;
-    lastMessageLossCheck = 0;
+    errorStats.rx0Overflows = 0;
+    errorStats.rx1Overflows = 0;
+    errorStats.errorInterrupts = 0;
+    errorStats.peakReceiveErrorCount = errorStats.receiveErrorCount;
     lastOverflowWarning = 0;
     LOG_INFO("Message loss counters reset");
 }
@@ -3,33 +3,73 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "can_filter_planner.h"
+#include "can_protocol.h"
+#include "mcp2515_burst.h"
 
-// CAN message structure
-struct CANMessage {
-    uint32_t id;
-    uint8_t length;
-    uint8_t data[8];
-    unsigned long timestamp;
+// Received frames are CANFrame (can_protocol.h) from the driver to the parsers
+typedef CANFrame CANMessage;
+
+// Software receive queue statistics
+struct CANQueueStats {
+    uint16_t depth;                 // Frames currently queued
+    uint16_t capacity;              // Queue capacity (frames)
+    uint16_t highWaterMark;         // Deepest fill level since last reset
+    uint32_t drops;                 // Frames dropped because the queue was full
 };
 
 // Function declarations
 bool initializeCAN();
-bool receiveCANMessage(CANMessage& message);
-void processPendingCANMessages();
+uint16_t serviceCANReceive();       // Producer: drain controller into the queue
+bool receiveCANMessage(CANMessage& message);  // Consumer: pop oldest queued frame (a copy)
+// Consumer, in place: the oldest queued frame, valid until releaseCANMessage(); nullptr when empty
+const CANMessage* peekCANMessage();
+void releaseCANMessage();
+// Consumer, in place: up to maxCount oldest frames, contiguous in *frames until releaseCANMessages()
+uint16_t peekCANMessages(const CANMessage** frames, uint16_t maxCount);
+void releaseCANMessages(uint16_t count);
+CANQueueStats getCANQueueStats();
+#if ENABLE_CAN_RX_TASK
+bool startCANReceiveTask();         // Run serviceCANReceive() from a dedicated pinned task
+bool isCANReceiveTaskRunning();
+#endif
+void notifyCANWake();               // Drain the controller after a light sleep wake
 bool isCANConnected();
-void handleCANError();
-bool recoverCANSystem();
+void handleCANError();              // Requests a recovery (non-blocking)
+bool startCANSystemRecovery();      // false while one runs or during backoff
+void serviceCANRecovery(unsigned long now);   // Advance a running recovery by one step
 
 // Utility functions for monitoring and debugging
 void printCANStatistics();
 void resetCANStatistics();
-bool isTargetCANMessage(uint32_t messageId);
+bool isTargetCANMessage(uint32_t messageId);    // ID bitmap test (can_dispatch.cpp)
+
+// MCP2515 acceptance filters, planned from the dispatcher's IDs (can_filter_planner.h).
+// Changes take effect immediately, without a controller reset.
+bool setCANFiltersOpen(bool open);  // true: accept the whole bus; false: the plan
+bool areCANFiltersOpen();
+bool getCANFilterPlan(CANFilterPlan& plan);
 void checkRawCANActivity();
-void debugReceiveAllMessages();
+
+// MCP2515 error and overflow accounting (from EFLG, TEC and REC registers)
+struct CANErrorStats {
+    uint32_t rx0Overflows;          // RX0OVR events (frame lost, RXB0 full)
+    uint32_t rx1Overflows;          // RX1OVR events (frame lost, RXB1 full)
+    uint32_t errorInterrupts;       // ERRIF interrupts serviced
+    uint8_t lastErrorFlags;         // Most recent EFLG value
+    uint8_t transmitErrorCount;     // TEC (stays 0 in listen-only mode)
+    uint8_t receiveErrorCount;      // REC
+    uint8_t peakReceiveErrorCount;  // Highest REC since last reset
+    uint8_t reserved;
+};
 
 // Message loss detection and monitoring
 void checkMessageLoss();
 uint32_t getMessageLossCount();
+CANErrorStats getCANErrorStats();
 void resetMessageLossCounters();
 
+// SPI traffic of the MCP2515 receive path, cleared with resetCANStatistics()
+MCP2515SpiStats getMCP2515SpiStats();
+
 #endif // CAN_MANAGER_H
@@ -8,11 +8,21 @@
 extern "C" {
 #endif
 
-// Pure CAN message structure (no Arduino dependencies)
+// Controller a frame was received on
+#define CAN_SOURCE_MCP2515 0    // X2 header (SPI)
+#define CAN_SOURCE_TWAI 1       // X1 header (built-in)
+
+// The one received-frame type, shared by the drivers, the receive queue, the
+// parsers and the native tests (CANMessage is the same type). The first 16
+// bytes have the layout of the MCP2515 library's struct can_frame, so the
+// driver reads a receive buffer straight into a queue slot (can_manager.cpp).
 typedef struct {
     uint32_t id;
     uint8_t length;
-    uint8_t data[8];
+    uint8_t data[8] __attribute__((aligned(8)));    // Offset 8, as can_frame::data
+    uint32_t timestamp;         // millis() when received
+    uint8_t source;             // CAN_SOURCE_* of the receiving controller
+    uint32_t arrivalUs;         // esp_timer_get_time() at the controller, for latency_tracker.h
 } CANFrame;
 
 #include "bit_utils.h"
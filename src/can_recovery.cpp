@@ -0,0 +1,116 @@
+#include "can_recovery.h"
+#include <string.h>
+
+static const CANRecoveryOps* recoveryOps = nullptr;
+static CANRecoveryStats recoveryStats;
+static unsigned long recoveryStartedAt = 0;
+static unsigned long nextStepAt = 0;
+
+// Wrap-safe "deadline has passed" for millis() timestamps
+static bool isDue(unsigned long now, unsigned long deadline) {
+    return (long)(now - deadline) >= 0;
+}
+
+static void finishCANRecovery(unsigned long now, bool success) {
+    unsigned long duration = now - recoveryStartedAt;
+    recoveryStats.lastRecoveryMs = duration;
+    recoveryStats.totalRecoveryMs += duration;
+    recoveryStats.state = CAN_RECOVERY_IDLE;
+
+    if (success) {
+        recoveryStats.successes++;
+        recoveryStats.backoffMs = CAN_RECOVERY_BACKOFF_MIN_MS;
+        recoveryStats.retryAllowedAt = now;
+    } else {
+        recoveryStats.failures++;
+        recoveryStats.retryAllowedAt = now + recoveryStats.backoffMs;
+        recoveryStats.backoffMs = recoveryStats.backoffMs * 2 > CAN_RECOVERY_BACKOFF_MAX_MS
+                                      ? CAN_RECOVERY_BACKOFF_MAX_MS
+                                      : recoveryStats.backoffMs * 2;
+    }
+}
+
+void initCANRecovery(const CANRecoveryOps* ops) {
+    recoveryOps = ops;
+    memset(&recoveryStats, 0, sizeof(recoveryStats));
+    recoveryStats.state = CAN_RECOVERY_IDLE;
+    recoveryStats.backoffMs = CAN_RECOVERY_BACKOFF_MIN_MS;
+    recoveryStartedAt = 0;
+    nextStepAt = 0;
+}
+
+bool requestCANRecovery(unsigned long now) {
+    if (!recoveryOps || recoveryStats.state != CAN_RECOVERY_IDLE ||
+        !isDue(now, recoveryStats.retryAllowedAt)) {
+        recoveryStats.refused++;
+        return false;
+    }
+
+    recoveryStats.attempts++;
+    recoveryStats.state = CAN_RECOVERY_RESET_CONTROLLER;
+    recoveryStartedAt = now;
+    nextStepAt = now;
+    return true;
+}
+
+uint8_t advanceCANRecovery(unsigned long now) {
+    if (recoveryStats.state == CAN_RECOVERY_IDLE || !isDue(now, nextStepAt)) {
+        return recoveryStats.state;
+    }
+
+    switch (recoveryStats.state) {
+        case CAN_RECOVERY_RESET_CONTROLLER:
+            recoveryOps->resetController();
+            recoveryStats.state = CAN_RECOVERY_STOP_BUS;
+            nextStepAt = now + CAN_RECOVERY_RESET_SETTLE_MS;
+            break;
+
+        case CAN_RECOVERY_STOP_BUS:
+            recoveryOps->stopBus();
+            recoveryStats.state = CAN_RECOVERY_START_BUS;
+            nextStepAt = now + CAN_RECOVERY_BUS_SETTLE_MS;
+            break;
+
+        case CAN_RECOVERY_START_BUS:
+            recoveryOps->startBus();
+            recoveryStats.state = CAN_RECOVERY_CONFIGURE;
+            nextStepAt = now + CAN_RECOVERY_BUS_SETTLE_MS;
+            break;
+
+        case CAN_RECOVERY_CONFIGURE:
+            finishCANRecovery(now, recoveryOps->configureController());
+            break;
+    }
+
+    return recoveryStats.state;
+}
+
+bool isCANRecoveryActive() {
+    return recoveryStats.state != CAN_RECOVERY_IDLE;
+}
+
+unsigned long getCANRecoveryIdleTime(unsigned long now, unsigned long maxMs) {
+    if (recoveryStats.state == CAN_RECOVERY_IDLE) {
+        return maxMs;
+    }
+    if (isDue(now, nextStepAt)) {
+        return 0;
+    }
+    unsigned long untilDue = nextStepAt - now;
+    return untilDue < maxMs ? untilDue : maxMs;
+}
+
+CANRecoveryStats getCANRecoveryStats() {
+    return recoveryStats;
+}
+
+const char* getCANRecoveryStateName(uint8_t state) {
+    switch (state) {
+        case CAN_RECOVERY_IDLE: return "IDLE";
+        case CAN_RECOVERY_RESET_CONTROLLER: return "RESET_CONTROLLER";
+        case CAN_RECOVERY_STOP_BUS: return "STOP_BUS";
+        case CAN_RECOVERY_START_BUS: return "START_BUS";
+        case CAN_RECOVERY_CONFIGURE: return "CONFIGURE";
+        default: return "UNKNOWN";
+    }
+}
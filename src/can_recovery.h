@@ -0,0 +1,59 @@
+#ifndef CAN_RECOVERY_H
+#define CAN_RECOVERY_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Non-blocking CAN controller recovery
+ *
+ * A full recovery (controller reset, SPI restart, reconfiguration) used to run
+ * as one call with ~400 ms of delay() in it. It is now a sequence of short
+ * steps separated by settle times; advanceCANRecovery() runs at most one step
+ * per call and returns immediately while a settle time is pending, so loop()
+ * keeps servicing buttons, timers and outputs throughout.
+ *
+ * After a failed attempt new requests are refused until an exponential
+ * backoff (CAN_RECOVERY_BACKOFF_MIN_MS doubling up to _MAX_MS) has elapsed;
+ * a successful attempt resets the backoff.
+ *
+ * The hardware actions are supplied by the caller (can_manager.cpp), which
+ * keeps the sequencing host-testable.
+ */
+
+enum CANRecoveryState {
+    CAN_RECOVERY_IDLE = 0,
+    CAN_RECOVERY_RESET_CONTROLLER,  // Reset the controller, then settle
+    CAN_RECOVERY_STOP_BUS,          // Release the SPI bus, then settle
+    CAN_RECOVERY_START_BUS,         // Re-acquire the SPI bus, then settle
+    CAN_RECOVERY_CONFIGURE          // Bitrate, filters, listen-only mode
+};
+
+struct CANRecoveryOps {
+    void (*resetController)();
+    void (*stopBus)();
+    void (*startBus)();
+    bool (*configureController)();  // true when the controller is usable again
+};
+
+struct CANRecoveryStats {
+    uint32_t attempts;              // Recoveries started
+    uint32_t successes;
+    uint32_t failures;
+    uint32_t refused;               // Requests rejected during backoff or while running
+    unsigned long totalRecoveryMs;  // Time spent in recoveries (start to finish)
+    unsigned long lastRecoveryMs;
+    unsigned long backoffMs;        // Wait applied after the next failure
+    unsigned long retryAllowedAt;   // millis() from which a new request is accepted
+    uint8_t state;                  // CANRecoveryState
+};
+
+void initCANRecovery(const CANRecoveryOps* ops);
+bool requestCANRecovery(unsigned long now);         // false if running or backing off
+uint8_t advanceCANRecovery(unsigned long now);      // Returns the state after this call
+bool isCANRecoveryActive();
+unsigned long getCANRecoveryIdleTime(unsigned long now, unsigned long maxMs);
+CANRecoveryStats getCANRecoveryStats();
+const char* getCANRecoveryStateName(uint8_t state);
+
+#endif // CAN_RECOVERY_H
@@ -0,0 +1,162 @@
+#ifndef CAN_RING_BUFFER_H
+#define CAN_RING_BUFFER_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * Fixed-capacity single-producer/single-consumer ring buffer
+ *
+ * Exactly one context pushes (the CAN receive path: ISR, RX task or the drain
+ * call in loop()) and exactly one context pops (the parsing loop). The head
+ * index is only written by the producer and the tail index only by the
+ * consumer, so no locks or critical sections are required. Release/acquire
+ * ordering on the indices publishes slot contents before they are consumed.
+ *
+ * Indices run freely and are masked on access, so Capacity must be a power
+ * of two. When the ring is full, push() drops the new item and counts it.
+ *
+ * reserve()/commit() and front()/release() do the same without a copy: the
+ * producer fills the next slot in place and the consumer reads the oldest one
+ * where it lies, which is how CAN frames travel from the driver to the parsers.
+ * front(items, maxCount)/release(count) hand the consumer a run of the oldest
+ * items at once; a run stops at the end of the storage, so a wrapped backlog
+ * arrives as two runs.
+ */
+template <typename T, uint16_t Capacity>
+class SPSCRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SPSCRingBuffer capacity must be a power of two");
+
+public:
+    SPSCRingBuffer() : head(0), tail(0), drops(0), highWaterMark(0) {}
+
+    // Producer side: copy an item into the ring. Returns false (and counts a drop) when full.
+    bool push(const T& item) {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        uint32_t used = currentHead - tail.load(std::memory_order_acquire);
+
+        if (used >= Capacity) {
+            drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        buffer[currentHead & MASK] = item;
+        head.store(currentHead + 1, std::memory_order_release);
+
+        if (used + 1 > highWaterMark.load(std::memory_order_relaxed)) {
+            highWaterMark.store(used + 1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Producer side, in place: the slot the next item goes into, or nullptr when
+    // full. Nothing is queued until commit(); an uncommitted slot is reused.
+    T* reserve() {
+        uint32_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - tail.load(std::memory_order_acquire) >= Capacity) {
+            return nullptr;
+        }
+        return &buffer[currentHead & MASK];
+    }
+
+    // Publish the slot returned by the last reserve()
+    void commit() {
+        uint32_t currentHead = head.load(std::memory_order_relaxed) + 1;
+        head.store(currentHead, std::memory_order_release);
+
+        uint32_t used = currentHead - tail.load(std::memory_order_acquire);
+        if (used > highWaterMark.load(std::memory_order_relaxed)) {
+            highWaterMark.store(used, std::memory_order_relaxed);
+        }
+    }
+
+    // The producer discarded an item because reserve() found the ring full
+    void countDrop() {
+        drops.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Consumer side, in place: the oldest item, valid until release(); nullptr when empty
+    const T* front() const {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &buffer[currentTail & MASK];
+    }
+
+    // Hand the slot returned by front() back to the producer
+    void release() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer side, in place: up to maxCount of the oldest items, contiguous in
+    // *items and valid until release(count). Returns how many (0 when empty).
+    uint16_t front(const T** items, uint16_t maxCount) const {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        uint32_t available = head.load(std::memory_order_acquire) - currentTail;
+        uint32_t untilEnd = Capacity - (currentTail & MASK);
+        uint32_t count = available < untilEnd ? available : untilEnd;
+        if (count > maxCount) {
+            count = maxCount;
+        }
+        *items = &buffer[currentTail & MASK];
+        return (uint16_t)count;
+    }
+
+    // Hand the first count slots of the run returned by front(items, maxCount) back
+    void release(uint16_t count) {
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer side: copy the oldest item out of the ring. Returns false when empty.
+    bool pop(T& item) {
+        uint32_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = buffer[currentTail & MASK];
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Number of items currently queued (a snapshot; either side may be moving)
+    uint16_t size() const {
+        return (uint16_t)(head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire));
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    static constexpr uint16_t capacity() {
+        return Capacity;
+    }
+
+    // Items rejected because the ring was full
+    uint32_t getDropCount() const {
+        return drops.load(std::memory_order_relaxed);
+    }
+
+    // Deepest fill level observed since the last statistics reset
+    uint16_t getHighWaterMark() const {
+        return (uint16_t)highWaterMark.load(std::memory_order_relaxed);
+    }
+
+    void resetStatistics() {
+        drops.store(0, std::memory_order_relaxed);
+        highWaterMark.store(size(), std::memory_order_relaxed);
+    }
+
+private:
+    static const uint32_t MASK = Capacity - 1;
+
+    T buffer[Capacity];
+    std::atomic<uint32_t> head;           // Written by producer only
+    std::atomic<uint32_t> tail;           // Written by consumer only
+    std::atomic<uint32_t> drops;          // Written by producer only
+    std::atomic<uint32_t> highWaterMark;  // Written by producer only (and on reset)
+};
+
+#endif // CAN_RING_BUFFER_H
@@ -0,0 +1,191 @@
+#define LOG_MODULE_ID LOG_MODULE_CAN
+#include "can_stress.h"
+
+#if ENABLE_CAN_STRESS_LOOPBACK && !defined(NATIVE_ENV)
+
+#include <Arduino.h>
+#include <string.h>
+#include <esp_timer.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "can_manager.h"
+#include "can_dispatch.h"
+#include "twai_controller.h"
+#include "state_manager.h"
+#include "gpio_controller.h"
+#include "logger.h"
+
+#if !ENABLE_TWAI_CONTROLLER
+#error "ENABLE_CAN_STRESS_LOOPBACK needs ENABLE_TWAI_CONTROLLER"
+#endif
+
+static TaskHandle_t stressTaskHandle = NULL;
+static CANStressReport stressReport = {};
+static LoadGenerator stressGenerator;
+
+// Receive-side counters at the start of the run
+static TWAIStats startTWAI;
+static CANQueueStats startQueue;
+static CANDispatchStats startDispatch;
+
+static void checkFinalState(const LoadModel& model) {
+    VehicleSignals signals = getVehicleSignals();
+    const uint8_t published[LOAD_SIGNAL_COUNT] = {
+        (uint8_t)signals.pudLampRequest, (uint8_t)signals.vehicleLockStatus,
+        (uint8_t)signals.transmissionParkStatus, (uint8_t)signals.batterySOC
+    };
+
+    stressReport.signalMismatchMask = 0;
+    for (uint8_t signal = 0; signal < LOAD_SIGNAL_COUNT; signal++) {
+        if ((model.seenMask & (1u << signal)) && published[signal] != model.values[signal]) {
+            stressReport.signalMismatchMask |= (uint8_t)(1u << signal);
+        }
+    }
+    stressReport.decisionsMatch = signals.isParked == expectLoadParked(model) &&
+                                  signals.isUnlocked == expectLoadUnlocked(model) &&
+                                  getGPIOState().bedlight == (signals.systemReady && expectLoadBedlight(model));
+}
+
+static void canStressTask(void* parameter) {
+    (void)parameter;
+    CANFrame frame;
+    LoadFrameInfo info;
+    uint64_t dueUs;
+    int64_t startUs = esp_timer_get_time();
+
+    bool pending = nextLoadFrame(stressGenerator, frame, dueUs, info);
+    while (pending) {
+        if ((uint64_t)(esp_timer_get_time() - startUs) < dueUs) {
+            vTaskDelay(1);
+            continue;
+        }
+        if (transmitTWAIFrame(frame, 0)) {
+            stressReport.framesSent++;
+            if (info.fault == LOAD_FAULT_DLC_MISMATCH) {
+                stressReport.dlcFaultsSent++;
+            }
+        } else {
+            stressReport.txRejected++;
+        }
+        pending = nextLoadFrame(stressGenerator, frame, dueUs, info);
+    }
+    stressReport.elapsedMs = (uint32_t)((esp_timer_get_time() - startUs) / 1000);
+    stressReport.generated = stressGenerator.stats;
+
+    // Final values, fault free, so the end state is known whatever was lost
+    LoadModel model;
+    resetLoadModel(model);
+    for (uint8_t signal = 0; signal < LOAD_SIGNAL_COUNT; signal++) {
+        makeLoadSignalFrame(stressGenerator, signal, frame, info);
+        if (transmitTWAIFrame(frame, 100)) {
+            applyLoadModelFrame(model, info);
+        }
+    }
+    vTaskDelay(pdMS_TO_TICKS(CAN_STRESS_SETTLE_MS));
+
+    TWAIStats twai = getTWAIStats();
+    CANQueueStats queue = getCANQueueStats();
+    CANDispatchStats dispatch = getCANDispatchStats();
+    stressReport.framesReceived = twai.framesReceived - startTWAI.framesReceived;
+    stressReport.framesFiltered = twai.framesFiltered - startTWAI.framesFiltered;
+    stressReport.rxMissed = twai.rxMissed - startTWAI.rxMissed;
+    stressReport.queueDrops = queue.drops - startQueue.drops;
+    stressReport.queueHighWater = queue.highWaterMark;
+    stressReport.framesDispatched = dispatch.framesDispatched - startDispatch.framesDispatched;
+    stressReport.parseErrors = dispatch.parseErrors - startDispatch.parseErrors;
+    checkFinalState(model);
+
+    stressReport.running = false;
+    stressReport.complete = true;
+    LOG_INFO("Stress run finished - type 'stress' for the report");
+    stressTaskHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+bool startCANStressRun(uint32_t framesPerSecond, uint32_t durationMs) {
+    if (stressTaskHandle != NULL) {
+        return false;
+    }
+    if (!isTWAIActive()) {
+        LOG_ERROR("Stress run needs the TWAI controller");
+        return false;
+    }
+
+    LoadProfile profile = defaultLoadProfile();
+    profile.seed = (uint32_t)esp_timer_get_time() | 1;
+    profile.framesPerSecond = framesPerSecond;
+    profile.durationMs = durationMs;
+    profile.burstFrames = 32;
+    profile.burstIntervalMs = 1000;
+    for (uint8_t fault = 0; fault < LOAD_FAULT_COUNT; fault++) {
+        profile.faultPerMille[fault] = CAN_STRESS_FAULT_PER_MILLE;
+    }
+    beginLoadGenerator(stressGenerator, profile);
+
+    memset(&stressReport, 0, sizeof(stressReport));
+    stressReport.running = true;
+    stressReport.requestedFramesPerSecond = framesPerSecond;
+    stressReport.durationMs = durationMs;
+    startTWAI = getTWAIStats();
+    startQueue = getCANQueueStats();
+    startDispatch = getCANDispatchStats();
+
+    BaseType_t result = xTaskCreatePinnedToCore(canStressTask, "can_stress", CAN_STRESS_TASK_STACK_SIZE,
+                                                NULL, CAN_STRESS_TASK_PRIORITY, &stressTaskHandle,
+                                                CAN_STRESS_TASK_CORE);
+    if (result != pdPASS) {
+        stressTaskHandle = NULL;
+        stressReport.running = false;
+        LOG_ERROR("Failed to create stress task");
+        return false;
+    }
+
+    LOG_WARN("Stress run: %lu frames/s for %lu ms on X1 (loopback, bench only)",
+             (unsigned long)framesPerSecond, (unsigned long)durationMs);
+    return true;
+}
+
+CANStressReport getCANStressReport() {
+    return stressReport;
+}
+
+void printCANStressReport() {
+    CANStressReport report = stressReport;
+    LOG_INFO("=== CAN STRESS (TWAI loopback) ===");
+    if (report.running) {
+        LOG_INFO("Running: %lu frames/s for %lu ms, %lu sent so far, %lu rejected",
+                 (unsigned long)report.requestedFramesPerSecond, (unsigned long)report.durationMs,
+                 (unsigned long)report.framesSent, (unsigned long)report.txRejected);
+        return;
+    }
+    if (!report.complete) {
+        LOG_INFO("No run yet - 'stress <frames/s> [seconds]' (%lu frames/s is 100%% load at 500 kbit/s)",
+                 (unsigned long)getCANBusLoadFrameRate(500000, 100));
+        return;
+    }
+
+    uint32_t elapsedMs = report.elapsedMs > 0 ? report.elapsedMs : 1;
+    LOG_INFO("Offered: %lu frames/s for %lu ms, %lu frames (%lu in bursts)",
+             (unsigned long)report.requestedFramesPerSecond, (unsigned long)report.durationMs,
+             (unsigned long)report.generated.frames, (unsigned long)report.generated.burstFrames);
+    LOG_INFO("Sent: %lu (%lu frames/s sustained), %lu rejected with the TX queue full",
+             (unsigned long)report.framesSent, (unsigned long)((uint64_t)report.framesSent * 1000 / elapsedMs),
+             (unsigned long)report.txRejected);
+    LOG_INFO("Faults: %lu DLC, %lu malformed, %lu invalid value, %lu out of order",
+             (unsigned long)report.generated.faults[LOAD_FAULT_DLC_MISMATCH],
+             (unsigned long)report.generated.faults[LOAD_FAULT_MALFORMED],
+             (unsigned long)report.generated.faults[LOAD_FAULT_INVALID_VALUE],
+             (unsigned long)report.generated.faults[LOAD_FAULT_OUT_OF_ORDER]);
+    LOG_INFO("Received: %lu (filtered %lu), driver RX missed %lu, queue drops %lu (high water %u/%d)",
+             (unsigned long)report.framesReceived, (unsigned long)report.framesFiltered,
+             (unsigned long)report.rxMissed, (unsigned long)report.queueDrops,
+             (unsigned)report.queueHighWater, CAN_RX_QUEUE_SIZE);
+    LOG_INFO("Dispatch: %lu monitored, %lu parse errors (%lu short frames sent)",
+             (unsigned long)report.framesDispatched, (unsigned long)report.parseErrors,
+             (unsigned long)report.dlcFaultsSent);
+    LOG_INFO("End state: signals %s (mismatch mask 0x%X), decisions %s",
+             report.signalMismatchMask == 0 ? "OK" : "WRONG", (unsigned)report.signalMismatchMask,
+             report.decisionsMatch ? "OK" : "WRONG");
+}
+
+#endif // ENABLE_CAN_STRESS_LOOPBACK && !NATIVE_ENV
@@ -0,0 +1,52 @@
+#ifndef CAN_STRESS_H
+#define CAN_STRESS_H
+
+#include <stdint.h>
+#include "config.h"
+#include "load_generator.h"
+
+/**
+ * On-target bus-load stress run over TWAI loopback (ENABLE_CAN_STRESS_LOOPBACK)
+ *
+ * A low-priority task paces load_generator.h traffic in real time and queues
+ * each frame on the TWAI controller with self reception. The frames come
+ * back through the production receive path (TWAI driver queue, software
+ * queue, dispatch, state, outputs) while loop() runs as usual. A frame the TX
+ * queue cannot take is counted as rejected: the bus itself is full.
+ *
+ * At the end every monitored message is sent once more, fault free, with its
+ * final value; after CAN_STRESS_SETTLE_MS the published signals and the bed
+ * light are compared with what those values mean (LoadModel). The report has
+ * the achieved frame rate and the receive-side losses over the run.
+ *
+ * Bench only: the frames are driven onto the X1 bus wires.
+ */
+
+struct CANStressReport {
+    bool running;
+    bool complete;
+    uint32_t requestedFramesPerSecond;
+    uint32_t durationMs;
+    uint32_t elapsedMs;
+    LoadGeneratorStats generated;
+    uint32_t framesSent;            // Accepted by the TWAI TX queue
+    uint32_t txRejected;            // TX queue full
+    uint32_t dlcFaultsSent;
+    uint32_t framesReceived;        // Accepted by readTWAIFrame() (monitored IDs while filtering)
+    uint32_t framesFiltered;
+    uint32_t rxMissed;              // Driver RX queue full
+    uint32_t queueDrops;            // Software queue full
+    uint16_t queueHighWater;
+    uint32_t framesDispatched;
+    uint32_t parseErrors;
+    uint8_t signalMismatchMask;     // Bit per LOAD_SIGNAL_* differing at the end
+    bool decisionsMatch;            // Parked, unlocked and bed light as expected at the end
+};
+
+#if ENABLE_CAN_STRESS_LOOPBACK
+bool startCANStressRun(uint32_t framesPerSecond, uint32_t durationMs);   // false while one runs
+CANStressReport getCANStressReport();
+void printCANStressReport();
+#endif
+
+#endif // CAN_STRESS_H
@@ -0,0 +1,98 @@
+#include "command_line.h"
+#include <string.h>
+
+void resetCommandLineReader(CommandLineReader& reader) {
+    reader.length = 0;
+    reader.overflowed = false;
+    reader.buffer[0] = '\0';
+}
+
+uint8_t feedCommandLine(CommandLineReader& reader, char c) {
+    if (c == '\n' || c == '\r') {
+        if (reader.overflowed) {
+            resetCommandLineReader(reader);
+            return COMMAND_LINE_OVERFLOW;
+        }
+
+        // Trim trailing whitespace (leading whitespace is never stored)
+        while (reader.length > 0 && reader.buffer[reader.length - 1] == ' ') {
+            reader.length--;
+        }
+        reader.buffer[reader.length] = '\0';
+        if (reader.length == 0) {
+            return COMMAND_LINE_PENDING;   // Blank line, or the \n of a \r\n pair
+        }
+
+        reader.length = 0;
+        return COMMAND_LINE_READY;
+    }
+
+    if (reader.overflowed) {
+        return COMMAND_LINE_PENDING;
+    }
+
+    if (c == '\t') {
+        c = ' ';
+    }
+    if (c == ' ' && reader.length == 0) {
+        return COMMAND_LINE_PENDING;
+    }
+    if ((unsigned char)c < ' ' || (unsigned char)c > '~') {
+        return COMMAND_LINE_PENDING;       // Drop control and non-ASCII bytes
+    }
+
+    if (reader.length >= COMMAND_LINE_MAX_LENGTH) {
+        reader.overflowed = true;
+        reader.length = 0;
+        return COMMAND_LINE_PENDING;
+    }
+
+    if (c >= 'A' && c <= 'Z') {
+        c = (char)(c - 'A' + 'a');
+    }
+    reader.buffer[reader.length++] = c;
+    reader.buffer[reader.length] = '\0';
+    return COMMAND_LINE_PENDING;
+}
+
+const char* getCommandLine(const CommandLineReader& reader) {
+    return reader.buffer;
+}
+
+size_t splitCommandLine(const char* line, const char** args) {
+    size_t nameLength = 0;
+    while (line[nameLength] != '\0' && line[nameLength] != ' ') {
+        nameLength++;
+    }
+
+    const char* rest = line + nameLength;
+    while (*rest == ' ') {
+        rest++;
+    }
+    *args = rest;
+    return nameLength;
+}
+
+const CommandEntry* findCommand(const CommandEntry* table, size_t count, const char* name, size_t nameLength) {
+    size_t low = 0;
+    size_t high = count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        const char* candidate = table[mid].name;
+        int cmp = strncmp(candidate, name, nameLength);
+        if (cmp == 0 && candidate[nameLength] != '\0') {
+            cmp = 1;                       // Candidate is longer: sorts after name
+        }
+
+        if (cmp == 0) {
+            return &table[mid];
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,66 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Allocation-free serial command handling
+ *
+ * CommandLineReader assembles a line one character at a time into a fixed
+ * buffer (no String, no heap), so the caller can feed it whatever
+ * Serial.available() reports without ever blocking for the rest of a line.
+ * Completed lines are trimmed and lower-cased. Lines longer than
+ * COMMAND_LINE_MAX_LENGTH are discarded up to the newline and reported once.
+ *
+ * Commands are looked up by binary search in a static table sorted by name
+ * (aliases are separate rows). Declaring the table constexpr lets its owner
+ * check the ordering at compile time with isCommandTableSorted().
+ */
+
+enum CommandLineResult {
+    COMMAND_LINE_PENDING = 0,       // Line not complete yet
+    COMMAND_LINE_READY,             // getCommandLine() holds a complete line
+    COMMAND_LINE_OVERFLOW           // A too-long line was discarded
+};
+
+struct CommandLineReader {
+    char buffer[COMMAND_LINE_MAX_LENGTH + 1];
+    uint8_t length;
+    bool overflowed;                // Discarding until the next newline
+};
+
+typedef void (*CommandFunction)();
+typedef void (*CommandArgsFunction)(const char* args);
+
+// Exactly one of run / runWithArgs is set
+struct CommandEntry {
+    const char* name;
+    CommandFunction run;
+    CommandArgsFunction runWithArgs;
+};
+
+void resetCommandLineReader(CommandLineReader& reader);
+uint8_t feedCommandLine(CommandLineReader& reader, char c);    // Returns CommandLineResult
+const char* getCommandLine(const CommandLineReader& reader);
+
+// Split "name args..." in place: returns the name length; *args points past the
+// separating spaces (to "" when there are none)
+size_t splitCommandLine(const char* line, const char** args);
+
+const CommandEntry* findCommand(const CommandEntry* table, size_t count, const char* name, size_t nameLength);
+
+// Compile-time ordering check for command tables
+constexpr int compareCommandNames(const char* a, const char* b) {
+    return (*a == '\0' || *a != *b) ? (int)(unsigned char)*a - (int)(unsigned char)*b
+                                    : compareCommandNames(a + 1, b + 1);
+}
+
+template <size_t N>
+constexpr bool isCommandTableSorted(const CommandEntry (&table)[N], size_t i = 1) {
+    return i >= N || (compareCommandNames(table[i - 1].name, table[i].name) < 0 &&
+                      isCommandTableSorted(table, i + 1));
+}
+
+#endif // COMMAND_LINE_H
@@ -22,12 +22,24 @@
 #define CAN_IRQ_PIN 3           // MCP2515 Interrupt pin
 #define CAN_BAUDRATE 500000     // 500kbps - standard automotive rate
 
+// Built-in ESP32 TWAI controller on X1 header (CAN1) - ESP32-CAN-X2 board
+#define TWAI_TX_PIN 7           // Unused in listen-only mode but claimed by the driver
+#define TWAI_RX_PIN 6
+
 // CAN Message IDs (from minimal.dbc and validated with Python can_embedded_logger.py)
 #define BCM_LAMP_STAT_FD1_ID 0x3C3      // 963 decimal
 #define LOCKING_SYSTEMS_2_FD1_ID 0x331  // 817 decimal
 #define POWERTRAIN_DATA_10_ID 0x176     // 374 decimal
 #define BATTERY_MGMT_3_FD1_ID 0x43C     // 1084 decimal
 
+// Expected transmit cycle of each monitored message, for the per-ID missed-frame
+// estimate ('can_ids'). From GenMsgCycleTime in ford_lincoln_base_pt.dbc; 0 where
+// the DBC gives none (event-driven or unknown) - fill in from a bus capture.
+#define BCM_LAMP_STAT_FD1_PERIOD_MS 0
+#define LOCKING_SYSTEMS_2_FD1_PERIOD_MS 0
+#define POWERTRAIN_DATA_10_PERIOD_MS 100
+#define BATTERY_MGMT_3_FD1_PERIOD_MS 0
+
 // Timing Configuration
 #define TOOLBOX_OPENER_DURATION_MS 500  // Duration to keep toolbox opener active
 #define BUTTON_DEBOUNCE_MS 50          // Button debounce time
@@ -71,30 +83,83 @@
 #define DEBUG_LEVEL DEBUG_LEVEL_DEBUG
 #endif
 
+// Log modules - each has a runtime level (serial command 'log'), capped by DEBUG_LEVEL.
+// A source file selects its module by defining LOG_MODULE_ID before its includes.
+#define LOG_MODULE_MAIN 0       // main loop, watchdog, recovery
+#define LOG_MODULE_CAN 1        // can_manager (MCP2515 receive path)
+#define LOG_MODULE_TWAI 2       // twai_controller
+#define LOG_MODULE_FRAMES 3     // raw frame dumps (logCANMessage)
+#define LOG_MODULE_PARSER 4     // message_parser, can_dispatch
+#define LOG_MODULE_STATE 5      // state_manager
+#define LOG_MODULE_GPIO 6       // gpio_controller
+#define LOG_MODULE_DIAG 7       // diagnostic_commands
+#define LOG_MODULE_COUNT 8
+
+#ifndef LOG_MODULE_ID
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#endif
+
+// Deferred Logging Configuration
+// When enabled, LOG_* calls only capture the format pointer and raw arguments
+// into a ring buffer (see deferred_log.h); a low-priority task formats and
+// writes them to Serial, so logging never blocks CAN ingest on the USB CDC port.
+// DEBUG records are dropped (and counted) when the ring is full; other levels
+// wait up to DEFERRED_LOG_FULL_WAIT_MS for room first, except from tasks above
+// APP_TASK_PRIORITY (CAN receive, esp_timer) and interrupts, which never wait.
+#define ENABLE_DEFERRED_LOGGING 1
+#define DEFERRED_LOG_QUEUE_SIZE 128    // Records (power of two), 92 bytes each on ESP32
+#define DEFERRED_LOG_FULL_WAIT_MS 5
+#define DEFERRED_LOG_FLUSH_MS 10       // Writer task poll interval
+#define LOG_TASK_CORE 0
+#define LOG_TASK_PRIORITY 1            // Below everything but idle
+#define LOG_TASK_STACK_SIZE 4096
+
 // Logging macros
+#if defined(UNIT_TESTING)
+#define LOG_ENABLED(module, level) ((level) <= DEBUG_LEVEL)
+#define LOG_EMIT(module, level, prefix, format, ...) Serial.printf(prefix format "\n", ##__VA_ARGS__)
+#else
+#include <stdint.h>
+#ifdef __cplusplus
+extern uint8_t logModuleLevels[LOG_MODULE_COUNT];   // logger.cpp
+#endif
+#define LOG_ENABLED(module, level) ((level) <= logModuleLevels[module])
+#if ENABLE_DEFERRED_LOGGING && defined(__cplusplus)
+#include "deferred_log.h"
+#define LOG_EMIT(module, level, prefix, format, ...) \
+    do { if (LOG_ENABLED(module, level)) deferredLog(level, prefix format "\n", ##__VA_ARGS__); } while (0)
+#else
+#define LOG_EMIT(module, level, prefix, format, ...) \
+    do { if (LOG_ENABLED(module, level)) Serial.printf(prefix format "\n", ##__VA_ARGS__); } while (0)
+#endif
+#endif
+
+// Native tests may already have defined these from test/common/test_config.h
+#ifndef LOG_ERROR
 #if DEBUG_LEVEL >= DEBUG_LEVEL_ERROR
-#define LOG_ERROR(format, ...) Serial.printf("[ERROR] " format "\n", ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LOG_EMIT(LOG_MODULE_ID, DEBUG_LEVEL_ERROR, "[ERROR] ", format, ##__VA_ARGS__)
 #else
 #define LOG_ERROR(format, ...)
 #endif
 
 #if DEBUG_LEVEL >= DEBUG_LEVEL_WARN
-#define LOG_WARN(format, ...) Serial.printf("[WARN] " format "\n", ##__VA_ARGS__)
+#define LOG_WARN(format, ...) LOG_EMIT(LOG_MODULE_ID, DEBUG_LEVEL_WARN, "[WARN] ", format, ##__VA_ARGS__)
 #else
 #define LOG_WARN(format, ...)
 #endif
 
 #if DEBUG_LEVEL >= DEBUG_LEVEL_INFO
-#define LOG_INFO(format, ...) Serial.printf("[INFO] " format "\n", ##__VA_ARGS__)
+#define LOG_INFO(format, ...) LOG_EMIT(LOG_MODULE_ID, DEBUG_LEVEL_INFO, "[INFO] ", format, ##__VA_ARGS__)
 #else
 #define LOG_INFO(format, ...)
 #endif
 
 #if DEBUG_LEVEL >= DEBUG_LEVEL_DEBUG
-#define LOG_DEBUG(format, ...) Serial.printf("[DEBUG] " format "\n", ##__VA_ARGS__)
+#define LOG_DEBUG(format, ...) LOG_EMIT(LOG_MODULE_ID, DEBUG_LEVEL_DEBUG, "[DEBUG] ", format, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG(format, ...)
 #endif
+#endif // LOG_ERROR
 
 // Hardware CAN Filtering Configuration
 // Enable hardware filtering on MCP2515 to only receive target messages
@@ -102,6 +167,262 @@
 // Can be disabled for debugging to receive all messages
 #define ENABLE_HARDWARE_CAN_FILTERING 1
 
+// MCP2515 Filter Planner
+// The acceptance filters are planned from the IDs registered with the dispatcher
+// (can_filter_planner.h): exact for up to six IDs, shared masks beyond that.
+// 'can_filters open' accepts the whole bus at runtime, 'can_filters apply' restores the plan.
+#define CAN_FILTER_PLAN_MAX_IDS 32          // Largest ID set the planner accepts
+#define CAN_FILTER_PLAN_EXHAUSTIVE_IDS 10   // Try every buffer split up to this many IDs
+
+// Software ID Filter
+// loop() takes queued frames in runs of up to CAN_SOFTWARE_FILTER_BATCH and tests
+// them against a 2048-bit bitmap of the dispatcher's IDs (can_id_filter.h). Frames
+// nobody decodes are still counted per ID and captured by the flight recorder, but
+// skip dispatch. Keeps an open bus (filters open, or ENABLE_HARDWARE_CAN_FILTERING 0)
+// cheap enough to run in production. Set to 0 to dispatch every frame.
+#define ENABLE_SOFTWARE_CAN_FILTER 1
+#define CAN_SOFTWARE_FILTER_BATCH 32        // Frames per bitmap test (1-32)
+
+// Interrupt-Driven CAN Receive Configuration
+// When enabled, the MCP2515 INT line (CAN_IRQ_PIN, active low) arms the receive
+// path on its falling edge. The reader then drains RXB0/RXB1 into a software
+// queue, so SPI is only touched when the controller actually holds frames.
+// Set to 0 to poll the controller on every receive service call instead.
+#define ENABLE_CAN_RX_INTERRUPT 1
+#define CAN_RX_QUEUE_SIZE 64           // Software receive queue depth (frames, power of two)
+#define CAN_MAX_FRAMES_PER_LOOP CAN_RX_QUEUE_SIZE  // Frames parsed per loop() pass
+
+// MCP2515 Burst Read Configuration
+// When enabled, the receive path talks to the MCP2515 itself instead of through
+// the library: one READ of CANINTF+EFLG per drain pass, and one READ RX BUFFER
+// burst per frame (ID, DLC and data in one chip select; the instruction clears
+// RXnIF when CS rises). 'can_buffers' reports the SPI bytes and transactions
+// per frame of both paths. The MCP2515 SPI limit is 10 MHz.
+#define ENABLE_MCP2515_BURST_READ 1
+#define CAN_SPI_CLOCK_HZ 10000000
+
+// Change-Only Processing Configuration
+// Body-control frames repeat at 10-100 Hz with identical payloads. With the
+// change filter, a frame whose signal bits (the DBC signals its handler reads)
+// match the last applied frame only refreshes the freshness timestamp; parse,
+// state update and logging are skipped. Counters/checksums outside the signal
+// mask are ignored. A full parse is still forced every CAN_UNCHANGED_REPARSE_MS.
+#define ENABLE_CAN_CHANGE_FILTER 1
+#define CAN_UNCHANGED_REPARSE_MS 1000
+
+// CAN Recovery Configuration
+// Recovery runs as a non-blocking step sequence advanced from loop() (see
+// can_recovery.h). Settle times replace the old in-line delay() calls; failed
+// attempts back off exponentially before another request is accepted.
+#define CAN_RECOVERY_RESET_SETTLE_MS 200   // After controller reset
+#define CAN_RECOVERY_BUS_SETTLE_MS 100     // After SPI end / begin
+#define CAN_RECOVERY_BACKOFF_MIN_MS 5000   // Wait after the first failed attempt
+#define CAN_RECOVERY_BACKOFF_MAX_MS 300000 // Backoff ceiling (5 minutes)
+
+// Task Configuration
+// With ENABLE_CAN_RX_TASK the receive path runs in its own FreeRTOS task pinned
+// to core 0, woken by the MCP2515 INT line, and is the queue's only producer.
+// loop() (Arduino loop task, core 1) consumes the queue and runs state, GPIO,
+// button and diagnostics logic, so slow serial output never delays bus draining.
+// Stack sizes are in bytes (ESP-IDF convention).
+#define ENABLE_CAN_RX_TASK 1
+#define CAN_RX_TASK_CORE 0
+#define CAN_RX_TASK_PRIORITY 10        // Above loop(), below the Wi-Fi/BT stacks
+#define CAN_RX_TASK_STACK_SIZE 4096
+#define CAN_RX_TASK_POLL_MS 10         // Wake-up interval when no interrupt arrives
+#define APP_TASK_PRIORITY 1            // Arduino loop task priority (core ARDUINO_RUNNING_CORE)
+#define APP_TASK_STACK_SIZE 8192       // Arduino loop task stack
+
+// Loop Scheduler Configuration
+// loop() sleeps until a CAN frame is queued, the toolbox button changes level or
+// the next periodic job is due (see loop_scheduler.h). Worst-case reaction time
+// to a CAN event is the wake-up latency (reported by 'status'); to a button
+// press it is BUTTON_DEBOUNCE_MS (see button_driver.h).
+#define LOOP_MAX_IDLE_MS 50            // Longest sleep (bounds serial command latency)
+#define BUTTON_ACTIVE_POLL_MS 5        // Poll interval while timed work is pending (button events, polled opener)
+#define BUTTON_EVENT_QUEUE_LEN 16      // Debounced button events waiting for loop()
+#define OUTPUT_RECONCILE_INTERVAL_MS 1000  // Safety-net recompute of all outputs (changes apply immediately)
+#define LOOP_SCHEDULER_MAX_JOBS 8
+#define LOOP_EVENT_LATENCY_BUDGET_US 2000  // Wake-to-output passes slower than this are counted
+
+// Frame-to-Output Latency Tracking
+// Every frame carries the esp_timer time it arrived at the controller; the
+// dispatcher and the output logic stamp it again after parse, state update and
+// GPIO commit. Per-stage log2 histograms are shown by 'latency' (latency_tracker.h).
+#define LATENCY_HISTOGRAM_BUCKETS 24   // Bucket n counts [2^(n-1), 2^n) us; the last one anything slower
+
+// Loop Profiler
+// Every loop() pass is split into sections (serial, CAN, state, button, outputs,
+// jobs, idle) timed with the CPU cycle counter; 'system_info' shows the table
+// and 'profile stream' prints a one-line summary per window (loop_profiler.h).
+#define LOOP_PROFILE_STREAM_MS 10000   // Window of the periodic summary
+#define LOOP_PROFILE_STREAM_DEFAULT 0  // Stream from boot
+
+// Per-ID CAN Statistics
+// The dispatcher records every received frame in a fixed hash table keyed by ID:
+// count, inter-arrival mean/max/jitter, last payload and missed frames against
+// the expected cycle time. 'can_ids' dumps one line per ID (can_id_stats.h).
+#define CAN_ID_STATS_SLOTS 128         // Distinct IDs tracked; power of two
+#define CAN_ID_STATS_MAX_PROBE 8       // Probe limit per lookup; IDs beyond it are counted as untracked
+
+// Flight Recorder Configuration
+// loop() keeps the last FLIGHT_RECORDER_FRAMES frames in a RAM ring (16 bytes
+// each). A watchdog trip, a denied toolbox request or 'flight trigger' keeps
+// recording for the post-trigger window, then a low-priority task writes the
+// record to LittleFS in large sequential blocks (flight_recorder.h,
+// flight_storage.h). Only the newest FLIGHT_RECORDER_MAX_FILES records are kept
+// and automatic triggers are rate-limited, which bounds flash wear.
+#define ENABLE_FLIGHT_RECORDER 1
+#define FLIGHT_RECORDER_FRAMES 1024    // Ring size (power of two): 16 KB of RAM
+#define FLIGHT_RECORDER_POST_FRAMES 256    // Frames recorded after the trigger...
+#define FLIGHT_RECORDER_POST_MS 2000       // ...or this long, whichever ends first
+#define FLIGHT_RECORDER_TRIGGER_COOLDOWN_MS 60000  // Between automatic triggers
+#define FLIGHT_RECORDER_SERVICE_MS 100     // Post-trigger window check interval
+#define FLIGHT_RECORDER_MAX_FILES 8
+#define FLIGHT_RECORDER_WRITE_BLOCK 4096   // Bytes per flash write (one flash sector)
+#define FLIGHT_RECORDER_DIR "/flight"
+#define FLIGHT_STORAGE_POLL_MS 50
+#define FLIGHT_STORAGE_TASK_CORE 0
+#define FLIGHT_STORAGE_TASK_PRIORITY 1     // Same as the log writer
+#define FLIGHT_STORAGE_TASK_STACK_SIZE 4096
+
+// Signal History Configuration
+// loop() records each change of the four DBC signals as a delta-encoded event
+// in a fixed arena of SIGNAL_HISTORY_EVENT_BYTES per signal (signal_history.h).
+// Events older than SIGNAL_HISTORY_RAW_MAX_AGE_MS, or pushed out by newer ones,
+// are folded into min/max buckets of SIGNAL_HISTORY_BUCKET_MS, and the oldest
+// buckets are dropped: RAM use is fixed however long the truck sits.
+#define ENABLE_SIGNAL_HISTORY 1
+#define SIGNAL_HISTORY_EVENT_BYTES 512         // Event arena per signal, ~2-4 bytes per change
+#define SIGNAL_HISTORY_RAW_MAX_AGE_MS 21600000UL   // Exact events for 6 h...
+#define SIGNAL_HISTORY_BUCKET_MS 900000UL      // ...then 15 min min/max buckets
+#define SIGNAL_HISTORY_BUCKETS 192             // 48 h of buckets per signal (6 bytes each)
+#define SIGNAL_HISTORY_TELEMETRY_INTERVAL_MS 60000     // One signal's history per datagram, in turn
+#define SIGNAL_HISTORY_TELEMETRY_WINDOW_MS 86400000UL  // Span of that history...
+#define SIGNAL_HISTORY_TELEMETRY_SLOTS 24              // ...downsampled into this many slots
+
+// UDP Telemetry Configuration
+// When enabled, a low-priority task joins TELEMETRY_WIFI_SSID and streams the
+// decoded signals and health counters as binary UDP datagrams (telemetry_protocol.h)
+// for tools/can_dashboard.py --telemetry. A datagram goes out every
+// TELEMETRY_INTERVAL_MS while signals change, else every TELEMETRY_HEARTBEAT_MS.
+// The task runs on the loop() core, away from the CAN receive task; the Wi-Fi
+// driver itself stays on core 0. Set the credentials with build_flags, e.g.
+// -DTELEMETRY_WIFI_SSID=\"garage\" -DTELEMETRY_WIFI_PASSWORD=\"...\"
+#define ENABLE_TELEMETRY 0
+#ifndef TELEMETRY_WIFI_SSID
+#define TELEMETRY_WIFI_SSID ""
+#endif
+#ifndef TELEMETRY_WIFI_PASSWORD
+#define TELEMETRY_WIFI_PASSWORD ""
+#endif
+#ifndef TELEMETRY_UDP_HOST
+#define TELEMETRY_UDP_HOST ""          // Receiver address; empty broadcasts on the local subnet
+#endif
+#define TELEMETRY_UDP_PORT 47150
+#define TELEMETRY_INTERVAL_MS 100      // Batching window while signals change
+#define TELEMETRY_HEARTBEAT_MS 1000    // Datagram interval when nothing changes
+#define TELEMETRY_RECONNECT_MS 10000   // Wi-Fi reconnect attempt interval
+#define TELEMETRY_MAX_CHANGES 32       // Signal changes per datagram
+#define VEHICLE_SIGNAL_CHANGE_QUEUE_SIZE 64    // Journaled changes awaiting the task (power of two)
+#define TELEMETRY_TASK_CORE 1
+#define TELEMETRY_TASK_PRIORITY 1      // Same as loop(); sends are short and rare
+#define TELEMETRY_TASK_STACK_SIZE 4096
+
+// Diagnostic Command Configuration
+// Serial input is assembled into a fixed buffer without blocking; long-running
+// diagnostics run in the background from loop() instead of stalling it.
+#define COMMAND_LINE_MAX_LENGTH 64     // Longest accepted command line (characters)
+#define CAN_DEBUG_DURATION_MS 10000    // 'can_debug' session length
+#define CAN_DEBUG_MAX_LOGGED_FRAMES 50 // Frames printed per progress interval; the rest are only counted
+#define CAN_DEBUG_PROGRESS_MS 2000     // Progress message interval during 'can_debug'
+
+// Output Channels
+// Relay and PWM outputs are rows of the channel table in gpio_controller.cpp
+// (pin, mode: level, pulse or LEDC PWM, pulse length). When the pulse timer is
+// enabled, one esp_timer one-shot ends every pulse channel on time, independent
+// of loop() load; loop() only mirrors ended pulses into the channel state.
+// Disabled (and in native tests) loop() sleeps until the earliest pulse end.
+#define OUTPUT_CHANNEL_MAX 8            // Table rows (pulse bookkeeping uses 32-bit masks)
+#define ENABLE_OUTPUT_PULSE_TIMER 1
+
+// Bed Light Fade
+// With a MOSFET or LED driver in place of the bed light relay, the bed light
+// becomes an LEDC PWM channel that ramps up and down like the truck's puddle
+// lamps: the BCM's RAMP_UP/RAMP_DOWN requests switch it, and the LEDC fade
+// engine runs the ramp with no CPU work per step. Keep 0 with the relay
+// (PWM would chatter the coil).
+#define ENABLE_BEDLIGHT_PWM_FADE 0
+#define BEDLIGHT_PWM_CHANNEL 0          // LEDC channel
+#define BEDLIGHT_PWM_FREQUENCY_HZ 1000  // Above visible flicker, low switching loss
+#define BEDLIGHT_PWM_RESOLUTION_BITS 10 // 1024 steps keep the low end of the ramp smooth
+#define BEDLIGHT_FADE_IN_MS 1000        // Ramp up on PUDLAMP_RAMP_UP/ON
+#define BEDLIGHT_FADE_OUT_MS 1500       // Ramp down on PUDLAMP_RAMP_DOWN/OFF
+
+// Dual-Controller Configuration
+// When enabled, the built-in TWAI controller (X1) becomes the primary receiver:
+// its driver RX queue holds TWAI_RX_QUEUE_LEN frames and costs no SPI traffic.
+// The MCP2515 (X2) then either feeds a second bus into the same queue, or acts
+// as a hot standby that is drained continuously but only forwarded after the
+// TWAI path has been silent for CAN_STANDBY_FAILOVER_MS.
+#define ENABLE_TWAI_CONTROLLER 0
+#define TWAI_RX_QUEUE_LEN 64           // Driver RX queue depth (frames)
+#define MCP2515_ROLE_SECOND_BUS 0
+#define MCP2515_ROLE_HOT_STANDBY 1
+#define MCP2515_ROLE MCP2515_ROLE_HOT_STANDBY
+#define CAN_STANDBY_FAILOVER_MS 1000   // TWAI silence before standby frames are used
+
+// Bus-Load Stress Loopback (bench only)
+// The 'stress' command sends load_generator.h traffic (monitored messages,
+// background IDs, bursts and injected faults) through the TWAI controller:
+// the driver runs in no-ACK mode and every frame is transmitted with self
+// reception, so it comes back through the TWAI receive path, the software
+// queue, dispatch, state and outputs. The frames are driven onto CAN1H/CAN1L:
+// never enable this on a board wired to the truck. Needs ENABLE_TWAI_CONTROLLER.
+#define ENABLE_CAN_STRESS_LOOPBACK 0
+#define CAN_STRESS_TX_QUEUE_LEN 32         // TWAI driver TX queue (frames)
+#define CAN_STRESS_FAULT_PER_MILLE 10      // Rate of each fault kind
+#define CAN_STRESS_SETTLE_MS 200           // Wait after the final frames before the state is checked
+#define CAN_STRESS_TASK_CORE 0
+#define CAN_STRESS_TASK_PRIORITY 5         // Below the receive task, above loop()
+#define CAN_STRESS_TASK_STACK_SIZE 4096
+
+// Light Sleep Configuration
+// Parked, locked and with the bus asleep, loop() puts the chip into light sleep
+// instead of idling: the CPUs stop and the relay-driver supply (SYSTEM_READY_PIN)
+// stays off. The MCP2515 INT line, a TWAI RX edge or the toolbox button wakes
+// it; so does the next loop deadline, capped at LIGHT_SLEEP_MAX_MS. The MCP2515
+// keeps the frame that woke the chip. The TWAI controller is clocked off during
+// sleep, so the frame whose edge woke it is lost and the next repeat is used.
+// USB serial drops out while asleep, taking the diagnostic console with it, so
+// sleep is opt-in.
+#define ENABLE_LIGHT_SLEEP 0
+#define LIGHT_SLEEP_BUS_QUIET_MS 60000      // No frame for this long before sleeping
+#define LIGHT_SLEEP_MIN_IDLE_MS 100         // Shorter idle periods are not worth a sleep
+#define LIGHT_SLEEP_MAX_MS 60000            // Timer wake at the latest
+
+// Boot Configuration
+// setup() brings up outputs, CAN and state before printing anything. The last
+// published vehicle signals are kept in RTC slow memory and, after a reset that
+// preserved it, restored before the first frame arrives (boot_state.h).
+#define ENABLE_BOOT_STATE_RESTORE 1
+
+// Memory Budget Configuration
+// Queues, logs, tables and history are static arrays; 'mem' lists them with their
+// peak use, the heap against its post-setup() baseline and the task stack
+// high-water marks (memory_budget.h), and setup() prints the list once. The
+// watchdog warns when the heap holds MEMORY_HEAP_BLOCK_SLACK more blocks, or
+// MEMORY_HEAP_SLACK_BYTES less free memory, than when setup() finished.
+// ENABLE_STATIC_ALLOCATION_MODE counts every C++ new after setup() per task; on
+// the CAN receive, log writer and loop tasks it is a violation that trips the
+// watchdog, and with STATIC_ALLOCATION_ABORT the firmware aborts at the caller.
+#define ENABLE_STATIC_ALLOCATION_MODE 0
+#define STATIC_ALLOCATION_ABORT 0
+#define MEMORY_HEAP_LOW_BYTES 10000         // Watchdog: free heap floor
+#define MEMORY_HEAP_BLOCK_SLACK 32          // Blocks allocated after setup() before a warning
+#define MEMORY_HEAP_SLACK_BYTES 16384       // Free heap lost after setup() before a warning
+#define MEMORY_TASK_MAX 8                   // Tasks whose stacks 'mem' reports
+
 // System Health Tracking Structure
 struct SystemHealth {
     unsigned long canErrors;
@@ -0,0 +1,42 @@
+// Generated by tools/generate_can_signals.py from experiments/message_watcher/minimal.dbc
+// DO NOT EDIT - change the DBC and rerun the generator instead
+#ifndef DBC_SIGNALS_H
+#define DBC_SIGNALS_H
+
+#include "signal_decoder.h"
+
+namespace dbc {
+
+// BCM_Lamp_Stat_FD1 (0x3C3, 8 bytes, sent by GWM)
+namespace BCM_Lamp_Stat_FD1 {
+    constexpr uint32_t ID = 0x3C3;
+    constexpr uint8_t LENGTH = 8;
+    inline constexpr CANSignalSpec Illuminated_Entry_Stat = {63, 2, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 3.0f};  // "SED"
+    inline constexpr CANSignalSpec Dr_Courtesy_Light_Stat = {49, 2, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 3.0f};  // "SED"
+    inline constexpr CANSignalSpec PudLamp_D_Rq = {11, 2, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 3.0f};  // "SED"
+}
+
+// Locking_Systems_2_FD1 (0x331, 8 bytes, sent by GWM)
+namespace Locking_Systems_2_FD1 {
+    constexpr uint32_t ID = 0x331;
+    constexpr uint8_t LENGTH = 8;
+    inline constexpr CANSignalSpec Veh_Lock_Status = {34, 2, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 3.0f};  // "SED"
+}
+
+// PowertrainData_10 (0x176, 8 bytes, sent by PCM)
+namespace PowertrainData_10 {
+    constexpr uint32_t ID = 0x176;
+    constexpr uint8_t LENGTH = 8;
+    inline constexpr CANSignalSpec TrnPrkSys_D_Actl = {31, 4, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 15.0f};  // "SED"
+}
+
+// Battery_Mgmt_3_FD1 (0x43C, 8 bytes, sent by GWM)
+namespace Battery_Mgmt_3_FD1 {
+    constexpr uint32_t ID = 0x43C;
+    constexpr uint8_t LENGTH = 8;
+    inline constexpr CANSignalSpec BSBattSOC = {22, 7, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 127.0f};  // "%"
+}
+
+} // namespace dbc
+
+#endif // DBC_SIGNALS_H
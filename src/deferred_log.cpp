@@ -0,0 +1,141 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include <Arduino.h>
+#include "config.h"
+#include "can_ring_buffer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "memory_budget.h"
+
+#if ENABLE_DEFERRED_LOGGING
+
+#define DEFERRED_LOG_LINE_BYTES 256
+
+// Records waiting for the writer task. Any task may log, so producers are
+// serialized by logProducerLock; the writer task is the only consumer.
+static SPSCRingBuffer<DeferredLogRecord, DEFERRED_LOG_QUEUE_SIZE> logQueue;
+static portMUX_TYPE logProducerLock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t logTaskHandle = NULL;
+static volatile uint32_t logRecordsDropped = 0;
+static uint32_t logDropsReported = 0;
+
+static void writeDeferredLogRecord(const DeferredLogRecord& record) {
+    char line[DEFERRED_LOG_LINE_BYTES];
+    int length = formatDeferredLogRecord(record, line, sizeof(line));
+    if (length <= 0) {
+        return;
+    }
+    if (length >= (int)sizeof(line)) {
+        length = sizeof(line) - 1;
+        line[length - 1] = '\n'; // Keep line framing when truncated
+    }
+    Serial.write((const uint8_t*)line, (size_t)length);
+}
+
+static bool tryQueueRecord(const DeferredLogRecord& record) {
+    bool queued = false;
+    portENTER_CRITICAL(&logProducerLock);
+    if (logQueue.size() < logQueue.capacity()) {
+        queued = logQueue.push(record);
+    }
+    portEXIT_CRITICAL(&logProducerLock);
+    return queued;
+}
+
+// Only tasks at loop() priority or below may wait for room. The CAN receive
+// task, esp_timer callbacks and interrupts log overflow and errors exactly when
+// the queue floods, so they drop and count like DEBUG instead of stalling.
+static bool mayWaitForLogQueue() {
+    if (xPortInIsrContext()) {
+        return false;
+    }
+    return xTaskGetCurrentTaskHandle() != logTaskHandle && uxTaskPriorityGet(NULL) <= APP_TASK_PRIORITY;
+}
+
+void pushDeferredLog(const DeferredLogRecord& record) {
+    // Until the writer exists (early setup) logging is synchronous
+    if (logTaskHandle == NULL) {
+        writeDeferredLogRecord(record);
+        return;
+    }
+
+    if (tryQueueRecord(record)) {
+        return;
+    }
+
+    // Debug output is best-effort; anything more important waits briefly for room
+    if (record.level < DEBUG_LEVEL_DEBUG && mayWaitForLogQueue()) {
+        for (uint32_t waited = 0; waited < DEFERRED_LOG_FULL_WAIT_MS; waited++) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+            if (tryQueueRecord(record)) {
+                return;
+            }
+        }
+    }
+
+    portENTER_CRITICAL(&logProducerLock);
+    logRecordsDropped++;
+    portEXIT_CRITICAL(&logProducerLock);
+}
+
+static void drainDeferredLog() {
+    DeferredLogRecord record;
+    while (logQueue.pop(record)) {
+        writeDeferredLogRecord(record);
+    }
+
+    uint32_t dropped = logRecordsDropped;
+    if (dropped != logDropsReported) {
+        Serial.printf("[WARN] Log queue full: %lu record(s) dropped\n", (unsigned long)(dropped - logDropsReported));
+        logDropsReported = dropped;
+    }
+}
+
+static void deferredLogTask(void* parameter) {
+    (void)parameter;
+
+    while (true) {
+        drainDeferredLog();
+        vTaskDelay(pdMS_TO_TICKS(DEFERRED_LOG_FLUSH_MS));
+    }
+}
+
+bool startDeferredLogTask() {
+    if (logTaskHandle != NULL) {
+        return true;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(deferredLogTask, "log_writer", LOG_TASK_STACK_SIZE,
+                                                NULL, LOG_TASK_PRIORITY, &logTaskHandle, LOG_TASK_CORE);
+    if (result != pdPASS) {
+        logTaskHandle = NULL;
+        LOG_ERROR("Failed to create log writer task - logging stays synchronous");
+        return false;
+    }
+    registerMemoryTask(logTaskHandle, "log_writer", LOG_TASK_STACK_SIZE, false);
+
+    LOG_INFO("Deferred logging started (queue=%d records, core=%d, priority=%d)",
+             DEFERRED_LOG_QUEUE_SIZE, LOG_TASK_CORE, LOG_TASK_PRIORITY);
+    return true;
+}
+
+void flushDeferredLog() {
+    if (logTaskHandle == NULL) {
+        return;
+    }
+
+    // Let the writer catch up; the caller may be about to restart the chip
+    for (uint32_t waited = 0; !logQueue.empty() && waited < 100; waited++) {
+        vTaskDelay(pdMS_TO_TICKS(DEFERRED_LOG_FLUSH_MS));
+    }
+    Serial.flush();
+}
+
+uint32_t getDeferredLogDropCount() {
+    return logRecordsDropped;
+}
+
+uint16_t getDeferredLogHighWaterMark() {
+    return logQueue.getHighWaterMark();
+}
+
+#endif // ENABLE_DEFERRED_LOGGING
@@ -0,0 +1,137 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * Deferred binary logging
+ *
+ * A LOG_* call in deferred mode does not format anything. It copies the
+ * format string pointer (which lives in flash and doubles as the message ID)
+ * and the raw argument words into a fixed-size record and pushes that record
+ * into a ring buffer. A low-priority writer task pops records, formats them
+ * with snprintf and writes them to Serial, so the caller never waits for the
+ * USB CDC port.
+ *
+ * Supported arguments are integers, enums, pointers and C strings. Strings
+ * are copied into the record (up to DEFERRED_LOG_TEXT_BYTES in total), so
+ * temporaries such as String::c_str() are safe. Other argument types are
+ * rejected at compile time.
+ */
+
+#define DEFERRED_LOG_MAX_ARGS 12     // Raw frame dumps pass ID, length and 8 data bytes
+#define DEFERRED_LOG_TEXT_BYTES 32
+
+struct DeferredLogRecord {
+    const char* format;                     // printf format (static storage)
+    uint8_t argCount;
+    uint16_t stringArgs;                    // Bit i set: args[i] is an offset into text
+    uint8_t textUsed;
+    uint8_t level;                          // DEBUG_LEVEL_* of the call
+    uintptr_t args[DEFERRED_LOG_MAX_ARGS];
+    char text[DEFERRED_LOG_TEXT_BYTES];     // Copied string arguments, NUL-terminated
+};
+
+namespace deferred_log_detail {
+
+template <typename T>
+struct ArgTraits {
+    typedef typename std::decay<T>::type Type;
+    static constexpr bool isString =
+        std::is_same<Type, const char*>::value || std::is_same<Type, char*>::value;
+    static constexpr bool isWord =
+        (std::is_integral<Type>::value || std::is_enum<Type>::value || std::is_pointer<Type>::value) &&
+        sizeof(Type) <= sizeof(uintptr_t);
+};
+
+inline void storeString(DeferredLogRecord& record, uint8_t index, const char* value) {
+    if (value == NULL) {
+        value = "(null)";
+    }
+
+    uint8_t offset = record.textUsed < DEFERRED_LOG_TEXT_BYTES ? record.textUsed : DEFERRED_LOG_TEXT_BYTES - 1;
+    size_t room = DEFERRED_LOG_TEXT_BYTES - offset - 1;
+    size_t length = strlen(value);
+    if (length > room) {
+        length = room; // Truncate; later strings share the last NUL
+    }
+
+    memcpy(record.text + offset, value, length);
+    record.text[offset + length] = '\0';
+    record.textUsed = (uint8_t)(offset + length + 1);
+    record.stringArgs |= (uint16_t)(1u << index);
+    record.args[index] = offset;
+}
+
+inline void storeArg(DeferredLogRecord& record, uint8_t index, const char* value) {
+    storeString(record, index, value);
+}
+
+inline void storeArg(DeferredLogRecord& record, uint8_t index, char* value) {
+    storeString(record, index, value);
+}
+
+template <typename T>
+inline void storeArg(DeferredLogRecord& record, uint8_t index, T value) {
+    record.args[index] = (uintptr_t)value;
+}
+
+inline void storeArgs(DeferredLogRecord&, uint8_t) {}
+
+template <typename T, typename... Rest>
+inline void storeArgs(DeferredLogRecord& record, uint8_t index, T value, Rest... rest) {
+    storeArg(record, index, value);
+    storeArgs(record, index + 1, rest...);
+}
+
+} // namespace deferred_log_detail
+
+// Capture a log call into a record without formatting it
+template <typename... Args>
+inline void captureDeferredLog(DeferredLogRecord& record, uint8_t level, const char* format, Args... args) {
+    static_assert(sizeof...(Args) <= DEFERRED_LOG_MAX_ARGS, "too many arguments for a deferred log record");
+    static_assert(((deferred_log_detail::ArgTraits<Args>::isWord ||
+                    deferred_log_detail::ArgTraits<Args>::isString) && ...),
+                  "deferred logging supports integer, enum, pointer and C string arguments only");
+
+    record.format = format;
+    record.argCount = sizeof...(Args);
+    record.stringArgs = 0;
+    record.textUsed = 0;
+    record.level = level;
+    deferred_log_detail::storeArgs(record, 0, args...);
+}
+
+// Format a captured record into out (always NUL-terminated); returns snprintf's result
+inline int formatDeferredLogRecord(const DeferredLogRecord& record, char* out, size_t size) {
+    uintptr_t a[DEFERRED_LOG_MAX_ARGS] = {0};
+    for (uint8_t i = 0; i < record.argCount && i < DEFERRED_LOG_MAX_ARGS; i++) {
+        a[i] = (record.stringArgs & (1u << i)) ? (uintptr_t)(record.text + record.args[i]) : record.args[i];
+    }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+    return snprintf(out, size, record.format, a[0], a[1], a[2], a[3], a[4], a[5],
+                    a[6], a[7], a[8], a[9], a[10], a[11]);
+#pragma GCC diagnostic pop
+}
+
+// Runtime log control (deferred_log.cpp, firmware builds)
+void pushDeferredLog(const DeferredLogRecord& record);
+bool startDeferredLogTask();
+void flushDeferredLog();                    // Emit everything queued (e.g. before shutdown)
+uint32_t getDeferredLogDropCount();
+uint16_t getDeferredLogHighWaterMark();
+
+template <typename... Args>
+inline void deferredLog(uint8_t level, const char* format, Args... args) {
+    DeferredLogRecord record;
+    captureDeferredLog(record, level, format, args...);
+    pushDeferredLog(record);
+}
+
+#endif // DEFERRED_LOG_H
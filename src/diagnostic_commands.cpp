@@ -1,44 +1,169 @@
+#define LOG_MODULE_ID LOG_MODULE_DIAG
 #include "diagnostic_commands.h"
 #include "config.h"
 #include "can_manager.h"
+#include "can_dispatch.h"
 #include "state_manager.h"
 #include "gpio_controller.h"
+#include "output_channels.h"
+#include "logger.h"
+#include "loop_scheduler.h"
+#include "can_recovery.h"
+#include "command_line.h"
+#include "latency_tracker.h"
+#include "loop_profiler.h"
+#include "can_id_stats.h"
+#include "telemetry.h"
+#include "flight_recorder.h"
+#include "flight_storage.h"
+#include "sleep_policy.h"
+#include "boot_state.h"
+#include "signal_history.h"
+#include "can_stress.h"
+#include "memory_budget.h"
+#include <stdlib.h>
+#include <string.h>
 
 // External global variables
 extern SystemHealth systemHealth;
 
-void processSerialCommands() {
-    if (!Serial.available()) {
+// Sorted by name (checked below); aliases are separate rows
+static constexpr CommandEntry commandTable[] = {
+    {"can_buffers",    cmd_can_buffers,             nullptr},
+    {"can_debug",      cmd_can_debug,               nullptr},
+    {"can_filters",    nullptr,                     cmd_can_filters},
+    {"can_ids",        nullptr,                     cmd_can_ids},
+    {"can_reset",      cmd_can_reset,               nullptr},
+    {"can_status",     cmd_can_status,              nullptr},
+    {"cb",             cmd_can_buffers,             nullptr},
+    {"cd",             cmd_can_debug,               nullptr},
+    {"cf",             nullptr,                     cmd_can_filters},
+    {"ci",             nullptr,                     cmd_can_ids},
+    {"clb",            cmd_clear_bedlight_override, nullptr},
+    {"clear_bedlight", cmd_clear_bedlight_override, nullptr},
+    {"cr",             cmd_can_reset,               nullptr},
+    {"cs",             cmd_can_status,              nullptr},
+    {"flight",         nullptr,                     cmd_flight},
+    {"h",              cmd_help,                    nullptr},
+    {"help",           cmd_help,                    nullptr},
+    {"history",        nullptr,                     cmd_history},
+    {"lat",            nullptr,                     cmd_latency},
+    {"latency",        nullptr,                     cmd_latency},
+    {"log",            nullptr,                     cmd_log},
+    {"mem",            cmd_mem,                     nullptr},
+    {"outputs",        cmd_outputs,                 nullptr},
+    {"power",          nullptr,                     cmd_power},
+    {"profile",        nullptr,                     cmd_profile},
+    {"si",             cmd_system_info,             nullptr},
+    {"status",         cmd_status,                  nullptr},
+    {"stress",         nullptr,                     cmd_stress},
+    {"system_info",    cmd_system_info,             nullptr},
+    {"t",              cmd_status,                  nullptr},
+    {"telemetry",      cmd_telemetry,               nullptr},
+};
+static_assert(isCommandTableSorted(commandTable), "commandTable must be sorted by name for binary search");
+
+static CommandLineReader commandReader = {{0}, 0, false};
+
+// Background 'can_debug' session, advanced by serviceDiagnosticJobs(). It only
+// observes the frames loop() takes from the receive queue; the controller is
+// never read here, so dispatch and the statistics see every frame as usual.
+static bool canDebugActive = false;
+static unsigned long canDebugStartTime = 0;
+static unsigned long canDebugNextProgress = 0;
+static uint32_t canDebugFrames = 0;           // Frames seen this session
+static uint32_t canDebugLogged = 0;           // ...printed in the current progress interval
+static uint32_t canDebugSuppressed = 0;       // ...counted but not printed this session
+
+static void executeCommandLine(const char* line) {
+    LOG_INFO("Received command: '%s'", line);
+    
+    const char* args;
+    size_t nameLength = splitCommandLine(line, &args);
+    const CommandEntry* entry = findCommand(commandTable, sizeof(commandTable) / sizeof(commandTable[0]),
+                                            line, nameLength);
+    if (!entry) {
+        LOG_ERROR("Unknown command: '%s'. Type 'help' for available commands.", line);
         return;
     }
     
-    String command = Serial.readStringUntil('\n');
-    command.trim();
-    command.toLowerCase();
+    if (entry->runWithArgs) {
+        entry->runWithArgs(args);
+    } else if (*args != '\0') {
+        LOG_ERROR("Command '%s' takes no arguments", entry->name);
+    } else {
+        entry->run();
+    }
+}
+
+// Consume whatever input has arrived; a partial line waits for the next call
+void processSerialCommands() {
+    while (Serial.available() > 0) {
+        int c = Serial.read();
+        if (c < 0) {
+            break;
+        }
+        
+        uint8_t result = feedCommandLine(commandReader, (char)c);
+        if (result == COMMAND_LINE_READY) {
+            executeCommandLine(getCommandLine(commandReader));
+        } else if (result == COMMAND_LINE_OVERFLOW) {
+            LOG_ERROR("Command too long (max %d characters) - ignored", COMMAND_LINE_MAX_LENGTH);
+        }
+    }
+}
+
+void serviceDiagnosticJobs(unsigned long now) {
+    if (!canDebugActive) {
+        return;
+    }
     
-    LOG_INFO("Received command: '%s'", command.c_str());
+    if (now - canDebugStartTime >= CAN_DEBUG_DURATION_MS) {
+        canDebugActive = false;
+        LOG_INFO("=== CAN DEBUG COMPLETE: %lu frames (%lu not printed) ===",
+                 (unsigned long)canDebugFrames, (unsigned long)canDebugSuppressed);
+        printCANStatistics();
+        return;
+    }
     
-    if (command == "help" || command == "h") {
-        cmd_help();
-    } else if (command == "status" || command == "t") {
-        cmd_status();
-    } else if (command == "can_status" || command == "cs") {
-        cmd_can_status();
-    } else if (command == "can_debug" || command == "cd") {
-        cmd_can_debug();
-    } else if (command == "can_reset" || command == "cr") {
-        cmd_can_reset();
-    } else if (command == "can_buffers" || command == "cb") {
-        cmd_can_buffers();
-    } else if (command == "system_info" || command == "si") {
-        cmd_system_info();
-    } else if (command == "clear_bedlight" || command == "clb") {
-        cmd_clear_bedlight_override();
-    } else if (command.length() > 0) {
-        LOG_ERROR("Unknown command: '%s'. Type 'help' for available commands.", command.c_str());
+    if ((long)(now - canDebugNextProgress) >= 0) {
+        LOG_INFO("Debug monitoring... %lu seconds elapsed, %lu frames",
+                 (now - canDebugStartTime) / 1000, (unsigned long)canDebugFrames);
+        canDebugNextProgress += CAN_DEBUG_PROGRESS_MS;
+        canDebugLogged = 0;
     }
 }
 
+bool isCANDebugActive() {
+    return canDebugActive;
+}
+
+// Called by loop() for each frame it takes from the receive queue
+void observeCANDebugFrame(const CANMessage& message) {
+    canDebugFrames++;
+    if (canDebugLogged >= CAN_DEBUG_MAX_LOGGED_FRAMES) {
+        canDebugSuppressed++;
+        return;
+    }
+    canDebugLogged++;
+    LOG_INFO("DEBUG CAN RX: ID=0x%03lX (%lu), Len=%d, Data=[%02X %02X %02X %02X %02X %02X %02X %02X]",
+             (unsigned long)message.id, (unsigned long)message.id, message.length,
+             message.data[0], message.data[1], message.data[2], message.data[3],
+             message.data[4], message.data[5], message.data[6], message.data[7]);
+}
+
+unsigned long getDiagnosticIdleTime(unsigned long now, unsigned long maxMs) {
+    if (!canDebugActive) {
+        return maxMs;
+    }
+    // Frames wake the loop on their own; only the progress lines and the end are timed
+    if ((long)(now - canDebugNextProgress) >= 0) {
+        return 0;
+    }
+    unsigned long untilProgress = canDebugNextProgress - now;
+    return untilProgress < maxMs ? untilProgress : maxMs;
+}
+
 void cmd_help() {
     LOG_INFO("=== Ford F150 Gen14 CAN Bus Interface ===");
     LOG_INFO("Project: https://github.com/jantman/ford-f150-gen14-can-bus-interface");
@@ -52,8 +177,20 @@ void cmd_help() {
     LOG_INFO("can_debug (cd)  - Debug CAN message reception");
     LOG_INFO("can_reset (cr)  - Reset CAN system");
     LOG_INFO("can_buffers (cb)- Show CAN buffer status and message loss");
-    LOG_INFO("system_info (si)- Show system information");
+    LOG_INFO("can_ids (ci) [reset] - Per-ID rate, interval jitter, missed frames, last payload");
+    LOG_INFO("can_filters (cf) [open|apply] - MCP2515 filter plan; open accepts the whole bus");
+    LOG_INFO("latency (lat) [buckets|reset] - Frame arrival to GPIO latency per stage");
+    LOG_INFO("system_info (si)- Show system information and loop profile");
+    LOG_INFO("profile [reset|stream|stop] - Loop profile; stream prints it every %d s", LOOP_PROFILE_STREAM_MS / 1000);
+    LOG_INFO("flight [trigger|list|dump <n>|erase] - Flight recorder status and LittleFS records");
+    LOG_INFO("telemetry       - Show UDP telemetry stream status");
+    LOG_INFO("outputs         - Show output channels (pin, mode, state, pulse time left)");
+    LOG_INFO("mem             - Static arenas, heap since setup() and task stack high-water marks");
+    LOG_INFO("power [reset]   - Light sleep: time asleep, wake causes, wake to first frame");
+    LOG_INFO("history [<signal> [minutes [slots]]] - Signal change history, downsampled to slots");
+    LOG_INFO("stress [<frames/s> [seconds]] - Bench TWAI loopback load test; report of the last run");
     LOG_INFO("clear_bedlight (clb) - Clear bed light manual override");
+    LOG_INFO("log [<module|all> <level>] - Show or set log levels (none/error/warn/info/debug)");
     LOG_INFO("============================");
     LOG_INFO("");
     LOG_INFO("=== BED LIGHT CONTROLS ===");
@@ -62,50 +199,174 @@ void cmd_help() {
     LOG_INFO("============================");
 }
 
+void cmd_log(const char* args) {
+    if (*args == '\0') {
+        printLogConfiguration();
+        return;
+    }
+
+    const char* levelName;
+    size_t moduleLength = splitCommandLine(args, &levelName);
+    if (*levelName == '\0') {
+        LOG_ERROR("Usage: log [<module|all> <level>]");
+        return;
+    }
+
+    char moduleName[16];
+    if (moduleLength >= sizeof(moduleName)) {
+        moduleLength = sizeof(moduleName) - 1;
+    }
+    memcpy(moduleName, args, moduleLength);
+    moduleName[moduleLength] = '\0';
+
+    int level = parseLogLevel(levelName);
+    if (level < 0) {
+        LOG_ERROR("Unknown log level '%s' (none/error/warn/info/debug or 0-4)", levelName);
+        return;
+    }
+
+    if (strcmp(moduleName, "all") == 0) {
+        setAllLogModuleLevels((uint8_t)level);
+    } else {
+        int module = findLogModule(moduleName);
+        if (module < 0) {
+            LOG_ERROR("Unknown log module '%s'", moduleName);
+            return;
+        }
+        setLogModuleLevel((uint8_t)module, (uint8_t)level);
+    }
+
+    if (level > DEBUG_LEVEL) {
+        LOG_WARN("Requested level exceeds compiled DEBUG_LEVEL (%s); capped", logLevelToString(DEBUG_LEVEL));
+    }
+    printLogConfiguration();
+}
+
 void cmd_can_status() {
     LOG_INFO("=== CAN BUS STATUS ===");
     printCANStatistics();
+    printCANDispatchStatistics();
     checkRawCANActivity();
     
     // Show current state
     VehicleState state = getCurrentState();
     LOG_INFO("=== VEHICLE STATE ===");
-    LOG_INFO("System Ready: %s", state.systemReady ? "YES" : "NO");
-    LOG_INFO("Bed Light Should Be On: %s", state.bedlightShouldBeOn ? "YES" : "NO");
-    LOG_INFO("Is Parked: %s", state.isParked ? "YES" : "NO");
-    LOG_INFO("Is Unlocked: %s", state.isUnlocked ? "YES" : "NO");
+    LOG_INFO("System Ready: %s", state.current.systemReady ? "YES" : "NO");
+    LOG_INFO("Bed Light Should Be On: %s", state.current.bedlightShouldBeOn ? "YES" : "NO");
+    LOG_INFO("Is Parked: %s", state.current.isParked ? "YES" : "NO");
+    LOG_INFO("Is Unlocked: %s", state.current.isUnlocked ? "YES" : "NO");
+    
+    uint32_t staleMask = getStaleSourceMask();
+    LOG_INFO("Stale Sources: 0x%02lX (BCM:%s, Lock:%s, PT:%s, Batt:%s)", (unsigned long)staleMask,
+             (staleMask & (1UL << VEHICLE_MSG_BCM_LAMP)) ? "STALE" : "OK",
+             (staleMask & (1UL << VEHICLE_MSG_LOCKING_SYSTEMS)) ? "STALE" : "OK",
+             (staleMask & (1UL << VEHICLE_MSG_POWERTRAIN)) ? "STALE" : "OK",
+             (staleMask & (1UL << VEHICLE_MSG_BATTERY)) ? "STALE" : "OK");
 }
 
-void cmd_can_debug() {
-    LOG_INFO("=== CAN DEBUG MODE (10 seconds) ===");
-    LOG_INFO("Monitoring ALL CAN messages for 10 seconds...");
+void cmd_latency(const char* args) {
+    if (*args == '\0') {
+        printLatencyStatistics(false);
+    } else if (strcmp(args, "buckets") == 0) {
+        printLatencyStatistics(true);
+    } else if (strcmp(args, "reset") == 0) {
+        resetLatencyStatistics();
+        LOG_INFO("Latency histograms cleared");
+    } else {
+        LOG_ERROR("Usage: latency [buckets|reset]");
+    }
+}
+
+void cmd_can_ids(const char* args) {
+    if (*args == '\0') {
+        printCANIdStatistics();
+    } else if (strcmp(args, "reset") == 0) {
+        resetCANIdStatistics();
+        LOG_INFO("Per-ID statistics cleared");
+    } else {
+        LOG_ERROR("Usage: can_ids [reset]");
+    }
+}
+
+void cmd_can_filters(const char* args) {
+    if (strcmp(args, "open") == 0 || strcmp(args, "apply") == 0) {
+        bool open = args[0] == 'o';
+        if (!setCANFiltersOpen(open)) {
+            LOG_ERROR("Filter update failed");
+            return;
+        }
+        LOG_INFO("Hardware filters %s", open ? "open (whole bus)" : "set to the plan");
+        return;
+    } else if (*args != '\0') {
+        LOG_ERROR("Usage: can_filters [open|apply]");
+        return;
+    }
     
-    unsigned long startTime = millis();
-    int totalMessages = 0;
+    CANFilterPlan plan;
+    LOG_INFO("=== CAN FILTERS (%s) ===", areCANFiltersOpen() ? "open" : "planned");
+    if (!getCANFilterPlan(plan)) {
+        LOG_ERROR("No filter plan for the monitored IDs");
+        return;
+    }
+    printCANFilterPlan(plan);
     
-    while (millis() - startTime < 10000) { // 10 seconds
-        debugReceiveAllMessages();
-        delay(100); // Small delay between checks
-        
-        // Update total count
-        // This is a simple way to show we're still running
-        if ((millis() - startTime) % 2000 == 0) {
-            LOG_INFO("Debug monitoring... %lu seconds elapsed", (millis() - startTime) / 1000);
+    // Traffic the plan would pass, from the per-ID table; complete only if it
+    // was collected with the filters open
+    uint32_t seenFrames = 0;
+    uint32_t passedFrames = 0;
+    uint16_t seenIds = 0;
+    uint16_t passedIds = 0;
+    CANIdStats stats;
+    for (uint16_t slot = 0; slot < getCANIdStatsCapacity(); slot++) {
+        if (!getCANIdStatsAt(slot, stats)) {
+            continue;
         }
+        seenIds++;
+        seenFrames += stats.count;
+        if (canFilterPlanAdmits(plan, stats.id)) {
+            passedIds++;
+            passedFrames += stats.count;
+        }
+    }
+    if (seenFrames == 0) {
+        LOG_INFO("  No traffic observed yet ('can_filters open' + 'can_ids reset' to survey the bus)");
+        return;
+    }
+    LOG_INFO("  Observed: %u of %u IDs, %lu of %lu frames (%lu%%) would pass the plan",
+             passedIds, seenIds, (unsigned long)passedFrames, (unsigned long)seenFrames,
+             (unsigned long)(((uint64_t)passedFrames * 100) / seenFrames));
+}
+
+// Runs in the background from serviceDiagnosticJobs(); loop() keeps going
+void cmd_can_debug() {
+    if (canDebugActive) {
+        LOG_WARN("CAN debug already running (%lu ms left)",
+                 CAN_DEBUG_DURATION_MS - (millis() - canDebugStartTime));
+        return;
     }
     
-    LOG_INFO("=== CAN DEBUG COMPLETE ===");
-    printCANStatistics();
+    LOG_INFO("=== CAN DEBUG MODE (%d seconds) ===", CAN_DEBUG_DURATION_MS / 1000);
+    LOG_INFO("Monitoring ALL CAN messages for %d seconds...", CAN_DEBUG_DURATION_MS / 1000);
+    
+    canDebugStartTime = millis();
+    canDebugFrames = 0;
+    canDebugLogged = 0;
+    canDebugSuppressed = 0;
+    canDebugNextProgress = canDebugStartTime + CAN_DEBUG_PROGRESS_MS;
+    canDebugActive = true;
 }
 
 void cmd_can_reset() {
     LOG_INFO("=== RESETTING CAN SYSTEM ===");
-    if (recoverCANSystem()) {
-        LOG_INFO("CAN system reset successful");
+    // Runs in steps from loop(); 'can_status' shows the outcome
+    if (startCANSystemRecovery()) {
+        LOG_INFO("CAN system reset started");
     } else {
-        LOG_ERROR("CAN system reset failed");
+        CANRecoveryStats recovery = getCANRecoveryStats();
+        LOG_WARN("CAN system reset not started (%s, retry allowed in %lu ms)",
+                 getCANRecoveryStateName(recovery.state),
+                 (long)(recovery.retryAllowedAt - millis()) > 0 ? recovery.retryAllowedAt - millis() : 0UL);
     }
-    printCANStatistics();
 }
 
 void cmd_can_buffers() {
@@ -114,40 +375,71 @@ void cmd_can_buffers() {
     LOG_INFO("RX Buffer Count: 2 (RXB0, RXB1)");
     LOG_INFO("Buffer Size: 1 message per buffer");
     LOG_INFO("Total Hardware Capacity: 2 messages");
-    LOG_INFO("Overflow Detection: Heuristic-based (pattern analysis)");
+    LOG_INFO("Overflow Detection: EFLG RX0OVR/RX1OVR flags (exact, per buffer)");
     
+    // Software receive queue between the CAN receive path and the parsing loop
+    CANQueueStats queueStats = getCANQueueStats();
+    LOG_INFO("=== SOFTWARE RX QUEUE ===");
+    LOG_INFO("Queue Capacity: %d messages", queueStats.capacity);
+    LOG_INFO("Currently Queued: %d messages", queueStats.depth);
+    LOG_INFO("High-Water Mark: %d messages", queueStats.highWaterMark);
+    LOG_INFO("Dropped (queue full): %lu", queueStats.drops);
+    if (queueStats.drops > 0) {
+        LOG_WARN("WARNING: %lu frames dropped because the software queue was full!", queueStats.drops);
+    }
+    
+    // Refresh EFLG/TEC/REC before reporting (one register read, no frames consumed)
+    checkMessageLoss();
+    
+    CANErrorStats errorStats = getCANErrorStats();
     uint32_t lossCount = getMessageLossCount();
-    LOG_INFO("Suspected Buffer Overflows: %lu", lossCount);
+    LOG_INFO("=== HARDWARE OVERFLOWS ===");
+    LOG_INFO("RX Buffer Overflows: %lu (RXB0: %lu, RXB1: %lu)",
+             lossCount, errorStats.rx0Overflows, errorStats.rx1Overflows);
+    LOG_INFO("Error Interrupts Serviced: %lu", errorStats.errorInterrupts);
+    LOG_INFO("Error Counters: TEC=%d REC=%d (peak REC %d)",
+             errorStats.transmitErrorCount, errorStats.receiveErrorCount, errorStats.peakReceiveErrorCount);
+    LOG_INFO("EFLG: 0x%02X", errorStats.lastErrorFlags);
     
     if (lossCount > 0) {
-        LOG_WARN("WARNING: Potential buffer overflows detected!");
-        LOG_WARN("Detection method: Monitoring for sudden message cessation during active periods");
-        LOG_WARN("This indicates the system may not be processing messages fast enough");
+        LOG_WARN("WARNING: MCP2515 receive buffer overflows detected - frames were lost!");
+        LOG_WARN("This indicates the receive path is not draining the controller fast enough");
         LOG_WARN("Recommendations:");
-        LOG_WARN("  1. Reduce main loop delay (currently 10ms)");
-        LOG_WARN("  2. Increase MAX_MESSAGES_PER_LOOP (currently 10)");
+        LOG_WARN("  1. Check 'profile' for long loop() passes holding off the drain");
+        LOG_WARN("  2. Increase CAN_RX_QUEUE_SIZE (currently %d)", CAN_RX_QUEUE_SIZE);
         LOG_WARN("  3. Consider using ESP32 TWAI instead of MCP2515 for larger buffers");
         LOG_WARN("  4. Filter messages to reduce processing load");
         LOG_WARN("  5. Monitor 'can_debug' output for message burst patterns");
     } else {
-        LOG_INFO("No suspected buffer overflows - system appears to be keeping up");
+        LOG_INFO("No buffer overflows - system is keeping up");
     }
     
     // Show current processing limits
     LOG_INFO("=== PROCESSING LIMITS ===");
-    LOG_INFO("MAX_MESSAGES_PER_LOOP: 10");
-    LOG_INFO("Main loop delay: 10ms");
-    LOG_INFO("Overflow check interval: 100ms");
-    LOG_INFO("Detection threshold: 5 seconds of silence during active periods");
+    LOG_INFO("CAN_MAX_FRAMES_PER_LOOP: %d", CAN_MAX_FRAMES_PER_LOOP);
+    LOG_INFO("Receive path: %s", ENABLE_CAN_RX_TASK ? "dedicated task" : "loop() on INT");
     
-    // Force an immediate overflow check
-    LOG_INFO("Performing immediate buffer status check...");
-    checkMessageLoss();
+    // SPI cost of draining the controller, against the library's readMessage() path
+    MCP2515SpiStats spi = getMCP2515SpiStats();
+    LOG_INFO("=== MCP2515 SPI ===");
+    LOG_INFO("Read path: %s at %lu Hz", ENABLE_MCP2515_BURST_READ ? "READ RX BUFFER burst" : "library readMessage()",
+             (unsigned long)CAN_SPI_CLOCK_HZ);
+    LOG_INFO("Frames: %lu in %lu drain passes", (unsigned long)spi.frames, (unsigned long)spi.drainPasses);
+    if (spi.frames > 0) {
+        // Hundredths per frame
+        unsigned long bytes = (unsigned long)((uint64_t)spi.bytes * 100 / spi.frames);
+        unsigned long transactions = (unsigned long)((uint64_t)spi.transactions * 100 / spi.frames);
+        unsigned long libraryBytes = (unsigned long)((uint64_t)spi.libraryBytes * 100 / spi.frames);
+        unsigned long libraryTransactions = (unsigned long)((uint64_t)spi.libraryTransactions * 100 / spi.frames);
+        LOG_INFO("Per frame: %lu.%02lu bytes, %lu.%02lu transactions (library: %lu.%02lu bytes, %lu.%02lu transactions)",
+                 bytes / 100, bytes % 100, transactions / 100, transactions % 100,
+                 libraryBytes / 100, libraryBytes % 100, libraryTransactions / 100, libraryTransactions % 100);
+    }
     
     LOG_INFO("=== BUFFER MONITORING NOTES ===");
     LOG_INFO("The MCP2515 has very limited (2-message) hardware buffers");
     LOG_INFO("Unlike software queues, these cannot be increased");
-    LOG_INFO("Monitor for patterns: busy periods followed by silence, then bursts");
+    LOG_INFO("Overflows are counted from the controller's own flags, not inferred");
     LOG_INFO("Use 'can_debug' to observe actual message timing and patterns");
     
     LOG_INFO("=== END BUFFER STATUS ===");
@@ -162,6 +454,7 @@ void cmd_system_info() {
     LOG_INFO("Free Heap: %d bytes", ESP.getFreeHeap());
     LOG_INFO("SDK Version: %s", ESP.getSdkVersion());
     LOG_INFO("Uptime: %lu ms", millis());
+    printBootStatus();
     
     // GPIO status
     GPIOState gpioState = getGPIOState();
@@ -170,6 +463,26 @@ void cmd_system_info() {
     LOG_INFO("System Ready: %s", gpioState.systemReady ? "ON" : "OFF");
     LOG_INFO("Toolbox Opener: %s", gpioState.toolboxOpener ? "ACTIVE" : "INACTIVE");
     LOG_INFO("Button State: %s", gpioState.toolboxButton ? "PRESSED" : "RELEASED");
+    
+    // Where loop() spends its time, and whether CAN bursts are keeping up
+    printLoopProfile();
+}
+
+void cmd_profile(const char* args) {
+    if (*args == '\0') {
+        printLoopProfile();
+    } else if (strcmp(args, "reset") == 0) {
+        resetLoopProfile();
+        LOG_INFO("Loop profile cleared");
+    } else if (strcmp(args, "stream") == 0) {
+        setLoopProfileStreaming(true);
+        LOG_INFO("Loop profile summary every %d ms ('profile stop' ends it)", LOOP_PROFILE_STREAM_MS);
+    } else if (strcmp(args, "stop") == 0) {
+        setLoopProfileStreaming(false);
+        LOG_INFO("Loop profile stream stopped");
+    } else {
+        LOG_ERROR("Usage: profile [reset|stream|stop]");
+    }
 }
 
 void cmd_status() {
@@ -183,23 +496,23 @@ void cmd_status() {
     
     // Vehicle State Flags
     LOG_INFO("Vehicle State: Ready=%s Parked=%s Unlocked=%s BedLight=%s", 
-             vehicleState.systemReady ? "Y" : "N",
-             vehicleState.isParked ? "Y" : "N", 
-             vehicleState.isUnlocked ? "Y" : "N",
-             vehicleState.bedlightShouldBeOn ? "Y" : "N");
+             vehicleState.current.systemReady ? "Y" : "N",
+             vehicleState.current.isParked ? "Y" : "N", 
+             vehicleState.current.isUnlocked ? "Y" : "N",
+             vehicleState.current.bedlightShouldBeOn ? "Y" : "N");
     
     // Bed Light Override Status
     if (isBedlightManuallyOverridden()) {
         LOG_INFO("Bed Light Override: ACTIVE (Manual: %s)", 
-                 vehicleState.bedlightManualState ? "ON" : "OFF");
+                 vehicleState.current.bedlightManualState ? "ON" : "OFF");
     } else {
         LOG_INFO("Bed Light Override: DISABLED (Automatic Mode)");
     }
     
     // Vehicle State Raw Values
     LOG_INFO("Raw Values: PUD=%d Lock=%d Park=%d SOC=%d%%", 
-             vehicleState.pudLampRequest, vehicleState.vehicleLockStatus,
-             vehicleState.transmissionParkStatus, vehicleState.batterySOC);
+             vehicleState.current.pudLampRequest, vehicleState.current.vehicleLockStatus,
+             vehicleState.current.transmissionParkStatus, vehicleState.current.batterySOC);
     
     // GPIO States
     LOG_INFO("GPIO Outputs: Bed=%s SysReady=%s Toolbox=%s Button=%s",
@@ -219,6 +532,123 @@ void cmd_status() {
              isCANConnected() ? "OK" : "FAIL",
              systemHealth.canErrors, systemHealth.parseErrors, systemHealth.criticalErrors,
              systemHealth.recoveryMode ? "Y" : "N");
+    
+    // Event-to-output latency and periodic job timing
+    printLoopSchedulerStatistics();
+}
+
+void cmd_flight(const char* args) {
+#if ENABLE_FLIGHT_RECORDER
+    bool queued = true;
+    if (*args == '\0') {
+        printFlightRecorderStatus();
+    } else if (strcmp(args, "trigger") == 0) {
+        if (triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, millis())) {
+            LOG_INFO("Flight recorder triggered; the record is stored after the post-trigger window");
+        } else {
+            LOG_WARN("Flight recorder trigger refused - storage unavailable or previous record still being stored");
+        }
+    } else if (strcmp(args, "list") == 0) {
+        queued = requestFlightRecordList();
+    } else if (strncmp(args, "dump ", 5) == 0 && args[5] >= '0' && args[5] <= '9') {
+        queued = requestFlightRecordDump(strtoul(args + 5, NULL, 10));
+    } else if (strcmp(args, "erase") == 0) {
+        queued = requestFlightRecordErase();
+    } else {
+        LOG_ERROR("Usage: flight [trigger|list|dump <n>|erase]");
+    }
+    if (!queued) {
+        LOG_WARN("Flight record storage unavailable or busy");
+    }
+#else
+    (void)args;
+    LOG_INFO("Flight recorder not built in (set ENABLE_FLIGHT_RECORDER to 1 in config.h)");
+#endif
+}
+
+void cmd_mem() {
+    LOG_INFO("=== MEMORY BUDGET ===");
+    printMemoryBudget(true);
+}
+
+void cmd_outputs() {
+    printOutputChannelStatus();
+}
+
+void cmd_power(const char* args) {
+    if (*args == '\0') {
+        printSleepStats();
+    } else if (strcmp(args, "reset") == 0) {
+        resetSleepStats();
+        LOG_INFO("Light sleep statistics cleared");
+    } else {
+        LOG_ERROR("Usage: power [reset]");
+    }
+}
+
+void cmd_history(const char* args) {
+#if ENABLE_SIGNAL_HISTORY
+    uint32_t now = millis();
+    if (*args == '\0') {
+        printSignalHistoryStatus(now);
+        return;
+    }
+
+    const char* rest;
+    size_t nameLength = splitCommandLine(args, &rest);
+    char name[24];
+    if (nameLength >= sizeof(name)) {
+        nameLength = sizeof(name) - 1;
+    }
+    memcpy(name, args, nameLength);
+    name[nameLength] = '\0';
+
+    int signal = findSignalHistorySignal(name);
+    char* end = nullptr;
+    unsigned long minutes = *rest ? strtoul(rest, &end, 10) : 60;
+    unsigned long slots = (end != nullptr && *end == ' ') ? strtoul(end, &end, 10) : 12;
+    if (signal < 0 || minutes == 0 || minutes > 7 * 24 * 60 || slots == 0 || (end != nullptr && *end != '\0')) {
+        LOG_ERROR("Usage: history [<signal> [minutes [slots]]], signal one of %s %s %s %s",
+                  getSignalHistoryName(0), getSignalHistoryName(1), getSignalHistoryName(2), getSignalHistoryName(3));
+        return;
+    }
+    printSignalHistory((uint8_t)signal, now, (uint32_t)(minutes * 60000UL), (uint16_t)slots);
+#else
+    (void)args;
+    LOG_INFO("Signal history not built in (set ENABLE_SIGNAL_HISTORY to 1 in config.h)");
+#endif
+}
+
+void cmd_stress(const char* args) {
+#if ENABLE_CAN_STRESS_LOOPBACK
+    if (*args == '\0') {
+        printCANStressReport();
+        return;
+    }
+
+    char* end = nullptr;
+    unsigned long rate = strtoul(args, &end, 10);
+    unsigned long seconds = (end != nullptr && *end == ' ') ? strtoul(end, &end, 10) : 10;
+    if (rate == 0 || rate > 10000 || seconds == 0 || seconds > 600 || *end != '\0') {
+        LOG_ERROR("Usage: stress [<frames/s> [seconds]] (%lu frames/s is 100%% load at 500 kbit/s)",
+                  (unsigned long)getCANBusLoadFrameRate(500000, 100));
+        return;
+    }
+    if (!startCANStressRun((uint32_t)rate, (uint32_t)(seconds * 1000UL))) {
+        LOG_ERROR("Stress run not started (one is running or TWAI is down)");
+    }
+#else
+    (void)args;
+    LOG_INFO("Stress loopback not built in (set ENABLE_CAN_STRESS_LOOPBACK to 1 in config.h; bench only)");
+#endif
+}
+
+void cmd_telemetry() {
+#if ENABLE_TELEMETRY
+    printTelemetryStatus();
+#else
+    LOG_INFO("Telemetry not built in (set ENABLE_TELEMETRY to 1 in config.h)");
+#endif
 }
 
 void cmd_clear_bedlight_override() {
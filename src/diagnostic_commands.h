@@ -2,18 +2,39 @@
 #define DIAGNOSTIC_COMMANDS_H
 
 #include <Arduino.h>
+#include "can_manager.h"
 
-// Function to process serial diagnostic commands
+// Function to process serial diagnostic commands (non-blocking, no heap)
 void processSerialCommands();
 
+// Background diagnostics (e.g. can_debug); call every loop() pass
+void serviceDiagnosticJobs(unsigned long now);
+unsigned long getDiagnosticIdleTime(unsigned long now, unsigned long maxMs);
+
+// 'can_debug' prints the frames loop() dequeues; it never reads the controller
+bool isCANDebugActive();
+void observeCANDebugFrame(const CANMessage& message);
+
 // Individual diagnostic functions
 void cmd_can_status();
+void cmd_latency(const char* args);
+void cmd_can_ids(const char* args);
+void cmd_can_filters(const char* args);
 void cmd_can_debug();
 void cmd_can_reset();
 void cmd_can_buffers();
 void cmd_system_info();
+void cmd_profile(const char* args);
 void cmd_status();
 void cmd_help();
+void cmd_flight(const char* args);
+void cmd_telemetry();
+void cmd_outputs();
+void cmd_mem();
+void cmd_power(const char* args);
+void cmd_history(const char* args);
+void cmd_stress(const char* args);
 void cmd_clear_bedlight_override();
+void cmd_log(const char* args);
 
 #endif // DIAGNOSTIC_COMMANDS_H
@@ -0,0 +1,181 @@
+#define LOG_MODULE_ID LOG_MODULE_CAN
+#include "flight_recorder.h"
+#include <atomic>
+#include <string.h>
+#include "logger.h"
+
+static_assert((FLIGHT_RECORDER_FRAMES & (FLIGHT_RECORDER_FRAMES - 1)) == 0,
+              "FLIGHT_RECORDER_FRAMES must be a power of two");
+static_assert(FLIGHT_RECORDER_POST_FRAMES < FLIGHT_RECORDER_FRAMES, "Post-trigger window exceeds the ring");
+
+#define FLIGHT_RING_MASK (FLIGHT_RECORDER_FRAMES - 1)
+
+static FlightFrame ring[FLIGHT_RECORDER_FRAMES];
+static uint32_t ringHead = 0;           // Next slot to write
+static uint32_t ringCount = 0;          // Valid frames, at most FLIGHT_RECORDER_FRAMES
+static std::atomic<uint8_t> recorderState(FLIGHT_RECORDER_RECORDING);
+
+// Pending record, fixed when the trigger fires
+static FlightRecordHeader header;
+static uint32_t postFrames = 0;
+static uint32_t missedSinceRecord = 0;
+static bool anyAutomaticTrigger = false;
+static unsigned long lastAutomaticTriggerMs = 0;
+static FlightRecorderStats stats;
+static bool storageAvailable = false;  // Only the storage task releases a frozen ring
+
+static void freezeRecord() {
+    header.frameCount = ringCount;
+    header.triggerFrame = ringCount - postFrames;
+    header.framesMissed = missedSinceRecord;
+    missedSinceRecord = 0;
+    recorderState.store(FLIGHT_RECORDER_FROZEN, std::memory_order_release);
+}
+
+void resetFlightRecorder() {
+    ringHead = 0;
+    ringCount = 0;
+    postFrames = 0;
+    missedSinceRecord = 0;
+    anyAutomaticTrigger = false;
+    lastAutomaticTriggerMs = 0;
+    memset(&header, 0, sizeof(header));
+    memset(&stats, 0, sizeof(stats));
+    storageAvailable = false;
+    recorderState.store(FLIGHT_RECORDER_RECORDING, std::memory_order_release);
+}
+
+void setFlightRecordStorageAvailable(bool available) {
+    storageAvailable = available;
+}
+
+void recordFlightFrame(const CANMessage& message) {
+    uint8_t state = recorderState.load(std::memory_order_acquire);
+    if (state == FLIGHT_RECORDER_FROZEN) {
+        stats.framesMissed++;
+        missedSinceRecord++;
+        return;
+    }
+
+    FlightFrame& frame = ring[ringHead];
+    frame.arrivalUs = message.arrivalUs;
+    frame.id = (uint16_t)message.id;
+    frame.length = message.length <= 8 ? message.length : 8;
+    frame.source = message.source;
+    memcpy(frame.data, message.data, sizeof(frame.data));
+    ringHead = (ringHead + 1) & FLIGHT_RING_MASK;
+    if (ringCount < FLIGHT_RECORDER_FRAMES) {
+        ringCount++;
+    }
+    stats.framesRecorded++;
+
+    if (state == FLIGHT_RECORDER_POST_TRIGGER && ++postFrames >= FLIGHT_RECORDER_POST_FRAMES) {
+        freezeRecord();
+    }
+}
+
+bool triggerFlightRecorder(uint8_t trigger, unsigned long now) {
+    if (trigger >= FLIGHT_TRIGGER_COUNT) {
+        return false;
+    }
+    bool automatic = trigger != FLIGHT_TRIGGER_MANUAL;
+    bool coolingDown = automatic && anyAutomaticTrigger &&
+                       now - lastAutomaticTriggerMs < FLIGHT_RECORDER_TRIGGER_COOLDOWN_MS;
+    // Without the storage task nothing would ever release a frozen ring, so never freeze one
+    if (!storageAvailable || recorderState.load(std::memory_order_acquire) != FLIGHT_RECORDER_RECORDING ||
+        coolingDown) {
+        stats.triggersIgnored++;
+        LOG_DEBUG("Flight recorder: %s trigger ignored (%s)", getFlightTriggerName(trigger),
+                  !storageAvailable ? "no storage" : coolingDown ? "cooldown" : "busy");
+        return false;
+    }
+
+    if (automatic) {
+        anyAutomaticTrigger = true;
+        lastAutomaticTriggerMs = now;
+    }
+    stats.triggers[trigger]++;
+    memcpy(header.magic, FLIGHT_RECORD_MAGIC, sizeof(header.magic));
+    header.version = FLIGHT_RECORD_VERSION;
+    header.frameSize = sizeof(FlightFrame);
+    header.trigger = trigger;
+    header.triggerMs = (uint32_t)now;
+    postFrames = 0;
+    recorderState.store(FLIGHT_RECORDER_POST_TRIGGER, std::memory_order_release);
+    LOG_INFO("Flight recorder: %s trigger, %lu frames before it", getFlightTriggerName(trigger),
+             (unsigned long)ringCount);
+    return true;
+}
+
+void serviceFlightRecorder(unsigned long now) {
+    // The bus may be silent after the trigger (watchdog trips often are), so time ends the window too
+    if (recorderState.load(std::memory_order_acquire) == FLIGHT_RECORDER_POST_TRIGGER &&
+        now - header.triggerMs >= FLIGHT_RECORDER_POST_MS) {
+        freezeRecord();
+    }
+}
+
+bool isFlightRecordFrozen() {
+    return recorderState.load(std::memory_order_acquire) == FLIGHT_RECORDER_FROZEN;
+}
+
+uint32_t getFlightRecordSize() {
+    return sizeof(FlightRecordHeader) + header.frameCount * sizeof(FlightFrame);
+}
+
+uint32_t copyFlightRecordBytes(uint32_t offset, uint8_t* out, uint32_t length) {
+    uint32_t size = getFlightRecordSize();
+    if (offset >= size) {
+        return 0;
+    }
+    if (length > size - offset) {
+        length = size - offset;
+    }
+
+    uint32_t copied = 0;
+    if (offset < sizeof(header)) {
+        uint32_t part = sizeof(header) - offset;
+        part = part < length ? part : length;
+        memcpy(out, (const uint8_t*)&header + offset, part);
+        copied = part;
+    }
+
+    // Frames oldest first; the oldest sits at ringHead once the ring has wrapped
+    uint32_t oldest = (ringHead - header.frameCount) & FLIGHT_RING_MASK;
+    while (copied < length) {
+        uint32_t frameOffset = offset + copied - sizeof(header);
+        uint32_t index = (oldest + frameOffset / sizeof(FlightFrame)) & FLIGHT_RING_MASK;
+        uint32_t within = frameOffset % sizeof(FlightFrame);
+        uint32_t part = sizeof(FlightFrame) - within;
+        part = part < length - copied ? part : length - copied;
+        memcpy(out + copied, (const uint8_t*)&ring[index] + within, part);
+        copied += part;
+    }
+    return copied;
+}
+
+void finishFlightRecord(bool stored) {
+    if (stored) {
+        stats.recordsStored++;
+    } else {
+        stats.storeFailures++;
+    }
+    ringHead = 0;
+    ringCount = 0;
+    recorderState.store(FLIGHT_RECORDER_RECORDING, std::memory_order_release);
+}
+
+FlightRecorderStats getFlightRecorderStats() {
+    FlightRecorderStats snapshot = stats;
+    snapshot.state = recorderState.load(std::memory_order_acquire);
+    return snapshot;
+}
+
+const char* getFlightTriggerName(uint8_t trigger) {
+    switch (trigger) {
+        case FLIGHT_TRIGGER_MANUAL: return "manual";
+        case FLIGHT_TRIGGER_WATCHDOG: return "watchdog";
+        case FLIGHT_TRIGGER_TOOLBOX_DENIED: return "toolbox_denied";
+        default: return "unknown";
+    }
+}
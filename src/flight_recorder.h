@@ -0,0 +1,95 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <stdint.h>
+#include "config.h"
+#include "can_manager.h"
+
+/**
+ * CAN flight recorder
+ *
+ * loop() copies every frame it consumes into a fixed RAM ring of
+ * FLIGHT_RECORDER_FRAMES entries, so the ring always holds the most recent
+ * traffic. A trigger (watchdog trip, denied toolbox request, manual command)
+ * keeps recording for FLIGHT_RECORDER_POST_FRAMES frames or
+ * FLIGHT_RECORDER_POST_MS, whichever comes first, then freezes the ring:
+ * the record is the pre-trigger history plus the post-trigger window.
+ *
+ * A frozen record is handed to the storage task (flight_storage.cpp), which
+ * streams it out with copyFlightRecordBytes() in large blocks and calls
+ * finishFlightRecord(). Until then the ring is owned by the writer and new
+ * frames are only counted as missed; loop() never waits for flash. Triggers
+ * are refused until the storage task has called
+ * setFlightRecordStorageAvailable(true), so a failed LittleFS mount leaves
+ * the ring rolling instead of frozen for the rest of the run.
+ *
+ * Automatic triggers are rate-limited by FLIGHT_RECORDER_TRIGGER_COOLDOWN_MS
+ * to bound flash wear; manual triggers are not. The recording side runs on
+ * the loop() task only; the ring handover is an acquire/release state word.
+ *
+ * Record layout (little-endian): FlightRecordHeader, then recordCount
+ * FlightFrame entries, oldest first.
+ */
+
+#define FLIGHT_TRIGGER_MANUAL 0
+#define FLIGHT_TRIGGER_WATCHDOG 1
+#define FLIGHT_TRIGGER_TOOLBOX_DENIED 2
+#define FLIGHT_TRIGGER_COUNT 3
+
+enum FlightRecorderState {
+    FLIGHT_RECORDER_RECORDING = 0,  // Ring rolling, no trigger pending
+    FLIGHT_RECORDER_POST_TRIGGER,   // Triggered, collecting the post-trigger window
+    FLIGHT_RECORDER_FROZEN          // Record complete, owned by the storage task
+};
+
+#define FLIGHT_RECORD_MAGIC "F150FLT"   // 7 characters + NUL
+#define FLIGHT_RECORD_VERSION 1
+
+struct FlightFrame {
+    uint32_t arrivalUs;             // CANMessage::arrivalUs
+    uint16_t id;
+    uint8_t length;
+    uint8_t source;                 // CAN_SOURCE_*
+    uint8_t data[8];
+};
+
+struct FlightRecordHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t frameSize;             // sizeof(FlightFrame)
+    uint32_t trigger;               // FLIGHT_TRIGGER_*
+    uint32_t triggerMs;             // millis() of the trigger
+    uint32_t frameCount;
+    uint32_t triggerFrame;          // Index of the first frame after the trigger
+    uint32_t framesMissed;          // Frames not recorded while the previous record was being stored
+};
+
+static_assert(sizeof(FlightFrame) == 16, "FlightFrame layout is part of the record format");
+static_assert(sizeof(FlightRecordHeader) == 32, "FlightRecordHeader layout is part of the record format");
+
+struct FlightRecorderStats {
+    uint32_t framesRecorded;
+    uint32_t framesMissed;          // Arrived while a record was frozen
+    uint32_t triggers[FLIGHT_TRIGGER_COUNT];
+    uint32_t triggersIgnored;       // No storage, busy or within the cooldown
+    uint32_t recordsStored;
+    uint32_t storeFailures;
+    uint8_t state;                  // FlightRecorderState
+};
+
+void resetFlightRecorder();        // Also marks storage unavailable
+void setFlightRecordStorageAvailable(bool available);
+void recordFlightFrame(const CANMessage& message);
+bool triggerFlightRecorder(uint8_t trigger, unsigned long now);   // false when ignored
+void serviceFlightRecorder(unsigned long now);                     // Ends the post-trigger window on time
+
+// Storage side: valid only while the recorder is FLIGHT_RECORDER_FROZEN
+bool isFlightRecordFrozen();
+uint32_t getFlightRecordSize();     // Header + frames, bytes
+uint32_t copyFlightRecordBytes(uint32_t offset, uint8_t* out, uint32_t length);
+void finishFlightRecord(bool stored);   // Releases the ring and restarts recording
+
+FlightRecorderStats getFlightRecorderStats();
+const char* getFlightTriggerName(uint8_t trigger);
+
+#endif // FLIGHT_RECORDER_H
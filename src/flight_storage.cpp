@@ -0,0 +1,293 @@
+#define LOG_MODULE_ID LOG_MODULE_CAN
+#include <Arduino.h>
+#include "config.h"
+#include "flight_storage.h"
+
+#if ENABLE_FLIGHT_RECORDER
+
+#include <LittleFS.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "flight_recorder.h"
+#include "memory_budget.h"
+#include "logger.h"
+
+#define FLIGHT_REQUEST_NONE 0
+#define FLIGHT_REQUEST_LIST 1
+#define FLIGHT_REQUEST_DUMP 2
+#define FLIGHT_REQUEST_ERASE 3
+
+#define FLIGHT_RECORD_PATH_BYTES 32
+#define FLIGHT_DUMP_LINES_PER_YIELD 16
+
+static TaskHandle_t storageTaskHandle = NULL;
+static volatile uint8_t pendingRequest = FLIGHT_REQUEST_NONE;
+static volatile uint32_t requestNumber = 0;
+
+// Stored records are numbered; the directory holds oldestRecord..newestRecord (with gaps after failures)
+static uint32_t oldestRecord = 0;
+static uint32_t newestRecord = 0;
+static uint8_t storedRecords = 0;
+static uint32_t nextRecord = 1;         // Never reused, even after "flight erase"
+
+static uint8_t block[FLIGHT_RECORDER_WRITE_BLOCK];
+
+static void recordPath(uint32_t number, char* path) {
+    snprintf(path, FLIGHT_RECORD_PATH_BYTES, "%s/%08lu.rec", FLIGHT_RECORDER_DIR, (unsigned long)number);
+}
+
+// Rebuild oldest/newest/count from the directory (at most FLIGHT_RECORDER_MAX_FILES entries)
+static void scanFlightRecords() {
+    oldestRecord = 0;
+    newestRecord = 0;
+    storedRecords = 0;
+
+    File dir = LittleFS.open(FLIGHT_RECORDER_DIR);
+    if (!dir || !dir.isDirectory()) {
+        return;
+    }
+    for (File file = dir.openNextFile(); file; file = dir.openNextFile()) {
+        const char* name = strrchr(file.name(), '/');
+        name = name ? name + 1 : file.name();
+        char* end;
+        unsigned long number = strtoul(name, &end, 10);
+        if (file.isDirectory() || end == name || strcmp(end, ".rec") != 0) {
+            continue;
+        }
+        if (storedRecords == 0 || number < oldestRecord) {
+            oldestRecord = number;
+        }
+        if (storedRecords == 0 || number > newestRecord) {
+            newestRecord = number;
+        }
+        storedRecords++;
+    }
+    if (storedRecords > 0 && newestRecord >= nextRecord) {
+        nextRecord = newestRecord + 1;
+    }
+}
+
+static void removeOldestRecord() {
+    char path[FLIGHT_RECORD_PATH_BYTES];
+    recordPath(oldestRecord, path);
+    LittleFS.remove(path);
+    scanFlightRecords();
+}
+
+static bool writeFrozenRecord(uint32_t number, uint32_t size) {
+    char path[FLIGHT_RECORD_PATH_BYTES];
+    recordPath(number, path);
+    File file = LittleFS.open(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    // Few large sequential writes; yield between them so flash work never hogs the core
+    bool ok = true;
+    for (uint32_t offset = 0; ok && offset < size; offset += FLIGHT_RECORDER_WRITE_BLOCK) {
+        uint32_t length = copyFlightRecordBytes(offset, block, FLIGHT_RECORDER_WRITE_BLOCK);
+        ok = file.write(block, length) == length;
+        vTaskDelay(1);
+    }
+    file.close();
+    if (!ok) {
+        LittleFS.remove(path);
+    }
+    return ok;
+}
+
+static void storeFrozenRecord() {
+    uint32_t size = getFlightRecordSize();
+
+    // Bounded footprint: drop the oldest records first
+    while (storedRecords > 0 && (storedRecords >= FLIGHT_RECORDER_MAX_FILES ||
+                                 LittleFS.totalBytes() - LittleFS.usedBytes() < size + FLIGHT_RECORDER_WRITE_BLOCK)) {
+        removeOldestRecord();
+    }
+
+    FlightRecordHeader header;
+    copyFlightRecordBytes(0, (uint8_t*)&header, sizeof(header));
+    uint32_t number = nextRecord++;
+    bool stored = writeFrozenRecord(number, size);
+    finishFlightRecord(stored);
+
+    if (!stored) {
+        LOG_ERROR("Flight recorder: failed to write record %lu (%lu bytes)", (unsigned long)number,
+                  (unsigned long)size);
+        return;
+    }
+    if (storedRecords == 0) {
+        oldestRecord = number;
+    }
+    newestRecord = number;
+    storedRecords++;
+    LOG_INFO("Flight record %lu stored: %s trigger, %lu frames (%lu after it), %lu bytes",
+             (unsigned long)number, getFlightTriggerName(header.trigger), (unsigned long)header.frameCount,
+             (unsigned long)(header.frameCount - header.triggerFrame), (unsigned long)size);
+}
+
+static bool readRecordHeader(File& file, FlightRecordHeader& header) {
+    return file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+           memcmp(header.magic, FLIGHT_RECORD_MAGIC, sizeof(header.magic)) == 0 &&
+           header.frameSize == sizeof(FlightFrame);
+}
+
+static void listFlightRecords() {
+    LOG_INFO("=== FLIGHT RECORDS (%d stored, newest %d kept) ===", storedRecords, FLIGHT_RECORDER_MAX_FILES);
+    char path[FLIGHT_RECORD_PATH_BYTES];
+    for (uint32_t number = oldestRecord; storedRecords > 0 && number <= newestRecord; number++) {
+        recordPath(number, path);
+        File file = LittleFS.open(path, "r");
+        FlightRecordHeader header;
+        if (!file) {
+            continue;
+        }
+        if (readRecordHeader(file, header)) {
+            LOG_INFO("  #%lu %s at %lu ms: %lu frames (%lu before, %lu after), %lu missed",
+                     (unsigned long)number, getFlightTriggerName(header.trigger), (unsigned long)header.triggerMs,
+                     (unsigned long)header.frameCount, (unsigned long)header.triggerFrame,
+                     (unsigned long)(header.frameCount - header.triggerFrame), (unsigned long)header.framesMissed);
+        } else {
+            LOG_WARN("  #%lu unreadable", (unsigned long)number);
+        }
+        file.close();
+    }
+    LOG_INFO("Filesystem: %lu of %lu bytes used", (unsigned long)LittleFS.usedBytes(),
+             (unsigned long)LittleFS.totalBytes());
+}
+
+static void dumpFlightRecord(uint32_t number) {
+    char path[FLIGHT_RECORD_PATH_BYTES];
+    recordPath(number, path);
+    File file = LittleFS.open(path, "r");
+    FlightRecordHeader header;
+    if (!file || !readRecordHeader(file, header)) {
+        LOG_ERROR("Flight record %lu not found ('flight list' shows the stored ones)", (unsigned long)number);
+        return;
+    }
+
+    LOG_INFO("=== FLIGHT RECORD %lu: %s trigger, frame %lu is the first after it ===",
+             (unsigned long)number, getFlightTriggerName(header.trigger), (unsigned long)header.triggerFrame);
+    uint32_t firstUs = 0;
+    for (uint32_t index = 0; index < header.frameCount; index++) {
+        FlightFrame frame;
+        if (file.read((uint8_t*)&frame, sizeof(frame)) != sizeof(frame)) {
+            LOG_WARN("Flight record %lu truncated at frame %lu", (unsigned long)number, (unsigned long)index);
+            break;
+        }
+        if (index == 0) {
+            firstUs = frame.arrivalUs;
+        }
+        char hex[17];
+        for (uint8_t i = 0; i < frame.length && i < 8; i++) {
+            snprintf(&hex[i * 2], 3, "%02X", frame.data[i]);
+        }
+        hex[frame.length * 2] = '\0';
+        uint32_t relativeUs = frame.arrivalUs - firstUs;
+        LOG_INFO("(%lu.%06lu) can0 %03X#%s", (unsigned long)(relativeUs / 1000000),
+                 (unsigned long)(relativeUs % 1000000), frame.id, hex);
+        if (index % FLIGHT_DUMP_LINES_PER_YIELD == FLIGHT_DUMP_LINES_PER_YIELD - 1) {
+            vTaskDelay(1);   // Let the log writer drain instead of dropping lines
+        }
+    }
+    file.close();
+    LOG_INFO("=== END FLIGHT RECORD %lu ===", (unsigned long)number);
+}
+
+static void eraseFlightRecords() {
+    while (storedRecords > 0) {
+        removeOldestRecord();
+    }
+    LOG_INFO("Flight records erased");
+}
+
+static void flightStorageTask(void* parameter) {
+    (void)parameter;
+
+    while (true) {
+        if (isFlightRecordFrozen()) {
+            storeFrozenRecord();
+        }
+
+        uint8_t request = pendingRequest;
+        if (request == FLIGHT_REQUEST_LIST) {
+            listFlightRecords();
+        } else if (request == FLIGHT_REQUEST_DUMP) {
+            dumpFlightRecord(requestNumber);
+        } else if (request == FLIGHT_REQUEST_ERASE) {
+            eraseFlightRecords();
+        }
+        pendingRequest = FLIGHT_REQUEST_NONE;
+
+        vTaskDelay(pdMS_TO_TICKS(FLIGHT_STORAGE_POLL_MS));
+    }
+}
+
+bool startFlightStorageTask() {
+    if (storageTaskHandle != NULL) {
+        return true;
+    }
+    if (!LittleFS.begin(true)) {
+        LOG_ERROR("Flight recorder: LittleFS mount failed - flight recording disabled");
+        return false;
+    }
+    if (!LittleFS.exists(FLIGHT_RECORDER_DIR)) {
+        LittleFS.mkdir(FLIGHT_RECORDER_DIR);
+    }
+    scanFlightRecords();
+
+    BaseType_t result = xTaskCreatePinnedToCore(flightStorageTask, "flight_store", FLIGHT_STORAGE_TASK_STACK_SIZE,
+                                                NULL, FLIGHT_STORAGE_TASK_PRIORITY, &storageTaskHandle,
+                                                FLIGHT_STORAGE_TASK_CORE);
+    if (result != pdPASS) {
+        storageTaskHandle = NULL;
+        LOG_ERROR("Failed to create flight recorder storage task");
+        return false;
+    }
+    setFlightRecordStorageAvailable(true);
+    // LittleFS allocates file handles and caches per record
+    registerMemoryTask(storageTaskHandle, "flight_store", FLIGHT_STORAGE_TASK_STACK_SIZE, true);
+
+    LOG_INFO("Flight recorder ready (%d frame ring, %d records stored, core=%d)",
+             FLIGHT_RECORDER_FRAMES, storedRecords, FLIGHT_STORAGE_TASK_CORE);
+    return true;
+}
+
+static bool queueRequest(uint8_t request, uint32_t number) {
+    if (storageTaskHandle == NULL || pendingRequest != FLIGHT_REQUEST_NONE) {
+        return false;
+    }
+    requestNumber = number;
+    pendingRequest = request;
+    return true;
+}
+
+bool requestFlightRecordList() {
+    return queueRequest(FLIGHT_REQUEST_LIST, 0);
+}
+
+bool requestFlightRecordDump(uint32_t number) {
+    return queueRequest(FLIGHT_REQUEST_DUMP, number);
+}
+
+bool requestFlightRecordErase() {
+    return queueRequest(FLIGHT_REQUEST_ERASE, 0);
+}
+
+void printFlightRecorderStatus() {
+    static const char* const stateNames[] = {"RECORDING", "POST_TRIGGER", "FROZEN"};
+    FlightRecorderStats stats = getFlightRecorderStats();
+    LOG_INFO("=== FLIGHT RECORDER ===");
+    LOG_INFO("State: %s, storage %s, %d records stored", stats.state < 3 ? stateNames[stats.state] : "?",
+             storageTaskHandle != NULL ? "ready" : "unavailable", storedRecords);
+    LOG_INFO("Frames: %lu recorded, %lu missed while storing", (unsigned long)stats.framesRecorded,
+             (unsigned long)stats.framesMissed);
+    LOG_INFO("Triggers: manual %lu, watchdog %lu, toolbox_denied %lu, ignored %lu (busy/cooldown)",
+             (unsigned long)stats.triggers[FLIGHT_TRIGGER_MANUAL], (unsigned long)stats.triggers[FLIGHT_TRIGGER_WATCHDOG],
+             (unsigned long)stats.triggers[FLIGHT_TRIGGER_TOOLBOX_DENIED], (unsigned long)stats.triggersIgnored);
+    LOG_INFO("Records: %lu stored, %lu failed", (unsigned long)stats.recordsStored, (unsigned long)stats.storeFailures);
+}
+
+#endif // ENABLE_FLIGHT_RECORDER
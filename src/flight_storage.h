@@ -0,0 +1,29 @@
+#ifndef FLIGHT_STORAGE_H
+#define FLIGHT_STORAGE_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Flight record storage on LittleFS (ENABLE_FLIGHT_RECORDER)
+ *
+ * A low-priority task owns the filesystem. It stores each frozen flight
+ * record (flight_recorder.h) as FLIGHT_RECORDER_DIR/<number>.rec, written
+ * sequentially in FLIGHT_RECORDER_WRITE_BLOCK chunks with a yield between
+ * chunks, and keeps the newest FLIGHT_RECORDER_MAX_FILES records: the oldest
+ * file is deleted before a new one is written, so flash use is bounded and
+ * LittleFS spreads the rewrites. Listing, dumping and erasing also run on
+ * the task; the serial commands only queue a request.
+ *
+ * 'flight dump <n>' prints the frames as candump -l lines (time relative to
+ * the first frame), which tools/can_capture_convert.py turns into a .f150cap
+ * capture for the trace replay engine.
+ */
+
+bool startFlightStorageTask();          // Mounts LittleFS (formatting it if needed) and starts the task
+bool requestFlightRecordList();
+bool requestFlightRecordDump(uint32_t number);
+bool requestFlightRecordErase();
+void printFlightRecorderStatus();
+
+#endif // FLIGHT_STORAGE_H
@@ -0,0 +1,111 @@
+#include "freshness_tracker.h"
+#include <string.h>
+
+// Wrap-safe "deadline has passed" for millis() timestamps
+static bool isDeadlineReached(unsigned long now, unsigned long deadline) {
+    return (long)(now - deadline) >= 0;
+}
+
+// Recompute both masks and the earliest future deadline from scratch
+static void rescanFreshness(FreshnessTracker& tracker, unsigned long now) {
+    uint32_t staleMask = 0;
+    uint32_t readyMask = 0;
+    bool deadlinePending = false;
+    unsigned long nextDeadline = 0;
+
+    for (uint8_t i = 0; i < tracker.sourceCount; i++) {
+        unsigned long staleAt = tracker.lastUpdate[i] + tracker.staleTimeoutMs;
+        unsigned long unreadyAt = tracker.lastUpdate[i] + tracker.readyTimeoutMs;
+        unsigned long pending = 0;
+        bool hasPending = false;
+
+        if (isDeadlineReached(now, staleAt)) {
+            staleMask |= 1UL << i;
+        } else {
+            pending = staleAt;
+            hasPending = true;
+        }
+
+        if (!isDeadlineReached(now, unreadyAt)) {
+            readyMask |= 1UL << i;
+            if (!hasPending || (long)(unreadyAt - pending) < 0) {
+                pending = unreadyAt;
+                hasPending = true;
+            }
+        }
+
+        if (hasPending && (!deadlinePending || (long)(pending - nextDeadline) < 0)) {
+            nextDeadline = pending;
+            deadlinePending = true;
+        }
+    }
+
+    if (staleMask != tracker.staleMask || readyMask != tracker.readyMask) {
+        tracker.changed = true;
+    }
+    tracker.staleMask = staleMask;
+    tracker.readyMask = readyMask;
+    tracker.nextDeadline = nextDeadline;
+    tracker.deadlinePending = deadlinePending;
+    tracker.rescans++;
+}
+
+void initFreshnessTracker(FreshnessTracker& tracker, uint8_t sourceCount,
+                          unsigned long staleTimeoutMs, unsigned long readyTimeoutMs,
+                          unsigned long now) {
+    memset(&tracker, 0, sizeof(tracker));
+    tracker.sourceCount = sourceCount > FRESHNESS_MAX_SOURCES ? FRESHNESS_MAX_SOURCES : sourceCount;
+    tracker.staleTimeoutMs = staleTimeoutMs;
+    tracker.readyTimeoutMs = readyTimeoutMs;
+
+    for (uint8_t i = 0; i < tracker.sourceCount; i++) {
+        tracker.lastUpdate[i] = now;
+    }
+    rescanFreshness(tracker, now);
+    tracker.changed = false;
+    tracker.rescans = 0;
+}
+
+void noteFreshnessUpdate(FreshnessTracker& tracker, uint8_t source, unsigned long now) {
+    if (source >= tracker.sourceCount) {
+        return;
+    }
+
+    uint32_t bit = 1UL << source;
+    tracker.lastUpdate[source] = now;
+
+    if ((tracker.staleMask & bit) || !(tracker.readyMask & bit)) {
+        tracker.staleMask &= ~bit;
+        tracker.readyMask |= bit;
+        tracker.changed = true;
+    }
+
+    // This source's new deadline is later than any it had, so only arm the
+    // cached deadline if nothing was pending
+    if (!tracker.deadlinePending) {
+        tracker.nextDeadline = now + (tracker.staleTimeoutMs < tracker.readyTimeoutMs
+                                          ? tracker.staleTimeoutMs : tracker.readyTimeoutMs);
+        tracker.deadlinePending = true;
+    }
+}
+
+bool updateFreshness(FreshnessTracker& tracker, unsigned long now) {
+    if (tracker.deadlinePending && isDeadlineReached(now, tracker.nextDeadline)) {
+        rescanFreshness(tracker, now);
+    }
+
+    bool changed = tracker.changed;
+    tracker.changed = false;
+    return changed;
+}
+
+unsigned long getFreshnessIdleTime(const FreshnessTracker& tracker, unsigned long now, unsigned long maxMs) {
+    if (!tracker.deadlinePending) {
+        return maxMs;
+    }
+    if (isDeadlineReached(now, tracker.nextDeadline)) {
+        return 0;
+    }
+    unsigned long untilDue = tracker.nextDeadline - now;
+    return untilDue < maxMs ? untilDue : maxMs;
+}
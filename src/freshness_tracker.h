@@ -0,0 +1,49 @@
+#ifndef FRESHNESS_TRACKER_H
+#define FRESHNESS_TRACKER_H
+
+#include <stdint.h>
+
+/**
+ * Deadline-based freshness tracking for monitored message sources
+ *
+ * Each source (one per monitored CAN message) has two timeouts measured from
+ * its last update: a short staleness timeout and a long readiness timeout.
+ * Instead of comparing every source against both timeouts on every pass, the
+ * tracker keeps the earliest pending deadline; updateFreshness() is O(1)
+ * until that deadline passes, and only then rescans the sources.
+ *
+ * Updates only ever move a source's deadlines later, so the cached deadline
+ * may be early (costing one harmless rescan) but never late.
+ */
+
+#define FRESHNESS_MAX_SOURCES 32
+
+struct FreshnessTracker {
+    unsigned long lastUpdate[FRESHNESS_MAX_SOURCES];
+    unsigned long staleTimeoutMs;       // Source is stale after this long without data
+    unsigned long readyTimeoutMs;       // Source stops counting toward readiness after this long
+    unsigned long nextDeadline;         // Earliest time a mask can change without new data
+    uint32_t staleMask;                 // Bit i: source i is stale
+    uint32_t readyMask;                 // Bit i: source i is within the readiness timeout
+    uint8_t sourceCount;
+    bool deadlinePending;               // nextDeadline is valid
+    bool changed;                       // Masks changed since the last updateFreshness()
+    uint32_t rescans;                   // Deadline-triggered scans (diagnostics)
+};
+
+// All sources start as updated at `now` (fresh and ready)
+void initFreshnessTracker(FreshnessTracker& tracker, uint8_t sourceCount,
+                          unsigned long staleTimeoutMs, unsigned long readyTimeoutMs,
+                          unsigned long now);
+
+// New data for a source; O(1)
+void noteFreshnessUpdate(FreshnessTracker& tracker, uint8_t source, unsigned long now);
+
+// Apply any deadline that has passed. Returns true if staleMask or readyMask
+// changed since the previous call (including changes from noteFreshnessUpdate).
+bool updateFreshness(FreshnessTracker& tracker, unsigned long now);
+
+// Milliseconds until the next deadline (0 if due); maxMs when none is pending
+unsigned long getFreshnessIdleTime(const FreshnessTracker& tracker, unsigned long now, unsigned long maxMs);
+
+#endif // FRESHNESS_TRACKER_H
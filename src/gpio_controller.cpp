@@ -1,19 +1,26 @@
+#define LOG_MODULE_ID LOG_MODULE_GPIO
 #include "gpio_controller.h"
 #ifdef NATIVE_ENV
 #include "native_arduino_compat.h"
-#else
-#include <climits>  // For ULONG_MAX
 #endif
+#include "output_channels.h"
 
-// Global GPIO state tracking
-static GPIOState gpioState = {
-    .bedlight = false,
-    .toolboxOpener = false,
-    .toolboxButton = false,
-    .systemReady = false,
-    .toolboxOpenerStartTime = 0
+// The truck's outputs, indexed by GPIOOutputChannel. Further relays (aux
+// lights, a compressor) are additional rows driven with setOutputChannel().
+static const OutputChannelConfig outputChannelTable[OUTPUT_CHANNEL_COUNT] = {
+    // name              pin                 mode               pulseMs                     pwm channel/Hz/bits, fade in/out ms
+#if ENABLE_BEDLIGHT_PWM_FADE
+    {"bedlight",         BEDLIGHT_PIN,       OUTPUT_MODE_PWM,   0,                          BEDLIGHT_PWM_CHANNEL,
+     BEDLIGHT_PWM_FREQUENCY_HZ, BEDLIGHT_PWM_RESOLUTION_BITS, BEDLIGHT_FADE_IN_MS, BEDLIGHT_FADE_OUT_MS},
+#else
+    {"bedlight",         BEDLIGHT_PIN,       OUTPUT_MODE_LEVEL, 0,                          0, 0, 0, 0, 0},
+#endif
+    {"toolbox_opener",   TOOLBOX_OPENER_PIN, OUTPUT_MODE_PULSE, TOOLBOX_OPENER_DURATION_MS, 0, 0, 0, 0, 0},
+    {"system_ready",     SYSTEM_READY_PIN,   OUTPUT_MODE_LEVEL, 0,                          0, 0, 0, 0, 0},
 };
 
+static bool toolboxButtonPressed = false;
+
 // Arduino interface for dependency injection
 static ArduinoInterface* arduinoInterface = nullptr;
 static ArduinoHardware defaultHardware;
@@ -40,121 +47,70 @@ static ArduinoInterface* getArduinoInterface() {
 // C-compatible wrapper functions
 extern "C" {
 
+void beginGPIOBatch() {
+    beginOutputBatch();
+}
+
+bool commitGPIOBatch() {
+    return commitOutputBatch();
+}
+
 bool initializeGPIO() {
     ArduinoInterface* hw = getArduinoInterface();
     
     LOG_INFO("Initializing GPIO pins...");
     
-    // Initialize output pins
-    hw->pinMode(BEDLIGHT_PIN, OUTPUT);
-    hw->pinMode(TOOLBOX_OPENER_PIN, OUTPUT);
-    hw->pinMode(SYSTEM_READY_PIN, OUTPUT);
+    // Output pins are driven off by the channel table
+    if (!initializeOutputChannels(outputChannelTable, OUTPUT_CHANNEL_COUNT, hw)) {
+        LOG_ERROR("Output channel setup failed");
+        return false;
+    }
     
     // Initialize input pin with internal pullup
     hw->pinMode(TOOLBOX_BUTTON_PIN, INPUT_PULLUP);
-    
-    // Set all outputs to known state (off)
-    hw->digitalWrite(BEDLIGHT_PIN, LOW);
-    hw->digitalWrite(TOOLBOX_OPENER_PIN, LOW);
-    hw->digitalWrite(SYSTEM_READY_PIN, LOW);
-    
-    // Initialize state structure
-    gpioState.bedlight = false;
-    gpioState.toolboxOpener = false;
-    gpioState.systemReady = false;
-    gpioState.toolboxButton = hw->digitalRead(TOOLBOX_BUTTON_PIN) == LOW; // Active low with pullup
-    gpioState.toolboxOpenerStartTime = 0;
+    toolboxButtonPressed = hw->digitalRead(TOOLBOX_BUTTON_PIN) == LOW; // Active low with pullup
     
     LOG_INFO("GPIO initialization complete");
-    LOG_INFO("  BEDLIGHT_PIN (%d): OUTPUT, initial state: LOW", BEDLIGHT_PIN);
-    LOG_INFO("  TOOLBOX_OPENER_PIN (%d): OUTPUT, initial state: LOW", TOOLBOX_OPENER_PIN);
-    LOG_INFO("  SYSTEM_READY_PIN (%d): OUTPUT, initial state: LOW", SYSTEM_READY_PIN);
     LOG_INFO("  TOOLBOX_BUTTON_PIN (%d): INPUT_PULLUP, current state: %s", 
-             TOOLBOX_BUTTON_PIN, gpioState.toolboxButton ? "PRESSED" : "RELEASED");
+             TOOLBOX_BUTTON_PIN, toolboxButtonPressed ? "PRESSED" : "RELEASED");
     
     return true;
 }
 
 void setBedlight(bool state) {
-    ArduinoInterface* hw = getArduinoInterface();
-    
-    if (gpioState.bedlight != state) {
-        gpioState.bedlight = state;
-        hw->digitalWrite(BEDLIGHT_PIN, state ? HIGH : LOW);
-        LOG_INFO("Bedlight changed to: %s", state ? "ON" : "OFF");
-    }
+    setOutputChannel(OUTPUT_CHANNEL_BEDLIGHT, state);
 }
 
 void setSystemReady(bool state) {
-    ArduinoInterface* hw = getArduinoInterface();
-    
-    if (gpioState.systemReady != state) {
-        gpioState.systemReady = state;
-        hw->digitalWrite(SYSTEM_READY_PIN, state ? HIGH : LOW);
-        LOG_INFO("System ready indicator changed to: %s", state ? "ON" : "OFF");
-    }
+    setOutputChannel(OUTPUT_CHANNEL_SYSTEM_READY, state);
 }
 
 void setToolboxOpener(bool state) {
-    ArduinoInterface* hw = getArduinoInterface();
-    unsigned long currentTime = hw->millis();
-    
-    if (state && !gpioState.toolboxOpener) {
-        // Turning on toolbox opener
-        gpioState.toolboxOpener = true;
-        gpioState.toolboxOpenerStartTime = currentTime;
-        hw->digitalWrite(TOOLBOX_OPENER_PIN, HIGH);
-        LOG_INFO("Toolbox opener activated for %d ms", TOOLBOX_OPENER_DURATION_MS);
-    } else if (!state && gpioState.toolboxOpener) {
-        // Manually turning off toolbox opener
-        gpioState.toolboxOpener = false;
-        gpioState.toolboxOpenerStartTime = 0;
-        hw->digitalWrite(TOOLBOX_OPENER_PIN, LOW);
-        LOG_INFO("Toolbox opener deactivated (manual)");
-    }
+    setOutputChannel(OUTPUT_CHANNEL_TOOLBOX_OPENER, state);
 }
 
 bool readToolboxButton() {
     ArduinoInterface* hw = getArduinoInterface();
     
     // Read button state (active low with pullup)
-    bool currentButtonState = hw->digitalRead(TOOLBOX_BUTTON_PIN) == LOW;
-    
-    // Update stored state
-    gpioState.toolboxButton = currentButtonState;
-    
-    return currentButtonState;
+    toolboxButtonPressed = hw->digitalRead(TOOLBOX_BUTTON_PIN) == LOW;
+    return toolboxButtonPressed;
 }
 
 void updateToolboxOpenerTiming() {
-    if (!gpioState.toolboxOpener) {
-        return; // Not active, nothing to check
-    }
-    
-    ArduinoInterface* hw = getArduinoInterface();
-    unsigned long currentTime = hw->millis();
-    unsigned long elapsed = currentTime - gpioState.toolboxOpenerStartTime;
-    
-    // Handle potential timer rollover (happens every ~50 days)
-    if (currentTime < gpioState.toolboxOpenerStartTime) {
-        elapsed = (ULONG_MAX - gpioState.toolboxOpenerStartTime) + currentTime + 1;
-    }
-    
-    if (elapsed >= TOOLBOX_OPENER_DURATION_MS) {
-        // Time's up, turn off the toolbox opener
-        gpioState.toolboxOpener = false;
-        gpioState.toolboxOpenerStartTime = 0;
-        hw->digitalWrite(TOOLBOX_OPENER_PIN, LOW);
-        LOG_INFO("Toolbox opener timed out after %lu ms", elapsed);
-    }
+    serviceOutputChannels(getArduinoInterface()->millis());
 }
 
 GPIOState getGPIOState() {
-    ArduinoInterface* hw = getArduinoInterface();
+    GPIOState state;
+    state.bedlight = isOutputChannelActive(OUTPUT_CHANNEL_BEDLIGHT);
+    state.toolboxOpener = isOutputChannelActive(OUTPUT_CHANNEL_TOOLBOX_OPENER);
+    state.systemReady = isOutputChannelActive(OUTPUT_CHANNEL_SYSTEM_READY);
+    state.toolboxOpenerStartTime = getOutputChannelState(OUTPUT_CHANNEL_TOOLBOX_OPENER).activatedMs;
     
     // Update button state before returning
-    gpioState.toolboxButton = hw->digitalRead(TOOLBOX_BUTTON_PIN) == LOW;
-    return gpioState;
+    state.toolboxButton = readToolboxButton();
+    return state;
 }
 
 // Additional utility functions for debugging
@@ -11,7 +11,15 @@
 extern "C" {
 #endif
 
-// GPIO state tracking
+// Rows of the output channel table (output_channels.h); add a relay here and in gpio_controller.cpp
+enum GPIOOutputChannel {
+    OUTPUT_CHANNEL_BEDLIGHT = 0,
+    OUTPUT_CHANNEL_TOOLBOX_OPENER,
+    OUTPUT_CHANNEL_SYSTEM_READY,
+    OUTPUT_CHANNEL_COUNT
+};
+
+// GPIO state tracking (a view of the channel states of the fixed outputs)
 struct GPIOState {
     bool bedlight;
     bool toolboxOpener;
@@ -26,9 +34,14 @@ void setBedlight(bool state);
 void setToolboxOpener(bool state);
 void setSystemReady(bool state);
 bool readToolboxButton();
-void updateToolboxOpenerTiming();
+void updateToolboxOpenerTiming();    // Ends or mirrors expired pulses of every pulse channel
 GPIOState getGPIOState();
 
+// Output batching: setBedlight/setToolboxOpener/setSystemReady calls between
+// begin and commit are applied together in one register write (nestable)
+void beginGPIOBatch();
+bool commitGPIOBatch();   // true when the batch wrote the output register
+
 // Utility functions for debugging
 void printGPIOStatus();
 
@@ -0,0 +1,163 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include "latency_tracker.h"
+#include <string.h>
+#include <Arduino.h>
+#ifndef NATIVE_ENV
+#include <esp_timer.h>
+#endif
+
+static LatencyHistogram stageHistograms[LATENCY_STAGE_COUNT];
+
+static const char* const latencyStageNames[LATENCY_STAGE_COUNT] = {
+    "rx->parsed", "parsed->state", "state->gpio", "rx->gpio"
+};
+
+// Frame currently being dispatched
+static uint32_t frameArrivalUs = 0;
+static uint32_t frameParsedUs = 0;
+
+// Oldest frame whose state change has not reached the outputs yet
+static bool outputPending = false;
+static uint32_t pendingArrivalUs = 0;
+static uint32_t pendingAppliedUs = 0;
+
+uint8_t getLatencyBucket(uint32_t latencyUs) {
+    if (latencyUs == 0) {
+        return 0;
+    }
+    uint8_t bucket = (uint8_t)(32 - __builtin_clz(latencyUs));
+    return bucket < LATENCY_HISTOGRAM_BUCKETS ? bucket : LATENCY_HISTOGRAM_BUCKETS - 1;
+}
+
+uint32_t getLatencyBucketLimitUs(uint8_t bucket) {
+    if (bucket >= LATENCY_HISTOGRAM_BUCKETS - 1 || bucket >= 32) {
+        return UINT32_MAX;
+    }
+    return (1UL << bucket) - 1;
+}
+
+void addLatencySample(LatencyHistogram& histogram, uint32_t latencyUs) {
+    histogram.buckets[getLatencyBucket(latencyUs)]++;
+    if (histogram.count == 0 || latencyUs < histogram.minUs) {
+        histogram.minUs = latencyUs;
+    }
+    if (latencyUs > histogram.maxUs) {
+        histogram.maxUs = latencyUs;
+    }
+    histogram.count++;
+    histogram.totalUs += latencyUs;
+}
+
+uint32_t getLatencyPercentileUs(const LatencyHistogram& histogram, uint8_t percent) {
+    if (histogram.count == 0) {
+        return 0;
+    }
+
+    // Smallest bucket holding at least percent% of the samples (rounded up)
+    uint64_t target = ((uint64_t)histogram.count * percent + 99) / 100;
+    if (target == 0) {
+        target = 1;
+    }
+    uint64_t seen = 0;
+    for (uint8_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; bucket++) {
+        seen += histogram.buckets[bucket];
+        if (seen >= target) {
+            uint32_t limit = getLatencyBucketLimitUs(bucket);
+            return limit < histogram.maxUs ? limit : histogram.maxUs;
+        }
+    }
+    return histogram.maxUs;
+}
+
+uint32_t getLatencyTimeUs() {
+#ifdef NATIVE_ENV
+    return (uint32_t)micros();
+#else
+    return (uint32_t)esp_timer_get_time();
+#endif
+}
+
+void beginFrameLatency(uint32_t arrivalUs) {
+    frameArrivalUs = arrivalUs;
+    frameParsedUs = arrivalUs;
+}
+
+void markFrameParsed() {
+    frameParsedUs = getLatencyTimeUs();
+    addLatencySample(stageHistograms[LATENCY_STAGE_PARSE], frameParsedUs - frameArrivalUs);
+}
+
+void markFrameStateApplied(bool outputInputsChanged) {
+    uint32_t nowUs = getLatencyTimeUs();
+    addLatencySample(stageHistograms[LATENCY_STAGE_STATE], nowUs - frameParsedUs);
+
+    if (outputInputsChanged && !outputPending) {
+        outputPending = true;
+        pendingArrivalUs = frameArrivalUs;
+        pendingAppliedUs = nowUs;
+    }
+}
+
+void markOutputsCommitted(bool pinsWritten) {
+    if (!outputPending) {
+        return;
+    }
+    outputPending = false;
+    if (!pinsWritten) {
+        return;
+    }
+
+    uint32_t nowUs = getLatencyTimeUs();
+    addLatencySample(stageHistograms[LATENCY_STAGE_OUTPUT], nowUs - pendingAppliedUs);
+    addLatencySample(stageHistograms[LATENCY_STAGE_TOTAL], nowUs - pendingArrivalUs);
+}
+
+bool getLatencyHistogram(uint8_t stage, LatencyHistogram& histogram) {
+    if (stage >= LATENCY_STAGE_COUNT) {
+        return false;
+    }
+    histogram = stageHistograms[stage];
+    return true;
+}
+
+const char* getLatencyStageName(uint8_t stage) {
+    return stage < LATENCY_STAGE_COUNT ? latencyStageNames[stage] : "unknown";
+}
+
+void resetLatencyStatistics() {
+    memset(stageHistograms, 0, sizeof(stageHistograms));
+    outputPending = false;
+}
+
+void printLatencyStatistics(bool showBuckets) {
+    LOG_INFO("=== FRAME LATENCY (us) ===");
+    for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+        const LatencyHistogram& histogram = stageHistograms[stage];
+        if (histogram.count == 0) {
+            LOG_INFO("%-14s no samples", latencyStageNames[stage]);
+            continue;
+        }
+        LOG_INFO("%-14s n=%lu min %lu mean %lu p50 %lu p90 %lu p99 %lu max %lu", latencyStageNames[stage],
+                 (unsigned long)histogram.count, (unsigned long)histogram.minUs,
+                 (unsigned long)(histogram.totalUs / histogram.count),
+                 (unsigned long)getLatencyPercentileUs(histogram, 50),
+                 (unsigned long)getLatencyPercentileUs(histogram, 90),
+                 (unsigned long)getLatencyPercentileUs(histogram, 99), (unsigned long)histogram.maxUs);
+        if (!showBuckets) {
+            continue;
+        }
+        for (uint8_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; bucket++) {
+            if (histogram.buckets[bucket] == 0) {
+                continue;
+            }
+            if (bucket == LATENCY_HISTOGRAM_BUCKETS - 1) {
+                LOG_INFO("    >= %8lu: %lu", (unsigned long)getLatencyBucketLimitUs(bucket - 1) + 1,
+                         (unsigned long)histogram.buckets[bucket]);
+            } else {
+                LOG_INFO("    <= %8lu: %lu", (unsigned long)getLatencyBucketLimitUs(bucket),
+                         (unsigned long)histogram.buckets[bucket]);
+            }
+        }
+    }
+    LOG_INFO("Percentiles are log2 bucket limits%s", showBuckets ? "" : "; 'latency buckets' shows the histograms");
+}
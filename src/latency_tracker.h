@@ -0,0 +1,61 @@
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Frame-to-output latency histograms
+ *
+ * A frame is stamped (microseconds, esp_timer_get_time()) when the CAN
+ * controller hands it over - the MCP2515 INT edge or the TWAI driver read -
+ * and again as it moves through the pipeline:
+ *
+ *   arrival -> parsed -> state updated -> GPIO commit
+ *
+ * Each step feeds a log2 histogram, plus the end-to-end total. Only frames
+ * that changed an output input (bed light, system ready) reach the output
+ * stages; when several do before the outputs are recomputed, the oldest one
+ * is charged, so the total is the worst case for that change. A commit that
+ * writes no pin closes the measurement without a sample.
+ *
+ * All stamps after arrival are taken on the loop() task; the arrival stamp
+ * may come from the receive task on the other core (esp_timer is global).
+ * The 32-bit microsecond clock wraps after ~71 minutes, which unsigned
+ * subtraction absorbs for any latency below that.
+ */
+
+#define LATENCY_STAGE_PARSE 0       // Arrival -> parse finished (includes queue wait)
+#define LATENCY_STAGE_STATE 1       // Parse finished -> state update finished
+#define LATENCY_STAGE_OUTPUT 2      // State update -> GPIO register write
+#define LATENCY_STAGE_TOTAL 3       // Arrival -> GPIO register write
+#define LATENCY_STAGE_COUNT 4
+
+struct LatencyHistogram {
+    uint32_t buckets[LATENCY_HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+};
+
+// Histogram arithmetic (pure logic; host-testable)
+uint8_t getLatencyBucket(uint32_t latencyUs);           // 0 for 0 us, n for [2^(n-1), 2^n)
+uint32_t getLatencyBucketLimitUs(uint8_t bucket);       // Largest latency counted in the bucket
+void addLatencySample(LatencyHistogram& histogram, uint32_t latencyUs);
+uint32_t getLatencyPercentileUs(const LatencyHistogram& histogram, uint8_t percent);   // Bucket limit, capped at max
+
+// Pipeline stamps
+uint32_t getLatencyTimeUs();                            // Clock used for every stamp
+void beginFrameLatency(uint32_t arrivalUs);             // Dispatcher: frame taken for a full parse
+void markFrameParsed();                                 // Handler: parse finished
+void markFrameStateApplied(bool outputInputsChanged);   // Dispatcher: state updated
+void markOutputsCommitted(bool pinsWritten);            // Output logic: GPIO batch committed
+
+// Reporting
+bool getLatencyHistogram(uint8_t stage, LatencyHistogram& histogram);
+const char* getLatencyStageName(uint8_t stage);
+void resetLatencyStatistics();
+void printLatencyStatistics(bool showBuckets);
+
+#endif // LATENCY_TRACKER_H
@@ -0,0 +1,99 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include <Arduino.h>
+#include "config.h"
+#include "light_sleep.h"
+
+#if ENABLE_LIGHT_SLEEP
+
+#include "driver/gpio.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#include "button_driver.h"
+#include "can_manager.h"
+#include "gpio_controller.h"
+#include "output_channels.h"
+#include "sleep_policy.h"
+#include "logger.h"
+
+static void armWakeSources() {
+    gpio_wakeup_enable((gpio_num_t)CAN_IRQ_PIN, GPIO_INTR_LOW_LEVEL);
+#if ENABLE_TWAI_CONTROLLER
+    gpio_wakeup_enable((gpio_num_t)TWAI_RX_PIN, GPIO_INTR_LOW_LEVEL);   // Recessive is high
+#endif
+    gpio_wakeup_enable((gpio_num_t)TOOLBOX_BUTTON_PIN, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+}
+
+// gpio_wakeup_enable() replaced the interrupt types the drivers attached with
+static void disarmWakeSources() {
+    gpio_wakeup_disable((gpio_num_t)CAN_IRQ_PIN);
+#if ENABLE_CAN_RX_INTERRUPT
+    gpio_set_intr_type((gpio_num_t)CAN_IRQ_PIN, GPIO_INTR_NEGEDGE);
+#else
+    gpio_set_intr_type((gpio_num_t)CAN_IRQ_PIN, GPIO_INTR_DISABLE);
+#endif
+#if ENABLE_TWAI_CONTROLLER
+    gpio_wakeup_disable((gpio_num_t)TWAI_RX_PIN);
+    gpio_set_intr_type((gpio_num_t)TWAI_RX_PIN, GPIO_INTR_DISABLE);
+#endif
+    gpio_wakeup_disable((gpio_num_t)TOOLBOX_BUTTON_PIN);
+    gpio_set_intr_type((gpio_num_t)TOOLBOX_BUTTON_PIN, GPIO_INTR_ANYEDGE);
+}
+
+static uint8_t getWakeCause() {
+    if (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER) {
+        return SLEEP_WAKE_TIMER;
+    }
+    if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_GPIO) {
+        return SLEEP_WAKE_OTHER;
+    }
+    // INT and the button hold their level; a TWAI edge is usually over by now
+    if (gpio_get_level((gpio_num_t)CAN_IRQ_PIN) == 0) {
+        return SLEEP_WAKE_CAN;
+    }
+    if (gpio_get_level((gpio_num_t)TOOLBOX_BUTTON_PIN) == 0) {
+        return SLEEP_WAKE_BUTTON;
+    }
+#if ENABLE_TWAI_CONTROLLER
+    return SLEEP_WAKE_TWAI;
+#else
+    return SLEEP_WAKE_OTHER;
+#endif
+}
+
+bool enterLightSleep(unsigned long maxMs) {
+    // The relay drivers stay unpowered while the CPUs are stopped
+    bool relaySupplyOn = isOutputChannelActive(OUTPUT_CHANNEL_SYSTEM_READY);
+    setSystemReady(false);
+
+    armWakeSources();
+    esp_sleep_enable_timer_wakeup((uint64_t)maxMs * 1000ULL);
+
+    uint32_t sleepStartUs = (uint32_t)esp_timer_get_time();
+    esp_err_t result = esp_light_sleep_start();
+    uint32_t wakeUs = (uint32_t)esp_timer_get_time();
+
+    uint8_t cause = getWakeCause();
+    disarmWakeSources();
+    if (relaySupplyOn) {
+        setSystemReady(true);
+    }
+    if (result != ESP_OK) {
+        LOG_WARN("Light sleep failed: %s", esp_err_to_name(result));
+        return false;
+    }
+
+    // The wake edge never reached onCANInterrupt() / onButtonEdge()
+    if (cause == SLEEP_WAKE_CAN || cause == SLEEP_WAKE_TWAI) {
+        notifyCANWake();
+    } else if (cause == SLEEP_WAKE_BUTTON) {
+        notifyButtonWake();
+    }
+
+    recordSleepWake(cause, wakeUs - sleepStartUs, wakeUs);
+    LOG_DEBUG("Woke from light sleep after %lu ms (%s)", (unsigned long)((wakeUs - sleepStartUs) / 1000),
+              getSleepWakeCauseName(cause));
+    return true;
+}
+
+#endif // ENABLE_LIGHT_SLEEP
@@ -0,0 +1,26 @@
+#ifndef LIGHT_SLEEP_H
+#define LIGHT_SLEEP_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Light sleep entry and wake (ENABLE_LIGHT_SLEEP, firmware only)
+ *
+ * loop() calls enterLightSleep() in place of its idle wait once
+ * getSleepBlocker() (sleep_policy.h) has nothing against it. The relay-driver
+ * supply is dropped, the wake sources are armed as low-level GPIO wakeups
+ * (MCP2515 INT, TWAI RX when the TWAI controller is enabled, toolbox button)
+ * next to a timer wake for the loop's own deadline, and the chip sleeps.
+ *
+ * A wake edge is taken by the wakeup logic rather than the pin's interrupt
+ * handler, so on wake the receive path and the button driver are kicked
+ * directly and the relay supply is restored. The wake cause and the time
+ * asleep go to recordSleepWake().
+ */
+
+#if ENABLE_LIGHT_SLEEP && !defined(NATIVE_ENV)
+bool enterLightSleep(unsigned long maxMs);     // false when the chip did not sleep
+#endif
+
+#endif // LIGHT_SLEEP_H
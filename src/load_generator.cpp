@@ -0,0 +1,303 @@
+#include "load_generator.h"
+#include <string.h>
+#include "bit_utils.h"
+#include "dbc_signals.h"
+
+struct LoadSignalSource {
+    uint32_t id;
+    const CANSignalSpec* signal;
+};
+
+static const LoadSignalSource loadSignalSources[LOAD_SIGNAL_COUNT] = {
+    {BCM_LAMP_STAT_FD1_ID, &dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq},
+    {LOCKING_SYSTEMS_2_FD1_ID, &dbc::Locking_Systems_2_FD1::Veh_Lock_Status},
+    {POWERTRAIN_DATA_10_ID, &dbc::PowertrainData_10::TrnPrkSys_D_Actl},
+    {BATTERY_MGMT_3_FD1_ID, &dbc::Battery_Mgmt_3_FD1::BSBattSOC},
+};
+
+// Other HS-CAN traffic of a Gen14 truck; none of these is monitored
+static const uint16_t backgroundIds[] = {
+    0x07D, 0x083, 0x091, 0x092, 0x167, 0x178, 0x202, 0x204,
+    0x213, 0x216, 0x217, 0x230, 0x3B3, 0x3D8, 0x415, 0x42F
+};
+
+static uint32_t nextRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+uint32_t getCANFrameBits(uint8_t length) {
+    if (length > 8) {
+        length = 8;
+    }
+    // 47 bits of framing and interframe space, one stuff bit per 4 bits
+    // after the first across SOF..CRC (34 + 8 * length bits)
+    uint32_t stuffable = 34 + 8u * length;
+    return 47 + 8u * length + (stuffable - 1) / 4;
+}
+
+uint32_t getCANBusLoadFrameRate(uint32_t bitrate, uint8_t loadPercent) {
+    return (uint32_t)((uint64_t)bitrate * loadPercent / 100 / getCANFrameBits(8));
+}
+
+LoadProfile defaultLoadProfile() {
+    LoadProfile profile;
+    memset(&profile, 0, sizeof(profile));
+    profile.seed = 0x5EED1234;
+    profile.bitrate = 500000;
+    profile.framesPerSecond = getCANBusLoadFrameRate(profile.bitrate, 100);
+    profile.durationMs = 10000;
+    profile.monitoredPeriodMs = 100;
+    profile.scenarioStepMs = 250;
+    return profile;
+}
+
+static void stepScenario(LoadGenerator& generator) {
+    uint32_t& rng = generator.rng;
+    generator.values[LOAD_SIGNAL_PUD_LAMP] = (uint8_t)(nextRandom(rng) % 4);
+    generator.values[LOAD_SIGNAL_LOCK] = (uint8_t)(nextRandom(rng) % 4);
+    generator.values[LOAD_SIGNAL_PARK] = (uint8_t)(nextRandom(rng) % (TRNPRKSTS_OUT_OF_PARK + 1));
+    generator.values[LOAD_SIGNAL_BATTERY_SOC] = (uint8_t)(nextRandom(rng) % 101);
+}
+
+void beginLoadGenerator(LoadGenerator& generator, const LoadProfile& profile) {
+    memset(&generator, 0, sizeof(generator));
+    generator.profile = profile;
+    generator.rng = profile.seed != 0 ? profile.seed : 1;
+    uint32_t rate = profile.framesPerSecond != 0 ? profile.framesPerSecond : 1;
+    generator.slotNs = 1000000000ULL / rate;
+    generator.wireFrameNs = profile.bitrate != 0 ? 1000000000ULL * getCANFrameBits(8) / profile.bitrate : generator.slotNs;
+    generator.nextStepUs = profile.scenarioStepMs * 1000ULL;
+    generator.nextBurstUs = profile.burstIntervalMs * 1000ULL;
+
+    // Stagger the monitored messages across the first period
+    for (uint8_t signal = 0; signal < LOAD_SIGNAL_COUNT; signal++) {
+        generator.nextMonitoredUs[signal] = (uint64_t)profile.monitoredPeriodMs * 1000ULL * signal / LOAD_SIGNAL_COUNT;
+    }
+    stepScenario(generator);
+}
+
+static void buildSignalFrame(uint8_t signal, uint8_t value, CANFrame& frame) {
+    memset(&frame, 0, sizeof(frame));
+    frame.id = loadSignalSources[signal].id;
+    frame.length = 8;
+    setBits(frame.data, loadSignalSources[signal].signal->startBit, loadSignalSources[signal].signal->length, value);
+}
+
+void makeLoadSignalFrame(const LoadGenerator& generator, uint8_t signal, CANFrame& frame, LoadFrameInfo& info) {
+    buildSignalFrame(signal, generator.values[signal], frame);
+    info.signal = signal;
+    info.value = generator.values[signal];
+    info.fault = LOAD_FAULT_NONE;
+}
+
+static void buildBackgroundFrame(LoadGenerator& generator, CANFrame& frame, LoadFrameInfo& info) {
+    memset(&frame, 0, sizeof(frame));
+    frame.id = backgroundIds[nextRandom(generator.rng) % (sizeof(backgroundIds) / sizeof(backgroundIds[0]))];
+    frame.length = 8;
+    uint32_t low = nextRandom(generator.rng);
+    uint32_t high = nextRandom(generator.rng);
+    memcpy(frame.data, &low, sizeof(low));
+    memcpy(frame.data + 4, &high, sizeof(high));
+    info.signal = LOAD_SIGNAL_BACKGROUND;
+    info.value = 0;
+    info.fault = LOAD_FAULT_NONE;
+}
+
+// At most one fault per frame; kinds that do not apply to the frame are not drawn
+static uint8_t drawFault(LoadGenerator& generator, uint8_t signal, bool allowOutOfOrder) {
+    uint32_t roll = nextRandom(generator.rng) % 1000;
+    uint32_t threshold = 0;
+    for (uint8_t fault = 0; fault < LOAD_FAULT_COUNT; fault++) {
+        threshold += generator.profile.faultPerMille[fault];
+        if (roll >= threshold) {
+            continue;
+        }
+        bool monitored = signal != LOAD_SIGNAL_BACKGROUND;
+        switch (fault) {
+            case LOAD_FAULT_DLC_MISMATCH:
+            case LOAD_FAULT_MALFORMED:
+                return monitored ? fault : LOAD_FAULT_NONE;
+            case LOAD_FAULT_INVALID_VALUE:
+                return signal == LOAD_SIGNAL_PARK || signal == LOAD_SIGNAL_BATTERY_SOC ? fault : LOAD_FAULT_NONE;
+            default:
+                return allowOutOfOrder ? fault : LOAD_FAULT_NONE;
+        }
+    }
+    return LOAD_FAULT_NONE;
+}
+
+static void injectFault(LoadGenerator& generator, uint8_t fault, CANFrame& frame, LoadFrameInfo& info) {
+    const CANSignalSpec& spec = *loadSignalSources[info.signal].signal;
+    switch (fault) {
+        case LOAD_FAULT_DLC_MISMATCH:
+            frame.length = (uint8_t)(nextRandom(generator.rng) % 8);
+            memset(frame.data + frame.length, 0, sizeof(frame.data) - frame.length);
+            break;
+        case LOAD_FAULT_MALFORMED: {
+            uint8_t signalBits[8] = {0};
+            setBits(signalBits, spec.startBit, spec.length, (1u << spec.length) - 1);
+            for (uint8_t i = 0; i < 8; i++) {
+                frame.data[i] |= (uint8_t)nextRandom(generator.rng) & (uint8_t)~signalBits[i];
+            }
+            break;
+        }
+        case LOAD_FAULT_INVALID_VALUE:
+            info.value = info.signal == LOAD_SIGNAL_PARK
+                ? (uint8_t)(TRNPRKSTS_OUT_OF_PARK + 1 + nextRandom(generator.rng) % (15 - TRNPRKSTS_OUT_OF_PARK))
+                : (uint8_t)(101 + nextRandom(generator.rng) % 27);
+            setBits(frame.data, spec.startBit, spec.length, info.value);
+            break;
+        default:
+            break;
+    }
+    info.fault = fault;
+}
+
+// One frame in generation order (before any OUT_OF_ORDER swap)
+static bool generateFrame(LoadGenerator& generator, bool allowOutOfOrder, CANFrame& frame,
+                          uint64_t& timeUs, LoadFrameInfo& info) {
+    const LoadProfile& profile = generator.profile;
+    uint64_t endUs = profile.durationMs * 1000ULL;
+
+    // A burst takes the wire back to back, ahead of the regular slots
+    if (generator.burstRemaining == 0 && profile.burstFrames != 0 && profile.burstIntervalMs != 0 &&
+        generator.nextSlotNs / 1000 >= generator.nextBurstUs) {
+        generator.burstRemaining = profile.burstFrames;
+        generator.burstAtNs = generator.nextSlotNs;
+        generator.nextBurstUs += profile.burstIntervalMs * 1000ULL;
+    }
+
+    uint8_t signal = LOAD_SIGNAL_BACKGROUND;
+    if (generator.burstRemaining != 0) {
+        timeUs = generator.burstAtNs / 1000;
+        if (timeUs >= endUs) {
+            return false;
+        }
+        generator.burstAtNs += generator.wireFrameNs;
+        if (--generator.burstRemaining == 0 && generator.nextSlotNs < generator.burstAtNs) {
+            generator.nextSlotNs = generator.burstAtNs;
+        }
+        generator.stats.burstFrames++;
+    } else {
+        timeUs = generator.nextSlotNs / 1000;
+        if (timeUs >= endUs) {
+            return false;
+        }
+        generator.nextSlotNs += generator.slotNs;
+
+        while (profile.scenarioStepMs != 0 && timeUs >= generator.nextStepUs) {
+            stepScenario(generator);
+            generator.nextStepUs += profile.scenarioStepMs * 1000ULL;
+        }
+
+        // The most overdue monitored message takes the slot
+        for (uint8_t candidate = 0; candidate < LOAD_SIGNAL_COUNT; candidate++) {
+            if (generator.nextMonitoredUs[candidate] <= timeUs &&
+                (signal == LOAD_SIGNAL_BACKGROUND || generator.nextMonitoredUs[candidate] < generator.nextMonitoredUs[signal])) {
+                signal = candidate;
+            }
+        }
+    }
+
+    if (signal == LOAD_SIGNAL_BACKGROUND) {
+        buildBackgroundFrame(generator, frame, info);
+        generator.stats.backgroundFrames++;
+    } else {
+        uint64_t periodUs = profile.monitoredPeriodMs * 1000ULL;
+        generator.nextMonitoredUs[signal] += periodUs;
+        if (generator.nextMonitoredUs[signal] <= timeUs) {
+            generator.nextMonitoredUs[signal] = timeUs + periodUs;     // Too slow a rate: no catch-up storm
+        }
+        makeLoadSignalFrame(generator, signal, frame, info);
+        generator.stats.monitoredFrames++;
+    }
+
+    uint8_t fault = drawFault(generator, signal, allowOutOfOrder);
+    if (fault != LOAD_FAULT_NONE && fault != LOAD_FAULT_OUT_OF_ORDER) {
+        injectFault(generator, fault, frame, info);
+        generator.stats.faults[fault]++;
+    } else if (fault == LOAD_FAULT_OUT_OF_ORDER) {
+        info.fault = fault;
+    }
+    generator.stats.frames++;
+    return true;
+}
+
+bool nextLoadFrame(LoadGenerator& generator, CANFrame& frame, uint64_t& timeUs, LoadFrameInfo& info) {
+    if (generator.held) {
+        generator.held = false;
+        frame = generator.heldFrame;
+        info = generator.heldInfo;
+        timeUs = generator.heldTimeUs;
+        return true;
+    }
+
+    if (!generateFrame(generator, true, frame, timeUs, info)) {
+        return false;
+    }
+    if (info.fault != LOAD_FAULT_OUT_OF_ORDER) {
+        return true;
+    }
+
+    // Send the next frame in this one's slot and this one in the next slot
+    CANFrame next;
+    LoadFrameInfo nextInfo;
+    uint64_t nextTimeUs;
+    if (!generateFrame(generator, false, next, nextTimeUs, nextInfo)) {
+        info.fault = LOAD_FAULT_NONE;   // Nothing left to swap with
+        return true;
+    }
+    generator.heldFrame = frame;
+    generator.heldInfo = info;
+    generator.heldTimeUs = nextTimeUs;
+    generator.held = true;
+    generator.stats.faults[LOAD_FAULT_OUT_OF_ORDER]++;
+    frame = next;
+    info = nextInfo;
+    return true;
+}
+
+const char* getLoadFaultName(uint8_t fault) {
+    switch (fault) {
+        case LOAD_FAULT_DLC_MISMATCH: return "DLC mismatch";
+        case LOAD_FAULT_MALFORMED: return "malformed";
+        case LOAD_FAULT_INVALID_VALUE: return "invalid value";
+        case LOAD_FAULT_OUT_OF_ORDER: return "out of order";
+        default: return "none";
+    }
+}
+
+void resetLoadModel(LoadModel& model) {
+    memset(&model, 0, sizeof(model));
+}
+
+void applyLoadModelFrame(LoadModel& model, const LoadFrameInfo& info) {
+    // Short frames never reach the state; everything else is taken as sent
+    if (info.signal >= LOAD_SIGNAL_COUNT || info.fault == LOAD_FAULT_DLC_MISMATCH) {
+        return;
+    }
+    model.values[info.signal] = info.value;
+    model.seenMask |= (uint8_t)(1u << info.signal);
+}
+
+static bool hasLoadValue(const LoadModel& model, uint8_t signal) {
+    return (model.seenMask & (1u << signal)) != 0;
+}
+
+bool expectLoadBedlight(const LoadModel& model) {
+    uint8_t pudLamp = model.values[LOAD_SIGNAL_PUD_LAMP];
+    return hasLoadValue(model, LOAD_SIGNAL_PUD_LAMP) && (pudLamp == PUDLAMP_ON || pudLamp == PUDLAMP_RAMP_UP);
+}
+
+bool expectLoadParked(const LoadModel& model) {
+    // Assumed parked until the powertrain reports otherwise
+    return !hasLoadValue(model, LOAD_SIGNAL_PARK) || model.values[LOAD_SIGNAL_PARK] == TRNPRKSTS_PARK;
+}
+
+bool expectLoadUnlocked(const LoadModel& model) {
+    uint8_t lock = model.values[LOAD_SIGNAL_LOCK];
+    return hasLoadValue(model, LOAD_SIGNAL_LOCK) && (lock == VEH_UNLOCK_ALL || lock == VEH_UNLOCK_DRV);
+}
@@ -0,0 +1,115 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include <stdint.h>
+#include "config.h"
+#include "can_protocol.h"
+
+/**
+ * Synthetic Ford traffic for bus-load stress and fault injection
+ *
+ * A deterministic generator (seeded xorshift) produces a timed frame stream
+ * at a configured rate: the four monitored messages every monitoredPeriodMs,
+ * carrying values that change every scenarioStepMs, with the remaining
+ * frame slots filled by unmonitored background IDs. Optional bursts insert
+ * back-to-back background frames at the full wire rate. Faults are drawn per
+ * frame from per-mille rates:
+ * - DLC_MISMATCH: a monitored frame shorter than 8 bytes (parser rejects it)
+ * - MALFORMED: random bits everywhere except the monitored signal's own bits
+ * - INVALID_VALUE: TrnPrkSys_D_Actl or BSBattSOC outside the DBC value range
+ * - OUT_OF_ORDER: the frame is sent after the one generated behind it
+ *
+ * Every frame comes with a LoadFrameInfo saying which signal it carries and
+ * what value. LoadModel is the reference the pipeline is checked against: it
+ * applies the info of each frame that was actually delivered, in delivery
+ * order, and derives the expected outputs from the DBC values directly, not
+ * through the parser or the rule tables.
+ *
+ * Used by the host stress harness (lib/trace_replay/load_test.h) and the
+ * on-target TWAI loopback run (can_stress.h).
+ */
+
+#define LOAD_SIGNAL_PUD_LAMP 0
+#define LOAD_SIGNAL_LOCK 1
+#define LOAD_SIGNAL_PARK 2
+#define LOAD_SIGNAL_BATTERY_SOC 3
+#define LOAD_SIGNAL_COUNT 4
+#define LOAD_SIGNAL_BACKGROUND 0xFF     // Unmonitored ID
+
+#define LOAD_FAULT_DLC_MISMATCH 0
+#define LOAD_FAULT_MALFORMED 1
+#define LOAD_FAULT_INVALID_VALUE 2
+#define LOAD_FAULT_OUT_OF_ORDER 3
+#define LOAD_FAULT_COUNT 4
+#define LOAD_FAULT_NONE 0xFF
+
+struct LoadProfile {
+    uint32_t seed;
+    uint32_t framesPerSecond;           // Offered rate; getCANBusLoadFrameRate() converts a bus load
+    uint32_t durationMs;
+    uint32_t bitrate;                   // Wire rate of bursts
+    uint16_t monitoredPeriodMs;         // Repeat period of each monitored message
+    uint32_t scenarioStepMs;            // Monitored values change this often
+    uint16_t burstFrames;               // Back-to-back background frames per burst, 0 = no bursts
+    uint32_t burstIntervalMs;
+    uint16_t faultPerMille[LOAD_FAULT_COUNT];
+};
+
+struct LoadFrameInfo {
+    uint8_t signal;                     // LOAD_SIGNAL_*
+    uint8_t value;                      // Raw value the frame carries
+    uint8_t fault;                      // LOAD_FAULT_*
+};
+
+struct LoadGeneratorStats {
+    uint32_t frames;
+    uint32_t monitoredFrames;
+    uint32_t backgroundFrames;
+    uint32_t burstFrames;
+    uint32_t faults[LOAD_FAULT_COUNT];
+};
+
+struct LoadGenerator {
+    LoadProfile profile;
+    uint32_t rng;
+    uint64_t nextSlotNs;                // Next frame slot at the offered rate
+    uint64_t slotNs;
+    uint64_t wireFrameNs;               // One worst-case frame on the wire
+    uint64_t nextMonitoredUs[LOAD_SIGNAL_COUNT];
+    uint64_t nextStepUs;
+    uint64_t nextBurstUs;
+    uint64_t burstAtNs;
+    uint16_t burstRemaining;
+    uint8_t values[LOAD_SIGNAL_COUNT];  // Current scenario values
+    bool held;                          // A frame waits behind the next one (OUT_OF_ORDER)
+    CANFrame heldFrame;
+    LoadFrameInfo heldInfo;
+    uint64_t heldTimeUs;
+    LoadGeneratorStats stats;
+};
+
+// The expected pipeline state for the frames delivered so far
+struct LoadModel {
+    uint8_t values[LOAD_SIGNAL_COUNT];
+    uint8_t seenMask;                   // Bit per LOAD_SIGNAL_* with a delivered value
+};
+
+// Bits of a standard data frame with worst-case stuffing and the interframe space
+uint32_t getCANFrameBits(uint8_t length);
+uint32_t getCANBusLoadFrameRate(uint32_t bitrate, uint8_t loadPercent);   // 8-byte frames/s
+
+LoadProfile defaultLoadProfile();
+void beginLoadGenerator(LoadGenerator& generator, const LoadProfile& profile);
+// Next frame and its send time (us from the start); false once durationMs has passed
+bool nextLoadFrame(LoadGenerator& generator, CANFrame& frame, uint64_t& timeUs, LoadFrameInfo& info);
+// A fault-free frame of one monitored signal carrying its current scenario value
+void makeLoadSignalFrame(const LoadGenerator& generator, uint8_t signal, CANFrame& frame, LoadFrameInfo& info);
+const char* getLoadFaultName(uint8_t fault);
+
+void resetLoadModel(LoadModel& model);
+void applyLoadModelFrame(LoadModel& model, const LoadFrameInfo& info);
+bool expectLoadBedlight(const LoadModel& model);    // With the system ready and no manual override
+bool expectLoadParked(const LoadModel& model);
+bool expectLoadUnlocked(const LoadModel& model);
+
+#endif // LOAD_GENERATOR_H
@@ -1,7 +1,83 @@
 #include "logger.h"
 
+// Runtime level per module; LOG_* macros compare against these after the
+// compile-time DEBUG_LEVEL check has already removed anything more verbose
+uint8_t logModuleLevels[LOG_MODULE_COUNT] = {
+    DEBUG_LEVEL, DEBUG_LEVEL, DEBUG_LEVEL, DEBUG_LEVEL,
+    DEBUG_LEVEL, DEBUG_LEVEL, DEBUG_LEVEL, DEBUG_LEVEL
+};
+
+static const char* const logModuleNames[LOG_MODULE_COUNT] = {
+    "main", "can", "twai", "frames", "parser", "state", "gpio", "diag"
+};
+
+static const char* const logLevelNames[] = {
+    "none", "error", "warn", "info", "debug"
+};
+
+const char* getLogModuleName(uint8_t module) {
+    return module < LOG_MODULE_COUNT ? logModuleNames[module] : "unknown";
+}
+
+int findLogModule(const char* name) {
+    for (uint8_t i = 0; i < LOG_MODULE_COUNT; i++) {
+        if (strcasecmp(name, logModuleNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int parseLogLevel(const char* name) {
+    for (uint8_t i = 0; i <= DEBUG_LEVEL_DEBUG; i++) {
+        if (strcasecmp(name, logLevelNames[i]) == 0) {
+            return i;
+        }
+    }
+    if (name[0] >= '0' && name[0] <= '0' + DEBUG_LEVEL_DEBUG && name[1] == '\0') {
+        return name[0] - '0';
+    }
+    return -1;
+}
+
+const char* logLevelToString(uint8_t level) {
+    return level <= DEBUG_LEVEL_DEBUG ? logLevelNames[level] : "invalid";
+}
+
+bool setLogModuleLevel(uint8_t module, uint8_t level) {
+    if (module >= LOG_MODULE_COUNT) {
+        return false;
+    }
+    // Levels above DEBUG_LEVEL were compiled out and cannot be enabled at runtime
+    logModuleLevels[module] = level > DEBUG_LEVEL ? DEBUG_LEVEL : level;
+    return true;
+}
+
+void setAllLogModuleLevels(uint8_t level) {
+    for (uint8_t i = 0; i < LOG_MODULE_COUNT; i++) {
+        setLogModuleLevel(i, level);
+    }
+}
+
+void printLogConfiguration() {
+    LOG_INFO("Log levels (compiled max: %s):", logLevelToString(DEBUG_LEVEL));
+    for (uint8_t i = 0; i < LOG_MODULE_COUNT; i++) {
+        LOG_INFO("  %-7s %s", logModuleNames[i], logLevelToString(logModuleLevels[i]));
+    }
+#if ENABLE_DEFERRED_LOGGING
+    LOG_INFO("Deferred log queue: %d records, high water %u, dropped %lu",
+             DEFERRED_LOG_QUEUE_SIZE, getDeferredLogHighWaterMark(), getDeferredLogDropCount());
+#endif
+}
+
 // Log CAN message with direction, ID, and raw data
 void logCANMessage(const char* direction, uint32_t id, const uint8_t* data, uint8_t length) {
+#if DEBUG_LEVEL >= DEBUG_LEVEL_DEBUG
+    // Skip the hex formatting entirely unless frame dumps are enabled
+    if (!LOG_ENABLED(LOG_MODULE_FRAMES, DEBUG_LEVEL_DEBUG)) {
+        return;
+    }
+
     // Create hex string representation of the data
     char dataHex[25]; // 8 bytes * 3 chars per byte + null terminator
     char* ptr = dataHex;
@@ -15,8 +91,11 @@ void logCANMessage(const char* direction, uint32_t id, const uint8_t* data, uint
     }
     *ptr = '\0';
     
-    LOG_DEBUG("CAN %s: ID=0x%03X (%d), Len=%d, Data=[%s]", 
-              direction, id, id, length, dataHex);
+    LOG_EMIT(LOG_MODULE_FRAMES, DEBUG_LEVEL_DEBUG, "[DEBUG] ", "CAN %s: ID=0x%03X (%d), Len=%d, Data=[%s]",
+             direction, id, id, length, dataHex);
+#else
+    (void)direction; (void)id; (void)data; (void)length;
+#endif
 }
 
 // Utility functions for converting values to strings
@@ -6,6 +6,15 @@
 
 // Additional logging utilities beyond the basic macros in config.h
 
+// Runtime log levels - one per LOG_MODULE_*, never above the compiled DEBUG_LEVEL
+const char* getLogModuleName(uint8_t module);
+int findLogModule(const char* name);                 // -1 when unknown
+int parseLogLevel(const char* name);                 // "error".."debug" or 0-4; -1 when invalid
+const char* logLevelToString(uint8_t level);
+bool setLogModuleLevel(uint8_t module, uint8_t level);
+void setAllLogModuleLevels(uint8_t level);
+void printLogConfiguration();
+
 // Function declarations
 void logSystemStartup();
 void logCANMessage(const char* direction, uint32_t id, const uint8_t* data, uint8_t length);
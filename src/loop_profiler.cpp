@@ -0,0 +1,153 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include "loop_profiler.h"
+#include <string.h>
+#include <Arduino.h>
+
+static LoopProfileStats profile;
+static uint32_t passStartCycles = 0;
+static uint32_t sectionStartCycles = 0;
+static uint32_t passIdleCycles = 0;
+static bool streaming = LOOP_PROFILE_STREAM_DEFAULT;
+
+static const char* const loopSectionNames[LOOP_SECTION_COUNT] = {
+    "idle", "serial", "can", "state", "button", "outputs", "jobs"
+};
+
+static uint32_t readProfileCycles() {
+#ifdef NATIVE_ENV
+    return (uint32_t)micros();
+#else
+    return ESP.getCycleCount();
+#endif
+}
+
+static uint32_t readCyclesPerUs() {
+#ifdef NATIVE_ENV
+    return 1;
+#else
+    return ESP.getCpuFreqMHz();
+#endif
+}
+
+void beginLoopPass() {
+    if (profile.cyclesPerUs == 0) {
+        profile.cyclesPerUs = readCyclesPerUs();
+    }
+    passStartCycles = readProfileCycles();
+    sectionStartCycles = passStartCycles;
+    passIdleCycles = 0;
+}
+
+void markLoopSection(uint8_t section) {
+    uint32_t now = readProfileCycles();
+    uint32_t elapsed = now - sectionStartCycles;
+    sectionStartCycles = now;
+    if (section >= LOOP_SECTION_COUNT) {
+        return;
+    }
+
+    profile.sectionCycles[section] += elapsed;
+    if (elapsed > profile.sectionMaxCycles[section]) {
+        profile.sectionMaxCycles[section] = elapsed;
+    }
+    if (section == LOOP_SECTION_IDLE) {
+        passIdleCycles += elapsed;
+    }
+}
+
+void endLoopPass(uint16_t framesDrained) {
+    uint32_t busyCycles = (sectionStartCycles - passStartCycles) - passIdleCycles;
+    addLatencySample(profile.busyUs, busyCycles / profile.cyclesPerUs);
+
+    profile.passes++;
+    profile.framesDrained += framesDrained;
+    if (framesDrained > profile.maxFramesPerPass) {
+        profile.maxFramesPerPass = framesDrained;
+    }
+    if (framesDrained >= CAN_MAX_FRAMES_PER_LOOP) {
+        profile.cappedPasses++;
+    }
+}
+
+LoopProfileStats getLoopProfileStats() {
+    return profile;
+}
+
+uint8_t getLoopIdlePercent(const LoopProfileStats& stats) {
+    uint64_t total = 0;
+    for (uint8_t i = 0; i < LOOP_SECTION_COUNT; i++) {
+        total += stats.sectionCycles[i];
+    }
+    return total > 0 ? (uint8_t)((stats.sectionCycles[LOOP_SECTION_IDLE] * 100) / total) : 0;
+}
+
+const char* getLoopSectionName(uint8_t section) {
+    return section < LOOP_SECTION_COUNT ? loopSectionNames[section] : "unknown";
+}
+
+void resetLoopProfile() {
+    uint32_t cyclesPerUs = profile.cyclesPerUs;
+    memset(&profile, 0, sizeof(profile));
+    profile.cyclesPerUs = cyclesPerUs;
+}
+
+void printLoopProfile() {
+    LoopProfileStats stats = profile;
+    LOG_INFO("=== LOOP PROFILE ===");
+    if (stats.passes == 0 || stats.cyclesPerUs == 0) {
+        LOG_INFO("No loop passes recorded yet");
+        return;
+    }
+
+    uint64_t totalCycles = 0;
+    for (uint8_t i = 0; i < LOOP_SECTION_COUNT; i++) {
+        totalCycles += stats.sectionCycles[i];
+    }
+    unsigned idlePercent = getLoopIdlePercent(stats);
+    LOG_INFO("Passes: %lu over %lu ms, CPU load %u%% (idle %u%%)", (unsigned long)stats.passes,
+             (unsigned long)(totalCycles / stats.cyclesPerUs / 1000), 100 - idlePercent, idlePercent);
+    LOG_INFO("Busy time per pass (us): min %lu avg %lu p99 %lu max %lu",
+             (unsigned long)stats.busyUs.minUs, (unsigned long)(stats.busyUs.totalUs / stats.busyUs.count),
+             (unsigned long)getLatencyPercentileUs(stats.busyUs, 99), (unsigned long)stats.busyUs.maxUs);
+    LOG_INFO("CAN frames per pass: avg %lu.%02lu max %u, capped at %d: %lu passes",
+             (unsigned long)(stats.framesDrained / stats.passes),
+             (unsigned long)((stats.framesDrained * 100 / stats.passes) % 100), stats.maxFramesPerPass,
+             CAN_MAX_FRAMES_PER_LOOP, (unsigned long)stats.cappedPasses);
+    for (uint8_t i = 0; i < LOOP_SECTION_COUNT; i++) {
+        LOG_INFO("  %-8s %3u%%  avg %6lu us/pass  max %6lu us", loopSectionNames[i],
+                 totalCycles > 0 ? (unsigned)((stats.sectionCycles[i] * 100) / totalCycles) : 0,
+                 (unsigned long)(stats.sectionCycles[i] / stats.passes / stats.cyclesPerUs),
+                 (unsigned long)(stats.sectionMaxCycles[i] / stats.cyclesPerUs));
+    }
+}
+
+void printLoopProfileSummary() {
+    LoopProfileStats stats = profile;
+    if (stats.passes == 0 || stats.cyclesPerUs == 0) {
+        LOG_INFO("Loop: no passes");
+        return;
+    }
+    LOG_INFO("Loop: %lu passes, idle %u%%, busy avg %lu p99 %lu max %lu us, frames/pass max %u, capped %lu",
+             (unsigned long)stats.passes, (unsigned)getLoopIdlePercent(stats),
+             (unsigned long)(stats.busyUs.totalUs / stats.busyUs.count),
+             (unsigned long)getLatencyPercentileUs(stats.busyUs, 99), (unsigned long)stats.busyUs.maxUs,
+             stats.maxFramesPerPass, (unsigned long)stats.cappedPasses);
+}
+
+void setLoopProfileStreaming(bool enabled) {
+    streaming = enabled;
+    resetLoopProfile();
+}
+
+bool isLoopProfileStreaming() {
+    return streaming;
+}
+
+void serviceLoopProfileStream(unsigned long now) {
+    (void)now;
+    if (!streaming) {
+        return;
+    }
+    printLoopProfileSummary();
+    resetLoopProfile();
+}
@@ -0,0 +1,64 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <stdint.h>
+#include "config.h"
+#include "latency_tracker.h"
+
+/**
+ * Loop-time and CPU-load profiler
+ *
+ * loop() is split into consecutive sections; each markLoopSection() charges
+ * the CPU cycles since the previous mark to one of them. The idle wait in
+ * waitForLoopEvent() is a section too, so the shares add up to the wall time
+ * of the loop task and the idle share is the headroom left for bursts.
+ *
+ * Per pass the profiler also records the busy time (everything but the idle
+ * wait) in a log2 histogram for min/avg/max/p99 and the number of CAN frames
+ * drained, including how often the CAN_MAX_FRAMES_PER_LOOP cap was hit -
+ * frames left queued for the next pass.
+ *
+ * Cycles come from the CPU cycle counter (ESP.getCycleCount()) of the core
+ * running loop(); the 32-bit counter wraps every ~17 s at 240 MHz, far above
+ * any single section. The native build counts micros() instead.
+ */
+
+#define LOOP_SECTION_IDLE 0         // waitForLoopEvent() sleep
+#define LOOP_SECTION_SERIAL 1       // Serial command input
+#define LOOP_SECTION_CAN 2          // Controller service + queue drain + dispatch
+#define LOOP_SECTION_STATE 3        // checkForStateChanges()
+#define LOOP_SECTION_BUTTON 4       // Button events, double-click, opener requests
+#define LOOP_SECTION_OUTPUTS 5      // Opener timing + output recompute
+#define LOOP_SECTION_JOBS 6         // Periodic jobs (watchdog, heartbeat, ...), recovery, diagnostics
+#define LOOP_SECTION_COUNT 7
+
+struct LoopProfileStats {
+    uint32_t passes;
+    uint32_t cyclesPerUs;                           // Conversion for the figures below
+    uint64_t sectionCycles[LOOP_SECTION_COUNT];
+    uint32_t sectionMaxCycles[LOOP_SECTION_COUNT];  // Longest single run of the section
+    LatencyHistogram busyUs;                        // Per pass, all sections but idle
+    uint64_t framesDrained;
+    uint16_t maxFramesPerPass;
+    uint32_t cappedPasses;                          // Passes that stopped at CAN_MAX_FRAMES_PER_LOOP
+};
+
+// Instrumentation (call from loop() only)
+void beginLoopPass();                               // Start of a pass; opens the idle section
+void markLoopSection(uint8_t section);              // Charge the time since the last mark to section
+void endLoopPass(uint16_t framesDrained);
+
+// Reporting
+LoopProfileStats getLoopProfileStats();
+uint8_t getLoopIdlePercent(const LoopProfileStats& stats);
+const char* getLoopSectionName(uint8_t section);
+void resetLoopProfile();
+void printLoopProfile();                            // Full table (system_info)
+void printLoopProfileSummary();                     // One line (periodic stream)
+
+// Periodic stream: summary every LOOP_PROFILE_STREAM_MS, window reset after each
+void setLoopProfileStreaming(bool enabled);
+bool isLoopProfileStreaming();
+void serviceLoopProfileStream(unsigned long now);  // Loop job body
+
+#endif // LOOP_PROFILER_H
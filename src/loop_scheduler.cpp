@@ -0,0 +1,238 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include "loop_scheduler.h"
+#include <string.h>
+
+#ifndef NATIVE_ENV
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#endif
+
+struct LoopJob {
+    const char* name;
+    LoopJobFunction run;
+    unsigned long periodMs;
+    unsigned long nextDue;
+    uint32_t runs;
+    unsigned long maxLatenessMs;
+};
+
+static LoopJob loopJobs[LOOP_SCHEDULER_MAX_JOBS];
+static uint8_t loopJobCount = 0;
+
+// Wrap-safe "deadline has passed" for millis() timestamps
+static bool isDeadlineReached(unsigned long now, unsigned long deadline) {
+    return (long)(now - deadline) >= 0;
+}
+
+int addLoopJob(const char* name, unsigned long periodMs, LoopJobFunction run, unsigned long now) {
+    if (loopJobCount >= LOOP_SCHEDULER_MAX_JOBS || run == NULL || periodMs == 0) {
+        return -1;
+    }
+
+    LoopJob& job = loopJobs[loopJobCount];
+    job.name = name;
+    job.run = run;
+    job.periodMs = periodMs;
+    job.nextDue = now + periodMs;
+    job.runs = 0;
+    job.maxLatenessMs = 0;
+    return loopJobCount++;
+}
+
+void resetLoopScheduler() {
+    memset(loopJobs, 0, sizeof(loopJobs));
+    loopJobCount = 0;
+}
+
+uint8_t runDueLoopJobs(unsigned long now) {
+    uint8_t jobsRun = 0;
+
+    for (uint8_t i = 0; i < loopJobCount; i++) {
+        LoopJob& job = loopJobs[i];
+        if (!isDeadlineReached(now, job.nextDue)) {
+            continue;
+        }
+
+        unsigned long lateness = now - job.nextDue;
+        if (lateness > job.maxLatenessMs) {
+            job.maxLatenessMs = lateness;
+        }
+
+        // Keep the cadence, but never queue up catch-up runs after a long stall
+        job.nextDue = lateness >= job.periodMs ? now + job.periodMs : job.nextDue + job.periodMs;
+        job.runs++;
+        job.run(now);
+        jobsRun++;
+    }
+
+    return jobsRun;
+}
+
+unsigned long getLoopIdleTime(unsigned long now, unsigned long maxIdleMs) {
+    unsigned long idle = maxIdleMs;
+
+    for (uint8_t i = 0; i < loopJobCount; i++) {
+        if (isDeadlineReached(now, loopJobs[i].nextDue)) {
+            return 0;
+        }
+        unsigned long untilDue = loopJobs[i].nextDue - now;
+        if (untilDue < idle) {
+            idle = untilDue;
+        }
+    }
+
+    return idle;
+}
+
+void triggerLoopJob(int jobId) {
+    if (jobId < 0 || jobId >= loopJobCount) {
+        return;
+    }
+    // Due as of the previous run, so lateness stays meaningful
+    loopJobs[jobId].nextDue -= loopJobs[jobId].periodMs;
+}
+
+bool getLoopJobStats(int jobId, LoopJobStats& stats) {
+    if (jobId < 0 || jobId >= loopJobCount) {
+        return false;
+    }
+
+    const LoopJob& job = loopJobs[jobId];
+    stats.name = job.name;
+    stats.periodMs = job.periodMs;
+    stats.runs = job.runs;
+    stats.maxLatenessMs = job.maxLatenessMs;
+    return true;
+}
+
+uint8_t getLoopJobCount() {
+    return loopJobCount;
+}
+
+#ifndef NATIVE_ENV
+// Event bits and the time the oldest pending event of each type was signalled.
+// Signalled from the CAN receive task and the button ISR, consumed by loop().
+static TaskHandle_t loopTaskHandle = NULL;
+static portMUX_TYPE loopEventLock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t pendingEvents = 0;
+static uint32_t pendingSignalledUs[LOOP_EVENT_COUNT] = {0};
+static LoopLatencyStats latencyStats[LOOP_EVENT_COUNT];
+static uint32_t loopWakeups = 0;
+static uint32_t loopTimeouts = 0;
+
+static const char* const loopEventNames[LOOP_EVENT_COUNT] = {"CAN RX", "Button", "Output pulse"};
+
+void attachLoopSchedulerTask() {
+    loopTaskHandle = xTaskGetCurrentTaskHandle();
+}
+
+// Caller holds loopEventLock
+static void IRAM_ATTR markEventsPending(uint32_t events, uint32_t nowUs) {
+    for (uint8_t i = 0; i < LOOP_EVENT_COUNT; i++) {
+        if ((events & (1u << i)) && !(pendingEvents & (1u << i))) {
+            pendingSignalledUs[i] = nowUs;
+        }
+    }
+    pendingEvents |= events;
+}
+
+void signalLoopEvent(uint32_t events) {
+    uint32_t nowUs = (uint32_t)esp_timer_get_time();
+
+    portENTER_CRITICAL(&loopEventLock);
+    markEventsPending(events, nowUs);
+    portEXIT_CRITICAL(&loopEventLock);
+
+    if (loopTaskHandle != NULL) {
+        xTaskNotifyGive(loopTaskHandle);
+    }
+}
+
+void IRAM_ATTR signalLoopEventFromISR(uint32_t events) {
+    uint32_t nowUs = (uint32_t)esp_timer_get_time();
+
+    portENTER_CRITICAL_ISR(&loopEventLock);
+    markEventsPending(events, nowUs);
+    portEXIT_CRITICAL_ISR(&loopEventLock);
+
+    if (loopTaskHandle != NULL) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(loopTaskHandle, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
+
+LoopWake waitForLoopEvent(unsigned long timeoutMs) {
+    if (timeoutMs > 0 && loopTaskHandle != NULL) {
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs)) > 0) {
+            loopWakeups++;
+        } else {
+            loopTimeouts++;
+        }
+    }
+
+    LoopWake wake;
+    portENTER_CRITICAL(&loopEventLock);
+    wake.events = pendingEvents;
+    memcpy(wake.signalledUs, pendingSignalledUs, sizeof(wake.signalledUs));
+    pendingEvents = 0;
+    portEXIT_CRITICAL(&loopEventLock);
+    return wake;
+}
+
+void recordLoopLatency(const LoopWake& wake) {
+    uint32_t nowUs = (uint32_t)esp_timer_get_time();
+
+    for (uint8_t i = 0; i < LOOP_EVENT_COUNT; i++) {
+        if (!(wake.events & (1u << i))) {
+            continue;
+        }
+
+        LoopLatencyStats& stats = latencyStats[i];
+        uint32_t latency = nowUs - wake.signalledUs[i];
+        stats.events++;
+        stats.lastUs = latency;
+        if (latency > stats.maxUs) {
+            stats.maxUs = latency;
+        }
+        if (latency > LOOP_EVENT_LATENCY_BUDGET_US) {
+            stats.overBudget++;
+        }
+    }
+}
+
+LoopLatencyStats getLoopLatencyStats(uint8_t eventIndex) {
+    LoopLatencyStats stats = {};
+    if (eventIndex < LOOP_EVENT_COUNT) {
+        stats = latencyStats[eventIndex];
+    }
+    return stats;
+}
+
+void resetLoopSchedulerStatistics() {
+    memset(latencyStats, 0, sizeof(latencyStats));
+    loopWakeups = 0;
+    loopTimeouts = 0;
+    for (uint8_t i = 0; i < loopJobCount; i++) {
+        loopJobs[i].runs = 0;
+        loopJobs[i].maxLatenessMs = 0;
+    }
+}
+
+void printLoopSchedulerStatistics() {
+    LOG_INFO("Loop Scheduler:");
+    LOG_INFO("  Wake-ups: %lu by event, %lu by deadline (max idle %d ms)",
+             loopWakeups, loopTimeouts, LOOP_MAX_IDLE_MS);
+    for (uint8_t i = 0; i < LOOP_EVENT_COUNT; i++) {
+        LOG_INFO("  %s -> outputs: %lu events, last %lu us, max %lu us, over %d us: %lu",
+                 loopEventNames[i], latencyStats[i].events, latencyStats[i].lastUs,
+                 latencyStats[i].maxUs, LOOP_EVENT_LATENCY_BUDGET_US, latencyStats[i].overBudget);
+    }
+    for (uint8_t i = 0; i < loopJobCount; i++) {
+        LOG_INFO("  Job %-14s every %lu ms, runs %lu, max late %lu ms",
+                 loopJobs[i].name, loopJobs[i].periodMs, loopJobs[i].runs, loopJobs[i].maxLatenessMs);
+    }
+}
+#endif
@@ -0,0 +1,71 @@
+#ifndef LOOP_SCHEDULER_H
+#define LOOP_SCHEDULER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Deadline scheduler for the application loop
+ *
+ * Periodic jobs (heartbeat, watchdog, output reconcile, ...) register once with
+ * their period. Each pass of loop() runs the jobs whose deadline has passed
+ * and then sleeps until the earliest remaining deadline, unless an event
+ * (a CAN frame queued or a toolbox button event) wakes it first. Between
+ * events the loop is idle instead of spinning every 10 ms.
+ *
+ * Deadlines are compared with wrap-safe unsigned arithmetic, so millis()
+ * rollover is harmless. A job that falls more than one period behind is
+ * rescheduled from the current time rather than run back-to-back.
+ */
+
+// Events that wake the loop before the next deadline
+#define LOOP_EVENT_CAN_RX (1u << 0)     // Frames were added to the receive queue
+#define LOOP_EVENT_BUTTON (1u << 1)     // Button driver queued a debounced event
+#define LOOP_EVENT_OUTPUT (1u << 2)     // The pulse timer ended an output pulse
+#define LOOP_EVENT_COUNT 3
+
+typedef void (*LoopJobFunction)(unsigned long now);
+
+struct LoopJobStats {
+    const char* name;
+    unsigned long periodMs;
+    uint32_t runs;
+    unsigned long maxLatenessMs;    // Worst delay between deadline and actual run
+};
+
+// Wake-up latency for one event type, from signal to the end of the loop pass
+struct LoopLatencyStats {
+    uint32_t events;
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint32_t overBudget;            // Passes exceeding LOOP_EVENT_LATENCY_BUDGET_US
+};
+
+// Result of one sleep: which events fired and when the oldest of each was signalled
+struct LoopWake {
+    uint32_t events;
+    uint32_t signalledUs[LOOP_EVENT_COUNT];
+};
+
+// Job table (pure logic; host-testable)
+int addLoopJob(const char* name, unsigned long periodMs, LoopJobFunction run, unsigned long now);
+void resetLoopScheduler();
+uint8_t runDueLoopJobs(unsigned long now);          // Returns the number of jobs run
+unsigned long getLoopIdleTime(unsigned long now, unsigned long maxIdleMs);
+void triggerLoopJob(int jobId);                     // Make a job due on the next pass
+bool getLoopJobStats(int jobId, LoopJobStats& stats);
+uint8_t getLoopJobCount();
+
+// Event wake-up (firmware only)
+#ifndef NATIVE_ENV
+void attachLoopSchedulerTask();                     // Call from the task that runs loop()
+void signalLoopEvent(uint32_t events);
+void signalLoopEventFromISR(uint32_t events);
+LoopWake waitForLoopEvent(unsigned long timeoutMs);
+void recordLoopLatency(const LoopWake& wake);
+LoopLatencyStats getLoopLatencyStats(uint8_t eventIndex);
+void resetLoopSchedulerStatistics();
+void printLoopSchedulerStatistics();
+#endif
+
+#endif // LOOP_SCHEDULER_H
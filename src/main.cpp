@@ -1,27 +1,38 @@
 #include <Arduino.h>
+#include "esp_system.h"
+#include "esp_timer.h"
 #include "config.h"
 
 // Module includes (will be created in subsequent steps)
 #include "can_manager.h"
+#include "can_dispatch.h"
 #include "gpio_controller.h"
+#include "output_channels.h"
 #include "message_parser.h"
 #include "state_manager.h"
 #include "diagnostic_commands.h"
 #include "logger.h"
+#include "loop_scheduler.h"
+#include "button_driver.h"
+#include "can_recovery.h"
+#include "latency_tracker.h"
+#include "loop_profiler.h"
+#include "telemetry.h"
+#include "flight_recorder.h"
+#include "flight_storage.h"
+#include "sleep_policy.h"
+#include "light_sleep.h"
+#include "boot_state.h"
+#include "signal_history.h"
+#include "memory_budget.h"
 
 // Global variables for application state
 bool systemInitialized = false;
-unsigned long lastHeartbeat = 0;
-unsigned long lastCANStats = 0;
-unsigned long lastOutputUpdate = 0;
-unsigned long lastWatchdog = 0;
-unsigned long lastErrorRecovery = 0;
 
 // Error tracking and recovery
 SystemHealth systemHealth = {0, 0, 0, 0, 0, false, false};
 const unsigned long HEARTBEAT_INTERVAL = 10000; // 10 seconds
 const unsigned long CAN_STATS_INTERVAL = 30000; // 30 seconds
-const unsigned long OUTPUT_UPDATE_INTERVAL = 100; // 100ms for output updates
 const unsigned long WATCHDOG_INTERVAL = 60000; // 60 seconds - system health check
 const unsigned long ERROR_RECOVERY_INTERVAL = 5000; // 5 seconds between recovery attempts
 const unsigned long CRITICAL_ERROR_THRESHOLD = 10; // Max critical errors before system reset
@@ -33,29 +44,38 @@ struct OutputState {
 };
 static OutputState outputState = {false, false};
 
+#if defined(SET_LOOP_TASK_STACK_SIZE)
+// Size the Arduino loop task (state, GPIO and diagnostics) from config.h
+SET_LOOP_TASK_STACK_SIZE(APP_TASK_STACK_SIZE);
+#endif
+
 // Function declarations
-void updateOutputControlLogic();
+void registerLoopJobs(unsigned long now);
+void updateOutputControlLogic(uint8_t changedInputs);
 void performSystemWatchdog();
 void handleErrorRecovery();
 void performSafeSystemShutdown();
 void printSystemInfo();
 
 void setup() {
-    // Initialize serial communication
+    // Fast boot: outputs, CAN and state come first; no serial settle delay,
+    // and the banners are printed once the truck can already be served
     Serial.begin(SERIAL_BAUD_RATE);
-    delay(1000); // Allow serial to stabilize
     
-    LOG_INFO("=== Ford F150 Gen14 CAN Bus Interface ===");
-    LOG_INFO("Project: https://github.com/jantman/ford-f150-gen14-can-bus-interface");
-    LOG_INFO("Firmware Version: %s", FIRMWARE_VERSION);
-    LOG_INFO("Build Date: %s %s", BUILD_DATE, BUILD_TIME);
-    LOG_INFO("Starting initialization...");
+#if ENABLE_DEFERRED_LOGGING
+    // Hand Serial output to the log writer task so LOG_* never blocks the CAN path
+    startDeferredLogTask();
+#endif
+    
+    // Last-known state from RTC memory, if it survived the reset
+    beginBootState((uint8_t)esp_reset_reason());
     
     // Initialize GPIO (Step 2)
     if (!initializeGPIO()) {
         LOG_ERROR("Failed to initialize GPIO pins");
         return;
     }
+    noteBootMilestone(BOOT_MILESTONE_OUTPUTS, (uint32_t)esp_timer_get_time());
     LOG_INFO("GPIO initialization successful");
     
     // Initialize CAN bus (Step 3)
@@ -65,8 +85,28 @@ void setup() {
     }
     LOG_INFO("CAN bus initialization successful");
     
+#if ENABLE_CAN_RX_TASK
+    // Move bus draining off the loop task; fall back to servicing from loop()
+    if (!startCANReceiveTask()) {
+        LOG_WARN("CAN receive task unavailable - receiving from loop()");
+    }
+    vTaskPrioritySet(NULL, APP_TASK_PRIORITY);
+    LOG_INFO("Application logic running on core %d (priority %d)", xPortGetCoreID(), APP_TASK_PRIORITY);
+#endif
+    noteBootMilestone(BOOT_MILESTONE_CAN, (uint32_t)esp_timer_get_time());
+    
     // Initialize state management (Step 5)
     initializeStateManager();
+#if ENABLE_BOOT_STATE_RESTORE
+    VehicleSignals restoredSignals;
+    if (getRestoredVehicleSignals(restoredSignals)) {
+        restoreVehicleSignals(restoredSignals);
+    }
+#endif
+    noteBootMilestone(BOOT_MILESTONE_STATE, (uint32_t)esp_timer_get_time());
+#if ENABLE_SIGNAL_HISTORY
+    resetSignalHistory();
+#endif
     LOG_INFO("State management initialization successful");
     
     systemInitialized = true;
@@ -76,7 +116,37 @@ void setup() {
     systemHealth.lastCanActivity = currentTime;
     systemHealth.lastSystemOK = currentTime;
     
+    // Periodic work runs from the deadline scheduler; events wake loop() in between
+    attachLoopSchedulerTask();
+    registerLoopJobs(currentTime);
+    
+    // Edge interrupt + debounce timer; loop() only consumes the button events
+    if (!startButtonDriver()) {
+        LOG_ERROR("Button driver failed to start - toolbox button disabled");
+    }
+    
+#if ENABLE_FLIGHT_RECORDER
+    // Records are written by their own task; without storage, triggers are refused
+    startFlightStorageTask();
+#endif
+    
+#if ENABLE_TELEMETRY
+    // Optional UDP stream of decoded signals; runs beside loop(), never on the CAN path
+    startTelemetryTask();
+#endif
+    noteBootMilestone(BOOT_MILESTONE_SETUP_DONE, (uint32_t)esp_timer_get_time());
+    
+    LOG_INFO("=== Ford F150 Gen14 CAN Bus Interface ===");
+    LOG_INFO("Project: https://github.com/jantman/ford-f150-gen14-can-bus-interface");
+    LOG_INFO("Firmware Version: %s", FIRMWARE_VERSION);
+    LOG_INFO("Build Date: %s %s", BUILD_DATE, BUILD_TIME);
     LOG_INFO("System initialization complete");
+    printBootStatus();
+    
+    // Every task and arena exists now: take the heap baseline and report the budget
+    registerMemoryTask(xTaskGetCurrentTaskHandle(), "loopTask", APP_TASK_STACK_SIZE, false);
+    lockHeapAllocations();
+    printMemoryBudget(false);
     
     // Print pin configuration for verification
     LOG_INFO("Pin Configuration:");
@@ -86,107 +156,190 @@ void setup() {
     LOG_INFO("  SYSTEM_READY_PIN: %d", SYSTEM_READY_PIN);
 }
 
+// Heartbeat message
+static void runHeartbeatJob(unsigned long now) {
+    (void)now;
+    LOG_DEBUG("Heartbeat - System running, free heap: %d bytes", ESP.getFreeHeap());
+}
+
+// Periodic CAN statistics and diagnostics
+static void runCANStatsJob(unsigned long now) {
+    (void)now;
+    if (isCANConnected()) {
+        LOG_DEBUG("CAN bus status: Connected");
+    } else {
+        LOG_WARN("CAN bus status: Disconnected");
+        // Print detailed diagnostics when disconnected
+        printCANStatistics();
+    }
+}
+
+// Safety net: recompute every output even if no dirty flag was raised
+static void runOutputReconcileJob(unsigned long now) {
+    (void)now;
+    takeOutputInputChanges();
+    updateOutputControlLogic(OUTPUT_INPUT_ALL);
+}
+
+static void runWatchdogJob(unsigned long now) {
+    (void)now;
+    performSystemWatchdog();
+}
+
+static void runErrorRecoveryJob(unsigned long now) {
+    (void)now;
+    handleErrorRecovery();
+}
+
+void registerLoopJobs(unsigned long now) {
+    resetLoopScheduler();
+    addLoopJob("heartbeat", HEARTBEAT_INTERVAL, runHeartbeatJob, now);
+    addLoopJob("can_stats", CAN_STATS_INTERVAL, runCANStatsJob, now);
+    addLoopJob("output_reconcile", OUTPUT_RECONCILE_INTERVAL_MS, runOutputReconcileJob, now);
+    addLoopJob("watchdog", WATCHDOG_INTERVAL, runWatchdogJob, now);
+    addLoopJob("error_recovery", ERROR_RECOVERY_INTERVAL, runErrorRecoveryJob, now);
+    addLoopJob("profile_stream", LOOP_PROFILE_STREAM_MS, serviceLoopProfileStream, now);
+#if ENABLE_FLIGHT_RECORDER
+    addLoopJob("flight_recorder", FLIGHT_RECORDER_SERVICE_MS, serviceFlightRecorder, now);
+#endif
+}
+
+// How long loop() may sleep before it has to look at something again
+static unsigned long computeLoopIdleTime(unsigned long now, bool framesPending) {
+    if (framesPending) {
+        return 0;
+    }
+    
+    unsigned long idle = getLoopIdleTime(now, LOOP_MAX_IDLE_MS);
+    
+    // Wake when a source goes stale or times out so readiness changes are applied on time
+    idle = getStateFreshnessIdleTime(idle);
+    
+    // Next step of a running CAN recovery or background diagnostic
+    idle = getCANRecoveryIdleTime(now, idle);
+    idle = getDiagnosticIdleTime(now, idle);
+    
+    // A held-back button event needs a prompt next pass
+    if (isButtonActivityPending() && idle > BUTTON_ACTIVE_POLL_MS) {
+        idle = BUTTON_ACTIVE_POLL_MS;
+    }
+    
+    // Pulses end on their own timer; without it, wake exactly at the next pulse end
+    idle = getOutputChannelIdleTime(now, idle);
+    return idle;
+}
+
+#if ENABLE_LIGHT_SLEEP
+// Light sleep in place of the idle wait when the truck is parked, locked and quiet
+static bool tryLightSleep(unsigned long now, unsigned long idleMs, bool framesPending) {
+    SleepConditions conditions;
+    conditions.signals = getVehicleSignals();
+    conditions.busQuietMs = now - systemHealth.lastCanActivity;
+    conditions.idleMs = idleMs;
+    // The relay supply is cut by the sleep itself
+    conditions.outputsActive = !areOutputChannelsIdle(now, 1UL << OUTPUT_CHANNEL_SYSTEM_READY);
+    conditions.busy = framesPending || isButtonActivityPending() || isButtonHeld() ||
+                      isCANRecoveryActive() || hasOutputInputChanges();
+#if ENABLE_FLIGHT_RECORDER
+    conditions.busy = conditions.busy || getFlightRecorderStats().state != FLIGHT_RECORDER_RECORDING;
+#endif
+    
+    uint8_t blocker = getSleepBlocker(conditions);
+    noteSleepBlocker(blocker);
+    if (blocker != SLEEP_BLOCK_NONE) {
+        return false;
+    }
+    return enterLightSleep(idleMs < LIGHT_SLEEP_MAX_MS ? idleMs : LIGHT_SLEEP_MAX_MS);
+}
+#endif
+
 void loop() {
     if (!systemInitialized) {
         delay(100);
         return;
     }
     
+    // Sleep until a frame is queued, the button changes, or the next deadline
+    static bool framesPending = false;
+    beginLoopPass();
+    unsigned long idleMs = computeLoopIdleTime(millis(), framesPending);
+#if ENABLE_LIGHT_SLEEP
+    if (tryLightSleep(millis(), idleMs, framesPending)) {
+        idleMs = 0; // Whatever woke the chip is handled on this pass
+    }
+#endif
+    LoopWake wake = waitForLoopEvent(idleMs);
+    markLoopSection(LOOP_SECTION_IDLE);
+    
     // Process serial diagnostic commands
     processSerialCommands();
+    markLoopSection(LOOP_SECTION_SERIAL);
     
-    // Heartbeat message
     unsigned long currentTime = millis();
-    if (currentTime - lastHeartbeat >= HEARTBEAT_INTERVAL) {
-        LOG_DEBUG("Heartbeat - System running, free heap: %d bytes", ESP.getFreeHeap());
-        lastHeartbeat = currentTime;
-    }
-    
-    // Periodic CAN statistics and diagnostics
-    if (currentTime - lastCANStats >= CAN_STATS_INTERVAL) {
-        if (isCANConnected()) {
-            LOG_DEBUG("CAN bus status: Connected");
-        } else {
-            LOG_WARN("CAN bus status: Disconnected");
-            // Print detailed diagnostics when disconnected
-            printCANStatistics();
-            
-            // Enable debug message monitoring when having connection issues
-            LOG_INFO("=== DEBUG: Attempting to receive ANY CAN messages ===");
-            debugReceiveAllMessages();
-        }
-        lastCANStats = currentTime;
-    }
+    unsigned int messagesProcessed = 0;
     
     // Process CAN messages with error handling (Step 3-4, enhanced in Step 8)
     try {
-        // Check for message loss (MCP2515 buffer overflow monitoring)
-        checkMessageLoss();
+        // Move any frames waiting in the controller into the software queue
+        // (the receive task does this on its own core when it is running)
+#if ENABLE_CAN_RX_TASK
+        if (!isCANReceiveTaskRunning()) {
+            serviceCANReceive();
+        }
+#else
+        serviceCANReceive();
+#endif
         
         // Parse received target messages (Step 4)
-        CANMessage message;
-        unsigned int messagesProcessed = 0;
-        const unsigned int MAX_MESSAGES_PER_LOOP = 10; // Prevent loop blocking
+        // Frames are taken in runs where they lie in the receive queue and the
+        // software filter picks the ones to dispatch with one bitmap pass. Each
+        // frame is released once handled (also when a parser throws, so a bad
+        // frame cannot wedge the queue)
+        struct QueuedFrameRelease {
+            uint16_t count = 0;
+            ~QueuedFrameRelease() { releaseCANMessages(count); }
+        };
+        const CANMessage* batch;
         
-        while (receiveCANMessage(message) && messagesProcessed < MAX_MESSAGES_PER_LOOP) {
-            messagesProcessed++;
+        while (messagesProcessed < CAN_MAX_FRAMES_PER_LOOP) {
+            // Cap each run at the loop limit so a frame is never taken and then discarded
+            unsigned int room = CAN_MAX_FRAMES_PER_LOOP - messagesProcessed;
+            uint16_t batchSize = peekCANMessages(&batch, room < CAN_SOFTWARE_FILTER_BATCH ? room : CAN_SOFTWARE_FILTER_BATCH);
+            if (batchSize == 0) {
+                break;
+            }
+            QueuedFrameRelease release;
+            uint32_t decode = selectCANFramesToDecode(batch, (uint8_t)batchSize);
             systemHealth.lastCanActivity = currentTime;
+            noteFrameAfterWake((uint32_t)micros());
+            noteBootMilestone(BOOT_MILESTONE_FIRST_FRAME, batch[0].arrivalUs);
             
-            if (isTargetCANMessage(message.id)) {
-                // Log raw CAN message frame data at debug level for target messages
-                logCANMessage("RX", message.id, message.data, message.length);
-                
-                bool parseSuccess = false;
-                // Parse the message based on its ID
-                switch (message.id) {
-                    case BCM_LAMP_STAT_FD1_ID: {
-                        BCMLampStatus lampStatus;
-                        if (parseBCMLampStatus(message, lampStatus)) {
-                            updateBCMLampState(lampStatus);
-                            LOG_DEBUG("BCM Lamp Status updated: PudLamp=%d", lampStatus.pudLampRequest);
-                            parseSuccess = true;
-                        }
-                        break;
-                    }
-                    case LOCKING_SYSTEMS_2_FD1_ID: {
-                        LockingSystemsStatus lockStatus;
-                        if (parseLockingSystemsStatus(message, lockStatus)) {
-                            updateLockingSystemsState(lockStatus);
-                            LOG_DEBUG("Lock Status updated: VehLock=%d", lockStatus.vehicleLockStatus);
-                            parseSuccess = true;
-                        }
-                        break;
-                    }
-                    case POWERTRAIN_DATA_10_ID: {
-                        PowertrainData powertrainData;
-                        if (parsePowertrainData(message, powertrainData)) {
-                            updatePowertrainState(powertrainData);
-                            LOG_DEBUG("Powertrain Data updated: ParkStatus=%d", powertrainData.transmissionParkStatus);
-                            parseSuccess = true;
-                        }
-                        break;
-                    }
-                    case BATTERY_MGMT_3_FD1_ID: {
-                        BatteryManagement batteryData;
-                        if (parseBatteryManagement(message, batteryData)) {
-                            updateBatteryState(batteryData);
-                            LOG_DEBUG("Battery Data updated: SOC=%d%%", batteryData.batterySOC);
-                            parseSuccess = true;
-                        }
-                        break;
-                    }
+            for (uint16_t i = 0; i < batchSize; i++) {
+                const CANMessage& message = batch[i];
+                release.count++;
+                messagesProcessed++;
+                if (isCANDebugActive()) {
+                    observeCANDebugFrame(message);
+                }
+#if ENABLE_FLIGHT_RECORDER
+                recordFlightFrame(message);
+#endif
+                if (!(decode & (1u << i))) {
+                    skipCANMessage(message);
+                    continue;
                 }
                 
-                // Track parsing errors
-                if (!parseSuccess) {
+                // One table lookup routes the frame to its parser + state updater
+                if (dispatchCANMessage(message) == CAN_DISPATCH_PARSE_ERROR) {
                     systemHealth.parseErrors++;
                     LOG_WARN("Failed to parse CAN message ID 0x%03X", message.id);
                 }
             }
         }
         
-        // If we hit the message limit, log it
-        if (messagesProcessed >= MAX_MESSAGES_PER_LOOP) {
+        // If we hit the message limit, log it (remaining frames stay queued)
+        framesPending = messagesProcessed >= CAN_MAX_FRAMES_PER_LOOP;
+        if (framesPending) {
             LOG_DEBUG("Message processing limit reached (%d messages), continuing next loop", messagesProcessed);
         }
         
@@ -195,9 +348,11 @@ void loop() {
         systemHealth.criticalErrors++;
         LOG_ERROR("Critical error in CAN message processing (count: %lu)", systemHealth.criticalErrors);
     }
+    markLoopSection(LOOP_SECTION_CAN);
     
     // Update state management (Step 5)
     checkForStateChanges();
+    markLoopSection(LOOP_SECTION_STATE);
     
     // Handle button input (Step 6) 
     updateButtonState();
@@ -224,6 +379,9 @@ void loop() {
             setToolboxOpener(true);
         } else {
             LOG_WARN("Toolbox activation requested - button held for %dms but conditions not met (not ready/parked/unlocked)", BUTTON_HOLD_THRESHOLD_MS);
+#if ENABLE_FLIGHT_RECORDER
+            triggerFlightRecorder(FLIGHT_TRIGGER_TOOLBOX_DENIED, millis());
+#endif
         }
     }
     
@@ -233,83 +391,89 @@ void loop() {
     if (isButtonHeld() && (getButtonHoldDuration() % 5000) == 0) {
         LOG_DEBUG("Button held for %lu ms", getButtonHoldDuration());
     }
+    markLoopSection(LOOP_SECTION_BUTTON);
     
-    // Update GPIO timing (toolbox opener auto-shutoff)
-    updateToolboxOpenerTiming();
+    // End expired output pulses, or mirror the ones the pulse timer ended
+    serviceOutputChannels(millis());
     
-    // Update outputs based on vehicle state (Step 7)
-    updateOutputControlLogic();
+    // Recompute outputs the moment one of their inputs changed (Step 7)
+    uint8_t changedInputs = takeOutputInputChanges();
+    if (changedInputs != 0) {
+        updateOutputControlLogic(changedInputs);
+    }
+    markLoopSection(LOOP_SECTION_OUTPUTS);
     
-    // System watchdog and error recovery (Step 8)
-    performSystemWatchdog();
-    handleErrorRecovery();
+    // Heartbeat, statistics, output reconcile, watchdog and recovery (Step 8)
+    runDueLoopJobs(currentTime);
+    serviceCANRecovery(currentTime);
+    serviceDiagnosticJobs(currentTime);
     
     // Update system health
-    if (isCANConnected() && getCurrentState().systemReady) {
+    if (isCANConnected() && isSystemReady()) {
         systemHealth.lastSystemOK = currentTime;
     }
     
-    // Small delay to prevent overwhelming the CPU
-    delay(10);
+    // Keep the RTC copy current so a reset can resume from it
+    retainBootState(getVehicleSignals(), systemHealth, currentTime);
+#if ENABLE_SIGNAL_HISTORY
+    recordSignalHistory(vehicleSignalsWord(getVehicleSignals()), currentTime);
+#endif
+    
+    recordLoopLatency(wake);
+    markLoopSection(LOOP_SECTION_JOBS);
+    endLoopPass(messagesProcessed);
 }
 
-// Output Control Logic (Step 7) - Update all GPIO outputs based on vehicle state
-void updateOutputControlLogic() {
+// Output Control Logic (Step 7) - Update the GPIO outputs fed by the changed inputs
+// (OUTPUT_INPUT_* from the state manager; OUTPUT_INPUT_ALL recomputes everything)
+void updateOutputControlLogic(uint8_t changedInputs) {
     if (!systemInitialized) {
         return;
     }
     
     unsigned long currentTime = millis();
     
-    // Throttle output updates to avoid excessive GPIO operations
-    if (currentTime - lastOutputUpdate < OUTPUT_UPDATE_INTERVAL) {
-        return;
-    }
-    lastOutputUpdate = currentTime;
-    
-    // Get current vehicle state
-    VehicleState vehicleState = getCurrentState();
+    // Get current vehicle flags (one word from the published state)
+    uint32_t vehicleFlags = getVehicleStateFlags();
+    bool systemReady = (vehicleFlags & VEHICLE_FLAG_SYSTEM_READY) != 0;
+    bool manualOverride = (vehicleFlags & VEHICLE_FLAG_MANUAL_OVERRIDE) != 0;
     
     // Store previous output states for change detection
     outputState.prevBedlightActive = outputState.bedlightActive;
     
     // === Bed Light Control Logic ===
-    // Control bedlight based on manual override or PudLamp_D_Rq signal from BCM_Lamp_Stat_FD1
-    if (vehicleState.systemReady) {
-        if (isBedlightManuallyOverridden()) {
-            // Manual override mode - use manual state
-            outputState.bedlightActive = vehicleState.bedlightManualState;
-        } else {
-            // Automatic mode - use CAN signal
-            outputState.bedlightActive = vehicleState.bedlightShouldBeOn;
-        }
-    } else {
-        // If system not ready, turn off bedlight for safety
-        outputState.bedlightActive = false;
-    }
+    // Manual override state or PudLamp_D_Rq from BCM_Lamp_Stat_FD1; off for
+    // safety while the system is not ready (readiness gates the bed light, so
+    // every input change re-evaluates it)
+    outputState.bedlightActive = decideBedlightOutput(vehicleFlags);
     
     // === Apply GPIO Changes (only if state changed to minimize GPIO operations) ===
+    // Bedlight and system-ready changes from one recompute land in one register write
+    beginGPIOBatch();
     
     // Update bedlight if state changed
     if (outputState.bedlightActive != outputState.prevBedlightActive) {
         setBedlight(outputState.bedlightActive);
-        if (isBedlightManuallyOverridden()) {
+        if (manualOverride) {
             LOG_INFO("Bedlight %s (Manual Override)", 
                      outputState.bedlightActive ? "ON" : "OFF");
         } else {
             LOG_INFO("Bedlight %s (PudLamp state: %d)", 
                      outputState.bedlightActive ? "ON" : "OFF", 
-                     vehicleState.pudLampRequest);
+                     getVehicleSignals().pudLampRequest);
         }
     }
     
     // === System Ready Indicator Control Logic ===
     // Control system ready indicator (GPIO18) based on overall system readiness
-    setSystemReady(vehicleState.systemReady);
+    if (changedInputs & OUTPUT_INPUT_SYSTEM_READY) {
+        setSystemReady(systemReady);
+    }
+    markOutputsCommitted(commitGPIOBatch());   // Closes the frame-to-GPIO latency sample
     
     // === Toolbox Opener Logic ===
     // Toolbox opener is handled by button press events in the main loop
-    // The timing shutoff is handled by updateToolboxOpenerTiming()
+    // The timing shutoff is handled by the pulse timer or serviceOutputChannels()
     // No additional logic needed here as it's event-driven
     
     // Periodic status logging (every 30 seconds when outputs are active)
@@ -318,7 +482,7 @@ void updateOutputControlLogic() {
         if (outputState.bedlightActive) {
             LOG_DEBUG("Output Status: Bedlight=%s, System=%s",
                       outputState.bedlightActive ? "ON" : "OFF",
-                      vehicleState.systemReady ? "READY" : "NOT_READY");
+                      systemReady ? "READY" : "NOT_READY");
         }
         lastStatusLog = currentTime;
     }
@@ -328,12 +492,6 @@ void updateOutputControlLogic() {
 void performSystemWatchdog() {
     unsigned long currentTime = millis();
     
-    // Only run watchdog check at specified intervals
-    if (currentTime - lastWatchdog < WATCHDOG_INTERVAL) {
-        return;
-    }
-    lastWatchdog = currentTime;
-    
     bool systemHealthy = true;
     
     // Check 1: CAN activity timeout
@@ -354,10 +512,9 @@ void performSystemWatchdog() {
         systemHealthy = false;
     }
     
-    // Check 4: Memory health
+    // Check 4: Memory health - free heap floor, growth since setup(), static allocation violations
     uint32_t freeHeap = ESP.getFreeHeap();
-    if (freeHeap < 10000) { // Less than 10KB free
-        LOG_ERROR("Watchdog: Low memory warning (%lu bytes free)", freeHeap);
+    if (!checkHeapBudget()) {
         systemHealthy = false;
     }
     
@@ -375,6 +532,9 @@ void performSystemWatchdog() {
         LOG_ERROR("  Last CAN Activity: %lu ms ago", currentTime - systemHealth.lastCanActivity);
         LOG_ERROR("  Last System OK: %lu ms ago", currentTime - systemHealth.lastSystemOK);
         LOG_ERROR("  Free Heap: %lu bytes", freeHeap);
+#if ENABLE_FLIGHT_RECORDER
+        triggerFlightRecorder(FLIGHT_TRIGGER_WATCHDOG, currentTime);
+#endif
         
     } else if (systemHealthy && systemHealth.watchdogTriggered) {
         // System recovered
@@ -397,30 +557,18 @@ void handleErrorRecovery() {
         return; // Only run recovery when needed
     }
     
-    unsigned long currentTime = millis();
-    
-    // Throttle recovery attempts
-    if (currentTime - lastErrorRecovery < ERROR_RECOVERY_INTERVAL) {
-        return;
-    }
-    lastErrorRecovery = currentTime;
-    
     LOG_INFO("Attempting system recovery...");
     
-    // Recovery Step 1: Restart CAN bus if needed
-    if (!isCANConnected()) {
-        LOG_INFO("Recovery: Performing full CAN system recovery...");
-        if (recoverCANSystem()) {
-            LOG_INFO("Recovery: CAN system recovered successfully");
-            systemHealth.canErrors = 0; // Reset CAN error count
-        } else {
-            LOG_ERROR("Recovery: CAN system recovery failed");
-        }
+    // Recovery Step 1: Restart CAN bus if needed. The recovery runs in steps from
+    // loop(); Step 4 clears the error counters once the bus is connected again.
+    if (!isCANConnected() && startCANSystemRecovery()) {
+        LOG_INFO("Recovery: Full CAN system recovery started");
     }
     
     // Recovery Step 2: Reset state timeouts
     LOG_INFO("Recovery: Resetting state timeouts...");
     resetStateTimeouts();
+    invalidateCANPayloadCache(); // Re-parse the next frame of every message
     
     // Recovery Step 3: Reset GPIO if needed
     GPIOState gpioState = getGPIOState();
@@ -454,15 +602,20 @@ void handleErrorRecovery() {
 void performSafeSystemShutdown() {
     LOG_ERROR("=== PERFORMING SAFE SYSTEM SHUTDOWN ===");
     
-    // Turn off all outputs for safety
+    // Turn off all outputs for safety, in a single write
+    beginGPIOBatch();
     setBedlight(false);
     setToolboxOpener(false);
     setSystemReady(false);
+    commitGPIOBatch();
     
     // Log final system state
     LOG_ERROR("All outputs disabled for safety");
     LOG_ERROR("System entering minimal operation mode");
     LOG_ERROR("Manual reset required to restore full functionality");
+#if ENABLE_DEFERRED_LOGGING
+    flushDeferredLog();
+#endif
     
     // Set system to minimal operation mode
     systemInitialized = false;
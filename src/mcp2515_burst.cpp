@@ -0,0 +1,91 @@
+#define LOG_MODULE_ID LOG_MODULE_CAN
+#include "mcp2515_burst.h"
+
+// SIDL bits
+#define MCP2515_SIDL_IDE 0x08       // Extended identifier
+#define MCP2515_SIDL_SRR 0x10       // Standard remote frame
+// DLC register bits
+#define MCP2515_DLC_RTR 0x40        // Extended remote frame
+#define MCP2515_DLC_MASK 0x0F
+
+// Wire cost per transaction: instruction, address (READ only), then data
+#define LIBRARY_STATUS_BYTES 3u     // READ CANINTF
+#define BURST_STATUS_BYTES 4u       // READ CANINTF, EFLG
+#define LIBRARY_FRAME_BYTES 16u     // READ SIDH..DLC (7) + READ CTRL (3) + READ data (2) + BIT MODIFY (4)
+#define LIBRARY_FRAME_TRANSACTIONS 4u
+#define BURST_FRAME_BYTES (1u + MCP2515_RX_HEADER_BYTES)
+
+bool decodeMCP2515RxHeader(const uint8_t header[MCP2515_RX_HEADER_BYTES], CANFrame& frame) {
+    uint8_t sidh = header[0];
+    uint8_t sidl = header[1];
+    uint8_t dlc = header[4];
+
+    uint32_t id = ((uint32_t)sidh << 3) | (sidl >> 5);
+    bool remote;
+    if (sidl & MCP2515_SIDL_IDE) {
+        id = (id << 18) | ((uint32_t)(sidl & 0x03) << 16) | ((uint32_t)header[2] << 8) | header[3];
+        id |= MCP2515_ID_EXTENDED_FLAG;
+        remote = (dlc & MCP2515_DLC_RTR) != 0;
+    } else {
+        remote = (sidl & MCP2515_SIDL_SRR) != 0;
+    }
+    if (remote) {
+        id |= MCP2515_ID_REMOTE_FLAG;
+    }
+
+    frame.id = id;
+    frame.length = dlc & MCP2515_DLC_MASK;
+    return frame.length <= 8;
+}
+
+void noteMCP2515StatusRead(MCP2515SpiStats& stats, bool burst) {
+    stats.drainPasses++;
+    stats.transactions++;
+    stats.bytes += burst ? BURST_STATUS_BYTES : LIBRARY_STATUS_BYTES;
+    stats.libraryTransactions++;
+    stats.libraryBytes += LIBRARY_STATUS_BYTES;
+}
+
+void noteMCP2515FrameRead(MCP2515SpiStats& stats, const CANFrame& frame, bool burst) {
+    stats.frames++;
+    stats.transactions += burst ? 1 : LIBRARY_FRAME_TRANSACTIONS;
+    stats.bytes += (burst ? BURST_FRAME_BYTES : LIBRARY_FRAME_BYTES) + frame.length;
+    stats.libraryTransactions += LIBRARY_FRAME_TRANSACTIONS;
+    stats.libraryBytes += LIBRARY_FRAME_BYTES + frame.length;
+}
+
+#if ENABLE_MCP2515_BURST_READ && !defined(NATIVE_ENV)
+
+#include <Arduino.h>
+#include <SPI.h>
+
+static const SPISettings mcp2515SpiSettings(CAN_SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0);
+
+void readMCP2515Registers(uint8_t address, uint8_t* values, uint8_t count) {
+    SPI.beginTransaction(mcp2515SpiSettings);
+    digitalWrite(CAN_CS_PIN, LOW);
+    SPI.transfer(MCP2515_INSTRUCTION_READ);
+    SPI.transfer(address);
+    SPI.transfer(values, count);
+    digitalWrite(CAN_CS_PIN, HIGH);
+    SPI.endTransaction();
+}
+
+bool readMCP2515RxBuffer(uint8_t buffer, CANFrame& frame) {
+    uint8_t header[MCP2515_RX_HEADER_BYTES];
+
+    // The DLC arrives before the data, so the burst stops after exactly DLC bytes
+    SPI.beginTransaction(mcp2515SpiSettings);
+    digitalWrite(CAN_CS_PIN, LOW);
+    SPI.transfer(buffer == 0 ? MCP2515_INSTRUCTION_READ_RX0 : MCP2515_INSTRUCTION_READ_RX1);
+    SPI.transfer(header, MCP2515_RX_HEADER_BYTES);
+    bool valid = decodeMCP2515RxHeader(header, frame);
+    if (valid && frame.length > 0) {
+        SPI.transfer(frame.data, frame.length);
+    }
+    digitalWrite(CAN_CS_PIN, HIGH);     // Clears RXnIF, also for a frame with a bad DLC
+    SPI.endTransaction();
+    return valid;
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef MCP2515_BURST_H
+#define MCP2515_BURST_H
+
+#include <stdint.h>
+#include "config.h"
+#include "can_protocol.h"
+
+/**
+ * MCP2515 burst receive path (ENABLE_MCP2515_BURST_READ)
+ *
+ * The library's readMessage() costs four chip selects per standard frame:
+ * READ of SIDH..DLC, READ of RXBnCTRL, READ of the data bytes and a BIT
+ * MODIFY to clear RXnIF, 16 + DLC bytes on the wire; the drain adds a READ of
+ * CANINTF per pass. The burst path uses the MCP2515's own shortcuts instead:
+ * - READ RX BUFFER (0x90 / 0x94) starts at RXBnSIDH with no address byte,
+ *   streams the 5 header bytes and then exactly DLC data bytes, and clears
+ *   RXnIF when CS rises: 6 + DLC bytes, one chip select
+ * - CANINTF (0x2C) and EFLG (0x2D) are neighbours, so one READ per pass gives
+ *   the receive flags and the overflow flags together
+ *
+ * The header decoding and the byte accounting are pure and host-tested; the
+ * SPI transactions are firmware only.
+ */
+
+#define MCP2515_INSTRUCTION_READ 0x03
+#define MCP2515_INSTRUCTION_READ_RX0 0x90       // READ RX BUFFER, RXB0 from SIDH
+#define MCP2515_INSTRUCTION_READ_RX1 0x94       // READ RX BUFFER, RXB1 from SIDH
+#define MCP2515_REG_TEC 0x1C                    // REC follows at 0x1D
+#define MCP2515_REG_CANINTF 0x2C                // EFLG follows at 0x2D
+#define MCP2515_RX_HEADER_BYTES 5               // SIDH, SIDL, EID8, EID0, DLC
+
+// Same bits as the library's CAN_EFF_FLAG / CAN_RTR_FLAG in can_frame::can_id
+#define MCP2515_ID_EXTENDED_FLAG 0x80000000UL
+#define MCP2515_ID_REMOTE_FLAG 0x40000000UL
+
+// Fills id and length from a receive buffer header; false when DLC exceeds 8
+bool decodeMCP2515RxHeader(const uint8_t header[MCP2515_RX_HEADER_BYTES], CANFrame& frame);
+
+// SPI traffic of the receive path, with what the library path would have cost
+struct MCP2515SpiStats {
+    uint32_t frames;
+    uint32_t drainPasses;               // Status reads
+    uint32_t bytes;
+    uint32_t transactions;              // Chip selects
+    uint32_t libraryBytes;              // Same frames and passes through readMessage()
+    uint32_t libraryTransactions;
+};
+
+// burst: the traffic went through this file's path rather than the library's
+void noteMCP2515StatusRead(MCP2515SpiStats& stats, bool burst);
+void noteMCP2515FrameRead(MCP2515SpiStats& stats, const CANFrame& frame, bool burst);
+
+#if ENABLE_MCP2515_BURST_READ && !defined(NATIVE_ENV)
+// Caller holds the controller lock; CS is CAN_CS_PIN on the shared SPI bus
+void readMCP2515Registers(uint8_t address, uint8_t* values, uint8_t count);
+bool readMCP2515RxBuffer(uint8_t buffer, CANFrame& frame);   // buffer 0 or 1; false on a bad DLC
+#endif
+
+#endif // MCP2515_BURST_H
@@ -0,0 +1,259 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include "memory_budget.h"
+#include "can_manager.h"
+#include "can_id_stats.h"
+#include "flight_recorder.h"
+#include "signal_history.h"
+#include "logger.h"
+
+#ifndef NATIVE_ENV
+#include <Arduino.h>
+#include <new>
+#include <stdlib.h>
+#include "esp_heap_caps.h"
+#include "deferred_log.h"
+#include "telemetry_protocol.h"
+#endif
+
+static void addArena(MemoryArena* arenas, uint8_t maxArenas, uint8_t& count,
+                     const char* name, uint32_t staticBytes, uint32_t peakBytes) {
+    if (count < maxArenas) {
+        arenas[count].name = name;
+        arenas[count].staticBytes = staticBytes;
+        arenas[count].peakBytes = peakBytes < staticBytes ? peakBytes : staticBytes;
+        count++;
+    }
+}
+
+uint8_t collectMemoryArenas(MemoryArena* arenas, uint8_t maxArenas) {
+    uint8_t count = 0;
+
+#ifndef NATIVE_ENV
+    CANQueueStats queue = getCANQueueStats();
+    addArena(arenas, maxArenas, count, "CAN RX queue",
+             (uint32_t)queue.capacity * sizeof(CANMessage), (uint32_t)queue.highWaterMark * sizeof(CANMessage));
+#if ENABLE_DEFERRED_LOGGING
+    addArena(arenas, maxArenas, count, "Log queue",
+             DEFERRED_LOG_QUEUE_SIZE * sizeof(DeferredLogRecord),
+             (uint32_t)getDeferredLogHighWaterMark() * sizeof(DeferredLogRecord));
+#endif
+#endif
+
+#if ENABLE_FLIGHT_RECORDER
+    FlightRecorderStats flight = getFlightRecorderStats();
+    uint32_t flightFrames = flight.framesRecorded < FLIGHT_RECORDER_FRAMES ? flight.framesRecorded : FLIGHT_RECORDER_FRAMES;
+    addArena(arenas, maxArenas, count, "Flight recorder",
+             FLIGHT_RECORDER_FRAMES * sizeof(FlightFrame), flightFrames * sizeof(FlightFrame));
+#ifndef NATIVE_ENV
+    addArena(arenas, maxArenas, count, "Flight write block", FLIGHT_RECORDER_WRITE_BLOCK, FLIGHT_RECORDER_WRITE_BLOCK);
+#endif
+#endif
+
+    // Slot array plus its in-use flags
+    const uint32_t idSlotBytes = sizeof(CANIdStats) + sizeof(bool);
+    addArena(arenas, maxArenas, count, "CAN ID table",
+             getCANIdStatsCapacity() * idSlotBytes, getCANIdStatsSummary().trackedIds * idSlotBytes);
+
+#if ENABLE_SIGNAL_HISTORY
+    addArena(arenas, maxArenas, count, "Signal history", getSignalHistoryStorageBytes(), getSignalHistoryBytesInUse());
+#endif
+
+#if ENABLE_TELEMETRY && !defined(NATIVE_ENV)
+    addArena(arenas, maxArenas, count, "Telemetry datagram", TELEMETRY_DATAGRAM_MAX_BYTES, TELEMETRY_DATAGRAM_MAX_BYTES);
+#endif
+    return count;
+}
+
+uint32_t getMemoryArenaTotal(const MemoryArena* arenas, uint8_t count) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        total += arenas[i].staticBytes;
+    }
+    return total;
+}
+
+#ifndef NATIVE_ENV
+
+struct MemoryTask {
+    TaskHandle_t handle;
+    const char* name;
+    uint32_t stackBytes;
+    bool heapAllowed;
+    uint32_t newCalls;              // After lockHeapAllocations()
+};
+
+// Written during setup() only; read-only once the heap is locked
+static MemoryTask memoryTasks[MEMORY_TASK_MAX];
+static uint8_t memoryTaskCount = 0;
+
+static volatile bool heapLocked = false;
+static uint32_t freeAtLock = 0;
+static uint32_t blocksAtLock = 0;
+static uint32_t newCalls = 0;
+static uint32_t newBytes = 0;
+static uint32_t violations = 0;
+static uint32_t violationsReported = 0;
+static uint32_t lastBlockWarning = 0;
+
+void registerMemoryTask(TaskHandle_t handle, const char* name, uint32_t stackBytes, bool heapAllowed) {
+    if (handle == NULL || memoryTaskCount >= MEMORY_TASK_MAX) {
+        return;
+    }
+    memoryTasks[memoryTaskCount++] = {handle, name, stackBytes, heapAllowed, 0};
+}
+
+void lockHeapAllocations() {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+    freeAtLock = info.total_free_bytes;
+    blocksAtLock = info.allocated_blocks;
+    lastBlockWarning = blocksAtLock;
+    heapLocked = true;
+}
+
+HeapBudgetStats getHeapBudgetStats() {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+
+    HeapBudgetStats stats;
+    stats.locked = heapLocked;
+    stats.freeAtLock = freeAtLock;
+    stats.blocksAtLock = blocksAtLock;
+    stats.freeBytes = info.total_free_bytes;
+    stats.minFreeBytes = info.minimum_free_bytes;
+    stats.largestFreeBlock = info.largest_free_block;
+    stats.allocatedBlocks = info.allocated_blocks;
+    stats.newCalls = __atomic_load_n(&newCalls, __ATOMIC_RELAXED);
+    stats.newBytes = __atomic_load_n(&newBytes, __ATOMIC_RELAXED);
+    stats.violations = __atomic_load_n(&violations, __ATOMIC_RELAXED);
+    return stats;
+}
+
+bool checkHeapBudget() {
+    HeapBudgetStats stats = getHeapBudgetStats();
+    bool healthy = true;
+
+    if (stats.freeBytes < MEMORY_HEAP_LOW_BYTES) {
+        LOG_ERROR("Watchdog: Low memory warning (%lu bytes free)", (unsigned long)stats.freeBytes);
+        healthy = false;
+    }
+    if (!stats.locked) {
+        return healthy;
+    }
+
+    // Warn once per further MEMORY_HEAP_BLOCK_SLACK blocks, so a slow leak keeps reporting
+    if (stats.allocatedBlocks >= lastBlockWarning + MEMORY_HEAP_BLOCK_SLACK ||
+        stats.freeBytes + MEMORY_HEAP_SLACK_BYTES < stats.freeAtLock) {
+        if (stats.allocatedBlocks > lastBlockWarning) {
+            lastBlockWarning = stats.allocatedBlocks;
+        }
+        LOG_WARN("Heap grew since setup: %lu blocks (+%ld), %lu bytes free (%ld) - see 'mem'",
+                 (unsigned long)stats.allocatedBlocks, (long)(stats.allocatedBlocks - stats.blocksAtLock),
+                 (unsigned long)stats.freeBytes, (long)stats.freeBytes - (long)stats.freeAtLock);
+    }
+
+    if (stats.violations != violationsReported) {
+        LOG_ERROR("Static allocation mode: %lu heap allocations on tasks that may not allocate - see 'mem'",
+                  (unsigned long)(stats.violations - violationsReported));
+        violationsReported = stats.violations;
+        healthy = false;
+    }
+    return healthy;
+}
+
+void printMemoryBudget(bool withTasks) {
+    MemoryArena arenas[MEMORY_ARENA_MAX];
+    uint8_t count = collectMemoryArenas(arenas, MEMORY_ARENA_MAX);
+    uint32_t peakTotal = 0;
+
+    LOG_INFO("Static arenas (%lu bytes):", (unsigned long)getMemoryArenaTotal(arenas, count));
+    for (uint8_t i = 0; i < count; i++) {
+        LOG_INFO("  %-20s %6lu bytes, peak %6lu (%lu%%)", arenas[i].name, (unsigned long)arenas[i].staticBytes,
+                 (unsigned long)arenas[i].peakBytes,
+                 arenas[i].staticBytes > 0 ? (unsigned long)((uint64_t)arenas[i].peakBytes * 100 / arenas[i].staticBytes) : 0UL);
+        peakTotal += arenas[i].peakBytes;
+    }
+    LOG_INFO("  %-20s %6lu bytes in use at peak", "Total", (unsigned long)peakTotal);
+
+    HeapBudgetStats heap = getHeapBudgetStats();
+    LOG_INFO("Heap: %lu bytes free (min %lu since boot, largest block %lu), %lu blocks allocated",
+             (unsigned long)heap.freeBytes, (unsigned long)heap.minFreeBytes,
+             (unsigned long)heap.largestFreeBlock, (unsigned long)heap.allocatedBlocks);
+    if (heap.locked) {
+        LOG_INFO("  Since setup(): %+ld blocks, %+ld bytes free", (long)(heap.allocatedBlocks - heap.blocksAtLock),
+                 (long)heap.freeBytes - (long)heap.freeAtLock);
+    }
+#if ENABLE_STATIC_ALLOCATION_MODE
+    LOG_INFO("  Static allocation mode: %lu C++ allocations after setup() (%lu bytes), %lu violations",
+             (unsigned long)heap.newCalls, (unsigned long)heap.newBytes, (unsigned long)heap.violations);
+#endif
+
+    if (!withTasks) {
+        return;
+    }
+    LOG_INFO("Task stacks (high-water mark = least ever free):");
+    for (uint8_t i = 0; i < memoryTaskCount; i++) {
+        const MemoryTask& task = memoryTasks[i];
+        uint32_t freeBytes = uxTaskGetStackHighWaterMark(task.handle);
+        uint32_t usedBytes = task.stackBytes > freeBytes ? task.stackBytes - freeBytes : 0;
+#if ENABLE_STATIC_ALLOCATION_MODE
+        LOG_INFO("  %-12s %5lu of %5lu bytes used, %5lu never touched, heap %s (%lu allocations)", task.name,
+                 (unsigned long)usedBytes, (unsigned long)task.stackBytes, (unsigned long)freeBytes,
+                 task.heapAllowed ? "allowed" : "forbidden",
+                 (unsigned long)__atomic_load_n(&task.newCalls, __ATOMIC_RELAXED));
+#else
+        LOG_INFO("  %-12s %5lu of %5lu bytes used, %5lu never touched", task.name,
+                 (unsigned long)usedBytes, (unsigned long)task.stackBytes, (unsigned long)freeBytes);
+#endif
+    }
+}
+
+#if ENABLE_STATIC_ALLOCATION_MODE
+// Replacement global operator new: plain malloc(), counted once setup() is done.
+// No logging here - checkHeapBudget() reports from the watchdog.
+static void noteHeapAllocation(size_t size) {
+    if (!heapLocked) {
+        return;
+    }
+    __atomic_fetch_add(&newCalls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&newBytes, (uint32_t)size, __ATOMIC_RELAXED);
+
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < memoryTaskCount; i++) {
+        if (memoryTasks[i].handle == current) {
+            __atomic_fetch_add(&memoryTasks[i].newCalls, 1, __ATOMIC_RELAXED);
+            if (!memoryTasks[i].heapAllowed) {
+                __atomic_fetch_add(&violations, 1, __ATOMIC_RELAXED);
+#if STATIC_ALLOCATION_ABORT
+                abort();
+#endif
+            }
+            return;
+        }
+    }
+}
+
+void* operator new(size_t size) {
+    noteHeapAllocation(size);
+    void* block = malloc(size != 0 ? size : 1);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    noteHeapAllocation(size);
+    return malloc(size != 0 ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+#endif // ENABLE_STATIC_ALLOCATION_MODE
+
+#endif // !NATIVE_ENV
@@ -0,0 +1,66 @@
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <stdint.h>
+#include "config.h"
+
+#ifndef NATIVE_ENV
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+/**
+ * Memory budget: static arenas, heap use after setup() and task stacks
+ *
+ * The receive queue, log queue, flight recorder ring, per-ID table and signal
+ * history are statically sized. collectMemoryArenas() lists them with the
+ * bytes they reserve and the deepest use seen: the high-water mark for
+ * queues, and what holds data for rings and tables, which only fill up.
+ *
+ * lockHeapAllocations() at the end of setup() takes a heap baseline: free
+ * bytes and allocated blocks. checkHeapBudget() (the watchdog) compares the
+ * heap with it, so a leak or a growing buffer shows up as block growth long
+ * before the heap runs out. With ENABLE_STATIC_ALLOCATION_MODE every C++ new
+ * after that point is counted against the task that made it; a task
+ * registered without heapAllowed may not allocate at all, and with
+ * STATIC_ALLOCATION_ABORT its first allocation aborts so the backtrace names
+ * the caller. malloc() from C code is only seen through the block count.
+ *
+ * Tasks register with registerMemoryTask() once created; 'mem' prints their
+ * stack high-water marks. Tasks that delete themselves do not register.
+ */
+
+#define MEMORY_ARENA_MAX 8
+
+struct MemoryArena {
+    const char* name;
+    uint32_t staticBytes;           // Reserved at build time
+    uint32_t peakBytes;             // Deepest use seen (queues) or bytes holding data (rings, tables)
+};
+
+// Fills up to maxArenas entries; returns how many
+uint8_t collectMemoryArenas(MemoryArena* arenas, uint8_t maxArenas);
+uint32_t getMemoryArenaTotal(const MemoryArena* arenas, uint8_t count);   // Sum of staticBytes
+
+struct HeapBudgetStats {
+    bool locked;                    // lockHeapAllocations() has run
+    uint32_t freeAtLock;
+    uint32_t blocksAtLock;
+    uint32_t freeBytes;
+    uint32_t minFreeBytes;          // Since boot
+    uint32_t largestFreeBlock;
+    uint32_t allocatedBlocks;
+    uint32_t newCalls;              // C++ allocations after setup (ENABLE_STATIC_ALLOCATION_MODE)
+    uint32_t newBytes;
+    uint32_t violations;            // ...made on a task without heapAllowed
+};
+
+#ifndef NATIVE_ENV
+void registerMemoryTask(TaskHandle_t handle, const char* name, uint32_t stackBytes, bool heapAllowed);
+void lockHeapAllocations();
+HeapBudgetStats getHeapBudgetStats();
+bool checkHeapBudget();             // false when the heap is below its floor or a violation was counted
+void printMemoryBudget(bool withTasks);
+#endif
+
+#endif // MEMORY_BUDGET_H
@@ -1,17 +1,32 @@
+#define LOG_MODULE_ID LOG_MODULE_PARSER
 #include "message_parser.h"
+#include "dbc_signals.h"
+
+// Signal positions come from the constexpr descriptors in dbc_signals.h, generated
+// from minimal.dbc by tools/generate_can_signals.py. Each payload is loaded once
+// and every decodeSignal<>() resolves to a constant shift and mask.
+
+// The filter/dispatch IDs in config.h must agree with the DBC
+static_assert(dbc::BCM_Lamp_Stat_FD1::ID == BCM_LAMP_STAT_FD1_ID, "BCM_LAMP_STAT_FD1_ID does not match DBC");
+static_assert(dbc::Locking_Systems_2_FD1::ID == LOCKING_SYSTEMS_2_FD1_ID, "LOCKING_SYSTEMS_2_FD1_ID does not match DBC");
+static_assert(dbc::PowertrainData_10::ID == POWERTRAIN_DATA_10_ID, "POWERTRAIN_DATA_10_ID does not match DBC");
+static_assert(dbc::Battery_Mgmt_3_FD1::ID == BATTERY_MGMT_3_FD1_ID, "BATTERY_MGMT_3_FD1_ID does not match DBC");
 
 // Parse BCM_Lamp_Stat_FD1 message (ID: 963, 8 bytes)
-// Signals: PudLamp_D_Rq (bits 11-12), Illuminated_Entry_Stat (bits 63-64), Dr_Courtesy_Light_Stat (bits 49-50)
+// Signals: PudLamp_D_Rq (bits 10-11), Illuminated_Entry_Stat (bits 62-63), Dr_Courtesy_Light_Stat (bits 48-49)
 bool parseBCMLampStatus(const CANMessage& message, BCMLampStatus& status) {
-    if (message.id != BCM_LAMP_STAT_FD1_ID || message.length != 8) {
+    using namespace dbc::BCM_Lamp_Stat_FD1;
+    
+    if (message.id != ID || message.length != LENGTH) {
         LOG_WARN("Invalid BCM_Lamp_Stat_FD1 message: ID=0x%03X, Length=%d", message.id, message.length);
+        status.valid = false;
         return false;
     }
     
-    // Extract signals according to real CAN data analysis (FINAL CORRECTED bit positions)
-    status.pudLampRequest = extractBits(message.data, 11, 2);           // Bits 10-11, 2 bits (start_bit=11, length=2 per Python)
-    status.illuminatedEntryStatus = extractBits(message.data, 63, 2);   // Bits 62-63, 2 bits (start_bit=63, length=2 per Python)
-    status.drCourtesyLightStatus = extractBits(message.data, 49, 2);    // Bits 48-49, 2 bits (start_bit=49, length=2 per Python)
+    uint64_t payload = loadCANPayload(message.data);
+    status.pudLampRequest = decodeSignal<PudLamp_D_Rq>(payload);
+    status.illuminatedEntryStatus = decodeSignal<Illuminated_Entry_Stat>(payload);
+    status.drCourtesyLightStatus = decodeSignal<Dr_Courtesy_Light_Stat>(payload);
     
     status.valid = true;
     status.timestamp = message.timestamp;
@@ -25,13 +40,16 @@ bool parseBCMLampStatus(const CANMessage& message, BCMLampStatus& status) {
 // Parse Locking_Systems_2_FD1 message (ID: 817, 8 bytes)
 // Signal: Veh_Lock_Status (bits 33-34)
 bool parseLockingSystemsStatus(const CANMessage& message, LockingSystemsStatus& status) {
-    if (message.id != LOCKING_SYSTEMS_2_FD1_ID || message.length != 8) {
+    using namespace dbc::Locking_Systems_2_FD1;
+    
+    if (message.id != ID || message.length != LENGTH) {
         LOG_WARN("Invalid Locking_Systems_2_FD1 message: ID=0x%03X, Length=%d", message.id, message.length);
+        status.valid = false;
         return false;
     }
     
-    // Extract vehicle lock status signal (corrected bit position based on real CAN data analysis)
-    status.vehicleLockStatus = extractBits(message.data, 34, 2);  // Bits 33-34 (original working position)
+    uint64_t payload = loadCANPayload(message.data);
+    status.vehicleLockStatus = decodeSignal<Veh_Lock_Status>(payload);
     
     status.valid = true;
     status.timestamp = message.timestamp;
@@ -42,15 +60,18 @@ bool parseLockingSystemsStatus(const CANMessage& message, LockingSystemsStatus&
 }
 
 // Parse PowertrainData_10 message (ID: 374, 8 bytes)
-// Signal: TrnPrkSys_D_Actl (bits 31-34)
+// Signal: TrnPrkSys_D_Actl (bits 28-31)
 bool parsePowertrainData(const CANMessage& message, PowertrainData& data) {
-    if (message.id != POWERTRAIN_DATA_10_ID || message.length != 8) {
+    using namespace dbc::PowertrainData_10;
+    
+    if (message.id != ID || message.length != LENGTH) {
         LOG_WARN("Invalid PowertrainData_10 message: ID=0x%03X, Length=%d", message.id, message.length);
+        data.valid = false;
         return false;
     }
     
-    // Extract transmission park system status (corrected bit position based on test analysis)
-    data.transmissionParkStatus = extractBits(message.data, 31, 4);  // Bits 28-31, 4 bits (start_bit=31, length=4 per Python)
+    uint64_t payload = loadCANPayload(message.data);
+    data.transmissionParkStatus = decodeSignal<TrnPrkSys_D_Actl>(payload);
     
     data.valid = true;
     data.timestamp = message.timestamp;
@@ -61,15 +82,18 @@ bool parsePowertrainData(const CANMessage& message, PowertrainData& data) {
 }
 
 // Parse Battery_Mgmt_3_FD1 message (ID: 1084, 8 bytes)
-// Signal: BSBattSOC (bits 22-28)
+// Signal: BSBattSOC (bits 16-22)
 bool parseBatteryManagement(const CANMessage& message, BatteryManagement& data) {
-    if (message.id != BATTERY_MGMT_3_FD1_ID || message.length != 8) {
+    using namespace dbc::Battery_Mgmt_3_FD1;
+    
+    if (message.id != ID || message.length != LENGTH) {
         LOG_WARN("Invalid Battery_Mgmt_3_FD1 message: ID=0x%03X, Length=%d", message.id, message.length);
+        data.valid = false;
         return false;
     }
     
-    // Extract battery state of charge (FINAL CORRECTED bit position - VALIDATED)
-    data.batterySOC = extractBits(message.data, 22, 7);  // Bits 16-22, 7 bits (start_bit=22, length=7 per Python)
+    uint64_t payload = loadCANPayload(message.data);
+    data.batterySOC = decodeSignal<BSBattSOC>(payload);
     
     data.valid = true;
     data.timestamp = message.timestamp;
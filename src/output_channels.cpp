@@ -0,0 +1,499 @@
+#define LOG_MODULE_ID LOG_MODULE_GPIO
+#include "output_channels.h"
+#include <atomic>
+#include <string.h>
+#include "logger.h"
+#include "loop_scheduler.h"
+
+#if ENABLE_OUTPUT_PULSE_TIMER && !defined(NATIVE_ENV)
+#define OUTPUT_PULSE_TIMER_ACTIVE 1
+#else
+#define OUTPUT_PULSE_TIMER_ACTIVE 0
+#endif
+
+#if OUTPUT_PULSE_TIMER_ACTIVE
+#include <esp_timer.h>
+#endif
+
+static_assert(OUTPUT_CHANNEL_MAX <= 32, "Pulse bookkeeping uses one bit per channel");
+
+#define OUTPUT_NO_PULSE_DUE 0xFFFFFFFFUL
+
+static const OutputChannelConfig* channels = nullptr;
+static uint8_t channelCount = 0;
+static ArduinoInterface* hardware = nullptr;
+static OutputChannelState states[OUTPUT_CHANNEL_MAX];
+
+// Running pulses, one bit per channel. Whoever clears a channel's bit (the
+// timer callback or loop()) owns ending that pulse, so it ends exactly once.
+static std::atomic<uint32_t> pulseArmedMask(0);
+static std::atomic<uint32_t> pulseEndedMask(0);     // Ended by the timer, not yet mirrored
+static unsigned long pulseStartMs[OUTPUT_CHANNEL_MAX];
+
+// LEDC fades: the running ramp per channel and duty changes waiting for it to end
+static unsigned long fadeStartMs[OUTPUT_CHANNEL_MAX];
+static uint16_t fadeLengthMs[OUTPUT_CHANNEL_MAX];
+static uint16_t deferredFadeMs[OUTPUT_CHANNEL_MAX];
+static uint32_t deferredDutyMask = 0;
+
+// Level/pulse changes collect here and are applied with one writeOutputs() call
+static uint8_t outputBatchDepth = 0;
+static uint32_t pendingSetMask = 0;
+static uint32_t pendingClearMask = 0;
+
+#if OUTPUT_PULSE_TIMER_ACTIVE
+static esp_timer_handle_t pulseTimer = nullptr;
+static std::atomic<bool> pulseTimerFired(false);
+#endif
+
+static const char* getModeName(uint8_t mode) {
+    switch (mode) {
+        case OUTPUT_MODE_LEVEL: return "level";
+        case OUTPUT_MODE_PULSE: return "pulse";
+        case OUTPUT_MODE_PWM: return "pwm";
+        default: return "?";
+    }
+}
+
+static uint16_t getFullDuty(const OutputChannelConfig& config) {
+    return (uint16_t)((1UL << config.pwmResolutionBits) - 1);
+}
+
+static bool flushPendingOutputs() {
+    if (pendingSetMask || pendingClearMask) {
+        hardware->writeOutputs(pendingSetMask, pendingClearMask);
+        pendingSetMask = 0;
+        pendingClearMask = 0;
+        return true;
+    }
+    return false;
+}
+
+// Queue one output level; written now unless a batch is open
+static void writeOutputPin(uint8_t pin, bool high) {
+    uint32_t bit = 1UL << pin;
+    if (high) {
+        pendingSetMask |= bit;
+        pendingClearMask &= ~bit;
+    } else {
+        pendingClearMask |= bit;
+        pendingSetMask &= ~bit;
+    }
+    if (outputBatchDepth == 0) {
+        flushPendingOutputs();
+    }
+}
+
+static bool isPulseExpired(uint8_t channel, unsigned long now) {
+    return now - pulseStartMs[channel] >= channels[channel].pulseMs;
+}
+
+// Milliseconds until the earliest running pulse ends (0 when one is overdue)
+static unsigned long getNextPulseWait(unsigned long now) {
+    unsigned long wait = OUTPUT_NO_PULSE_DUE;
+    uint32_t armed = pulseArmedMask.load(std::memory_order_acquire);
+    for (uint8_t channel = 0; channel < channelCount; channel++) {
+        if (!(armed & (1UL << channel))) {
+            continue;
+        }
+        unsigned long elapsed = now - pulseStartMs[channel];
+        unsigned long remaining = elapsed >= channels[channel].pulseMs ? 0 : channels[channel].pulseMs - elapsed;
+        if (remaining < wait) {
+            wait = remaining;
+        }
+    }
+    return wait;
+}
+
+static void finishPulse(uint8_t channel) {
+    states[channel].active = false;
+    states[channel].duty = 0;
+    states[channel].activatedMs = 0;
+}
+
+#if OUTPUT_PULSE_TIMER_ACTIVE
+// Runs in the esp_timer task when the earliest pulse is due
+static void onPulseTimer(void* arg) {
+    (void)arg;
+    unsigned long now = hardware->millis();
+    uint32_t armed = pulseArmedMask.load(std::memory_order_acquire);
+    uint32_t clearMask = 0;
+    uint32_t ended = 0;
+    for (uint8_t channel = 0; channel < channelCount; channel++) {
+        uint32_t bit = 1UL << channel;
+        if ((armed & bit) && isPulseExpired(channel, now) &&
+            (pulseArmedMask.fetch_and(~bit, std::memory_order_acq_rel) & bit)) {
+            clearMask |= 1UL << channels[channel].pin;
+            ended |= bit;
+        }
+    }
+    // Direct clear: W1TC touches only these pins, so it cannot race loop() writes
+    if (clearMask) {
+        hardware->writeOutputs(0, clearMask);
+    }
+    pulseEndedMask.fetch_or(ended, std::memory_order_release);
+
+    // loop() owns arming: it mirrors the ended pulses and arms for the next one
+    pulseTimerFired.store(true, std::memory_order_release);
+    signalLoopEvent(LOOP_EVENT_OUTPUT);
+}
+
+static void createPulseTimer() {
+    if (pulseTimer) {
+        return;
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = onPulseTimer;
+    args.arg = nullptr;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "output_pulse";
+    if (esp_timer_create(&args, &pulseTimer) != ESP_OK) {
+        pulseTimer = nullptr;
+        LOG_WARN("Output pulse timer unavailable - falling back to loop deadlines");
+    }
+}
+#endif
+
+bool isOutputPulseTimerActive() {
+#if OUTPUT_PULSE_TIMER_ACTIVE
+    return pulseTimer != nullptr;
+#else
+    return false;
+#endif
+}
+
+// Only loop() calls this, so the timer never has two arming writers
+static void armPulseTimer(unsigned long now) {
+#if OUTPUT_PULSE_TIMER_ACTIVE
+    if (!pulseTimer) {
+        return;
+    }
+    esp_timer_stop(pulseTimer);
+    unsigned long wait = getNextPulseWait(now);
+    if (wait != OUTPUT_NO_PULSE_DUE) {
+        esp_timer_start_once(pulseTimer, wait > 0 ? (uint64_t)wait * 1000ULL : 1ULL);
+    }
+#else
+    (void)now;
+#endif
+}
+
+bool initializeOutputChannels(const OutputChannelConfig* table, uint8_t count, ArduinoInterface* hw) {
+    if (table == nullptr || hw == nullptr || count > OUTPUT_CHANNEL_MAX) {
+        LOG_ERROR("Output channel table invalid (%d rows, at most %d)", count, OUTPUT_CHANNEL_MAX);
+        return false;
+    }
+    for (uint8_t channel = 0; channel < count; channel++) {
+        const OutputChannelConfig& config = table[channel];
+        bool valid = config.mode == OUTPUT_MODE_PWM
+                         ? config.pwmResolutionBits >= 1 && config.pwmResolutionBits <= 16 && config.pwmFrequencyHz > 0
+                         : config.pin < 32 && (config.mode == OUTPUT_MODE_LEVEL ||
+                                               (config.mode == OUTPUT_MODE_PULSE && config.pulseMs > 0));
+        if (!valid) {
+            LOG_ERROR("Output channel %s (pin %d, %s) is misconfigured", config.name, config.pin,
+                      getModeName(config.mode));
+            return false;
+        }
+    }
+
+#if OUTPUT_PULSE_TIMER_ACTIVE
+    if (pulseTimer) {
+        esp_timer_stop(pulseTimer);
+    }
+    pulseTimerFired.store(false, std::memory_order_relaxed);
+#endif
+    channels = table;
+    channelCount = count;
+    hardware = hw;
+    pulseArmedMask.store(0, std::memory_order_relaxed);
+    pulseEndedMask.store(0, std::memory_order_relaxed);
+    memset(states, 0, sizeof(states));
+    memset(pulseStartMs, 0, sizeof(pulseStartMs));
+    memset(fadeStartMs, 0, sizeof(fadeStartMs));
+    memset(fadeLengthMs, 0, sizeof(fadeLengthMs));
+    memset(deferredFadeMs, 0, sizeof(deferredFadeMs));
+    deferredDutyMask = 0;
+    outputBatchDepth = 0;
+    pendingSetMask = 0;
+    pendingClearMask = 0;
+
+    // All level/pulse outputs off in one write, PWM outputs at zero duty
+    uint32_t outputMask = 0;
+    for (uint8_t channel = 0; channel < count; channel++) {
+        const OutputChannelConfig& config = table[channel];
+        if (config.mode == OUTPUT_MODE_PWM) {
+            if (!hw->setupPWM(config.pin, config.pwmChannel, config.pwmFrequencyHz, config.pwmResolutionBits)) {
+                LOG_WARN("Output channel %s: LEDC setup failed", config.name);
+            }
+            hw->writePWM(config.pwmChannel, 0);
+        } else {
+            hw->pinMode(config.pin, OUTPUT);
+            outputMask |= 1UL << config.pin;
+        }
+    }
+    hw->writeOutputs(0, outputMask);
+
+#if OUTPUT_PULSE_TIMER_ACTIVE
+    createPulseTimer();
+#endif
+
+    for (uint8_t channel = 0; channel < count; channel++) {
+        const OutputChannelConfig& config = table[channel];
+        if (config.mode == OUTPUT_MODE_PULSE) {
+            LOG_INFO("  %s (pin %d): pulse %d ms, initial state: LOW", config.name, config.pin, config.pulseMs);
+        } else if (config.mode == OUTPUT_MODE_PWM) {
+            LOG_INFO("  %s (pin %d): PWM on LEDC %d, %d Hz, %d bit, fade %d/%d ms, initial duty: 0", config.name,
+                     config.pin, config.pwmChannel, config.pwmFrequencyHz, config.pwmResolutionBits, config.fadeInMs,
+                     config.fadeOutMs);
+        } else {
+            LOG_INFO("  %s (pin %d): OUTPUT, initial state: LOW", config.name, config.pin);
+        }
+    }
+    return true;
+}
+
+uint8_t getOutputChannelCount() {
+    return channelCount;
+}
+
+const OutputChannelConfig* getOutputChannelConfig(uint8_t channel) {
+    return channel < channelCount ? &channels[channel] : nullptr;
+}
+
+int findOutputChannel(const char* name) {
+    for (uint8_t channel = 0; channel < channelCount; channel++) {
+        if (strcmp(channels[channel].name, name) == 0) {
+            return channel;
+        }
+    }
+    return -1;
+}
+
+static bool startPulse(uint8_t channel, unsigned long now) {
+    const OutputChannelConfig& config = channels[channel];
+    states[channel].active = true;
+    states[channel].duty = 1;
+    states[channel].activatedMs = now;
+    pulseStartMs[channel] = now;
+    writeOutputPin(config.pin, true);
+    pulseArmedMask.fetch_or(1UL << channel, std::memory_order_release);
+    armPulseTimer(now);
+    LOG_INFO("Output %s: pulse for %d ms", config.name, config.pulseMs);
+    return true;
+}
+
+static bool cancelPulse(uint8_t channel, unsigned long now) {
+    const OutputChannelConfig& config = channels[channel];
+    uint32_t bit = 1UL << channel;
+    if (pulseArmedMask.fetch_and(~bit, std::memory_order_acq_rel) & bit) {
+        writeOutputPin(config.pin, false);
+    } else {
+        pulseEndedMask.fetch_and(~bit, std::memory_order_acq_rel);   // The timer got there first
+    }
+    finishPulse(channel);
+    armPulseTimer(now);
+    LOG_INFO("Output %s: pulse ended early", config.name);
+    return true;
+}
+
+bool setOutputChannel(uint8_t channel, bool on) {
+    if (channel >= channelCount) {
+        return false;
+    }
+    const OutputChannelConfig& config = channels[channel];
+    if (config.mode == OUTPUT_MODE_PWM) {
+        return setOutputChannelDuty(channel, on ? getFullDuty(config) : 0, on ? config.fadeInMs : config.fadeOutMs);
+    }
+
+    unsigned long now = hardware->millis();
+    if (config.mode == OUTPUT_MODE_PULSE) {
+        // A pulse that already ended must not block a new activation
+        serviceOutputChannels(now);
+        if (on && !states[channel].active) {
+            return startPulse(channel, now);
+        }
+        if (!on && states[channel].active) {
+            return cancelPulse(channel, now);
+        }
+        return false;
+    }
+
+    if (states[channel].active == on) {
+        return false;
+    }
+    states[channel].active = on;
+    states[channel].duty = on ? 1 : 0;
+    writeOutputPin(config.pin, on);
+    LOG_INFO("Output %s: %s", config.name, on ? "ON" : "OFF");
+    return true;
+}
+
+static bool isFadeRunning(uint8_t channel, unsigned long now) {
+    return fadeLengthMs[channel] > 0 && now - fadeStartMs[channel] < fadeLengthMs[channel];
+}
+
+// Hands the duty to LEDC: a hardware ramp when asked for and available, else a plain write
+static void writeChannelDuty(uint8_t channel, uint16_t duty, uint16_t fadeMs, unsigned long now) {
+    const OutputChannelConfig& config = channels[channel];
+    fadeLengthMs[channel] = 0;
+    if (fadeMs > 0 && hardware->fadePWM(config.pwmChannel, duty, fadeMs)) {
+        fadeStartMs[channel] = now;
+        fadeLengthMs[channel] = fadeMs;
+        return;
+    }
+    hardware->writePWM(config.pwmChannel, duty);
+}
+
+bool setOutputChannelDuty(uint8_t channel, uint16_t duty, uint16_t fadeMs) {
+    if (channel >= channelCount || channels[channel].mode != OUTPUT_MODE_PWM) {
+        return false;
+    }
+    const OutputChannelConfig& config = channels[channel];
+    uint16_t fullDuty = getFullDuty(config);
+    if (duty > fullDuty) {
+        duty = fullDuty;
+    }
+    if (states[channel].duty == duty) {
+        return false;
+    }
+
+    bool wasActive = states[channel].active;
+    states[channel].duty = duty;
+    states[channel].active = duty > 0;
+
+    unsigned long now = hardware->millis();
+    if (isFadeRunning(channel, now)) {
+        // Started by serviceOutputChannels() once the running ramp is done
+        deferredDutyMask |= 1UL << channel;
+        deferredFadeMs[channel] = fadeMs;
+    } else {
+        deferredDutyMask &= ~(1UL << channel);
+        writeChannelDuty(channel, duty, fadeMs, now);
+    }
+
+    if (states[channel].active != wasActive) {
+        LOG_INFO("Output %s: %s%s", config.name, duty > 0 ? "ON" : "OFF", fadeMs > 0 ? " (fading)" : "");
+    } else {
+        LOG_DEBUG("Output %s: duty %d/%d", config.name, duty, fullDuty);
+    }
+    return true;
+}
+
+OutputChannelState getOutputChannelState(uint8_t channel) {
+    if (channel >= channelCount) {
+        OutputChannelState idle = {false, 0, 0};
+        return idle;
+    }
+    return states[channel];
+}
+
+bool isOutputChannelActive(uint8_t channel) {
+    return channel < channelCount && states[channel].active;
+}
+
+bool areOutputChannelsIdle(unsigned long now, uint32_t ignoreMask) {
+    if (((deferredDutyMask | pulseArmedMask.load(std::memory_order_acquire)) & ~ignoreMask) != 0) {
+        return false;
+    }
+    for (uint8_t channel = 0; channel < channelCount; channel++) {
+        if (ignoreMask & (1UL << channel)) {
+            continue;
+        }
+        if (states[channel].active || isFadeRunning(channel, now)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void serviceOutputChannels(unsigned long now) {
+    for (uint8_t channel = 0; deferredDutyMask != 0 && channel < channelCount; channel++) {
+        uint32_t bit = 1UL << channel;
+        if ((deferredDutyMask & bit) && !isFadeRunning(channel, now)) {
+            deferredDutyMask &= ~bit;
+            writeChannelDuty(channel, states[channel].duty, deferredFadeMs[channel], now);
+        }
+    }
+
+    uint32_t ended = pulseEndedMask.exchange(0, std::memory_order_acquire);
+    for (uint8_t channel = 0; ended != 0 && channel < channelCount; channel++) {
+        if (ended & (1UL << channel)) {
+            LOG_INFO("Output %s: pulse ended by timer after %lu ms", channels[channel].name,
+                     (unsigned long)(now - states[channel].activatedMs));
+            finishPulse(channel);
+        }
+    }
+
+#if OUTPUT_PULSE_TIMER_ACTIVE
+    if (pulseTimer) {
+        if (pulseTimerFired.exchange(false, std::memory_order_acq_rel)) {
+            armPulseTimer(now);
+        }
+        return;
+    }
+#endif
+
+    uint32_t armed = pulseArmedMask.load(std::memory_order_acquire);
+    for (uint8_t channel = 0; armed != 0 && channel < channelCount; channel++) {
+        uint32_t bit = 1UL << channel;
+        if ((armed & bit) && isPulseExpired(channel, now) &&
+            (pulseArmedMask.fetch_and(~bit, std::memory_order_acq_rel) & bit)) {
+            writeOutputPin(channels[channel].pin, false);
+            LOG_INFO("Output %s: pulse ended after %lu ms", channels[channel].name,
+                     (unsigned long)(now - pulseStartMs[channel]));
+            finishPulse(channel);
+        }
+    }
+}
+
+unsigned long getOutputChannelIdleTime(unsigned long now, unsigned long maxIdleMs) {
+    // Deferred duty changes start when their channel's ramp ends
+    unsigned long wait = maxIdleMs;
+    for (uint8_t channel = 0; deferredDutyMask != 0 && channel < channelCount; channel++) {
+        if (deferredDutyMask & (1UL << channel)) {
+            unsigned long elapsed = now - fadeStartMs[channel];
+            unsigned long remaining = elapsed < fadeLengthMs[channel] ? fadeLengthMs[channel] - elapsed : 0;
+            wait = remaining < wait ? remaining : wait;
+        }
+    }
+
+    // The timer wakes loop() itself when a pulse ends
+    if (!isOutputPulseTimerActive()) {
+        unsigned long pulseWait = getNextPulseWait(now);
+        wait = pulseWait < wait ? pulseWait : wait;
+    }
+    return wait;
+}
+
+void beginOutputBatch() {
+    outputBatchDepth++;
+}
+
+bool commitOutputBatch() {
+    if (outputBatchDepth > 0 && --outputBatchDepth == 0) {
+        return flushPendingOutputs();
+    }
+    return false;
+}
+
+void printOutputChannelStatus() {
+    unsigned long now = hardware ? hardware->millis() : 0;
+    LOG_INFO("=== OUTPUT CHANNELS (%d, pulses ended by %s) ===", channelCount,
+             isOutputPulseTimerActive() ? "timer" : "loop deadline");
+    for (uint8_t channel = 0; channel < channelCount; channel++) {
+        const OutputChannelConfig& config = channels[channel];
+        const OutputChannelState& state = states[channel];
+        if (config.mode == OUTPUT_MODE_PWM) {
+            LOG_INFO("  %-16s pin %2d pwm    duty %d/%d%s", config.name, config.pin, state.duty, getFullDuty(config),
+                     isFadeRunning(channel, now) ? " (fading)" : "");
+        } else if (config.mode == OUTPUT_MODE_PULSE && state.active) {
+            unsigned long elapsed = now - state.activatedMs;
+            LOG_INFO("  %-16s pin %2d pulse  ON, %lu ms left", config.name, config.pin,
+                     (unsigned long)(elapsed < config.pulseMs ? config.pulseMs - elapsed : 0));
+        } else {
+            LOG_INFO("  %-16s pin %2d %-6s %s", config.name, config.pin, getModeName(config.mode),
+                     state.active ? "ON" : "OFF");
+        }
+    }
+}
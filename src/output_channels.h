@@ -0,0 +1,87 @@
+#ifndef OUTPUT_CHANNELS_H
+#define OUTPUT_CHANNELS_H
+
+#include <stdint.h>
+#include "config.h"
+#include "arduino_interface.h"
+
+/**
+ * Table-driven output channels
+ *
+ * Every output is one OutputChannelConfig row: a name, a pin and a mode.
+ * - LEVEL: the pin follows setOutputChannel()
+ * - PULSE: setOutputChannel(true) energizes the pin for pulseMs, then it
+ *   drops on its own; setOutputChannel(false) ends the pulse early
+ * - PWM: an LEDC channel; setOutputChannelDuty() sets the duty and
+ *   setOutputChannel() switches between off and full duty, ramping over
+ *   fadeInMs / fadeOutMs when they are set
+ *
+ * Ramps run in the LEDC fade engine: loop() starts one and returns, with no
+ * CPU work per step. The LEDC driver holds a channel until its fade has
+ * finished, so a duty change requested mid-fade is kept and started when the
+ * running fade ends (serviceOutputChannels(); getOutputChannelIdleTime()
+ * wakes loop() for it) instead of blocking the loop.
+ *
+ * Level and pulse pins must be GPIO 0-31: their changes are written with
+ * writeOutputs(), so changes made between beginOutputBatch() and
+ * commitOutputBatch() land in one register write. PWM duty is written
+ * immediately.
+ *
+ * All pulse channels share one timer service. With ENABLE_OUTPUT_PULSE_TIMER
+ * a single esp_timer one-shot is armed for the earliest pulse end and drives
+ * the expired pins low from the timer task; serviceOutputChannels() mirrors
+ * the ended pulses and re-arms it. Without the timer, serviceOutputChannels()
+ * ends expired pulses itself and getOutputChannelIdleTime() lets loop() sleep
+ * exactly until the next one is due, however many channels are pulsing.
+ */
+
+enum OutputChannelMode : uint8_t {
+    OUTPUT_MODE_LEVEL = 0,
+    OUTPUT_MODE_PULSE,
+    OUTPUT_MODE_PWM
+};
+
+struct OutputChannelConfig {
+    const char* name;
+    uint8_t pin;
+    uint8_t mode;                   // OutputChannelMode
+    uint16_t pulseMs;               // PULSE: on time per activation
+    uint8_t pwmChannel;             // PWM: LEDC channel
+    uint16_t pwmFrequencyHz;        // PWM: carrier frequency
+    uint8_t pwmResolutionBits;      // PWM: duty resolution (full duty is 2^bits - 1)
+    uint16_t fadeInMs;              // PWM: ramp time of setOutputChannel(true), 0 = switch
+    uint16_t fadeOutMs;             // PWM: ramp time of setOutputChannel(false), 0 = switch
+};
+
+struct OutputChannelState {
+    bool active;
+    uint16_t duty;                  // PWM target duty (a ramp may still be under way); 1/0 otherwise
+    unsigned long activatedMs;      // PULSE: start of the running pulse, 0 when idle
+};
+
+// Validates the table, sets up the pins and drives every output off
+bool initializeOutputChannels(const OutputChannelConfig* table, uint8_t count, ArduinoInterface* hardware);
+uint8_t getOutputChannelCount();
+const OutputChannelConfig* getOutputChannelConfig(uint8_t channel);   // nullptr when out of range
+int findOutputChannel(const char* name);                               // -1 when unknown
+
+bool setOutputChannel(uint8_t channel, bool on);                       // true when the output changed
+bool setOutputChannelDuty(uint8_t channel, uint16_t duty, uint16_t fadeMs = 0);   // PWM channels only
+OutputChannelState getOutputChannelState(uint8_t channel);
+bool isOutputChannelActive(uint8_t channel);
+// Every channel outside ignoreMask (bit per channel) off, with no pulse, fade or deferred change
+bool areOutputChannelsIdle(unsigned long now, uint32_t ignoreMask = 0);
+
+// Called every loop() pass: mirrors timer-ended pulses or ends expired ones,
+// and starts PWM changes that waited for a fade to finish
+void serviceOutputChannels(unsigned long now);
+unsigned long getOutputChannelIdleTime(unsigned long now, unsigned long maxIdleMs);
+bool isOutputPulseTimerActive();        // false: pulses end from serviceOutputChannels()
+
+// Level and pulse changes between begin and commit are written together (nestable)
+void beginOutputBatch();
+bool commitOutputBatch();               // true when the batch wrote the output register
+
+void printOutputChannelStatus();
+
+#endif // OUTPUT_CHANNELS_H
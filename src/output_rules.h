@@ -0,0 +1,55 @@
+#ifndef OUTPUT_RULES_H
+#define OUTPUT_RULES_H
+
+#include <stdint.h>
+#include "config.h"
+#include "rule_table.h"
+#include "state_manager.h"
+
+/**
+ * Output decision rules
+ *
+ * The single place where the outputs and the derived flags they depend on
+ * are described. Each rule is compiled into a truth table (rule_table.h);
+ * the state manager and loop() only look results up. A new accessory output
+ * is one more rule over the VEHICLE_FLAG_* inputs below.
+ */
+
+// Flag rule inputs: bit n of the VEHICLE_FLAG_* word (getVehicleStateFlags())
+constexpr RuleFlag SystemReady(0);          // VEHICLE_FLAG_SYSTEM_READY
+constexpr RuleFlag Parked(1);               // VEHICLE_FLAG_PARKED
+constexpr RuleFlag Unlocked(2);             // VEHICLE_FLAG_UNLOCKED
+constexpr RuleFlag BedlightRequested(3);    // VEHICLE_FLAG_BEDLIGHT_REQUESTED
+constexpr RuleFlag ManualOverride(4);       // VEHICLE_FLAG_MANUAL_OVERRIDE
+constexpr RuleFlag ManualState(5);          // VEHICLE_FLAG_MANUAL_STATE
+
+static_assert((1u << SystemReady.bit) == VEHICLE_FLAG_SYSTEM_READY &&
+              (1u << Parked.bit) == VEHICLE_FLAG_PARKED &&
+              (1u << Unlocked.bit) == VEHICLE_FLAG_UNLOCKED &&
+              (1u << BedlightRequested.bit) == VEHICLE_FLAG_BEDLIGHT_REQUESTED &&
+              (1u << ManualOverride.bit) == VEHICLE_FLAG_MANUAL_OVERRIDE &&
+              (1u << ManualState.bit) == VEHICLE_FLAG_MANUAL_STATE,
+              "Rule inputs must match the VEHICLE_FLAG_* bits");
+
+// Toolbox opener (on a button hold): ready, in park and unlocked
+constexpr FlagRuleTable TOOLBOX_OPENER_RULE = compileFlagRule(SystemReady && Parked && Unlocked);
+
+// Bed light: off until ready, then the manual override state if one is active,
+// otherwise the BCM puddle lamp request
+constexpr FlagRuleTable BEDLIGHT_RULE = compileFlagRule(
+    SystemReady && ((ManualOverride && ManualState) || (!ManualOverride && BedlightRequested)));
+
+// Derived flags from raw signal values
+constexpr uint32_t BEDLIGHT_REQUEST_VALUES[] = {PUDLAMP_ON, PUDLAMP_RAMP_UP};
+constexpr uint32_t UNLOCKED_VALUES[] = {VEH_UNLOCK_ALL, VEH_UNLOCK_DRV};
+constexpr uint32_t PARKED_VALUES[] = {TRNPRKSTS_PARK};
+
+static_assert(valueRuleInputsFit<2>(BEDLIGHT_REQUEST_VALUES), "PudLamp_D_Rq is 2 bits");
+static_assert(valueRuleInputsFit<8>(UNLOCKED_VALUES), "vehicleLockStatus is stored in 8 bits");
+static_assert(valueRuleInputsFit<4>(PARKED_VALUES), "TrnPrkSys_D_Actl is 4 bits");
+
+constexpr ValueRuleTable<2> BEDLIGHT_REQUEST_RULE = compileValueRule<2>(BEDLIGHT_REQUEST_VALUES);
+constexpr ValueRuleTable<8> UNLOCKED_RULE = compileValueRule<8>(UNLOCKED_VALUES);
+constexpr ValueRuleTable<4> PARKED_RULE = compileValueRule<4>(PARKED_VALUES);
+
+#endif // OUTPUT_RULES_H
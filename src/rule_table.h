@@ -0,0 +1,138 @@
+#ifndef RULE_TABLE_H
+#define RULE_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+
+/**
+ * Compile-time rule tables
+ *
+ * Output decisions are written as boolean expressions and compiled by the
+ * compiler into truth tables, so evaluating a rule at run time is one shift
+ * and one AND, whatever the expression.
+ *
+ * Flag rules combine single-bit inputs of a packed state word with &&, ||
+ * and !. The inputs are the low RULE_FLAG_INPUTS bits of the word, so the
+ * truth table of any expression is one 64-bit constant indexed by the word:
+ *
+ *   constexpr RuleFlag Ready(0), Parked(1);
+ *   constexpr FlagRuleTable rule = compileFlagRule(Ready && !Parked);
+ *   rule.evaluate(flags);
+ *
+ * Value rules classify a raw signal value of up to RULE_VALUE_MAX_BITS bits
+ * (for example PudLamp_D_Rq in {ON, RAMP_UP}) with a bitmap over every value
+ * the field can hold; values outside the field are false.
+ */
+
+#define RULE_FLAG_INPUTS 6          // Packed input bits per flag rule (64-entry table)
+#define RULE_VALUE_MAX_BITS 8       // Widest signal a value rule classifies (256 values)
+
+// One input bit of the packed state word
+struct RuleFlag {
+    uint8_t bit;
+
+    constexpr explicit RuleFlag(uint8_t inputBit) : bit(inputBit) {}
+    constexpr bool eval(uint32_t flags) const { return (flags >> bit) & 1u; }
+};
+
+template <typename Operand>
+struct RuleNot {
+    Operand operand;
+    constexpr bool eval(uint32_t flags) const { return !operand.eval(flags); }
+};
+
+template <typename Left, typename Right>
+struct RuleAnd {
+    Left left;
+    Right right;
+    constexpr bool eval(uint32_t flags) const { return left.eval(flags) && right.eval(flags); }
+};
+
+template <typename Left, typename Right>
+struct RuleOr {
+    Left left;
+    Right right;
+    constexpr bool eval(uint32_t flags) const { return left.eval(flags) || right.eval(flags); }
+};
+
+// Expression nodes only; keeps the operators away from unrelated types
+template <typename T> struct IsRuleExpression { static constexpr bool value = false; };
+template <> struct IsRuleExpression<RuleFlag> { static constexpr bool value = true; };
+template <typename O> struct IsRuleExpression<RuleNot<O>> { static constexpr bool value = true; };
+template <typename L, typename R> struct IsRuleExpression<RuleAnd<L, R>> { static constexpr bool value = true; };
+template <typename L, typename R> struct IsRuleExpression<RuleOr<L, R>> { static constexpr bool value = true; };
+
+template <typename O, typename = typename std::enable_if<IsRuleExpression<O>::value>::type>
+constexpr RuleNot<O> operator!(const O& operand) {
+    return RuleNot<O>{operand};
+}
+
+template <typename L, typename R,
+          typename = typename std::enable_if<IsRuleExpression<L>::value && IsRuleExpression<R>::value>::type>
+constexpr RuleAnd<L, R> operator&&(const L& left, const R& right) {
+    return RuleAnd<L, R>{left, right};
+}
+
+template <typename L, typename R,
+          typename = typename std::enable_if<IsRuleExpression<L>::value && IsRuleExpression<R>::value>::type>
+constexpr RuleOr<L, R> operator||(const L& left, const R& right) {
+    return RuleOr<L, R>{left, right};
+}
+
+struct FlagRuleTable {
+    uint64_t truth;                 // Bit n: the rule's value for input word n
+
+    constexpr bool evaluate(uint32_t flags) const {
+        return (truth >> (flags & ((1u << RULE_FLAG_INPUTS) - 1))) & 1u;
+    }
+};
+
+template <typename Expression>
+constexpr FlagRuleTable compileFlagRule(const Expression& expression) {
+    FlagRuleTable table = {0};
+    for (uint32_t flags = 0; flags < (1u << RULE_FLAG_INPUTS); flags++) {
+        if (expression.eval(flags)) {
+            table.truth |= 1ULL << flags;
+        }
+    }
+    return table;
+}
+
+template <uint8_t Bits>
+struct ValueRuleTable {
+    static_assert(Bits >= 1 && Bits <= RULE_VALUE_MAX_BITS, "Value rules cover 1-8 bit signals");
+    static constexpr uint32_t VALUE_COUNT = 1u << Bits;
+    static constexpr size_t WORDS = (VALUE_COUNT + 63) / 64;
+
+    uint64_t truth[WORDS];          // Bit v: the rule's value for raw value v
+
+    constexpr bool evaluate(uint32_t value) const {
+        return value < VALUE_COUNT && ((truth[value >> 6] >> (value & 63)) & 1u);
+    }
+};
+
+// True for the listed raw values, false for every other value of the field
+template <uint8_t Bits, size_t N>
+constexpr ValueRuleTable<Bits> compileValueRule(const uint32_t (&values)[N]) {
+    ValueRuleTable<Bits> table = {};
+    for (size_t i = 0; i < N; i++) {
+        if (values[i] < ValueRuleTable<Bits>::VALUE_COUNT) {
+            table.truth[values[i] >> 6] |= 1ULL << (values[i] & 63);
+        }
+    }
+    return table;
+}
+
+// Every listed value fits the field (a typo'd constant would silently never match)
+template <uint8_t Bits, size_t N>
+constexpr bool valueRuleInputsFit(const uint32_t (&values)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        if (values[i] >= ValueRuleTable<Bits>::VALUE_COUNT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // RULE_TABLE_H
@@ -0,0 +1,112 @@
+#ifndef SIGNAL_DECODER_H
+#define SIGNAL_DECODER_H
+
+#include <stdint.h>
+#include "bit_utils.h"
+
+/**
+ * Compile-time CAN signal decoding
+ *
+ * Every signal is described by a constexpr CANSignalSpec generated from the
+ * DBC (see dbc_signals.h and tools/generate_can_signals.py). The decoders are
+ * templated on the descriptor, so shift and mask are constants and decoding
+ * a signal is a shift and an AND on the payload loaded once per frame with
+ * loadCANPayload().
+ *
+ * Bit numbering matches bit_utils.c: the payload is read as one little-endian
+ * 64-bit word. Intel (@1) signals start at their LSB. Motorola (@0) signals
+ * start at their MSB; when they stay within one byte (every signal in
+ * minimal.dbc) their LSB is startBit - length + 1, the same position the
+ * hand-validated extractBits() uses. Motorola signals spanning several bytes
+ * are contiguous in the byte-swapped word instead, so only those pay for a
+ * swap.
+ */
+
+#define CAN_BYTE_ORDER_MOTOROLA 0   // DBC @0 (big-endian)
+#define CAN_BYTE_ORDER_INTEL 1      // DBC @1 (little-endian)
+
+struct CANSignalSpec {
+    uint8_t startBit;       // DBC start bit
+    uint8_t length;         // Signal width in bits (1-32)
+    uint8_t byteOrder;      // CAN_BYTE_ORDER_*
+    bool isSigned;          // DBC value type '-'
+    float factor;           // physical = raw * factor + offset
+    float offset;
+    float minimum;          // DBC [min|max] physical range
+    float maximum;
+};
+
+// Motorola signal spanning more than one byte (decoded from the swapped word)
+constexpr bool canSignalNeedsSwap(const CANSignalSpec& signal) {
+    return signal.byteOrder == CAN_BYTE_ORDER_MOTOROLA && (signal.startBit % 8) + 1 < signal.length;
+}
+
+// Position of the signal's MSB within the byte-swapped (big-endian) payload word
+constexpr int canSignalSwappedMSB(const CANSignalSpec& signal) {
+    return (7 - signal.startBit / 8) * 8 + signal.startBit % 8;
+}
+
+// Position of the signal's LSB within the word it is decoded from
+constexpr int canSignalShift(const CANSignalSpec& signal) {
+    return signal.byteOrder == CAN_BYTE_ORDER_INTEL ? signal.startBit
+         : canSignalNeedsSwap(signal) ? canSignalSwappedMSB(signal) - signal.length + 1
+         : signal.startBit - signal.length + 1;
+}
+
+constexpr uint64_t canSignalMask(const CANSignalSpec& signal) {
+    return (1ULL << signal.length) - 1;
+}
+
+// Bits of the little-endian payload word that carry the signal
+constexpr uint64_t canSignalPayloadMask(const CANSignalSpec& signal) {
+    return canSignalNeedsSwap(signal)
+        ? __builtin_bswap64(canSignalMask(signal) << canSignalShift(signal))
+        : canSignalMask(signal) << canSignalShift(signal);
+}
+
+// Union of the payload bits of several signals (e.g. all signals a handler reads)
+template <typename... Signals>
+constexpr uint64_t canSignalsPayloadMask(const Signals&... signals) {
+    return (0ULL | ... | canSignalPayloadMask(signals));
+}
+
+// Whether the descriptor describes bits that exist in an 8-byte payload
+constexpr bool canSignalFitsPayload(const CANSignalSpec& signal) {
+    return signal.length >= 1 && signal.length <= 32 && signal.startBit <= 63 &&
+           canSignalShift(signal) >= 0 && canSignalShift(signal) + signal.length <= 64;
+}
+
+// Load the 8 payload bytes as one little-endian word (unused bytes must be zero)
+inline uint64_t loadCANPayload(const uint8_t* data) {
+    return loadCANWord(data);
+}
+
+// Raw (unscaled) signal value
+template <const CANSignalSpec& Signal>
+inline uint32_t decodeSignal(uint64_t payload) {
+    static_assert(canSignalFitsPayload(Signal), "signal does not fit in an 8-byte payload");
+    if (canSignalNeedsSwap(Signal)) {
+        payload = __builtin_bswap64(payload);
+    }
+    return (uint32_t)((payload >> canSignalShift(Signal)) & canSignalMask(Signal));
+}
+
+// Raw value with the DBC sign applied
+template <const CANSignalSpec& Signal>
+inline int32_t decodeSignalSigned(uint64_t payload) {
+    uint32_t raw = decodeSignal<Signal>(payload);
+    if (Signal.isSigned && Signal.length < 32 && (raw & (1UL << (Signal.length - 1)))) {
+        raw |= ~(uint32_t)canSignalMask(Signal);
+    }
+    return (int32_t)raw;
+}
+
+// Physical value (raw * factor + offset)
+template <const CANSignalSpec& Signal>
+inline float decodeSignalPhysical(uint64_t payload) {
+    float raw = Signal.isSigned ? (float)decodeSignalSigned<Signal>(payload)
+                                : (float)decodeSignal<Signal>(payload);
+    return raw * Signal.factor + Signal.offset;
+}
+
+#endif // SIGNAL_DECODER_H
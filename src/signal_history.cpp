@@ -0,0 +1,386 @@
+#define LOG_MODULE_ID LOG_MODULE_STATE
+#include "signal_history.h"
+#include <string.h>
+#include <strings.h>
+#include "logger.h"
+#ifndef NATIVE_ENV
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+#define MAX_EVENT_BYTES 8               // 5-byte time varint + 2-byte value varint, rounded up
+#define PRINT_MAX_SLOTS 48
+
+struct SignalHistoryBucket {
+    uint16_t changes;
+    uint8_t min;
+    uint8_t max;
+    uint8_t last;
+};
+
+// One signal: a byte ring of events, and the buckets they age into
+struct SignalHistoryTrack {
+    uint8_t events[SIGNAL_HISTORY_EVENT_BYTES];
+    uint16_t tail;                      // Oldest event
+    uint16_t used;
+    uint16_t eventCount;
+    bool started;                       // A value has been recorded
+    bool baseKnown;                     // An event has been folded: base is a real value
+    uint32_t baseMs;                    // Event before the tail: the oldest event is a delta from it
+    uint8_t baseValue;
+    uint32_t newestMs;                  // Newest event: the next one is a delta from it
+    uint8_t newestValue;
+
+    SignalHistoryBucket buckets[SIGNAL_HISTORY_BUCKETS];
+    uint16_t newestBucket;
+    uint16_t bucketCount;
+    uint32_t newestBucketMs;            // Buckets are contiguous, so one start time places them all
+
+    uint32_t eventsRecorded;
+    uint32_t eventsFolded;
+};
+
+static SignalHistoryTrack tracks[SIGNAL_HISTORY_COUNT];
+
+static const char* const signalNames[SIGNAL_HISTORY_COUNT] = {
+    "PudLamp_D_Rq", "TrnPrkSys_D_Actl", "BSBattSOC", "Veh_Lock_Status"
+};
+
+#ifndef NATIVE_ENV
+static SemaphoreHandle_t historyMutex = NULL;
+#endif
+
+class SignalHistoryLock {
+public:
+    SignalHistoryLock() {
+#ifndef NATIVE_ENV
+        if (historyMutex != NULL) {
+            xSemaphoreTake(historyMutex, portMAX_DELAY);
+        }
+#endif
+    }
+    ~SignalHistoryLock() {
+#ifndef NATIVE_ENV
+        if (historyMutex != NULL) {
+            xSemaphoreGive(historyMutex);
+        }
+#endif
+    }
+};
+
+static uint8_t encodeVarint(uint32_t value, uint8_t* out) {
+    uint8_t length = 0;
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[length++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    return length;
+}
+
+static uint32_t readVarint(const SignalHistoryTrack& track, uint16_t& offset) {
+    uint32_t value = 0;
+    uint8_t shift = 0;
+    uint8_t byte;
+    do {
+        byte = track.events[(track.tail + offset) % SIGNAL_HISTORY_EVENT_BYTES];
+        offset++;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while ((byte & 0x80) && shift < 35);
+    return value;
+}
+
+// Decodes the event at offset (from the tail) relative to *ms / *value and advances offset
+static void readEvent(const SignalHistoryTrack& track, uint16_t& offset, uint32_t& ms, uint8_t& value) {
+    ms += readVarint(track, offset);
+    uint32_t zigzag = readVarint(track, offset);
+    int32_t delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+    value = (uint8_t)(value + delta);
+}
+
+static void pushBucket(SignalHistoryTrack& track, uint8_t value) {
+    track.newestBucket = (track.newestBucket + 1) % SIGNAL_HISTORY_BUCKETS;
+    if (track.bucketCount < SIGNAL_HISTORY_BUCKETS) {
+        track.bucketCount++;
+    }
+    track.buckets[track.newestBucket] = {0, value, value, value};
+}
+
+static void foldIntoBuckets(SignalHistoryTrack& track, uint32_t ms, uint8_t value) {
+    if (track.bucketCount == 0) {
+        track.newestBucketMs = ms - ms % SIGNAL_HISTORY_BUCKET_MS;
+        pushBucket(track, value);
+    } else {
+        // Buckets with no change hold the previous value; more than a ring's worth only keeps the newest
+        uint32_t gap = (ms - track.newestBucketMs) / SIGNAL_HISTORY_BUCKET_MS;
+        uint32_t first = gap > SIGNAL_HISTORY_BUCKETS ? gap - SIGNAL_HISTORY_BUCKETS + 1 : 1;
+        for (uint32_t i = first; i <= gap; i++) {
+            pushBucket(track, track.baseValue);
+        }
+        track.newestBucketMs += gap * SIGNAL_HISTORY_BUCKET_MS;
+    }
+
+    SignalHistoryBucket& bucket = track.buckets[track.newestBucket];
+    if (value < bucket.min) bucket.min = value;
+    if (value > bucket.max) bucket.max = value;
+    bucket.last = value;
+    if (track.baseKnown && bucket.changes < UINT16_MAX) {
+        bucket.changes++;
+    }
+}
+
+static void foldOldestEvent(SignalHistoryTrack& track) {
+    uint16_t offset = 0;
+    uint32_t ms = track.baseMs;
+    uint8_t value = track.baseValue;
+    readEvent(track, offset, ms, value);
+    foldIntoBuckets(track, ms, value);
+
+    track.baseMs = ms;
+    track.baseValue = value;
+    track.baseKnown = true;
+    track.tail = (track.tail + offset) % SIGNAL_HISTORY_EVENT_BYTES;
+    track.used -= offset;
+    track.eventCount--;
+    track.eventsFolded++;
+}
+
+static void appendEvent(SignalHistoryTrack& track, uint32_t ms, uint8_t value) {
+    if (!track.started) {
+        track.started = true;
+        track.baseMs = ms;
+        track.baseValue = 0;
+        track.newestMs = ms;
+        track.newestValue = 0;
+    }
+
+    uint8_t encoded[MAX_EVENT_BYTES];
+    int32_t delta = (int32_t)value - (int32_t)track.newestValue;
+    uint8_t length = encodeVarint(ms - track.newestMs, encoded);
+    length += encodeVarint(((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31), encoded + length);
+
+    while (SIGNAL_HISTORY_EVENT_BYTES - track.used < length) {
+        foldOldestEvent(track);
+    }
+    uint16_t head = (track.tail + track.used) % SIGNAL_HISTORY_EVENT_BYTES;
+    for (uint8_t i = 0; i < length; i++) {
+        track.events[(head + i) % SIGNAL_HISTORY_EVENT_BYTES] = encoded[i];
+    }
+    track.used += length;
+    track.eventCount++;
+    track.eventsRecorded++;
+    track.newestMs = ms;
+    track.newestValue = value;
+}
+
+void resetSignalHistory() {
+#ifndef NATIVE_ENV
+    if (historyMutex == NULL) {
+        historyMutex = xSemaphoreCreateMutex();
+    }
+#endif
+    SignalHistoryLock lock;
+    memset(tracks, 0, sizeof(tracks));
+}
+
+void recordSignalHistory(uint32_t signalsWord, uint32_t nowMs) {
+    SignalHistoryLock lock;
+    for (uint8_t signal = 0; signal < SIGNAL_HISTORY_COUNT; signal++) {
+        SignalHistoryTrack& track = tracks[signal];
+        uint8_t value = getSignalHistoryValue(signal, signalsWord);
+        if (!track.started || value != track.newestValue) {
+            appendEvent(track, nowMs, value);
+        }
+
+        // Age out: only the oldest event's time has to be decoded
+        while (track.used > 0) {
+            uint16_t offset = 0;
+            uint32_t oldestMs = track.baseMs + readVarint(track, offset);
+            if (nowMs - oldestMs <= SIGNAL_HISTORY_RAW_MAX_AGE_MS) {
+                break;
+            }
+            foldOldestEvent(track);
+        }
+    }
+}
+
+const char* getSignalHistoryName(uint8_t signal) {
+    return signal < SIGNAL_HISTORY_COUNT ? signalNames[signal] : "unknown";
+}
+
+int findSignalHistorySignal(const char* name) {
+    for (uint8_t signal = 0; signal < SIGNAL_HISTORY_COUNT; signal++) {
+        if (strcasecmp(name, signalNames[signal]) == 0) {
+            return signal;
+        }
+    }
+    return -1;
+}
+
+uint8_t getSignalHistoryValue(uint8_t signal, uint32_t signalsWord) {
+    VehicleSignals signals = vehicleSignalsFromWord(signalsWord);
+    switch (signal) {
+        case SIGNAL_HISTORY_PUD_LAMP: return signals.pudLampRequest;
+        case SIGNAL_HISTORY_PARK: return signals.transmissionParkStatus;
+        case SIGNAL_HISTORY_BATTERY_SOC: return signals.batterySOC;
+        case SIGNAL_HISTORY_LOCK: return signals.vehicleLockStatus;
+        default: return 0;
+    }
+}
+
+// Folds time-ordered samples (buckets, then events) into the query's slots
+struct SlotFolder {
+    uint32_t fromMs;
+    uint32_t slotMs;
+    uint16_t slotCount;
+    SignalHistorySlot* slots;
+    int32_t current;                    // Last slot opened, -1 before the first
+    bool heldKnown;
+    uint8_t held;                       // Value in force at the latest sample
+
+    void openSlotsThrough(int32_t slot) {
+        while (current < slot) {
+            current++;
+            slots[current] = {fromMs + (uint32_t)current * slotMs, 0, held, held, held, heldKnown};
+        }
+    }
+
+    void add(uint32_t ms, uint8_t min, uint8_t max, uint8_t last, uint16_t changes) {
+        int32_t offset = (int32_t)(ms - fromMs);
+        if (offset >= 0 && (uint32_t)offset / slotMs < slotCount) {
+            openSlotsThrough((int32_t)((uint32_t)offset / slotMs));
+            SignalHistorySlot& slot = slots[current];
+            if (!slot.known || min < slot.min) slot.min = min;
+            if (!slot.known || max > slot.max) slot.max = max;
+            slot.last = last;
+            slot.known = true;
+            slot.changes = (uint16_t)(slot.changes + changes < UINT16_MAX ? slot.changes + changes : UINT16_MAX);
+        } else if (offset >= 0) {
+            return;                     // After the window; the held value no longer matters
+        }
+        held = last;
+        heldKnown = true;
+    }
+};
+
+uint16_t querySignalHistory(uint8_t signal, uint32_t fromMs, uint32_t slotMs, uint16_t slotCount,
+                            SignalHistorySlot* slots) {
+    if (signal >= SIGNAL_HISTORY_COUNT || slotMs == 0 || slotCount == 0 || slots == nullptr) {
+        return 0;
+    }
+
+    SignalHistoryLock lock;
+    const SignalHistoryTrack& track = tracks[signal];
+    SlotFolder folder = {fromMs, slotMs, slotCount, slots, -1, false, 0};
+
+    uint32_t bucketMs = track.newestBucketMs - (uint32_t)(track.bucketCount - 1) * SIGNAL_HISTORY_BUCKET_MS;
+    uint16_t bucket = (track.newestBucket + SIGNAL_HISTORY_BUCKETS - (track.bucketCount - 1)) % SIGNAL_HISTORY_BUCKETS;
+    for (uint16_t i = 0; i < track.bucketCount; i++) {
+        const SignalHistoryBucket& entry = track.buckets[bucket];
+        folder.add(bucketMs, entry.min, entry.max, entry.last, entry.changes);
+        bucket = (bucket + 1) % SIGNAL_HISTORY_BUCKETS;
+        bucketMs += SIGNAL_HISTORY_BUCKET_MS;
+    }
+
+    uint16_t offset = 0;
+    uint32_t ms = track.baseMs;
+    uint8_t value = track.baseValue;
+    bool known = track.baseKnown;
+    while (offset < track.used) {
+        readEvent(track, offset, ms, value);
+        folder.add(ms, value, value, value, known ? 1 : 0);
+        known = true;
+    }
+
+    folder.openSlotsThrough(slotCount - 1);
+    return slotCount;
+}
+
+SignalHistoryInfo getSignalHistoryInfo(uint8_t signal) {
+    SignalHistoryInfo info = {};
+    if (signal >= SIGNAL_HISTORY_COUNT) {
+        return info;
+    }
+
+    SignalHistoryLock lock;
+    const SignalHistoryTrack& track = tracks[signal];
+    info.events = track.eventCount;
+    info.bytesUsed = track.used;
+    info.buckets = track.bucketCount;
+    info.hasEvents = track.used > 0;
+    info.hasBuckets = track.bucketCount > 0;
+    if (info.hasEvents) {
+        uint16_t offset = 0;
+        info.oldestEventMs = track.baseMs + readVarint(track, offset);
+    }
+    if (info.hasBuckets) {
+        info.oldestBucketMs = track.newestBucketMs - (uint32_t)(track.bucketCount - 1) * SIGNAL_HISTORY_BUCKET_MS;
+    }
+    info.eventsRecorded = track.eventsRecorded;
+    info.eventsFolded = track.eventsFolded;
+    return info;
+}
+
+uint32_t getSignalHistoryStorageBytes() {
+    return sizeof(tracks);
+}
+
+uint32_t getSignalHistoryBytesInUse() {
+    SignalHistoryLock lock;
+    uint32_t bytes = 0;
+    for (uint8_t signal = 0; signal < SIGNAL_HISTORY_COUNT; signal++) {
+        bytes += tracks[signal].used + tracks[signal].bucketCount * (uint32_t)sizeof(SignalHistoryBucket);
+    }
+    return bytes;
+}
+
+void printSignalHistoryStatus(uint32_t nowMs) {
+    LOG_INFO("=== SIGNAL HISTORY ===");
+    LOG_INFO("Arena: %d bytes of events per signal, exact for %lu min, then %lu min buckets for %lu h",
+             SIGNAL_HISTORY_EVENT_BYTES, (unsigned long)(SIGNAL_HISTORY_RAW_MAX_AGE_MS / 60000),
+             (unsigned long)(SIGNAL_HISTORY_BUCKET_MS / 60000),
+             (unsigned long)(SIGNAL_HISTORY_BUCKET_MS * SIGNAL_HISTORY_BUCKETS / 3600000UL));
+
+    for (uint8_t signal = 0; signal < SIGNAL_HISTORY_COUNT; signal++) {
+        SignalHistoryInfo info = getSignalHistoryInfo(signal);
+        SignalHistorySlot hour;
+        SignalHistorySlot day;
+        querySignalHistory(signal, nowMs - 3600000UL, 3600000UL, 1, &hour);
+        querySignalHistory(signal, nowMs - 86400000UL, 86400000UL, 1, &day);
+
+        LOG_INFO("%s: now %d, %u changes in 1 h, %u in 24 h (min %d, max %d)", getSignalHistoryName(signal),
+                 day.known ? day.last : -1, hour.changes, day.changes, day.known ? day.min : -1,
+                 day.known ? day.max : -1);
+        unsigned long exactMin = info.hasEvents ? (unsigned long)((nowMs - info.oldestEventMs) / 60000) : 0;
+        unsigned long spanMin = info.hasBuckets ? (unsigned long)((nowMs - info.oldestBucketMs) / 60000) : exactMin;
+        LOG_INFO("  %u events (%u bytes), exact for the last %lu min; %u buckets, back %lu min; %lu recorded, %lu folded",
+                 info.events, info.bytesUsed, exactMin, info.buckets, spanMin,
+                 (unsigned long)info.eventsRecorded, (unsigned long)info.eventsFolded);
+    }
+}
+
+void printSignalHistory(uint8_t signal, uint32_t nowMs, uint32_t windowMs, uint16_t slotCount) {
+    if (slotCount > PRINT_MAX_SLOTS) {
+        slotCount = PRINT_MAX_SLOTS;
+    }
+    uint32_t slotMs = slotCount > 0 ? windowMs / slotCount : 0;
+    SignalHistorySlot slots[PRINT_MAX_SLOTS];
+    if (querySignalHistory(signal, nowMs - slotMs * slotCount, slotMs, slotCount, slots) == 0) {
+        LOG_WARN("Signal history: nothing to show for that window");
+        return;
+    }
+
+    LOG_INFO("=== %s: last %lu min in %u slots of %lu s ===", getSignalHistoryName(signal),
+             (unsigned long)(slotMs * slotCount / 60000), slotCount, (unsigned long)(slotMs / 1000));
+    for (uint16_t i = 0; i < slotCount; i++) {
+        const SignalHistorySlot& slot = slots[i];
+        unsigned long agoS = (unsigned long)((nowMs - slot.startMs) / 1000);
+        if (!slot.known) {
+            LOG_INFO("  -%6lu s: no data", agoS);
+        } else {
+            LOG_INFO("  -%6lu s: min %3d max %3d last %3d, %u changes", agoS, slot.min, slot.max, slot.last,
+                     slot.changes);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef SIGNAL_HISTORY_H
+#define SIGNAL_HISTORY_H
+
+#include <stdint.h>
+#include "config.h"
+#include "state_manager.h"
+
+/**
+ * Per-signal history of the monitored DBC signals
+ *
+ * VehicleState only has the current and previous values. loop() hands every
+ * published signal word to recordSignalHistory(), which appends an event for
+ * each signal whose value changed. An event is the time since the signal's
+ * previous event (LEB128 varint, ms) and the value delta (zigzag varint), so a
+ * change costs 2-4 bytes of the signal's SIGNAL_HISTORY_EVENT_BYTES ring.
+ *
+ * Events age into a second tier: once older than SIGNAL_HISTORY_RAW_MAX_AGE_MS,
+ * or when the ring needs room, the oldest event is folded into a ring of
+ * SIGNAL_HISTORY_BUCKETS min/max buckets of SIGNAL_HISTORY_BUCKET_MS. Minutes
+ * with no change become buckets holding the last value, and the oldest bucket
+ * is dropped. Nothing is allocated, however long the truck sits.
+ *
+ * querySignalHistory() downsamples both tiers on demand into slots of any
+ * width: min, max and last value plus the number of changes per slot. Slots
+ * match exactly while they fall in the event tier; older ones are built from
+ * whole buckets, each counted in the slot that holds the bucket's start.
+ *
+ * One writer (loop()). Queries may run on any task: firmware builds take a
+ * mutex around each record and query.
+ */
+
+#define SIGNAL_HISTORY_PUD_LAMP 0           // PudLamp_D_Rq
+#define SIGNAL_HISTORY_PARK 1               // TrnPrkSys_D_Actl
+#define SIGNAL_HISTORY_BATTERY_SOC 2        // BSBattSOC
+#define SIGNAL_HISTORY_LOCK 3               // Veh_Lock_Status
+#define SIGNAL_HISTORY_COUNT 4
+
+struct SignalHistorySlot {
+    uint32_t startMs;
+    uint16_t changes;                   // Value changes that fell in the slot
+    uint8_t min;                        // Valid when known: also covers the value held into the slot
+    uint8_t max;
+    uint8_t last;                       // Value at the end of the slot
+    bool known;                         // false before the signal's first recorded value
+};
+
+struct SignalHistoryInfo {
+    uint16_t events;                    // In the event tier
+    uint16_t bytesUsed;                 // Of SIGNAL_HISTORY_EVENT_BYTES
+    uint16_t buckets;
+    bool hasEvents;
+    bool hasBuckets;
+    uint32_t oldestEventMs;             // Valid with hasEvents: exact history starts here
+    uint32_t oldestBucketMs;            // Valid with hasBuckets
+    uint32_t eventsRecorded;
+    uint32_t eventsFolded;              // Moved into buckets by age or for room
+};
+
+void resetSignalHistory();
+void recordSignalHistory(uint32_t signalsWord, uint32_t nowMs);   // Also folds events that aged out
+
+const char* getSignalHistoryName(uint8_t signal);   // DBC signal name
+int findSignalHistorySignal(const char* name);      // Case-insensitive; -1 when unknown
+uint8_t getSignalHistoryValue(uint8_t signal, uint32_t signalsWord);
+
+// Fills slotCount slots of slotMs starting at fromMs; returns slotCount, or 0 on bad arguments
+uint16_t querySignalHistory(uint8_t signal, uint32_t fromMs, uint32_t slotMs, uint16_t slotCount,
+                            SignalHistorySlot* slots);
+SignalHistoryInfo getSignalHistoryInfo(uint8_t signal);
+uint32_t getSignalHistoryStorageBytes();    // Event rings and buckets of every signal (static)
+uint32_t getSignalHistoryBytesInUse();      // Event bytes and buckets holding data
+
+void printSignalHistoryStatus(uint32_t nowMs);
+void printSignalHistory(uint8_t signal, uint32_t nowMs, uint32_t windowMs, uint16_t slotCount);
+
+#endif // SIGNAL_HISTORY_H
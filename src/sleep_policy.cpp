@@ -0,0 +1,118 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include "sleep_policy.h"
+#include <string.h>
+#include "logger.h"
+
+static SleepStats stats;
+static bool awaitingFrame = false;
+static uint32_t lastWakeUs = 0;
+
+uint8_t getSleepBlocker(const SleepConditions& conditions) {
+    const VehicleSignals& signals = conditions.signals;
+    if (!signals.isParked) {
+        return SLEEP_BLOCK_NOT_PARKED;
+    }
+    if (signals.vehicleLockStatus != VEH_LOCK_ALL && signals.vehicleLockStatus != VEH_LOCK_DBL) {
+        return SLEEP_BLOCK_NOT_LOCKED;
+    }
+    if (conditions.busQuietMs < LIGHT_SLEEP_BUS_QUIET_MS) {
+        return SLEEP_BLOCK_BUS_ACTIVE;
+    }
+    if (conditions.outputsActive) {
+        return SLEEP_BLOCK_OUTPUT_ACTIVE;
+    }
+    if (conditions.busy) {
+        return SLEEP_BLOCK_BUSY;
+    }
+    if (conditions.idleMs < LIGHT_SLEEP_MIN_IDLE_MS) {
+        return SLEEP_BLOCK_SHORT_IDLE;
+    }
+    return SLEEP_BLOCK_NONE;
+}
+
+const char* getSleepBlockerName(uint8_t blocker) {
+    switch (blocker) {
+        case SLEEP_BLOCK_NONE: return "none";
+        case SLEEP_BLOCK_NOT_PARKED: return "not parked";
+        case SLEEP_BLOCK_NOT_LOCKED: return "not locked";
+        case SLEEP_BLOCK_BUS_ACTIVE: return "bus active";
+        case SLEEP_BLOCK_OUTPUT_ACTIVE: return "output active";
+        case SLEEP_BLOCK_BUSY: return "busy";
+        case SLEEP_BLOCK_SHORT_IDLE: return "next deadline too close";
+        default: return "unknown";
+    }
+}
+
+const char* getSleepWakeCauseName(uint8_t cause) {
+    switch (cause) {
+        case SLEEP_WAKE_CAN: return "CAN";
+        case SLEEP_WAKE_TWAI: return "TWAI";
+        case SLEEP_WAKE_BUTTON: return "button";
+        case SLEEP_WAKE_TIMER: return "timer";
+        default: return "other";
+    }
+}
+
+void noteSleepBlocker(uint8_t blocker) {
+    stats.blocker = blocker;
+}
+
+void recordSleepWake(uint8_t cause, uint32_t sleptUs, uint32_t wakeUs) {
+    // The previous bus wake never delivered a frame
+    if (awaitingFrame && (stats.lastWakeCause == SLEEP_WAKE_CAN || stats.lastWakeCause == SLEEP_WAKE_TWAI)) {
+        stats.busWakesWithoutFrame++;
+    }
+    if (cause >= SLEEP_WAKE_CAUSE_COUNT) {
+        cause = SLEEP_WAKE_OTHER;
+    }
+
+    stats.sleeps++;
+    stats.totalSleepUs += sleptUs;
+    stats.lastSleepUs = sleptUs;
+    if (sleptUs > stats.longestSleepUs) {
+        stats.longestSleepUs = sleptUs;
+    }
+    stats.wakes[cause]++;
+    stats.lastWakeCause = cause;
+    lastWakeUs = wakeUs;
+    awaitingFrame = true;
+}
+
+void noteFrameAfterWake(uint32_t nowUs) {
+    if (!awaitingFrame) {
+        return;
+    }
+    awaitingFrame = false;
+    uint32_t latency = nowUs - lastWakeUs;
+    stats.framesAfterWake++;
+    stats.lastWakeToFrameUs = latency;
+    if (latency > stats.maxWakeToFrameUs) {
+        stats.maxWakeToFrameUs = latency;
+    }
+}
+
+SleepStats getSleepStats() {
+    return stats;
+}
+
+void resetSleepStats() {
+    memset(&stats, 0, sizeof(stats));
+    awaitingFrame = false;
+    lastWakeUs = 0;
+}
+
+void printSleepStats() {
+    LOG_INFO("=== LIGHT SLEEP ===");
+    LOG_INFO("Sleep: %s (blocked by: %s)", ENABLE_LIGHT_SLEEP ? "enabled" : "disabled",
+             getSleepBlockerName(stats.blocker));
+    LOG_INFO("Sleeps: %lu, total %lu s, last %lu ms, longest %lu ms", (unsigned long)stats.sleeps,
+             (unsigned long)(stats.totalSleepUs / 1000000ULL), (unsigned long)(stats.lastSleepUs / 1000),
+             (unsigned long)(stats.longestSleepUs / 1000));
+    LOG_INFO("Wakes: CAN %lu, TWAI %lu, button %lu, timer %lu, other %lu (last: %s)",
+             (unsigned long)stats.wakes[SLEEP_WAKE_CAN], (unsigned long)stats.wakes[SLEEP_WAKE_TWAI],
+             (unsigned long)stats.wakes[SLEEP_WAKE_BUTTON], (unsigned long)stats.wakes[SLEEP_WAKE_TIMER],
+             (unsigned long)stats.wakes[SLEEP_WAKE_OTHER], getSleepWakeCauseName(stats.lastWakeCause));
+    LOG_INFO("Wake to first frame: last %lu us, max %lu us (%lu wakes with a frame, %lu bus wakes without)",
+             (unsigned long)stats.lastWakeToFrameUs, (unsigned long)stats.maxWakeToFrameUs,
+             (unsigned long)stats.framesAfterWake, (unsigned long)stats.busWakesWithoutFrame);
+}
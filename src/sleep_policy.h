@@ -0,0 +1,71 @@
+#ifndef SLEEP_POLICY_H
+#define SLEEP_POLICY_H
+
+#include <stdint.h>
+#include "config.h"
+#include "state_manager.h"
+
+/**
+ * Light sleep policy and statistics
+ *
+ * getSleepBlocker() decides from one snapshot of the system whether loop()
+ * may put the chip into light sleep (light_sleep.h): the truck must be parked
+ * and locked, the bus quiet for LIGHT_SLEEP_BUS_QUIET_MS, every output off,
+ * nothing in flight, and the next deadline far enough away. The first
+ * reason that applies is reported, so 'power' shows why the board is awake.
+ *
+ * The statistics record time in sleep, the wake causes and the time from a
+ * wake to the first frame loop() processes after it. A bus wake that never
+ * produced a frame before the next sleep is counted separately: that is the
+ * sign of a missed frame.
+ */
+
+#define SLEEP_BLOCK_NONE 0
+#define SLEEP_BLOCK_NOT_PARKED 1
+#define SLEEP_BLOCK_NOT_LOCKED 2            // Unlocked or lock state unknown
+#define SLEEP_BLOCK_BUS_ACTIVE 3
+#define SLEEP_BLOCK_OUTPUT_ACTIVE 4
+#define SLEEP_BLOCK_BUSY 5                  // Button, CAN recovery, flight record or queued work
+#define SLEEP_BLOCK_SHORT_IDLE 6            // Next deadline sooner than LIGHT_SLEEP_MIN_IDLE_MS
+
+#define SLEEP_WAKE_CAN 0                    // MCP2515 INT
+#define SLEEP_WAKE_TWAI 1                   // TWAI RX edge
+#define SLEEP_WAKE_BUTTON 2
+#define SLEEP_WAKE_TIMER 3                  // Loop deadline or LIGHT_SLEEP_MAX_MS
+#define SLEEP_WAKE_OTHER 4
+#define SLEEP_WAKE_CAUSE_COUNT 5
+
+struct SleepConditions {
+    VehicleSignals signals;
+    unsigned long busQuietMs;           // Since the last processed frame
+    unsigned long idleMs;               // Until loop()'s next deadline
+    bool outputsActive;                 // Any output channel on, pulsing or fading
+    bool busy;
+};
+
+struct SleepStats {
+    uint32_t sleeps;
+    uint64_t totalSleepUs;
+    uint32_t lastSleepUs;
+    uint32_t longestSleepUs;
+    uint32_t wakes[SLEEP_WAKE_CAUSE_COUNT];
+    uint32_t framesAfterWake;           // Wakes followed by a processed frame
+    uint32_t lastWakeToFrameUs;
+    uint32_t maxWakeToFrameUs;
+    uint32_t busWakesWithoutFrame;      // CAN/TWAI wakes with no frame before the next sleep
+    uint8_t lastWakeCause;
+    uint8_t blocker;                    // SLEEP_BLOCK_* of the latest check
+};
+
+uint8_t getSleepBlocker(const SleepConditions& conditions);
+const char* getSleepBlockerName(uint8_t blocker);
+const char* getSleepWakeCauseName(uint8_t cause);
+
+void noteSleepBlocker(uint8_t blocker);
+void recordSleepWake(uint8_t cause, uint32_t sleptUs, uint32_t wakeUs);
+void noteFrameAfterWake(uint32_t nowUs);    // Per processed frame; only the first after a wake counts
+SleepStats getSleepStats();
+void resetSleepStats();
+void printSleepStats();
+
+#endif // SLEEP_POLICY_H
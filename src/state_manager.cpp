@@ -1,42 +1,97 @@
+#define LOG_MODULE_ID LOG_MODULE_STATE
 #include "state_manager.h"
+#include "state_snapshot.h"
+#include "freshness_tracker.h"
+#include "button_driver.h"
+#include "can_ring_buffer.h"
+#include "output_rules.h"
+#ifndef NATIVE_ENV
+#include <freertos/FreeRTOS.h>
+#endif
 
 // Global state variables
+// vehicleState is owned by the task that runs the parsers (loop()); every
+// mutation is followed by publishVehicleState() so other readers only ever
+// see the published snapshot and signal word.
 static VehicleState vehicleState;
+static SeqlockSnapshot<VehicleState> publishedState;
+static std::atomic<uint32_t> publishedSignals(0);   // vehicleSignalsWord(vehicleState.current)
 static ButtonState buttonState;
 static bool stateManagerInitialized = false;
+static uint8_t outputInputChanges = 0;
+static FreshnessTracker sourceFreshness;             // Stale/readiness deadlines per VEHICLE_MSG_*
+static SPSCRingBuffer<VehicleSignalChange, VEHICLE_SIGNAL_CHANGE_QUEUE_SIZE> signalChanges;
+
+#ifndef NATIVE_ENV
+// Keeps a same-core reader from preempting a half-written snapshot
+static portMUX_TYPE statePublishLock = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+static uint32_t computeVehicleStateFlags(const VehicleSignals& signals) {
+    uint32_t flags = 0;
+    if (signals.systemReady) flags |= VEHICLE_FLAG_SYSTEM_READY;
+    if (signals.isParked) flags |= VEHICLE_FLAG_PARKED;
+    if (signals.isUnlocked) flags |= VEHICLE_FLAG_UNLOCKED;
+    if (signals.bedlightShouldBeOn) flags |= VEHICLE_FLAG_BEDLIGHT_REQUESTED;
+    if (signals.bedlightManualOverride) flags |= VEHICLE_FLAG_MANUAL_OVERRIDE;
+    if (signals.bedlightManualState) flags |= VEHICLE_FLAG_MANUAL_STATE;
+    return flags;
+}
+
+// Make the current vehicleState visible to readers
+static void publishVehicleState() {
+    uint32_t signalsWord = vehicleSignalsWord(vehicleState.current);
+    uint32_t previousWord = publishedSignals.load(std::memory_order_relaxed);
+#ifndef NATIVE_ENV
+    portENTER_CRITICAL(&statePublishLock);
+#endif
+    publishedState.publish(vehicleState);
+    publishedSignals.store(signalsWord, std::memory_order_release);
+#ifndef NATIVE_ENV
+    portEXIT_CRITICAL(&statePublishLock);
+#endif
+    
+    // Journal for the telemetry task; a full ring drops (and counts) the change
+    if (signalsWord != previousWord) {
+        signalChanges.push({(uint32_t)millis(), signalsWord});
+    }
+}
+
+// Record new data for one source: the published timestamp and its freshness deadlines
+static void noteSourceUpdate(uint8_t source, unsigned long timestamp) {
+    vehicleState.lastUpdate[source] = timestamp;
+    noteFreshnessUpdate(sourceFreshness, source, timestamp);
+}
+
+// Record that a value the output logic depends on changed
+static void markOutputInputChanged(uint8_t inputs) {
+    outputInputChanges |= inputs;
+}
 
 // Initialize the state manager
 void initializeStateManager() {
     LOG_INFO("Initializing State Manager...");
     
-    // Initialize vehicle state with default values
-    vehicleState.pudLampRequest = PUDLAMP_OFF;
-    vehicleState.vehicleLockStatus = VEH_LOCK_UNKNOWN;
-    vehicleState.transmissionParkStatus = TRNPRKSTS_PARK;  // Default to PARK if POWERTRAIN_DATA_10 not seen yet
-    vehicleState.batterySOC = 0;
-    
-    // Initialize previous values
-    vehicleState.prevPudLampRequest = PUDLAMP_OFF;
-    vehicleState.prevVehicleLockStatus = VEH_LOCK_UNKNOWN;
-    vehicleState.prevTransmissionParkStatus = TRNPRKSTS_PARK;  // Default to PARK if POWERTRAIN_DATA_10 not seen yet
-    vehicleState.prevBatterySOC = 0;
+    // Initialize vehicle state with default values (also clears the reserved bits)
+    memset(&vehicleState, 0, sizeof(vehicleState));
+    vehicleState.current.pudLampRequest = PUDLAMP_OFF;
+    vehicleState.current.vehicleLockStatus = VEH_LOCK_UNKNOWN;
+    vehicleState.current.transmissionParkStatus = TRNPRKSTS_PARK;  // Default to PARK if POWERTRAIN_DATA_10 not seen yet
+    vehicleState.current.batterySOC = 0;
     
-    // Initialize timestamps
+    // Timestamps start at 0 (no message seen)
     unsigned long currentTime = millis();
-    vehicleState.lastBCMLampUpdate = 0;
-    vehicleState.lastLockingSystemsUpdate = 0;
-    vehicleState.lastPowertrainUpdate = 0;
-    vehicleState.lastBatteryUpdate = 0;
     
     // Initialize state flags
-    vehicleState.isUnlocked = false;
-    vehicleState.isParked = true;  // Default to parked if POWERTRAIN_DATA_10 not seen yet
-    vehicleState.bedlightShouldBeOn = false;
-    vehicleState.systemReady = false;
+    vehicleState.current.isUnlocked = false;
+    vehicleState.current.isParked = true;  // Default to parked if POWERTRAIN_DATA_10 not seen yet
+    vehicleState.current.bedlightShouldBeOn = false;
+    vehicleState.current.systemReady = false;
     
     // Initialize manual bed light control
-    vehicleState.bedlightManualOverride = false;
-    vehicleState.bedlightManualState = false;
+    vehicleState.current.bedlightManualOverride = false;
+    vehicleState.current.bedlightManualState = false;
+    vehicleState.previous = vehicleState.current;
     
     // Initialize button state
     buttonState.currentState = false;
@@ -55,10 +110,39 @@ void initializeStateManager() {
     buttonState.doubleClickDetected = false;
     buttonState.secondToLastPressTime = 0;
     
+    // Sources count as seen at t=0 (matching the zeroed timestamps), so the
+    // system is ready during the first readiness window after boot
+    initFreshnessTracker(sourceFreshness, VEHICLE_MSG_COUNT, CAN_TIMEOUT_MS, SYSTEM_READINESS_TIMEOUT_MS, 0);
+    // systemReady starts false: have the first checkForStateChanges() apply the masks
+    sourceFreshness.changed = true;
+    
+    // Outputs have never been computed from this state
+    outputInputChanges = OUTPUT_INPUT_ALL;
+    publishVehicleState();
+    
     stateManagerInitialized = true;
     LOG_INFO("State Manager initialized successfully");
 }
 
+// Seed the state with the signals from before a reset (boot_state.h). The
+// sources keep their boot-time freshness, so every value is replaced as soon
+// as its message arrives.
+void restoreVehicleSignals(const VehicleSignals& signals) {
+    if (!stateManagerInitialized) {
+        return;
+    }
+    
+    vehicleState.current = signals;
+    vehicleState.current.reserved = 0;
+    vehicleState.previous = vehicleState.current;
+    sourceFreshness.changed = true;   // Readiness is re-derived on the next pass
+    markOutputInputChanged(OUTPUT_INPUT_ALL);
+    publishVehicleState();
+    LOG_INFO("Restored last-known state: lock %d, park %d, %s, %s", signals.vehicleLockStatus,
+             signals.transmissionParkStatus, signals.isUnlocked ? "UNLOCKED" : "LOCKED",
+             signals.isParked ? "PARKED" : "NOT_PARKED");
+}
+
 // Update BCM lamp state and detect changes
 void updateBCMLampState(const BCMLampStatus& status) {
     if (!stateManagerInitialized) {
@@ -71,25 +155,28 @@ void updateBCMLampState(const BCMLampStatus& status) {
         return;
     }
     
-    // Store previous value
-    vehicleState.prevPudLampRequest = vehicleState.pudLampRequest;
+    // Store previous values
+    vehicleState.previous = vehicleState.current;
     
     // Update current value
-    vehicleState.pudLampRequest = status.pudLampRequest;
-    vehicleState.lastBCMLampUpdate = millis();
+    vehicleState.current.pudLampRequest = status.pudLampRequest;
+    noteSourceUpdate(VEHICLE_MSG_BCM_LAMP, millis());
     
     // Update derived state
-    vehicleState.bedlightShouldBeOn = (vehicleState.pudLampRequest == PUDLAMP_ON || 
-                                      vehicleState.pudLampRequest == PUDLAMP_RAMP_UP);
+    vehicleState.current.bedlightShouldBeOn = BEDLIGHT_REQUEST_RULE.evaluate(vehicleState.current.pudLampRequest);
+    if (vehicleState.current.bedlightShouldBeOn != vehicleState.previous.bedlightShouldBeOn) {
+        markOutputInputChanged(OUTPUT_INPUT_BEDLIGHT);
+    }
+    publishVehicleState();
     
     // Log state changes
-    if (vehicleState.prevPudLampRequest != vehicleState.pudLampRequest) {
+    if (vehicleState.previous.pudLampRequest != vehicleState.current.pudLampRequest) {
         const char* stateNames[] = {"OFF", "ON", "RAMP_UP", "RAMP_DOWN"};
-        const char* prevName = (vehicleState.prevPudLampRequest < 4) ? stateNames[vehicleState.prevPudLampRequest] : "UNKNOWN";
-        const char* currName = (vehicleState.pudLampRequest < 4) ? stateNames[vehicleState.pudLampRequest] : "UNKNOWN";
+        const char* prevName = (vehicleState.previous.pudLampRequest < 4) ? stateNames[vehicleState.previous.pudLampRequest] : "UNKNOWN";
+        const char* currName = (vehicleState.current.pudLampRequest < 4) ? stateNames[vehicleState.current.pudLampRequest] : "UNKNOWN";
         
         LOG_INFO("PudLamp state changed: %s -> %s (bedlight should be %s)", 
-                 prevName, currName, vehicleState.bedlightShouldBeOn ? "ON" : "OFF");
+                 prevName, currName, vehicleState.current.bedlightShouldBeOn ? "ON" : "OFF");
     }
 }
 
@@ -105,32 +192,33 @@ void updateLockingSystemsState(const LockingSystemsStatus& status) {
         return;
     }
     
-    // Store previous value
-    vehicleState.prevVehicleLockStatus = vehicleState.vehicleLockStatus;
+    // Store previous values
+    vehicleState.previous = vehicleState.current;
     
     // Update current value
-    vehicleState.vehicleLockStatus = status.vehicleLockStatus;
-    vehicleState.lastLockingSystemsUpdate = millis();
+    vehicleState.current.vehicleLockStatus = status.vehicleLockStatus;
+    noteSourceUpdate(VEHICLE_MSG_LOCKING_SYSTEMS, millis());
     
     // Update derived state
-    vehicleState.isUnlocked = (vehicleState.vehicleLockStatus == VEH_UNLOCK_ALL || 
-                               vehicleState.vehicleLockStatus == VEH_UNLOCK_DRV);
+    vehicleState.current.isUnlocked = UNLOCKED_RULE.evaluate(vehicleState.current.vehicleLockStatus);
     
     // Clear manual bed light override when vehicle is locked
-    if (!vehicleState.isUnlocked && vehicleState.bedlightManualOverride) {
-        vehicleState.bedlightManualOverride = false;
-        vehicleState.bedlightManualState = false;
+    if (!vehicleState.current.isUnlocked && vehicleState.current.bedlightManualOverride) {
+        vehicleState.current.bedlightManualOverride = false;
+        vehicleState.current.bedlightManualState = false;
+        markOutputInputChanged(OUTPUT_INPUT_BEDLIGHT);
         LOG_INFO("Bed light manual override cleared due to vehicle lock");
     }
+    publishVehicleState();
     
     // Log state changes
-    if (vehicleState.prevVehicleLockStatus != vehicleState.vehicleLockStatus) {
+    if (vehicleState.previous.vehicleLockStatus != vehicleState.current.vehicleLockStatus) {
         const char* stateNames[] = {"LOCK_DBL", "LOCK_ALL", "UNLOCK_ALL", "UNLOCK_DRV"};
-        const char* prevName = (vehicleState.prevVehicleLockStatus < 4) ? stateNames[vehicleState.prevVehicleLockStatus] : "UNKNOWN";
-        const char* currName = (vehicleState.vehicleLockStatus < 4) ? stateNames[vehicleState.vehicleLockStatus] : "UNKNOWN";
+        const char* prevName = (vehicleState.previous.vehicleLockStatus < 4) ? stateNames[vehicleState.previous.vehicleLockStatus] : "UNKNOWN";
+        const char* currName = (vehicleState.current.vehicleLockStatus < 4) ? stateNames[vehicleState.current.vehicleLockStatus] : "UNKNOWN";
         
         LOG_INFO("Vehicle lock state changed: %s -> %s (unlocked: %s)", 
-                 prevName, currName, vehicleState.isUnlocked ? "YES" : "NO");
+                 prevName, currName, vehicleState.current.isUnlocked ? "YES" : "NO");
     }
 }
 
@@ -146,24 +234,25 @@ void updatePowertrainState(const PowertrainData& data) {
         return;
     }
     
-    // Store previous value
-    vehicleState.prevTransmissionParkStatus = vehicleState.transmissionParkStatus;
+    // Store previous values
+    vehicleState.previous = vehicleState.current;
     
     // Update current value
-    vehicleState.transmissionParkStatus = data.transmissionParkStatus;
-    vehicleState.lastPowertrainUpdate = millis();
+    vehicleState.current.transmissionParkStatus = data.transmissionParkStatus;
+    noteSourceUpdate(VEHICLE_MSG_POWERTRAIN, millis());
     
     // Update derived state
-    vehicleState.isParked = (vehicleState.transmissionParkStatus == TRNPRKSTS_PARK);
+    vehicleState.current.isParked = PARKED_RULE.evaluate(vehicleState.current.transmissionParkStatus);
+    publishVehicleState();
     
     // Log state changes
-    if (vehicleState.prevTransmissionParkStatus != vehicleState.transmissionParkStatus) {
+    if (vehicleState.previous.transmissionParkStatus != vehicleState.current.transmissionParkStatus) {
         const char* stateNames[] = {"UNKNOWN", "PARK", "REVERSE", "NEUTRAL", "DRIVE", "SPORT", "LOW"};
-        const char* prevName = (vehicleState.prevTransmissionParkStatus < 7) ? stateNames[vehicleState.prevTransmissionParkStatus] : "INVALID";
-        const char* currName = (vehicleState.transmissionParkStatus < 7) ? stateNames[vehicleState.transmissionParkStatus] : "INVALID";
+        const char* prevName = (vehicleState.previous.transmissionParkStatus < 7) ? stateNames[vehicleState.previous.transmissionParkStatus] : "INVALID";
+        const char* currName = (vehicleState.current.transmissionParkStatus < 7) ? stateNames[vehicleState.current.transmissionParkStatus] : "INVALID";
         
         LOG_INFO("Transmission park state changed: %s -> %s (parked: %s)", 
-                 prevName, currName, vehicleState.isParked ? "YES" : "NO");
+                 prevName, currName, vehicleState.current.isParked ? "YES" : "NO");
     }
 }
 
@@ -179,65 +268,113 @@ void updateBatteryState(const BatteryManagement& data) {
         return;
     }
     
-    // Store previous value
-    vehicleState.prevBatterySOC = vehicleState.batterySOC;
+    // Store previous values
+    vehicleState.previous = vehicleState.current;
     
     // Update current value
-    vehicleState.batterySOC = data.batterySOC;
-    vehicleState.lastBatteryUpdate = millis();
+    vehicleState.current.batterySOC = data.batterySOC;
+    noteSourceUpdate(VEHICLE_MSG_BATTERY, millis());
+    publishVehicleState();
     
     // Log significant battery changes (>5% change)
-    if (abs((int)vehicleState.prevBatterySOC - (int)vehicleState.batterySOC) >= 5) {
+    if (abs((int)vehicleState.previous.batterySOC - (int)vehicleState.current.batterySOC) >= 5) {
         LOG_INFO("Battery SOC changed significantly: %d%% -> %d%%", 
-                 vehicleState.prevBatterySOC, vehicleState.batterySOC);
+                 vehicleState.previous.batterySOC, vehicleState.current.batterySOC);
     }
 }
 
-// Check for state changes and system health
+// Freshness refresh for frames whose signal bits did not change. The values are
+// already applied, so only the timestamps used for timeout/readiness move.
+void refreshBCMLampState(unsigned long timestamp) {
+    noteSourceUpdate(VEHICLE_MSG_BCM_LAMP, timestamp);
+    publishVehicleState();
+}
+
+void refreshLockingSystemsState(unsigned long timestamp) {
+    noteSourceUpdate(VEHICLE_MSG_LOCKING_SYSTEMS, timestamp);
+    publishVehicleState();
+}
+
+void refreshPowertrainState(unsigned long timestamp) {
+    noteSourceUpdate(VEHICLE_MSG_POWERTRAIN, timestamp);
+    publishVehicleState();
+}
+
+void refreshBatteryState(unsigned long timestamp) {
+    noteSourceUpdate(VEHICLE_MSG_BATTERY, timestamp);
+    publishVehicleState();
+}
+
+static const char* const vehicleSourceNames[VEHICLE_MSG_COUNT] = {
+    "BCM lamp", "Locking systems", "Powertrain", "Battery"
+};
+
+// Check for state changes and system health. Readiness and staleness only move
+// when a source deadline passes or new data arrives, so most passes return
+// after a single comparison.
 void checkForStateChanges() {
     if (!stateManagerInitialized) {
         return;
     }
     
+    uint32_t previousStale = sourceFreshness.staleMask;
+    uint32_t previousReady = sourceFreshness.readyMask;
     unsigned long currentTime = millis();
-    bool systemWasReady = vehicleState.systemReady;
+    if (!updateFreshness(sourceFreshness, currentTime)) {
+        return;
+    }
     
-    // Check if we have recent data from ANY of the monitored systems
-    bool hasBCMData = (currentTime - vehicleState.lastBCMLampUpdate) < SYSTEM_READINESS_TIMEOUT_MS;
-    bool hasLockingData = (currentTime - vehicleState.lastLockingSystemsUpdate) < SYSTEM_READINESS_TIMEOUT_MS;
-    bool hasPowertrainData = (currentTime - vehicleState.lastPowertrainUpdate) < SYSTEM_READINESS_TIMEOUT_MS;
-    bool hasBatteryData = (currentTime - vehicleState.lastBatteryUpdate) < SYSTEM_READINESS_TIMEOUT_MS;
+    uint32_t readyMask = sourceFreshness.readyMask;
+    bool systemWasReady = vehicleState.current.systemReady;
     
     // System is ready if we have recent data from ANY of the monitored systems
-    vehicleState.systemReady = hasBCMData || hasLockingData || hasPowertrainData || hasBatteryData;
+    vehicleState.current.systemReady = readyMask != 0;
     
     // Log system readiness changes
-    if (systemWasReady != vehicleState.systemReady) {
+    if (systemWasReady != vehicleState.current.systemReady) {
+        markOutputInputChanged(OUTPUT_INPUT_SYSTEM_READY);
+        publishVehicleState();
         LOG_INFO("System readiness changed: %s (BCM:%s, Lock:%s, PT:%s, Batt:%s)",
-                 vehicleState.systemReady ? "READY" : "NOT_READY",
-                 hasBCMData ? "OK" : "TIMEOUT",
-                 hasLockingData ? "OK" : "TIMEOUT",
-                 hasPowertrainData ? "OK" : "TIMEOUT",
-                 hasBatteryData ? "OK" : "TIMEOUT");
-    }
-    
-    // Log warnings for data timeouts (only if ALL systems are timed out and system is not ready)
-    if (!vehicleState.systemReady) {
-        if (!hasBCMData && (currentTime % 30000) < 100) { // Log every 30s
-            LOG_WARN("BCM lamp data timeout (last update %lu ms ago)", currentTime - vehicleState.lastBCMLampUpdate);
-        }
-        if (!hasLockingData && (currentTime % 30000) < 100) {
-            LOG_WARN("Locking systems data timeout (last update %lu ms ago)", currentTime - vehicleState.lastLockingSystemsUpdate);
-        }
-        if (!hasPowertrainData && (currentTime % 30000) < 100) {
-            LOG_WARN("Powertrain data timeout (last update %lu ms ago)", currentTime - vehicleState.lastPowertrainUpdate);
-        }
-        if (!hasBatteryData && (currentTime % 30000) < 100) {
-            LOG_WARN("Battery data timeout (last update %lu ms ago)", currentTime - vehicleState.lastBatteryUpdate);
+                 vehicleState.current.systemReady ? "READY" : "NOT_READY",
+                 (readyMask & (1UL << VEHICLE_MSG_BCM_LAMP)) ? "OK" : "TIMEOUT",
+                 (readyMask & (1UL << VEHICLE_MSG_LOCKING_SYSTEMS)) ? "OK" : "TIMEOUT",
+                 (readyMask & (1UL << VEHICLE_MSG_POWERTRAIN)) ? "OK" : "TIMEOUT",
+                 (readyMask & (1UL << VEHICLE_MSG_BATTERY)) ? "OK" : "TIMEOUT");
+    }
+    
+    // Each transition is logged exactly once, when its deadline passes
+    uint32_t newlyStale = sourceFreshness.staleMask & ~previousStale;
+    uint32_t newlyTimedOut = previousReady & ~readyMask;
+    for (uint8_t source = 0; source < VEHICLE_MSG_COUNT; source++) {
+        uint32_t bit = 1UL << source;
+        if (newlyTimedOut & bit) {
+            LOG_WARN("%s data timeout (last update %lu ms ago)", vehicleSourceNames[source],
+                     currentTime - vehicleState.lastUpdate[source]);
+        } else if (newlyStale & bit) {
+            LOG_DEBUG("%s data stale (last update %lu ms ago)", vehicleSourceNames[source],
+                      currentTime - vehicleState.lastUpdate[source]);
         }
     }
 }
 
+// Bit VEHICLE_MSG_* set when that source has been silent for CAN_TIMEOUT_MS
+uint32_t getStaleSourceMask() {
+    return sourceFreshness.staleMask;
+}
+
+bool popVehicleSignalChange(VehicleSignalChange& change) {
+    return signalChanges.pop(change);
+}
+
+uint32_t getVehicleSignalChangeDrops() {
+    return signalChanges.getDropCount();
+}
+
+// Time until checkForStateChanges() can change anything without new data
+unsigned long getStateFreshnessIdleTime(unsigned long maxMs) {
+    return getFreshnessIdleTime(sourceFreshness, millis(), maxMs);
+}
+
 // Determine if toolbox should be activated
 bool shouldActivateToolbox() {
     if (!stateManagerInitialized) {
@@ -250,22 +387,49 @@ bool shouldActivateToolbox() {
     // 3. Vehicle must be unlocked
     // 4. Button must be pressed (checked separately)
     
-    bool conditions = vehicleState.systemReady && 
-                     vehicleState.isParked && 
-                     vehicleState.isUnlocked;
+    bool conditions = TOOLBOX_OPENER_RULE.evaluate(computeVehicleStateFlags(vehicleState.current));
     
     LOG_DEBUG("Toolbox activation conditions: ready=%s, parked=%s, unlocked=%s -> %s",
-              vehicleState.systemReady ? "YES" : "NO",
-              vehicleState.isParked ? "YES" : "NO", 
-              vehicleState.isUnlocked ? "YES" : "NO",
+              vehicleState.current.systemReady ? "YES" : "NO",
+              vehicleState.current.isParked ? "YES" : "NO", 
+              vehicleState.current.isUnlocked ? "YES" : "NO",
               conditions ? "ALLOW" : "DENY");
     
     return conditions;
 }
 
-// Get current vehicle state (read-only copy)
+// Get current vehicle state (consistent copy of the last publish)
 VehicleState getCurrentState() {
-    return vehicleState;
+    VehicleState state;
+    publishedState.read(state);
+    return state;
+}
+
+void readCurrentState(VehicleState& state) {
+    publishedState.read(state);
+}
+
+VehicleSignals getVehicleSignals() {
+    return vehicleSignalsFromWord(publishedSignals.load(std::memory_order_acquire));
+}
+
+uint32_t getVehicleStateFlags() {
+    return computeVehicleStateFlags(getVehicleSignals());
+}
+
+bool isSystemReady() {
+    return (getVehicleStateFlags() & VEHICLE_FLAG_SYSTEM_READY) != 0;
+}
+
+// Consume the dirty flags; the caller recomputes the outputs they feed
+bool hasOutputInputChanges() {
+    return outputInputChanges != 0;
+}
+
+uint8_t takeOutputInputChanges() {
+    uint8_t changes = outputInputChanges;
+    outputInputChanges = 0;
+    return changes;
 }
 
 // Reset state timeouts (useful for testing)
@@ -275,89 +439,93 @@ void resetStateTimeouts() {
     }
     
     unsigned long currentTime = millis();
-    vehicleState.lastBCMLampUpdate = currentTime;
-    vehicleState.lastLockingSystemsUpdate = currentTime;
-    vehicleState.lastPowertrainUpdate = currentTime;
-    vehicleState.lastBatteryUpdate = currentTime;
+    noteSourceUpdate(VEHICLE_MSG_BCM_LAMP, currentTime);
+    noteSourceUpdate(VEHICLE_MSG_LOCKING_SYSTEMS, currentTime);
+    noteSourceUpdate(VEHICLE_MSG_POWERTRAIN, currentTime);
+    noteSourceUpdate(VEHICLE_MSG_BATTERY, currentTime);
+    publishVehicleState();
     
     LOG_INFO("State timeouts reset");
 }
 
-// Update button state (Step 6 functionality - enhanced debouncing)
+#ifndef NATIVE_ENV
+// A release drained in the same pass as the hold before it is held back one
+// pass, so the hold stays visible to isButtonHeld() for at least one loop
+static ButtonEvent deferredButtonEvent;
+static bool buttonEventDeferred = false;
+
+static void applyButtonEvent(const ButtonEvent& event) {
+    switch (event.type) {
+        case BUTTON_EVENT_PRESS:
+            buttonState.currentState = true;
+            buttonState.rawState = true;
+            buttonState.pressed = true;
+            buttonState.lastChangeTime = event.timestamp;
+            buttonState.secondToLastPressTime = buttonState.lastPressTime;
+            buttonState.lastPressTime = event.timestamp;
+            buttonState.pressCount++;
+            buttonState.holdDuration = 0;
+            LOG_INFO("Toolbox button pressed (count: %lu)", buttonState.pressCount);
+            break;
+            
+        case BUTTON_EVENT_DOUBLE_CLICK:
+            buttonState.doubleClickDetected = true;
+            LOG_INFO("Toolbox button double-clicked (%lu ms between presses)", event.duration);
+            break;
+            
+        case BUTTON_EVENT_HOLD:
+            buttonState.isHeld = true;
+            buttonState.holdDuration = event.duration;
+            LOG_INFO("Toolbox button is being held (%lu ms)", event.duration);
+            break;
+            
+        case BUTTON_EVENT_RELEASE:
+            buttonState.currentState = false;
+            buttonState.rawState = false;
+            buttonState.released = true;
+            buttonState.lastChangeTime = event.timestamp;
+            buttonState.lastReleaseTime = event.timestamp;
+            buttonState.isHeld = false;
+            buttonState.holdDuration = 0;
+            LOG_INFO("Toolbox button released (held for %lu ms)", event.duration);
+            break;
+    }
+}
+#endif
+
+// Update button state from the debounced events posted by the button driver.
+// The pin itself is only read by the driver's debounce timer.
 void updateButtonState() {
     if (!stateManagerInitialized) {
         return;
     }
     
-    // Read raw button state (active low with pullup)
-    bool currentRawReading = !digitalRead(TOOLBOX_BUTTON_PIN);
-    unsigned long currentTime = millis();
-    
-    // Store raw state
-    buttonState.rawState = currentRawReading;
-    
-    // Store previous debounced state
     buttonState.previousState = buttonState.currentState;
     
-    // Debouncing logic: require stable state for BUTTON_DEBOUNCE_MS
-    if (currentRawReading != buttonState.currentState) {
-        // State change detected, check if it's been stable long enough
-        if ((currentTime - buttonState.lastChangeTime) >= BUTTON_DEBOUNCE_MS) {
-            // State change confirmed, update debounced state
-            buttonState.currentState = currentRawReading;
-            buttonState.lastChangeTime = currentTime;
-            
-            // Detect press event (transition from false to true)
-            if (buttonState.currentState && !buttonState.previousState) {
-                buttonState.pressed = true;
-                
-                // Check for double-click: two presses within BUTTON_DOUBLE_CLICK_MS, but not held
-                unsigned long timeSinceLastPress = currentTime - buttonState.lastPressTime;
-                if (buttonState.pressCount > 0 && 
-                    timeSinceLastPress <= BUTTON_DOUBLE_CLICK_MS && 
-                    timeSinceLastPress > BUTTON_DEBOUNCE_MS) {
-                    
-                    buttonState.doubleClickDetected = true;
-                    LOG_INFO("Toolbox button double-clicked (%lu ms between presses)", timeSinceLastPress);
-                }
-                
-                // Update press timing tracking
-                buttonState.secondToLastPressTime = buttonState.lastPressTime;
-                buttonState.lastPressTime = currentTime;
-                buttonState.pressCount++;
-                buttonState.holdDuration = 0;
-                
-                LOG_INFO("Toolbox button pressed (count: %lu)", buttonState.pressCount);
-            }
-            
-            // Detect release event (transition from true to false)
-            if (!buttonState.currentState && buttonState.previousState) {
-                buttonState.released = true;
-                buttonState.lastReleaseTime = currentTime;
-                buttonState.isHeld = false;
-                buttonState.holdDuration = 0;
-                
-                unsigned long pressDuration = currentTime - buttonState.lastPressTime;
-                LOG_INFO("Toolbox button released (held for %lu ms)", pressDuration);
-            }
+#ifndef NATIVE_ENV
+    bool heldThisPass = false;
+    ButtonEvent event;
+    
+    if (buttonEventDeferred) {
+        buttonEventDeferred = false;
+        applyButtonEvent(deferredButtonEvent);
+    }
+    while (receiveButtonEvent(event)) {
+        if (event.type == BUTTON_EVENT_RELEASE && heldThisPass) {
+            deferredButtonEvent = event;
+            buttonEventDeferred = true;
+            break;
         }
-    } else {
-        // No state change, reset the debounce timer
-        buttonState.lastChangeTime = currentTime;
+        heldThisPass = heldThisPass || event.type == BUTTON_EVENT_HOLD;
+        applyButtonEvent(event);
     }
+#endif
     
-    // Update hold status and duration
+    // Hold duration is derived from the press timestamp, not accumulated per pass
     if (buttonState.currentState) {
-        buttonState.holdDuration = currentTime - buttonState.lastPressTime;
-        
-        // Check if button is being held
-        if (buttonState.holdDuration >= BUTTON_HOLD_THRESHOLD_MS && !buttonState.isHeld) {
-            buttonState.isHeld = true;
-            LOG_INFO("Toolbox button is being held (%lu ms)", buttonState.holdDuration);
-        }
+        buttonState.holdDuration = millis() - buttonState.lastPressTime;
     } else {
         buttonState.holdDuration = 0;
-        buttonState.isHeld = false;
     }
 }
 
@@ -425,6 +593,19 @@ ButtonState getButtonState() {
     return buttonState;
 }
 
+// A button event is waiting for the next pass (see updateButtonState()); the
+// loop keeps a short idle until it has been applied
+bool isButtonActivityPending() {
+    if (!stateManagerInitialized) {
+        return false;
+    }
+#ifndef NATIVE_ENV
+    return buttonEventDeferred;
+#else
+    return false;
+#endif
+}
+
 // Check if button was double-clicked (and clear the flag)
 bool isButtonDoubleClicked() {
     if (!stateManagerInitialized) {
@@ -443,7 +624,7 @@ bool shouldProcessButtonInput() {
     }
     
     // For security reasons, only process button input when the vehicle is unlocked
-    return vehicleState.isUnlocked;
+    return vehicleState.current.isUnlocked;
 }
 
 // Toggle bed light manual override
@@ -452,18 +633,22 @@ void toggleBedlightManualOverride() {
         return;
     }
     
-    if (vehicleState.bedlightManualOverride) {
+    if (vehicleState.current.bedlightManualOverride) {
         // Currently in manual mode, toggle the manual state
-        vehicleState.bedlightManualState = !vehicleState.bedlightManualState;
+        vehicleState.current.bedlightManualState = !vehicleState.current.bedlightManualState;
+        markOutputInputChanged(OUTPUT_INPUT_BEDLIGHT);
+        publishVehicleState();
         LOG_INFO("Bed light manual override toggled: %s", 
-                 vehicleState.bedlightManualState ? "ON" : "OFF");
+                 vehicleState.current.bedlightManualState ? "ON" : "OFF");
     } else {
         // Not in manual mode, enter manual mode and set to opposite of current automatic state
-        vehicleState.bedlightManualOverride = true;
-        vehicleState.bedlightManualState = !vehicleState.bedlightShouldBeOn;
+        vehicleState.current.bedlightManualOverride = true;
+        vehicleState.current.bedlightManualState = !vehicleState.current.bedlightShouldBeOn;
+        markOutputInputChanged(OUTPUT_INPUT_BEDLIGHT);
+        publishVehicleState();
         LOG_INFO("Bed light manual override activated: %s (was automatic %s)", 
-                 vehicleState.bedlightManualState ? "ON" : "OFF",
-                 vehicleState.bedlightShouldBeOn ? "ON" : "OFF");
+                 vehicleState.current.bedlightManualState ? "ON" : "OFF",
+                 vehicleState.current.bedlightShouldBeOn ? "ON" : "OFF");
     }
 }
 
@@ -473,7 +658,7 @@ bool isBedlightManuallyOverridden() {
         return false;
     }
     
-    return vehicleState.bedlightManualOverride;
+    return vehicleState.current.bedlightManualOverride;
 }
 
 // Clear bed light manual override (return to automatic mode)
@@ -482,26 +667,34 @@ void clearBedlightManualOverride() {
         return;
     }
     
-    if (vehicleState.bedlightManualOverride) {
-        vehicleState.bedlightManualOverride = false;
-        vehicleState.bedlightManualState = false;
+    if (vehicleState.current.bedlightManualOverride) {
+        vehicleState.current.bedlightManualOverride = false;
+        vehicleState.current.bedlightManualState = false;
+        markOutputInputChanged(OUTPUT_INPUT_BEDLIGHT);
+        publishVehicleState();
         LOG_INFO("Bed light manual override cleared, returning to automatic mode");
     }
 }
 
-// Utility functions for testing - parameterized versions of the state logic
+// Parameterized versions of the state logic; all of them are rule table lookups (output_rules.h)
 bool shouldEnableBedlight(uint8_t pudLampRequest) {
-    return (pudLampRequest == PUDLAMP_ON || pudLampRequest == PUDLAMP_RAMP_UP);
+    return BEDLIGHT_REQUEST_RULE.evaluate(pudLampRequest);
 }
 
 bool isVehicleUnlocked(uint8_t vehicleLockStatus) {
-    return (vehicleLockStatus == VEH_UNLOCK_ALL || vehicleLockStatus == VEH_UNLOCK_DRV);
+    return UNLOCKED_RULE.evaluate(vehicleLockStatus);
 }
 
 bool isVehicleParked(uint8_t transmissionParkStatus) {
-    return (transmissionParkStatus == TRNPRKSTS_PARK);
+    return PARKED_RULE.evaluate(transmissionParkStatus);
 }
 
 bool shouldActivateToolboxWithParams(bool systemReady, bool isParked, bool isUnlocked) {
-    return systemReady && isParked && isUnlocked;
+    return TOOLBOX_OPENER_RULE.evaluate((systemReady ? VEHICLE_FLAG_SYSTEM_READY : 0) |
+                                        (isParked ? VEHICLE_FLAG_PARKED : 0) |
+                                        (isUnlocked ? VEHICLE_FLAG_UNLOCKED : 0));
+}
+
+bool decideBedlightOutput(uint32_t vehicleFlags) {
+    return BEDLIGHT_RULE.evaluate(vehicleFlags);
 }
@@ -4,73 +4,131 @@
 #include <Arduino.h>
 #include "config.h"
 #include "message_parser.h"
+#include <string.h>
 
-// Vehicle state structure
-struct VehicleState {
-    // Current signal values
-    uint8_t pudLampRequest;
-    uint8_t vehicleLockStatus;
-    uint8_t transmissionParkStatus;
-    uint8_t batterySOC;
-    
-    // Previous values for change detection
-    uint8_t prevPudLampRequest;
-    uint8_t prevVehicleLockStatus;
-    uint8_t prevTransmissionParkStatus;
-    uint8_t prevBatterySOC;
-    
-    // Timestamps
-    unsigned long lastBCMLampUpdate;
-    unsigned long lastLockingSystemsUpdate;
-    unsigned long lastPowertrainUpdate;
-    unsigned long lastBatteryUpdate;
+// Monitored messages, indexing VehicleState::lastUpdate
+#define VEHICLE_MSG_BCM_LAMP 0
+#define VEHICLE_MSG_LOCKING_SYSTEMS 1
+#define VEHICLE_MSG_POWERTRAIN 2
+#define VEHICLE_MSG_BATTERY 3
+#define VEHICLE_MSG_COUNT 4
+
+// Signal values and derived flags packed into one 32-bit word, so comparing,
+// change-detecting or publishing the whole value set is one word operation
+// (see vehicleSignalsWord). Widths follow the DBC; vehicleLockStatus keeps
+// 8 bits for VEH_LOCK_UNKNOWN (255).
+struct VehicleSignals {
+    uint32_t pudLampRequest : 2;
+    uint32_t transmissionParkStatus : 4;
+    uint32_t batterySOC : 7;
+    uint32_t vehicleLockStatus : 8;
     
     // State flags
-    bool isUnlocked;
-    bool isParked;
-    bool bedlightShouldBeOn;
-    bool systemReady;
+    uint32_t isUnlocked : 1;
+    uint32_t isParked : 1;
+    uint32_t bedlightShouldBeOn : 1;
+    uint32_t systemReady : 1;
     
     // Manual bed light control
-    bool bedlightManualOverride;    // True when bed lights are manually controlled
-    bool bedlightManualState;       // Manual override state (ON/OFF)
+    uint32_t bedlightManualOverride : 1;    // True when bed lights are manually controlled
+    uint32_t bedlightManualState : 1;       // Manual override state (ON/OFF)
+    uint32_t reserved : 5;
+};
+static_assert(sizeof(VehicleSignals) == sizeof(uint32_t), "VehicleSignals must stay one word");
+
+// Vehicle state structure
+struct VehicleState {
+    VehicleSignals current;
+    VehicleSignals previous;                        // Before the most recent update (change detection)
+    unsigned long lastUpdate[VEHICLE_MSG_COUNT];    // millis() of the last frame per VEHICLE_MSG_*
 };
 
-// Button state structure
+inline uint32_t vehicleSignalsWord(const VehicleSignals& signals) {
+    uint32_t word;
+    memcpy(&word, &signals, sizeof(word));
+    return word;
+}
+
+inline VehicleSignals vehicleSignalsFromWord(uint32_t word) {
+    VehicleSignals signals;
+    memcpy(&signals, &word, sizeof(signals));
+    return signals;
+}
+
+// Published signal word after a change, for streaming consumers
+struct VehicleSignalChange {
+    uint32_t timeMs;                // millis() of the publish
+    uint32_t signals;               // vehicleSignalsWord() after the change
+};
+
+// Button state structure (timestamps first, flags packed at the end)
 struct ButtonState {
-    bool currentState;              // Current debounced button state
-    bool previousState;             // Previous debounced button state
-    bool rawState;                  // Raw button reading (before debouncing)
-    bool pressed;                   // Flag: button was pressed (cleared after reading)
-    bool released;                  // Flag: button was released (cleared after reading)
-    bool isHeld;                    // Flag: button is currently being held
     unsigned long lastChangeTime;   // Time of last state change
     unsigned long lastPressTime;    // Time of last press event
     unsigned long lastReleaseTime;  // Time of last release event
+    unsigned long secondToLastPressTime;  // Time of second-to-last press for double-click detection
     unsigned long pressCount;       // Total number of button presses
     unsigned long holdDuration;     // Current hold duration (if held)
     
-    // Double-click detection
-    bool doubleClickDetected;       // Flag: double-click was detected (cleared after reading)
-    unsigned long secondToLastPressTime;  // Time of second-to-last press for double-click detection
+    bool currentState : 1;          // Current debounced button state
+    bool previousState : 1;         // Previous debounced button state
+    bool rawState : 1;              // Level reported by the button driver's last event
+    bool pressed : 1;               // Flag: button was pressed (cleared after reading)
+    bool released : 1;              // Flag: button was released (cleared after reading)
+    bool isHeld : 1;                // Flag: button is currently being held
+    bool doubleClickDetected : 1;   // Flag: double-click was detected (cleared after reading)
 };
 
+// Derived flags published as a single word (getVehicleStateFlags)
+#define VEHICLE_FLAG_SYSTEM_READY (1u << 0)
+#define VEHICLE_FLAG_PARKED (1u << 1)
+#define VEHICLE_FLAG_UNLOCKED (1u << 2)
+#define VEHICLE_FLAG_BEDLIGHT_REQUESTED (1u << 3)   // bedlightShouldBeOn
+#define VEHICLE_FLAG_MANUAL_OVERRIDE (1u << 4)
+#define VEHICLE_FLAG_MANUAL_STATE (1u << 5)
+
+// Output inputs that changed since the output logic last ran (dirty flags)
+#define OUTPUT_INPUT_BEDLIGHT (1u << 0)     // bedlightShouldBeOn or manual override state
+#define OUTPUT_INPUT_SYSTEM_READY (1u << 1) // systemReady
+#define OUTPUT_INPUT_ALL (OUTPUT_INPUT_BEDLIGHT | OUTPUT_INPUT_SYSTEM_READY)
+
 // Function declarations (to be implemented in Step 5)
 void initializeStateManager();
 void updateBCMLampState(const BCMLampStatus& status);
 void updateLockingSystemsState(const LockingSystemsStatus& status);
 void updatePowertrainState(const PowertrainData& data);
 void updateBatteryState(const BatteryManagement& data);
+// Mark a message's state fresh without re-parsing (payload unchanged since last update)
+void refreshBCMLampState(unsigned long timestamp);
+void refreshLockingSystemsState(unsigned long timestamp);
+void refreshPowertrainState(unsigned long timestamp);
+void refreshBatteryState(unsigned long timestamp);
 void checkForStateChanges();
 bool shouldActivateToolbox();
+// State readers - safe from any task/core: each returns a consistent published
+// snapshot. Prefer the single-word flag accessors when only flags are needed.
 VehicleState getCurrentState();
+void readCurrentState(VehicleState& state);
+uint32_t getVehicleStateFlags();
+VehicleSignals getVehicleSignals();   // All signal values and flags in one atomic load
+bool isSystemReady();
 void resetStateTimeouts();
+void restoreVehicleSignals(const VehicleSignals& signals);   // Last-known state after a reset (boot_state.h)
+uint8_t takeOutputInputChanges();   // Returns OUTPUT_INPUT_* set since the last call, then clears them
+bool hasOutputInputChanges();       // Any OUTPUT_INPUT_* waiting for takeOutputInputChanges()
+uint32_t getStaleSourceMask();      // Bit (1 << VEHICLE_MSG_*) set when that source exceeded CAN_TIMEOUT_MS
+unsigned long getStateFreshnessIdleTime(unsigned long maxMs);   // Until the next freshness deadline
+// Signal change journal: every change of the published signal word, oldest
+// first. Single consumer (the telemetry task); safe from any task or core.
+bool popVehicleSignalChange(VehicleSignalChange& change);
+uint32_t getVehicleSignalChangeDrops();   // Changes lost because the journal was full
 
 // Utility functions for testing - parameterized versions of state logic
 bool shouldEnableBedlight(uint8_t pudLampRequest);
 bool isVehicleUnlocked(uint8_t vehicleLockStatus);
 bool isVehicleParked(uint8_t transmissionParkStatus);
 bool shouldActivateToolboxWithParams(bool systemReady, bool isParked, bool isUnlocked);
+bool decideBedlightOutput(uint32_t vehicleFlags);   // Bed light level for a VEHICLE_FLAG_* word
 
 // Function declarations for button handling (Step 6)
 void updateButtonState();
@@ -83,6 +141,7 @@ void resetButtonPressCount();
 ButtonState getButtonState();
 bool isButtonDoubleClicked();
 bool shouldProcessButtonInput();
+bool isButtonActivityPending();    // A button event is held back for the next pass
 
 // Function declarations for bed light manual override
 void toggleBedlightManualOverride();
@@ -0,0 +1,88 @@
+#ifndef STATE_SNAPSHOT_H
+#define STATE_SNAPSHOT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Seqlock-protected snapshot of a plain struct
+ *
+ * One writer publishes complete copies; any number of readers on any core
+ * take consistent copies without locks. The sequence number is odd while a
+ * publish is in progress; a reader that sees it change (or odd) retries, so
+ * it can never return a mix of two publishes.
+ *
+ * The payload is stored as relaxed atomic words, which keeps concurrent
+ * access well-defined. Readers spin only for the duration of one publish,
+ * so the writer must not be preempted mid-publish by a reader on the same
+ * core (state_manager publishes inside a critical section on the ESP32).
+ */
+template <typename T>
+class SeqlockSnapshot {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshot type must be trivially copyable");
+
+public:
+    SeqlockSnapshot() : sequence(0) {
+        for (uint32_t i = 0; i < WORDS; i++) {
+            words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Writer side: replace the snapshot with value
+    void publish(const T& value) {
+        uint32_t raw[WORDS] = {0};
+        memcpy(raw, &value, sizeof(T));
+
+        uint32_t start = sequence.load(std::memory_order_relaxed);
+        sequence.store(start + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (uint32_t i = 0; i < WORDS; i++) {
+            words[i].store(raw[i], std::memory_order_relaxed);
+        }
+
+        sequence.store(start + 2, std::memory_order_release);
+    }
+
+    // Reader side: one attempt; false if a publish overlapped the copy
+    bool tryRead(T& out) const {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+
+        uint32_t raw[WORDS];
+        for (uint32_t i = 0; i < WORDS; i++) {
+            raw[i] = words[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+
+        memcpy(&out, raw, sizeof(T));
+        return true;
+    }
+
+    // Reader side: retry until a consistent copy is obtained
+    void read(T& out) const {
+        while (!tryRead(out)) {
+        }
+    }
+
+    // Completed publishes so far (even values only; changes on every publish)
+    uint32_t version() const {
+        return sequence.load(std::memory_order_acquire) & ~1u;
+    }
+
+private:
+    static const uint32_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> words[WORDS];
+};
+
+#endif // STATE_SNAPSHOT_H
@@ -0,0 +1,198 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include <Arduino.h>
+#include "config.h"
+#include "telemetry.h"
+
+#if ENABLE_TELEMETRY
+
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "telemetry_protocol.h"
+#include "signal_history.h"
+#include "state_manager.h"
+#include "can_manager.h"
+#include "can_dispatch.h"
+#include "can_recovery.h"
+#include "gpio_controller.h"
+#include "memory_budget.h"
+#include "logger.h"
+
+extern SystemHealth systemHealth;
+
+static TaskHandle_t telemetryTaskHandle = NULL;
+static WiFiUDP telemetrySocket;
+static TelemetryStats telemetryStats = {false, 0, 0, 0, 0, 0};
+static uint32_t telemetrySequence = 0;
+
+static void fillTelemetrySnapshot(TelemetrySnapshot& snapshot) {
+    GPIOState gpio = getGPIOState();
+    CANQueueStats queue = getCANQueueStats();
+    CANErrorStats errors = getCANErrorStats();
+    CANDispatchStats dispatch = getCANDispatchStats();
+
+    snapshot.sequence = telemetrySequence;
+    snapshot.uptimeMs = millis();
+    snapshot.signals = vehicleSignalsWord(getVehicleSignals());
+    snapshot.outputs = (gpio.bedlight ? TELEMETRY_OUTPUT_BEDLIGHT : 0) |
+                       (gpio.toolboxOpener ? TELEMETRY_OUTPUT_OPENER : 0) |
+                       (gpio.toolboxButton ? TELEMETRY_OUTPUT_BUTTON : 0) |
+                       (gpio.systemReady ? TELEMETRY_OUTPUT_SYSTEM_READY : 0);
+    snapshot.staleMask = (uint8_t)getStaleSourceMask();
+    snapshot.recoveryState = getCANRecoveryStats().state;
+    snapshot.framesDispatched = dispatch.framesDispatched;
+    snapshot.parseErrors = dispatch.parseErrors;
+    snapshot.canErrors = systemHealth.canErrors;
+    snapshot.queueDrops = queue.drops;
+    snapshot.controllerOverflows = errors.rx0Overflows + errors.rx1Overflows;
+    snapshot.changeDrops = getVehicleSignalChangeDrops();
+    snapshot.queueHighWater = queue.highWaterMark;
+}
+
+static uint8_t drainSignalChanges(VehicleSignalChange* changes) {
+    uint8_t count = 0;
+    while (count < TELEMETRY_MAX_CHANGES && popVehicleSignalChange(changes[count])) {
+        count++;
+    }
+    return count;
+}
+
+static void sendTelemetryDatagram(const VehicleSignalChange* changes, uint8_t count,
+                                  const TelemetryHistory* history) {
+    static uint8_t datagram[TELEMETRY_DATAGRAM_MAX_BYTES];
+    TelemetrySnapshot snapshot;
+    fillTelemetrySnapshot(snapshot);
+    size_t length = encodeTelemetryDatagram(snapshot, changes, count, datagram, sizeof(datagram), history);
+
+    IPAddress destination;
+    if (TELEMETRY_UDP_HOST[0] == '\0' || !destination.fromString(TELEMETRY_UDP_HOST)) {
+        destination = WiFi.broadcastIP();
+    }
+
+    telemetrySequence++;
+    if (telemetrySocket.beginPacket(destination, TELEMETRY_UDP_PORT) &&
+        telemetrySocket.write(datagram, length) == length && telemetrySocket.endPacket()) {
+        telemetryStats.datagramsSent++;
+        telemetryStats.changesSent += count;
+    } else {
+        telemetryStats.sendFailures++;
+    }
+}
+
+static void telemetryTask(void* parameter) {
+    (void)parameter;
+    VehicleSignalChange changes[TELEMETRY_MAX_CHANGES];
+    unsigned long lastSentMs = 0;
+#if ENABLE_SIGNAL_HISTORY
+    SignalHistorySlot historySlots[SIGNAL_HISTORY_TELEMETRY_SLOTS];
+    unsigned long lastHistoryMs = 0;
+    uint8_t historySignal = 0;
+#endif
+    unsigned long lastConnectMs = millis();
+    TickType_t lastWake = xTaskGetTickCount();
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(TELEMETRY_WIFI_SSID, TELEMETRY_WIFI_PASSWORD);
+
+    while (true) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(TELEMETRY_INTERVAL_MS));
+        unsigned long now = millis();
+
+        bool connected = WiFi.status() == WL_CONNECTED;
+        if (connected != telemetryStats.connected) {
+            telemetryStats.connected = connected;
+            if (connected) {
+                LOG_INFO("Telemetry: connected as %s, streaming to UDP port %d",
+                         WiFi.localIP().toString().c_str(), TELEMETRY_UDP_PORT);
+            } else {
+                LOG_WARN("Telemetry: Wi-Fi connection lost");
+            }
+        }
+
+        if (!connected) {
+            // Keep the journal from filling; the next datagram carries the current word
+            telemetryStats.changesDiscarded += drainSignalChanges(changes);
+            if (now - lastConnectMs >= TELEMETRY_RECONNECT_MS) {
+                lastConnectMs = now;
+                telemetryStats.reconnects++;
+                WiFi.reconnect();
+            }
+            continue;
+        }
+
+        // One signal's downsampled history rides on the next datagram, signals in turn
+        TelemetryHistory history = {0, 0, 0, nullptr};
+#if ENABLE_SIGNAL_HISTORY
+        if (now - lastHistoryMs >= SIGNAL_HISTORY_TELEMETRY_INTERVAL_MS) {
+            lastHistoryMs = now;
+            history.signal = historySignal;
+            history.slotMs = SIGNAL_HISTORY_TELEMETRY_WINDOW_MS / SIGNAL_HISTORY_TELEMETRY_SLOTS;
+            history.slotCount = (uint8_t)querySignalHistory(historySignal, now - SIGNAL_HISTORY_TELEMETRY_WINDOW_MS,
+                                                            history.slotMs, SIGNAL_HISTORY_TELEMETRY_SLOTS,
+                                                            historySlots);
+            history.slots = historySlots;
+            historySignal = (historySignal + 1) % SIGNAL_HISTORY_COUNT;
+        }
+#endif
+
+        // A burst larger than one datagram goes out as several in the same window
+        uint8_t count;
+        do {
+            count = drainSignalChanges(changes);
+            if (count == 0 && history.slotCount == 0 && now - lastSentMs < TELEMETRY_HEARTBEAT_MS) {
+                break;
+            }
+            sendTelemetryDatagram(changes, count, &history);
+            history.slotCount = 0;
+            lastSentMs = now;
+        } while (count == TELEMETRY_MAX_CHANGES);
+    }
+}
+
+bool startTelemetryTask() {
+    if (telemetryTaskHandle != NULL) {
+        return true;
+    }
+    if (TELEMETRY_WIFI_SSID[0] == '\0') {
+        LOG_WARN("Telemetry: TELEMETRY_WIFI_SSID not set - streaming disabled");
+        return false;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(telemetryTask, "telemetry", TELEMETRY_TASK_STACK_SIZE,
+                                                NULL, TELEMETRY_TASK_PRIORITY, &telemetryTaskHandle,
+                                                TELEMETRY_TASK_CORE);
+    if (result != pdPASS) {
+        telemetryTaskHandle = NULL;
+        LOG_ERROR("Failed to create telemetry task");
+        return false;
+    }
+    // Wi-Fi and UDP buffers come from the heap
+    registerMemoryTask(telemetryTaskHandle, "telemetry", TELEMETRY_TASK_STACK_SIZE, true);
+
+    LOG_INFO("Telemetry started (SSID '%s', port %d, %d ms batches, core=%d)",
+             TELEMETRY_WIFI_SSID, TELEMETRY_UDP_PORT, TELEMETRY_INTERVAL_MS, TELEMETRY_TASK_CORE);
+    return true;
+}
+
+TelemetryStats getTelemetryStats() {
+    return telemetryStats;
+}
+
+void printTelemetryStatus() {
+    TelemetryStats stats = telemetryStats;
+    LOG_INFO("=== TELEMETRY ===");
+    if (telemetryTaskHandle == NULL) {
+        LOG_INFO("Telemetry task not running (TELEMETRY_WIFI_SSID '%s')", TELEMETRY_WIFI_SSID);
+        return;
+    }
+    LOG_INFO("Wi-Fi: %s (SSID '%s', RSSI %d dBm), reconnect attempts %lu",
+             stats.connected ? "CONNECTED" : "DISCONNECTED", TELEMETRY_WIFI_SSID,
+             stats.connected ? (int)WiFi.RSSI() : 0, stats.reconnects);
+    LOG_INFO("Destination: %s:%d", TELEMETRY_UDP_HOST[0] ? TELEMETRY_UDP_HOST : "broadcast", TELEMETRY_UDP_PORT);
+    LOG_INFO("Datagrams: %lu sent, %lu failed; changes %lu sent, %lu discarded offline, %lu lost (journal full)",
+             stats.datagramsSent, stats.sendFailures, stats.changesSent, stats.changesDiscarded,
+             getVehicleSignalChangeDrops());
+}
+
+#endif // ENABLE_TELEMETRY
@@ -0,0 +1,34 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * UDP live telemetry (ENABLE_TELEMETRY)
+ *
+ * A FreeRTOS task keeps a Wi-Fi station connection and, every
+ * TELEMETRY_INTERVAL_MS, drains the state manager's signal change journal
+ * into one datagram (telemetry_protocol.h) together with the current signal
+ * word and health counters. With no changes it only sends a heartbeat every
+ * TELEMETRY_HEARTBEAT_MS. Every SIGNAL_HISTORY_TELEMETRY_INTERVAL_MS one
+ * datagram also carries the downsampled history of the next signal in turn.
+ * The task never touches the CAN path: it reads
+ * published state and counters only, and changes it cannot send while Wi-Fi
+ * is down are discarded (the next datagram carries the current word anyway).
+ */
+
+struct TelemetryStats {
+    bool connected;                 // Wi-Fi station associated with an IP
+    uint32_t datagramsSent;
+    uint32_t sendFailures;          // beginPacket/endPacket refused
+    uint32_t changesSent;
+    uint32_t changesDiscarded;      // Drained while Wi-Fi was down
+    uint32_t reconnects;            // Reconnect attempts after the first join
+};
+
+bool startTelemetryTask();          // No-op when TELEMETRY_WIFI_SSID is empty
+TelemetryStats getTelemetryStats();
+void printTelemetryStatus();
+
+#endif // TELEMETRY_H
@@ -0,0 +1,69 @@
+#define LOG_MODULE_ID LOG_MODULE_MAIN
+#include "telemetry_protocol.h"
+#include <string.h>
+
+static uint8_t* putU16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    return out + 2;
+}
+
+static uint8_t* putU32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+    return out + 4;
+}
+
+size_t encodeTelemetryDatagram(const TelemetrySnapshot& snapshot, const VehicleSignalChange* changes,
+                               uint8_t count, uint8_t* out, size_t capacity,
+                               const TelemetryHistory* history) {
+    uint8_t slotCount = history != nullptr ? history->slotCount : 0;
+    size_t length = TELEMETRY_HEADER_BYTES + (size_t)count * TELEMETRY_CHANGE_BYTES;
+    if (slotCount > 0) {
+        length += TELEMETRY_HISTORY_HEADER_BYTES + (size_t)slotCount * TELEMETRY_HISTORY_SLOT_BYTES;
+    }
+    if (count > TELEMETRY_MAX_CHANGES || slotCount > SIGNAL_HISTORY_TELEMETRY_SLOTS || length > capacity) {
+        return 0;
+    }
+
+    uint8_t* cursor = putU16(out, TELEMETRY_MAGIC);
+    *cursor++ = TELEMETRY_PROTOCOL_VERSION;
+    *cursor++ = count;
+    cursor = putU32(cursor, snapshot.sequence);
+    cursor = putU32(cursor, snapshot.uptimeMs);
+    cursor = putU32(cursor, snapshot.signals);
+    *cursor++ = snapshot.outputs;
+    *cursor++ = snapshot.staleMask;
+    *cursor++ = snapshot.recoveryState;
+    *cursor++ = slotCount;
+    cursor = putU32(cursor, snapshot.framesDispatched);
+    cursor = putU32(cursor, snapshot.parseErrors);
+    cursor = putU32(cursor, snapshot.canErrors);
+    cursor = putU32(cursor, snapshot.queueDrops);
+    cursor = putU32(cursor, snapshot.controllerOverflows);
+    cursor = putU32(cursor, snapshot.changeDrops);
+    cursor = putU16(cursor, snapshot.queueHighWater);
+    *cursor++ = slotCount > 0 ? history->signal : 0;
+    *cursor++ = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        cursor = putU32(cursor, changes[i].timeMs);
+        cursor = putU32(cursor, changes[i].signals);
+    }
+
+    if (slotCount > 0) {
+        cursor = putU32(cursor, history->slotMs);
+        cursor = putU32(cursor, history->slots[0].startMs);
+        for (uint8_t i = 0; i < slotCount; i++) {
+            const SignalHistorySlot& slot = history->slots[i];
+            cursor = putU16(cursor, slot.changes);
+            *cursor++ = slot.min;
+            *cursor++ = slot.max;
+            *cursor++ = slot.last;
+            *cursor++ = slot.known ? TELEMETRY_HISTORY_FLAG_KNOWN : 0;
+        }
+    }
+    return length;
+}
@@ -0,0 +1,103 @@
+#ifndef TELEMETRY_PROTOCOL_H
+#define TELEMETRY_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+#include "state_manager.h"
+#include "signal_history.h"
+
+/**
+ * Telemetry datagram (version 2)
+ *
+ * One UDP datagram carries the current signal word, the health counters and
+ * the signal changes journaled since the previous datagram. About once a
+ * minute it also carries the downsampled history of one signal
+ * (signal_history.h), taking the signals in turn. All fields are
+ * little-endian; experiments/message_watcher/can_dashboard.py --telemetry
+ * decodes them.
+ *
+ *   offset size field
+ *        0    2 magic 0xF150
+ *        2    1 version (TELEMETRY_PROTOCOL_VERSION)
+ *        3    1 change count N
+ *        4    4 sequence (+1 per datagram; gaps are lost datagrams)
+ *        8    4 uptime, ms
+ *       12    4 signal word (VehicleSignals, see below)
+ *       16    1 outputs: bit 0 bed light, 1 opener, 2 button, 3 system ready
+ *       17    1 stale source mask (1 << VEHICLE_MSG_*)
+ *       18    1 CAN recovery state (CANRecoveryState)
+ *       19    1 history slot count H (0: no history section)
+ *       20    4 frames dispatched
+ *       24    4 parse errors
+ *       28    4 CAN errors
+ *       32    4 receive queue drops
+ *       36    4 controller overflows (RX0OVR + RX1OVR)
+ *       40    4 signal changes lost (journal full)
+ *       44    2 receive queue high-water mark
+ *       46    1 history signal (SIGNAL_HISTORY_*)
+ *       47    1 reserved
+ *       48  8*N changes: 4 time (ms), 4 signal word
+ * With H > 0, after the changes:
+ *        0    4 slot width, ms
+ *        4    4 start of the first slot, ms (uptime clock)
+ *        8  6*H slots, oldest first: 2 changes, 1 min, 1 max, 1 last,
+ *               1 flags (bit 0: value known)
+ *
+ * Signal word bits, LSB first (GCC bitfield order on little-endian targets):
+ * 0-1 PudLamp_D_Rq, 2-5 TrnPrkSys_D_Actl, 6-12 BSBattSOC, 13-20
+ * Veh_Lock_Status, 21 unlocked, 22 parked, 23 bed light requested,
+ * 24 system ready, 25 manual override, 26 manual state.
+ *
+ * Pure encoding, host-testable; the sender lives in telemetry.cpp.
+ */
+
+#define TELEMETRY_MAGIC 0xF150
+#define TELEMETRY_PROTOCOL_VERSION 2
+#define TELEMETRY_HEADER_BYTES 48
+#define TELEMETRY_CHANGE_BYTES 8
+#define TELEMETRY_HISTORY_HEADER_BYTES 8
+#define TELEMETRY_HISTORY_SLOT_BYTES 6
+#define TELEMETRY_HISTORY_FLAG_KNOWN (1u << 0)
+#define TELEMETRY_DATAGRAM_MAX_BYTES (TELEMETRY_HEADER_BYTES + TELEMETRY_MAX_CHANGES * TELEMETRY_CHANGE_BYTES + \
+                                      TELEMETRY_HISTORY_HEADER_BYTES + \
+                                      SIGNAL_HISTORY_TELEMETRY_SLOTS * TELEMETRY_HISTORY_SLOT_BYTES)
+
+#define TELEMETRY_OUTPUT_BEDLIGHT (1u << 0)
+#define TELEMETRY_OUTPUT_OPENER (1u << 1)
+#define TELEMETRY_OUTPUT_BUTTON (1u << 2)
+#define TELEMETRY_OUTPUT_SYSTEM_READY (1u << 3)
+
+// Header fields, gathered by the sender
+struct TelemetrySnapshot {
+    uint32_t sequence;
+    uint32_t uptimeMs;
+    uint32_t signals;               // vehicleSignalsWord()
+    uint8_t outputs;                // TELEMETRY_OUTPUT_*
+    uint8_t staleMask;
+    uint8_t recoveryState;
+    uint32_t framesDispatched;
+    uint32_t parseErrors;
+    uint32_t canErrors;
+    uint32_t queueDrops;
+    uint32_t controllerOverflows;
+    uint32_t changeDrops;
+    uint16_t queueHighWater;
+};
+
+// History section of one signal; slotCount 0 leaves it out
+struct TelemetryHistory {
+    uint8_t signal;                 // SIGNAL_HISTORY_*
+    uint8_t slotCount;
+    uint32_t slotMs;
+    const SignalHistorySlot* slots; // querySignalHistory() result
+};
+
+// Returns the datagram length, or 0 when count exceeds TELEMETRY_MAX_CHANGES,
+// the history exceeds SIGNAL_HISTORY_TELEMETRY_SLOTS or the datagram does not
+// fit capacity
+size_t encodeTelemetryDatagram(const TelemetrySnapshot& snapshot, const VehicleSignalChange* changes,
+                               uint8_t count, uint8_t* out, size_t capacity,
+                               const TelemetryHistory* history = nullptr);
+
+#endif // TELEMETRY_PROTOCOL_H
@@ -0,0 +1,224 @@
+#define LOG_MODULE_ID LOG_MODULE_TWAI
+#include "twai_controller.h"
+#include "driver/twai.h"
+#include <esp_timer.h>
+
+// TWAI driver configuration - listen-only, deep RX queue, no TX queue.
+// The bench stress loopback transmits, without needing an ACK, and receives
+// its own frames (can_stress.h).
+static const twai_general_config_t twaiGeneralConfig = {
+#if ENABLE_CAN_STRESS_LOOPBACK
+    .mode = TWAI_MODE_NO_ACK,
+#else
+    .mode = TWAI_MODE_LISTEN_ONLY,
+#endif
+    .tx_io = (gpio_num_t)TWAI_TX_PIN,
+    .rx_io = (gpio_num_t)TWAI_RX_PIN,
+    .clkout_io = TWAI_IO_UNUSED,
+    .bus_off_io = TWAI_IO_UNUSED,
+#if ENABLE_CAN_STRESS_LOOPBACK
+    .tx_queue_len = CAN_STRESS_TX_QUEUE_LEN,
+#else
+    .tx_queue_len = 0,
+#endif
+    .rx_queue_len = TWAI_RX_QUEUE_LEN,
+    .alerts_enabled = TWAI_ALERT_ERR_PASS | TWAI_ALERT_BUS_ERROR | TWAI_ALERT_RX_QUEUE_FULL,
+    .clkout_divider = 0,
+    .intr_flags = ESP_INTR_FLAG_LEVEL1
+};
+
+static const twai_timing_config_t twaiTimingConfig = TWAI_TIMING_CONFIG_500KBITS();
+
+// The TWAI acceptance filter cannot express four unrelated 11-bit IDs exactly,
+// so accept everything in hardware and filter in readTWAIFrame()
+static const twai_filter_config_t twaiFilterConfig = {
+    .acceptance_code = 0x00000000,
+    .acceptance_mask = 0xFFFFFFFF,
+    .single_filter = true
+};
+
+// TWAI state
+static bool twaiInitialized = false;
+static uint32_t framesReceived = 0;
+static uint32_t framesFiltered = 0;
+static uint32_t receiveErrors = 0;
+static uint32_t errorPassiveAlerts = 0;
+static uint32_t busErrorAlerts = 0;
+static uint32_t queueFullAlerts = 0;
+static unsigned long lastFrameTime = 0;
+
+bool initializeTWAI() {
+#if ENABLE_CAN_STRESS_LOOPBACK
+    LOG_WARN("Initializing CAN bus (TWAI) in NO-ACK LOOPBACK mode - transmits on X1, bench use only");
+#else
+    LOG_INFO("Initializing CAN bus (TWAI) in LISTEN-ONLY mode...");
+#endif
+    LOG_INFO("Using X1 header (CAN1H/CAN1L) with built-in TWAI controller");
+
+    if (twaiInitialized) {
+        LOG_WARN("TWAI driver already initialized");
+        return true;
+    }
+
+    esp_err_t result = twai_driver_install(&twaiGeneralConfig, &twaiTimingConfig, &twaiFilterConfig);
+    if (result != ESP_OK) {
+        LOG_ERROR("Failed to install TWAI driver: %s", esp_err_to_name(result));
+        return false;
+    }
+
+    result = twai_start();
+    if (result != ESP_OK) {
+        LOG_ERROR("Failed to start TWAI driver: %s", esp_err_to_name(result));
+        twai_driver_uninstall();
+        return false;
+    }
+
+    twaiInitialized = true;
+    LOG_INFO("TWAI initialized successfully (RX=%d, TX=%d, rx_queue_len=%d)",
+             TWAI_RX_PIN, TWAI_TX_PIN, TWAI_RX_QUEUE_LEN);
+    return true;
+}
+
+bool readTWAIFrame(CANMessage& message) {
+    if (!twaiInitialized) {
+        return false;
+    }
+
+    twai_message_t frame;
+
+    // Skip frames we never process without returning to the caller
+    while (true) {
+        esp_err_t result = twai_receive(&frame, 0);
+
+        if (result == ESP_ERR_TIMEOUT) {
+            return false; // RX queue empty
+        }
+        if (result != ESP_OK) {
+            receiveErrors++;
+            LOG_DEBUG("TWAI receive error: %s", esp_err_to_name(result));
+            return false;
+        }
+
+        // Only 11-bit data frames are monitored
+        if (frame.extd || frame.rtr) {
+            framesFiltered++;
+            continue;
+        }
+
+        // Follow the MCP2515 filter mode; while planned, only the wanted IDs pass
+        if (!areCANFiltersOpen() && !isTargetCANMessage(frame.identifier)) {
+            framesFiltered++;
+            continue;
+        }
+        break;
+    }
+
+    uint8_t length = frame.data_length_code > 8 ? 8 : frame.data_length_code;
+
+    message.id = frame.identifier;
+    message.length = length;
+    memcpy(message.data, frame.data, length);
+    message.timestamp = millis();
+    message.source = CAN_SOURCE_TWAI;
+    message.arrivalUs = (uint32_t)esp_timer_get_time();   // Driver queue carries no receive time
+
+    framesReceived++;
+    lastFrameTime = message.timestamp;
+    return true;
+}
+
+void pollTWAIAlerts() {
+    if (!twaiInitialized) {
+        return;
+    }
+
+    uint32_t alerts = 0;
+    if (twai_read_alerts(&alerts, 0) != ESP_OK) {
+        return; // None raised since the last poll
+    }
+    if (alerts & TWAI_ALERT_ERR_PASS) {
+        errorPassiveAlerts++;
+        LOG_WARN("TWAI controller entered error passive");
+    }
+    if (alerts & TWAI_ALERT_BUS_ERROR) {
+        busErrorAlerts++;
+    }
+    if (alerts & TWAI_ALERT_RX_QUEUE_FULL) {
+        queueFullAlerts++;
+    }
+}
+
+#if ENABLE_CAN_STRESS_LOOPBACK
+bool transmitTWAIFrame(const CANMessage& message, uint32_t timeoutMs) {
+    if (!twaiInitialized) {
+        return false;
+    }
+
+    twai_message_t frame = {};
+    frame.self = 1;                     // Received back through readTWAIFrame()
+    frame.identifier = message.id;
+    frame.data_length_code = message.length > 8 ? 8 : message.length;
+    memcpy(frame.data, message.data, frame.data_length_code);
+    return twai_transmit(&frame, pdMS_TO_TICKS(timeoutMs)) == ESP_OK;
+}
+#endif
+
+bool isTWAIActive() {
+    return twaiInitialized;
+}
+
+unsigned long getTWAILastFrameTime() {
+    return lastFrameTime;
+}
+
+TWAIStats getTWAIStats() {
+    TWAIStats stats = {};
+    stats.initialized = twaiInitialized;
+    stats.framesReceived = framesReceived;
+    stats.framesFiltered = framesFiltered;
+    stats.receiveErrors = receiveErrors;
+    stats.errorPassiveAlerts = errorPassiveAlerts;
+    stats.busErrorAlerts = busErrorAlerts;
+    stats.queueFullAlerts = queueFullAlerts;
+    stats.lastFrameTime = lastFrameTime;
+
+    twai_status_info_t status;
+    if (twaiInitialized && twai_get_status_info(&status) == ESP_OK) {
+        stats.state = (uint8_t)status.state;
+        stats.queueDepth = status.msgs_to_rx;
+        stats.rxMissed = status.rx_missed_count;
+        stats.rxOverrun = status.rx_overrun_count;
+        stats.busErrors = status.bus_error_count;
+        stats.rxErrorCounter = status.rx_error_counter;
+    }
+
+    return stats;
+}
+
+void resetTWAIStatistics() {
+    framesReceived = 0;
+    framesFiltered = 0;
+    receiveErrors = 0;
+    errorPassiveAlerts = 0;
+    busErrorAlerts = 0;
+    queueFullAlerts = 0;
+}
+
+void printTWAIStatistics() {
+    TWAIStats stats = getTWAIStats();
+
+    LOG_INFO("TWAI Statistics (X1 header, %s Mode):", ENABLE_CAN_STRESS_LOOPBACK ? "No-ACK Loopback" : "Listen-Only");
+    LOG_INFO("  Initialized: %s", stats.initialized ? "Yes" : "No");
+    if (!stats.initialized) {
+        return;
+    }
+    LOG_INFO("  State: %d (0=STOPPED, 1=RUNNING, 2=BUS_OFF, 3=RECOVERING)", stats.state);
+    LOG_INFO("  Frames Received: %lu (filtered: %lu)", stats.framesReceived, stats.framesFiltered);
+    LOG_INFO("  Driver RX Queue: %d/%d frames", stats.queueDepth, TWAI_RX_QUEUE_LEN);
+    LOG_INFO("  RX Missed (queue full): %lu, RX Overrun: %lu", stats.rxMissed, stats.rxOverrun);
+    LOG_INFO("  Bus Errors: %lu, REC: %lu, Receive Errors: %lu",
+             stats.busErrors, stats.rxErrorCounter, stats.receiveErrors);
+    LOG_INFO("  Alerts: error passive %lu, bus error %lu, RX queue full %lu",
+             stats.errorPassiveAlerts, stats.busErrorAlerts, stats.queueFullAlerts);
+    LOG_INFO("  Last Frame: %lu ms ago", millis() - stats.lastFrameTime);
+}
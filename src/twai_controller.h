@@ -0,0 +1,44 @@
+#ifndef TWAI_CONTROLLER_H
+#define TWAI_CONTROLLER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "can_manager.h"
+
+// ESP32-S3 built-in TWAI controller on the X1 header (CAN1H/CAN1L)
+// The driver keeps received frames in its own RX queue (TWAI_RX_QUEUE_LEN deep),
+// so frames are fetched without any SPI traffic.
+
+// TWAI receive statistics
+struct TWAIStats {
+    bool initialized;
+    uint8_t state;                  // twai_state_t (0=STOPPED, 1=RUNNING, 2=BUS_OFF, 3=RECOVERING)
+    uint16_t queueDepth;            // Frames waiting in the driver RX queue
+    uint32_t framesReceived;        // Frames accepted into the software queue path
+    uint32_t framesFiltered;        // Frames discarded by the software ID filter
+    uint32_t receiveErrors;         // twai_receive() failures other than timeout
+    uint32_t errorPassiveAlerts;    // TWAI_ALERT_ERR_PASS raised by the driver
+    uint32_t busErrorAlerts;        // Reads with TWAI_ALERT_BUS_ERROR raised (busErrors has the exact count)
+    uint32_t queueFullAlerts;       // Reads with TWAI_ALERT_RX_QUEUE_FULL raised (rxMissed has the exact count)
+    uint32_t rxMissed;              // Frames lost because the driver RX queue was full
+    uint32_t rxOverrun;             // Frames lost to hardware FIFO overrun
+    uint32_t busErrors;             // Bus errors reported by the driver
+    uint32_t rxErrorCounter;        // REC
+    unsigned long lastFrameTime;    // millis() of the last accepted frame
+};
+
+// Function declarations
+bool initializeTWAI();
+bool readTWAIFrame(CANMessage& message);   // Non-blocking; false when the RX queue is empty
+void pollTWAIAlerts();                     // Non-blocking; counts the alerts raised since the last poll
+#if ENABLE_CAN_STRESS_LOOPBACK
+// Queue a frame with self reception (bench loopback); false when the TX queue stayed full
+bool transmitTWAIFrame(const CANMessage& message, uint32_t timeoutMs);
+#endif
+bool isTWAIActive();
+unsigned long getTWAILastFrameTime();
+TWAIStats getTWAIStats();
+void resetTWAIStatistics();
+void printTWAIStatistics();
+
+#endif // TWAI_CONTROLLER_H
@@ -23,4 +23,42 @@ public:
     unsigned long millis() override {
         return ArduinoMock::instance().getMillis();
     }
+    
+    // LEDC channels: attached pin and last written duty
+    bool setupPWM(uint8_t pin, uint8_t channel, uint32_t frequencyHz, uint8_t resolutionBits) override {
+        if (channel >= 16) {
+            return false;
+        }
+        pwmPin[channel] = pin;
+        pwmFrequencyHz[channel] = frequencyHz;
+        pwmResolutionBits[channel] = resolutionBits;
+        return true;
+    }
+    
+    void writePWM(uint8_t channel, uint32_t duty) override {
+        if (channel < 16) {
+            pwmDuty[channel] = duty;
+            pwmWrites++;
+        }
+    }
+    
+    // LEDC fade engine: records the ramp and reports the target duty at once
+    bool fadePWM(uint8_t channel, uint32_t duty, uint32_t fadeMs) override {
+        if (!fadeSupported || channel >= 16) {
+            return false;
+        }
+        pwmDuty[channel] = duty;
+        pwmFadeMs[channel] = fadeMs;
+        pwmFades++;
+        return true;
+    }
+    
+    uint8_t pwmPin[16] = {0};
+    uint32_t pwmFrequencyHz[16] = {0};
+    uint8_t pwmResolutionBits[16] = {0};
+    uint32_t pwmDuty[16] = {0};
+    uint32_t pwmWrites = 0;
+    uint32_t pwmFadeMs[16] = {0};
+    uint32_t pwmFades = 0;
+    bool fadeSupported = true;
 };
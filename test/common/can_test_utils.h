@@ -28,7 +28,7 @@ public:
      * @return CANFrame structure ready for parsing
      */
     static CANFrame createCANFrame(uint32_t id, const uint8_t data[8]) {
-        CANFrame frame;
+        CANFrame frame = {};
         frame.id = id;
         frame.length = 8;
         memcpy(frame.data, data, 8);
@@ -45,7 +45,7 @@ public:
      */
     static CANFrame createCANFrame(uint32_t id, uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3,
                                    uint8_t b4, uint8_t b5, uint8_t b6, uint8_t b7) {
-        CANFrame frame;
+        CANFrame frame = {};
         frame.id = id;
         frame.length = 8;
         frame.data[0] = b0; frame.data[1] = b1; frame.data[2] = b2; frame.data[3] = b3;
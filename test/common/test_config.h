@@ -62,7 +62,8 @@
 #define DEBUG_LEVEL DEBUG_LEVEL_INFO
 #endif
 
-// Logging macros for testing (captured by mock)
+// Logging macros for testing (captured by mock); src/config.h may have defined them first
+#ifndef LOG_ERROR
 #if DEBUG_LEVEL >= DEBUG_LEVEL_ERROR
 #define LOG_ERROR(format, ...) Serial.printf("[ERROR] " format "\n", ##__VA_ARGS__)
 #else
@@ -86,6 +87,7 @@
 #else
 #define LOG_DEBUG(format, ...)
 #endif
+#endif // LOG_ERROR
 
 #else
 // Include the original config for embedded builds
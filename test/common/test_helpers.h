@@ -15,17 +15,6 @@ extern "C" {
     #include "../../src/bit_utils.h"
 }
 
-// Helper function to convert CANFrame to CANMessage for any future production function usage
-inline CANMessage convertToCANMessage(const CANFrame& frame) {
-    CANMessage message;
-    message.id = frame.id;
-    message.length = frame.length;
-    for (int i = 0; i < frame.length && i < 8; i++) {
-        message.data[i] = frame.data[i];
-    }
-    return message;
-}
-
 // Test helper class for Arduino mock setup/teardown
 class ArduinoTest : public ::testing::Test {
 protected:
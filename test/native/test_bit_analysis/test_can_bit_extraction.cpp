@@ -411,4 +411,89 @@ TEST_F(CANBitExtractionTest, CrossValidationWithPythonLogic) {
     }
 }
 
+// ===============================================
+// Test Suite: Single-load word extraction and batched extraction
+// ===============================================
+
+// Previous extractBits() implementation: rebuilds the payload word on every call
+static uint8_t legacyExtractBits(const uint8_t* data, uint8_t startBit, uint8_t length) {
+    if (length > 8 || startBit > 63) return 0;
+    
+    uint64_t data_int = 0;
+    for (int i = 0; i < 8; i++) {
+        data_int |= ((uint64_t)data[i]) << (i * 8);
+    }
+    
+    uint8_t bit_pos = startBit - length + 1;
+    uint64_t mask = (1ULL << length) - 1;
+    return (data_int >> bit_pos) & mask;
+}
+
+TEST_F(CANBitExtractionTest, WordExtractionMatchesLegacy) {
+    uint8_t data[8];
+    uint32_t seed = 0x1234567;
+    
+    for (int frame = 0; frame < 500; frame++) {
+        for (int i = 0; i < 8; i++) {
+            seed = seed * 1103515245 + 12345;
+            data[i] = (uint8_t)(seed >> 16);
+        }
+        
+        uint64_t word = loadCANWord(data);
+        for (uint8_t length = 1; length <= 8; length++) {
+            for (uint8_t startBit = length - 1; startBit < 64; startBit++) {
+                ASSERT_EQ(extractBitsFromWord(word, startBit, length), legacyExtractBits(data, startBit, length))
+                    << "startBit=" << (int)startBit << " length=" << (int)length;
+                ASSERT_EQ(extractBits(data, startBit, length), legacyExtractBits(data, startBit, length));
+            }
+        }
+    }
+    
+    // Fields that would start below bit 0 are rejected instead of shifting by a wrapped amount
+    EXPECT_EQ(extractBitsFromWord(~0ULL, 2, 4), 0u);
+    EXPECT_EQ(extractBitsFromWord(~0ULL, 31, 32), 0xFFFFFFFFu);
+}
+
+TEST_F(CANBitExtractionTest, BatchedExtractSignals) {
+    // BCM_Lamp_Stat_FD1 signals from the Python implementation
+    uint8_t bcmData[8] = {0x40, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0xC0};
+    const SignalBits bcmSignals[] = {
+        {11, 2},    // PudLamp_D_Rq
+        {63, 2},    // Illuminated_Entry_Stat
+        {49, 2},    // Dr_Courtesy_Light_Stat
+    };
+    uint32_t values[3] = {0xFF, 0xFF, 0xFF};
+    
+    extractSignals(bcmData, bcmSignals, values, 3);
+    
+    EXPECT_EQ(values[0], extractBits(bcmData, 11, 2));
+    EXPECT_EQ(values[1], extractBits(bcmData, 63, 2));
+    EXPECT_EQ(values[2], extractBits(bcmData, 49, 2));
+    EXPECT_EQ(values[0], 2u);
+    EXPECT_EQ(values[1], 3u);
+    EXPECT_EQ(values[2], 2u);
+}
+
+TEST_F(CANBitExtractionTest, ExtractionPathsAgree) {
+    // Three BCM_Lamp_Stat_FD1 signals per frame, as in parseBCMLampStatus();
+    // bench/bench_kernels.cpp times the same three paths
+    uint8_t data[8] = {0x40, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0xC0};
+    const SignalBits signals[] = {{11, 2}, {63, 2}, {49, 2}};
+    
+    for (int i = 0; i < 256 * 4; i++) {
+        data[0] = (uint8_t)i;
+        data[6] = (uint8_t)(i >> 2);
+        data[7] = (uint8_t)(i * 37);
+        uint64_t word = loadCANWord(data);
+        uint32_t values[3];
+        extractSignals(data, signals, values, 3);
+        
+        for (int s = 0; s < 3; s++) {
+            uint32_t legacy = legacyExtractBits(data, signals[s].startBit, signals[s].length);
+            ASSERT_EQ(extractBitsFromWord(word, signals[s].startBit, signals[s].length), legacy) << "frame " << i;
+            ASSERT_EQ(values[s], legacy) << "frame " << i;
+        }
+    }
+}
+
 // Main function removed - using unified test runner in test_main.cpp
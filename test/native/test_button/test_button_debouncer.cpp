@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production button debounce state machine
+#include "../src/button_driver.h"
+
+/**
+ * Button Debouncer Test Suite
+ *
+ * Validates the state machine run from the button driver's debounce timer:
+ * - A settled level change emits exactly one press or release
+ * - Hold is reported once, at the threshold, and the timer is armed for it
+ * - Double-click is detected from press timestamps, not loop timing
+ * - A button already down at boot is neither a press nor a hold
+ */
+
+class ButtonDebouncerTest : public ::testing::Test {
+protected:
+    ButtonDebouncer debouncer;
+    ButtonEvent events[BUTTON_DEBOUNCER_MAX_EVENTS];
+
+    void SetUp() override {
+        initButtonDebouncer(debouncer, false);
+    }
+
+    uint8_t sample(bool pressed, unsigned long now) {
+        return updateButtonDebouncer(debouncer, pressed, now, events, BUTTON_DEBOUNCER_MAX_EVENTS);
+    }
+};
+
+TEST_F(ButtonDebouncerTest, PressAndReleaseEmitOnce) {
+    ASSERT_EQ(sample(true, 1000), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_PRESS);
+    EXPECT_EQ(events[0].timestamp, 1000u);
+
+    // Same level again (bounce that settled back) is not an event
+    EXPECT_EQ(sample(true, 1060), 0);
+
+    ASSERT_EQ(sample(false, 1200), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_RELEASE);
+    EXPECT_EQ(events[0].duration, 200u);
+    EXPECT_EQ(getButtonDebouncerTimeout(debouncer, 1200), 0u);
+}
+
+TEST_F(ButtonDebouncerTest, HoldReportedAtThreshold) {
+    sample(true, 1000);
+    EXPECT_EQ(getButtonDebouncerTimeout(debouncer, 1000), (unsigned long)BUTTON_HOLD_THRESHOLD_MS);
+    EXPECT_EQ(getButtonDebouncerTimeout(debouncer, 1400), (unsigned long)BUTTON_HOLD_THRESHOLD_MS - 400);
+
+    EXPECT_EQ(sample(true, 1000 + BUTTON_HOLD_THRESHOLD_MS - 1), 0);
+    ASSERT_EQ(sample(true, 1000 + BUTTON_HOLD_THRESHOLD_MS), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_HOLD);
+    EXPECT_EQ(events[0].duration, (unsigned long)BUTTON_HOLD_THRESHOLD_MS);
+
+    // Only once per press, and no further timer needed
+    EXPECT_EQ(sample(true, 1000 + 2 * BUTTON_HOLD_THRESHOLD_MS), 0);
+    EXPECT_EQ(getButtonDebouncerTimeout(debouncer, 1000 + 2 * BUTTON_HOLD_THRESHOLD_MS), 0u);
+
+    ASSERT_EQ(sample(false, 3000), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_RELEASE);
+    EXPECT_EQ(events[0].duration, 2000u);
+}
+
+TEST_F(ButtonDebouncerTest, DoubleClickFromPressInterval) {
+    sample(true, 1000);
+    sample(false, 1100);
+    ASSERT_EQ(sample(true, 1000 + BUTTON_DOUBLE_CLICK_MS), 2);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_PRESS);
+    EXPECT_EQ(events[1].type, BUTTON_EVENT_DOUBLE_CLICK);
+    EXPECT_EQ(events[1].duration, (unsigned long)BUTTON_DOUBLE_CLICK_MS);
+
+    // Too slow for a double-click
+    sample(false, 1400);
+    ASSERT_EQ(sample(true, 1400 + BUTTON_DOUBLE_CLICK_MS + 1), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_PRESS);
+}
+
+TEST_F(ButtonDebouncerTest, FirstPressIsNeverDoubleClick) {
+    ASSERT_EQ(sample(true, 100), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_PRESS);
+}
+
+TEST_F(ButtonDebouncerTest, PressedAtBootIsIgnored) {
+    initButtonDebouncer(debouncer, true);
+    EXPECT_EQ(getButtonDebouncerTimeout(debouncer, 5000), 0u);
+    EXPECT_EQ(sample(true, 5000), 0);
+
+    ASSERT_EQ(sample(false, 6000), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_RELEASE);
+
+    ASSERT_EQ(sample(true, 7000), 1);
+    EXPECT_EQ(events[0].type, BUTTON_EVENT_PRESS);
+}
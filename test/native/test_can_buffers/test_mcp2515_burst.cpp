@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production MCP2515 burst read helpers
+#include "../src/mcp2515_burst.h"
+
+/**
+ * MCP2515 Burst Read Test Suite
+ *
+ * Validates the host-side half of the READ RX BUFFER receive path:
+ * - Receive buffer headers decode to the same IDs and flags as the library
+ *   (standard, extended, standard and extended remote frames)
+ * - A DLC above 8 is rejected
+ * - The SPI accounting charges one transaction and 6 + DLC bytes per burst
+ *   frame, against four transactions and 16 + DLC bytes through readMessage()
+ */
+
+class MCP2515BurstTest : public ::testing::Test {
+protected:
+    CANFrame frame = {};
+};
+
+TEST_F(MCP2515BurstTest, DecodesStandardHeader) {
+    // 0x3B3 = SIDH 0x76, SIDL 0x60
+    const uint8_t header[MCP2515_RX_HEADER_BYTES] = {0x76, 0x60, 0x00, 0x00, 0x08};
+    ASSERT_TRUE(decodeMCP2515RxHeader(header, frame));
+    EXPECT_EQ(frame.id, 0x3B3u);
+    EXPECT_EQ(frame.length, 8);
+}
+
+TEST_F(MCP2515BurstTest, DecodesExtendedHeader) {
+    // 0x18FEF100: SID 0x63F, EID 0x2F100
+    const uint8_t header[MCP2515_RX_HEADER_BYTES] = {0xC7, 0xEA, 0xF1, 0x00, 0x03};
+    ASSERT_TRUE(decodeMCP2515RxHeader(header, frame));
+    EXPECT_EQ(frame.id, 0x18FEF100u | MCP2515_ID_EXTENDED_FLAG);
+    EXPECT_EQ(frame.length, 3);
+}
+
+TEST_F(MCP2515BurstTest, FlagsRemoteFrames) {
+    const uint8_t standardRemote[MCP2515_RX_HEADER_BYTES] = {0x76, 0x70, 0x00, 0x00, 0x00};
+    ASSERT_TRUE(decodeMCP2515RxHeader(standardRemote, frame));
+    EXPECT_EQ(frame.id, 0x3B3u | MCP2515_ID_REMOTE_FLAG);
+
+    // Extended frames carry RTR in the DLC register; SIDL bit 4 is SRR there
+    const uint8_t extendedRemote[MCP2515_RX_HEADER_BYTES] = {0xC7, 0xEA, 0xF1, 0x00, 0x40};
+    ASSERT_TRUE(decodeMCP2515RxHeader(extendedRemote, frame));
+    EXPECT_EQ(frame.id, 0x18FEF100u | MCP2515_ID_EXTENDED_FLAG | MCP2515_ID_REMOTE_FLAG);
+    EXPECT_EQ(frame.length, 0);
+
+    const uint8_t extendedData[MCP2515_RX_HEADER_BYTES] = {0xC7, 0xFA, 0xF1, 0x00, 0x08};
+    ASSERT_TRUE(decodeMCP2515RxHeader(extendedData, frame));
+    EXPECT_EQ(frame.id & MCP2515_ID_REMOTE_FLAG, 0u);
+}
+
+TEST_F(MCP2515BurstTest, RejectsOversizedDlc) {
+    const uint8_t header[MCP2515_RX_HEADER_BYTES] = {0x76, 0x60, 0x00, 0x00, 0x0F};
+    EXPECT_FALSE(decodeMCP2515RxHeader(header, frame));
+}
+
+TEST_F(MCP2515BurstTest, CountsBurstAgainstLibraryCost) {
+    MCP2515SpiStats stats = {};
+    frame.length = 8;
+    noteMCP2515StatusRead(stats, true);
+    noteMCP2515FrameRead(stats, frame, true);
+    EXPECT_EQ(stats.frames, 1u);
+    EXPECT_EQ(stats.drainPasses, 1u);
+    EXPECT_EQ(stats.bytes, 4u + 14u);
+    EXPECT_EQ(stats.transactions, 2u);
+    EXPECT_EQ(stats.libraryBytes, 3u + 24u);
+    EXPECT_EQ(stats.libraryTransactions, 5u);
+
+    frame.length = 0;
+    noteMCP2515FrameRead(stats, frame, true);
+    EXPECT_EQ(stats.bytes, 18u + 6u);
+    EXPECT_EQ(stats.transactions, 3u);
+}
+
+TEST_F(MCP2515BurstTest, LibraryPathCountsLibraryCost) {
+    MCP2515SpiStats stats = {};
+    frame.length = 8;
+    noteMCP2515StatusRead(stats, false);
+    noteMCP2515FrameRead(stats, frame, false);
+    EXPECT_EQ(stats.bytes, stats.libraryBytes);
+    EXPECT_EQ(stats.transactions, stats.libraryTransactions);
+}
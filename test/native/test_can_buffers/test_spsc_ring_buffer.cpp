@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <thread>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production ring buffer and CAN message structure
+#include "../src/can_ring_buffer.h"
+#include "../src/can_manager.h"
+
+/**
+ * SPSC Ring Buffer Test Suite
+ *
+ * Validates the software receive queue that sits between the CAN receive
+ * path and the parsing loop: FIFO order, wrap-around, drop accounting when
+ * full, high-water mark tracking, in-place reserve/commit and front/release,
+ * runs of frames for the batch consumer, and correctness with a real producer thread racing a consumer thread.
+ */
+
+class SPSCRingBufferTest : public ::testing::Test {
+protected:
+    static CANMessage makeMessage(uint32_t id, uint8_t seq) {
+        CANMessage message = {};
+        message.id = id;
+        message.length = 8;
+        message.data[0] = seq;
+        message.data[7] = seq;
+        message.timestamp = seq;
+        return message;
+    }
+};
+
+TEST_F(SPSCRingBufferTest, StartsEmpty) {
+    SPSCRingBuffer<CANMessage, 8> ring;
+    CANMessage message;
+
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.size(), 0);
+    EXPECT_EQ(ring.capacity(), 8);
+    EXPECT_FALSE(ring.pop(message));
+    EXPECT_EQ(ring.getDropCount(), 0u);
+    EXPECT_EQ(ring.getHighWaterMark(), 0);
+}
+
+TEST_F(SPSCRingBufferTest, PreservesFIFOOrder) {
+    SPSCRingBuffer<CANMessage, 8> ring;
+
+    EXPECT_TRUE(ring.push(makeMessage(BCM_LAMP_STAT_FD1_ID, 1)));
+    EXPECT_TRUE(ring.push(makeMessage(LOCKING_SYSTEMS_2_FD1_ID, 2)));
+    EXPECT_TRUE(ring.push(makeMessage(POWERTRAIN_DATA_10_ID, 3)));
+    EXPECT_EQ(ring.size(), 3);
+
+    CANMessage message;
+    ASSERT_TRUE(ring.pop(message));
+    EXPECT_EQ(message.id, BCM_LAMP_STAT_FD1_ID);
+    EXPECT_EQ(message.data[0], 1);
+    ASSERT_TRUE(ring.pop(message));
+    EXPECT_EQ(message.id, LOCKING_SYSTEMS_2_FD1_ID);
+    ASSERT_TRUE(ring.pop(message));
+    EXPECT_EQ(message.id, POWERTRAIN_DATA_10_ID);
+    EXPECT_EQ(message.data[7], 3);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(SPSCRingBufferTest, WrapsAroundCapacity) {
+    SPSCRingBuffer<CANMessage, 4> ring;
+    CANMessage message;
+
+    // Push/pop well past the capacity so indices wrap several times
+    for (uint8_t i = 0; i < 50; i++) {
+        ASSERT_TRUE(ring.push(makeMessage(BATTERY_MGMT_3_FD1_ID, i)));
+        ASSERT_TRUE(ring.pop(message));
+        EXPECT_EQ(message.data[0], i);
+    }
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.getDropCount(), 0u);
+}
+
+TEST_F(SPSCRingBufferTest, DropsNewestWhenFull) {
+    SPSCRingBuffer<CANMessage, 4> ring;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.push(makeMessage(BCM_LAMP_STAT_FD1_ID, i)));
+    }
+    EXPECT_FALSE(ring.push(makeMessage(BCM_LAMP_STAT_FD1_ID, 99)));
+    EXPECT_FALSE(ring.push(makeMessage(BCM_LAMP_STAT_FD1_ID, 100)));
+    EXPECT_EQ(ring.getDropCount(), 2u);
+    EXPECT_EQ(ring.size(), 4);
+
+    // Queued frames are unaffected by the drops
+    CANMessage message;
+    for (uint8_t i = 0; i < 4; i++) {
+        ASSERT_TRUE(ring.pop(message));
+        EXPECT_EQ(message.data[0], i);
+    }
+}
+
+TEST_F(SPSCRingBufferTest, TracksHighWaterMark) {
+    SPSCRingBuffer<CANMessage, 16> ring;
+    CANMessage message;
+
+    for (uint8_t i = 0; i < 5; i++) {
+        ring.push(makeMessage(POWERTRAIN_DATA_10_ID, i));
+    }
+    ring.pop(message);
+    ring.pop(message);
+    ring.push(makeMessage(POWERTRAIN_DATA_10_ID, 5));
+
+    EXPECT_EQ(ring.getHighWaterMark(), 5);
+    EXPECT_EQ(ring.size(), 4);
+
+    // Reset keeps the current depth as the new baseline
+    ring.resetStatistics();
+    EXPECT_EQ(ring.getHighWaterMark(), 4);
+    EXPECT_EQ(ring.getDropCount(), 0u);
+}
+
+TEST_F(SPSCRingBufferTest, InPlaceSlotsAvoidCopies) {
+    SPSCRingBuffer<CANMessage, 4> ring;
+
+    // Nothing is queued until commit(); an abandoned slot is handed out again
+    CANMessage* slot = ring.reserve();
+    ASSERT_NE(slot, nullptr);
+    slot->id = 0x123;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.reserve(), slot);
+
+    slot->id = BCM_LAMP_STAT_FD1_ID;
+    slot->data[0] = 7;
+    ring.commit();
+    EXPECT_EQ(ring.size(), 1);
+    EXPECT_EQ(ring.getHighWaterMark(), 1);
+
+    // The consumer reads the very slot the producer wrote
+    const CANMessage* front = ring.front();
+    EXPECT_EQ(front, slot);
+    EXPECT_EQ(front->data[0], 7);
+    ring.release();
+    EXPECT_EQ(ring.front(), nullptr);
+
+    for (uint8_t i = 0; i < 4; i++) {
+        ASSERT_NE(ring.reserve(), nullptr);
+        ring.commit();
+    }
+    EXPECT_EQ(ring.reserve(), nullptr);
+    ring.countDrop();
+    EXPECT_EQ(ring.getDropCount(), 1u);
+    EXPECT_EQ(ring.getHighWaterMark(), 4);
+}
+
+TEST_F(SPSCRingBufferTest, RunsStopAtTheEndOfStorage) {
+    SPSCRingBuffer<CANMessage, 8> ring;
+    const CANMessage* run = nullptr;
+    EXPECT_EQ(ring.front(&run, 8), 0);
+
+    // Move the tail to slot 5, then queue 6 frames: 3 before the wrap, 3 after
+    for (uint8_t i = 0; i < 5; i++) {
+        ASSERT_TRUE(ring.push(makeMessage(0x100, i)));
+    }
+    ring.release(5);
+    for (uint8_t i = 0; i < 6; i++) {
+        ASSERT_TRUE(ring.push(makeMessage(0x200 + i, i)));
+    }
+
+    EXPECT_EQ(ring.front(&run, 2), 2);
+    EXPECT_EQ(ring.front(&run, 8), 3);
+    EXPECT_EQ(run[0].id, 0x200u);
+    EXPECT_EQ(run[2].id, 0x202u);
+    ring.release(3);
+
+    ASSERT_EQ(ring.front(&run, 8), 3);
+    EXPECT_EQ(run, ring.front());   // In place, at the start of the storage
+    EXPECT_EQ(run[0].id, 0x203u);
+    EXPECT_EQ(run[2].id, 0x205u);
+    ring.release(1);
+    EXPECT_EQ(ring.size(), 2);
+    EXPECT_EQ(ring.front()->id, 0x204u);
+}
+
+TEST_F(SPSCRingBufferTest, FrameLayoutOverlaysDriverFrame) {
+    // The MCP2515 driver writes id, DLC and payload of a struct can_frame in place
+    EXPECT_EQ(offsetof(CANMessage, id), 0u);
+    EXPECT_EQ(offsetof(CANMessage, length), 4u);
+    EXPECT_EQ(offsetof(CANMessage, data), 8u);
+    EXPECT_EQ(offsetof(CANMessage, timestamp), 16u);
+    EXPECT_EQ(sizeof(CANMessage), 32u);   // Same on the ESP32 and the host
+}
+
+TEST_F(SPSCRingBufferTest, ConcurrentProducerConsumer) {
+    static SPSCRingBuffer<CANMessage, 64> ring;
+    const uint32_t TOTAL_FRAMES = 200000;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < TOTAL_FRAMES; i++) {
+            CANMessage message = makeMessage(i & 0x7FF, (uint8_t)i);
+            message.timestamp = i;
+            while (!ring.push(message)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Every frame must arrive exactly once, in order, with intact payload
+    uint32_t expected = 0;
+    CANMessage message;
+    while (expected < TOTAL_FRAMES) {
+        if (ring.pop(message)) {
+            ASSERT_EQ(message.timestamp, expected);
+            ASSERT_EQ(message.id, expected & 0x7FF);
+            ASSERT_EQ(message.data[0], (uint8_t)expected);
+            ASSERT_EQ(message.data[7], (uint8_t)expected);
+            expected++;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ring.empty());
+    EXPECT_LE(ring.getHighWaterMark(), 64);
+}
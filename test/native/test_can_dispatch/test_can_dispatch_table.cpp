@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production dispatch table builder
+#include "../src/can_dispatch_table.h"
+
+/**
+ * CAN Dispatch Table Test Suite
+ *
+ * Validates the compile-time ID -> route lookup used by can_dispatch.cpp:
+ * every registered ID maps to its route index, every other 11-bit ID (and
+ * every out-of-range ID) maps to CAN_DISPATCH_NO_SLOT, and invalid route
+ * lists are rejected at compile time.
+ */
+
+namespace {
+struct TestRoute {
+    uint32_t id;
+    int handlerTag;
+};
+
+constexpr TestRoute MONITORED_ROUTES[] = {
+    {BCM_LAMP_STAT_FD1_ID, 10},
+    {LOCKING_SYSTEMS_2_FD1_ID, 11},
+    {POWERTRAIN_DATA_10_ID, 12},
+    {BATTERY_MGMT_3_FD1_ID, 13},
+};
+
+constexpr CANDispatchTable MONITORED_TABLE = buildCANDispatchTable(MONITORED_ROUTES);
+
+constexpr TestRoute DUPLICATE_ROUTES[] = {{0x100, 0}, {0x200, 1}, {0x100, 2}};
+constexpr TestRoute EXTENDED_ROUTES[] = {{0x100, 0}, {0x18FF0000, 1}};
+
+// Lookups are usable in constant expressions
+static_assert(MONITORED_TABLE.slotFor(BCM_LAMP_STAT_FD1_ID) == 0, "first route");
+static_assert(MONITORED_TABLE.slotFor(BATTERY_MGMT_3_FD1_ID) == 3, "last route");
+static_assert(canRoutesAreValid(MONITORED_ROUTES), "monitored routes are valid");
+static_assert(!canRoutesAreValid(DUPLICATE_ROUTES), "duplicate IDs are rejected");
+static_assert(!canRoutesAreValid(EXTENDED_ROUTES), "29-bit IDs are rejected");
+}
+
+class CANDispatchTableTest : public ::testing::Test {
+};
+
+TEST_F(CANDispatchTableTest, RegisteredIdsMapToTheirRoute) {
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t slot = MONITORED_TABLE.slotFor(MONITORED_ROUTES[i].id);
+        ASSERT_EQ(slot, i);
+        EXPECT_EQ(MONITORED_ROUTES[slot].handlerTag, 10 + i);
+    }
+}
+
+TEST_F(CANDispatchTableTest, EveryOtherStandardIdIsUnrouted) {
+    int routed = 0;
+    for (uint32_t id = 0; id < CAN_STANDARD_ID_COUNT; id++) {
+        if (MONITORED_TABLE.slotFor(id) != CAN_DISPATCH_NO_SLOT) {
+            routed++;
+        }
+    }
+    EXPECT_EQ(routed, 4);
+}
+
+TEST_F(CANDispatchTableTest, OutOfRangeIdsAreUnrouted) {
+    EXPECT_EQ(MONITORED_TABLE.slotFor(0x800), CAN_DISPATCH_NO_SLOT);
+    EXPECT_EQ(MONITORED_TABLE.slotFor(0x18FF03C3), CAN_DISPATCH_NO_SLOT);
+    EXPECT_EQ(MONITORED_TABLE.slotFor(0xFFFFFFFF), CAN_DISPATCH_NO_SLOT);
+}
+
+TEST_F(CANDispatchTableTest, TableIsOneBytePerStandardId) {
+    EXPECT_EQ(sizeof(CANDispatchTable), (size_t)CAN_STANDARD_ID_COUNT);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production MCP2515 filter planner
+#include "../src/can_filter_planner.h"
+#include "../src/can_dispatch.h"
+
+/**
+ * CAN Filter Planner Test Suite
+ *
+ * Validates the acceptance filter plans written to the MCP2515:
+ * - The monitored IDs (and anything up to six IDs) get exact filters
+ * - Larger sets admit every wanted ID and as few others as the masks allow
+ * - Admission follows the register semantics of both receive buffers
+ * - Invalid ID sets are rejected and the open plan admits the whole bus
+ */
+
+namespace {
+void expectAdmitsAll(const CANFilterPlan& plan, const uint32_t* ids, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        EXPECT_TRUE(canFilterPlanAdmits(plan, ids[i])) << "ID 0x" << std::hex << ids[i];
+    }
+}
+}
+
+TEST(CANFilterPlannerTest, MonitoredIdsGetExactFilters) {
+    uint32_t ids[CAN_FILTER_PLAN_MAX_IDS];
+    uint8_t count = getMonitoredMessageCount();
+    for (uint8_t i = 0; i < count; i++) {
+        ids[i] = getMonitoredMessageId(i);
+    }
+
+    CANFilterPlan plan;
+    ASSERT_TRUE(planCANFilters(ids, count, plan));
+    expectAdmitsAll(plan, ids, count);
+    EXPECT_TRUE(isCANFilterPlanExact(plan));
+    EXPECT_EQ(plan.admittedIds, count);
+    EXPECT_FALSE(canFilterPlanAdmits(plan, 0x3C2));
+}
+
+TEST(CANFilterPlannerTest, SixIdsUseAllFiltersExactly) {
+    const uint32_t ids[] = {0x076, 0x176, 0x331, 0x3C3, 0x43C, 0x7E8};
+    CANFilterPlan plan;
+    ASSERT_TRUE(planCANFilters(ids, 6, plan));
+    expectAdmitsAll(plan, ids, 6);
+    EXPECT_EQ(plan.admittedIds, 6);
+    EXPECT_EQ(plan.masks[0], CAN_FILTER_STANDARD_MASK);
+    EXPECT_EQ(plan.masks[1], CAN_FILTER_STANDARD_MASK);
+}
+
+TEST(CANFilterPlannerTest, SharedMasksStayTight) {
+    // Eight IDs: four pairs differing in bit 0 fit RXB1 with one bit cleared
+    const uint32_t ids[] = {0x200, 0x201, 0x310, 0x311, 0x420, 0x421, 0x530, 0x531};
+    CANFilterPlan plan;
+    ASSERT_TRUE(planCANFilters(ids, 8, plan));
+    expectAdmitsAll(plan, ids, 8);
+    EXPECT_EQ(plan.admittedIds, 8);
+    EXPECT_TRUE(isCANFilterPlanExact(plan));
+
+    // Seven unrelated IDs cannot be exact, but stay far from the open bus
+    const uint32_t spread[] = {0x076, 0x176, 0x331, 0x3C3, 0x43C, 0x5A1, 0x7E8};
+    ASSERT_TRUE(planCANFilters(spread, 7, plan));
+    expectAdmitsAll(plan, spread, 7);
+    EXPECT_GT(plan.admittedIds, 7);
+    EXPECT_LE(plan.admittedIds, 16);
+    EXPECT_EQ(plan.admittedIds, countCANFilterPlanAdmitted(plan));
+}
+
+TEST(CANFilterPlannerTest, LargeSetsUseContiguousSplits) {
+    uint32_t ids[20];
+    for (uint8_t i = 0; i < 20; i++) {
+        ids[i] = 0x100 + i * 0x40;
+    }
+    CANFilterPlan plan;
+    ASSERT_TRUE(planCANFilters(ids, 20, plan));
+    expectAdmitsAll(plan, ids, 20);
+    EXPECT_LT(plan.admittedIds, 2048 / 4);
+}
+
+TEST(CANFilterPlannerTest, RejectsInvalidSetsAndOpensTheBus) {
+    CANFilterPlan plan;
+    const uint32_t extended[] = {0x176, 0x18DAF110};
+    EXPECT_FALSE(planCANFilters(extended, 2, plan));
+    EXPECT_FALSE(planCANFilters(extended, 0, plan));
+
+    makeOpenCANFilterPlan(plan);
+    EXPECT_EQ(plan.admittedIds, 2048);
+    EXPECT_EQ(countCANFilterPlanAdmitted(plan), 2048);
+    EXPECT_TRUE(canFilterPlanAdmits(plan, 0x7FF));
+}
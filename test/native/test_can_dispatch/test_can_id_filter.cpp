@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import the production ID bitmap and the dispatcher's software filter stage
+#include "../src/can_id_filter.h"
+#include "../src/can_dispatch.h"
+#include "../src/can_id_stats.h"
+#include "../src/state_manager.h"
+
+/**
+ * Software CAN ID Filter Test Suite
+ *
+ * Validates the 2048-bit ID bitmap behind the dispatcher's software filter:
+ * - The bitmap holds exactly the registered IDs; out-of-range IDs never match
+ * - A batch of frames yields one bit per frame, including a full batch of 32
+ * - The dispatcher selects the same frames the dispatch table would route
+ * - Skipped frames are still counted per ID and in the dispatch statistics
+ */
+
+namespace {
+struct TestRoute {
+    uint32_t id;
+};
+
+constexpr TestRoute MONITORED_ROUTES[] = {
+    {BCM_LAMP_STAT_FD1_ID},
+    {LOCKING_SYSTEMS_2_FD1_ID},
+    {POWERTRAIN_DATA_10_ID},
+    {BATTERY_MGMT_3_FD1_ID},
+};
+
+constexpr TestRoute EDGE_ROUTES[] = {{0x000}, {0x01F}, {0x020}, {0x7FF}};
+
+constexpr CANIdBitmap MONITORED_BITMAP = buildCANIdBitmap(MONITORED_ROUTES);
+constexpr CANIdBitmap EDGE_BITMAP = buildCANIdBitmap(EDGE_ROUTES);
+
+static_assert(sizeof(CANIdBitmap) == 256, "one bit per standard ID");
+static_assert(MONITORED_BITMAP.contains(BCM_LAMP_STAT_FD1_ID), "registered ID");
+static_assert(!MONITORED_BITMAP.contains(BCM_LAMP_STAT_FD1_ID + 1), "neighbouring ID");
+static_assert(EDGE_BITMAP.contains(0x000) && EDGE_BITMAP.contains(0x7FF), "word boundaries");
+static_assert(!EDGE_BITMAP.contains(0x800), "29-bit IDs never match");
+
+CANMessage makeFrame(uint32_t id, uint8_t value = 0) {
+    CANMessage message;
+    memset(&message, 0, sizeof(message));
+    message.id = id;
+    message.length = 8;
+    message.data[0] = value;
+    return message;
+}
+}
+
+class CANIdFilterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ArduinoMock::instance().reset();
+        initializeStateManager();
+        invalidateCANPayloadCache();
+        resetCANDispatchStatistics();
+        resetCANIdStatistics();
+    }
+};
+
+TEST_F(CANIdFilterTest, BitmapHoldsExactlyTheRegisteredIds) {
+    int matched = 0;
+    for (uint32_t id = 0; id < CAN_STANDARD_ID_COUNT; id++) {
+        if (EDGE_BITMAP.contains(id)) {
+            matched++;
+        }
+    }
+    EXPECT_EQ(matched, 4);
+    EXPECT_EQ(EDGE_BITMAP.words[0], 0x80000001u);
+    EXPECT_EQ(EDGE_BITMAP.words[1], 0x00000001u);
+    EXPECT_EQ(EDGE_BITMAP.words[CAN_ID_FILTER_WORDS - 1], 0x80000000u);
+
+    // 0x800 wraps onto the word holding ID 0 and must still not match
+    EXPECT_FALSE(EDGE_BITMAP.contains(0x800));
+    EXPECT_FALSE(EDGE_BITMAP.contains(0x18FF07FF));
+}
+
+TEST_F(CANIdFilterTest, BatchMatchGivesOneBitPerFrame) {
+    CANMessage frames[CAN_ID_FILTER_MAX_BATCH];
+    uint32_t expected = 0;
+    for (uint8_t i = 0; i < CAN_ID_FILTER_MAX_BATCH; i++) {
+        // Every third frame is monitored; the others are background or extended IDs
+        uint32_t id = (i % 3 == 0) ? MONITORED_ROUTES[i % 4].id : (i % 3 == 1 ? 0x100u + i : 0x800u | BCM_LAMP_STAT_FD1_ID);
+        frames[i] = makeFrame(id);
+        if (i % 3 == 0) {
+            expected |= 1u << i;
+        }
+    }
+
+    EXPECT_EQ(matchCANIdBatch(MONITORED_BITMAP, frames, CAN_ID_FILTER_MAX_BATCH), expected);
+    EXPECT_EQ(matchCANIdBatch(MONITORED_BITMAP, frames, 4), expected & 0x0F);
+    EXPECT_EQ(matchCANIdBatch(MONITORED_BITMAP, frames, 0), 0u);
+}
+
+TEST_F(CANIdFilterTest, SelectionMatchesTheDispatchTable) {
+    CANMessage frames[CAN_ID_FILTER_MAX_BATCH];
+    for (uint32_t base = 0; base < CAN_STANDARD_ID_COUNT; base += CAN_ID_FILTER_MAX_BATCH) {
+        for (uint8_t i = 0; i < CAN_ID_FILTER_MAX_BATCH; i++) {
+            frames[i] = makeFrame(base + i);
+        }
+        uint32_t selected = selectCANFramesToDecode(frames, CAN_ID_FILTER_MAX_BATCH);
+        for (uint8_t i = 0; i < CAN_ID_FILTER_MAX_BATCH; i++) {
+            ASSERT_EQ((selected >> i) & 1u, getCANMessageName(base + i) != NULL ? 1u : 0u) << base + i;
+            ASSERT_EQ(isTargetCANMessage(base + i), getCANMessageName(base + i) != NULL);
+        }
+    }
+}
+
+TEST_F(CANIdFilterTest, SkippedFramesAreStillCounted) {
+    CANMessage frames[3] = {makeFrame(0x123), makeFrame(BCM_LAMP_STAT_FD1_ID, 0x01), makeFrame(0x123)};
+    uint32_t selected = selectCANFramesToDecode(frames, 3);
+    ASSERT_EQ(selected, 0x2u);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        if (selected & (1u << i)) {
+            dispatchCANMessage(frames[i]);
+        } else {
+            skipCANMessage(frames[i]);
+        }
+    }
+
+    CANDispatchStats stats = getCANDispatchStats();
+    EXPECT_EQ(stats.framesFiltered, 2u);
+    EXPECT_EQ(stats.framesDispatched, 1u);
+
+    CANIdStats idStats;
+    ASSERT_TRUE(getCANIdStats(0x123, idStats));
+    EXPECT_EQ(idStats.count, 2u);
+    ASSERT_TRUE(getCANIdStats(BCM_LAMP_STAT_FD1_ID, idStats));
+    EXPECT_EQ(idStats.count, 1u);
+
+    resetCANDispatchStatistics();
+    EXPECT_EQ(getCANDispatchStats().framesFiltered, 0u);
+}
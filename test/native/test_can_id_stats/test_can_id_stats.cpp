@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production per-ID statistics and the dispatcher that feeds them
+#include "../src/can_id_stats.h"
+#include "../src/can_dispatch.h"
+#include "../src/state_manager.h"
+
+/**
+ * Per-CAN-ID Statistics Test Suite
+ *
+ * Validates the fixed per-ID table behind 'can_ids':
+ * - Every dispatched frame, monitored or not, is counted against its ID
+ * - Inter-arrival mean/min/max and jitter follow the arrival stamps
+ * - Missed frames are estimated from the expected cycle time of the route
+ * - Long gaps count as outages, not as missed frames
+ * - A full probe window counts frames as untracked instead of evicting IDs
+ */
+
+namespace {
+CANMessage makeFrame(uint32_t id, uint32_t arrivalUs, uint8_t value = 0) {
+    CANMessage message;
+    memset(&message, 0, sizeof(message));
+    message.id = id;
+    message.length = 8;
+    message.data[0] = value;
+    message.timestamp = arrivalUs / 1000;
+    message.arrivalUs = arrivalUs;
+    return message;
+}
+
+CANIdStats statsFor(uint32_t id) {
+    CANIdStats stats;
+    memset(&stats, 0, sizeof(stats));
+    EXPECT_TRUE(getCANIdStats(id, stats));
+    return stats;
+}
+}
+
+class CANIdStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ArduinoMock::instance().reset();
+        initializeStateManager();
+        invalidateCANPayloadCache();
+        resetCANIdStatistics();
+    }
+};
+
+TEST_F(CANIdStatsTest, CountsMonitoredAndUnmonitoredIds) {
+    dispatchCANMessage(makeFrame(POWERTRAIN_DATA_10_ID, 1000));
+    dispatchCANMessage(makeFrame(POWERTRAIN_DATA_10_ID, 101000));
+    EXPECT_EQ(dispatchCANMessage(makeFrame(0x123, 5000, 0xAB)), CAN_DISPATCH_IGNORED);
+
+    CANIdStatsSummary summary = getCANIdStatsSummary();
+    EXPECT_EQ(summary.trackedIds, 2);
+    EXPECT_EQ(summary.trackedFrames, 3u);
+    EXPECT_EQ(summary.untrackedFrames, 0u);
+
+    EXPECT_EQ(statsFor(POWERTRAIN_DATA_10_ID).count, 2u);
+    EXPECT_EQ(statsFor(POWERTRAIN_DATA_10_ID).expectedPeriodMs, POWERTRAIN_DATA_10_PERIOD_MS);
+    CANIdStats other = statsFor(0x123);
+    EXPECT_EQ(other.count, 1u);
+    EXPECT_EQ(other.expectedPeriodMs, 0);
+    EXPECT_EQ(other.data[0], 0xAB);
+
+    CANIdStats missing;
+    EXPECT_FALSE(getCANIdStats(0x7FF, missing));
+}
+
+TEST_F(CANIdStatsTest, IntervalsAndJitterFollowArrivalStamps) {
+    // 100 ms cycle with one late frame: intervals 100, 100, 120, 80 ms
+    const uint32_t arrivals[] = {0, 100000, 200000, 320000, 400000};
+    for (uint32_t arrivalUs : arrivals) {
+        recordCANIdFrame(makeFrame(0x200, arrivalUs), 100);
+    }
+
+    CANIdStats stats = statsFor(0x200);
+    EXPECT_EQ(stats.count, 5u);
+    EXPECT_EQ(stats.intervals, 4u);
+    EXPECT_EQ(getCANIdMeanIntervalUs(stats), 100000u);
+    EXPECT_EQ(stats.minIntervalUs, 80000u);
+    EXPECT_EQ(stats.maxIntervalUs, 120000u);
+    EXPECT_EQ(stats.missedFrames, 0u);
+
+    // RFC 3550 estimator: J += (|D| - J) / 16 for D = 0, 20000, 40000 us
+    EXPECT_NEAR(getCANIdJitterUs(stats), 20000 / 16 + (40000 - 20000 / 16) / 16, 2);
+}
+
+TEST_F(CANIdStatsTest, MissedFramesFromExpectedCycle) {
+    recordCANIdFrame(makeFrame(0x200, 0), 100);
+    recordCANIdFrame(makeFrame(0x200, 100000), 100);
+    recordCANIdFrame(makeFrame(0x200, 400000), 100);     // Two frames lost
+    recordCANIdFrame(makeFrame(0x200, 540000), 100);     // Late, not lost
+
+    EXPECT_EQ(statsFor(0x200).missedFrames, 2u);
+
+    // Without an expected cycle there is no estimate
+    recordCANIdFrame(makeFrame(0x201, 0), 0);
+    recordCANIdFrame(makeFrame(0x201, 900000), 0);
+    EXPECT_EQ(statsFor(0x201).missedFrames, 0u);
+}
+
+TEST_F(CANIdStatsTest, LongGapsAreOutages) {
+    recordCANIdFrame(makeFrame(0x200, 0), 100);
+    recordCANIdFrame(makeFrame(0x200, 100000), 100);
+    recordCANIdFrame(makeFrame(0x200, 100000 + CAN_TIMEOUT_MS * 1000UL), 100);
+
+    CANIdStats stats = statsFor(0x200);
+    EXPECT_EQ(stats.outages, 1u);
+    EXPECT_EQ(stats.missedFrames, 0u);
+    EXPECT_EQ(stats.intervals, 1u);
+    EXPECT_EQ(stats.maxIntervalUs, 100000u);
+}
+
+TEST_F(CANIdStatsTest, FullTableCountsUntrackedFrames) {
+    for (uint32_t id = 0; id < 2 * CAN_ID_STATS_SLOTS; id++) {
+        recordCANIdFrame(makeFrame(id, 0), 0);
+    }
+
+    CANIdStatsSummary summary = getCANIdStatsSummary();
+    EXPECT_LE(summary.trackedIds, CAN_ID_STATS_SLOTS);
+    EXPECT_EQ(summary.trackedFrames + summary.untrackedFrames, 2u * CAN_ID_STATS_SLOTS);
+    EXPECT_GT(summary.untrackedFrames, 0u);
+
+    // Tracked IDs keep their entries
+    CANIdStats stats;
+    uint16_t found = 0;
+    for (uint16_t slot = 0; slot < getCANIdStatsCapacity(); slot++) {
+        if (getCANIdStatsAt(slot, stats)) {
+            found++;
+        }
+    }
+    EXPECT_EQ(found, summary.trackedIds);
+
+    resetCANIdStatistics();
+    EXPECT_EQ(getCANIdStatsSummary().trackedIds, 0);
+}
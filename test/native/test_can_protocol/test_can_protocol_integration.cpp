@@ -48,7 +48,7 @@ TEST_F(CANProtocolTest, BCMLampParsingProduction) {
     CANFrame frame = CANTestUtils::createCANFrame(BCM_LAMP_STAT_FD1_ID, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
     
     // Convert to CANMessage and use production function
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     BCMLampStatus result;
     bool success = parseBCMLampStatus(message, result);
     
@@ -67,7 +67,7 @@ TEST_F(CANProtocolTest, LockingSystemsParsingProduction) {
                                 testData[4], testData[5], testData[6], testData[7]);
     
     // Convert to CANMessage and use production function
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     LockingSystemsStatus result;
     bool success = parseLockingSystemsStatus(message, result);
     
@@ -86,7 +86,7 @@ TEST_F(CANProtocolTest, PowertrainParsingProduction) {
                                 testData[4], testData[5], testData[6], testData[7]);
     
     // Convert to CANMessage and use production function
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     PowertrainData result;
     bool success = parsePowertrainData(message, result);
     
@@ -142,9 +142,9 @@ TEST_F(CANProtocolTest, EndToEndScenarioProduction) {
                                     parkData[4], parkData[5], parkData[6], parkData[7]);
     
     // Parse using ACTUAL production functions
-    CANMessage bcmMessage = convertToCANMessage(bcmFrame);
-    CANMessage lockMessage = convertToCANMessage(lockFrame);
-    CANMessage parkMessage = convertToCANMessage(parkFrame);
+    CANMessage bcmMessage = bcmFrame;
+    CANMessage lockMessage = lockFrame;
+    CANMessage parkMessage = parkFrame;
     
     BCMLampStatus bcm;
     LockingSystemsStatus lock;
@@ -177,7 +177,7 @@ TEST_F(CANProtocolTest, EndToEndScenarioProduction) {
 TEST_F(CANProtocolTest, InvalidFrameHandling) {
     // Test wrong CAN ID
     CANFrame wrongId = CANTestUtils::createCANFrame(0x999, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-    CANMessage wrongMessage = convertToCANMessage(wrongId);
+    CANMessage wrongMessage = wrongId;
     BCMLampStatus bcmResult;
     bool bcmSuccess = parseBCMLampStatus(wrongMessage, bcmResult);
     EXPECT_FALSE(bcmSuccess);
@@ -190,7 +190,7 @@ TEST_F(CANProtocolTest, InvalidFrameHandling) {
     
     // Test wrong frame length
     CANFrame shortFrame = CANTestUtils::createCANFrame(BCM_LAMP_STAT_FD1_ID, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
-    CANMessage shortMessage = convertToCANMessage(shortFrame);
+    CANMessage shortMessage = shortFrame;
     shortMessage.length = 4;  // Wrong length
     BCMLampStatus shortResult;
     bool shortSuccess = parseBCMLampStatus(shortMessage, shortResult);
@@ -209,7 +209,7 @@ TEST_F(CANProtocolTest, DetectProductionCodeChanges) {
                                     testData[4], testData[5], testData[6], testData[7]);
     
     // Use production function
-    CANMessage message = convertToCANMessage(testFrame);
+    CANMessage message = testFrame;
     BCMLampStatus result;
     bool success = parseBCMLampStatus(message, result);
     
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "common/test_config.h"
+
+// Import production CAN recovery sequencer
+#include "../src/can_recovery.h"
+
+/**
+ * CAN Recovery Test Suite
+ *
+ * Validates the non-blocking recovery sequence that replaced the delay()-based
+ * recoverCANSystem():
+ * - Each hardware step runs only after the previous step's settle time
+ * - No call ever runs more than one step
+ * - Failed attempts back off exponentially; success resets the backoff
+ * - Attempts and time spent recovering are accounted
+ */
+
+namespace {
+std::string trace;
+bool configureResult = true;
+
+void fakeReset() { trace += "R"; }
+void fakeStopBus() { trace += "S"; }
+void fakeStartBus() { trace += "B"; }
+bool fakeConfigure() { trace += "C"; return configureResult; }
+
+const CANRecoveryOps fakeOps = { fakeReset, fakeStopBus, fakeStartBus, fakeConfigure };
+
+// Drive a recovery to completion from `start`, advancing 1 ms at a time
+unsigned long runToCompletion(unsigned long start) {
+    unsigned long now = start;
+    while (advanceCANRecovery(now) != CAN_RECOVERY_IDLE) {
+        now++;
+    }
+    return now;
+}
+}
+
+class CANRecoveryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        trace.clear();
+        configureResult = true;
+        initCANRecovery(&fakeOps);
+    }
+};
+
+TEST_F(CANRecoveryTest, IdleDoesNothing) {
+    EXPECT_EQ(advanceCANRecovery(1000), CAN_RECOVERY_IDLE);
+    EXPECT_FALSE(isCANRecoveryActive());
+    EXPECT_EQ(getCANRecoveryIdleTime(1000, 50), 50u);
+    EXPECT_TRUE(trace.empty());
+}
+
+TEST_F(CANRecoveryTest, StepsHonourSettleTimes) {
+    ASSERT_TRUE(requestCANRecovery(1000));
+    EXPECT_TRUE(isCANRecoveryActive());
+    EXPECT_EQ(getCANRecoveryIdleTime(1000, 50), 0u);
+
+    EXPECT_EQ(advanceCANRecovery(1000), CAN_RECOVERY_STOP_BUS);
+    EXPECT_EQ(trace, "R");
+
+    // Nothing happens until the reset settle time has passed
+    EXPECT_EQ(advanceCANRecovery(1000 + CAN_RECOVERY_RESET_SETTLE_MS - 1), CAN_RECOVERY_STOP_BUS);
+    EXPECT_EQ(trace, "R");
+    EXPECT_EQ(getCANRecoveryIdleTime(1000 + CAN_RECOVERY_RESET_SETTLE_MS - 1, 50), 1u);
+
+    unsigned long t = 1000 + CAN_RECOVERY_RESET_SETTLE_MS;
+    EXPECT_EQ(advanceCANRecovery(t), CAN_RECOVERY_START_BUS);
+    EXPECT_EQ(trace, "RS");
+
+    t += CAN_RECOVERY_BUS_SETTLE_MS;
+    EXPECT_EQ(advanceCANRecovery(t), CAN_RECOVERY_CONFIGURE);
+    EXPECT_EQ(trace, "RSB");
+
+    t += CAN_RECOVERY_BUS_SETTLE_MS;
+    EXPECT_EQ(advanceCANRecovery(t), CAN_RECOVERY_IDLE);
+    EXPECT_EQ(trace, "RSBC");
+
+    CANRecoveryStats stats = getCANRecoveryStats();
+    EXPECT_EQ(stats.attempts, 1u);
+    EXPECT_EQ(stats.successes, 1u);
+    EXPECT_EQ(stats.lastRecoveryMs, (unsigned long)(CAN_RECOVERY_RESET_SETTLE_MS + 2 * CAN_RECOVERY_BUS_SETTLE_MS));
+    EXPECT_EQ(stats.totalRecoveryMs, stats.lastRecoveryMs);
+}
+
+TEST_F(CANRecoveryTest, RequestWhileRunningIsRefused) {
+    ASSERT_TRUE(requestCANRecovery(0));
+    advanceCANRecovery(0);
+    EXPECT_FALSE(requestCANRecovery(10));
+    EXPECT_EQ(getCANRecoveryStats().refused, 1u);
+    EXPECT_EQ(getCANRecoveryStats().attempts, 1u);
+}
+
+TEST_F(CANRecoveryTest, FailureBacksOffExponentially) {
+    configureResult = false;
+
+    ASSERT_TRUE(requestCANRecovery(0));
+    unsigned long done = runToCompletion(0);
+    CANRecoveryStats stats = getCANRecoveryStats();
+    EXPECT_EQ(stats.failures, 1u);
+    EXPECT_EQ(stats.retryAllowedAt, done + CAN_RECOVERY_BACKOFF_MIN_MS);
+
+    EXPECT_FALSE(requestCANRecovery(done + CAN_RECOVERY_BACKOFF_MIN_MS - 1));
+    ASSERT_TRUE(requestCANRecovery(done + CAN_RECOVERY_BACKOFF_MIN_MS));
+    done = runToCompletion(done + CAN_RECOVERY_BACKOFF_MIN_MS);
+    EXPECT_EQ(getCANRecoveryStats().retryAllowedAt, done + 2 * CAN_RECOVERY_BACKOFF_MIN_MS);
+
+    // Backoff is capped
+    for (int i = 0; i < 20; i++) {
+        unsigned long retryAt = getCANRecoveryStats().retryAllowedAt;
+        ASSERT_TRUE(requestCANRecovery(retryAt));
+        runToCompletion(retryAt);
+    }
+    EXPECT_EQ(getCANRecoveryStats().backoffMs, (unsigned long)CAN_RECOVERY_BACKOFF_MAX_MS);
+}
+
+TEST_F(CANRecoveryTest, SuccessResetsBackoff) {
+    configureResult = false;
+    ASSERT_TRUE(requestCANRecovery(0));
+    unsigned long done = runToCompletion(0);
+
+    configureResult = true;
+    unsigned long retryAt = done + CAN_RECOVERY_BACKOFF_MIN_MS;
+    ASSERT_TRUE(requestCANRecovery(retryAt));
+    done = runToCompletion(retryAt);
+
+    CANRecoveryStats stats = getCANRecoveryStats();
+    EXPECT_EQ(stats.successes, 1u);
+    EXPECT_EQ(stats.failures, 1u);
+    EXPECT_EQ(stats.backoffMs, (unsigned long)CAN_RECOVERY_BACKOFF_MIN_MS);
+    EXPECT_TRUE(requestCANRecovery(done));
+}
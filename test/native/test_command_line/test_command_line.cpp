@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include "common/test_config.h"
+
+// Import production command line reader and table lookup
+#include "../src/command_line.h"
+
+/**
+ * Command Line Test Suite
+ *
+ * Validates the allocation-free serial command path:
+ * - Lines are assembled incrementally, trimmed and lower-cased
+ * - Over-long lines are discarded and reported once
+ * - Table lookup by binary search finds exact names only
+ */
+
+namespace {
+int statusRuns = 0;
+void runStatus() { statusRuns++; }
+void runLog(const char* args) { (void)args; }
+
+constexpr CommandEntry testTable[] = {
+    {"can_status", runStatus, nullptr},
+    {"cs",         runStatus, nullptr},
+    {"log",        nullptr,   runLog},
+    {"status",     runStatus, nullptr},
+    {"t",          runStatus, nullptr},
+};
+static_assert(isCommandTableSorted(testTable), "test table must be sorted");
+
+constexpr CommandEntry unsortedTable[] = {
+    {"status", runStatus, nullptr},
+    {"log",    nullptr,   runLog},
+};
+static_assert(!isCommandTableSorted(unsortedTable), "unsorted table must be detected");
+
+const size_t TABLE_SIZE = sizeof(testTable) / sizeof(testTable[0]);
+}
+
+class CommandLineTest : public ::testing::Test {
+protected:
+    CommandLineReader reader;
+
+    void SetUp() override {
+        resetCommandLineReader(reader);
+    }
+
+    // Feed a string; returns the result of the last character
+    uint8_t feed(const char* text) {
+        uint8_t result = COMMAND_LINE_PENDING;
+        for (const char* p = text; *p; p++) {
+            result = feedCommandLine(reader, *p);
+        }
+        return result;
+    }
+
+    const CommandEntry* lookup(const char* line) {
+        const char* args;
+        size_t length = splitCommandLine(line, &args);
+        return findCommand(testTable, TABLE_SIZE, line, length);
+    }
+};
+
+TEST_F(CommandLineTest, AssemblesLineIncrementally) {
+    EXPECT_EQ(feed("  STA"), COMMAND_LINE_PENDING);
+    EXPECT_EQ(feed("tus  "), COMMAND_LINE_PENDING);
+    EXPECT_EQ(feedCommandLine(reader, '\n'), COMMAND_LINE_READY);
+    EXPECT_STREQ(getCommandLine(reader), "status");
+}
+
+TEST_F(CommandLineTest, CrLfAndBlankLinesAreIgnored) {
+    EXPECT_EQ(feed("help\r"), COMMAND_LINE_READY);
+    EXPECT_EQ(feedCommandLine(reader, '\n'), COMMAND_LINE_PENDING);
+    EXPECT_EQ(feed("   \n"), COMMAND_LINE_PENDING);
+}
+
+TEST_F(CommandLineTest, OverlongLineIsDiscarded) {
+    for (int i = 0; i < COMMAND_LINE_MAX_LENGTH + 10; i++) {
+        EXPECT_EQ(feedCommandLine(reader, 'x'), COMMAND_LINE_PENDING);
+    }
+    EXPECT_EQ(feedCommandLine(reader, '\n'), COMMAND_LINE_OVERFLOW);
+
+    // The next line is unaffected
+    EXPECT_EQ(feed("t\n"), COMMAND_LINE_READY);
+    EXPECT_STREQ(getCommandLine(reader), "t");
+}
+
+TEST_F(CommandLineTest, SplitsNameAndArguments) {
+    const char* args;
+    EXPECT_EQ(splitCommandLine("log can   debug", &args), 3u);
+    EXPECT_STREQ(args, "can   debug");
+
+    EXPECT_EQ(splitCommandLine("status", &args), 6u);
+    EXPECT_STREQ(args, "");
+}
+
+TEST_F(CommandLineTest, LookupFindsExactNamesOnly) {
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        EXPECT_EQ(lookup(testTable[i].name), &testTable[i]);
+    }
+
+    const CommandEntry* entry = lookup("log all info");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_STREQ(entry->name, "log");
+
+    EXPECT_EQ(lookup("stat"), nullptr);
+    EXPECT_EQ(lookup("statuss"), nullptr);
+    EXPECT_EQ(lookup("c"), nullptr);
+    EXPECT_EQ(lookup("zzz"), nullptr);
+    EXPECT_EQ(lookup(""), nullptr);
+}
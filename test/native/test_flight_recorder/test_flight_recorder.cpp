@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production flight recorder ring (storage task is firmware-only)
+#include "../src/flight_recorder.h"
+
+/**
+ * Flight Recorder Test Suite
+ *
+ * Validates the RAM ring behind the LittleFS flight records:
+ * - The ring keeps the newest FLIGHT_RECORDER_FRAMES frames, oldest first
+ * - A trigger freezes the record after the post-trigger frame count or time
+ * - A frozen record is serialized as header + frames in any block size
+ * - Frames are counted as missed while the record awaits storage
+ * - Automatic triggers respect the cooldown; manual ones do not
+ * - Without storage, triggers are refused and the ring keeps rolling
+ */
+
+namespace {
+CANMessage makeFrame(uint32_t sequence) {
+    CANMessage message;
+    memset(&message, 0, sizeof(message));
+    message.id = 0x100 + (sequence & 0xFF);
+    message.length = 8;
+    memcpy(message.data, &sequence, sizeof(sequence));
+    message.arrivalUs = sequence * 100;
+    return message;
+}
+
+void recordFrames(uint32_t first, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        recordFlightFrame(makeFrame(first + i));
+    }
+}
+
+// Read the frozen record back through copyFlightRecordBytes in blockSize pieces
+std::vector<uint8_t> readRecord(uint32_t blockSize) {
+    std::vector<uint8_t> bytes(getFlightRecordSize());
+    for (uint32_t offset = 0; offset < bytes.size(); offset += blockSize) {
+        uint32_t length = std::min<uint32_t>(blockSize, bytes.size() - offset);
+        EXPECT_EQ(copyFlightRecordBytes(offset, bytes.data() + offset, length), length);
+    }
+    return bytes;
+}
+
+uint32_t frameSequence(const std::vector<uint8_t>& record, uint32_t index) {
+    FlightFrame frame;
+    memcpy(&frame, record.data() + sizeof(FlightRecordHeader) + index * sizeof(FlightFrame), sizeof(frame));
+    uint32_t sequence;
+    memcpy(&sequence, frame.data, sizeof(sequence));
+    return sequence;
+}
+}
+
+class FlightRecorderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ArduinoMock::instance().reset();
+        resetFlightRecorder();
+        setFlightRecordStorageAvailable(true);
+    }
+};
+
+TEST_F(FlightRecorderTest, FreezesAfterPostTriggerFrames) {
+    recordFrames(0, 100);
+    ASSERT_TRUE(triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 1000));
+    EXPECT_FALSE(isFlightRecordFrozen());
+    recordFrames(100, FLIGHT_RECORDER_POST_FRAMES - 1);
+    EXPECT_FALSE(isFlightRecordFrozen());
+    recordFrames(100 + FLIGHT_RECORDER_POST_FRAMES - 1, 1);
+    ASSERT_TRUE(isFlightRecordFrozen());
+
+    std::vector<uint8_t> record = readRecord(4096);
+    FlightRecordHeader header;
+    memcpy(&header, record.data(), sizeof(header));
+    EXPECT_STREQ(header.magic, FLIGHT_RECORD_MAGIC);
+    EXPECT_EQ(header.frameSize, sizeof(FlightFrame));
+    EXPECT_EQ(header.trigger, (uint32_t)FLIGHT_TRIGGER_MANUAL);
+    EXPECT_EQ(header.triggerMs, 1000u);
+    EXPECT_EQ(header.frameCount, 100u + FLIGHT_RECORDER_POST_FRAMES);
+    EXPECT_EQ(header.triggerFrame, 100u);
+    EXPECT_EQ(frameSequence(record, 0), 0u);
+    EXPECT_EQ(frameSequence(record, header.triggerFrame), 100u);
+}
+
+TEST_F(FlightRecorderTest, WrappedRingKeepsNewestFramesOldestFirst) {
+    recordFrames(0, 3 * FLIGHT_RECORDER_FRAMES + 5);
+    triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 0);
+    recordFrames(3 * FLIGHT_RECORDER_FRAMES + 5, FLIGHT_RECORDER_POST_FRAMES);
+    ASSERT_TRUE(isFlightRecordFrozen());
+
+    // Odd block size splits header and frames at arbitrary offsets
+    std::vector<uint8_t> record = readRecord(100);
+    uint32_t last = 3 * FLIGHT_RECORDER_FRAMES + 5 + FLIGHT_RECORDER_POST_FRAMES - 1;
+    EXPECT_EQ(getFlightRecordSize(), sizeof(FlightRecordHeader) + FLIGHT_RECORDER_FRAMES * sizeof(FlightFrame));
+    EXPECT_EQ(frameSequence(record, 0), last - FLIGHT_RECORDER_FRAMES + 1);
+    EXPECT_EQ(frameSequence(record, FLIGHT_RECORDER_FRAMES - 1), last);
+    EXPECT_EQ(copyFlightRecordBytes(getFlightRecordSize(), record.data(), 16), 0u);
+}
+
+TEST_F(FlightRecorderTest, PostTriggerWindowEndsOnTime) {
+    recordFrames(0, 10);
+    triggerFlightRecorder(FLIGHT_TRIGGER_WATCHDOG, 5000);
+    serviceFlightRecorder(5000 + FLIGHT_RECORDER_POST_MS - 1);
+    EXPECT_FALSE(isFlightRecordFrozen());
+    serviceFlightRecorder(5000 + FLIGHT_RECORDER_POST_MS);
+    ASSERT_TRUE(isFlightRecordFrozen());
+
+    FlightRecordHeader header;
+    copyFlightRecordBytes(0, (uint8_t*)&header, sizeof(header));
+    EXPECT_EQ(header.frameCount, 10u);
+    EXPECT_EQ(header.triggerFrame, 10u);
+}
+
+TEST_F(FlightRecorderTest, FrozenRecordCountsMissedFrames) {
+    recordFrames(0, 10);
+    triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 0);
+    serviceFlightRecorder(FLIGHT_RECORDER_POST_MS);
+    recordFrames(10, 7);
+    EXPECT_FALSE(triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 0));
+
+    finishFlightRecord(true);
+    FlightRecorderStats stats = getFlightRecorderStats();
+    EXPECT_EQ(stats.framesMissed, 7u);
+    EXPECT_EQ(stats.recordsStored, 1u);
+    EXPECT_EQ(stats.triggersIgnored, 1u);
+    EXPECT_EQ(stats.state, FLIGHT_RECORDER_RECORDING);
+
+    // The next record starts empty and reports the frames lost in between
+    recordFrames(20, 3);
+    triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 0);
+    serviceFlightRecorder(FLIGHT_RECORDER_POST_MS);
+    FlightRecordHeader header;
+    copyFlightRecordBytes(0, (uint8_t*)&header, sizeof(header));
+    EXPECT_EQ(header.frameCount, 3u);
+    EXPECT_EQ(header.framesMissed, 7u);
+}
+
+TEST_F(FlightRecorderTest, AutomaticTriggersRespectCooldown) {
+    ASSERT_TRUE(triggerFlightRecorder(FLIGHT_TRIGGER_TOOLBOX_DENIED, 1000));
+    serviceFlightRecorder(1000 + FLIGHT_RECORDER_POST_MS);
+    finishFlightRecord(true);
+
+    EXPECT_FALSE(triggerFlightRecorder(FLIGHT_TRIGGER_WATCHDOG, 1000 + FLIGHT_RECORDER_TRIGGER_COOLDOWN_MS - 1));
+    ASSERT_TRUE(triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 2000));
+    serviceFlightRecorder(2000 + FLIGHT_RECORDER_POST_MS);
+    finishFlightRecord(false);
+    EXPECT_TRUE(triggerFlightRecorder(FLIGHT_TRIGGER_WATCHDOG, 1000 + FLIGHT_RECORDER_TRIGGER_COOLDOWN_MS));
+
+    FlightRecorderStats stats = getFlightRecorderStats();
+    EXPECT_EQ(stats.triggers[FLIGHT_TRIGGER_TOOLBOX_DENIED], 1u);
+    EXPECT_EQ(stats.triggers[FLIGHT_TRIGGER_WATCHDOG], 1u);
+    EXPECT_EQ(stats.triggers[FLIGHT_TRIGGER_MANUAL], 1u);
+    EXPECT_EQ(stats.storeFailures, 1u);
+    EXPECT_FALSE(triggerFlightRecorder(FLIGHT_TRIGGER_COUNT, 0));
+}
+
+TEST_F(FlightRecorderTest, TriggerWithoutStorageKeepsRecording) {
+    setFlightRecordStorageAvailable(false);
+    recordFrames(0, 10);
+    EXPECT_FALSE(triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 0));
+    EXPECT_FALSE(triggerFlightRecorder(FLIGHT_TRIGGER_WATCHDOG, 0));
+    recordFrames(10, FLIGHT_RECORDER_POST_FRAMES);
+    serviceFlightRecorder(FLIGHT_RECORDER_POST_MS);
+    EXPECT_FALSE(isFlightRecordFrozen());
+
+    FlightRecorderStats stats = getFlightRecorderStats();
+    EXPECT_EQ(stats.state, FLIGHT_RECORDER_RECORDING);
+    EXPECT_EQ(stats.framesRecorded, 10u + FLIGHT_RECORDER_POST_FRAMES);
+    EXPECT_EQ(stats.framesMissed, 0u);
+    EXPECT_EQ(stats.triggersIgnored, 2u);
+    EXPECT_EQ(stats.triggers[FLIGHT_TRIGGER_MANUAL], 0u);
+
+    // Storage coming up later makes triggers work again
+    setFlightRecordStorageAvailable(true);
+    EXPECT_TRUE(triggerFlightRecorder(FLIGHT_TRIGGER_MANUAL, 0));
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production latency histograms and the dispatch pipeline that stamps them
+#include "../src/latency_tracker.h"
+#include "../src/can_dispatch.h"
+#include "../src/state_manager.h"
+
+/**
+ * Frame Latency Tracker Test Suite
+ *
+ * Validates the frame-arrival-to-GPIO latency accounting:
+ * - Samples land in log2 buckets; percentiles report bucket limits
+ * - A dispatched frame records parse and state stages from its arrival stamp
+ * - Only frames that change an output input reach the GPIO stages, and the
+ *   oldest such frame is charged when several wait for the same commit
+ * - Change-filtered repeats and commits that write no pin add no samples
+ */
+
+namespace {
+CANMessage makeFrame(uint32_t id, uint8_t byteIndex, uint8_t value) {
+    CANMessage message;
+    memset(&message, 0, sizeof(message));
+    message.id = id;
+    message.length = 8;
+    message.data[byteIndex] = value;
+    message.timestamp = millis();
+    message.arrivalUs = getLatencyTimeUs();
+    return message;
+}
+
+LatencyHistogram stage(uint8_t index) {
+    LatencyHistogram histogram;
+    EXPECT_TRUE(getLatencyHistogram(index, histogram));
+    return histogram;
+}
+}
+
+class LatencyTrackerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ArduinoMock::instance().reset();
+        ArduinoMock::instance().setMillis(1000);
+        initializeStateManager();
+        invalidateCANPayloadCache();
+        takeOutputInputChanges();
+        resetLatencyStatistics();
+    }
+};
+
+TEST_F(LatencyTrackerTest, SamplesFallInLog2Buckets) {
+    EXPECT_EQ(getLatencyBucket(0), 0);
+    EXPECT_EQ(getLatencyBucket(1), 1);
+    EXPECT_EQ(getLatencyBucket(2), 2);
+    EXPECT_EQ(getLatencyBucket(3), 2);
+    EXPECT_EQ(getLatencyBucket(1023), 10);
+    EXPECT_EQ(getLatencyBucket(1024), 11);
+    EXPECT_EQ(getLatencyBucket(UINT32_MAX), LATENCY_HISTOGRAM_BUCKETS - 1);
+
+    EXPECT_EQ(getLatencyBucketLimitUs(0), 0u);
+    EXPECT_EQ(getLatencyBucketLimitUs(10), 1023u);
+    EXPECT_EQ(getLatencyBucketLimitUs(LATENCY_HISTOGRAM_BUCKETS - 1), UINT32_MAX);
+}
+
+TEST_F(LatencyTrackerTest, PercentilesReportBucketLimits) {
+    LatencyHistogram histogram;
+    memset(&histogram, 0, sizeof(histogram));
+    EXPECT_EQ(getLatencyPercentileUs(histogram, 50), 0u);
+
+    // 90 fast samples (100 us -> bucket limit 127) and 10 slow ones (5000 us)
+    for (int i = 0; i < 90; i++) {
+        addLatencySample(histogram, 100);
+    }
+    for (int i = 0; i < 10; i++) {
+        addLatencySample(histogram, 5000);
+    }
+    EXPECT_EQ(histogram.count, 100u);
+    EXPECT_EQ(histogram.minUs, 100u);
+    EXPECT_EQ(histogram.maxUs, 5000u);
+    EXPECT_EQ(histogram.totalUs, 90u * 100 + 10u * 5000);
+    EXPECT_EQ(getLatencyPercentileUs(histogram, 50), 127u);
+    EXPECT_EQ(getLatencyPercentileUs(histogram, 90), 127u);
+    EXPECT_EQ(getLatencyPercentileUs(histogram, 99), 5000u);   // Bucket limit 8191, capped at max
+}
+
+TEST_F(LatencyTrackerTest, FrameStagesFollowTheArrivalStamp) {
+    // Puddle lamps on: the bed light input changes
+    CANMessage lamp = makeFrame(BCM_LAMP_STAT_FD1_ID, 1, 0x04);
+    ArduinoMock::instance().advanceMicros(250);     // Queue wait before dispatch
+    EXPECT_EQ(dispatchCANMessage(lamp), CAN_DISPATCH_HANDLED);
+
+    EXPECT_EQ(stage(LATENCY_STAGE_PARSE).count, 1u);
+    EXPECT_EQ(stage(LATENCY_STAGE_PARSE).maxUs, 250u);
+    EXPECT_EQ(stage(LATENCY_STAGE_STATE).count, 1u);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).count, 0u);
+
+    ArduinoMock::instance().advanceMicros(100);
+    markOutputsCommitted(true);
+    EXPECT_EQ(stage(LATENCY_STAGE_OUTPUT).maxUs, 100u);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).count, 1u);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).maxUs, 350u);
+
+    // Nothing pending any more: a later commit adds no sample
+    markOutputsCommitted(true);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).count, 1u);
+}
+
+TEST_F(LatencyTrackerTest, OldestChangingFrameIsCharged) {
+    CANMessage lamp = makeFrame(BCM_LAMP_STAT_FD1_ID, 1, 0x04);
+    dispatchCANMessage(lamp);
+    ArduinoMock::instance().advanceMicros(400);
+
+    CANMessage unlock = makeFrame(LOCKING_SYSTEMS_2_FD1_ID, 4, 0x04);
+    dispatchCANMessage(unlock);
+    ArduinoMock::instance().advanceMicros(100);
+
+    markOutputsCommitted(true);
+    EXPECT_EQ(stage(LATENCY_STAGE_PARSE).count, 2u);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).count, 1u);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).maxUs, 500u);
+}
+
+TEST_F(LatencyTrackerTest, RepeatsAndIdleCommitsAddNoSamples) {
+    CANMessage battery = makeFrame(BATTERY_MGMT_3_FD1_ID, 2, 0x50);
+    EXPECT_EQ(dispatchCANMessage(battery), CAN_DISPATCH_HANDLED);
+    EXPECT_EQ(dispatchCANMessage(battery), CAN_DISPATCH_UNCHANGED);
+    EXPECT_EQ(stage(LATENCY_STAGE_PARSE).count, 1u);
+
+    // Battery SOC feeds no output: nothing waits for the GPIO commit
+    markOutputsCommitted(true);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).count, 0u);
+
+    // An output input changed but the recompute wrote no pin: sample dropped
+    CANMessage lamp = makeFrame(BCM_LAMP_STAT_FD1_ID, 1, 0x04);
+    dispatchCANMessage(lamp);
+    markOutputsCommitted(false);
+    markOutputsCommitted(true);
+    EXPECT_EQ(stage(LATENCY_STAGE_TOTAL).count, 0u);
+}
@@ -24,7 +24,7 @@ protected:
     void validateLockingMessage(const char* testName, const uint8_t data[8], 
                                uint8_t expectedStatus, const char* expectedAction) {
         CANFrame frame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, data);
-        CANMessage message = convertToCANMessage(frame);
+        CANMessage message = frame;
         LockingSystemsStatus result;
         
         bool success = parseLockingSystemsStatus(message, result);
@@ -170,7 +170,7 @@ TEST_F(LockingSystemDataTest, VehicleLogicIntegration) {
     // Scenario 1: Vehicle locks, toolbox should NOT open
     uint8_t lockData[8] = {0x00, 0x0F, 0x00, 0x00, 0x02, 0xC7, 0x44, 0x10};
     CANFrame lockFrame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, lockData);
-    CANMessage lockMessage = convertToCANMessage(lockFrame);
+    CANMessage lockMessage = lockFrame;
     LockingSystemsStatus lockResult;
     
     bool lockSuccess = parseLockingSystemsStatus(lockMessage, lockResult);
@@ -189,7 +189,7 @@ TEST_F(LockingSystemDataTest, VehicleLogicIntegration) {
     // Scenario 2: Vehicle unlocks, toolbox SHOULD open (if other conditions met)
     uint8_t unlockData[8] = {0x00, 0x0F, 0x00, 0x00, 0x05, 0xC2, 0x44, 0x10};
     CANFrame unlockFrame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, unlockData);
-    CANMessage unlockMessage = convertToCANMessage(unlockFrame);
+    CANMessage unlockMessage = unlockFrame;
     LockingSystemsStatus unlockResult;
     
     bool unlockSuccess = parseLockingSystemsStatus(unlockMessage, unlockResult);
@@ -247,7 +247,7 @@ TEST_F(LockingSystemDataTest, MessageSequenceAnalysis) {
     
     for (const auto& step : sequence) {
         CANFrame frame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, step.data);
-        CANMessage message = convertToCANMessage(frame);
+        CANMessage message = frame;
         LockingSystemsStatus result;
         
         bool success = parseLockingSystemsStatus(message, result);
@@ -287,7 +287,7 @@ TEST_F(LockingSystemDataTest, ErrorConditions) {
     // Test invalid message ID
     uint8_t validData[8] = {0x00, 0x0F, 0x00, 0x00, 0x02, 0xC7, 0x44, 0x10};
     CANFrame invalidIdFrame = CANTestUtils::createCANFrame(0x999, validData);
-    CANMessage invalidIdMessage = convertToCANMessage(invalidIdFrame);
+    CANMessage invalidIdMessage = invalidIdFrame;
     LockingSystemsStatus result1;
     
     bool success1 = parseLockingSystemsStatus(invalidIdMessage, result1);
@@ -297,7 +297,7 @@ TEST_F(LockingSystemDataTest, ErrorConditions) {
     // Test invalid message length
     CANFrame invalidLengthFrame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, validData);
     invalidLengthFrame.length = 4; // Wrong length
-    CANMessage invalidLengthMessage = convertToCANMessage(invalidLengthFrame);
+    CANMessage invalidLengthMessage = invalidLengthFrame;
     LockingSystemsStatus result2;
     
     bool success2 = parseLockingSystemsStatus(invalidLengthMessage, result2);
@@ -307,7 +307,7 @@ TEST_F(LockingSystemDataTest, ErrorConditions) {
     // Test with corrupted message data
     CANFrame corruptedFrame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, validData);
     corruptedFrame.id = 0; // Corrupt the ID to 0
-    CANMessage corruptedMessage = convertToCANMessage(corruptedFrame);
+    CANMessage corruptedMessage = corruptedFrame;
     LockingSystemsStatus result3;
     
     bool success3 = parseLockingSystemsStatus(corruptedMessage, result3);
@@ -327,7 +327,7 @@ TEST_F(LockingSystemDataTest, PerformanceValidation) {
     
     uint8_t testData[8] = {0x00, 0x0F, 0x00, 0x00, 0x05, 0xC2, 0x44, 0x10};
     CANFrame frame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, testData);
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     
     const int iterations = 1000;
     unsigned long startTime = millis();
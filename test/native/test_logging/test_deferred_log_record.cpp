@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "common/test_config.h"
+
+// Import production deferred log capture/format helpers
+#include "../src/deferred_log.h"
+
+/**
+ * Deferred Log Record Test Suite
+ *
+ * Validates the capture/format split used by deferred logging:
+ * - A captured record formats to exactly what printf would have produced
+ * - String arguments are copied, so the caller's buffer may change afterwards
+ * - String space overflow truncates instead of overrunning the record
+ */
+
+class DeferredLogRecordTest : public ::testing::Test {
+protected:
+    DeferredLogRecord record;
+    char line[256];
+
+    template <typename... Args>
+    std::string captureAndFormat(const char* format, Args... args) {
+        captureDeferredLog(record, DEBUG_LEVEL_INFO, format, args...);
+        formatDeferredLogRecord(record, line, sizeof(line));
+        return std::string(line);
+    }
+};
+
+TEST_F(DeferredLogRecordTest, IntegerArgumentsMatchPrintf) {
+    uint8_t data[8] = {0x40, 0x00, 0x0C, 0x00, 0x00, 0xFF, 0x10, 0x80};
+    std::string formatted = captureAndFormat(
+        "[DEBUG] ID=0x%03X (%d), Len=%d, Data=[%02X %02X %02X %02X %02X %02X %02X %02X]\n",
+        0x3C3, 0x3C3, 8, data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7]);
+
+    EXPECT_EQ(formatted, "[DEBUG] ID=0x3C3 (963), Len=8, Data=[40 00 0C 00 00 FF 10 80]\n");
+    EXPECT_EQ(record.argCount, 11);
+    EXPECT_EQ(record.level, DEBUG_LEVEL_INFO);
+}
+
+TEST_F(DeferredLogRecordTest, UnsignedAndNegativeValues) {
+    unsigned long uptime = 4000000000UL;
+    int delta = -25;
+    EXPECT_EQ(captureAndFormat("uptime=%lu delta=%d", uptime, delta), "uptime=4000000000 delta=-25");
+}
+
+TEST_F(DeferredLogRecordTest, StringArgumentsAreCopied) {
+    char name[16] = "PARK";
+    captureDeferredLog(record, DEBUG_LEVEL_INFO, "%s: %s -> %s", "TrnPrkSys", "UNKNOWN", name);
+    strcpy(name, "XXXX"); // Caller's buffer changes before the writer runs
+
+    formatDeferredLogRecord(record, line, sizeof(line));
+    EXPECT_STREQ(line, "TrnPrkSys: UNKNOWN -> PARK");
+    EXPECT_EQ(record.stringArgs, 0x7);
+}
+
+TEST_F(DeferredLogRecordTest, LongStringsAreTruncated) {
+    std::string longText(2 * DEFERRED_LOG_TEXT_BYTES, 'a');
+    std::string formatted = captureAndFormat("[%s][%s][%d]", longText.c_str(), "next", 7);
+
+    std::string expected = "[" + std::string(DEFERRED_LOG_TEXT_BYTES - 1, 'a') + "][][7]";
+    EXPECT_EQ(formatted, expected);
+    EXPECT_LE(record.textUsed, DEFERRED_LOG_TEXT_BYTES);
+}
+
+TEST_F(DeferredLogRecordTest, NullStringIsSafe) {
+    const char* missing = NULL;
+    EXPECT_EQ(captureAndFormat("value=%s", missing), "value=(null)");
+}
+
+TEST_F(DeferredLogRecordTest, OutputIsBoundedByBufferSize) {
+    char small[8];
+    captureDeferredLog(record, DEBUG_LEVEL_WARN, "%s-%d", "overflow", 12345);
+    int length = formatDeferredLogRecord(record, small, sizeof(small));
+
+    EXPECT_EQ(length, 14);
+    EXPECT_STREQ(small, "overflo");
+}
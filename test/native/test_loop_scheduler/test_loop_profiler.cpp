@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production loop profiler
+#include "../src/loop_profiler.h"
+
+/**
+ * Loop Profiler Test Suite
+ *
+ * Validates the per-section loop accounting behind 'system_info' and 'profile':
+ * - Time between marks is charged to the section that just finished
+ * - The idle share is the wait time over the whole pass, busy time excludes it
+ * - Frames drained per pass and passes that hit the CAN cap are counted
+ * - The stream prints one summary per window and starts a fresh window
+ */
+
+namespace {
+void runPass(unsigned long idleUs, unsigned long canUs, unsigned long jobsUs, uint16_t frames) {
+    beginLoopPass();
+    ArduinoMock::instance().advanceMicros(idleUs);
+    markLoopSection(LOOP_SECTION_IDLE);
+    markLoopSection(LOOP_SECTION_SERIAL);
+    ArduinoMock::instance().advanceMicros(canUs);
+    markLoopSection(LOOP_SECTION_CAN);
+    markLoopSection(LOOP_SECTION_STATE);
+    markLoopSection(LOOP_SECTION_BUTTON);
+    markLoopSection(LOOP_SECTION_OUTPUTS);
+    ArduinoMock::instance().advanceMicros(jobsUs);
+    markLoopSection(LOOP_SECTION_JOBS);
+    endLoopPass(frames);
+}
+}
+
+class LoopProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ArduinoMock::instance().reset();
+        setLoopProfileStreaming(false);
+    }
+};
+
+TEST_F(LoopProfilerTest, SectionsChargeTimeSinceLastMark) {
+    runPass(900, 80, 20, 2);
+    runPass(700, 250, 50, 4);
+
+    LoopProfileStats stats = getLoopProfileStats();
+    EXPECT_EQ(stats.passes, 2u);
+    EXPECT_EQ(stats.cyclesPerUs, 1u);
+    EXPECT_EQ(stats.sectionCycles[LOOP_SECTION_IDLE], 1600u);
+    EXPECT_EQ(stats.sectionCycles[LOOP_SECTION_CAN], 330u);
+    EXPECT_EQ(stats.sectionCycles[LOOP_SECTION_JOBS], 70u);
+    EXPECT_EQ(stats.sectionCycles[LOOP_SECTION_SERIAL], 0u);
+    EXPECT_EQ(stats.sectionMaxCycles[LOOP_SECTION_CAN], 250u);
+    EXPECT_EQ(getLoopIdlePercent(stats), 80);
+}
+
+TEST_F(LoopProfilerTest, BusyTimeExcludesTheIdleWait) {
+    runPass(5000, 100, 0, 0);
+    runPass(10, 300, 100, 0);
+
+    LoopProfileStats stats = getLoopProfileStats();
+    EXPECT_EQ(stats.busyUs.count, 2u);
+    EXPECT_EQ(stats.busyUs.minUs, 100u);
+    EXPECT_EQ(stats.busyUs.maxUs, 400u);
+    EXPECT_EQ(stats.busyUs.totalUs, 500u);
+}
+
+TEST_F(LoopProfilerTest, CountsFramesAndCappedPasses) {
+    runPass(100, 10, 0, 3);
+    runPass(100, 10, 0, CAN_MAX_FRAMES_PER_LOOP);
+    runPass(100, 10, 0, 0);
+
+    LoopProfileStats stats = getLoopProfileStats();
+    EXPECT_EQ(stats.framesDrained, 3u + CAN_MAX_FRAMES_PER_LOOP);
+    EXPECT_EQ(stats.maxFramesPerPass, CAN_MAX_FRAMES_PER_LOOP);
+    EXPECT_EQ(stats.cappedPasses, 1u);
+}
+
+TEST_F(LoopProfilerTest, StreamPrintsSummaryAndStartsNewWindow) {
+    runPass(100, 10, 0, 1);
+    ArduinoMock::instance().clearSerialOutput();
+    serviceLoopProfileStream(millis());
+    EXPECT_TRUE(ArduinoMock::instance().getSerialOutput().empty());
+    EXPECT_EQ(getLoopProfileStats().passes, 1u);
+
+    setLoopProfileStreaming(true);
+    EXPECT_TRUE(isLoopProfileStreaming());
+    EXPECT_EQ(getLoopProfileStats().passes, 0u);
+
+    runPass(100, 10, 0, 1);
+    serviceLoopProfileStream(millis());
+    EXPECT_NE(ArduinoMock::instance().getSerialOutput().find("Loop: 1 passes"), std::string::npos);
+    EXPECT_EQ(getLoopProfileStats().passes, 0u);
+    EXPECT_EQ(getLoopProfileStats().busyUs.count, 0u);
+
+    setLoopProfileStreaming(false);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production deadline scheduler
+#include "../src/loop_scheduler.h"
+
+/**
+ * Loop Scheduler Test Suite
+ *
+ * Validates the deadline scheduler that replaced the fixed delay(10) loop:
+ * - Jobs run when their period elapses, not on every pass
+ * - Idle time is the distance to the earliest deadline, capped by the caller
+ * - millis() rollover and long stalls do not cause missed or burst runs
+ */
+
+namespace {
+unsigned long fastRuns = 0;
+unsigned long slowRuns = 0;
+unsigned long lastRunAt = 0;
+
+void fastJob(unsigned long now) {
+    fastRuns++;
+    lastRunAt = now;
+}
+
+void slowJob(unsigned long now) {
+    (void)now;
+    slowRuns++;
+}
+}
+
+class LoopSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        resetLoopScheduler();
+        fastRuns = 0;
+        slowRuns = 0;
+        lastRunAt = 0;
+    }
+};
+
+TEST_F(LoopSchedulerTest, JobsRunWhenPeriodElapses) {
+    int fast = addLoopJob("fast", 100, fastJob, 0);
+    int slow = addLoopJob("slow", 1000, slowJob, 0);
+    EXPECT_EQ(fast, 0);
+    EXPECT_EQ(slow, 1);
+
+    EXPECT_EQ(runDueLoopJobs(99), 0);
+    EXPECT_EQ(runDueLoopJobs(100), 1);
+    EXPECT_EQ(fastRuns, 1u);
+
+    for (unsigned long t = 110; t <= 1000; t += 10) {
+        runDueLoopJobs(t);
+    }
+    EXPECT_EQ(fastRuns, 10u);
+    EXPECT_EQ(slowRuns, 1u);
+}
+
+TEST_F(LoopSchedulerTest, IdleTimeIsDistanceToNextDeadline) {
+    addLoopJob("fast", 100, fastJob, 0);
+    addLoopJob("slow", 1000, slowJob, 0);
+
+    EXPECT_EQ(getLoopIdleTime(0, 50), 50u);     // Capped by caller
+    EXPECT_EQ(getLoopIdleTime(70, 50), 30u);
+    EXPECT_EQ(getLoopIdleTime(100, 50), 0u);    // Due now
+    EXPECT_EQ(getLoopIdleTime(150, 50), 0u);    // Overdue
+
+    runDueLoopJobs(150);
+    EXPECT_EQ(getLoopIdleTime(150, 500), 50u);
+}
+
+TEST_F(LoopSchedulerTest, EmptySchedulerSleepsForMaxIdle) {
+    EXPECT_EQ(getLoopIdleTime(12345, 50), 50u);
+    EXPECT_EQ(runDueLoopJobs(12345), 0);
+}
+
+TEST_F(LoopSchedulerTest, CadenceIsKeptWhenSlightlyLate) {
+    addLoopJob("fast", 100, fastJob, 0);
+
+    runDueLoopJobs(130);    // 30 ms late
+    EXPECT_EQ(getLoopIdleTime(130, 1000), 70u);
+
+    LoopJobStats stats;
+    ASSERT_TRUE(getLoopJobStats(0, stats));
+    EXPECT_EQ(stats.maxLatenessMs, 30u);
+    EXPECT_EQ(stats.runs, 1u);
+    EXPECT_STREQ(stats.name, "fast");
+}
+
+TEST_F(LoopSchedulerTest, LongStallDoesNotBurst) {
+    addLoopJob("fast", 100, fastJob, 0);
+
+    // A 1 s stall runs the job once, then resumes one period later
+    EXPECT_EQ(runDueLoopJobs(1000), 1);
+    EXPECT_EQ(runDueLoopJobs(1000), 0);
+    EXPECT_EQ(runDueLoopJobs(1099), 0);
+    EXPECT_EQ(runDueLoopJobs(1100), 1);
+    EXPECT_EQ(fastRuns, 2u);
+}
+
+TEST_F(LoopSchedulerTest, MillisRolloverIsHandled) {
+    unsigned long start = (unsigned long)-50;   // 50 ms before wrap
+    addLoopJob("fast", 100, fastJob, start);
+
+    EXPECT_EQ(getLoopIdleTime(start + 10, 1000), 90u);
+    EXPECT_EQ(runDueLoopJobs(start + 99), 0);
+    EXPECT_EQ(runDueLoopJobs(start + 100), 1);  // Deadline is past the wrap
+    EXPECT_EQ(lastRunAt, start + 100);
+}
+
+TEST_F(LoopSchedulerTest, TriggerMakesJobDueImmediately) {
+    int slow = addLoopJob("slow", 1000, slowJob, 0);
+
+    triggerLoopJob(slow);
+    EXPECT_EQ(getLoopIdleTime(10, 50), 0u);
+    EXPECT_EQ(runDueLoopJobs(10), 1);
+    EXPECT_EQ(getLoopIdleTime(10, 5000), 990u);   // Original cadence continues
+
+    triggerLoopJob(-1);     // Ignored
+    triggerLoopJob(7);
+    EXPECT_EQ(runDueLoopJobs(20), 0);
+}
+
+TEST_F(LoopSchedulerTest, RejectsInvalidAndExcessJobs) {
+    EXPECT_EQ(addLoopJob("null", 100, NULL, 0), -1);
+    EXPECT_EQ(addLoopJob("zero", 0, fastJob, 0), -1);
+
+    for (int i = 0; i < LOOP_SCHEDULER_MAX_JOBS; i++) {
+        EXPECT_EQ(addLoopJob("job", 100, fastJob, 0), i);
+    }
+    EXPECT_EQ(addLoopJob("overflow", 100, fastJob, 0), -1);
+    EXPECT_EQ(getLoopJobCount(), LOOP_SCHEDULER_MAX_JOBS);
+}
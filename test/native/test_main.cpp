@@ -127,7 +127,7 @@ TEST_F(ArduinoTest, ArduinoMockTiming) {
 // Test Suite: Message Parsing Logic
 TEST_F(ArduinoTest, MessageParsingValidation) {
     // Test BCM message structure validation
-    CANMessage message = {BCM_LAMP_STAT_FD1_ID, 8, {0}, 1000};
+    CANMessage message = {BCM_LAMP_STAT_FD1_ID, 8, {0}, 1000, CAN_SOURCE_MCP2515, 1000000};
     
     // Valid message
     EXPECT_EQ(message.id, 0x3C3);
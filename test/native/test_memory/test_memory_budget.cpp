@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <string.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production memory budget and the subsystems whose arenas it reports
+#include "../src/memory_budget.h"
+#include "../src/flight_recorder.h"
+#include "../src/can_id_stats.h"
+#include "../src/signal_history.h"
+
+/**
+ * Memory Budget Test Suite
+ *
+ * Validates the static arena report behind 'mem' and the boot summary:
+ * - Each arena reports its build-time size, and peak use never exceeds it
+ * - Peak use follows what the flight recorder, per-ID table and signal
+ *   history actually hold, and is capped once a ring is full
+ * - The total is the sum of the arenas, and a short buffer is not overrun
+ * (The heap baseline and task stacks are firmware-only.)
+ */
+
+namespace {
+CANMessage makeFrame(uint32_t id, uint32_t arrivalUs) {
+    CANMessage message;
+    memset(&message, 0, sizeof(message));
+    message.id = id;
+    message.length = 8;
+    message.arrivalUs = arrivalUs;
+    message.timestamp = arrivalUs / 1000;
+    return message;
+}
+
+const MemoryArena* findArena(const MemoryArena* arenas, uint8_t count, const char* name) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(arenas[i].name, name) == 0) {
+            return &arenas[i];
+        }
+    }
+    return nullptr;
+}
+
+uint32_t makeWord(uint8_t lockStatus, uint8_t soc) {
+    VehicleSignals signals = vehicleSignalsFromWord(0);
+    signals.vehicleLockStatus = lockStatus;
+    signals.batterySOC = soc;
+    return vehicleSignalsWord(signals);
+}
+}
+
+class MemoryBudgetTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ArduinoMock::instance().reset();
+        resetFlightRecorder();
+        resetCANIdStatistics();
+        resetSignalHistory();
+    }
+
+    MemoryArena arenas[MEMORY_ARENA_MAX];
+    uint8_t count = 0;
+
+    const MemoryArena& arena(const char* name) {
+        count = collectMemoryArenas(arenas, MEMORY_ARENA_MAX);
+        const MemoryArena* found = findArena(arenas, count, name);
+        EXPECT_NE(found, nullptr) << name;
+        static const MemoryArena missing = {"", 0, 0};
+        return found ? *found : missing;
+    }
+};
+
+TEST_F(MemoryBudgetTest, ArenasReportTheirBuildTimeSize) {
+    EXPECT_EQ(arena("Flight recorder").staticBytes, FLIGHT_RECORDER_FRAMES * sizeof(FlightFrame));
+    EXPECT_EQ(arena("CAN ID table").staticBytes, CAN_ID_STATS_SLOTS * (sizeof(CANIdStats) + sizeof(bool)));
+    EXPECT_EQ(arena("Signal history").staticBytes, getSignalHistoryStorageBytes());
+    EXPECT_GE(getSignalHistoryStorageBytes(), SIGNAL_HISTORY_COUNT * SIGNAL_HISTORY_EVENT_BYTES);
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        EXPECT_GT(arenas[i].staticBytes, 0u) << arenas[i].name;
+        EXPECT_EQ(arenas[i].peakBytes, 0u) << arenas[i].name;   // Nothing recorded yet
+        total += arenas[i].staticBytes;
+    }
+    EXPECT_EQ(getMemoryArenaTotal(arenas, count), total);
+}
+
+TEST_F(MemoryBudgetTest, PeakFollowsWhatTheArenasHold) {
+    for (uint32_t i = 0; i < 100; i++) {
+        recordFlightFrame(makeFrame(0x100 + (i % 10), i * 1000));
+        recordCANIdFrame(makeFrame(0x100 + (i % 10), i * 1000), 0);
+    }
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 80), 1000);
+    recordSignalHistory(makeWord(VEH_UNLOCK_ALL, 79), 2000);
+
+    EXPECT_EQ(arena("Flight recorder").peakBytes, 100 * sizeof(FlightFrame));
+    EXPECT_EQ(arena("CAN ID table").peakBytes, 10 * (sizeof(CANIdStats) + sizeof(bool)));
+    uint32_t historyBytes = arena("Signal history").peakBytes;
+    EXPECT_EQ(historyBytes, getSignalHistoryBytesInUse());
+    EXPECT_GT(historyBytes, 0u);
+    EXPECT_LE(historyBytes, 4u * 8u);
+}
+
+TEST_F(MemoryBudgetTest, FullRingIsCappedAtItsSize) {
+    for (uint32_t i = 0; i < FLIGHT_RECORDER_FRAMES * 3; i++) {
+        recordFlightFrame(makeFrame(0x200, i * 100));
+    }
+    const MemoryArena& flight = arena("Flight recorder");
+    EXPECT_EQ(flight.peakBytes, flight.staticBytes);
+}
+
+TEST_F(MemoryBudgetTest, ShortBufferIsNotOverrun) {
+    MemoryArena two[3];
+    memset(two, 0, sizeof(two));
+    EXPECT_EQ(collectMemoryArenas(two, 2), 2);
+    EXPECT_EQ(two[2].name, nullptr);
+    EXPECT_EQ(collectMemoryArenas(two, 0), 0);
+}
@@ -5,7 +5,7 @@
 // Import production code structures and functions - using production message_parser.h
 // No need to import can_protocol.h since we removed the duplicate functions
 #include "../src/state_manager.h"
-// isTargetCANMessage is provided by mock_arduino.cpp
+// isTargetCANMessage is provided by can_dispatch.cpp
 // Decision logic functions are declared in state_manager.h
 
 /**
@@ -95,7 +95,7 @@ TEST_F(MessageParserTest, BCMLampStatusBasicParsing) {
     CANTestUtils::setSignalValue(testData, 11, 2, 1); // PudLamp_D_Rq = ON (1)
     
     CANFrame frame = CANTestUtils::createCANFrame(BCM_LAMP_STAT_FD1_ID, testData);
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     BCMLampStatus result;
     
     bool success = parseBCMLampStatus(message, result);
@@ -127,7 +127,7 @@ TEST_F(MessageParserTest, BCMLampStatusPythonValueMapping) {
         CANTestUtils::setSignalValue(testData, 11, 2, testCase.rawValue);
         
         CANFrame frame = CANTestUtils::createCANFrame(BCM_LAMP_STAT_FD1_ID, testData);
-        CANMessage message = convertToCANMessage(frame);
+        CANMessage message = frame;
         BCMLampStatus result;
         
         bool success = parseBCMLampStatus(message, result);
@@ -146,7 +146,7 @@ TEST_F(MessageParserTest, BCMLampStatusInvalidMessage) {
     // Test invalid message ID
     uint8_t testData[8] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0};
     CANFrame frame = CANTestUtils::createCANFrame(0x999, testData); // Wrong ID
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     BCMLampStatus result;
     
     bool success = parseBCMLampStatus(message, result);
@@ -157,7 +157,7 @@ TEST_F(MessageParserTest, BCMLampStatusInvalidMessage) {
     // Test invalid length
     frame.id = BCM_LAMP_STAT_FD1_ID;
     frame.length = 4; // Wrong length
-    message = convertToCANMessage(frame);
+    message = frame;
     
     success = parseBCMLampStatus(message, result);
     EXPECT_FALSE(success);
@@ -176,7 +176,7 @@ TEST_F(MessageParserTest, LockingSystemsBasicParsing) {
     CANTestUtils::setSignalValue(testData, 34, 2, 2); // Veh_Lock_Status = UNLOCK_ALL (2) - match production bit position
     
     CANFrame frame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, testData);
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     LockingSystemsStatus result;
     
     bool success = parseLockingSystemsStatus(message, result);
@@ -214,7 +214,7 @@ TEST_F(MessageParserTest, LockingSystemsRealCANData) {
     
     for (const auto& testCase : testCases) {
         CANFrame frame = CANTestUtils::createCANFrame(LOCKING_SYSTEMS_2_FD1_ID, testCase.data);
-        CANMessage message = convertToCANMessage(frame);
+        CANMessage message = frame;
         LockingSystemsStatus result;
         
         bool success = parseLockingSystemsStatus(message, result);
@@ -247,7 +247,7 @@ TEST_F(MessageParserTest, PowertrainDataBasicParsing) {
     CANTestUtils::setSignalValue(testData, 31, 4, 1); // TrnPrkSys_D_Actl = PARK (1)
     
     CANFrame frame = CANTestUtils::createCANFrame(POWERTRAIN_DATA_10_ID, testData);
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     PowertrainData result;
     
     bool success = parsePowertrainData(message, result);
@@ -286,7 +286,7 @@ TEST_F(MessageParserTest, PowertrainDataPythonValueMapping) {
         CANTestUtils::setSignalValue(testData, 31, 4, testCase.rawValue);
         
         CANFrame frame = CANTestUtils::createCANFrame(POWERTRAIN_DATA_10_ID, testData);
-        CANMessage message = convertToCANMessage(frame);
+        CANMessage message = frame;
         PowertrainData result;
         
         bool success = parsePowertrainData(message, result);
@@ -313,7 +313,7 @@ TEST_F(MessageParserTest, BatteryManagementBasicParsing) {
     CANTestUtils::setSignalValue(testData, 22, 7, 85); // Battery SOC = 85%
     
     CANFrame frame = CANTestUtils::createCANFrame(BATTERY_MGMT_3_FD1_ID, testData);
-    CANMessage message = convertToCANMessage(frame);
+    CANMessage message = frame;
     BatteryManagement result;
     
     bool success = parseBatteryManagement(message, result);
@@ -344,7 +344,7 @@ TEST_F(MessageParserTest, BatteryManagementRangeValues) {
         CANTestUtils::setSignalValue(testData, 22, 7, testCase.rawValue);
         
         CANFrame frame = CANTestUtils::createCANFrame(BATTERY_MGMT_3_FD1_ID, testData);
-        CANMessage message = convertToCANMessage(frame);
+        CANMessage message = frame;
         BatteryManagement result;
         
         bool success = parseBatteryManagement(message, result);
@@ -416,10 +416,10 @@ TEST_F(MessageParserTest, ComprehensiveMessageValidation) {
     CANFrame battFrame = CANTestUtils::createCANFrame(BATTERY_MGMT_3_FD1_ID, battData);
     
     // Parse all messages
-    CANMessage bcmMessage = convertToCANMessage(bcmFrame);
-    CANMessage lockMessage = convertToCANMessage(lockFrame);
-    CANMessage powerMessage = convertToCANMessage(powerFrame);
-    CANMessage battMessage = convertToCANMessage(battFrame);
+    CANMessage bcmMessage = bcmFrame;
+    CANMessage lockMessage = lockFrame;
+    CANMessage powerMessage = powerFrame;
+    CANMessage battMessage = battFrame;
     
     BCMLampStatus bcmResult;
     LockingSystemsStatus lockResult;
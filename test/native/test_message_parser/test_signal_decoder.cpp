@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "common/test_config.h"
+
+// Import production signal descriptors, decoders and the reference extractor
+#include "../src/dbc_signals.h"
+#include "../src/bit_utils.h"
+
+/**
+ * Signal Decoder Test Suite
+ *
+ * Validates the compile-time decoders in signal_decoder.h and the descriptors
+ * generated from minimal.dbc into dbc_signals.h:
+ * - Generated descriptors decode exactly what the validated extractBits() does
+ * - Intel, single-byte Motorola and multi-byte Motorola bit layouts
+ * - Sign extension and physical scaling
+ */
+
+namespace {
+constexpr CANSignalSpec INTEL_12BIT = {12, 12, CAN_BYTE_ORDER_INTEL, false, 1.0f, 0.0f, 0.0f, 4095.0f};
+constexpr CANSignalSpec MOTOROLA_16BIT = {7, 16, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 65535.0f};
+constexpr CANSignalSpec MOTOROLA_12BIT_MID = {19, 12, CAN_BYTE_ORDER_MOTOROLA, false, 1.0f, 0.0f, 0.0f, 4095.0f};
+constexpr CANSignalSpec SIGNED_8BIT = {8, 8, CAN_BYTE_ORDER_INTEL, true, 0.5f, -10.0f, -74.0f, 53.5f};
+}
+
+class SignalDecoderTest : public ::testing::Test {
+protected:
+    uint8_t data[8];
+
+    void SetUp() override {
+        memset(data, 0, sizeof(data));
+    }
+};
+
+TEST_F(SignalDecoderTest, GeneratedSignalsMatchExtractBits) {
+    std::mt19937 rng(12345);
+
+    for (int i = 0; i < 1000; i++) {
+        for (int b = 0; b < 8; b++) {
+            data[b] = (uint8_t)rng();
+        }
+        uint64_t payload = loadCANPayload(data);
+
+        EXPECT_EQ(decodeSignal<dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq>(payload), extractBits(data, 11, 2));
+        EXPECT_EQ(decodeSignal<dbc::BCM_Lamp_Stat_FD1::Illuminated_Entry_Stat>(payload), extractBits(data, 63, 2));
+        EXPECT_EQ(decodeSignal<dbc::BCM_Lamp_Stat_FD1::Dr_Courtesy_Light_Stat>(payload), extractBits(data, 49, 2));
+        EXPECT_EQ(decodeSignal<dbc::Locking_Systems_2_FD1::Veh_Lock_Status>(payload), extractBits(data, 34, 2));
+        EXPECT_EQ(decodeSignal<dbc::PowertrainData_10::TrnPrkSys_D_Actl>(payload), extractBits(data, 31, 4));
+        EXPECT_EQ(decodeSignal<dbc::Battery_Mgmt_3_FD1::BSBattSOC>(payload), extractBits(data, 22, 7));
+    }
+}
+
+TEST_F(SignalDecoderTest, GeneratedMessageMetadata) {
+    EXPECT_EQ(dbc::BCM_Lamp_Stat_FD1::ID, (uint32_t)BCM_LAMP_STAT_FD1_ID);
+    EXPECT_EQ(dbc::Locking_Systems_2_FD1::ID, (uint32_t)LOCKING_SYSTEMS_2_FD1_ID);
+    EXPECT_EQ(dbc::PowertrainData_10::ID, (uint32_t)POWERTRAIN_DATA_10_ID);
+    EXPECT_EQ(dbc::Battery_Mgmt_3_FD1::ID, (uint32_t)BATTERY_MGMT_3_FD1_ID);
+    EXPECT_EQ(dbc::Battery_Mgmt_3_FD1::LENGTH, 8);
+    EXPECT_FLOAT_EQ(dbc::Battery_Mgmt_3_FD1::BSBattSOC.maximum, 127.0f);
+}
+
+TEST_F(SignalDecoderTest, ShiftsAreCompileTimeConstants) {
+    static_assert(canSignalShift(dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq) == 10, "PudLamp_D_Rq LSB");
+    static_assert(canSignalShift(dbc::Battery_Mgmt_3_FD1::BSBattSOC) == 16, "BSBattSOC LSB");
+    static_assert(canSignalMask(dbc::PowertrainData_10::TrnPrkSys_D_Actl) == 0xF, "TrnPrkSys_D_Actl mask");
+    static_assert(!canSignalNeedsSwap(dbc::Locking_Systems_2_FD1::Veh_Lock_Status), "single-byte signal");
+    SUCCEED();
+}
+
+TEST_F(SignalDecoderTest, IntelSignalAcrossBytes) {
+    // 12 bits starting at bit 12: high nibble of byte 1 and all of byte 2
+    data[1] = 0xB0;
+    data[2] = 0x5A;
+    EXPECT_EQ(decodeSignal<INTEL_12BIT>(loadCANPayload(data)), 0x5ABu);
+}
+
+TEST_F(SignalDecoderTest, MotorolaSignalAcrossBytes) {
+    // MSB at byte 0 bit 7, continuing into byte 1
+    data[0] = 0x12;
+    data[1] = 0x34;
+    EXPECT_TRUE(canSignalNeedsSwap(MOTOROLA_16BIT));
+    EXPECT_EQ(decodeSignal<MOTOROLA_16BIT>(loadCANPayload(data)), 0x1234u);
+
+    // MSB at byte 2 bit 3: low nibble of byte 2, then all of byte 3
+    memset(data, 0, sizeof(data));
+    data[2] = 0xF7;
+    data[3] = 0x89;
+    EXPECT_EQ(decodeSignal<MOTOROLA_12BIT_MID>(loadCANPayload(data)), 0x789u);
+}
+
+TEST_F(SignalDecoderTest, SignedAndPhysicalValues) {
+    data[1] = 0xFE; // -2
+    uint64_t payload = loadCANPayload(data);
+    EXPECT_EQ(decodeSignalSigned<SIGNED_8BIT>(payload), -2);
+    EXPECT_FLOAT_EQ(decodeSignalPhysical<SIGNED_8BIT>(payload), -11.0f);
+
+    data[1] = 0x14; // 20
+    EXPECT_FLOAT_EQ(decodeSignalPhysical<SIGNED_8BIT>(loadCANPayload(data)), 0.0f);
+
+    data[2] = 0x64; // BSBattSOC = 100
+    EXPECT_FLOAT_EQ(decodeSignalPhysical<dbc::Battery_Mgmt_3_FD1::BSBattSOC>(loadCANPayload(data)), 100.0f);
+}
+
+TEST_F(SignalDecoderTest, PayloadMasksCoverOnlySignalBits) {
+    // Masks used by the change filter in can_dispatch.cpp
+    constexpr uint64_t bcmMask = canSignalsPayloadMask(dbc::BCM_Lamp_Stat_FD1::PudLamp_D_Rq,
+                                                       dbc::BCM_Lamp_Stat_FD1::Illuminated_Entry_Stat,
+                                                       dbc::BCM_Lamp_Stat_FD1::Dr_Courtesy_Light_Stat);
+    EXPECT_EQ(bcmMask, 0xC003000000000C00ULL);
+    EXPECT_EQ(canSignalPayloadMask(dbc::Battery_Mgmt_3_FD1::BSBattSOC), 0x7F0000ULL);
+
+    // Multi-byte Motorola: bytes 0 and 1 of the payload
+    EXPECT_EQ(canSignalPayloadMask(MOTOROLA_16BIT), 0xFFFFULL);
+
+    // A counter outside the mask does not change the masked payload
+    data[1] = 0x08;
+    uint64_t before = loadCANPayload(data) & bcmMask;
+    data[0] = 0x5A;
+    data[5] = 0xA5;
+    EXPECT_EQ(loadCANPayload(data) & bcmMask, before);
+    data[1] = 0x04;
+    EXPECT_NE(loadCANPayload(data) & bcmMask, before);
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include "../../common/test_helpers.h"
+#include "../../common/test_config.h"
+#include "../../common/arduino_test_interface.h"
+
+// Import production output channel engine
+#include "../../../src/output_channels.h"
+
+/**
+ * Output Channel Test Suite
+ *
+ * Validates the table-driven output channels with a table of their own:
+ * - Level channels follow setOutputChannel() and report changes
+ * - Pulse channels end on time, independently, from one shared deadline
+ * - The loop idle time is the earliest pulse end, not a fixed poll
+ * - PWM channels set up LEDC, clamp duty and switch between off and full
+ * - Fading channels hand ramps to the LEDC fade engine, defer changes that
+ *   arrive mid-fade, and switch directly when no fade engine is available
+ * - Misconfigured tables are rejected
+ */
+
+namespace {
+
+enum TestChannel {
+    CH_RELAY = 0,
+    CH_SHORT_PULSE,
+    CH_LONG_PULSE,
+    CH_DIMMER,
+    CH_FADER,
+    CH_COUNT
+};
+
+const OutputChannelConfig testTable[CH_COUNT] = {
+    {"relay",       12, OUTPUT_MODE_LEVEL, 0,   0, 0,    0,  0,   0},
+    {"short_pulse", 13, OUTPUT_MODE_PULSE, 100, 0, 0,    0,  0,   0},
+    {"long_pulse",  14, OUTPUT_MODE_PULSE, 300, 0, 0,    0,  0,   0},
+    {"dimmer",      40, OUTPUT_MODE_PWM,   0,   3, 5000, 8,  0,   0},
+    {"fader",       41, OUTPUT_MODE_PWM,   0,   4, 1000, 10, 400, 800},
+};
+
+}  // namespace
+
+class OutputChannelTest : public ArduinoTest {
+protected:
+    ArduinoTestInterface testInterface;
+
+    void SetUp() override {
+        ArduinoTest::SetUp();
+        setTime(1000);
+        ASSERT_TRUE(initializeOutputChannels(testTable, CH_COUNT, &testInterface));
+    }
+};
+
+TEST_F(OutputChannelTest, InitializationDrivesEverythingOff) {
+    EXPECT_EQ(getOutputChannelCount(), CH_COUNT);
+    EXPECT_EQ(ArduinoMock::instance().getPinMode(12), OUTPUT);
+    EXPECT_EQ(ArduinoMock::instance().getPinMode(14), OUTPUT);
+    EXPECT_FALSE(isGPIOHigh(12));
+    EXPECT_EQ(testInterface.pwmPin[3], 40);
+    EXPECT_EQ(testInterface.pwmFrequencyHz[3], 5000u);
+    EXPECT_EQ(testInterface.pwmResolutionBits[3], 8);
+    EXPECT_EQ(testInterface.pwmDuty[3], 0u);
+    EXPECT_EQ(findOutputChannel("long_pulse"), CH_LONG_PULSE);
+    EXPECT_EQ(findOutputChannel("compressor"), -1);
+    EXPECT_EQ(getOutputChannelConfig(CH_COUNT), nullptr);
+}
+
+TEST_F(OutputChannelTest, LevelChannelFollowsRequests) {
+    EXPECT_TRUE(setOutputChannel(CH_RELAY, true));
+    EXPECT_TRUE(isGPIOHigh(12));
+    EXPECT_FALSE(setOutputChannel(CH_RELAY, true));   // No change
+    EXPECT_TRUE(setOutputChannel(CH_RELAY, false));
+    EXPECT_FALSE(isGPIOHigh(12));
+    EXPECT_FALSE(setOutputChannel(CH_COUNT, true));   // Unknown channel
+}
+
+TEST_F(OutputChannelTest, PulsesEndIndependently) {
+    setOutputChannel(CH_LONG_PULSE, true);
+    advanceTime(50);
+    setOutputChannel(CH_SHORT_PULSE, true);
+    EXPECT_EQ(getOutputChannelState(CH_SHORT_PULSE).activatedMs, 1050u);
+
+    advanceTime(99);
+    serviceOutputChannels(millis());
+    EXPECT_TRUE(isGPIOHigh(13));
+    advanceTime(1);
+    serviceOutputChannels(millis());
+    EXPECT_FALSE(isGPIOHigh(13));
+    EXPECT_FALSE(isOutputChannelActive(CH_SHORT_PULSE));
+    EXPECT_TRUE(isGPIOHigh(14));
+
+    advanceTime(150);   // 300 ms since the long pulse started
+    serviceOutputChannels(millis());
+    EXPECT_FALSE(isGPIOHigh(14));
+    EXPECT_EQ(getOutputChannelState(CH_LONG_PULSE).activatedMs, 0u);
+}
+
+TEST_F(OutputChannelTest, IdleTimeIsEarliestPulseEnd) {
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 1000u);
+
+    setOutputChannel(CH_LONG_PULSE, true);
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 300u);
+    advanceTime(20);
+    setOutputChannel(CH_SHORT_PULSE, true);
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 100u);
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 40), 40u);
+
+    advanceTime(100);
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 0u);   // Overdue
+    serviceOutputChannels(millis());
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 180u);
+}
+
+TEST_F(OutputChannelTest, PulseCanBeEndedEarlyAndRestarted) {
+    setOutputChannel(CH_SHORT_PULSE, true);
+    advanceTime(30);
+    EXPECT_FALSE(setOutputChannel(CH_SHORT_PULSE, true));   // Running pulse is not extended
+    EXPECT_TRUE(setOutputChannel(CH_SHORT_PULSE, false));
+    EXPECT_FALSE(isGPIOHigh(13));
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 1000u);
+
+    EXPECT_TRUE(setOutputChannel(CH_SHORT_PULSE, true));
+    EXPECT_EQ(getOutputChannelState(CH_SHORT_PULSE).activatedMs, 1030u);
+}
+
+TEST_F(OutputChannelTest, ExpiredPulseDoesNotBlockNewActivation) {
+    setOutputChannel(CH_SHORT_PULSE, true);
+    advanceTime(150);   // No service pass in between
+    EXPECT_TRUE(setOutputChannel(CH_SHORT_PULSE, true));
+    EXPECT_TRUE(isGPIOHigh(13));
+    EXPECT_EQ(getOutputChannelState(CH_SHORT_PULSE).activatedMs, 1150u);
+}
+
+TEST_F(OutputChannelTest, PwmDutyIsClampedAndReported) {
+    EXPECT_TRUE(setOutputChannelDuty(CH_DIMMER, 64));
+    EXPECT_EQ(testInterface.pwmDuty[3], 64u);
+    EXPECT_TRUE(isOutputChannelActive(CH_DIMMER));
+    EXPECT_EQ(getOutputChannelState(CH_DIMMER).duty, 64);
+
+    uint32_t writes = testInterface.pwmWrites;
+    EXPECT_FALSE(setOutputChannelDuty(CH_DIMMER, 64));   // Unchanged duty is not rewritten
+    EXPECT_EQ(testInterface.pwmWrites, writes);
+
+    EXPECT_TRUE(setOutputChannelDuty(CH_DIMMER, 1000));
+    EXPECT_EQ(testInterface.pwmDuty[3], 255u);
+    EXPECT_TRUE(setOutputChannel(CH_DIMMER, false));
+    EXPECT_EQ(testInterface.pwmDuty[3], 0u);
+    EXPECT_FALSE(isOutputChannelActive(CH_DIMMER));
+    EXPECT_TRUE(setOutputChannel(CH_DIMMER, true));
+    EXPECT_EQ(testInterface.pwmDuty[3], 255u);
+
+    EXPECT_FALSE(setOutputChannelDuty(CH_RELAY, 10));   // Not a PWM channel
+}
+
+TEST_F(OutputChannelTest, BatchCoversLevelAndPulseChannels) {
+    beginOutputBatch();
+    setOutputChannel(CH_RELAY, true);
+    setOutputChannel(CH_SHORT_PULSE, true);
+    EXPECT_FALSE(isGPIOHigh(12));
+    EXPECT_TRUE(commitOutputBatch());
+    EXPECT_TRUE(isGPIOHigh(12));
+    EXPECT_TRUE(isGPIOHigh(13));
+}
+
+TEST_F(OutputChannelTest, MisconfiguredTablesAreRejected) {
+    const OutputChannelConfig zeroPulse[] = {{"opener", 4, OUTPUT_MODE_PULSE, 0, 0, 0, 0, 0, 0}};
+    const OutputChannelConfig highPin[] = {{"relay", 40, OUTPUT_MODE_LEVEL, 0, 0, 0, 0, 0, 0}};
+    const OutputChannelConfig wideDuty[] = {{"dimmer", 40, OUTPUT_MODE_PWM, 0, 0, 1000, 20, 0, 0}};
+    EXPECT_FALSE(initializeOutputChannels(zeroPulse, 1, &testInterface));
+    EXPECT_FALSE(initializeOutputChannels(highPin, 1, &testInterface));
+    EXPECT_FALSE(initializeOutputChannels(wideDuty, 1, &testInterface));
+    EXPECT_FALSE(initializeOutputChannels(testTable, OUTPUT_CHANNEL_MAX + 1, &testInterface));
+
+    // The previous table stays in effect
+    EXPECT_EQ(getOutputChannelCount(), CH_COUNT);
+}
+
+TEST_F(OutputChannelTest, FadeRunsInLedcFadeEngine) {
+    EXPECT_TRUE(setOutputChannel(CH_FADER, true));
+    EXPECT_EQ(testInterface.pwmFades, 1u);
+    EXPECT_EQ(testInterface.pwmDuty[4], 1023u);
+    EXPECT_EQ(testInterface.pwmFadeMs[4], 400u);
+    EXPECT_TRUE(isOutputChannelActive(CH_FADER));
+
+    // Nothing to do per step while the ramp runs
+    uint32_t writes = testInterface.pwmWrites;
+    for (int i = 0; i < 10; i++) {
+        advanceTime(30);
+        serviceOutputChannels(millis());
+    }
+    EXPECT_EQ(testInterface.pwmWrites, writes);
+    EXPECT_EQ(testInterface.pwmFades, 1u);
+}
+
+TEST_F(OutputChannelTest, ChangeDuringFadeStartsWhenFadeEnds) {
+    setOutputChannel(CH_FADER, true);
+    advanceTime(100);
+    EXPECT_TRUE(setOutputChannel(CH_FADER, false));
+    EXPECT_FALSE(isOutputChannelActive(CH_FADER));     // State is the new target at once
+    EXPECT_EQ(testInterface.pwmFades, 1u);             // but LEDC still owns the ramp
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 300u);
+
+    advanceTime(299);
+    serviceOutputChannels(millis());
+    EXPECT_EQ(testInterface.pwmFades, 1u);
+    advanceTime(1);
+    serviceOutputChannels(millis());
+    EXPECT_EQ(testInterface.pwmFades, 2u);
+    EXPECT_EQ(testInterface.pwmDuty[4], 0u);
+    EXPECT_EQ(testInterface.pwmFadeMs[4], 800u);
+    EXPECT_EQ(getOutputChannelIdleTime(millis(), 1000), 1000u);
+}
+
+TEST_F(OutputChannelTest, FadeFallsBackToDirectWrite) {
+    testInterface.fadeSupported = false;
+    EXPECT_TRUE(setOutputChannel(CH_FADER, true));
+    EXPECT_EQ(testInterface.pwmFades, 0u);
+    EXPECT_EQ(testInterface.pwmDuty[4], 1023u);
+
+    // No ramp is running, so the next change is written at once
+    EXPECT_TRUE(setOutputChannel(CH_FADER, false));
+    EXPECT_EQ(testInterface.pwmDuty[4], 0u);
+}
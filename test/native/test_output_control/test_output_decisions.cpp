@@ -479,3 +479,86 @@ TEST_F(SystemReadyIndicatorTest, SystemReadyIndependentOfOtherOutputs) {
     EXPECT_FALSE(isGPIOHigh(SYSTEM_READY_PIN));
     EXPECT_TRUE(state.bedlight);
 }
+
+// Test Suite for Batched Output Writes
+class CountingTestInterface : public ArduinoTestInterface {
+public:
+    int writeOutputsCalls = 0;
+    uint32_t lastSetMask = 0;
+    uint32_t lastClearMask = 0;
+    
+    void writeOutputs(uint32_t setMask, uint32_t clearMask) override {
+        writeOutputsCalls++;
+        lastSetMask = setMask;
+        lastClearMask = clearMask;
+        ArduinoTestInterface::writeOutputs(setMask, clearMask);
+    }
+};
+
+class OutputBatchTest : public ArduinoTest {
+protected:
+    CountingTestInterface testInterface;
+    
+    void SetUp() override {
+        ArduinoTest::SetUp();
+        initializeGPIOWithInterface(&testInterface);
+        setTime(1000);
+        testInterface.writeOutputsCalls = 0;
+    }
+};
+
+TEST_F(OutputBatchTest, UnbatchedChangeWritesImmediately) {
+    setBedlight(true);
+    EXPECT_EQ(testInterface.writeOutputsCalls, 1);
+    EXPECT_EQ(testInterface.lastSetMask, 1UL << BEDLIGHT_PIN);
+    EXPECT_TRUE(isGPIOHigh(BEDLIGHT_PIN));
+}
+
+TEST_F(OutputBatchTest, BatchAppliesAllChangesInOneWrite) {
+    beginGPIOBatch();
+    setBedlight(true);
+    setSystemReady(true);
+    setToolboxOpener(true);
+    EXPECT_EQ(testInterface.writeOutputsCalls, 0);
+    EXPECT_FALSE(isGPIOHigh(BEDLIGHT_PIN));
+    
+    commitGPIOBatch();
+    EXPECT_EQ(testInterface.writeOutputsCalls, 1);
+    EXPECT_EQ(testInterface.lastSetMask,
+              (1UL << BEDLIGHT_PIN) | (1UL << SYSTEM_READY_PIN) | (1UL << TOOLBOX_OPENER_PIN));
+    EXPECT_TRUE(isGPIOHigh(BEDLIGHT_PIN));
+    EXPECT_TRUE(isGPIOHigh(SYSTEM_READY_PIN));
+    EXPECT_TRUE(isGPIOHigh(TOOLBOX_OPENER_PIN));
+}
+
+TEST_F(OutputBatchTest, SafeShutdownPatternClearsTogether) {
+    setBedlight(true);
+    setSystemReady(true);
+    testInterface.writeOutputsCalls = 0;
+    
+    beginGPIOBatch();
+    setBedlight(false);
+    setToolboxOpener(false);   // Already off - no pin change
+    setSystemReady(false);
+    commitGPIOBatch();
+    
+    EXPECT_EQ(testInterface.writeOutputsCalls, 1);
+    EXPECT_EQ(testInterface.lastSetMask, 0u);
+    EXPECT_EQ(testInterface.lastClearMask, (1UL << BEDLIGHT_PIN) | (1UL << SYSTEM_READY_PIN));
+    EXPECT_FALSE(isGPIOHigh(BEDLIGHT_PIN));
+    EXPECT_FALSE(isGPIOHigh(SYSTEM_READY_PIN));
+}
+
+TEST_F(OutputBatchTest, NestedBatchCommitsAtOutermost) {
+    beginGPIOBatch();
+    beginGPIOBatch();
+    setBedlight(true);
+    commitGPIOBatch();
+    EXPECT_EQ(testInterface.writeOutputsCalls, 0);
+    commitGPIOBatch();
+    EXPECT_EQ(testInterface.writeOutputsCalls, 1);
+    
+    // Unbalanced commit is ignored
+    commitGPIOBatch();
+    EXPECT_EQ(testInterface.writeOutputsCalls, 1);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production rule tables
+#include "../src/output_rules.h"
+
+/**
+ * Output Rule Table Test Suite
+ *
+ * Validates the compiled output rules against the hand-written decision
+ * logic they replaced:
+ * - Flag rules agree with the reference logic for all 64 flag words
+ * - Value rules agree for every raw value of their signal (and beyond it)
+ * - The state manager's decision helpers are rule lookups
+ * - The rule compiler handles negation, nesting and out-of-range values
+ */
+
+namespace {
+
+bool referenceToolbox(uint32_t flags) {
+    return (flags & VEHICLE_FLAG_SYSTEM_READY) && (flags & VEHICLE_FLAG_PARKED) && (flags & VEHICLE_FLAG_UNLOCKED);
+}
+
+bool referenceBedlight(uint32_t flags) {
+    if (!(flags & VEHICLE_FLAG_SYSTEM_READY)) {
+        return false;
+    }
+    if (flags & VEHICLE_FLAG_MANUAL_OVERRIDE) {
+        return (flags & VEHICLE_FLAG_MANUAL_STATE) != 0;
+    }
+    return (flags & VEHICLE_FLAG_BEDLIGHT_REQUESTED) != 0;
+}
+
+}  // namespace
+
+class OutputRulesTest : public ::testing::Test {};
+
+TEST_F(OutputRulesTest, ToolboxRuleMatchesReferenceForEveryFlagWord) {
+    for (uint32_t flags = 0; flags < (1u << RULE_FLAG_INPUTS); flags++) {
+        EXPECT_EQ(TOOLBOX_OPENER_RULE.evaluate(flags), referenceToolbox(flags)) << "flags=" << flags;
+    }
+}
+
+TEST_F(OutputRulesTest, BedlightRuleMatchesReferenceForEveryFlagWord) {
+    for (uint32_t flags = 0; flags < (1u << RULE_FLAG_INPUTS); flags++) {
+        EXPECT_EQ(BEDLIGHT_RULE.evaluate(flags), referenceBedlight(flags)) << "flags=" << flags;
+        EXPECT_EQ(decideBedlightOutput(flags), referenceBedlight(flags)) << "flags=" << flags;
+    }
+}
+
+TEST_F(OutputRulesTest, ToolboxHelperUsesRule) {
+    for (uint32_t flags = 0; flags < 8; flags++) {
+        bool ready = flags & VEHICLE_FLAG_SYSTEM_READY;
+        bool parked = flags & VEHICLE_FLAG_PARKED;
+        bool unlocked = flags & VEHICLE_FLAG_UNLOCKED;
+        EXPECT_EQ(shouldActivateToolboxWithParams(ready, parked, unlocked), ready && parked && unlocked);
+    }
+}
+
+TEST_F(OutputRulesTest, ValueRulesMatchReferenceForEveryRawValue) {
+    for (uint32_t value = 0; value < 512; value++) {
+        EXPECT_EQ(BEDLIGHT_REQUEST_RULE.evaluate(value), value == PUDLAMP_ON || value == PUDLAMP_RAMP_UP);
+        EXPECT_EQ(UNLOCKED_RULE.evaluate(value), value == VEH_UNLOCK_ALL || value == VEH_UNLOCK_DRV);
+        EXPECT_EQ(PARKED_RULE.evaluate(value), value == TRNPRKSTS_PARK);
+    }
+    for (uint32_t value = 0; value < 256; value++) {
+        EXPECT_EQ(shouldEnableBedlight(value), BEDLIGHT_REQUEST_RULE.evaluate(value));
+        EXPECT_EQ(isVehicleUnlocked(value), UNLOCKED_RULE.evaluate(value));
+        EXPECT_EQ(isVehicleParked(value), PARKED_RULE.evaluate(value));
+    }
+    EXPECT_FALSE(isVehicleUnlocked(VEH_LOCK_UNKNOWN));
+    EXPECT_FALSE(isVehicleUnlocked(VEH_LOCK_ALL));
+    EXPECT_TRUE(isVehicleUnlocked(VEH_UNLOCK_DRV));
+    EXPECT_TRUE(isVehicleParked(TRNPRKSTS_PARK));
+    EXPECT_FALSE(isVehicleParked(TRNPRKSTS_OUT_OF_PARK));
+}
+
+TEST_F(OutputRulesTest, CompilerHandlesNegationAndUnusedBits) {
+    constexpr RuleFlag A(0), B(1), C(5);
+    constexpr FlagRuleTable xorRule = compileFlagRule((A && !B) || (!A && B));
+    constexpr FlagRuleTable notRule = compileFlagRule(!C);
+    static_assert(xorRule.evaluate(0b01) && xorRule.evaluate(0b10), "compiled at build time");
+
+    for (uint32_t flags = 0; flags < (1u << RULE_FLAG_INPUTS); flags++) {
+        EXPECT_EQ(xorRule.evaluate(flags), ((flags & 1) != 0) != ((flags & 2) != 0));
+        EXPECT_EQ(notRule.evaluate(flags), (flags & 0x20) == 0);
+    }
+    // Bits above the rule inputs do not change the result
+    EXPECT_EQ(xorRule.evaluate(0xFFC1), xorRule.evaluate(0x01));
+}
+
+TEST_F(OutputRulesTest, ValueRuleIgnoresValuesOutsideTheField) {
+    constexpr uint32_t values[] = {1, 300};
+    constexpr ValueRuleTable<8> rule = compileValueRule<8>(values);
+    static_assert(!valueRuleInputsFit<8>(values), "300 does not fit 8 bits");
+    EXPECT_TRUE(rule.evaluate(1));
+    EXPECT_FALSE(rule.evaluate(300));
+    EXPECT_FALSE(rule.evaluate(44));
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production light sleep policy
+#include "../src/sleep_policy.h"
+
+/**
+ * Light Sleep Policy Test Suite
+ *
+ * Validates when the board may light sleep and what it reports:
+ * - Only a parked, locked truck on a quiet bus with every output off sleeps
+ * - The first blocker that applies is the one reported
+ * - Sleep time and wake causes are accumulated
+ * - Wake-to-first-frame latency counts only the first frame after a wake
+ * - Bus wakes that never produced a frame are counted as suspect
+ */
+
+namespace {
+
+SleepConditions makeSleepyConditions() {
+    SleepConditions conditions = {};
+    conditions.signals.isParked = 1;
+    conditions.signals.vehicleLockStatus = VEH_LOCK_ALL;
+    conditions.busQuietMs = LIGHT_SLEEP_BUS_QUIET_MS;
+    conditions.idleMs = 1000;
+    conditions.outputsActive = false;
+    conditions.busy = false;
+    return conditions;
+}
+
+}  // namespace
+
+class SleepPolicyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        resetSleepStats();
+    }
+};
+
+TEST_F(SleepPolicyTest, ParkedLockedAndQuietMaySleep) {
+    SleepConditions conditions = makeSleepyConditions();
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_NONE);
+
+    conditions.signals.vehicleLockStatus = VEH_LOCK_DBL;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_NONE);
+}
+
+TEST_F(SleepPolicyTest, EachConditionBlocksSleep) {
+    SleepConditions conditions = makeSleepyConditions();
+    conditions.signals.isParked = 0;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_NOT_PARKED);
+
+    conditions = makeSleepyConditions();
+    conditions.signals.vehicleLockStatus = VEH_UNLOCK_ALL;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_NOT_LOCKED);
+    conditions.signals.vehicleLockStatus = VEH_LOCK_UNKNOWN;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_NOT_LOCKED);
+
+    conditions = makeSleepyConditions();
+    conditions.busQuietMs = LIGHT_SLEEP_BUS_QUIET_MS - 1;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_BUS_ACTIVE);
+
+    conditions = makeSleepyConditions();
+    conditions.outputsActive = true;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_OUTPUT_ACTIVE);
+
+    conditions = makeSleepyConditions();
+    conditions.busy = true;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_BUSY);
+
+    conditions = makeSleepyConditions();
+    conditions.idleMs = LIGHT_SLEEP_MIN_IDLE_MS - 1;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_SHORT_IDLE);
+}
+
+TEST_F(SleepPolicyTest, FirstBlockerIsReported) {
+    SleepConditions conditions = makeSleepyConditions();
+    conditions.signals.isParked = 0;
+    conditions.signals.vehicleLockStatus = VEH_UNLOCK_ALL;
+    conditions.busQuietMs = 0;
+    EXPECT_EQ(getSleepBlocker(conditions), SLEEP_BLOCK_NOT_PARKED);
+    EXPECT_STREQ(getSleepBlockerName(SLEEP_BLOCK_NOT_PARKED), "not parked");
+
+    noteSleepBlocker(SLEEP_BLOCK_BUS_ACTIVE);
+    EXPECT_EQ(getSleepStats().blocker, SLEEP_BLOCK_BUS_ACTIVE);
+}
+
+TEST_F(SleepPolicyTest, SleepTimeAndWakeCausesAccumulate) {
+    recordSleepWake(SLEEP_WAKE_TIMER, 5000000, 5000000);
+    recordSleepWake(SLEEP_WAKE_CAN, 2000000, 7100000);
+    recordSleepWake(SLEEP_WAKE_BUTTON, 500000, 7700000);
+    recordSleepWake(42, 100, 7800000);
+
+    SleepStats stats = getSleepStats();
+    EXPECT_EQ(stats.sleeps, 4u);
+    EXPECT_EQ(stats.totalSleepUs, 7500100u);
+    EXPECT_EQ(stats.lastSleepUs, 100u);
+    EXPECT_EQ(stats.longestSleepUs, 5000000u);
+    EXPECT_EQ(stats.wakes[SLEEP_WAKE_TIMER], 1u);
+    EXPECT_EQ(stats.wakes[SLEEP_WAKE_CAN], 1u);
+    EXPECT_EQ(stats.wakes[SLEEP_WAKE_BUTTON], 1u);
+    EXPECT_EQ(stats.wakes[SLEEP_WAKE_OTHER], 1u);   // Out-of-range cause
+    EXPECT_EQ(stats.lastWakeCause, SLEEP_WAKE_OTHER);
+}
+
+TEST_F(SleepPolicyTest, OnlyFirstFrameAfterWakeIsTimed) {
+    noteFrameAfterWake(1000);   // No wake yet
+    EXPECT_EQ(getSleepStats().framesAfterWake, 0u);
+
+    recordSleepWake(SLEEP_WAKE_CAN, 1000000, 2000000);
+    noteFrameAfterWake(2001500);
+    noteFrameAfterWake(2009000);
+    SleepStats stats = getSleepStats();
+    EXPECT_EQ(stats.framesAfterWake, 1u);
+    EXPECT_EQ(stats.lastWakeToFrameUs, 1500u);
+    EXPECT_EQ(stats.maxWakeToFrameUs, 1500u);
+
+    recordSleepWake(SLEEP_WAKE_TWAI, 1000000, 4000000);
+    noteFrameAfterWake(4000400);
+    stats = getSleepStats();
+    EXPECT_EQ(stats.lastWakeToFrameUs, 400u);
+    EXPECT_EQ(stats.maxWakeToFrameUs, 1500u);
+}
+
+TEST_F(SleepPolicyTest, BusWakeWithoutFrameIsCounted) {
+    recordSleepWake(SLEEP_WAKE_CAN, 1000000, 1000000);
+    recordSleepWake(SLEEP_WAKE_TIMER, 1000000, 2000000);   // CAN wake delivered nothing
+    recordSleepWake(SLEEP_WAKE_TIMER, 1000000, 3000000);   // Timer wakes are not expected to
+    EXPECT_EQ(getSleepStats().busWakesWithoutFrame, 1u);
+
+    resetSleepStats();
+    EXPECT_EQ(getSleepStats().sleeps, 0u);
+    EXPECT_EQ(getSleepStats().busWakesWithoutFrame, 0u);
+}
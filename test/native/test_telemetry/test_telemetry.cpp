@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production telemetry encoding and the state change journal it drains
+#include "../src/telemetry_protocol.h"
+#include "../src/state_manager.h"
+
+/**
+ * Telemetry Test Suite
+ *
+ * Validates the data behind the UDP telemetry stream:
+ * - Every change of the published signal word is journaled once, in order
+ * - A full journal counts lost changes instead of blocking the producer
+ * - Datagrams follow the documented little-endian layout, with and without
+ *   a signal history section
+ * - The signal word bit positions match what can_dashboard.py decodes
+ */
+
+namespace {
+void drainSignalChanges() {
+    VehicleSignalChange change;
+    while (popVehicleSignalChange(change)) {
+    }
+}
+
+uint32_t readU32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+BCMLampStatus makeLampStatus(uint8_t request) {
+    BCMLampStatus status = {};
+    status.pudLampRequest = request;
+    status.valid = true;
+    status.timestamp = millis();
+    return status;
+}
+}
+
+class TelemetryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ArduinoMock::instance().reset();
+        initializeStateManager();
+        drainSignalChanges();
+    }
+};
+
+TEST_F(TelemetryTest, JournalsEachSignalChange) {
+    ArduinoMock::instance().advanceTime(5);
+    updateBCMLampState(makeLampStatus(PUDLAMP_ON));
+    updateBCMLampState(makeLampStatus(PUDLAMP_ON));     // Same word, nothing journaled
+    updateBCMLampState(makeLampStatus(PUDLAMP_OFF));
+
+    VehicleSignalChange change;
+    ASSERT_TRUE(popVehicleSignalChange(change));
+    EXPECT_EQ(vehicleSignalsFromWord(change.signals).pudLampRequest, PUDLAMP_ON);
+    EXPECT_EQ(change.timeMs, 5u);
+    ASSERT_TRUE(popVehicleSignalChange(change));
+    EXPECT_EQ(vehicleSignalsFromWord(change.signals).pudLampRequest, PUDLAMP_OFF);
+    EXPECT_EQ(change.signals, vehicleSignalsWord(getVehicleSignals()));
+    EXPECT_FALSE(popVehicleSignalChange(change));
+}
+
+TEST_F(TelemetryTest, FullJournalCountsDrops) {
+    uint32_t dropsBefore = getVehicleSignalChangeDrops();
+    for (int i = 0; i < VEHICLE_SIGNAL_CHANGE_QUEUE_SIZE + 3; i++) {
+        updateBCMLampState(makeLampStatus(i % 2 ? PUDLAMP_OFF : PUDLAMP_ON));
+    }
+    EXPECT_EQ(getVehicleSignalChangeDrops() - dropsBefore, 3u);
+
+    VehicleSignalChange change;
+    int queued = 0;
+    while (popVehicleSignalChange(change)) {
+        queued++;
+    }
+    EXPECT_EQ(queued, VEHICLE_SIGNAL_CHANGE_QUEUE_SIZE);
+}
+
+TEST_F(TelemetryTest, DatagramLayout) {
+    TelemetrySnapshot snapshot = {};
+    snapshot.sequence = 0x01020304;
+    snapshot.uptimeMs = 123456;
+    snapshot.signals = 0xCAFEF00D;
+    snapshot.outputs = TELEMETRY_OUTPUT_BEDLIGHT | TELEMETRY_OUTPUT_SYSTEM_READY;
+    snapshot.staleMask = 1u << VEHICLE_MSG_BATTERY;
+    snapshot.recoveryState = 2;
+    snapshot.framesDispatched = 1000;
+    snapshot.parseErrors = 1;
+    snapshot.canErrors = 2;
+    snapshot.queueDrops = 3;
+    snapshot.controllerOverflows = 4;
+    snapshot.changeDrops = 5;
+    snapshot.queueHighWater = 0x0102;
+    const VehicleSignalChange changes[] = {{100, 0x11}, {200, 0x22}};
+
+    uint8_t datagram[TELEMETRY_DATAGRAM_MAX_BYTES];
+    size_t length = encodeTelemetryDatagram(snapshot, changes, 2, datagram, sizeof(datagram));
+    ASSERT_EQ(length, (size_t)TELEMETRY_HEADER_BYTES + 2 * TELEMETRY_CHANGE_BYTES);
+
+    EXPECT_EQ(datagram[0], 0x50);
+    EXPECT_EQ(datagram[1], 0xF1);
+    EXPECT_EQ(datagram[2], TELEMETRY_PROTOCOL_VERSION);
+    EXPECT_EQ(datagram[3], 2);
+    EXPECT_EQ(readU32(datagram + 4), 0x01020304u);
+    EXPECT_EQ(readU32(datagram + 8), 123456u);
+    EXPECT_EQ(readU32(datagram + 12), 0xCAFEF00Du);
+    EXPECT_EQ(datagram[16], 0x09);
+    EXPECT_EQ(datagram[17], 0x08);
+    EXPECT_EQ(datagram[18], 2);
+    EXPECT_EQ(readU32(datagram + 20), 1000u);
+    EXPECT_EQ(readU32(datagram + 24), 1u);
+    EXPECT_EQ(readU32(datagram + 28), 2u);
+    EXPECT_EQ(readU32(datagram + 32), 3u);
+    EXPECT_EQ(readU32(datagram + 36), 4u);
+    EXPECT_EQ(readU32(datagram + 40), 5u);
+    EXPECT_EQ(datagram[44], 0x02);
+    EXPECT_EQ(datagram[45], 0x01);
+    EXPECT_EQ(readU32(datagram + 48), 100u);
+    EXPECT_EQ(readU32(datagram + 52), 0x11u);
+    EXPECT_EQ(readU32(datagram + 56), 200u);
+    EXPECT_EQ(readU32(datagram + 60), 0x22u);
+
+    // Too many changes or too little room
+    EXPECT_EQ(encodeTelemetryDatagram(snapshot, changes, TELEMETRY_MAX_CHANGES + 1, datagram, sizeof(datagram)), 0u);
+    EXPECT_EQ(encodeTelemetryDatagram(snapshot, changes, 2, datagram, TELEMETRY_HEADER_BYTES), 0u);
+}
+
+TEST_F(TelemetryTest, DatagramHistorySection) {
+    TelemetrySnapshot snapshot = {};
+    const VehicleSignalChange changes[] = {{100, 0x11}};
+    SignalHistorySlot slots[2] = {{60000, 3, 70, 80, 75, true}, {120000, 0, 0, 0, 0, false}};
+    TelemetryHistory history = {SIGNAL_HISTORY_BATTERY_SOC, 2, 60000, slots};
+
+    uint8_t datagram[TELEMETRY_DATAGRAM_MAX_BYTES];
+    size_t length = encodeTelemetryDatagram(snapshot, changes, 1, datagram, sizeof(datagram), &history);
+    ASSERT_EQ(length, (size_t)TELEMETRY_HEADER_BYTES + TELEMETRY_CHANGE_BYTES + TELEMETRY_HISTORY_HEADER_BYTES +
+                          2 * TELEMETRY_HISTORY_SLOT_BYTES);
+    EXPECT_EQ(datagram[19], 2);
+    EXPECT_EQ(datagram[46], SIGNAL_HISTORY_BATTERY_SOC);
+
+    const uint8_t* section = datagram + TELEMETRY_HEADER_BYTES + TELEMETRY_CHANGE_BYTES;
+    EXPECT_EQ(readU32(section), 60000u);
+    EXPECT_EQ(readU32(section + 4), 60000u);
+    const uint8_t firstSlot[] = {3, 0, 70, 80, 75, TELEMETRY_HISTORY_FLAG_KNOWN};
+    EXPECT_EQ(memcmp(section + 8, firstSlot, sizeof(firstSlot)), 0);
+    EXPECT_EQ(section[8 + TELEMETRY_HISTORY_SLOT_BYTES + 5], 0);
+
+    // No slots leaves the section out
+    history.slotCount = 0;
+    EXPECT_EQ(encodeTelemetryDatagram(snapshot, changes, 1, datagram, sizeof(datagram), &history),
+              (size_t)TELEMETRY_HEADER_BYTES + TELEMETRY_CHANGE_BYTES);
+    EXPECT_EQ(datagram[19], 0);
+    history.slotCount = SIGNAL_HISTORY_TELEMETRY_SLOTS + 1;
+    EXPECT_EQ(encodeTelemetryDatagram(snapshot, changes, 1, datagram, sizeof(datagram), &history), 0u);
+}
+
+TEST_F(TelemetryTest, SignalWordBitPositions) {
+    VehicleSignals signals = vehicleSignalsFromWord(0);
+    signals.pudLampRequest = 3;
+    EXPECT_EQ(vehicleSignalsWord(signals), 0x3u << 0);
+
+    signals = vehicleSignalsFromWord(0);
+    signals.transmissionParkStatus = 0xF;
+    EXPECT_EQ(vehicleSignalsWord(signals), 0xFu << 2);
+
+    signals = vehicleSignalsFromWord(0);
+    signals.batterySOC = 0x7F;
+    EXPECT_EQ(vehicleSignalsWord(signals), 0x7Fu << 6);
+
+    signals = vehicleSignalsFromWord(0);
+    signals.vehicleLockStatus = 0xFF;
+    EXPECT_EQ(vehicleSignalsWord(signals), 0xFFu << 13);
+
+    signals = vehicleSignalsFromWord(0);
+    signals.systemReady = 1;
+    signals.bedlightManualState = 1;
+    EXPECT_EQ(vehicleSignalsWord(signals), (1u << 24) | (1u << 26));
+}
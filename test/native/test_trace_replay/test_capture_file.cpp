@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "common/test_config.h"
+
+// Import the binary capture reader (lib/trace_replay)
+#include "capture_file.h"
+
+/**
+ * Binary Capture File Test Suite
+ *
+ * Validates the fixed-record capture format and its memory-mapped reader:
+ * - Records round-trip (time, ID, DLC, payload) through writeCaptureFile()
+ * - Time seeks and per-ID lookups are binary searches over the mapped file
+ * - Files that are not captures, or are truncated, are rejected
+ * - Header offsets that would wrap are rejected; a corrupt index slot or DLC
+ *   is caught where it is read instead of reading past the mapping
+ * - replayTraceFile() replays a binary capture like a text one
+ */
+
+namespace {
+std::string capturePath(const char* name) {
+    return std::string("/tmp/") + name + ".f150cap";
+}
+
+TraceFrame makeFrame(uint64_t timestampUs, uint32_t id, uint8_t firstByte) {
+    TraceFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.timestampUs = timestampUs;
+    frame.id = id;
+    frame.length = 8;
+    frame.data[0] = firstByte;
+    return frame;
+}
+
+// 3 IDs interleaved at 1 ms: 0x176, 0x331, 0x3C3, 0x176, ...
+std::vector<TraceFrame> interleavedDrive(size_t count) {
+    const uint32_t ids[] = {0x176, 0x331, 0x3C3};
+    std::vector<TraceFrame> frames;
+    for (size_t i = 0; i < count; i++) {
+        frames.push_back(makeFrame(5000000000ULL + i * 1000, ids[i % 3], (uint8_t)i));
+    }
+    return frames;
+}
+}
+
+TEST(CaptureFileTest, RecordsRoundTrip) {
+    std::vector<TraceFrame> frames = interleavedDrive(30);
+    frames.push_back(makeFrame(5000100000ULL, 0x18FF0001, 0xEE));  // Extended ID: skipped
+    std::string path = capturePath("round_trip");
+    ASSERT_EQ(writeCaptureFile(path.c_str(), frames.data(), frames.size()), 30);
+
+    CaptureFile file;
+    ASSERT_TRUE(openCaptureFile(path.c_str(), file));
+    EXPECT_EQ(file.header->recordCount, 30u);
+    EXPECT_EQ(file.header->idCount, 3u);
+    EXPECT_EQ(file.size, sizeof(CaptureFileHeader) + 30 * sizeof(CaptureRecord) +
+                             3 * sizeof(CaptureIdEntry) + 30 * sizeof(uint32_t));
+
+    for (uint64_t i = 0; i < 30; i++) {
+        TraceFrame frame = getCaptureFrame(file, i);
+        EXPECT_EQ(frame.timestampUs, frames[i].timestampUs);
+        EXPECT_EQ(frame.id, frames[i].id);
+        EXPECT_EQ(frame.length, 8);
+        EXPECT_EQ(frame.data[0], frames[i].data[0]);
+    }
+    closeCaptureFile(file);
+    EXPECT_EQ(file.base, nullptr);
+    remove(path.c_str());
+}
+
+TEST(CaptureFileTest, SeeksByTimeAndId) {
+    std::vector<TraceFrame> frames = interleavedDrive(300);
+    std::string path = capturePath("seek");
+    ASSERT_EQ(writeCaptureFile(path.c_str(), frames.data(), frames.size()), 300);
+
+    CaptureFile file;
+    ASSERT_TRUE(openCaptureFile(path.c_str(), file));
+
+    // Time: first record at or after the requested time
+    EXPECT_EQ(findCaptureRecordAtTime(file, 0), 0u);
+    EXPECT_EQ(findCaptureRecordAtTime(file, 5000100000ULL), 100u);
+    EXPECT_EQ(findCaptureRecordAtTime(file, 5000100001ULL), 101u);
+    EXPECT_EQ(findCaptureRecordAtTime(file, 6000000000ULL), 300u);
+
+    // ID: directory lookup, then that ID's frames in time order
+    const CaptureIdEntry* lock = findCaptureId(file, 0x331);
+    ASSERT_NE(lock, nullptr);
+    EXPECT_EQ(lock->count, 100u);
+    for (uint32_t n = 0; n < lock->count; n++) {
+        EXPECT_EQ(getCaptureIdRecord(file, *lock, n), 1u + n * 3);
+    }
+    EXPECT_EQ(findCaptureIdRecordAtTime(file, *lock, 5000150000ULL), 50u);   // Record 151
+    EXPECT_EQ(findCaptureId(file, 0x43C), nullptr);
+
+    closeCaptureFile(file);
+    remove(path.c_str());
+}
+
+TEST(CaptureFileTest, RejectsOtherAndTruncatedFiles) {
+    CaptureFile file;
+    EXPECT_FALSE(openCaptureFile("/tmp/does_not_exist.f150cap", file));
+
+    std::string textPath = capturePath("text");
+    FILE* text = fopen(textPath.c_str(), "w");
+    ASSERT_NE(text, nullptr);
+    for (int i = 0; i < 4; i++) {
+        fprintf(text, "(1699999999.%06d) can0 3C3#0011223344556677\n", i);
+    }
+    fclose(text);
+    EXPECT_FALSE(openCaptureFile(textPath.c_str(), file));
+    remove(textPath.c_str());
+
+    std::vector<TraceFrame> frames = interleavedDrive(30);
+    std::string path = capturePath("truncated");
+    ASSERT_EQ(writeCaptureFile(path.c_str(), frames.data(), frames.size()), 30);
+    FILE* capture = fopen(path.c_str(), "r+b");
+    ASSERT_NE(capture, nullptr);
+    ASSERT_EQ(ftruncate(fileno(capture), 200), 0);
+    fclose(capture);
+    EXPECT_FALSE(openCaptureFile(path.c_str(), file));
+    remove(path.c_str());
+}
+
+namespace {
+// Overwrite bytes of a capture in place
+void patchCapture(const std::string& path, uint64_t offset, const void* bytes, size_t length) {
+    FILE* capture = fopen(path.c_str(), "r+b");
+    ASSERT_NE(capture, nullptr);
+    ASSERT_EQ(fseek(capture, (long)offset, SEEK_SET), 0);
+    ASSERT_EQ(fwrite(bytes, 1, length, capture), length);
+    fclose(capture);
+}
+}
+
+TEST(CaptureFileTest, RejectsWrappingSectionOffsets) {
+    std::vector<TraceFrame> frames = interleavedDrive(30);
+    std::string path = capturePath("wrapping");
+    ASSERT_EQ(writeCaptureFile(path.c_str(), frames.data(), frames.size()), 30);
+
+    // offset + count * size wraps to a small value that looks in range
+    uint64_t indexOffset = ~0ULL - 15;
+    patchCapture(path, offsetof(CaptureFileHeader, indexOffset), &indexOffset, sizeof(indexOffset));
+    CaptureFile file;
+    EXPECT_FALSE(openCaptureFile(path.c_str(), file));
+    remove(path.c_str());
+}
+
+TEST(CaptureFileTest, CorruptIndexAndLengthStayInsideTheMapping) {
+    std::vector<TraceFrame> frames = interleavedDrive(30);
+    std::string path = capturePath("corrupt");
+    ASSERT_EQ(writeCaptureFile(path.c_str(), frames.data(), frames.size()), 30);
+
+    CaptureFile file;
+    ASSERT_TRUE(openCaptureFile(path.c_str(), file));
+    uint64_t indexOffset = file.header->indexOffset;
+    closeCaptureFile(file);
+
+    uint32_t badRecord = 0x7FFFFFFF;
+    patchCapture(path, indexOffset, &badRecord, sizeof(badRecord));
+    uint8_t badLength = 15;
+    patchCapture(path, sizeof(CaptureFileHeader) + offsetof(CaptureRecord, length), &badLength, 1);
+    ASSERT_TRUE(openCaptureFile(path.c_str(), file));
+
+    // Slot 0 belongs to the first ID (0x176); the bad record number is reported as none
+    const CaptureIdEntry* entry = findCaptureId(file, 0x176);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(getCaptureIdRecord(file, *entry, 0), 30u);
+    EXPECT_EQ(getCaptureIdRecord(file, *entry, 1), 3u);
+    EXPECT_EQ(getCaptureIdRecord(file, *entry, entry->count), 30u);
+    EXPECT_EQ(getCaptureRecordTimestampUs(file, 30), UINT64_MAX);
+    EXPECT_EQ(getCaptureFrame(file, 30).length, 0);
+    EXPECT_LE(findCaptureIdRecordAtTime(file, *entry, frames[3].timestampUs), entry->count);
+
+    // DLC 15 reads as the 8 bytes a classic CAN frame carries
+    EXPECT_EQ(getCaptureFrame(file, 0).length, 8);
+    closeCaptureFile(file);
+    remove(path.c_str());
+}
+
+TEST(CaptureFileTest, ReplaysLikeATextCapture) {
+    // Unlock, then puddle lamps requested: the bed light ends up on
+    std::vector<TraceFrame> frames;
+    TraceFrame lock = makeFrame(1000000, LOCKING_SYSTEMS_2_FD1_ID, 0);
+    lock.data[4] = 0x04;                        // Veh_Lock_Status = UNLOCK_ALL
+    TraceFrame lamp = makeFrame(1500000, BCM_LAMP_STAT_FD1_ID, 0);
+    lamp.data[1] = 0x04;                        // PudLamp_D_Rq = ON
+    frames.push_back(lock);
+    frames.push_back(lamp);
+
+    std::string path = capturePath("replay");
+    ASSERT_EQ(writeCaptureFile(path.c_str(), frames.data(), frames.size()), 2);
+
+    beginTraceReplay(defaultTraceReplayOptions());
+    ASSERT_TRUE(replayTraceFile(path.c_str()));
+    TraceReplayReport report = finishTraceReplay();
+    EXPECT_EQ(report.framesReplayed, 2u);
+    EXPECT_EQ(report.linesRead, 0u);
+    EXPECT_EQ(report.simulatedMs, 500u);
+    EXPECT_TRUE(report.finalOutputs.bedlight);
+    remove(path.c_str());
+}
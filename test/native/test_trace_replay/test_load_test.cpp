@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include "common/test_config.h"
+
+// Import the generator (src/) and the host stress harness (lib/trace_replay)
+#include "load_test.h"
+
+/**
+ * Bus-Load Stress Test Suite
+ *
+ * Validates the synthetic traffic generator and the stress runs through the
+ * production dispatch -> parse -> state -> output pipeline:
+ * - Frame length and bus-load arithmetic at 500 kbit/s
+ * - The generator is deterministic, paced and injects each fault as described
+ * - At 100% bus load with bursts and every fault kind, nothing is dropped and
+ *   the state and bed light follow the delivered frames
+ * - A stalled consumer overflows the queue, and the state still follows the
+ *   frames that were delivered
+ * - The drop point sweep finds where a consumer stall overflows the queue
+ *
+ * Set CAN_LOAD_FPS (and optionally CAN_LOAD_STALL_US, CAN_LOAD_STALL_EVERY_MS)
+ * to print the report of one run and the drop point of that consumer.
+ */
+
+namespace {
+LoadTestOptions faultyFullLoad() {
+    LoadTestOptions options = defaultLoadTestOptions();
+    options.profile.durationMs = 5000;
+    options.profile.monitoredPeriodMs = 20;
+    options.profile.burstFrames = 40;
+    options.profile.burstIntervalMs = 300;
+    for (uint8_t fault = 0; fault < LOAD_FAULT_COUNT; fault++) {
+        options.profile.faultPerMille[fault] = 20;
+    }
+    return options;
+}
+}
+
+TEST(LoadGeneratorTest, FrameBitsAndBusRate) {
+    EXPECT_EQ(getCANFrameBits(8), 135u);
+    EXPECT_EQ(getCANFrameBits(0), 55u);
+    EXPECT_EQ(getCANBusLoadFrameRate(500000, 100), 3703u);
+    EXPECT_EQ(getCANBusLoadFrameRate(500000, 50), 1851u);
+}
+
+TEST(LoadGeneratorTest, DeterministicAndPaced) {
+    LoadProfile profile = defaultLoadProfile();
+    profile.framesPerSecond = 1000;
+    profile.durationMs = 2000;
+
+    LoadGenerator first, second;
+    beginLoadGenerator(first, profile);
+    beginLoadGenerator(second, profile);
+
+    CANFrame a, b;
+    LoadFrameInfo infoA, infoB;
+    uint64_t timeA, timeB, lastTime = 0;
+    uint32_t lampFrames = 0;
+    while (nextLoadFrame(first, a, timeA, infoA)) {
+        ASSERT_TRUE(nextLoadFrame(second, b, timeB, infoB));
+        EXPECT_EQ(timeA, timeB);
+        EXPECT_EQ(a.id, b.id);
+        EXPECT_EQ(memcmp(a.data, b.data, sizeof(a.data)), 0);
+        EXPECT_GE(timeA, lastTime);
+        EXPECT_EQ(infoA.fault, LOAD_FAULT_NONE);
+        EXPECT_EQ(a.length, 8);
+        lastTime = timeA;
+        if (a.id == BCM_LAMP_STAT_FD1_ID) {
+            lampFrames++;
+        }
+    }
+
+    EXPECT_EQ(first.stats.frames, 2000u);
+    EXPECT_EQ(first.stats.monitoredFrames, 4u * 20u);      // Four messages every 100 ms
+    EXPECT_EQ(lampFrames, 20u);
+    EXPECT_EQ(first.stats.backgroundFrames, 2000u - 80u);
+}
+
+TEST(LoadGeneratorTest, FaultsAreInjectedAsDescribed) {
+    LoadProfile profile = defaultLoadProfile();
+    profile.durationMs = 5000;
+    profile.monitoredPeriodMs = 5;
+    for (uint8_t fault = 0; fault < LOAD_FAULT_COUNT; fault++) {
+        profile.faultPerMille[fault] = 50;
+    }
+
+    LoadGenerator generator;
+    beginLoadGenerator(generator, profile);
+    CANFrame frame;
+    LoadFrameInfo info;
+    uint64_t timeUs, lastTime = 0;
+    uint32_t seen[LOAD_FAULT_COUNT] = {0};
+    while (nextLoadFrame(generator, frame, timeUs, info)) {
+        EXPECT_GE(timeUs, lastTime);
+        lastTime = timeUs;
+        if (info.fault == LOAD_FAULT_NONE) {
+            continue;
+        }
+        ASSERT_LT(info.fault, LOAD_FAULT_COUNT);
+        seen[info.fault]++;
+
+        switch (info.fault) {
+            case LOAD_FAULT_DLC_MISMATCH:
+                EXPECT_NE(info.signal, LOAD_SIGNAL_BACKGROUND);
+                EXPECT_LT(frame.length, 8);
+                break;
+            case LOAD_FAULT_MALFORMED:
+                // The carried signal itself is intact
+                EXPECT_EQ(frame.length, 8);
+                if (info.signal == LOAD_SIGNAL_LOCK) {
+                    EXPECT_EQ((frame.data[4] >> 1) & 0x03, info.value);
+                }
+                break;
+            case LOAD_FAULT_INVALID_VALUE:
+                if (info.signal == LOAD_SIGNAL_PARK) {
+                    EXPECT_GT(info.value, TRNPRKSTS_OUT_OF_PARK);
+                    EXPECT_EQ(frame.data[3] >> 4, info.value);
+                } else {
+                    EXPECT_EQ(info.signal, LOAD_SIGNAL_BATTERY_SOC);
+                    EXPECT_GT(info.value, 100);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    for (uint8_t fault = 0; fault < LOAD_FAULT_COUNT; fault++) {
+        EXPECT_GT(seen[fault], 0u) << getLoadFaultName(fault);
+        EXPECT_EQ(seen[fault], generator.stats.faults[fault]) << getLoadFaultName(fault);
+    }
+}
+
+TEST(LoadTest, FullBusLoadWithFaultsStaysCorrect) {
+    LoadTestReport report = runLoadTest(faultyFullLoad());
+
+    EXPECT_NEAR(report.offeredFramesPerSecond, 3703 + 40 * 1000.0 / 300, 150);
+    EXPECT_GT(report.generated.burstFrames, 0u);
+    EXPECT_EQ(report.queueDrops, 0u);
+    EXPECT_EQ(report.framesDelivered, report.generated.frames);
+    EXPECT_GT(report.dlcFaultsDelivered, 0u);
+    EXPECT_EQ(report.dispatch.parseErrors, report.dlcFaultsDelivered);
+    EXPECT_EQ(report.checks, report.framesDelivered);
+    EXPECT_EQ(report.signalMismatches, 0u);
+    EXPECT_EQ(report.outputMismatches, 0u);
+    EXPECT_GT(report.framesPerSecond, 0);
+}
+
+TEST(LoadTest, StalledConsumerDropsAndFollowsDeliveredFrames) {
+    LoadTestOptions options = faultyFullLoad();
+    options.consumerStallUs = 40000;
+    options.consumerStallIntervalMs = 500;
+    LoadTestReport report = runLoadTest(options);
+
+    EXPECT_GT(report.queueDrops, 0u);
+    EXPECT_EQ(report.queueHighWater, CAN_RX_QUEUE_SIZE);
+    EXPECT_EQ(report.framesDelivered + report.queueDrops, report.generated.frames);
+    EXPECT_EQ(report.dispatch.parseErrors, report.dlcFaultsDelivered);
+    EXPECT_EQ(report.signalMismatches, 0u);
+    EXPECT_EQ(report.outputMismatches, 0u);
+}
+
+TEST(LoadTest, DropPointOfAStalledConsumer) {
+    LoadTestOptions options = defaultLoadTestOptions();
+    options.profile.durationMs = 2000;
+    options.consumerStallUs = 20000;
+    options.consumerStallIntervalMs = 500;
+
+    // 64 queue slots cover 20 ms of stall up to 3200 frames/s
+    uint32_t dropPoint = findLoadTestDropPoint(options, 200, 4000);
+    EXPECT_GE(dropPoint, 3000u);
+    EXPECT_LE(dropPoint, 3400u);
+
+    // Without the stall the queue never fills at CAN rates
+    options.consumerStallUs = 0;
+    EXPECT_EQ(findLoadTestDropPoint(options, 1000, 4000), 0u);
+}
+
+TEST(LoadTest, RunFromEnvironment) {
+    const char* rate = getenv("CAN_LOAD_FPS");
+    if (!rate) {
+        GTEST_SKIP() << "Set CAN_LOAD_FPS to print a stress report";
+    }
+
+    LoadTestOptions options = faultyFullLoad();
+    options.profile.framesPerSecond = (uint32_t)strtoul(rate, nullptr, 10);
+    const char* stall = getenv("CAN_LOAD_STALL_US");
+    const char* every = getenv("CAN_LOAD_STALL_EVERY_MS");
+    options.consumerStallUs = stall ? (uint32_t)strtoul(stall, nullptr, 10) : 0;
+    options.consumerStallIntervalMs = every ? (uint32_t)strtoul(every, nullptr, 10) : 1000;
+
+    LoadTestReport report = runLoadTest(options);
+    printLoadTestReport(report, stdout);
+    printf("  Drop point: %lu frames/s\n",
+           (unsigned long)findLoadTestDropPoint(options, 100, 2 * getCANBusLoadFrameRate(500000, 100)));
+    EXPECT_EQ(report.signalMismatches, 0u);
+    EXPECT_EQ(report.outputMismatches, 0u);
+}
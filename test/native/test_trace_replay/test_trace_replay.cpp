@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+#include "common/test_config.h"
+#include "common/can_test_utils.h"
+
+// Import the host-side replay engine (lib/trace_replay)
+#include "trace_replay.h"
+
+/**
+ * Trace Replay Test Suite
+ *
+ * Validates the host-side replay of captured drives through the production
+ * dispatch -> parse -> state -> output pipeline:
+ * - candump and can_embedded_logger.py lines parse to frames; other lines are skipped
+ * - A short drive ends with the output decisions the firmware would make
+ * - Freshness deadlines between frames are applied on the mock clock
+ *
+ * Set CAN_TRACE_FILE to replay a real capture (CAN_TRACE_SPEED=1 for capture
+ * timing, default as fast as possible); the report is printed to stdout.
+ */
+
+namespace {
+std::string candumpLine(double seconds, uint32_t id, const uint8_t data[8]) {
+    char line[96];
+    snprintf(line, sizeof(line), "(%.6f) can0 %03X#%02X%02X%02X%02X%02X%02X%02X%02X", seconds, id,
+             data[0], data[1], data[2], data[3], data[4], data[5], data[6], data[7]);
+    return line;
+}
+
+std::string signalFrame(double seconds, uint32_t id, uint8_t startBit, uint8_t length, uint32_t value) {
+    uint8_t data[8];
+    CANTestUtils::setSignalValue(data, startBit, length, value);
+    return candumpLine(seconds, id, data);
+}
+
+// DBC positions (minimal.dbc)
+std::string lampFrame(double seconds, uint8_t pudLamp) { return signalFrame(seconds, BCM_LAMP_STAT_FD1_ID, 11, 2, pudLamp); }
+std::string lockFrame(double seconds, uint8_t lock) { return signalFrame(seconds, LOCKING_SYSTEMS_2_FD1_ID, 34, 2, lock); }
+std::string parkFrame(double seconds, uint8_t park) { return signalFrame(seconds, POWERTRAIN_DATA_10_ID, 31, 4, park); }
+}
+
+TEST(TraceReplayParseTest, CandumpLogLine) {
+    TraceFrame frame;
+    ASSERT_TRUE(parseTraceLine("(1699999999.123456) can0 3C3#0011223344556677\n", frame));
+    EXPECT_EQ(frame.id, 0x3C3u);
+    EXPECT_EQ(frame.length, 8);
+    EXPECT_EQ(frame.data[0], 0x00);
+    EXPECT_EQ(frame.data[7], 0x77);
+    EXPECT_EQ(frame.timestampUs, 1699999999123456ULL);
+
+    // Short frames are zero-padded; remote frames and oversize payloads are rejected
+    ASSERT_TRUE(parseCandumpLine("(10.5) vcan0 176#AABB", frame));
+    EXPECT_EQ(frame.length, 2);
+    EXPECT_EQ(frame.data[2], 0x00);
+    EXPECT_EQ(frame.timestampUs, 10500000ULL);
+    EXPECT_FALSE(parseCandumpLine("(10.5) can0 3C3#R", frame));
+    EXPECT_FALSE(parseCandumpLine("(10.5) can0 3C3#001122334455667788", frame));
+}
+
+TEST(TraceReplayParseTest, EmbeddedLoggerLine) {
+    TraceFrame frame;
+    ASSERT_TRUE(parseTraceLine("2025-01-01 12:00:01.250 | CAN_ID:0x331 | data:00 00 00 00 04 00 00 00 | "
+                               "Locking_Systems_2_FD1 | Veh_Lock_Status=UNLOCK_ALL\n", frame));
+    EXPECT_EQ(frame.id, 0x331u);
+    EXPECT_EQ(frame.length, 8);
+    EXPECT_EQ(frame.data[4], 0x04);
+
+    TraceFrame earlier;
+    ASSERT_TRUE(parseTraceLine("2025-01-01 12:00:00.000 | CAN_ID:0x331 | data:00 00 00 00 00 00 00 00", earlier));
+    EXPECT_EQ(frame.timestampUs - earlier.timestampUs, 1250000ULL);
+
+    // Headers, comments and decoded-only logs carry no frame
+    EXPECT_FALSE(parseTraceLine("# Embedded CAN Signal Logger Output - Per-Message Mode", frame));
+    EXPECT_FALSE(parseTraceLine("2025-01-01 12:00:00.000 | BCM_Lamp_Stat_FD1.PudLamp_D_Rq=ON", frame));
+    EXPECT_FALSE(parseTraceLine("", frame));
+}
+
+TEST(TraceReplayTest, DriveEndsWithFirmwareOutputDecisions) {
+    beginTraceReplay(defaultTraceReplayOptions());
+
+    // Unlocked and parked, puddle lamps come on at t=2 s and ramp down at t=30 s
+    EXPECT_FALSE(replayTraceLine("# candump header\n"));
+    replayTraceLine(lockFrame(100.0, VEH_UNLOCK_ALL).c_str());
+    replayTraceLine(parkFrame(100.5, TRNPRKSTS_PARK).c_str());
+    replayTraceLine(lampFrame(102.0, PUDLAMP_ON).c_str());
+    for (int i = 1; i <= 20; i++) {
+        replayTraceLine(lampFrame(102.0 + i * 0.1, PUDLAMP_ON).c_str());   // 10 Hz repeats
+    }
+    EXPECT_TRUE(getGPIOState().bedlight);
+
+    replayTraceLine(lampFrame(130.0, PUDLAMP_RAMP_DOWN).c_str());
+    TraceReplayReport report = finishTraceReplay();
+
+    EXPECT_EQ(report.framesReplayed, 24u);
+    EXPECT_EQ(report.linesSkipped, 1u);
+    EXPECT_EQ(report.simulatedMs, 30000u);
+    EXPECT_EQ(report.dispatch.framesDispatched, 24u);
+    EXPECT_GT(report.dispatch.unchangedFrames, 0u);
+    EXPECT_EQ(report.bedlightChanges, 2u);
+    EXPECT_FALSE(report.finalOutputs.bedlight);
+    EXPECT_TRUE(report.finalOutputs.systemReady);
+    EXPECT_FALSE(report.finalOutputs.toolboxOpener);
+    EXPECT_EQ(report.finalSignals.vehicleLockStatus, VEH_UNLOCK_ALL);
+    EXPECT_TRUE(report.finalSignals.isParked);
+}
+
+TEST(TraceReplayTest, ReadyFromTheFirstPass) {
+    beginTraceReplay(defaultTraceReplayOptions());
+    EXPECT_TRUE(getGPIOState().systemReady);
+    EXPECT_TRUE(isSystemReady());
+}
+
+TEST(TraceReplayTest, DeadlinesBetweenFramesAreApplied) {
+    beginTraceReplay(defaultTraceReplayOptions());
+    replayTraceLine(lockFrame(0.0, VEH_UNLOCK_ALL).c_str());
+    replayTraceLine(lampFrame(0.1, PUDLAMP_ON).c_str());
+    EXPECT_TRUE(getGPIOState().bedlight);
+
+    // Bus silent past the readiness timeout: outputs drop at the deadline
+    advanceTraceReplay(SYSTEM_READINESS_TIMEOUT_MS + 1000);
+    EXPECT_FALSE(getGPIOState().bedlight);
+    EXPECT_FALSE(getGPIOState().systemReady);
+    EXPECT_EQ(getStaleSourceMask(), (1u << VEHICLE_MSG_COUNT) - 1);
+
+    // The next frame restores readiness and the still-requested bed light
+    double resume = (SYSTEM_READINESS_TIMEOUT_MS + 2000) / 1000.0;
+    replayTraceLine(lampFrame(resume, PUDLAMP_ON).c_str());
+    TraceReplayReport report = finishTraceReplay();
+    EXPECT_TRUE(report.finalOutputs.systemReady);
+    EXPECT_TRUE(report.finalOutputs.bedlight);
+    EXPECT_EQ(report.systemReadyChanges, 3u);   // Boot, timeout, recovery
+    EXPECT_EQ(report.staleSourceMask, (1u << VEHICLE_MSG_COUNT) - 1 - (1u << VEHICLE_MSG_BCM_LAMP));
+}
+
+TEST(TraceReplayTest, CaptureFromEnvironment) {
+    const char* path = getenv("CAN_TRACE_FILE");
+    if (!path) {
+        GTEST_SKIP() << "Set CAN_TRACE_FILE to replay a capture";
+    }
+
+    TraceReplayOptions options = defaultTraceReplayOptions();
+    const char* speed = getenv("CAN_TRACE_SPEED");
+    if (speed) {
+        options.speed = atof(speed);
+    }
+
+    beginTraceReplay(options);
+    ASSERT_TRUE(replayTraceFile(path)) << "Cannot open " << path;
+    printTraceReplayReport(finishTraceReplay(), stdout);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production boot state and the state manager it seeds
+#include "../src/boot_state.h"
+#include "../src/state_manager.h"
+
+/**
+ * Boot State Test Suite
+ *
+ * Validates the last-known state kept across resets:
+ * - A record retained before a reset is found and restored on the next boot
+ * - A corrupted or foreign record (power-on, brownout) boots cold
+ * - Health counters are reported from before the reset but restart at zero
+ * - Restored signals reach the state manager and its published snapshot
+ * - Boot milestones keep only their first stamp
+ */
+
+namespace {
+
+VehicleSignals makeParkedUnlocked() {
+    VehicleSignals signals;
+    memset(&signals, 0, sizeof(signals));
+    signals.vehicleLockStatus = VEH_UNLOCK_ALL;
+    signals.transmissionParkStatus = TRNPRKSTS_PARK;
+    signals.batterySOC = 80;
+    signals.isUnlocked = 1;
+    signals.isParked = 1;
+    signals.systemReady = 1;
+    return signals;
+}
+
+SystemHealth makeHealth(unsigned long canErrors, unsigned long parseErrors, unsigned long criticalErrors) {
+    return {canErrors, parseErrors, criticalErrors, 0, 0, false, false};
+}
+
+}  // namespace
+
+class BootStateTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Start every test from a cold boot
+        memset(getRetainedBootRecord(), 0xA5, sizeof(BootRecord));
+        beginBootState(1);
+    }
+};
+
+TEST_F(BootStateTest, ColdBootHasNothingToRestore) {
+    VehicleSignals signals;
+    EXPECT_FALSE(getRestoredVehicleSignals(signals));
+    EXPECT_EQ(getPreviousBootRecord().magic, 0u);
+    EXPECT_EQ(getRetainedBootRecord()->bootCount, 1u);
+    EXPECT_TRUE(isBootRecordValid(*getRetainedBootRecord()));
+}
+
+TEST_F(BootStateTest, RetainedStateSurvivesReset) {
+    VehicleSignals before = makeParkedUnlocked();
+    retainBootState(before, makeHealth(3, 2, 1), 45000);
+
+    EXPECT_TRUE(beginBootState(3));   // Software reset
+    VehicleSignals restored;
+    ASSERT_TRUE(getRestoredVehicleSignals(restored));
+    EXPECT_EQ(vehicleSignalsWord(restored), vehicleSignalsWord(before));
+
+    BootRecord previous = getPreviousBootRecord();
+    EXPECT_EQ(previous.canErrors, 3u);
+    EXPECT_EQ(previous.parseErrors, 2u);
+    EXPECT_EQ(previous.criticalErrors, 1u);
+    EXPECT_EQ(previous.uptimeMs, 45000u);
+
+    // The new record starts with zero counters but keeps the signals until replaced
+    EXPECT_EQ(getRetainedBootRecord()->bootCount, 2u);
+    EXPECT_EQ(getRetainedBootRecord()->criticalErrors, 0u);
+    EXPECT_TRUE(beginBootState(3));
+    ASSERT_TRUE(getRestoredVehicleSignals(restored));
+    EXPECT_EQ(vehicleSignalsWord(restored), vehicleSignalsWord(before));
+    EXPECT_EQ(getRetainedBootRecord()->bootCount, 3u);
+}
+
+TEST_F(BootStateTest, CorruptedRecordBootsCold) {
+    retainBootState(makeParkedUnlocked(), makeHealth(0, 0, 0), 1000);
+    getRetainedBootRecord()->signalsWord ^= 1;   // One flipped bit
+    EXPECT_FALSE(beginBootState(9));
+    VehicleSignals signals;
+    EXPECT_FALSE(getRestoredVehicleSignals(signals));
+
+    retainBootState(makeParkedUnlocked(), makeHealth(0, 0, 0), 1000);
+    BootRecord* record = getRetainedBootRecord();
+    record->version = BOOT_RECORD_VERSION + 1;
+    record->checksum = computeBootRecordChecksum(*record);   // Consistent, but another layout
+    EXPECT_FALSE(beginBootState(3));
+}
+
+TEST_F(BootStateTest, UnchangedStateIsNotRewritten) {
+    retainBootState(makeParkedUnlocked(), makeHealth(1, 0, 0), 1000);
+    retainBootState(makeParkedUnlocked(), makeHealth(1, 0, 0), 2000);
+    EXPECT_EQ(getRetainedBootRecord()->uptimeMs, 1000u);
+    retainBootState(makeParkedUnlocked(), makeHealth(2, 0, 0), 3000);
+    EXPECT_EQ(getRetainedBootRecord()->uptimeMs, 3000u);
+}
+
+TEST_F(BootStateTest, RestoredSignalsArePublished) {
+    initializeStateManager();
+    EXPECT_FALSE(getVehicleSignals().isUnlocked);
+    takeOutputInputChanges();
+
+    VehicleSignals restored = makeParkedUnlocked();
+    restoreVehicleSignals(restored);
+    VehicleSignals published = getVehicleSignals();
+    EXPECT_TRUE(published.isUnlocked);
+    EXPECT_TRUE(published.isParked);
+    EXPECT_EQ(published.vehicleLockStatus, (uint32_t)VEH_UNLOCK_ALL);
+    EXPECT_EQ(takeOutputInputChanges(), OUTPUT_INPUT_ALL);
+
+    // Readiness comes from freshness, and sources count as seen at boot
+    checkForStateChanges();
+    EXPECT_TRUE(isSystemReady());
+    EXPECT_TRUE(shouldActivateToolbox());
+}
+
+TEST_F(BootStateTest, MilestonesKeepFirstStamp) {
+    EXPECT_EQ(getBootMilestoneUs(BOOT_MILESTONE_FIRST_FRAME), 0u);
+    noteBootMilestone(BOOT_MILESTONE_FIRST_FRAME, 182000);
+    noteBootMilestone(BOOT_MILESTONE_FIRST_FRAME, 190000);
+    EXPECT_EQ(getBootMilestoneUs(BOOT_MILESTONE_FIRST_FRAME), 182000u);
+    noteBootMilestone(BOOT_MILESTONE_COUNT, 1);   // Ignored
+    EXPECT_EQ(getBootMilestoneUs(BOOT_MILESTONE_COUNT), 0u);
+    EXPECT_STREQ(getResetReasonName(9), "brownout");
+    EXPECT_STREQ(getResetReasonName(200), "unknown");
+
+    beginBootState(3);
+    EXPECT_EQ(getBootMilestoneUs(BOOT_MILESTONE_FIRST_FRAME), 0u);
+}
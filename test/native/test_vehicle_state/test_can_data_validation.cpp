@@ -317,20 +317,14 @@ TEST_F(CANDataValidationTest, MessageParsingIntegration) {
     // Test that our message parsing functions would work correctly with real CAN data
     // This simulates what happens in the main application loop
     
-    // Create a realistic CAN message structure
-    struct CANMessage {
-        uint32_t id;
-        uint8_t length;
-        uint8_t data[8];
-        unsigned long timestamp;
-    };
-    
     // Test BCM Lamp Status parsing
     CANMessage bcmMessage = {
         .id = BCM_LAMP_STAT_FD1_ID,
         .length = 8,
         .data = {0x40, 0xC4, 0x00, 0x00, 0x00, 0x00, 0x81, 0x00}, // PudLamp=ON
-        .timestamp = 1000
+        .timestamp = 1000,
+        .source = CAN_SOURCE_MCP2515,
+        .arrivalUs = 1000000
     };
     
     // Verify message structure
@@ -346,7 +340,9 @@ TEST_F(CANDataValidationTest, MessageParsingIntegration) {
         .id = LOCKING_SYSTEMS_2_FD1_ID,
         .length = 8,
         .data = {0x00, 0x0F, 0x00, 0x00, 0x05, 0xC2, 0x44, 0x10}, // Veh_Lock_Status=UNLOCK_ALL
-        .timestamp = 1000
+        .timestamp = 1000,
+        .source = CAN_SOURCE_MCP2515,
+        .arrivalUs = 1000000
     };
     
     // Verify message structure
@@ -362,7 +358,9 @@ TEST_F(CANDataValidationTest, MessageParsingIntegration) {
         .id = POWERTRAIN_DATA_10_ID,
         .length = 8,
         .data = {0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00}, // TrnPrkSys_D_Actl=Park
-        .timestamp = 1000
+        .timestamp = 1000,
+        .source = CAN_SOURCE_MCP2515,
+        .arrivalUs = 1000000
     };
     
     // Verify message structure
@@ -378,7 +376,9 @@ TEST_F(CANDataValidationTest, MessageParsingIntegration) {
         .id = BATTERY_MGMT_3_FD1_ID,
         .length = 8,
         .data = {0x32, 0x00, 0x41, 0x57, 0x40, 0xD9, 0x88, 0xC8}, // BSBattSOC=65
-        .timestamp = 1000
+        .timestamp = 1000,
+        .source = CAN_SOURCE_MCP2515,
+        .arrivalUs = 1000000
     };
     
     // Verify message structure
@@ -3,7 +3,7 @@
 #include "common/test_config.h"
 
 // Import production code structures and functions
-// isTargetCANMessage is provided by mock_arduino.cpp to avoid Arduino dependencies
+// isTargetCANMessage is the production dispatch table lookup (can_dispatch.cpp)
 extern "C" {
     bool isTargetCANMessage(uint32_t messageId);
 }
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "common/test_config.h"
+
+// Import production freshness tracker
+#include "../src/freshness_tracker.h"
+
+/**
+ * Freshness Tracker Test Suite
+ *
+ * Validates the deadline-based source freshness used for system readiness:
+ * - Sources go stale / time out exactly when their deadline passes
+ * - New data clears staleness immediately and reports the change once
+ * - No rescan happens before the earliest deadline
+ * - Deadlines survive millis() rollover
+ * - A boot pass flagged as changed applies the initial (ready) masks
+ */
+
+namespace {
+const unsigned long STALE_MS = 5000;
+const unsigned long READY_MS = 600000;
+const uint8_t SOURCES = 4;
+}
+
+class FreshnessTrackerTest : public ::testing::Test {
+protected:
+    FreshnessTracker tracker;
+
+    void SetUp() override {
+        initFreshnessTracker(tracker, SOURCES, STALE_MS, READY_MS, 0);
+    }
+};
+
+TEST_F(FreshnessTrackerTest, StartsFreshAndReady) {
+    EXPECT_EQ(tracker.staleMask, 0u);
+    EXPECT_EQ(tracker.readyMask, 0x0Fu);
+    EXPECT_FALSE(updateFreshness(tracker, 0));
+    EXPECT_EQ(getFreshnessIdleTime(tracker, 1000, 50), 50u);
+    EXPECT_EQ(getFreshnessIdleTime(tracker, 4990, 50), 10u);
+}
+
+TEST_F(FreshnessTrackerTest, SourceGoesStaleAtDeadline) {
+    noteFreshnessUpdate(tracker, 1, 3000);
+    EXPECT_FALSE(updateFreshness(tracker, 4999));
+    EXPECT_EQ(tracker.rescans, 0u);
+
+    EXPECT_TRUE(updateFreshness(tracker, 5000));
+    EXPECT_EQ(tracker.staleMask, 0x0Du);   // Source 1 was refreshed at 3000
+    EXPECT_EQ(tracker.readyMask, 0x0Fu);
+
+    EXPECT_FALSE(updateFreshness(tracker, 7999));
+    EXPECT_TRUE(updateFreshness(tracker, 8000));
+    EXPECT_EQ(tracker.staleMask, 0x0Fu);
+}
+
+TEST_F(FreshnessTrackerTest, UpdateClearsStalenessOnce) {
+    updateFreshness(tracker, 6000);
+    ASSERT_EQ(tracker.staleMask, 0x0Fu);
+
+    noteFreshnessUpdate(tracker, 2, 6100);
+    EXPECT_EQ(tracker.staleMask, 0x0Bu);
+    EXPECT_TRUE(updateFreshness(tracker, 6100));
+    EXPECT_FALSE(updateFreshness(tracker, 6200));
+
+    // Repeated fresh updates are not changes
+    noteFreshnessUpdate(tracker, 2, 6300);
+    EXPECT_FALSE(updateFreshness(tracker, 6300));
+}
+
+TEST_F(FreshnessTrackerTest, ReadinessTimesOutPerSource) {
+    noteFreshnessUpdate(tracker, 3, 300000);
+    EXPECT_TRUE(updateFreshness(tracker, READY_MS));
+    EXPECT_EQ(tracker.readyMask, 0x08u);
+
+    EXPECT_FALSE(updateFreshness(tracker, 300000 + READY_MS - 1));
+    EXPECT_TRUE(updateFreshness(tracker, 300000 + READY_MS));
+    EXPECT_EQ(tracker.readyMask, 0u);
+
+    // Nothing left to expire
+    EXPECT_FALSE(tracker.deadlinePending);
+    EXPECT_EQ(getFreshnessIdleTime(tracker, 2000000, 50), 50u);
+
+    noteFreshnessUpdate(tracker, 0, 2000000);
+    EXPECT_TRUE(updateFreshness(tracker, 2000000));
+    EXPECT_EQ(tracker.readyMask, 0x01u);
+    EXPECT_EQ(getFreshnessIdleTime(tracker, 2000000, 100000), STALE_MS);
+}
+
+TEST_F(FreshnessTrackerTest, SteadyTrafficAvoidsRescans) {
+    // Frames every 20 ms on all sources for a minute
+    for (unsigned long now = 20; now <= 60000; now += 20) {
+        for (uint8_t source = 0; source < SOURCES; source++) {
+            noteFreshnessUpdate(tracker, source, now);
+        }
+        EXPECT_FALSE(updateFreshness(tracker, now));
+    }
+    EXPECT_EQ(tracker.staleMask, 0u);
+    // One rescan per stale window at most, instead of a scan per pass
+    EXPECT_LE(tracker.rescans, 60000 / STALE_MS);
+}
+
+TEST_F(FreshnessTrackerTest, HandlesMillisRollover) {
+    unsigned long nearWrap = 0xFFFFFFFFUL - 1000;
+    initFreshnessTracker(tracker, SOURCES, STALE_MS, READY_MS, nearWrap);
+
+    EXPECT_FALSE(updateFreshness(tracker, nearWrap + 4999));
+    EXPECT_TRUE(updateFreshness(tracker, nearWrap + STALE_MS));
+    EXPECT_EQ(tracker.staleMask, 0x0Fu);
+    EXPECT_EQ(tracker.readyMask, 0x0Fu);
+}
+
+TEST_F(FreshnessTrackerTest, IgnoresUnknownSource) {
+    noteFreshnessUpdate(tracker, SOURCES, 100);
+    EXPECT_FALSE(updateFreshness(tracker, 100));
+    EXPECT_EQ(tracker.lastUpdate[SOURCES], 0u);
+}
+
+TEST_F(FreshnessTrackerTest, FlaggedBootPassAppliesInitialMasks) {
+    // initializeStateManager() flags the first pass, because systemReady
+    // starts false while every source is within its readiness window
+    tracker.changed = true;
+    EXPECT_TRUE(updateFreshness(tracker, 10));
+    EXPECT_EQ(tracker.readyMask, 0x0Fu);
+    EXPECT_EQ(tracker.staleMask, 0u);
+    EXPECT_EQ(tracker.rescans, 0u);
+    EXPECT_FALSE(updateFreshness(tracker, 20));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production state layout
+#include "../src/state_manager.h"
+
+/**
+ * Packed State Layout Test Suite
+ *
+ * Validates the compact VehicleSignals word and the ButtonState layout:
+ * - Every signal holds its full DBC range (and VEH_LOCK_UNKNOWN)
+ * - Any single field change is visible as a change of the whole word
+ * - Word round-trips preserve every field
+ */
+
+class PackedStateTest : public ::testing::Test {
+protected:
+    VehicleSignals signals;
+
+    void SetUp() override {
+        memset(&signals, 0, sizeof(signals));
+    }
+};
+
+TEST_F(PackedStateTest, LayoutIsCompact) {
+    EXPECT_EQ(sizeof(VehicleSignals), 4u);
+    EXPECT_EQ(sizeof(VehicleState), 8u + VEHICLE_MSG_COUNT * sizeof(unsigned long));
+    EXPECT_LE(sizeof(ButtonState), 6 * sizeof(unsigned long) + sizeof(unsigned long));
+}
+
+TEST_F(PackedStateTest, FieldsHoldFullSignalRange) {
+    signals.pudLampRequest = PUDLAMP_RAMP_DOWN;
+    signals.transmissionParkStatus = 15;
+    signals.batterySOC = 127;
+    signals.vehicleLockStatus = VEH_LOCK_UNKNOWN;
+
+    EXPECT_EQ(signals.pudLampRequest, (uint32_t)PUDLAMP_RAMP_DOWN);
+    EXPECT_EQ(signals.transmissionParkStatus, 15u);
+    EXPECT_EQ(signals.batterySOC, 127u);
+    EXPECT_EQ(signals.vehicleLockStatus, (uint32_t)VEH_LOCK_UNKNOWN);
+    EXPECT_FALSE(signals.isUnlocked);
+    EXPECT_FALSE(signals.systemReady);
+}
+
+TEST_F(PackedStateTest, SingleFieldChangeChangesWord) {
+    uint32_t baseline = vehicleSignalsWord(signals);
+    VehicleSignals changed;
+
+    changed = signals;
+    changed.pudLampRequest = PUDLAMP_ON;
+    EXPECT_NE(vehicleSignalsWord(changed), baseline);
+
+    changed = signals;
+    changed.batterySOC = 1;
+    EXPECT_NE(vehicleSignalsWord(changed), baseline);
+
+    changed = signals;
+    changed.bedlightManualState = true;
+    EXPECT_NE(vehicleSignalsWord(changed), baseline);
+
+    changed = signals;
+    EXPECT_EQ(vehicleSignalsWord(changed), baseline);
+}
+
+TEST_F(PackedStateTest, WordRoundTripPreservesFields) {
+    signals.pudLampRequest = PUDLAMP_RAMP_UP;
+    signals.transmissionParkStatus = TRNPRKSTS_OUT_OF_PARK;
+    signals.batterySOC = 83;
+    signals.vehicleLockStatus = VEH_UNLOCK_DRV;
+    signals.isUnlocked = true;
+    signals.isParked = false;
+    signals.bedlightShouldBeOn = true;
+    signals.systemReady = true;
+    signals.bedlightManualOverride = true;
+
+    VehicleSignals copy = vehicleSignalsFromWord(vehicleSignalsWord(signals));
+    EXPECT_EQ(copy.pudLampRequest, (uint32_t)PUDLAMP_RAMP_UP);
+    EXPECT_EQ(copy.transmissionParkStatus, (uint32_t)TRNPRKSTS_OUT_OF_PARK);
+    EXPECT_EQ(copy.batterySOC, 83u);
+    EXPECT_EQ(copy.vehicleLockStatus, (uint32_t)VEH_UNLOCK_DRV);
+    EXPECT_TRUE(copy.isUnlocked);
+    EXPECT_FALSE(copy.isParked);
+    EXPECT_TRUE(copy.bedlightShouldBeOn);
+    EXPECT_TRUE(copy.systemReady);
+    EXPECT_TRUE(copy.bedlightManualOverride);
+    EXPECT_FALSE(copy.bedlightManualState);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "mock_arduino.h"
+#include "common/test_config.h"
+
+// Import production signal history
+#include "../src/signal_history.h"
+
+/**
+ * Signal History Test Suite
+ *
+ * Validates the per-signal change history:
+ * - Only changes are recorded, per signal, from one published signal word
+ * - Queries count changes, track min/max and hold values across quiet slots
+ * - Events age into min/max buckets and stay queryable from there
+ * - A full arena folds its oldest events, keeping change counts, and RAM
+ *   stays bounded over any length of idle time
+ * - Signals are found by their DBC names
+ */
+
+namespace {
+
+uint32_t makeWord(uint8_t lockStatus, uint8_t soc) {
+    VehicleSignals signals = vehicleSignalsFromWord(0);
+    signals.vehicleLockStatus = lockStatus;
+    signals.batterySOC = soc;
+    return vehicleSignalsWord(signals);
+}
+
+SignalHistorySlot querySingleSlot(uint8_t signal, uint32_t fromMs, uint32_t toMs) {
+    SignalHistorySlot slot;
+    EXPECT_EQ(querySignalHistory(signal, fromMs, toMs - fromMs, 1, &slot), 1);
+    return slot;
+}
+
+}  // namespace
+
+class SignalHistoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        resetSignalHistory();
+    }
+};
+
+TEST_F(SignalHistoryTest, RecordsOnlyChanges) {
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 80), 1000);
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 80), 1100);
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 79), 1200);
+
+    EXPECT_EQ(getSignalHistoryInfo(SIGNAL_HISTORY_BATTERY_SOC).events, 2);
+    EXPECT_EQ(getSignalHistoryInfo(SIGNAL_HISTORY_LOCK).events, 1);
+    EXPECT_EQ(getSignalHistoryInfo(SIGNAL_HISTORY_LOCK).oldestEventMs, 1000u);
+    EXPECT_LE(getSignalHistoryInfo(SIGNAL_HISTORY_BATTERY_SOC).bytesUsed, 8);
+}
+
+TEST_F(SignalHistoryTest, QueryCountsChangesAndRange) {
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 80), 1000);
+    recordSignalHistory(makeWord(VEH_UNLOCK_ALL, 80), 2000);
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 80), 3000);
+    recordSignalHistory(makeWord(VEH_UNLOCK_ALL, 80), 4000);
+
+    // The first value is an observation, not a change
+    SignalHistorySlot slot = querySingleSlot(SIGNAL_HISTORY_LOCK, 0, 10000);
+    EXPECT_TRUE(slot.known);
+    EXPECT_EQ(slot.changes, 3);
+    EXPECT_EQ(slot.min, VEH_LOCK_ALL < VEH_UNLOCK_ALL ? VEH_LOCK_ALL : VEH_UNLOCK_ALL);
+    EXPECT_EQ(slot.max, VEH_LOCK_ALL > VEH_UNLOCK_ALL ? VEH_LOCK_ALL : VEH_UNLOCK_ALL);
+    EXPECT_EQ(slot.last, VEH_UNLOCK_ALL);
+
+    // A window after the changes sees the held value only
+    slot = querySingleSlot(SIGNAL_HISTORY_LOCK, 5000, 6000);
+    EXPECT_TRUE(slot.known);
+    EXPECT_EQ(slot.changes, 0);
+    EXPECT_EQ(slot.min, VEH_UNLOCK_ALL);
+    EXPECT_EQ(slot.max, VEH_UNLOCK_ALL);
+}
+
+TEST_F(SignalHistoryTest, SlotsHoldValuesBetweenChanges) {
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 80), 1500);
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 75), 3500);
+
+    SignalHistorySlot slots[5];
+    ASSERT_EQ(querySignalHistory(SIGNAL_HISTORY_BATTERY_SOC, 0, 1000, 5, slots), 5);
+    EXPECT_FALSE(slots[0].known);            // Before the first value
+    EXPECT_EQ(slots[1].startMs, 1000u);
+    EXPECT_TRUE(slots[1].known);
+    EXPECT_EQ(slots[1].last, 80);
+    EXPECT_EQ(slots[2].min, 80);             // Quiet slot holds the value
+    EXPECT_EQ(slots[2].changes, 0);
+    EXPECT_EQ(slots[3].min, 75);
+    EXPECT_EQ(slots[3].max, 80);
+    EXPECT_EQ(slots[3].changes, 1);
+    EXPECT_EQ(slots[4].last, 75);
+
+    EXPECT_EQ(querySignalHistory(SIGNAL_HISTORY_COUNT, 0, 1000, 5, slots), 0);
+    EXPECT_EQ(querySignalHistory(SIGNAL_HISTORY_LOCK, 0, 0, 5, slots), 0);
+}
+
+TEST_F(SignalHistoryTest, EventsAgeIntoBuckets) {
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 90), 1000);
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 60), 2000);
+    uint32_t later = 2000 + SIGNAL_HISTORY_RAW_MAX_AGE_MS + 1;
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 60), later);
+
+    SignalHistoryInfo info = getSignalHistoryInfo(SIGNAL_HISTORY_BATTERY_SOC);
+    EXPECT_EQ(info.events, 0);
+    EXPECT_EQ(info.eventsFolded, 2u);
+    EXPECT_TRUE(info.hasBuckets);
+
+    // "What was BSBattSOC overnight": the range survives in the bucket
+    SignalHistorySlot slot = querySingleSlot(SIGNAL_HISTORY_BATTERY_SOC, 0, later);
+    EXPECT_TRUE(slot.known);
+    EXPECT_EQ(slot.min, 60);
+    EXPECT_EQ(slot.max, 90);
+    EXPECT_EQ(slot.changes, 1);
+    EXPECT_EQ(slot.last, 60);
+}
+
+TEST_F(SignalHistoryTest, FullArenaFoldsOldestEvents) {
+    const int toggles = 2000;
+    uint32_t now = 0;
+    for (int i = 0; i <= toggles; i++) {
+        now = 1000 + i * 1000;
+        recordSignalHistory(makeWord(i % 2 ? VEH_UNLOCK_ALL : VEH_LOCK_ALL, 80), now);
+    }
+
+    SignalHistoryInfo info = getSignalHistoryInfo(SIGNAL_HISTORY_LOCK);
+    EXPECT_LE(info.bytesUsed, SIGNAL_HISTORY_EVENT_BYTES);
+    EXPECT_GT(info.eventsFolded, 0u);
+    EXPECT_EQ(info.events + info.eventsFolded, (uint32_t)toggles + 1);
+    EXPECT_GT(info.oldestEventMs, 1000u);
+
+    // Folded changes are still counted, exactly once
+    SignalHistorySlot slot = querySingleSlot(SIGNAL_HISTORY_LOCK, 0, now + 1);
+    EXPECT_EQ(slot.changes, toggles);
+
+    // The exact tier alone answers "how often in the last minute"
+    slot = querySingleSlot(SIGNAL_HISTORY_LOCK, now - 60000 + 1, now + 1);
+    EXPECT_EQ(slot.changes, 60);
+}
+
+TEST_F(SignalHistoryTest, LongIdleKeepsBucketRingBounded) {
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 80), 1000);
+    uint32_t now = 1000;
+    for (int day = 1; day <= 10; day++) {
+        now = 1000 + day * 86400000UL;
+        recordSignalHistory(makeWord(VEH_LOCK_ALL, 80 - day), now);
+    }
+    now += SIGNAL_HISTORY_RAW_MAX_AGE_MS + 1;
+    recordSignalHistory(makeWord(VEH_LOCK_ALL, 65), now);
+
+    // Only the newest ring of buckets is kept, ending where the exact events start
+    SignalHistoryInfo info = getSignalHistoryInfo(SIGNAL_HISTORY_BATTERY_SOC);
+    EXPECT_EQ(info.buckets, SIGNAL_HISTORY_BUCKETS);
+    EXPECT_EQ(info.events, 1);
+    EXPECT_EQ(info.oldestEventMs, now);
+    EXPECT_LE(info.oldestEventMs - info.oldestBucketMs, SIGNAL_HISTORY_BUCKETS * SIGNAL_HISTORY_BUCKET_MS +
+                                                        SIGNAL_HISTORY_RAW_MAX_AGE_MS + 1);
+
+    // The last day is still there at bucket resolution
+    SignalHistorySlot slot = querySingleSlot(SIGNAL_HISTORY_BATTERY_SOC, now - 86400000UL, now + 1);
+    EXPECT_TRUE(slot.known);
+    EXPECT_EQ(slot.last, 65);
+    EXPECT_EQ(slot.min, 65);
+    EXPECT_EQ(slot.max, 71);                 // Held from day 9 into the window
+    EXPECT_EQ(slot.changes, 2);
+}
+
+TEST_F(SignalHistoryTest, SignalsAreFoundByDbcName) {
+    EXPECT_EQ(findSignalHistorySignal("BSBattSOC"), SIGNAL_HISTORY_BATTERY_SOC);
+    EXPECT_EQ(findSignalHistorySignal("veh_lock_status"), SIGNAL_HISTORY_LOCK);
+    EXPECT_EQ(findSignalHistorySignal("soc"), -1);
+    EXPECT_STREQ(getSignalHistoryName(SIGNAL_HISTORY_PARK), "TrnPrkSys_D_Actl");
+    EXPECT_EQ(getSignalHistoryValue(SIGNAL_HISTORY_BATTERY_SOC, makeWord(VEH_LOCK_ALL, 42)), 42);
+}
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+Compare bench kernel results against the checked-in baselines.
+
+Reads either Google Benchmark JSON from the host runner ([env:bench]) or the
+serial log of the on-target runner ([env:bench-esp32], lines of the form
+"BENCH <kernel> <cycles> cycles/op") and compares each kernel with the
+matching baseline in bench/baselines/. A kernel slower than the baseline by
+more than the tolerance is a regression and makes the exit status 1.
+
+    .pio/build/bench/program --benchmark_out=bench.json --benchmark_out_format=json
+    python3 tools/bench_compare.py bench.json
+    pio device monitor | tee bench_esp32.log      # after pio run -e bench-esp32 -t upload
+    python3 tools/bench_compare.py bench_esp32.log
+    python3 tools/bench_compare.py bench.json --update    # accept the new figures
+
+Host timings depend on the machine: refresh native.json (--update) on the
+machine that runs the comparison rather than comparing across hosts.
+Cycle counts from the board do not depend on the host; create esp32s3.json
+with --update from a first run on hardware.
+"""
+
+import argparse
+import json
+import os
+import platform
+import re
+import sys
+
+BASELINE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'bench', 'baselines')
+NATIVE_BASELINE = os.path.join(BASELINE_DIR, 'native.json')
+TARGET_BASELINE = os.path.join(BASELINE_DIR, 'esp32s3.json')
+DEFAULT_TOLERANCE = 0.25
+
+TARGET_LINE_RE = re.compile(r'^\s*BENCH\s+(\S+)\s+([0-9.]+)\s+cycles/op')
+
+
+def load_google_benchmark(data):
+    """ns/op per kernel; the median aggregate wins when --benchmark_repetitions was used"""
+    results = {}
+    medians = {}
+    for entry in data.get('benchmarks', []):
+        items_per_second = entry.get('items_per_second')
+        if not items_per_second:
+            continue
+        ns_per_op = 1e9 / items_per_second
+        if entry.get('run_type') == 'aggregate':
+            if entry.get('aggregate_name') == 'median':
+                medians[entry['run_name']] = ns_per_op
+            continue
+        results.setdefault(entry.get('run_name', entry['name']), ns_per_op)
+    results.update(medians)
+    return results
+
+
+def load_target_log(text):
+    """cycles/op per kernel from the on-target runner's serial output"""
+    results = {}
+    for line in text.splitlines():
+        match = TARGET_LINE_RE.match(line)
+        if match:
+            results[match.group(1)] = float(match.group(2))
+    return results
+
+
+def load_results(path):
+    """Return (results, unit, default baseline path)"""
+    with open(path, 'r', encoding='utf-8', errors='replace') as source:
+        text = source.read()
+    try:
+        data = json.loads(text)
+    except ValueError:
+        return load_target_log(text), 'cycles/op', TARGET_BASELINE
+    return load_google_benchmark(data), 'ns/op', NATIVE_BASELINE
+
+
+def write_baseline(path, results, unit, tolerance):
+    baseline = {
+        'unit': unit,
+        'tolerance': tolerance,
+        'machine': platform.machine() if unit == 'ns/op' else 'esp32-s3',
+        'kernels': {name: round(value, 2) for name, value in sorted(results.items())},
+    }
+    with open(path, 'w', encoding='utf-8') as out:
+        json.dump(baseline, out, indent=2)
+        out.write('\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare bench kernel results with the checked-in baselines')
+    parser.add_argument('results', help='Google Benchmark JSON or on-target serial log')
+    parser.add_argument('--baseline', help='Baseline file (default: bench/baselines/native.json or esp32s3.json)')
+    parser.add_argument('--tolerance', type=float, help='Allowed slowdown as a fraction (default: from the baseline, else 0.25)')
+    parser.add_argument('--update', action='store_true', help='Write the results as the new baseline')
+    args = parser.parse_args()
+
+    results, unit, default_baseline = load_results(args.results)
+    if not results:
+        print(f"{args.results}: no bench results found", file=sys.stderr)
+        return 2
+    baseline_path = args.baseline or default_baseline
+
+    if args.update:
+        write_baseline(baseline_path, results, unit, args.tolerance or DEFAULT_TOLERANCE)
+        print(f"Wrote {len(results)} kernels to {baseline_path}")
+        return 0
+
+    if not os.path.exists(baseline_path):
+        print(f"No baseline at {baseline_path} - run again with --update to create it", file=sys.stderr)
+        for name, value in sorted(results.items()):
+            print(f"  {name:<32} {value:10.2f} {unit}")
+        return 2
+
+    with open(baseline_path, 'r', encoding='utf-8') as source:
+        baseline = json.load(source)
+    if baseline.get('unit') != unit:
+        print(f"{baseline_path} holds {baseline.get('unit')} figures, results are {unit}", file=sys.stderr)
+        return 2
+    tolerance = args.tolerance if args.tolerance is not None else baseline.get('tolerance', DEFAULT_TOLERANCE)
+
+    regressions = 0
+    print(f"{'kernel':<32} {'baseline':>10} {'current':>10} {'change':>8}  ({unit}, tolerance {tolerance:.0%})")
+    for name, expected in sorted(baseline['kernels'].items()):
+        if name not in results:
+            print(f"{name:<32} {expected:10.2f} {'missing':>10}")
+            continue
+        current = results[name]
+        change = (current - expected) / expected if expected else 0.0
+        flag = ''
+        if change > tolerance:
+            flag = '  REGRESSION'
+            regressions += 1
+        print(f"{name:<32} {expected:10.2f} {current:10.2f} {change:+8.1%}{flag}")
+    for name in sorted(set(results) - set(baseline['kernels'])):
+        print(f"{name:<32} {'new':>10} {results[name]:10.2f}")
+
+    if regressions:
+        print(f"{regressions} kernel(s) slower than the baseline by more than {tolerance:.0%}", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
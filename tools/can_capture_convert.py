@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+Convert text CAN captures to the binary capture format (.f150cap).
+
+Reads candump log files (candump -l / -L), can_embedded_logger.py output or
+a serial log of the firmware's 'flight dump' command and writes the fixed-record format described in
+lib/trace_replay/include/capture_file.h: a 64-byte header, 16-byte records in
+time order, and a directory + index that group the records by ID. The native
+replay engine memory-maps the result, so even multi-GB drives open instantly
+and can be seeked by ID or time without a scan.
+
+    python3 tools/can_capture_convert.py drive.log drive.f150cap
+    python3 tools/can_capture_convert.py can_log.csv drive.f150cap --stats
+
+Input is streamed; memory use is 4 bytes per frame for the ID index.
+Extended (29-bit) IDs, remote frames and CAN FD frames are skipped and
+counted. Timestamps that step backwards are clamped to the previous frame so
+record times never decrease.
+"""
+
+import argparse
+import array
+import calendar
+import re
+import struct
+import sys
+
+MAGIC = b'F150CAP\x00'
+VERSION = 1
+HEADER = struct.Struct('<8sIIQQIIQQQ')      # CaptureFileHeader
+RECORD = struct.Struct('<IBBH8s')           # CaptureRecord
+ID_ENTRY = struct.Struct('<HHIQ')           # CaptureIdEntry
+MAX_TIME_DELTA_US = (1 << 40) - 1
+STANDARD_ID_COUNT = 2048
+
+assert HEADER.size == 64 and RECORD.size == 16 and ID_ENTRY.size == 16
+assert array.array('I').itemsize == 4
+
+# 'flight dump' prints candump lines behind the firmware's log level prefix
+CANDUMP_RE = re.compile(r'^\s*(?:\[[A-Z]+\]\s*)?\((\d+)\.(\d+)\)\s+\S+\s+([0-9A-Fa-f]+)#([0-9A-Fa-f.]*)(?:\s+[RT])?\s*$')
+EMBEDDED_RE = re.compile(
+    r'^(\d{4})-(\d{2})-(\d{2}) (\d{2}):(\d{2}):(\d{2})\.(\d{3})\s*\|\s*CAN_ID:0x([0-9A-Fa-f]+)'
+    r'\s*\|\s*data:((?:\s*[0-9A-Fa-f]{2})*)\s*(?:\||$)')
+
+
+class ConvertStats:
+    def __init__(self):
+        self.lines = 0
+        self.records = 0
+        self.skipped_lines = 0
+        self.extended_ids = 0
+        self.clamped = 0
+        self.truncated = False
+
+
+def parse_line(line):
+    """Return (timestamp_us, id, data bytes) or None for lines without a data frame"""
+    match = CANDUMP_RE.match(line)
+    if match:
+        seconds, fraction, can_id, payload = match.groups()
+        payload = payload.replace('.', '')
+        if len(payload) % 2 or len(payload) > 16:
+            return None
+        micros = int((fraction + '000000')[:6])
+        return int(seconds) * 1000000 + micros, int(can_id, 16), bytes.fromhex(payload)
+
+    match = EMBEDDED_RE.match(line)
+    if match:
+        year, month, day, hour, minute, second, millis = (int(g) for g in match.groups()[:7])
+        payload = bytes.fromhex(match.group(9).replace(' ', ''))
+        if len(payload) > 8:
+            return None
+        seconds = calendar.timegm((year, month, day, hour, minute, second, 0, 0, 0))
+        return seconds * 1000000 + millis * 1000, int(match.group(8), 16), payload
+
+    return None
+
+
+def convert(source, output, stats):
+    header_offset = HEADER.size
+    id_records = {}
+    base = None
+    last_delta = 0
+
+    output.write(b'\x00' * HEADER.size)
+    for line in source:
+        stats.lines += 1
+        frame = parse_line(line)
+        if frame is None:
+            stats.skipped_lines += 1
+            continue
+
+        timestamp_us, can_id, payload = frame
+        if can_id >= STANDARD_ID_COUNT:
+            stats.extended_ids += 1
+            continue
+
+        if base is None:
+            base = timestamp_us
+        delta = timestamp_us - base
+        if delta < last_delta:
+            delta = last_delta
+            stats.clamped += 1
+        if delta > MAX_TIME_DELTA_US:
+            stats.truncated = True
+            break
+        last_delta = delta
+
+        output.write(RECORD.pack(delta & 0xFFFFFFFF, delta >> 32, len(payload), can_id,
+                                 payload.ljust(8, b'\x00')))
+        id_records.setdefault(can_id, array.array('I')).append(stats.records)
+        stats.records += 1
+
+    directory_offset = header_offset + stats.records * RECORD.size
+    index_offset = directory_offset + len(id_records) * ID_ENTRY.size
+
+    first_index = 0
+    for can_id in sorted(id_records):
+        output.write(ID_ENTRY.pack(can_id, 0, len(id_records[can_id]), first_index))
+        first_index += len(id_records[can_id])
+    for can_id in sorted(id_records):
+        records = id_records[can_id]
+        if sys.byteorder != 'little':
+            records.byteswap()
+        records.tofile(output)
+
+    output.seek(0)
+    output.write(HEADER.pack(MAGIC, VERSION, RECORD.size, base or 0, stats.records, len(id_records), 0,
+                             header_offset, directory_offset, index_offset))
+    return id_records
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a candump or can_embedded_logger.py capture to .f150cap')
+    parser.add_argument('input', help='Text capture (use - for stdin)')
+    parser.add_argument('output', help='Binary capture to write')
+    parser.add_argument('--stats', action='store_true', help='Print per-ID frame counts')
+    args = parser.parse_args()
+
+    stats = ConvertStats()
+    source = sys.stdin if args.input == '-' else open(args.input, 'r', encoding='utf-8', errors='replace')
+    with source, open(args.output, 'wb') as output:
+        id_records = convert(source, output, stats)
+
+    print(f"{args.output}: {stats.records} frames, {len(id_records)} IDs "
+          f"({stats.skipped_lines} lines without a frame, {stats.extended_ids} extended IDs skipped, "
+          f"{stats.clamped} timestamps clamped)", file=sys.stderr)
+    if stats.truncated:
+        print("WARNING: capture longer than the 40-bit time range - remaining frames dropped", file=sys.stderr)
+    if args.stats:
+        for can_id in sorted(id_records):
+            print(f"  0x{can_id:03X}: {len(id_records[can_id])}", file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""
+Decode the can_scanner sniffer stream (can_scanner, pio run -e sniffer).
+
+The scanner writes COBS-encoded packets, each ending in a 0x00 byte and
+guarded by a CRC-16/CCITT-FALSE (the layout is documented above
+snifferLoop() in can_scanner/src/main.cpp). This tool reads the stream
+from the USB serial port or from a raw dump, checks every packet and:
+
+    python3 tools/can_sniffer_decode.py /dev/ttyACM0 > drive.log
+        candump -l lines on stdout (the default)
+    python3 tools/can_sniffer_decode.py /dev/ttyACM0 --capture drive.f150cap
+        writes the binary capture format through can_capture_convert.py
+    python3 tools/can_sniffer_decode.py /dev/ttyACM0 --vcan vcan0
+        replays onto a SocketCAN interface, e.g. for can_logger.py vcan0
+    python3 tools/can_sniffer_decode.py stream.bin --capture drive.f150cap
+        decodes a raw dump (cat /dev/ttyACM0 > stream.bin) offline
+
+Sequence gaps (packets lost between device and host) and the driver's
+rx_missed/rx_overrun counters (frames lost on the device) are reported on
+stderr; a capture with all of them at zero is complete. Text the scanner
+prints before the stream starts is passed through to stderr.
+
+Serial ports need pyserial, --vcan needs python-can.
+"""
+
+import argparse
+import os
+import stat
+import struct
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import can_capture_convert  # noqa: E402  (sibling tool)
+
+PACKET_FRAMES = 0x01
+PACKET_STATUS = 0x02
+FRAME_RECORD = struct.Struct('<IIB8s')
+STATUS = struct.Struct('<IIIIIHB')
+ID_EXTENDED = 0x80000000
+ID_REMOTE = 0x40000000
+READ_CHUNK = 4096
+
+assert FRAME_RECORD.size == 17 and STATUS.size == 23
+
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Return the decoded bytes, or None for a malformed block"""
+    output = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            return None
+        output += data[index + 1:index + code]
+        index += code
+        if code < 0xFF and index < len(data):
+            output.append(0)
+    return bytes(output)
+
+
+def valid_packet(packet):
+    return len(packet) >= 4 and crc16_ccitt(packet[:-2]) == struct.unpack_from('<H', packet, len(packet) - 2)[0]
+
+
+def is_text(block):
+    return bool(block) and all(32 <= byte < 127 or byte in (9, 10, 13) for byte in block)
+
+
+class DecodeStats:
+    def __init__(self):
+        self.packets = 0
+        self.frames = 0
+        self.bad_packets = 0
+        self.sequence_gaps = 0
+        self.rx_missed = 0
+        self.rx_overrun = 0
+        self.bus_errors = 0
+
+
+class SnifferDecoder:
+    """Turns delimited blocks into (timestamp_us, id, extended, remote, data) frames"""
+
+    def __init__(self, stats, log=sys.stderr):
+        self.stats = stats
+        self.log = log
+        self.last_sequence = None
+        self.device_base_us = None
+        self.host_base_us = None
+        self.last_raw_us = None
+        self.wraps = 0
+        self.first_status = None
+
+    def feed(self, block):
+        packet = cobs_decode(block)
+        newline = block.rfind(b'\n')
+        if (packet is None or not valid_packet(packet)) and newline >= 0 and is_text(block[:newline + 1]):
+            # Text directly followed by a packet, without a delimiter in between
+            print(block[:newline + 1].decode('ascii').rstrip(), file=self.log)
+            block = block[newline + 1:]
+            if not block:
+                return []
+            packet = cobs_decode(block)
+        if packet is None or not valid_packet(packet):
+            self._reject(block)
+            return []
+
+        packet_type, sequence = packet[0], packet[1]
+        payload = packet[2:-2]
+        if self.last_sequence is not None and sequence != (self.last_sequence + 1) & 0xFF:
+            self.stats.sequence_gaps += 1
+        self.last_sequence = sequence
+        self.stats.packets += 1
+
+        if packet_type == PACKET_FRAMES:
+            return self._frames(payload)
+        if packet_type == PACKET_STATUS and len(payload) == STATUS.size:
+            self._status(payload)
+        return []
+
+    def _reject(self, block):
+        # Boot banner and other text printed before the binary stream starts
+        if is_text(block):
+            print(block.decode('ascii').rstrip(), file=self.log)
+        else:
+            self.stats.bad_packets += 1
+
+    def _timestamp_us(self, raw_us):
+        # Device clock is the low 32 bits of esp_timer; unwrap and anchor it to host time
+        if self.last_raw_us is not None and raw_us < self.last_raw_us:
+            self.wraps += 1
+        self.last_raw_us = raw_us
+        device_us = (self.wraps << 32) | raw_us
+        if self.device_base_us is None:
+            self.device_base_us = device_us
+            self.host_base_us = int(time.time() * 1000000)
+        return self.host_base_us + device_us - self.device_base_us
+
+    def _frames(self, payload):
+        if not payload or len(payload) != 1 + payload[0] * FRAME_RECORD.size:
+            self.stats.bad_packets += 1
+            return []
+        frames = []
+        for index in range(payload[0]):
+            raw_us, can_id, dlc, data = FRAME_RECORD.unpack_from(payload, 1 + index * FRAME_RECORD.size)
+            frames.append((self._timestamp_us(raw_us), can_id & 0x1FFFFFFF, bool(can_id & ID_EXTENDED),
+                           bool(can_id & ID_REMOTE), data[:min(dlc, 8)]))
+        self.stats.frames += len(frames)
+        return frames
+
+    def _status(self, payload):
+        uptime_ms, sent, missed, overrun, bus_errors, queued, state = STATUS.unpack(payload)
+        if self.first_status is None:
+            self.first_status = (missed, overrun, bus_errors)
+        self.stats.rx_missed = missed - self.first_status[0]
+        self.stats.rx_overrun = overrun - self.first_status[1]
+        self.stats.bus_errors = bus_errors - self.first_status[2]
+        if missed or overrun:
+            print(f"device {uptime_ms / 1000:.1f} s: {sent} frames sent, {queued} queued, "
+                  f"rx_missed {missed}, rx_overrun {overrun}, state {state}", file=self.log)
+
+
+def read_blocks(source, follow):
+    """Split a byte stream at 0x00 delimiters; with follow, read timeouts do not end it"""
+    pending = bytearray()
+    while True:
+        chunk = source.read(READ_CHUNK)
+        if not chunk:
+            if follow:
+                continue
+            return
+        pending += chunk
+        while True:
+            end = pending.find(0)
+            if end < 0:
+                break
+            block = bytes(pending[:end])
+            del pending[:end + 1]
+            if block:
+                yield block
+
+
+def open_source(path):
+    """Return (stream, follow): serial ports are followed until interrupted"""
+    if path == '-':
+        return sys.stdin.buffer, False
+    if stat.S_ISCHR(os.stat(path).st_mode):
+        import serial  # pyserial; USB CDC ignores the baud rate
+        return serial.Serial(path, 115200, timeout=1), True
+    return open(path, 'rb'), False
+
+
+def candump_line(frame):
+    timestamp_us, can_id, extended, remote, data = frame
+    id_text = f"{can_id:08X}" if extended else f"{can_id:03X}"
+    payload = 'R' if remote else data.hex().upper()
+    return f"({timestamp_us // 1000000}.{timestamp_us % 1000000:06d}) can0 {id_text}#{payload}\n"
+
+
+def decoded_frames(source, decoder, follow):
+    for block in read_blocks(source, follow):
+        for frame in decoder.feed(block):
+            yield frame
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the can_scanner binary sniffer stream')
+    parser.add_argument('input', help='Serial port, raw stream dump, or - for stdin')
+    output = parser.add_mutually_exclusive_group()
+    output.add_argument('--capture', metavar='FILE', help='Write a .f150cap binary capture')
+    output.add_argument('--vcan', metavar='IFACE', help='Send frames to a SocketCAN interface (python-can)')
+    args = parser.parse_args()
+
+    stats = DecodeStats()
+    decoder = SnifferDecoder(stats)
+    source, follow = open_source(args.input)
+    try:
+        frames = decoded_frames(source, decoder, follow)
+        if args.capture:
+            # Standard data frames go through the text converter's candump parser
+            lines = (candump_line(frame) for frame in frames if not frame[3])
+            convert_stats = can_capture_convert.ConvertStats()
+            with open(args.capture, 'wb') as capture:
+                can_capture_convert.convert(lines, capture, convert_stats)
+            print(f"{args.capture}: {convert_stats.records} frames "
+                  f"({convert_stats.extended_ids} extended IDs skipped)", file=sys.stderr)
+        elif args.vcan:
+            import can
+            with can.interface.Bus(channel=args.vcan, interface='socketcan') as bus:
+                for timestamp_us, can_id, extended, remote, data in frames:
+                    bus.send(can.Message(timestamp=timestamp_us / 1e6, arbitration_id=can_id,
+                                         is_extended_id=extended, is_remote_frame=remote, data=data))
+        else:
+            for frame in frames:
+                sys.stdout.write(candump_line(frame))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        source.close()
+
+    print(f"{stats.frames} frames in {stats.packets} packets: {stats.bad_packets} bad packets, "
+          f"{stats.sequence_gaps} sequence gaps, device rx_missed {stats.rx_missed}, "
+          f"rx_overrun {stats.rx_overrun}, bus errors {stats.bus_errors}", file=sys.stderr)
+    lost = stats.bad_packets or stats.sequence_gaps or stats.rx_missed or stats.rx_overrun
+    return 1 if lost else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
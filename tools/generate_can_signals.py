@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""
+Generate src/dbc_signals.h from a DBC file.
+
+Reads the BO_/SG_ definitions of a DBC file and emits one constexpr
+CANSignalSpec per signal, grouped by message. The firmware decodes signals
+through the templates in src/signal_decoder.h, so adding a signal to the DBC
+and rerunning this script is all that is needed to make it decodable.
+
+The generated header is checked in; rerun after editing the DBC:
+
+    python3 tools/generate_can_signals.py
+    python3 tools/generate_can_signals.py --check   # CI: fail if out of date
+
+Only what the 64-bit word decoder can express is accepted: standard (11-bit)
+IDs, payloads of at most 8 bytes and signals of at most 32 bits that lie
+inside the payload. Anything else is reported as an error rather than
+silently decoded wrong.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_DBC = os.path.join(REPO_ROOT, 'experiments', 'message_watcher', 'minimal.dbc')
+DEFAULT_OUTPUT = os.path.join(REPO_ROOT, 'src', 'dbc_signals.h')
+
+MESSAGE_RE = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)')
+SIGNAL_RE = re.compile(
+    r'^\s*SG_\s+(\w+)\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*'
+    r'\(([^,]+),([^)]+)\)\s*\[([^|]+)\|([^\]]+)\]\s*"([^"]*)"')
+
+
+class DBCError(Exception):
+    pass
+
+
+def parse_dbc(path):
+    """Return a list of messages: {'id', 'name', 'length', 'sender', 'signals': [...]}"""
+    messages = []
+    current = None
+
+    with open(path, 'r', encoding='utf-8', errors='replace') as dbc:
+        for line_number, line in enumerate(dbc, 1):
+            message_match = MESSAGE_RE.match(line)
+            if message_match:
+                current = {
+                    'id': int(message_match.group(1)),
+                    'name': message_match.group(2),
+                    'length': int(message_match.group(3)),
+                    'sender': message_match.group(4),
+                    'signals': [],
+                }
+                messages.append(current)
+                continue
+
+            signal_match = SIGNAL_RE.match(line)
+            if signal_match:
+                if current is None:
+                    raise DBCError('%s:%d: signal outside of a message' % (path, line_number))
+                current['signals'].append({
+                    'name': signal_match.group(1),
+                    'start_bit': int(signal_match.group(2)),
+                    'length': int(signal_match.group(3)),
+                    'motorola': signal_match.group(4) == '0',
+                    'signed': signal_match.group(5) == '-',
+                    'factor': float(signal_match.group(6)),
+                    'offset': float(signal_match.group(7)),
+                    'minimum': float(signal_match.group(8)),
+                    'maximum': float(signal_match.group(9)),
+                    'unit': signal_match.group(10),
+                    'line': line_number,
+                })
+            elif not line.startswith(' ') and not line.startswith('\t'):
+                current = None
+
+    return messages
+
+
+def signal_problem(signal):
+    """Why the word decoder cannot express this signal, or None"""
+    start = signal['start_bit']
+    length = signal['length']
+
+    if length < 1 or length > 32 or start > 63:
+        return 'unsupported start bit %d / length %d' % (start, length)
+    if signal['motorola']:
+        # MSB position in the big-endian word; the signal runs downwards from it
+        if (7 - start // 8) * 8 + start % 8 - length + 1 < 0:
+            return 'Motorola signal runs past the last byte'
+    elif start + length > 64:
+        return 'Intel signal runs past bit 63'
+    return None
+
+
+def validate(messages, path, skip_unsupported):
+    """Raise on the first unsupported message/signal, or drop them with a warning"""
+    supported = []
+
+    for message in messages:
+        problem = None
+        if message['id'] > 0x7FF:
+            problem = '0x%X is not a standard 11-bit ID' % message['id']
+        elif message['length'] > 8:
+            problem = '%d bytes, max 8' % message['length']
+
+        if problem:
+            if not skip_unsupported:
+                raise DBCError('%s: %s: %s' % (path, message['name'], problem))
+            print('warning: skipping %s: %s' % (message['name'], problem), file=sys.stderr)
+            continue
+
+        signals = []
+        for signal in message['signals']:
+            problem = signal_problem(signal)
+            if problem:
+                where = '%s:%d: %s.%s' % (path, signal['line'], message['name'], signal['name'])
+                if not skip_unsupported:
+                    raise DBCError('%s: %s' % (where, problem))
+                print('warning: skipping %s: %s' % (where, problem), file=sys.stderr)
+                continue
+            signals.append(signal)
+
+        message['signals'] = signals
+        supported.append(message)
+
+    return supported
+
+
+def format_float(value):
+    text = repr(float(value))
+    return text + 'f' if 'e' in text or '.' in text else text + '.0f'
+
+
+def generate_header(messages, dbc_path):
+    source = os.path.relpath(dbc_path, REPO_ROOT)
+    lines = [
+        '// Generated by tools/generate_can_signals.py from %s' % source,
+        '// DO NOT EDIT - change the DBC and rerun the generator instead',
+        '#ifndef DBC_SIGNALS_H',
+        '#define DBC_SIGNALS_H',
+        '',
+        '#include "signal_decoder.h"',
+        '',
+        'namespace dbc {',
+    ]
+
+    for message in messages:
+        lines.append('')
+        lines.append('// %s (0x%03X, %d bytes, sent by %s)' % (
+            message['name'], message['id'], message['length'], message['sender']))
+        lines.append('namespace %s {' % message['name'])
+        lines.append('    constexpr uint32_t ID = 0x%03X;' % message['id'])
+        lines.append('    constexpr uint8_t LENGTH = %d;' % message['length'])
+
+        for signal in message['signals']:
+            lines.append('    inline constexpr CANSignalSpec %s = {%d, %d, %s, %s, %s, %s, %s, %s};  // "%s"' % (
+                signal['name'],
+                signal['start_bit'],
+                signal['length'],
+                'CAN_BYTE_ORDER_MOTOROLA' if signal['motorola'] else 'CAN_BYTE_ORDER_INTEL',
+                'true' if signal['signed'] else 'false',
+                format_float(signal['factor']),
+                format_float(signal['offset']),
+                format_float(signal['minimum']),
+                format_float(signal['maximum']),
+                signal['unit']))
+
+        lines.append('}')
+
+    lines.extend([
+        '',
+        '} // namespace dbc',
+        '',
+        '#endif // DBC_SIGNALS_H',
+        '',
+    ])
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate constexpr CAN signal descriptors from a DBC file')
+    parser.add_argument('--dbc', default=DEFAULT_DBC, help='DBC file to read (default: minimal.dbc)')
+    parser.add_argument('--output', default=DEFAULT_OUTPUT, help='Header to write (default: src/dbc_signals.h)')
+    parser.add_argument('--check', action='store_true', help='Exit non-zero if the output is out of date')
+    parser.add_argument('--skip-unsupported', action='store_true',
+                        help='Warn about and skip messages/signals the decoder cannot express')
+    args = parser.parse_args()
+
+    try:
+        messages = parse_dbc(args.dbc)
+        messages = validate(messages, args.dbc, args.skip_unsupported)
+    except (DBCError, OSError) as error:
+        print('error: %s' % error, file=sys.stderr)
+        return 1
+
+    header = generate_header(messages, args.dbc)
+
+    if args.check:
+        try:
+            with open(args.output, 'r', encoding='utf-8') as existing:
+                if existing.read() == header:
+                    return 0
+        except OSError:
+            pass
+        print('%s is out of date - rerun tools/generate_can_signals.py' % args.output, file=sys.stderr)
+        return 1
+
+    with open(args.output, 'w', encoding='utf-8') as output:
+        output.write(header)
+    print('Wrote %d messages, %d signals to %s' % (
+        len(messages), sum(len(m['signals']) for m in messages), args.output))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())